@@ -10,7 +10,13 @@
  *                      the smallest finite element minus the largest
  *                      element is finite when performing maximization. 
  *                      Forbidden assignments can be given costs of +Inf
- *                      for minimization and -Inf for maximization.
+ *                      for minimization and -Inf for maximization. C can
+ *                      be of class double, single, int32 or int64. Single
+ *                      and int32 matrices are processed without being
+ *                      converted to doubles, which halves the memory
+ *                      used. Integer costs are solved exactly using 64-bit
+ *                      integer arithmetic; an error is raised if the range
+ *                      of the costs is so large that this could overflow.
  *          maximize    If true, the minimization problem is transformed
  *                      into a maximization problem. The default if this
  *                      parameter is omitted is false.
@@ -26,6 +32,9 @@
  *          u           The dual variable for the columns.
  *          v           The dual variable for the rows.
  *
+ *If C is an integer matrix, then gain, u and v are of class int64.
+ *Otherwise, they are doubles.
+ *
  *DEPENDENCIES: ShortestPathCPP.hpp
  *              ShortestPathCPP.cpp
  *              MexValidation.h
@@ -67,8 +76,9 @@
 
 /*This header is required by Matlab*/
 #include "mex.h"
-/*This is needed for copy and swap*/
+/*This is needed for copy, swap and min*/
 #include <algorithm>
+#include <limits>
 /* This header validates inputs and includes a header needed to handle
  * Matlab matrices.*/
 #include "MexValidation.h"
@@ -76,74 +86,76 @@
 
 using namespace std;
 
-void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+template<class CostType>
+void assign2DForType(const int nlhs, mxArray *plhs[], const mxArray *CMATLAB, const bool maximize);
+
+template<class CostType>
+void assign2DForType(const int nlhs, mxArray *plhs[], const mxArray *CMATLAB, const bool maximize) {
+/*ASSIGN2DFORTYPE Run the assignment algorithm on the Matlab matrix
+ *                CMATLAB, whose elements are of type CostType, and set
+ *                the outputs.*/
+    typedef typename AssignCostTraits<CostType>::DualType DualType;
     size_t numRow,numCol;
-    mxArray *CMat, *col4rowMATLAB, *row4colMATLAB,*uMATLAB,*vMATLAB;//These will hold the values to be returned.
-    ScratchSpace workMem;//Scratch space needed for the assignment algorithm.
-    MurtyHyp *problemSol;//To hold the return value of the C-function called.
+    mxArray *col4rowMATLAB, *row4colMATLAB,*uMATLAB,*vMATLAB,*gainMATLAB;//These will hold the values to be returned.
+    ScratchSpaceT<CostType> workMem;//Scratch space needed for the assignment algorithm.
+    MurtyHypT<CostType> *problemSol;//To hold the return value of the C-function called.
+    const CostType *C;
+    CostType *CTrans=NULL;
     bool didFlip=false;
-    bool maximize=false;
-    
-    if(nrhs<1){
-        mexErrMsgTxt("Not enough inputs.");
-    }
+    const mxClassID dualClass=numeric_limits<CostType>::is_integer?mxINT64_CLASS:mxDOUBLE_CLASS;
     
-    if(nrhs==2){
-        maximize=getBoolFromMatlab(prhs[1]);
-    }
-    
-    if(nrhs>2) {
-        mexErrMsgTxt("Too many inputs.");
-    }
-    
-    if(nlhs>5) {
-        mexErrMsgTxt("Too many outputs.");
-    }
-    
-    /*Verify the validity of the assignment matrix.*/
-    checkRealDoubleArray(prhs[0]);
     /* Get the dimensions of the input data and the pointer to the matrix.
      * It is assumed that the matrix is not so large in M or N as to cause
      * an overflow when using a SIGNED integer data type.*/
-    numRow = mxGetM(prhs[0]);
-    numCol = mxGetN(prhs[0]);
+    numRow = mxGetM(CMATLAB);
+    numCol = mxGetN(CMATLAB);
+    C=(const CostType*)mxGetData(CMATLAB);
+    
+    if(costRangeIsSafe(C,numRow*numCol,min(numRow,numCol))==false) {
+        mexErrMsgTxt("The range of the integer costs is too large.");
+    }
 
     /* Transpose the matrix, if necessary, so that the number of row is
-     * >= the number of columns.*/
-    if(numRow>=numCol) {
-        //This is freed using mxDestroyArray
-        CMat=mxDuplicateArray(prhs[0]);
-    } else {
-        swap(numRow,numCol);
+     * >= the number of columns. The input matrix is not modified, so no
+     * copy is made if it does not have to be transposed.*/
+    if(numRow<numCol) {
+        size_t curRow, curCol;
         
-        //This is freed using mxDestroyArray
-        CMat=mxCreateDoubleMatrix(numCol,numRow,mxREAL);
-        mexCallMATLAB(1, &CMat, 1,  (mxArray **)&prhs[0], "transpose");
+        CTrans=new CostType[numRow*numCol];
+        for(curCol=0;curCol<numCol;curCol++) {
+            for(curRow=0;curRow<numRow;curRow++) {
+                CTrans[curCol+curRow*numCol]=C[curRow+curCol*numRow];
+            }
+        }
+        C=CTrans;
+        swap(numRow,numCol);
         didFlip=true;
     }
     
     //Allocate scratch space.
     workMem.init(numRow,numCol);
     //Allocate space for the return variables from the called function
-    problemSol=new MurtyHyp(numRow, numCol);
+    problemSol=new MurtyHypT<CostType>(numRow, numCol);
 
     //Allocate space for the return variables to Matlab.
     col4rowMATLAB = allocSignedSizeMatInMatlab(numRow,1);
     row4colMATLAB = allocSignedSizeMatInMatlab(numCol,1);
 
-    uMATLAB = mxCreateNumericMatrix(numCol,1,mxDOUBLE_CLASS,mxREAL);
-    vMATLAB = mxCreateNumericMatrix(numRow,1,mxDOUBLE_CLASS,mxREAL);
+    uMATLAB = mxCreateNumericMatrix(numCol,1,dualClass,mxREAL);
+    vMATLAB = mxCreateNumericMatrix(numRow,1,dualClass,mxREAL);
     
     /*The assignment algorithm returns a nonzero value if no valid
      * solutions exist.*/    
     assign2D(numRow,
              numCol,
              maximize,
-             (double*)mxGetData(CMat),
+             C,
              workMem,
              problemSol);
    
-    mxDestroyArray(CMat);
+    if(CTrans!=NULL) {
+        delete[] CTrans;
+    }
     
     /*Convert C++ indices to Matlab indices*/
     for_each(problemSol->row4col, problemSol->row4col+numCol, increment<ptrdiff_t>);
@@ -152,12 +164,15 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     /*Copy the results into the return variables*/
     copy(problemSol->row4col,problemSol->row4col+numCol,(ptrdiff_t*)mxGetData(row4colMATLAB));
     copy(problemSol->col4row,problemSol->col4row+numRow,(ptrdiff_t*)mxGetData(col4rowMATLAB));
-    copy(problemSol->u,problemSol->u+numCol,(double*)mxGetData(uMATLAB));
-    copy(problemSol->v,problemSol->v+numRow,(double*)mxGetData(vMATLAB));
+    copy(problemSol->u,problemSol->u+numCol,(DualType*)mxGetData(uMATLAB));
+    copy(problemSol->v,problemSol->v+numRow,(DualType*)mxGetData(vMATLAB));
+    
+    gainMATLAB=mxCreateNumericMatrix(1,1,dualClass,mxREAL);
+    *(DualType*)mxGetData(gainMATLAB)=problemSol->gain;
+    delete problemSol;
     
     /* If a transposed array was used */
     if(didFlip==true) {
-        swap(numRow,numCol);
         swap(row4colMATLAB,col4rowMATLAB);
         swap(uMATLAB,vMATLAB);
     }
@@ -169,15 +184,61 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
         case 4:
             plhs[3]=uMATLAB;
         case 3:
-            plhs[2]=mxCreateDoubleMatrix(1,1,mxREAL);
-            *(double*)mxGetData(plhs[2])=problemSol->gain;
+            plhs[2]=gainMATLAB;
         case 2:
             plhs[1]=row4colMATLAB;
         default:
             plhs[0]=col4rowMATLAB;
     }
+}
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    bool maximize=false;
+    
+    if(nrhs<1){
+        mexErrMsgTxt("Not enough inputs.");
+    }
+    
+    if(nrhs==2){
+        maximize=getBoolFromMatlab(prhs[1]);
+    }
+    
+    if(nrhs>2) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+    
+    if(nlhs>5) {
+        mexErrMsgTxt("Too many outputs.");
+    }
+    
+    /*Verify the validity of the assignment matrix.*/
+    if(mxIsComplex(prhs[0])) {
+        mexErrMsgTxt("The cost matrix must be real.");
+    }
+    if(mxIsEmpty(prhs[0])) {
+        mexErrMsgTxt("The cost matrix is empty.");
+    }
+    if(mxGetNumberOfDimensions(prhs[0])>2) {
+        mexErrMsgTxt("The cost matrix has too many dimensions.");
+    }
+    
+    switch(mxGetClassID(prhs[0])) {
+        case mxDOUBLE_CLASS:
+            assign2DForType<double>(nlhs,plhs,prhs[0],maximize);
+            break;
+        case mxSINGLE_CLASS:
+            assign2DForType<float>(nlhs,plhs,prhs[0],maximize);
+            break;
+        case mxINT32_CLASS:
+            assign2DForType<int32_t>(nlhs,plhs,prhs[0],maximize);
+            break;
+        case mxINT64_CLASS:
+            assign2DForType<int64_t>(nlhs,plhs,prhs[0],maximize);
+            break;
+        default:
+            mexErrMsgTxt("The cost matrix must be of class double, single, int32, or int64.");
+    }
     
-    delete problemSol;
     /* Return variables that are not requested and returned will be
      * automatically freed by Matlab when this function exits.*/
     return;
@@ -9,7 +9,10 @@ function [col4row, row4col, gain, u, v]=assign2D(C,maximize)
 %                       the smallest finite element minus the largest
 %                       element is finite when performing maximization. 
 %                       Forbidden assignments can be given costs of +Inf
-%                       for minimization and -Inf for maximization.
+%                       for minimization and -Inf for maximization. The
+%                       compiled version of this function also accepts
+%                       single, int32 and int64 matrices without
+%                       converting them to doubles.
 %           maximize    If true, the minimization problem is transformed
 %                       into a maximization problem. The default if this
 %                       parameter is omitted is false.
@@ -0,0 +1,253 @@
+/**ASSIGN3D  A C++ code (for Matlab) implementation of algorithms to solve
+ *           the axial 3D assignment problem
+ *           minimize sum_{i} C(i,phi_2(i),phi_3(i))
+ *           where phi_2 and phi_3 are length n1 arrangements of n2 and n3
+ *           items and C is an n1Xn2Xn3 cost hypermatrix with n1<=n2<=n3.
+ *
+ *INPUTS: C An n1Xn2Xn3 cost hypermatrix. The costs are real, positive or
+ *          negative numbers > -Inf. If it is not the case that
+ *          n1<=n2<=n3, then the indices of C are permuted so that is
+ *          true. The permutation of the indices is returned in the
+ *          dimsOrder vector so that the meaning of the phi2 and phi3 values
+ *          returned is clear.
+ *     algorithm An optional parameter specifying the algorithm to use to
+ *          solve the 3D assignment problem. Possible values are
+ *          0 (The default if omitted) Use the relaxation approximation of
+ *            Pattipati et al.
+ *          1 Use the relaxation approximation of Frieze and Yadegar.
+ *          2 Get an exact solution using brute-force enumeration of the
+ *            arrangements of the second dimension.
+ *    maxIter The maximum number of iterations to perform if algorithm=0 or
+ *            algorithm=1. The default if omitted or an empty matrix is
+ *            passed is 200.
+ *     epsVal The threshold on the relative duality gap used for
+ *            determining convergence if algorithm=0 or algorithm=1. The
+ *            default if omitted or an empty matrix is passed is eps(1).
+ *
+ *OUTPUTS: phi2,phi3  C(i,phi2(i),phi3(i)) is the cost for row i of the
+ *                    cost hypermatrix with its indices permuted so that
+ *                    n1<=n2<=n3.
+ *          dimsOrder The ordering of the dimensions of C for the assignment
+ *                    problem. If n1<=n2<=n3, then this is just [1,2,3].
+ *         minCostVal The cost value of the optimal assignment found.
+ *            costGap If algorithm=2, then costGap=0 as minCostVal is
+ *                    optimal. Otherwise, costGap is an upper bound for the
+ *                    difference between minCostVal and the true global
+ *                    minimum (the duality gap).
+ *If no feasible assignment with a finite cost is found, then phi2 and phi3
+ *are empty and minCostVal and costGap are -1, as with the outputs of
+ *assign2D for infeasible problems.
+ *
+ *DEPENDENCIES: assign3DCPP.hpp
+ *              assign3DCPP.cpp
+ *              ShortestPathCPP.hpp
+ *              ShortestPathCPP.cpp
+ *              MexValidation.h
+ *              mex.h
+ *              <algorithm>
+ *
+ *This is a C++ implementation of the Matlab function assign3D.m, which
+ *contains more documentation and the references for the algorithms. All
+ *of the 2D assignment problems are solved within the mex function using a
+ *single scratch space rather than calling assign2D from Matlab on every
+ *iteration. The 2D assignment problems whose dual variables are not used
+ *are warm-started from the previous iteration, so if the 2D problems have
+ *ties in their optimal solutions, the solution might differ from that of
+ *assign3D.m.
+ *
+ * The algorithm can be compiled for use in Matlab  using the
+ * CompileCLibraries function.
+ *
+ * The algorithm is run in Matlab using the command format
+ * [phi2,phi3,dimsOrder,minCostVal,costGap]=assign3D(C,algorithm,maxIter,epsVal)
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+/*This header is required by Matlab*/
+#include "mex.h"
+/*This is needed for swap*/
+#include <algorithm>
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "ShortestPathCPP.hpp"
+#include "assign3DCPP.hpp"
+
+using namespace std;
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t nVals[3], nOrig[3], dimsOrder[3], strides[3];
+    size_t numDims, n1, n2, n3, i1, i2, i3;
+    const size_t *dims;
+    int algorithm=0;
+    size_t maxIter=200;
+    double epsVal=2.220446049250313e-16;//eps(1)
+    double minCostVal, costGap;
+    const double *COrig;
+    double *CPerm=NULL;
+    const double *C;
+    ptrdiff_t *phi2, *phi3;
+    bool foundSol;
+    mxArray *phi2MATLAB, *phi3MATLAB, *dimsOrderMATLAB;
+
+    if(nrhs<1){
+        mexErrMsgTxt("Not enough inputs.");
+    }
+
+    if(nrhs>4) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+
+    if(nlhs>5) {
+        mexErrMsgTxt("Too many outputs.");
+    }
+
+    checkRealDoubleArray(prhs[0]);
+    if(mxIsEmpty(prhs[0])) {
+        mexErrMsgTxt("The cost matrix is empty.");
+    }
+
+    if(nrhs>1&&!mxIsEmpty(prhs[1])) {
+        algorithm=getIntFromMatlab(prhs[1]);
+        if(algorithm<0||algorithm>2) {
+            mexErrMsgTxt("Invalid algorithm specified");
+        }
+    }
+
+    if(nrhs>2&&!mxIsEmpty(prhs[2])) {
+        maxIter=getSizeTFromMatlab(prhs[2]);
+    }
+
+    if(nrhs>3&&!mxIsEmpty(prhs[3])) {
+        epsVal=getDoubleFromMatlab(prhs[3]);
+    }
+
+    numDims=mxGetNumberOfDimensions(prhs[0]);
+    if(numDims>3) {
+        mexErrMsgTxt("The cost matrix has too many dimensions.");
+    }
+    dims=mxGetDimensions(prhs[0]);
+    nOrig[0]=dims[0];
+    nOrig[1]=dims[1];
+    nOrig[2]=(numDims>2)?dims[2]:1;
+
+    /*The algorithms assume that n1<=n2<=n3. The dimensions are sorted
+     *using a stable insertion sort, as the sort function in Matlab is
+     *stable, to get the permutation of the indices.*/
+    for(i1=0;i1<3;i1++) {
+        dimsOrder[i1]=i1;
+    }
+    for(i1=1;i1<3;i1++) {
+        for(i2=i1;i2>0&&nOrig[dimsOrder[i2-1]]>nOrig[dimsOrder[i2]];i2--) {
+            swap(dimsOrder[i2-1],dimsOrder[i2]);
+        }
+    }
+
+    for(i1=0;i1<3;i1++) {
+        nVals[i1]=nOrig[dimsOrder[i1]];
+    }
+    n1=nVals[0];
+    n2=nVals[1];
+    n3=nVals[2];
+
+    COrig=(const double*)mxGetData(prhs[0]);
+    if(dimsOrder[0]==0&&dimsOrder[1]==1&&dimsOrder[2]==2) {
+        //No permutation is necessary, so the data is used directly.
+        C=COrig;
+    } else {
+        /*Permute the indices of C. The element (i1,i2,i3) of the permuted
+         *matrix comes from the original element whose index along
+         *original dimension dimsOrder[k] is i(k+1).*/
+        size_t origStrides[3];
+
+        origStrides[0]=1;
+        origStrides[1]=nOrig[0];
+        origStrides[2]=nOrig[0]*nOrig[1];
+        for(i1=0;i1<3;i1++) {
+            strides[i1]=origStrides[dimsOrder[i1]];
+        }
+
+        CPerm=new double[n1*n2*n3];
+        for(i3=0;i3<n3;i3++) {
+            for(i2=0;i2<n2;i2++) {
+                for(i1=0;i1<n1;i1++) {
+                    CPerm[i1+n1*(i2+n2*i3)]=COrig[i1*strides[0]+i2*strides[1]+i3*strides[2]];
+                }
+            }
+        }
+        C=CPerm;
+    }
+
+    phi2=new ptrdiff_t[2*n1];
+    phi3=phi2+n1;
+
+    foundSol=assign3DCPP(phi2,phi3,&minCostVal,&costGap,C,n1,n2,n3,algorithm,maxIter,epsVal)!=0;
+
+    if(CPerm!=NULL) {
+        delete[] CPerm;
+    }
+
+    if(foundSol) {
+        double *phi2Out, *phi3Out;
+        
+        /*Convert C++ indices to Matlab indices. The indices are returned
+         *as doubles, as in assign3D.m.*/
+        phi2MATLAB=mxCreateDoubleMatrix(n1,1,mxREAL);
+        phi3MATLAB=mxCreateDoubleMatrix(n1,1,mxREAL);
+        phi2Out=(double*)mxGetData(phi2MATLAB);
+        phi3Out=(double*)mxGetData(phi3MATLAB);
+        for(i1=0;i1<n1;i1++) {
+            phi2Out[i1]=static_cast<double>(phi2[i1]+1);
+            phi3Out[i1]=static_cast<double>(phi3[i1]+1);
+        }
+    } else {
+        phi2MATLAB=mxCreateDoubleMatrix(0,0,mxREAL);
+        phi3MATLAB=mxCreateDoubleMatrix(0,0,mxREAL);
+        minCostVal=-1;
+        costGap=-1;
+    }
+    delete[] phi2;
+
+    dimsOrderMATLAB=mxCreateDoubleMatrix(1,3,mxREAL);
+    for(i1=0;i1<3;i1++) {
+        ((double*)mxGetData(dimsOrderMATLAB))[i1]=static_cast<double>(dimsOrder[i1]+1);
+    }
+
+    //Let Matlab know that these are the return variables.
+    switch(nlhs) {
+        case 5:
+            plhs[4]=mxCreateDoubleMatrix(1,1,mxREAL);
+            *(double*)mxGetData(plhs[4])=costGap;
+        case 4:
+            plhs[3]=mxCreateDoubleMatrix(1,1,mxREAL);
+            *(double*)mxGetData(plhs[3])=minCostVal;
+        case 3:
+            plhs[2]=dimsOrderMATLAB;
+        case 2:
+            plhs[1]=phi3MATLAB;
+        default:
+            plhs[0]=phi2MATLAB;
+    }
+
+    /* Return variables that are not requested and returned will be
+     * automatically freed by Matlab when this function exits.*/
+    return;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,676 @@
+/**ASSIGNBENCHMARK A standalone C++ program (not a mex file) for timing the
+ *            C++ implementations of the assignment algorithms in the
+ *            Shared C++ Code folders on reproducible, randomly generated
+ *            problems. Matlab is not needed to compile or run it.
+ *
+ *The program is compiled from the folder containing this file using a
+ *command such as
+ *g++ -O3 -std=c++11 -pthread -I"../Shared C++ Code" -I"../../Misc/Shared C++ Code" -I"../../Mathematical Functions/Combinatorics/Shared C++ Code" -I"../../Mathematical Functions/MMOSPAApprox/Shared C++ Code" assignBenchmark.cpp "../Shared C++ Code/ShortestPathCPP.cpp" "../Shared C++ Code/assign3DCPP.cpp" "../Shared C++ Code/assignSDCPP.cpp" "../../Mathematical Functions/Combinatorics/Shared C++ Code/permCPP.cpp" "../../Mathematical Functions/Combinatorics/Shared C++ Code/getNextComboCPP.cpp" "../../Mathematical Functions/MMOSPAApprox/Shared C++ Code/MMOSPAApproxCPP.cpp" -o assignBenchmark
+ *
+ *The program is run using the command format
+ *assignBenchmark seed numReps maxSize maxThreads
+ *where all of the arguments are optional.
+ *           seed The seed of the random number generator used to create
+ *                the problems. The default if omitted is 0. A given seed
+ *                always produces the same problems on all platforms.
+ *        numReps The number of times that each problem is regenerated and
+ *                solved. The default if omitted is 5.
+ *        maxSize The largest dimension of the 2D assignment problems. The
+ *                sizes tested go up from 16 by factors of 2 to maxSize. The
+ *                other algorithms are tested on proportionally smaller
+ *                problems. The default if omitted is 256.
+ *     maxThreads The largest number of threads to use for the algorithms
+ *                that support multiple threads. The thread counts tested go
+ *                up by factors of 2 from 1. If this is zero, the number of
+ *                hardware threads is used. The default if omitted is 0.
+ *
+ *The results are written to standard output as comma-separated values with
+ *a header line. The columns are
+ *      benchmark The name of the function being timed.
+ *      generator The type of problem. This is one of
+ *                dense       Costs drawn uniformly from [0,100).
+ *                gated       A target-measurement problem as in tracking,
+ *                            with measurements outside of a validation gate
+ *                            forbidden (infinite cost) and one missed
+ *                            detection dummy row per target.
+ *                rectangular A dense problem with twice as many rows as
+ *                            columns.
+ *                degenerate  Costs drawn from {0,1,2}, so that the
+ *                            problem has a very large number of ties.
+ *       costType The type of the elements of the cost matrix.
+ *    numRow,numCol The size of the problem. For the 3D and S-D problems,
+ *                numRow is the size of each dimension and numCol is the
+ *                number of dimensions. For MMOSPA, numRow is the number of
+ *                targets and numCol the number of hypotheses.
+ *          param A benchmark-dependent parameter: k for kBest2D, the
+ *                number of sequential problems for assign2DWarmStart, the
+ *                algorithm for assign3DCPP, the number of tuples for
+ *                assignSDCPP and the number of starts for MMOSPAApproxCPP.
+ *     numThreads The number of threads used.
+ *           seed The seed used for the problem in this repetition.
+ *       wallTime The wall clock time in seconds.
+ *  augmentations The number of shortest augmenting path searches, or NA
+ *                for the algorithms that do not report it.
+ *    allocations The number of calls to operator new during the timed
+ *                region.
+ *     allocBytes The number of bytes requested from operator new during
+ *                the timed region.
+ *      objective The cost of the solution found, so that the consistency
+ *                of the results can be checked.
+ *
+ *The mex-only algorithms (such as assign2DByCol.c and assign2DAlt.c) are
+ *not included, since their implementations are in the mex gateways.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <cstring>
+#include <math.h>
+#include <new>
+#include <vector>
+#include <limits>
+#include <random>
+#include <chrono>
+#include <atomic>
+#include <thread>
+#include "ShortestPathCPP.hpp"
+#include "assign3DCPP.hpp"
+#include "assignSDCPP.hpp"
+#include "permCPP.hpp"
+#include "MMOSPAApproxCPP.hpp"
+
+using namespace std;
+
+/*The global operators new and delete are replaced so that the number of
+ *allocations made by the algorithms can be counted. The counters are
+ *atomic, because some of the algorithms allocate memory in multiple
+ *threads. As with the default operators, the array and sized forms
+ *forward to the scalar forms, so memory from new[] is always released
+ *through the matching delete[] and only the scalar pair touches malloc
+ *and free.*/
+static atomic<size_t> allocCount(0);
+static atomic<size_t> allocBytes(0);
+
+/*GCC warns about the free in the replaced operator delete when it inlines
+ *the replaced operator new, though the two are a matching pair.*/
+#if defined(__GNUC__)&&!defined(__clang__)&&__GNUC__>=11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void *operator new(size_t numBytes) {
+    void *ptr;
+
+    allocCount++;
+    allocBytes+=numBytes;
+    ptr=malloc(numBytes>0?numBytes:1);
+    if(ptr==NULL) {
+        throw bad_alloc();
+    }
+    return ptr;
+}
+
+void *operator new[](size_t numBytes) {
+    return operator new(numBytes);
+}
+
+void operator delete(void *ptr) noexcept {
+    free(ptr);
+}
+
+void operator delete[](void *ptr) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept {
+    operator delete(ptr);
+}
+
+void operator delete[](void *ptr, size_t) noexcept {
+    operator delete[](ptr);
+}
+
+#if defined(__GNUC__)&&!defined(__clang__)&&__GNUC__>=11
+#pragma GCC diagnostic pop
+#endif
+
+/*The BenchRNG class generates the random values for the problems. The
+ *distributions in the standard library are implementation-defined, so the
+ *conversion from the output of the (fully specified) 64-bit Mersenne
+ *twister to doubles and integers is done here to make the problems
+ *identical on all platforms.*/
+class BenchRNG {
+private:
+    mt19937_64 gen;
+public:
+    BenchRNG(const uint64_t seed) : gen(seed) {}
+
+    //Uniform on [0,1).
+    double uniform() {
+        return static_cast<double>(gen()>>11)*(1.0/9007199254740992.0);
+    }
+
+    //Uniform on 0 to n-1. The modulo bias is negligible for small n.
+    size_t uniformInt(const size_t n) {
+        return static_cast<size_t>(gen()%static_cast<uint64_t>(n));
+    }
+};
+
+/*The BenchTimer class records the wall clock time and the number of
+ *allocations from construction to the call of stop.*/
+class BenchTimer {
+private:
+    chrono::steady_clock::time_point startTime;
+    size_t startCount, startBytes;
+public:
+    double wallTime;
+    size_t numAllocs, numBytes;
+
+    BenchTimer() {
+        startCount=allocCount;
+        startBytes=allocBytes;
+        startTime=chrono::steady_clock::now();
+    }
+
+    void stop() {
+        const chrono::steady_clock::time_point endTime=chrono::steady_clock::now();
+        numAllocs=allocCount-startCount;
+        numBytes=allocBytes-startBytes;
+        wallTime=chrono::duration<double>(endTime-startTime).count();
+    }
+};
+
+void printHeader();
+void printRow(const char *benchmark, const char *generator, const char *costType, const size_t numRow, const size_t numCol, const size_t param, const size_t numThreads, const uint64_t seed, const BenchTimer &timer, const ptrdiff_t numAugmentations, const double objective);
+void genDense(vector<double> &C, BenchRNG &rng, const size_t numRow, const size_t numCol);
+void genGated(vector<double> &C, BenchRNG &rng, const size_t numTar);
+void genDegenerate(vector<double> &C, BenchRNG &rng, const size_t numRow, const size_t numCol);
+size_t genProblem(vector<double> &C, BenchRNG &rng, const int genType, const size_t n);
+template<class CostType>
+void benchAssign2D(const char *costTypeName, const int genType, const size_t n, const size_t numReps, const uint64_t seed);
+void benchWarmStart(const size_t n, const size_t numReps, const uint64_t seed);
+void benchKBest(const size_t n, const size_t k, const size_t numReps, const uint64_t seed);
+void benchAssign3D(const size_t n, const int algorithm, const size_t numReps, const uint64_t seed);
+void benchAssignSD(const size_t n, const size_t numThreads, const size_t numReps, const uint64_t seed);
+void benchMMOSPA(const size_t numTar, const size_t numHyp, const size_t numThreads, const size_t numReps, const uint64_t seed);
+void benchAssocProbs(const size_t n, const size_t numReps, const uint64_t seed);
+
+//The names of the generator types used by genProblem.
+static const char *genNames[4]={"dense","gated","rectangular","degenerate"};
+
+int main(int argc, char *argv[]) {
+    uint64_t seed=0;
+    size_t numReps=5;
+    size_t maxSize=256;
+    size_t maxThreads=0;
+    size_t n, numThreads;
+    int genType;
+
+    if(argc>1) {
+        seed=strtoull(argv[1],NULL,10);
+    }
+    if(argc>2) {
+        numReps=strtoul(argv[2],NULL,10);
+    }
+    if(argc>3) {
+        maxSize=strtoul(argv[3],NULL,10);
+    }
+    if(argc>4) {
+        maxThreads=strtoul(argv[4],NULL,10);
+    }
+    if(argc>5) {
+        fprintf(stderr,"Too many inputs.\n");
+        return 1;
+    }
+
+    if(maxThreads==0) {
+        maxThreads=static_cast<size_t>(thread::hardware_concurrency());
+        if(maxThreads==0) {
+            maxThreads=1;
+        }
+    }
+
+    printHeader();
+
+    for(n=16;n<=maxSize;n*=2) {
+        for(genType=0;genType<4;genType++) {
+            benchAssign2D<double>("double",genType,n,numReps,seed);
+            benchAssign2D<float>("single",genType,n,numReps,seed);
+            //Integer costs cannot represent the forbidden assignments.
+            if(genType!=1) {
+                benchAssign2D<int32_t>("int32",genType,n,numReps,seed);
+                benchAssign2D<int64_t>("int64",genType,n,numReps,seed);
+            }
+        }
+        benchWarmStart(n,numReps,seed);
+        benchKBest(n,10,numReps,seed);
+    }
+
+    for(n=4;n<=maxSize/8;n*=2) {
+        benchAssign3D(n,0,numReps,seed);
+        benchAssign3D(n,1,numReps,seed);
+    }
+
+    for(n=8;n<=maxSize/2;n*=2) {
+        for(numThreads=1;numThreads<=maxThreads;numThreads*=2) {
+            benchAssignSD(n,numThreads,numReps,seed);
+        }
+    }
+
+    for(n=4;n<=maxSize/16;n*=2) {
+        for(numThreads=1;numThreads<=maxThreads;numThreads*=2) {
+            benchMMOSPA(n,4*n,numThreads,numReps,seed);
+        }
+    }
+
+    //The permanent grows exponentially, so the sizes are kept small.
+    for(n=4;n<=12&&n<=maxSize;n+=2) {
+        benchAssocProbs(n,numReps,seed);
+    }
+
+    return 0;
+}
+
+void printHeader() {
+    printf("benchmark,generator,costType,numRow,numCol,param,numThreads,seed,wallTime,augmentations,allocations,allocBytes,objective\n");
+}
+
+void printRow(const char *benchmark, const char *generator, const char *costType, const size_t numRow, const size_t numCol, const size_t param, const size_t numThreads, const uint64_t seed, const BenchTimer &timer, const ptrdiff_t numAugmentations, const double objective) {
+/*PRINTROW Write one line of results. A negative value of numAugmentations
+ *         means that the algorithm does not report it.
+ */
+    printf("%s,%s,%s,%zu,%zu,%zu,%zu,%llu,%.9e,",benchmark,generator,costType,numRow,numCol,param,numThreads,static_cast<unsigned long long>(seed),timer.wallTime);
+    if(numAugmentations<0) {
+        printf("NA,");
+    } else {
+        printf("%zu,",static_cast<size_t>(numAugmentations));
+    }
+    printf("%zu,%zu,%.17g\n",timer.numAllocs,timer.numBytes,objective);
+}
+
+void genDense(vector<double> &C, BenchRNG &rng, const size_t numRow, const size_t numCol) {
+    const size_t numEl=numRow*numCol;
+    size_t i;
+
+    C.resize(numEl);
+    for(i=0;i<numEl;i++) {
+        C[i]=floor(100000.0*rng.uniform())/1000.0;
+    }
+}
+
+void genGated(vector<double> &C, BenchRNG &rng, const size_t numTar) {
+/*GENGATED Generate a target-measurement assignment problem. The targets
+ *         and between numTar/2 and 2*numTar measurements are placed
+ *         uniformly in a square such that there is on average about one
+ *         target per unit area. The measurements are the rows and the
+ *         targets are the columns. The cost of a measurement-target
+ *         pairing is the squared distance between them and pairings
+ *         farther than the gate (1 unit) are forbidden. One dummy row per
+ *         target holds the missed detection cost of that target.
+ */
+    const double width=sqrt(static_cast<double>(numTar));
+    const double gateVal=1.0;
+    const double inf=numeric_limits<double>::infinity();
+    const size_t numMeas=numTar/2+rng.uniformInt(3*numTar/2+1);
+    const size_t numRow=numMeas+numTar;
+    vector<double> pos(2*(numTar+numMeas));
+    size_t i, curTar, curMeas;
+
+    for(i=0;i<pos.size();i++) {
+        pos[i]=floor(1000.0*width*rng.uniform())/1000.0;
+    }
+
+    C.assign(numRow*numTar,inf);
+    for(curTar=0;curTar<numTar;curTar++) {
+        const double *tarPos=&pos[2*curTar];
+        for(curMeas=0;curMeas<numMeas;curMeas++) {
+            const double *measPos=&pos[2*(numTar+curMeas)];
+            const double dx=tarPos[0]-measPos[0];
+            const double dy=tarPos[1]-measPos[1];
+            const double dist2=dx*dx+dy*dy;
+
+            if(dist2<=gateVal) {
+                C[curMeas+numRow*curTar]=dist2;
+            }
+        }
+        C[numMeas+curTar+numRow*curTar]=gateVal;
+    }
+}
+
+void genDegenerate(vector<double> &C, BenchRNG &rng, const size_t numRow, const size_t numCol) {
+    const size_t numEl=numRow*numCol;
+    size_t i;
+
+    C.resize(numEl);
+    for(i=0;i<numEl;i++) {
+        C[i]=static_cast<double>(rng.uniformInt(3));
+    }
+}
+
+size_t genProblem(vector<double> &C, BenchRNG &rng, const int genType, const size_t n) {
+/*GENPROBLEM Generate a problem of the type given by genType with n
+ *           columns. The return value is the number of rows, which is
+ *           always at least n. The elements of C are stored by column.
+ */
+    switch(genType) {
+        case 0:
+            genDense(C,rng,n,n);
+            return n;
+        case 1:
+            genGated(C,rng,n);
+            return C.size()/n;
+        case 2:
+            genDense(C,rng,2*n,n);
+            return 2*n;
+        default:
+            genDegenerate(C,rng,n,n);
+            return n;
+    }
+}
+
+template<class CostType>
+void benchAssign2D(const char *costTypeName, const int genType, const size_t n, const size_t numReps, const uint64_t seed) {
+    vector<double> CDouble;
+    size_t curRep, i;
+
+    for(curRep=0;curRep<numReps;curRep++) {
+        const uint64_t curSeed=seed+curRep;
+        BenchRNG rng(curSeed);
+        const size_t numRow=genProblem(CDouble,rng,genType,n);
+        const size_t numCol=n;
+        vector<CostType> C(CDouble.size());
+        double objective;
+
+        /*The generated costs have at most three decimal places, so they
+         *are scaled to be integers for the integer types.*/
+        if(numeric_limits<CostType>::is_integer) {
+            for(i=0;i<C.size();i++) {
+                C[i]=static_cast<CostType>(floor(1000.0*CDouble[i]+0.5));
+            }
+        } else {
+            for(i=0;i<C.size();i++) {
+                C[i]=static_cast<CostType>(CDouble[i]);
+            }
+        }
+
+        {
+            BenchTimer timer;
+            ScratchSpaceT<CostType> workMem(numRow,numCol);
+            MurtyHypT<CostType> problemSol(numRow,numCol);
+
+            if(assign2D(numRow,numCol,false,C.data(),workMem,&problemSol)) {
+                objective=static_cast<double>(problemSol.gain);
+            } else {
+                objective=numeric_limits<double>::quiet_NaN();
+            }
+            timer.stop();
+            printRow("assign2D",genNames[genType],costTypeName,numRow,numCol,0,1,curSeed,timer,static_cast<ptrdiff_t>(workMem.numAugmentations),objective);
+        }
+    }
+}
+
+void benchWarmStart(const size_t n, const size_t numReps, const uint64_t seed) {
+/*BENCHWARMSTART Time a sequence of numProblems dense problems where each
+ *          problem is a small perturbation of the previous one, as
+ *          happens between scans in target tracking. Each problem after
+ *          the first is warm-started from the solution of the previous
+ *          one. The same sequence solved from scratch is also timed.
+ */
+    const size_t numProblems=10;
+    size_t curRep, curProb, i;
+
+    for(curRep=0;curRep<numReps;curRep++) {
+        const uint64_t curSeed=seed+curRep;
+        BenchRNG rng(curSeed);
+        vector<double> C;
+        vector<vector<double> > CSeq(numProblems);
+        double objective;
+
+        genDense(C,rng,n,n);
+        CSeq[0]=C;
+        for(curProb=1;curProb<numProblems;curProb++) {
+            for(i=0;i<C.size();i++) {
+                C[i]+=floor(1000.0*rng.uniform())/1000.0;
+            }
+            CSeq[curProb]=C;
+        }
+
+        {
+            BenchTimer timer;
+            ScratchSpace workMem(n,n);
+            MurtyHyp problemSol(n,n);
+
+            objective=0;
+            for(curProb=0;curProb<numProblems;curProb++) {
+                if(curProb==0) {
+                    assign2D(n,n,false,CSeq[curProb].data(),workMem,&problemSol);
+                } else {
+                    assign2DWarmStart(n,n,false,CSeq[curProb].data(),workMem,&problemSol);
+                }
+                objective+=problemSol.gain;
+            }
+            timer.stop();
+            printRow("assign2DWarmStart","dense","double",n,n,numProblems,1,curSeed,timer,static_cast<ptrdiff_t>(workMem.numAugmentations),objective);
+        }
+
+        {
+            BenchTimer timer;
+            ScratchSpace workMem(n,n);
+            MurtyHyp problemSol(n,n);
+
+            objective=0;
+            for(curProb=0;curProb<numProblems;curProb++) {
+                assign2D(n,n,false,CSeq[curProb].data(),workMem,&problemSol);
+                objective+=problemSol.gain;
+            }
+            timer.stop();
+            printRow("assign2DColdSequence","dense","double",n,n,numProblems,1,curSeed,timer,static_cast<ptrdiff_t>(workMem.numAugmentations),objective);
+        }
+    }
+}
+
+void benchKBest(const size_t n, const size_t k, const size_t numReps, const uint64_t seed) {
+    size_t curRep;
+
+    for(curRep=0;curRep<numReps;curRep++) {
+        const uint64_t curSeed=seed+curRep;
+        BenchRNG rng(curSeed);
+        vector<double> C;
+        vector<ptrdiff_t> col4rowBest(n*k), row4colBest(n*k);
+        vector<double> gainBest(k);
+        size_t numFound;
+
+        genDense(C,rng,n,n);
+        {
+            BenchTimer timer;
+            ScratchSpace workMem(n,n);
+
+            numFound=kBest2D(k,n,n,false,C.data(),workMem,col4rowBest.data(),row4colBest.data(),gainBest.data());
+            timer.stop();
+            printRow("kBest2D","dense","double",n,n,k,1,curSeed,timer,static_cast<ptrdiff_t>(workMem.numAugmentations),numFound>0?gainBest[numFound-1]:numeric_limits<double>::quiet_NaN());
+        }
+    }
+}
+
+void benchAssign3D(const size_t n, const int algorithm, const size_t numReps, const uint64_t seed) {
+    size_t curRep;
+
+    for(curRep=0;curRep<numReps;curRep++) {
+        const uint64_t curSeed=seed+curRep;
+        BenchRNG rng(curSeed);
+        vector<double> C;
+        vector<ptrdiff_t> phi(2*n);
+        double minCostVal, costGap;
+
+        genDense(C,rng,n,n*n);
+        {
+            BenchTimer timer;
+
+            if(assign3DCPP(phi.data(),phi.data()+n,&minCostVal,&costGap,C.data(),n,n,n,algorithm,200,2.220446049250313e-16)==0) {
+                minCostVal=numeric_limits<double>::quiet_NaN();
+            }
+            timer.stop();
+            printRow("assign3DCPP","dense","double",n,3,static_cast<size_t>(algorithm),1,curSeed,timer,-1,minCostVal);
+        }
+    }
+}
+
+void benchAssignSD(const size_t n, const size_t numThreads, const size_t numReps, const uint64_t seed) {
+/*BENCHASSIGNSD Time a sparse 3D assignment problem with n non-dummy
+ *         indices in each dimension. The tuples are all of the single-
+ *         index tuples (so a feasible solution always exists) plus about
+ *         20*n random tuples with all indices being non-dummy. This is the
+ *         type of problem arising in gated multisensor data association.
+ */
+    const size_t S=3;
+    size_t curRep, i, s;
+
+    for(curRep=0;curRep<numReps;curRep++) {
+        const uint64_t curSeed=seed+curRep;
+        BenchRNG rng(curSeed);
+        const size_t numRandTuples=20*n;
+        const size_t numTuples=S*n+numRandTuples;
+        const size_t dimSizes[3]={n,n,n};
+        vector<size_t> tuples(S*numTuples,0);
+        vector<double> costs(numTuples);
+        vector<size_t> tupleSel(numTuples);
+        size_t numSel, curTuple;
+        double minCostVal, costGap;
+
+        curTuple=0;
+        for(s=0;s<S;s++) {
+            for(i=1;i<=n;i++) {
+                tuples[s+S*curTuple]=i;
+                costs[curTuple]=0;
+                curTuple++;
+            }
+        }
+        for(;curTuple<numTuples;curTuple++) {
+            for(s=0;s<S;s++) {
+                tuples[s+S*curTuple]=1+rng.uniformInt(n);
+            }
+            costs[curTuple]=-floor(100000.0*rng.uniform())/1000.0;
+        }
+
+        {
+            BenchTimer timer;
+
+            if(assignSDCPP(tupleSel.data(),&numSel,&minCostVal,&costGap,tuples.data(),costs.data(),numTuples,S,dimSizes,100,1e-6,numThreads)==0) {
+                minCostVal=numeric_limits<double>::quiet_NaN();
+            }
+            timer.stop();
+            printRow("assignSDCPP","gated","double",n,S,numTuples,numThreads,curSeed,timer,-1,minCostVal);
+        }
+    }
+}
+
+void benchMMOSPA(const size_t numTar, const size_t numHyp, const size_t numThreads, const size_t numReps, const uint64_t seed) {
+    const size_t xDim=4;
+    const size_t numStarts=8;
+    size_t curRep, i;
+
+    for(curRep=0;curRep<numReps;curRep++) {
+        const uint64_t curSeed=seed+curRep;
+        BenchRNG rng(curSeed);
+        vector<double> x(xDim*numTar*numHyp), w(numHyp);
+        vector<double> MMOSPAEst(xDim*numTar);
+        vector<size_t> orderList(numTar*numHyp);
+        double wSum=0, objective;
+
+        for(i=0;i<x.size();i++) {
+            x[i]=rng.uniform();
+        }
+        for(i=0;i<numHyp;i++) {
+            w[i]=0.01+rng.uniform();
+            wSum+=w[i];
+        }
+        for(i=0;i<numHyp;i++) {
+            w[i]/=wSum;
+        }
+
+        {
+            BenchTimer timer;
+
+            MMOSPAApproxCPP(MMOSPAEst.data(),orderList.data(),x.data(),w.data(),xDim,numTar,numHyp,1,numStarts,numThreads);
+            timer.stop();
+
+            //The objective is the squared norm of the estimate.
+            objective=0;
+            for(i=0;i<MMOSPAEst.size();i++) {
+                objective+=MMOSPAEst[i]*MMOSPAEst[i];
+            }
+            printRow("MMOSPAApproxCPP","dense","double",numTar,numHyp,numStarts,numThreads,curSeed,timer,-1,objective);
+        }
+    }
+}
+
+void benchAssocProbs(const size_t n, const size_t numReps, const uint64_t seed) {
+/*BENCHASSOCPROBS Time the computation of the matrix of exact assignment
+ *          probabilities of an nXn likelihood matrix using matrix
+ *          permanents, as done by calc2DAssignmentProbs with
+ *          diagAugment=false.
+ */
+    size_t curRep, i;
+
+    for(curRep=0;curRep<numReps;curRep++) {
+        const uint64_t curSeed=seed+curRep;
+        BenchRNG rng(curSeed);
+        vector<double> A, beta(n*n);
+        double objective;
+
+        genDense(A,rng,n,n);
+        {
+            BenchTimer timer;
+            const size_t numKept=n-1;
+            size_t *buffer=new size_t[3*numKept];
+            size_t *rows2Keep=buffer;
+            size_t *cols2Keep=rows2Keep+numKept;
+            size_t *buff4PermFunc=cols2Keep+numKept;
+            size_t curRow, curCol;
+
+            for(curRow=0;curRow<n;curRow++) {
+                for(i=curRow;i<numKept;i++) {
+                    rows2Keep[i]=i+1;
+                }
+                for(curCol=0;curCol<n;curCol++) {
+                    for(i=curCol;i<numKept;i++) {
+                        cols2Keep[i]=i+1;
+                    }
+                    beta[curRow+curCol*n]=A[curRow+curCol*n]*permCPPSkip(A.data(),n,rows2Keep,cols2Keep,numKept,numKept,buff4PermFunc);
+                    cols2Keep[curCol]=curCol;
+                }
+                rows2Keep[curRow]=curRow;
+            }
+            delete[] buffer;
+            timer.stop();
+
+            //The sum of any row of beta is the permanent of A.
+            objective=0;
+            for(curCol=0;curCol<n;curCol++) {
+                objective+=beta[n*curCol];
+            }
+            printRow("calc2DAssignmentProbs","dense","double",n,n,0,1,curSeed,timer,-1,objective);
+        }
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,223 @@
+/**ASSIGNSD A C++ code (for Matlab) implementation of a generalized S-D
+ *          assignment algorithm for sparse lists of hypotheses. This
+ *          approximately solves the problem
+ *          minimize sum_{z} costs(z)*rho(z)
+ *          over binary rho, where each z is a column of tuples, subject
+ *          to the constraint that every nonzero index of every dimension
+ *          is used by exactly one chosen tuple. Index 0 in each dimension
+ *          is a dummy index (for example, a missed detection or a false
+ *          alarm) that can be used by any number of tuples.
+ *
+ *INPUTS: tuples An SXnumTuples matrix of the indices of the hypotheses.
+ *               The indices in each dimension are integers >=0 and S>=2.
+ *               The number of non-dummy indices in dimension s is taken to
+ *               be max(tuples(s,:)). No tuple can have all indices equal
+ *               to zero. The tuples that are not given are not allowed,
+ *               so a dense S-dimensional cost hypermatrix never has to be
+ *               formed.
+ *         costs A numTuplesX1 or 1XnumTuples vector of the finite costs
+ *               of the tuples.
+ *       maxIter The maximum number of subgradient iterations to perform
+ *               at each level of the relaxation. The default if omitted or
+ *               an empty matrix is passed is 200.
+ *        epsVal The threshold on the relative duality gap used for
+ *               determining convergence. The default if omitted or an
+ *               empty matrix is passed is eps(1).
+ *    numThreads The number of threads to use for evaluating the dual cost
+ *               function. The default if omitted or an empty matrix is
+ *               passed is 0, which means that the number of hardware
+ *               threads is used. Threads are only used on problems with
+ *               many tuples.
+ *
+ *OUTPUTS: tupleIdx A numSelX1 vector of the indices of the columns of
+ *                  tuples that are in the assignment found.
+ *       minCostVal The cost value of the assignment found.
+ *          costGap An upper bound for the difference between minCostVal
+ *                  and the true global minimum (the duality gap). If S=2,
+ *                  then costGap=0, as the solution is optimal.
+ *
+ *DEPENDENCIES: assignSDCPP.hpp
+ *              assignSDCPP.cpp
+ *              ShortestPathCPP.hpp
+ *              ShortestPathCPP.cpp
+ *              parallelForCPP.hpp
+ *              MexValidation.h
+ *              mex.h
+ *
+ *The constraints of dimensions 3 to S are relaxed using Lagrange
+ *multipliers, leaving a 2D assignment problem that is solved with the
+ *same shortest augmenting path code as assign2D. Feasible solutions are
+ *found by recursively solving the (S-1)-dimensional problems obtained by
+ *fixing the pairs of indices of the first two dimensions. More details
+ *are given in assignSDCPP.hpp. The approach is that of
+ *S. Deb, M. Yeddanapudi, K. Pattipati, and Y. Bar-Shalom, "A generalized
+ *S-D assignment algorithm for multisensor-multitarget state estimation,"
+ *IEEE Transactions on Aerospace and Electronic Systems, vol. 33, no. 2,
+ *pp. 523-538, Apr. 1997.
+ *If the problem is infeasible or no feasible solution was found, an error
+ *is raised. As the algorithm is approximate for S>2, a feasible solution
+ *is not guaranteed to be found when only a few tuples are given.
+ *
+ * The algorithm can be compiled for use in Matlab  using the
+ * CompileCLibraries function.
+ *
+ * The algorithm is run in Matlab using the command format
+ * [tupleIdx,minCostVal,costGap]=assignSD(tuples,costs,maxIter,epsVal,numThreads)
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+/*This header is required by Matlab*/
+#include "mex.h"
+/*This is needed for copy*/
+#include <algorithm>
+//Needed for floor
+#include <math.h>
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "assignSDCPP.hpp"
+
+using namespace std;
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t S, numTuples, curTuple, s, numSel;
+    size_t maxIter=200;
+    double epsVal=2.220446049250313e-16;//eps(1)
+    size_t numThreads=0;
+    double minCostVal, costGap;
+    const double *tuplesDouble, *costs;
+    size_t *tuples, *dimSizes, *tupleSel;
+    mxArray *tupleIdxMATLAB;
+
+    if(nrhs<2){
+        mexErrMsgTxt("Not enough inputs.");
+    }
+
+    if(nrhs>5) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+
+    if(nlhs>3) {
+        mexErrMsgTxt("Too many outputs.");
+    }
+
+    checkRealDoubleArray(prhs[0]);
+    checkRealDoubleArray(prhs[1]);
+    if(mxIsEmpty(prhs[0])) {
+        mexErrMsgTxt("The tuple matrix is empty.");
+    }
+
+    S=mxGetM(prhs[0]);
+    numTuples=mxGetN(prhs[0]);
+    if(S<2) {
+        mexErrMsgTxt("The tuples must have at least two dimensions.");
+    }
+    if(mxGetNumberOfElements(prhs[1])!=numTuples) {
+        mexErrMsgTxt("The number of costs does not match the number of tuples.");
+    }
+
+    if(nrhs>2&&!mxIsEmpty(prhs[2])) {
+        maxIter=getSizeTFromMatlab(prhs[2]);
+    }
+
+    if(nrhs>3&&!mxIsEmpty(prhs[3])) {
+        epsVal=getDoubleFromMatlab(prhs[3]);
+    }
+
+    if(nrhs>4&&!mxIsEmpty(prhs[4])) {
+        numThreads=getSizeTFromMatlab(prhs[4]);
+    }
+
+    tuplesDouble=(const double*)mxGetData(prhs[0]);
+    costs=(const double*)mxGetData(prhs[1]);
+
+    for(curTuple=0;curTuple<numTuples;curTuple++) {
+        if(!mxIsFinite(costs[curTuple])) {
+            mexErrMsgTxt("The costs must be finite.");
+        }
+    }
+
+    /*Convert the tuples to size_t values and find the number of non-dummy
+     *indices in each dimension. The validation is done before anything is
+     *allocated.*/
+    for(curTuple=0;curTuple<numTuples;curTuple++) {
+        bool allZero=true;
+
+        for(s=0;s<S;s++) {
+            const double curVal=tuplesDouble[s+curTuple*S];
+
+            if(!(curVal>=0)||curVal!=floor(curVal)) {
+                mexErrMsgTxt("The tuple indices must be nonnegative integers.");
+            }
+            if(curVal!=0) {
+                allZero=false;
+            }
+        }
+
+        if(allZero) {
+            mexErrMsgTxt("A tuple has all indices equal to zero.");
+        }
+    }
+
+    tuples=new size_t[S*numTuples+S+numTuples];
+    dimSizes=tuples+S*numTuples;
+    tupleSel=dimSizes+S;
+    fill(dimSizes,dimSizes+S,0);
+    for(curTuple=0;curTuple<numTuples;curTuple++) {
+        for(s=0;s<S;s++) {
+            const size_t curIdx=static_cast<size_t>(tuplesDouble[s+curTuple*S]);
+
+            tuples[s+curTuple*S]=curIdx;
+            if(curIdx>dimSizes[s]) {
+                dimSizes[s]=curIdx;
+            }
+        }
+    }
+
+    if(assignSDCPP(tupleSel,&numSel,&minCostVal,&costGap,tuples,costs,numTuples,S,dimSizes,maxIter,epsVal,numThreads)==0) {
+        delete[] tuples;
+        mexErrMsgTxt("No feasible assignment was found.");
+    }
+
+    //Sort the indices and convert them to Matlab indices.
+    sort(tupleSel,tupleSel+numSel);
+    tupleIdxMATLAB=mxCreateDoubleMatrix(numSel,1,mxREAL);
+    for(curTuple=0;curTuple<numSel;curTuple++) {
+        ((double*)mxGetData(tupleIdxMATLAB))[curTuple]=static_cast<double>(tupleSel[curTuple]+1);
+    }
+    delete[] tuples;
+
+    //Let Matlab know that these are the return variables.
+    switch(nlhs) {
+        case 3:
+            plhs[2]=mxCreateDoubleMatrix(1,1,mxREAL);
+            *(double*)mxGetData(plhs[2])=costGap;
+        case 2:
+            plhs[1]=mxCreateDoubleMatrix(1,1,mxREAL);
+            *(double*)mxGetData(plhs[1])=minCostVal;
+        default:
+            plhs[0]=tupleIdxMATLAB;
+    }
+
+    /* Return variables that are not requested and returned will be
+     * automatically freed by Matlab when this function exits.*/
+    return;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
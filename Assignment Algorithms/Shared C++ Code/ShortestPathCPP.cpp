@@ -21,30 +21,40 @@
 #include <math.h>
 //Needed for bsearch and qsort.
 #include <cstdlib>
+//Needed for memcpy and memmove.
+#include <cstring>
 
 using namespace std;
 
+template<class CostType>
 struct pMurtyHyp {
-/* This structure is defined so that pointers to MurtyHyp classes can be
+/* This structure is defined so that pointers to MurtyHypT classes can be
  * placed in the standard C++ priority queue structure.*/
-	MurtyHyp *ptr;
+	MurtyHypT<CostType> *ptr;
 
     inline bool operator< (const pMurtyHyp &other) const {
 		return ptr->gain > other.ptr->gain;
 	}
     
-	inline pMurtyHyp(MurtyHyp *in) {
+	inline pMurtyHyp(MurtyHypT<CostType> *in) {
 		ptr = in;
 	}
 };
 
 //Prototypes for functions used in this file that are not present in
 //the header ShortestPathCPP.hpp.
-void calcGain(MurtyHyp *problemSol,const ScratchSpace &workMem,const size_t numRow,const size_t numCol4Gain);
-void updateDualAndAugment(MurtyHyp *problemSol,const ScratchSpace& workMem,const size_t curUnassignedCol, const size_t numColsScanned,const size_t numDim,const ptrdiff_t sink,const double delta);
-void split(MurtyHyp *parentHyp,priority_queue<pMurtyHyp> &HypQueue, ScratchSpace &workMem, const size_t numVarCol,const size_t numDim);
-double makeCostMatrixSafe(double *CMod,const double *COrig,const size_t numEl, const bool maximize);
-MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem,const size_t curUnassignedCol, size_t numRow2Scan, const size_t numVarCol, const size_t numDim);
+template<class CostType>
+void calcGain(MurtyHypT<CostType> *problemSol,const ScratchSpaceT<CostType> &workMem,const size_t numRow,const size_t numCol4Gain);
+template<class CostType>
+void updateDualAndAugment(MurtyHypT<CostType> *problemSol,const ScratchSpaceT<CostType>& workMem,const size_t curUnassignedCol, const size_t numColsScanned,const size_t numDim,const ptrdiff_t sink,const typename AssignCostTraits<CostType>::DualType delta);
+template<class CostType>
+void split(MurtyHypT<CostType> *parentHyp,priority_queue<pMurtyHyp<CostType> > &HypQueue, ScratchSpaceT<CostType> &workMem, const size_t numVarCol,const size_t numDim);
+template<class CostType>
+CostType makeCostMatrixSafe(ScratchSpaceT<CostType> &workMem,const CostType *C,const size_t numRow,const size_t numCol, const bool maximize);
+template<class CostType>
+MurtyHypT<CostType> *shortestPathUpdateCPP(const MurtyHypT<CostType> *parentHyp, ScratchSpaceT<CostType> &workMem,const size_t curUnassignedCol, size_t numRow2Scan, const size_t numVarCol, const size_t numDim);
+template<class CostType>
+int augmentFromColCPP(MurtyHypT<CostType> *problemSol,ScratchSpaceT<CostType> &workMem,const size_t numRow,const size_t curUnassignedCol);
 
 
 inline int compare (const void * a, const void * b) {
@@ -53,13 +63,14 @@ inline int compare (const void * a, const void * b) {
   return (int)( *(ptrdiff_t*)a - *(ptrdiff_t*)b );
 }
 
-void calcGain(MurtyHyp *problemSol,const ScratchSpace &workMem,const size_t numRow,const size_t numCol4Gain) {
+template<class CostType>
+void calcGain(MurtyHypT<CostType> *problemSol,const ScratchSpaceT<CostType> &workMem,const size_t numRow,const size_t numCol4Gain) {
 /*CALCGAIN: Compute the cost of a particular assignment specified by
  *          problemSol.
  *
- *INPUTS: problemSol  A pointer to a MurtyHyp in which the gain result will
+ *INPUTS: problemSol  A pointer to a MurtyHypT in which the gain result will
  *                    be placed and that holds a solution.
- *        workMem     An instance of the ScratchSpace class that holds a
+ *        workMem     An instance of the ScratchSpaceT class that holds a
  *                    pointer to the cost matrix C.
  *
  *OUTPUTS: Nothing is returned; the cost (gain) of the assignment specified
@@ -67,16 +78,17 @@ void calcGain(MurtyHyp *problemSol,const ScratchSpace &workMem,const size_t numR
  **/
     
     size_t curCol;
-    double gain=0;
+    typename AssignCostTraits<CostType>::DualType gain=0;
     
     for(curCol=0;curCol<numCol4Gain;curCol++){
-       gain=gain+workMem.C[curCol*numRow+(size_t)problemSol->row4col[curCol]];
+       gain=gain+workMem.cost((size_t)problemSol->row4col[curCol],curCol,numRow);
     }
 
     problemSol->gain=gain;
 }
 
-void updateDualAndAugment(MurtyHyp *problemSol,const ScratchSpace& workMem,const size_t curUnassignedCol, const size_t numColsScanned,const size_t numDim,const ptrdiff_t sink,const double delta){
+template<class CostType>
+void updateDualAndAugment(MurtyHypT<CostType> *problemSol,const ScratchSpaceT<CostType>& workMem,const size_t curUnassignedCol, const size_t numColsScanned,const size_t numDim,const ptrdiff_t sink,const typename AssignCostTraits<CostType>::DualType delta){
 /*UPDATEDUALANDAUGMENT Update the dual random variables when computing the
  *               shortest path or when updating a shortest path hypothesis.
  *               This also removes the sink row from those that need to be
@@ -113,11 +125,114 @@ void updateDualAndAugment(MurtyHyp *problemSol,const ScratchSpace& workMem,const
     } while(curCol!=curUnassignedCol);
 }
 
-int shortestPathCPP(MurtyHyp *problemSol,ScratchSpace &workMem,const size_t numRow, const size_t numCol, const size_t numCol4Gain) {
+template<class CostType>
+int augmentFromColCPP(MurtyHypT<CostType> *problemSol,ScratchSpaceT<CostType> &workMem,const size_t numRow,const size_t curUnassignedCol) {
+/*AUGMENTFROMCOLCPP Find the shortest augmenting path starting at the
+ *                  unassigned column curUnassignedCol, update the dual
+ *                  variables and augment the assignment in problemSol
+ *                  along the path. The dual variables in problemSol must
+ *                  be feasible and all assigned elements must have zero
+ *                  reduced cost. The return value is 1 if no augmenting
+ *                  path with a finite cost exists; otherwise it is zero.
+ **/
+    size_t curRow, curCol, numRow2Scan,numColsScanned;
+    ptrdiff_t sink;
+    typename AssignCostTraits<CostType>::DualType delta;
+
+    workMem.numAugmentations++;
+
+    /* Mark everything as not yet scanned. A 1 will be placed in each
+     * row entry as it is scanned.*/
+    numColsScanned=0;
+    fill_n(workMem.ScannedRows,numRow,false);
+    /* Initially, the cost of the shortest path to each column is not
+     * known and will be made infinite.*/
+    fill_n(workMem.shortestPathCost,numRow,AssignCostTraits<CostType>::infVal());
+
+    /*All rows need to be scanned.*/
+    for(curRow=0;curRow<numRow;curRow++){
+        workMem.Row2Scan[curRow]=(ptrdiff_t)curRow;
+    }
+
+    numRow2Scan=numRow;
+    /*pred will be used to keep track of the shortest path.*/
+
+    /*Sink will hold the final index of the shortest augmenting path.
+     *If the problem is not feasible, then sink will remain -1.*/
+    sink=-1;
+    delta=0;
+    curCol=curUnassignedCol;
+
+    do {
+        typename AssignCostTraits<CostType>::DualType minVal;
+        //The initialization is just to silence a warning if compiling
+        //using -Wconditional-uninitialized.
+        size_t curRowScan,closestRow,closestRowScan=0;
+        /*Mark the current column as having been visited.*/
+        workMem.ScannedColIdx[numColsScanned]=curCol;
+        numColsScanned++;
+
+        /*Scan all of the columns that have not already been scanned.*/
+        minVal=AssignCostTraits<CostType>::infVal();
+        for(curRowScan=0;curRowScan<numRow2Scan;curRowScan++) {
+            typename AssignCostTraits<CostType>::DualType reducedCost;
+
+            curRow=(size_t)workMem.Row2Scan[curRowScan];
+            reducedCost=delta+workMem.cost(curRow,curCol,numRow)-problemSol->u[curCol]-problemSol->v[curRow];
+
+            if(reducedCost<workMem.shortestPathCost[curRow]){
+                workMem.pred[curRow]=curCol;
+                workMem.shortestPathCost[curRow]=reducedCost;
+            }
+
+            //Find the minimum unassigned column that was scanned.
+            if(workMem.shortestPathCost[curRow]<minVal){
+                minVal=workMem.shortestPathCost[curRow];
+                closestRowScan=curRowScan;
+            }
+        }
+
+        if(minVal==AssignCostTraits<CostType>::infVal()) {
+           /* If the minimum cost column is not finite, then the
+            * problem is not feasible.*/
+            return 1;
+        }
+
+        /* Change the index from the relative column index to the
+         * absolute column index.*/
+        closestRow=(size_t)workMem.Row2Scan[closestRowScan];
+
+        /* Add the closest column to the list of scanned columns and
+         * delete it from the list of columns to scan by shifting all
+         * of the items after it over by one.
+         */
+        workMem.ScannedRows[closestRow]=true;
+
+        memmove(workMem.Row2Scan+closestRowScan,workMem.Row2Scan+closestRowScan+1,(numRow2Scan-closestRowScan)*sizeof(ptrdiff_t));
+        numRow2Scan--;//One fewer row to scan.           
+
+        delta=workMem.shortestPathCost[closestRow];
+
+        //If we have reached an unassigned row.
+        if(problemSol->col4row[closestRow]==-1) {
+            sink=(ptrdiff_t)closestRow;
+        } else{
+            curCol=(size_t)problemSol->col4row[closestRow];
+        }            
+    } while(sink==-1);
+
+/* Next, update the dual variables.*/
+
+    updateDualAndAugment(problemSol,workMem,curUnassignedCol, numColsScanned,numRow,sink,delta);
+    return 0;
+}
+
+template<class CostType>
+int shortestPathCPP(MurtyHypT<CostType> *problemSol,ScratchSpaceT<CostType> &workMem,const size_t numRow, const size_t numCol, const size_t numCol4Gain) {
 /*SHORTESTPATHCPP A C++ implementation of the basic shortest augmenting
  *                path 2D assignment algorithm.
  **/
-    size_t curRow, curCol, curUnassignedCol;
+    size_t curUnassignedCol;
     
     /* These will hold the indices of the assigned things. row4col will be
      * initiaized with -1 values to indicate unassigned columns. The
@@ -134,105 +249,97 @@ int shortestPathCPP(MurtyHyp *problemSol,ScratchSpace &workMem,const size_t numR
     fill_n(problemSol->forbiddenActiveRows,numRow,false);
  
     for(curUnassignedCol=0;curUnassignedCol<numCol;curUnassignedCol++){
-        size_t numRow2Scan,numColsScanned;
-        ptrdiff_t sink;
-        double delta;
-/* First, find the shortest augmenting path starting at
- * curUnassignedCol.*/
-        
-        /* Mark everything as not yet scanned. A 1 will be placed in each
-         * row entry as it is scanned.*/
-        numColsScanned=0;
-        fill_n(workMem.ScannedRows,numRow,false);
-        /* Initially, the cost of the shortest path to each column is not
-         * known and will be made infinite.*/
-        fill_n(workMem.shortestPathCost,numRow,numeric_limits<double>::infinity());
-        
-        /*All rows need to be scanned.*/
-        for(curRow=0;curRow<numRow;curRow++){
-            workMem.Row2Scan[curRow]=(ptrdiff_t)curRow;
+        if(augmentFromColCPP(problemSol,workMem,numRow,curUnassignedCol)) {
+            problemSol->gain=-1;
+            return 1;
         }
+    }
+    
+    //Determine the gain to return
+    calcGain(problemSol,workMem,numRow,numCol4Gain);    
+    problemSol->forbiddenActiveRows[problemSol->row4col[0]]=true;
+    return 0;
+}
 
-        numRow2Scan=numRow;
-        /*pred will be used to keep track of the shortest path.*/
+template<class CostType>
+int shortestPathWarmStartCPP(MurtyHypT<CostType> *problemSol,ScratchSpaceT<CostType> &workMem,const size_t numRow,const size_t numCol) {
+/*SHORTESTPATHWARMSTARTCPP A C++ implementation of the shortest augmenting
+ *                path 2D assignment algorithm that inherits the row dual
+ *                variables and the assignment in problemSol from the
+ *                solution of a previous problem of the same size.
+ **/
+    size_t curRow,curCol;
+    
+    /* The column dual variables are chosen as the largest values that are
+     * feasible given the inherited row dual variables. Assignments that
+     * are still tight (have zero reduced cost) are kept; all others are
+     * removed and the columns are reassigned below.*/
+    fill_n(problemSol->col4row,numRow,-1);
+    for(curCol=0;curCol<numCol;curCol++) {
+        const ptrdiff_t prevRow=problemSol->row4col[curCol];
+        typename AssignCostTraits<CostType>::DualType minVal=AssignCostTraits<CostType>::infVal();
         
-        /*Sink will hold the final index of the shortest augmenting path.
-         *If the problem is not feasible, then sink will remain -1.*/
-        sink=-1;
-        delta=0;
-        curCol=curUnassignedCol;
-
-        do {
-            double minVal;
-            //The initialization is just to silence a warning if compiling
-            //using -Wconditional-uninitialized.
-            size_t curRowScan,closestRow,closestRowScan=0;
-            /*Mark the current column as having been visited.*/
-            workMem.ScannedColIdx[numColsScanned]=curCol;
-            numColsScanned++;
-            
-            /*Scan all of the columns that have not already been scanned.*/
-            minVal=numeric_limits<double>::infinity();
-            for(curRowScan=0;curRowScan<numRow2Scan;curRowScan++) {
-                double reducedCost;
-                
-                curRow=(size_t)workMem.Row2Scan[curRowScan];
-                reducedCost=delta+workMem.C[curRow+curCol*numRow]-problemSol->u[curCol]-problemSol->v[curRow];
-                
-                if(reducedCost<workMem.shortestPathCost[curRow]){
-                    workMem.pred[curRow]=curCol;
-                    workMem.shortestPathCost[curRow]=reducedCost;
-                }
-
-                //Find the minimum unassigned column that was scanned.
-                if(workMem.shortestPathCost[curRow]<minVal){
-                    minVal=workMem.shortestPathCost[curRow];
-                    closestRowScan=curRowScan;
-                }
+        for(curRow=0;curRow<numRow;curRow++) {
+            const typename AssignCostTraits<CostType>::DualType reducedCost=workMem.cost(curRow,curCol,numRow)-problemSol->v[curRow];
+            if(reducedCost<minVal) {
+                minVal=reducedCost;
             }
-            
-            if(minVal==numeric_limits<double>::infinity()) {
-               /* If the minimum cost column is not finite, then the
-                * problem is not feasible.*/
-                problemSol->gain=-1;
-                return 1;
-            }
-            
-            /* Change the index from the relative column index to the
-             * absolute column index.*/
-            closestRow=(size_t)workMem.Row2Scan[closestRowScan];
+        }
         
-            /* Add the closest column to the list of scanned columns and
-             * delete it from the list of columns to scan by shifting all
-             * of the items after it over by one.
-             */
-            workMem.ScannedRows[closestRow]=true;
-            
-            memmove(workMem.Row2Scan+closestRowScan,workMem.Row2Scan+closestRowScan+1,(numRow2Scan-closestRowScan)*sizeof(ptrdiff_t));
-            numRow2Scan--;//One fewer row to scan.           
-            
-            delta=workMem.shortestPathCost[closestRow];
-            
-            //If we have reached an unassigned row.
-            if(problemSol->col4row[closestRow]==-1) {
-                sink=(ptrdiff_t)closestRow;
-            } else{
-                curCol=(size_t)problemSol->col4row[closestRow];
-            }            
-        } while(sink==-1);
+        if(minVal==AssignCostTraits<CostType>::infVal()) {
+            problemSol->gain=-1;
+            return 1;
+        }
+        problemSol->u[curCol]=minVal;
         
-/* Next, update the dual variables.*/
+        if(prevRow>=0&&(size_t)prevRow<numRow&&problemSol->col4row[prevRow]==-1&&workMem.cost((size_t)prevRow,curCol,numRow)-problemSol->v[prevRow]==minVal) {
+            problemSol->col4row[prevRow]=(ptrdiff_t)curCol;
+        } else {
+            problemSol->row4col[curCol]=-1;
+        }
+    }
+    problemSol->activeCol=0;
+    fill_n(problemSol->forbiddenActiveRows,numRow,false);
+    
+    for(curCol=0;curCol<numCol;curCol++){
+        if(problemSol->row4col[curCol]==-1&&augmentFromColCPP(problemSol,workMem,numRow,curCol)) {
+            problemSol->gain=-1;
+            return 1;
+        }
+    }
+    
+    /* When numRow>numCol, the inherited dual variables only form an
+     * optimal dual solution if all unassigned rows have the largest row
+     * dual variable. In that case, the dual variables are shifted so that
+     * the unassigned rows have zero dual values, as when starting cold.
+     * Otherwise, the problem is solved again without a warm start.*/
+    if(numRow>numCol) {
+        const typename AssignCostTraits<CostType>::DualType vMax=*max_element(problemSol->v,problemSol->v+numRow);
         
-        updateDualAndAugment(problemSol,workMem,curUnassignedCol, numColsScanned,numRow,sink,delta);
+        for(curRow=0;curRow<numRow;curRow++) {
+            if(problemSol->col4row[curRow]==-1&&problemSol->v[curRow]!=vMax) {
+                return shortestPathCPP(problemSol,workMem,numRow,numCol,numCol);
+            }
+        }
+        
+        if(vMax!=0) {
+            for(curRow=0;curRow<numRow;curRow++) {
+                problemSol->v[curRow]-=vMax;
+            }
+            for(curCol=0;curCol<numCol;curCol++) {
+                problemSol->u[curCol]+=vMax;
+            }
+        }
     }
     
     //Determine the gain to return
-    calcGain(problemSol,workMem,numRow,numCol4Gain);    
+    calcGain(problemSol,workMem,numRow,numCol);
     problemSol->forbiddenActiveRows[problemSol->row4col[0]]=true;
     return 0;
 }
 
-MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem,const size_t curUnassignedCol, size_t numRow2Scan, const size_t numVarCol, const size_t numDim) {
+template<class CostType>
+MurtyHypT<CostType> *shortestPathUpdateCPP(const MurtyHypT<CostType> *parentHyp, ScratchSpaceT<CostType> &workMem,const size_t curUnassignedCol, size_t numRow2Scan, const size_t numVarCol, const size_t numDim) {
 /*SHORTESTPATHUPDATECPP
  *
  * This is a realization of the update inheriting dual variables as
@@ -254,18 +361,19 @@ MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem
      **/
     size_t curRow,curCol,numColsScanned;
     ptrdiff_t sink;
-    double delta;
-    MurtyHyp *problemSol;
+    typename AssignCostTraits<CostType>::DualType delta;
+    MurtyHypT<CostType> *problemSol;
 
-    problemSol= new MurtyHyp(numDim,numDim);
+    problemSol= new MurtyHypT<CostType>(numDim,numDim);
+    workMem.numAugmentations++;
 
     //Copy the appropriate things that are to be inherited.
     problemSol->activeCol=curUnassignedCol;
     
     memcpy(problemSol->row4col,parentHyp->row4col,numDim*sizeof(ptrdiff_t));
     memcpy(problemSol->col4row,parentHyp->col4row,numDim*sizeof(ptrdiff_t));
-    memcpy(problemSol->u,parentHyp->u,numDim*sizeof(double));
-    memcpy(problemSol->v,parentHyp->v,numDim*sizeof(double));
+    memcpy(problemSol->u,parentHyp->u,numDim*sizeof(typename AssignCostTraits<CostType>::DualType));
+    memcpy(problemSol->v,parentHyp->v,numDim*sizeof(typename AssignCostTraits<CostType>::DualType));
     memcpy(problemSol->forbiddenActiveRows,workMem.forbiddenActiveRows,numDim*sizeof(bool));
 
     //Remove the association of the current row/ column.
@@ -281,7 +389,7 @@ MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem
     fill_n(workMem.ScannedRows,numDim,false);
     /* Initially, the cost of the shortest path to each column is not
      * known and will be made infinite.*/
-    fill_n(workMem.shortestPathCost,numDim,numeric_limits<double>::infinity());
+    fill_n(workMem.shortestPathCost,numDim,AssignCostTraits<CostType>::infVal());
 
     /*Sink will hold the final index of the shortest augmenting path.
      *If the problem is not feasible, then sink will remain -1.*/
@@ -290,7 +398,7 @@ MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem
     curCol=curUnassignedCol;
 
     do {
-        double minVal;
+        typename AssignCostTraits<CostType>::DualType minVal;
         //The initialization is just to silence a warning if compiling
         //using -Wconditional-uninitialized.
         size_t curRowScan,closestRow,closestRowScan=0;
@@ -298,14 +406,14 @@ MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem
         workMem.ScannedColIdx[numColsScanned++]=curCol;
 
         /*Scan all of the columns that have not already been scanned.*/
-        minVal=numeric_limits<double>::infinity();
+        minVal=AssignCostTraits<CostType>::infVal();
         for(curRowScan=0;curRowScan<numRow2Scan;curRowScan++) {
             curRow=(size_t)workMem.Row2Scan[curRowScan];
                 
             if(curCol!=curUnassignedCol||workMem.forbiddenActiveRows[curRow]==false) {
-                double reducedCost;
+                typename AssignCostTraits<CostType>::DualType reducedCost;
                 
-                reducedCost=delta+workMem.C[curRow+curCol*numDim]-problemSol->u[curCol]-problemSol->v[curRow];
+                reducedCost=delta+workMem.cost(curRow,curCol,numDim)-problemSol->u[curCol]-problemSol->v[curRow];
                 if(reducedCost<workMem.shortestPathCost[curRow]){
                     workMem.pred[curRow]=curCol;
                     workMem.shortestPathCost[curRow]=reducedCost;
@@ -319,7 +427,7 @@ MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem
             }
         }
         
-        if(minVal==numeric_limits<double>::infinity()) {
+        if(minVal==AssignCostTraits<CostType>::infVal()) {
            /* If the minimum cost column is not finite, then the
             * problem is not feasible.*/
             
@@ -357,7 +465,8 @@ MurtyHyp *shortestPathUpdateCPP(const MurtyHyp *parentHyp, ScratchSpace &workMem
     return problemSol;
 }
 
-void split(MurtyHyp *parentHyp,priority_queue<pMurtyHyp> &HypQueue, ScratchSpace &workMem, const size_t numVarCol,const size_t numDim) {
+template<class CostType>
+void split(MurtyHypT<CostType> *parentHyp,priority_queue<pMurtyHyp<CostType> > &HypQueue, ScratchSpaceT<CostType> &workMem, const size_t numVarCol,const size_t numDim) {
 /*SPLIT
  *
  * This is a realization of a function to split hypothesis for the k-best
@@ -371,7 +480,7 @@ void split(MurtyHyp *parentHyp,priority_queue<pMurtyHyp> &HypQueue, ScratchSpace
  */    
     size_t curCol,numRow2Scan,activeCol;
     char *row2RemovePtr;
-    MurtyHyp *newHyp;
+    MurtyHypT<CostType> *newHyp;
 
     activeCol=parentHyp->activeCol;
     
@@ -402,7 +511,7 @@ void split(MurtyHyp *parentHyp,priority_queue<pMurtyHyp> &HypQueue, ScratchSpace
         delete newHyp;
     }
     else {
-        HypQueue.push(pMurtyHyp(newHyp));
+        HypQueue.push(pMurtyHyp<CostType>(newHyp));
     }    
 
     /* Remove the current assignment from the list of columns that can 
@@ -424,7 +533,7 @@ void split(MurtyHyp *parentHyp,priority_queue<pMurtyHyp> &HypQueue, ScratchSpace
         
         /*If it is not a missed detection, add it to the queue*/
         if(newHyp->gain==-1) {delete newHyp;}
-        else {HypQueue.push(pMurtyHyp(newHyp));}
+        else {HypQueue.push(pMurtyHyp<CostType>(newHyp));}
 
         /*Remove the current assignment from the list of columns to be scanned.*/
         row2RemovePtr=(char*)bsearch(parentHyp->row4col+curCol,workMem.Row2ScanParent,numRow2Scan,sizeof(ptrdiff_t),compare);
@@ -436,58 +545,55 @@ void split(MurtyHyp *parentHyp,priority_queue<pMurtyHyp> &HypQueue, ScratchSpace
     }
 }
 
-double makeCostMatrixSafe(double *CMod,const double *COrig,const size_t numEl, const bool maximize) {
+template<class CostType>
+CostType makeCostMatrixSafe(ScratchSpaceT<CostType> &workMem,const CostType *C,const size_t numRow,const size_t numCol, const bool maximize) {
 /*MAKECOSTMATRIXSAFE
- * This function adjusts the cost matrix so that a shortest augmenting path
- * algorithm can be used. Specifically, it offsets the elements so that the
- * optimal solution can be obtained as a minimization problem of a cost
- * matrix with all positive elements. The results are placed in CMod and
- * the amount by which the elements of the matrix matrix were shifted
- * (after possibly being negatived) is returned.
+ * This function sets the cost matrix in workMem so that a shortest
+ * augmenting path algorithm can be used. Specifically, it offsets the
+ * elements so that the optimal solution can be obtained as a minimization
+ * problem of a cost matrix with all positive elements. The matrix is not
+ * copied; the offset (and negation) is applied as the elements are read.
+ * The amount by which the elements of the matrix are shifted (after
+ * possibly being negatived) is returned.
  *
- *INPUTS: CMod  A pointer to a cost matrix that can hold the result.
- *        COrig A pointer to the original cost matrix that is to be
- *              adjusted. CMod and COrig can be the same matrix.
- *        numEl The number of elements in the matrix COrig.
- *     maximize True is the adjustment is for a cost matrix that will be
- *              used in a maximization problem, false otherwise.
+ *INPUTS: workMem The scratch space in which the cost matrix is set.
+ *        C       A pointer to the numRowXnumCol cost matrix. It must
+ *                remain valid while workMem is used to solve the problem.
+ *  numRow,numCol The dimensions of C.
+ *      maximize  True is the adjustment is for a cost matrix that will be
+ *                used in a maximization problem, false otherwise.
  *
+ *For maximization, the elements are read as CDelta-C[i] rather than
+ *-C[i]+CDelta so that the smallest integer value does not overflow when
+ *negated. For floating point values, the two are identical.
  **/
-double CDelta;
-size_t i;
+    const size_t numEl=numRow*numCol;
+    CostType CDelta;
 
     if(maximize==false) {
-        CDelta = *min_element(COrig, COrig + numEl);
-
-        for(i=0;i<numEl;i++) {
-            CMod[i]=COrig[i]-CDelta;
-        }
+        CDelta = *min_element(C, C + numEl);
     } else {
-        CDelta = *max_element(COrig, COrig + numEl);
-
-        for(i=0;i<numEl;i++) {
-            CMod[i]=-COrig[i]+CDelta;
-        }
+        CDelta = *max_element(C, C + numEl);
     }
     
+    workMem.setCostMatrix(C,numCol,CDelta,maximize);
     return CDelta;
 }
 
-size_t kBest2D(const size_t k,const size_t numRow,const size_t numCol,const bool maximize,const double *C, ScratchSpace &workMem,ptrdiff_t *col4rowBest,ptrdiff_t *row4colBest,double *gainBest) {
+template<class CostType>
+size_t kBest2D(const size_t k,const size_t numRow,const size_t numCol,const bool maximize,const CostType *C, ScratchSpaceT<CostType> &workMem,ptrdiff_t *col4rowBest,ptrdiff_t *row4colBest,typename AssignCostTraits<CostType>::DualType *gainBest) {
     size_t curSweep;
-    MurtyHyp *curHyp=new MurtyHyp(numRow,numRow);
-    priority_queue<pMurtyHyp> HypQueue;
-    double CDelta;
+    MurtyHypT<CostType> *curHyp=new MurtyHypT<CostType>(numRow,numRow);
+    priority_queue<pMurtyHyp<CostType> > HypQueue;
+    typename AssignCostTraits<CostType>::DualType CDelta;
     
     /* The cost matrix must have all non-negative elements for the
      * assignment algorithm to work. This forces all of the elements to be
      * positive. The delta is added back in when computing the gain in the
-     * end. workMem.C must hold enough space for a numRowXnumRow matrix.
-     * since numrow>=numCol, the extra columns will be set to zero.*/
-    CDelta=makeCostMatrixSafe(workMem.C,C,numRow*numCol,maximize);
-    CDelta=CDelta*numCol;
-    //The rest of the entries in the working memory matrix are zero. 
-    fill_n(workMem.C+numRow*numCol,numRow*(numRow-numCol),0);
+     * end. The problem is solved as a numRowXnumRow problem. Since
+     * numRow>=numCol, the extra columns are read as zero.*/
+    CDelta=makeCostMatrixSafe(workMem,C,numRow,numCol,maximize);
+    CDelta=CDelta*static_cast<typename AssignCostTraits<CostType>::DualType>(numCol);
 
     //First, solve the full problem for the best hypothesis.
     if(shortestPathCPP(curHyp,workMem,numRow,numRow,numCol)) {
@@ -507,7 +613,7 @@ size_t kBest2D(const size_t k,const size_t numRow,const size_t numCol,const bool
         gainBest[0]=-gainBest[0]+CDelta;
     }
     
-    HypQueue.push(pMurtyHyp(curHyp));
+    HypQueue.push(pMurtyHyp<CostType>(curHyp));
     //Enter the loop to generate all of the other hypotheses from this one.
     for(curSweep=1;curSweep<k;curSweep++) {
         curHyp=HypQueue.top().ptr;
@@ -548,19 +654,20 @@ size_t kBest2D(const size_t k,const size_t numRow,const size_t numCol,const bool
     return curSweep;
 }
 
-int assign2D(const size_t numRow,const size_t numCol,const bool maximize,const double *C, ScratchSpace &workMem,MurtyHyp *problemSol) {
+template<class CostType>
+int assign2D(const size_t numRow,const size_t numCol,const bool maximize,const CostType *C, ScratchSpaceT<CostType> &workMem,MurtyHypT<CostType> *problemSol) {
 /*ASSIGN2D Perform 2D assignment after making adjusting the cost matrix to
  *         be safe and transforming the optimization problem into a
  *         minimization problem.
  **/
-    double CDelta;
+    typename AssignCostTraits<CostType>::DualType CDelta;
     
     /* The cost matrix must have all non-negative elements for the
      * assignment algorithm to work. This forces all of the elements to be
      * positive. The delta is added back in when computing the gain in the
-     * end. workMem.C must hold enough space for a numRowXnumCol matrix.*/
-    CDelta=makeCostMatrixSafe(workMem.C,C,numRow*numCol,maximize);
-    CDelta=CDelta*numCol;
+     * end.*/
+    CDelta=makeCostMatrixSafe(workMem,C,numRow,numCol,maximize);
+    CDelta=CDelta*static_cast<typename AssignCostTraits<CostType>::DualType>(numCol);
     
     if(shortestPathCPP(problemSol,workMem,numRow,numCol,numCol)) {
     /*If the problem is infeasible, then identify it as such and return.
@@ -577,6 +684,70 @@ int assign2D(const size_t numRow,const size_t numCol,const bool maximize,const d
     return 1;
 }
 
+template<class CostType>
+int assign2DWarmStart(const size_t numRow,const size_t numCol,const bool maximize,const CostType *C, ScratchSpaceT<CostType> &workMem,MurtyHypT<CostType> *problemSol) {
+/*ASSIGN2DWARMSTART Perform 2D assignment as in assign2D, but inheriting
+ *         the row dual variables and the assignment already in
+ *         problemSol.
+ **/
+    typename AssignCostTraits<CostType>::DualType CDelta;
+    
+    CDelta=makeCostMatrixSafe(workMem,C,numRow,numCol,maximize);
+    CDelta=CDelta*static_cast<typename AssignCostTraits<CostType>::DualType>(numCol);
+    
+    if(shortestPathWarmStartCPP(problemSol,workMem,numRow,numCol)) {
+        return 0;
+    }
+    
+    if(maximize==false) {
+        problemSol->gain=problemSol->gain+CDelta;
+    } else {
+        problemSol->gain=-problemSol->gain+CDelta;
+    }
+    
+    return 1;
+}
+
+template<class CostType>
+bool costRangeIsSafe(const CostType *C,const size_t numEl,const size_t numCol) {
+    CostType minVal, maxVal;
+    int64_t costRange;
+    
+    //Floating point values saturate at infinity rather than overflowing.
+    if(numeric_limits<CostType>::is_integer==false||numEl==0) {
+        return true;
+    }
+    
+    minVal=*min_element(C,C+numEl);
+    maxVal=*max_element(C,C+numEl);
+    
+    //The shifted cost matrix is stored using CostType.
+    if(minVal<0&&maxVal>numeric_limits<CostType>::max()+minVal) {
+        return false;
+    }
+    costRange=static_cast<int64_t>(maxVal)-static_cast<int64_t>(minVal);
+    
+    /*The dual variables and the path costs are bounded by sums of
+     *numCol+1 differences of costs. A factor of four is used so that the
+     *sums formed when computing reduced costs cannot overflow.*/
+    return costRange<=numeric_limits<int64_t>::max()/(4*(static_cast<int64_t>(numCol)+1));
+}
+
+/*The functions are explicitly instantiated for the supported cost types
+ *so that the implementations can remain in this file.*/
+#define INSTANTIATE_ASSIGN_FUNCTIONS(CostType) \
+template bool costRangeIsSafe<CostType>(const CostType *C,const size_t numEl,const size_t numCol); \
+template int assign2D<CostType>(const size_t numRow,const size_t numCol,const bool maximize,const CostType *C, ScratchSpaceT<CostType> &workMem,MurtyHypT<CostType> *problemSol); \
+template int assign2DWarmStart<CostType>(const size_t numRow,const size_t numCol,const bool maximize,const CostType *C, ScratchSpaceT<CostType> &workMem,MurtyHypT<CostType> *problemSol); \
+template int shortestPathCPP<CostType>(MurtyHypT<CostType> *problemSol,ScratchSpaceT<CostType> &workMem,const size_t numRow, const size_t numCol, const size_t numCol4Gain); \
+template int shortestPathWarmStartCPP<CostType>(MurtyHypT<CostType> *problemSol,ScratchSpaceT<CostType> &workMem,const size_t numRow,const size_t numCol); \
+template size_t kBest2D<CostType>(const size_t k,const size_t numRow,const size_t numCol,const bool maximize,const CostType *C, ScratchSpaceT<CostType> &workMem,ptrdiff_t *col4rowBest,ptrdiff_t *row4colBest,AssignCostTraits<CostType>::DualType *gainBest);
+
+INSTANTIATE_ASSIGN_FUNCTIONS(double)
+INSTANTIATE_ASSIGN_FUNCTIONS(float)
+INSTANTIATE_ASSIGN_FUNCTIONS(int32_t)
+INSTANTIATE_ASSIGN_FUNCTIONS(int64_t)
+
 /*LICENSE:
 %
 %The source code is in the public domain and not licensed or under
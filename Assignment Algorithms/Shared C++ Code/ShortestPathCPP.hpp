@@ -12,79 +12,144 @@
 #ifndef SPALGS
 #define SPALGS
 #include <stddef.h>
+//For int32_t and int64_t
+#include <stdint.h>
+#include <limits>
 
-/**The MurtyHyp class is used to hold a solution to the 2D assignment
+/**The AssignCostTraits class defines the type used for the dual variables,
+ * the path costs and the gain when the cost matrix has elements of type
+ * CostType, as well as the value used as an infinite path cost. The
+ * assignment functions in this file are implemented for CostType equal
+ * to double, float, int32_t and int64_t. Floating point costs use double
+ * precision dual variables. Integer costs use 64-bit integer dual
+ * variables, so the results are exact as long as nothing overflows (see
+ * costRangeIsSafe). The cost matrix in the ScratchSpace is stored using
+ * CostType, so single precision and 32-bit integer costs halve the amount
+ * of memory that has to be read in the inner loops.
+ **/
+template<class CostType>
+class AssignCostTraits {
+public:
+    typedef double DualType;
+    
+    static DualType infVal() {
+        return std::numeric_limits<double>::infinity();
+    }
+};
+
+template<>
+class AssignCostTraits<int32_t> {
+public:
+    typedef int64_t DualType;
+    
+    static DualType infVal() {
+        return std::numeric_limits<int64_t>::max();
+    }
+};
+
+template<>
+class AssignCostTraits<int64_t> {
+public:
+    typedef int64_t DualType;
+    
+    static DualType infVal() {
+        return std::numeric_limits<int64_t>::max();
+    }
+};
+
+/**The MurtyHypT class is used to hold a solution to the 2D assignment
  * algorithm as well as additional information that is useful when
- * implementing Murty's k-Best 2D assignment algorithm.
+ * implementing Murty's k-Best 2D assignment algorithm. MurtyHyp is the
+ * version for double precision costs.
  **/
-class MurtyHyp {
+template<class CostType>
+class MurtyHypT {
 private:
     char *buffer;
 public:
+    typedef typename AssignCostTraits<CostType>::DualType DualType;
+    
     ptrdiff_t *col4row;
     ptrdiff_t *row4col;
-    double gain;
-    double *u;
-    double *v;
+    DualType gain;
+    DualType *u;
+    DualType *v;
     /*activeCol and forbiddenActiveRows are used in the k-best 2D 
      *assignment algorithm, but not in the regular 2D assignment
      *algorithm.*/
     size_t activeCol;
     bool *forbiddenActiveRows;
     
-    MurtyHyp(){
+    MurtyHypT(){
         buffer=NULL;
     }
     
-    MurtyHyp(const size_t numRow, const size_t numCol) {
+    MurtyHypT(const size_t numRow, const size_t numCol) {
        char *basePtr;
     /*To minimize the number of calls to memory allocation and deallocation
      * routines, a big chunk of memory is allocated at once and pointers
      * to parts of it for the different variables are saved.*/
-       buffer=new char[sizeof(ptrdiff_t)*numRow+sizeof(ptrdiff_t)*numCol+sizeof(double)*numCol+sizeof(double)*numRow+sizeof(bool)*numRow];
+       buffer=new char[sizeof(ptrdiff_t)*numRow+sizeof(ptrdiff_t)*numCol+sizeof(DualType)*numCol+sizeof(DualType)*numRow+sizeof(bool)*numRow];
        basePtr=buffer;
        col4row=(ptrdiff_t*)basePtr;
        basePtr+=numRow*sizeof(ptrdiff_t);
        row4col=(ptrdiff_t*)basePtr;
        basePtr+=numCol*sizeof(ptrdiff_t);
-       u=(double*)basePtr;
-       basePtr+=sizeof(double)*numCol;
-       v=(double*)basePtr;
-       basePtr+=sizeof(double)*numRow;
+       u=(DualType*)basePtr;
+       basePtr+=sizeof(DualType)*numCol;
+       v=(DualType*)basePtr;
+       basePtr+=sizeof(DualType)*numRow;
        forbiddenActiveRows=(bool*)basePtr;
     }
     
-    ~MurtyHyp(){
+    ~MurtyHypT(){
         if(buffer!=NULL){
             delete[] buffer;
         }
     }
 }; 
 
-/* The ScratchSpace class holds the parameters and scratch space for the 2D
- * assignment algorithm so as to reduce the number of memory allocation and
- * deallocation operations that are necessary when the 2D assignment 
+/* The ScratchSpaceT class holds the parameters and scratch space for the
+ * 2D assignment algorithm so as to reduce the number of memory allocation
+ * and deallocation operations that are necessary when the 2D assignment 
  * algorithm must be called repeatedly. Some of the entries are only used
- * in the k-best implementation of the algorithm.
+ * in the k-best implementation of the algorithm. ScratchSpace is the
+ * version for double precision costs.
  */
-class ScratchSpace {
+template<class CostType>
+class ScratchSpaceT {
 public:
+    typedef typename AssignCostTraits<CostType>::DualType DualType;
+    
     char *buffer;
-    double *C;
+    CostType *C;
     size_t *ScannedColIdx;
     bool *ScannedRows;
     size_t *pred;
-    double *shortestPathCost;
+    DualType *shortestPathCost;
     ptrdiff_t *Row2ScanParent;
     ptrdiff_t *Row2Scan;
     bool* forbiddenActiveRows;
+    /*The number of shortest augmenting path searches performed using
+     *this scratch space. This is only used for profiling.*/
+    size_t numAugmentations;
+    /*The cost matrix that the shortest path functions read, as set by
+     *setCostMatrix. The matrix is not copied; the offset and negation
+     *that make the problem a minimization with non-negative costs are
+     *applied as the elements are read.*/
+    const CostType *CSolve;
+    CostType CDelta;
+    bool negateC;
+    size_t numColC;
     
     //The constructor
-    ScratchSpace(){
+    ScratchSpaceT(){
         buffer=NULL;
+        CSolve=NULL;
+        numAugmentations=0;
     }
     
-    ScratchSpace(const size_t numRow,const size_t numCol){
+    ScratchSpaceT(const size_t numRow,const size_t numCol){
         this->init(numRow,numCol);
     }
     
@@ -92,8 +157,9 @@ public:
         char *basePtr;
     /*To minimize the number of calls to memory allocation and deallocation
      * routines, a big chunk of memory is allocated at once and pointers
-     * to parts of it for the different variables are saved.*/
-        buffer=new char[numCol*sizeof(size_t)+2*numRow*sizeof(ptrdiff_t)+numRow*sizeof(size_t)+numRow*(1+numCol)*sizeof(double)+2*numRow*sizeof(bool)];
+     * to parts of it for the different variables are saved. The
+     * variables are ordered by decreasing alignment requirements.*/
+        buffer=new char[numCol*sizeof(size_t)+2*numRow*sizeof(ptrdiff_t)+numRow*sizeof(size_t)+numRow*sizeof(DualType)+numRow*numCol*sizeof(CostType)+2*numRow*sizeof(bool)];
         basePtr=buffer;
         ScannedColIdx=(size_t*)basePtr;
         basePtr+=sizeof(size_t)*numCol;
@@ -103,29 +169,71 @@ public:
         basePtr+=sizeof(ptrdiff_t)*numRow;
         pred=(size_t*)basePtr;
         basePtr+=sizeof(size_t)*numRow;
-        shortestPathCost=(double*)basePtr;
-        basePtr+=sizeof(double)*numRow;
+        shortestPathCost=(DualType*)basePtr;
+        basePtr+=sizeof(DualType)*numRow;
+        C=(CostType*)basePtr;
+        basePtr+=sizeof(CostType)*numRow*numCol;
         ScannedRows=(bool*)basePtr;
         basePtr+=sizeof(bool)*numRow;
         forbiddenActiveRows=(bool*)basePtr;
-        basePtr+=sizeof(bool)*numRow;
-
-        C=(double*)basePtr;
+        numAugmentations=0;
+        setCostMatrix(C,numCol,0,false);
+    }
+    
+    void setCostMatrix(const CostType *CIn,const size_t numColIn,const CostType delta,const bool negate) {
+    /*Make the shortest path functions read the cost matrix CIn. Element
+     *c becomes delta-c if negate is true and c-delta otherwise. Columns
+     *at or after numColIn are taken to be all zero, which is how the
+     *matrix is padded to be square in the k-best algorithm. init points
+     *this at C with no offset, so non-negative costs for a minimization
+     *can be placed in C directly.*/
+        CSolve=CIn;
+        numColC=numColIn;
+        CDelta=delta;
+        negateC=negate;
+    }
+    
+    DualType cost(const size_t row,const size_t col,const size_t numRow) const {
+        if(col>=numColC) {
+            return 0;
+        } else {
+            const CostType c=CSolve[row+col*numRow];
+            return static_cast<CostType>(negateC?CDelta-c:c-CDelta);
+        }
     }
     
-    ~ScratchSpace(){
+    ~ScratchSpaceT(){
         if(buffer!=NULL) {
             delete[] buffer;
         }
     }
 };
 
+typedef MurtyHypT<double> MurtyHyp;
+typedef ScratchSpaceT<double> ScratchSpace;
+
+template<class CostType>
+bool costRangeIsSafe(const CostType *C,
+                     const size_t numEl,
+                     const size_t numCol);
+/*COSTRANGEISSAFE Determine whether the assignment functions in this file
+ *         can be used with the numEl-element cost matrix C having numCol
+ *         columns (numCol<=numRow) without overflow. This is always true
+ *         for floating point costs. For integer costs, the difference
+ *         between the largest and smallest elements must fit in CostType
+ *         and numCol+1 times that difference must fit in an int64_t with
+ *         room to spare, as the dual variables and path costs are sums of
+ *         differences of costs.
+ *
+ **/
+
+template<class CostType>
 int assign2D(const size_t numRow,
              const size_t numCol,
              const bool maximize,
-             const double *C,
-             ScratchSpace &workMem,
-             MurtyHyp *problemSol);
+             const CostType *C,
+             ScratchSpaceT<CostType> &workMem,
+             MurtyHypT<CostType> *problemSol);
 /*ASSIGN2D Perform 2D assignment using a shortest augmenting path algorithm
  *         that scans by row. This function transforms the maximization
  *         problems into equivalent minimization problems having cost
@@ -135,10 +243,12 @@ int assign2D(const size_t numRow,
  *       numCol The number of columns in the cost matrix. Note that
  *              numRow>=numCol.
  *     maximize True if the optimization is a maximization
- *          C   The cost matrix.
- *      workMem An instance of the ScratchSpace class that was initialized
+ *          C   The cost matrix. The elements can be of type double, float,
+ *              int32_t or int64_t. For integer types, costRangeIsSafe
+ *              should be checked first.
+ *      workMem An instance of the ScratchSpaceT class that was initialized
  *              with workMem.init(numRow,numCol);
- *   ProblemSol An instance of MurtyHyp created using
+ *   ProblemSol An instance of MurtyHypT created using
  *              MurtyHyp(numRow,numCol) in which the solution to the
  *              assignment problem is placed.
  *
@@ -154,8 +264,59 @@ int assign2D(const size_t numRow,
  *
  **/
 
-int shortestPathCPP(MurtyHyp *problemSol,
-                   ScratchSpace &workMem,
+template<class CostType>
+int assign2DWarmStart(const size_t numRow,
+                      const size_t numCol,
+                      const bool maximize,
+                      const CostType *C,
+                      ScratchSpaceT<CostType> &workMem,
+                      MurtyHypT<CostType> *problemSol);
+/*ASSIGN2DWARMSTART Perform 2D assignment in the same manner as assign2D,
+ *         except that the dual variables and the assignment of a previous
+ *         solution are used as a starting point. This is useful when a
+ *         sequence of similar problems of the same size must be solved,
+ *         as in the subgradient iterations of Lagrangian relaxation
+ *         algorithms.
+ *
+ *INPUTS: The inputs are the same as in assign2D, except that problemSol
+ *        must hold a solution from a previous call to assign2D or
+ *        assign2DWarmStart with the same numRow, numCol, and maximize
+ *        values. The row dual variables (v) and row4col are inherited.
+ *
+ *OUTPUTS: The results are placed in problemSol. The return value is 0 if
+ *         no optimal solution with finite cost exists. It is one
+ *         otherwise.
+ *
+ *The column dual variables are set to the largest feasible values given
+ *the inherited row dual variables and previous assignments that remain
+ *tight are kept, so only the columns whose assignment changed need to be
+ *augmented. If numRow>numCol and the inherited dual variables do not lead
+ *to an optimal dual solution, the problem is solved again from scratch.
+ *The value of the optimal gain is the same as with assign2D, but the dual
+ *variables returned will generally differ and if there are ties for the
+ *optimal assignment, a different optimal assignment might be returned.
+ *
+ **/
+
+template<class CostType>
+int shortestPathWarmStartCPP(MurtyHypT<CostType> *problemSol,
+                             ScratchSpaceT<CostType> &workMem,
+                             const size_t numRow,
+                             const size_t numCol);
+/*SHORTESTPATHWARMSTARTCPP
+ *
+ * The shortest augmenting path algorithm for 2D assignment, starting from
+ * the row dual variables and the assignment in problemSol. The same
+ * assumptions as in shortestPathCPP about the cost matrix in workMem
+ * apply. The return value is 1 if the problem is infeasible; otherwise it
+ * is zero. If the problem is infeasible, then the gain in problemSol is
+ * set to -1.
+ *
+ **/
+
+template<class CostType>
+int shortestPathCPP(MurtyHypT<CostType> *problemSol,
+                   ScratchSpaceT<CostType> &workMem,
                    const size_t numRow,
                    const size_t numCol,
                    const size_t numCol4Gain);
@@ -165,7 +326,9 @@ int shortestPathCPP(MurtyHyp *problemSol,
  * assumes that one is performing a minimization, that numRow>=numCol, and
  * that all of the elements in the cost matrix are non-negative. If these
  * conditions do not hold, then the function assign2D should be used. That
- * function prepares the input and then calls this function.
+ * function prepares the input and then calls this function. The cost
+ * matrix is the one set with workMem.setCostMatrix, which is workMem.C
+ * after workMem.init.
  * Unlike assign2D, this function has an additional input called
  * numCol4Gain, which is useful when this function is used to start Murty's
  * algorithm for the k-best hypotheses. numCol4Gain is the number of
@@ -180,15 +343,16 @@ int shortestPathCPP(MurtyHyp *problemSol,
  **/
 
 
+template<class CostType>
 size_t kBest2D(const size_t k,
                const size_t numRow,
                const size_t numCol,
                const bool maximize,
-               const double *C,
-               ScratchSpace &workMem,
+               const CostType *C,
+               ScratchSpaceT<CostType> &workMem,
                ptrdiff_t *col4rowBest,
                ptrdiff_t *row4colBest,
-               double *gainBest);
+               typename AssignCostTraits<CostType>::DualType *gainBest);
 /*KBEST2D         Finds the k-Best 2D assignments using a shortest
  *                augmenting path algorithm that scans by row.
  *
@@ -199,8 +363,10 @@ size_t kBest2D(const size_t k,
  *       numCol The number of columns in the cost matrix. Note that
  *              numRow>=numCol.
  *     maximize True if the optimization is a maximization
- *          C   The cost matrix.
- *      workMem An instance of the ScratchSpace class that was initialized
+ *          C   The cost matrix. The elements can be of type double, float,
+ *              int32_t or int64_t. For integer types, costRangeIsSafe
+ *              should be checked first.
+ *      workMem An instance of the ScratchSpaceT class that was initialized
  *              with workMem.init(numRow,numRow);
  *  col4rowBest An array with space for numRow*k elements to hold the
  *              assignments of rows to columns for each of the hypotheses.
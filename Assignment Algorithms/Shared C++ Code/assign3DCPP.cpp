@@ -0,0 +1,461 @@
+/**ASSIGN3DCPP Functions in C++ implementing algorithms for the axial 3D
+ *             assignment problem. The code is easiest to understand after
+ *             examining the Matlab implementation in assign3D.m.
+ *
+ *  This file relies on the files assign3DCPP.hpp and ShortestPathCPP.hpp.
+ *  Much of the documentation for the functions is found in those headers.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "assign3DCPP.hpp"
+#include "ShortestPathCPP.hpp"
+#include <algorithm>
+#include <limits>
+//Needed for isfinite and nextafter
+#include <math.h>
+
+using namespace std;
+
+//Prototypes for functions used in this file that are not present in
+//the header assign3DCPP.hpp.
+int solveSub2D(ptrdiff_t *assign4Dim1,double *dual4Other,double &gain,const size_t n1,const size_t nOther,const bool maximize,const bool warmStart,ScratchSpace &workMem,MurtyHyp *problemSol);
+int assign3DRelaxPattipati(ptrdiff_t *phi2,ptrdiff_t *phi3,double *minCostVal,double *costGap,const double *C,const size_t n1,const size_t n2,const size_t n3,const size_t maxIter,const double epsVal,ScratchSpace &workMem);
+int assign3DRelaxFrieze(ptrdiff_t *phi2,ptrdiff_t *phi3,double *minCostVal,double *costGap,const double *C,const size_t n1,const size_t n2,const size_t n3,const size_t maxIter,const double epsVal,ScratchSpace &workMem);
+int assign3DBruteForce(ptrdiff_t *phi2,ptrdiff_t *phi3,double *minCostVal,double *costGap,const double *C,const size_t n1,const size_t n2,const size_t n3,ScratchSpace &workMem);
+
+inline size_t subIdx(const size_t i,const size_t j,const size_t n1,const size_t nOther) {
+/*SUBIDX The index of element (i,j) of an n1XnOther 2D assignment
+ *       subproblem in workMem.C. When n1<nOther, the subproblem is stored
+ *       transposed so that the number of rows is >= the number of
+ *       columns, as is done in the assign2D mex function.*/
+    if(n1==nOther) {
+        return i+j*n1;
+    } else {
+        return j+i*nOther;
+    }
+}
+
+inline double epsVal4(const double x) {
+/*EPSVAL4 The same as eps(x) in Matlab: the distance from abs(x) to the
+ *        next larger double. The result is NaN if x is not finite.*/
+    const double absX=fabs(x);
+    return nextafter(absX,numeric_limits<double>::infinity())-absX;
+}
+
+int solveSub2D(ptrdiff_t *assign4Dim1,double *dual4Other,double &gain,const size_t n1,const size_t nOther,const bool maximize,const bool warmStart,ScratchSpace &workMem,MurtyHyp *problemSol) {
+/*SOLVESUB2D Solve an n1XnOther 2D assignment problem whose cost matrix has
+ *           been placed in workMem.C in the order given by subIdx. The
+ *           cost matrix is modified. The element of the second dimension
+ *           assigned to each element of the first dimension is placed in
+ *           assign4Dim1 and if dual4Other is not NULL, the dual variables
+ *           for the second dimension are placed in dual4Other. These are
+ *           the same as those that assign2D returns in Matlab. The return
+ *           value is 0 if the problem is infeasible and 1 otherwise.*/
+    const bool isSquare=(n1==nOther);
+    const size_t numRow=nOther;
+    int found;
+
+    /*The cost matrix is adjusted in place.*/
+    if(warmStart) {
+        found=assign2DWarmStart(numRow,n1,maximize,workMem.C,workMem,problemSol);
+    } else {
+        found=assign2D(numRow,n1,maximize,workMem.C,workMem,problemSol);
+    }
+
+    if(found==0) {
+        return 0;
+    }
+
+    gain=problemSol->gain;
+    if(isSquare) {
+        copy(problemSol->col4row,problemSol->col4row+n1,assign4Dim1);
+        if(dual4Other!=NULL) {
+            copy(problemSol->u,problemSol->u+nOther,dual4Other);
+        }
+    } else {
+        copy(problemSol->row4col,problemSol->row4col+n1,assign4Dim1);
+        if(dual4Other!=NULL) {
+            copy(problemSol->v,problemSol->v+nOther,dual4Other);
+        }
+    }
+
+    return 1;
+}
+
+int assign3DRelaxPattipati(ptrdiff_t *phi2,ptrdiff_t *phi3,double *minCostVal,double *costGap,const double *C,const size_t n1,const size_t n2,const size_t n3,const size_t maxIter,const double epsVal,ScratchSpace &workMem) {
+/*ASSIGN3DRELAXPATTIPATI The relaxation approximation of algorithm 0 in
+ *               assign3D.m. The H matrix and the p vector in the Matlab
+ *               implementation do not affect the dual variable update and
+ *               are thus not computed.*/
+    const size_t n1n2=n1*n2;
+    const double inf=numeric_limits<double>::infinity();
+    MurtyHyp dSol(n3,n1);
+    MurtyHyp feasSol(n3,n1);
+    size_t curIter,i,j,k;
+    int foundSol=0;
+    double qStar=-inf;
+    double fTildeStar=inf;
+    double *u, *mu, *g;
+    size_t *minIdx;
+    ptrdiff_t *dim2ForDim1Cur,*dim3ForDim1Cur;
+    char *buffer;
+    char *basePtr;
+
+    buffer=new char[3*n3*sizeof(double)+n1n2*sizeof(size_t)+2*n1*sizeof(ptrdiff_t)];
+    basePtr=buffer;
+    u=(double*)basePtr;
+    basePtr+=n3*sizeof(double);
+    mu=(double*)basePtr;
+    basePtr+=n3*sizeof(double);
+    g=(double*)basePtr;
+    basePtr+=n3*sizeof(double);
+    minIdx=(size_t*)basePtr;
+    basePtr+=n1n2*sizeof(size_t);
+    dim2ForDim1Cur=(ptrdiff_t*)basePtr;
+    basePtr+=n1*sizeof(ptrdiff_t);
+    dim3ForDim1Cur=(ptrdiff_t*)basePtr;
+
+    fill_n(u,n3,0.0);
+    for(curIter=0;curIter<maxIter;curIter++) {
+        double q, fTilde, CMin, normG2, sumMu, gapVal, relGap, stepScal;
+        double minVal=0;
+
+        /*The minimum values are Eq. 3.8; the minimum indices are needed
+         *for Eq. 3.14b.*/
+        for(j=0;j<n2;j++) {
+            for(i=0;i<n1;i++) {
+                const double *CCur=C+i+j*n1;
+                double bestVal=inf;
+                size_t bestIdx=0;
+
+                for(k=0;k<n3;k++) {
+                    const double val=CCur[k*n1n2]-u[k];
+                    if(val<bestVal) {
+                        bestVal=val;
+                        bestIdx=k;
+                    }
+                }
+                workMem.C[subIdx(i,j,n1,n2)]=bestVal;
+                minIdx[i+j*n1]=bestIdx;
+            }
+        }
+
+        /*Perform the minimization in (3.7) for a fixed u. Only the
+         *assignment and the cost are needed, so the previous solution can
+         *be used as a warm start.*/
+        if(solveSub2D(dim2ForDim1Cur,NULL,minVal,n1,n2,false,curIter>0,workMem,&dSol)==0) {
+            break;
+        }
+        q=minVal;
+        for(k=0;k<n3;k++) {
+            q+=u[k];
+        }
+
+        if(q>qStar) {
+            qStar=q;
+        }
+
+        /*Next, get a feasible solution. This solves the minimization
+         *problem of Eqs. 3.19-3.20. The dual variables are needed, so no
+         *warm start is used, so that they are the same as in assign3D.m.*/
+        CMin=inf;
+        for(k=0;k<n3;k++) {
+            for(i=0;i<n1;i++) {
+                const double val=C[i+(size_t)dim2ForDim1Cur[i]*n1+k*n1n2];
+
+                workMem.C[subIdx(i,k,n1,n3)]=val;
+                if(val<CMin) {
+                    CMin=val;
+                }
+            }
+        }
+
+        if(solveSub2D(dim3ForDim1Cur,mu,fTilde,n1,n3,false,false,workMem,&feasSol)==0) {
+            break;
+        }
+        //Add back in the minimum cost that assign2D subtracted.
+        for(k=0;k<n3;k++) {
+            mu[k]+=CMin;
+        }
+
+        if(fTilde<fTildeStar) {
+            fTildeStar=fTilde;
+
+            copy(dim2ForDim1Cur,dim2ForDim1Cur+n1,phi2);
+            copy(dim3ForDim1Cur,dim3ForDim1Cur+n1,phi3);
+            *minCostVal=fTildeStar;
+            foundSol=1;
+        }
+
+        /*Check whether the termination criterion based on the duality gap
+         *has been fulfilled.*/
+        gapVal=fTildeStar-qStar;
+        *costGap=gapVal;
+        relGap=gapVal/fabs(qStar);
+        if(gapVal<=epsVal4(fTildeStar)||(!isfinite(relGap)&&relGap<epsVal)) {
+            break;
+        }
+
+        /*Get the g vector in Eq. 3.14a from the rho terms of the dual
+         *solution in Eq. 3.14b.*/
+        fill_n(g,n3,1.0);
+        for(i=0;i<n1;i++) {
+            g[minIdx[i+(size_t)dim2ForDim1Cur[i]*n1]]-=1.0;
+        }
+
+        normG2=0;
+        sumMu=0;
+        for(k=0;k<n3;k++) {
+            normG2+=g[k]*g[k];
+            sumMu+=mu[k];
+        }
+
+        /*If g is all zero, then no constraints were violated.*/
+        if(normG2==0) {
+            break;
+        }
+
+        //Update the dual variables as in 3.21
+        stepScal=((fTildeStar-qStar)/normG2)*(static_cast<double>(n3)/sumMu);
+        for(k=0;k<n3;k++) {
+            u[k]+=stepScal*(mu[k]*g[k]);
+        }
+
+        /*Enforce the inequality constraints when n1~=n2.*/
+        if(n2!=n1) {
+            for(k=0;k<n3;k++) {
+                if(u[k]>0) {
+                    u[k]=0;
+                }
+            }
+        }
+    }
+
+    delete[] buffer;
+    return foundSol;
+}
+
+int assign3DRelaxFrieze(ptrdiff_t *phi2,ptrdiff_t *phi3,double *minCostVal,double *costGap,const double *C,const size_t n1,const size_t n2,const size_t n3,const size_t maxIter,const double epsVal,ScratchSpace &workMem) {
+/*ASSIGN3DRELAXFRIEZE The relaxation approximation of algorithm 1 in
+ *               assign3D.m. The algorithm maximizes, so the negated cost
+ *               matrix is used.*/
+    const size_t n1n2=n1*n2;
+    const double inf=numeric_limits<double>::infinity();
+    MurtyHyp wSol(n3,n1);
+    MurtyHyp aSol(n3,n1);
+    size_t curIter,i,j,k;
+    int foundSol=0;
+    double lb=-inf;
+    double ub=inf;
+    double *u, *v;
+    size_t *maxIdx;
+    ptrdiff_t *dim2ForDim1Cur,*dim3ForDim1Cur;
+    char *buffer;
+    char *basePtr;
+
+    buffer=new char[2*n3*sizeof(double)+n1n2*sizeof(size_t)+2*n1*sizeof(ptrdiff_t)];
+    basePtr=buffer;
+    u=(double*)basePtr;
+    basePtr+=n3*sizeof(double);
+    v=(double*)basePtr;
+    basePtr+=n3*sizeof(double);
+    maxIdx=(size_t*)basePtr;
+    basePtr+=n1n2*sizeof(size_t);
+    dim2ForDim1Cur=(ptrdiff_t*)basePtr;
+    basePtr+=n1*sizeof(ptrdiff_t);
+    dim3ForDim1Cur=(ptrdiff_t*)basePtr;
+
+    fill_n(u,n3,0.0);
+    for(curIter=0;curIter<maxIter;curIter++) {
+        double phi, primalVal, normV2, gapVal, relGap, sigma;
+        double maxVal=0;
+
+        //Compute the w values in Equation 3.
+        for(j=0;j<n2;j++) {
+            for(i=0;i<n1;i++) {
+                const double *CCur=C+i+j*n1;
+                double bestVal=-inf;
+                size_t bestIdx=0;
+
+                for(k=0;k<n3;k++) {
+                    const double val=-CCur[k*n1n2]-u[k];
+                    if(val>bestVal) {
+                        bestVal=val;
+                        bestIdx=k;
+                    }
+                }
+                workMem.C[subIdx(i,j,n1,n2)]=bestVal;
+                maxIdx[i+j*n1]=bestIdx;
+            }
+        }
+
+        /*Perform the maximization in Equation 4 over xi.*/
+        if(solveSub2D(dim2ForDim1Cur,NULL,maxVal,n1,n2,true,curIter>0,workMem,&wSol)==0) {
+            break;
+        }
+        phi=maxVal;
+        for(k=0;k<n3;k++) {
+            phi+=u[k];
+        }
+        if(phi<ub) {
+            ub=phi;
+        }
+
+        /*The unnumbered equation before Equation 18.*/
+        for(k=0;k<n3;k++) {
+            for(i=0;i<n1;i++) {
+                workMem.C[subIdx(i,k,n1,n3)]=-C[i+(size_t)dim2ForDim1Cur[i]*n1+k*n1n2];
+            }
+        }
+
+        /*Perform the maximization in 8 to get the primal variables.*/
+        if(solveSub2D(dim3ForDim1Cur,NULL,primalVal,n1,n3,true,curIter>0,workMem,&aSol)==0) {
+            break;
+        }
+
+        if(primalVal>lb) {
+            lb=primalVal;
+
+            copy(dim2ForDim1Cur,dim2ForDim1Cur+n1,phi2);
+            copy(dim3ForDim1Cur,dim3ForDim1Cur+n1,phi3);
+            *minCostVal=-lb;
+            foundSol=1;
+        }
+
+        //Check for convergence as in Algorithm 0.
+        gapVal=ub-lb;
+        *costGap=gapVal;
+        relGap=gapVal/fabs(ub);
+        if(gapVal<=epsVal4(lb)||(!isfinite(relGap)&&relGap<epsVal)) {
+            break;
+        }
+
+        //The direction of search from Eq. 10.
+        fill_n(v,n3,1.0);
+        for(i=0;i<n1;i++) {
+            v[maxIdx[i+(size_t)dim2ForDim1Cur[i]*n1]]-=1.0;
+        }
+
+        normV2=0;
+        for(k=0;k<n3;k++) {
+            normV2+=v[k]*v[k];
+        }
+
+        if(normV2==0) {
+            break;
+        }
+
+        //Compute the stepsize from Eq. 11 and take the step.
+        sigma=(phi-lb)/normV2;
+        for(k=0;k<n3;k++) {
+            u[k]+=sigma*v[k];
+        }
+
+        /*Enforce the inequality constraints when n1~=n2.*/
+        if(n2!=n1) {
+            for(k=0;k<n3;k++) {
+                if(u[k]<0) {
+                    u[k]=0;
+                }
+            }
+        }
+    }
+
+    delete[] buffer;
+    return foundSol;
+}
+
+int assign3DBruteForce(ptrdiff_t *phi2,ptrdiff_t *phi3,double *minCostVal,double *costGap,const double *C,const size_t n1,const size_t n2,const size_t n3,ScratchSpace &workMem) {
+/*ASSIGN3DBRUTEFORCE Algorithm 2 in assign3D.m. All arrangements of n1 of
+ *               the n2 elements of the second dimension are visited in
+ *               lexicographic order and the 2D assignment problem over the
+ *               third dimension is solved for each. Consecutive 2D
+ *               problems differ little, so each is warm-started from the
+ *               previous one.*/
+    const size_t n1n2=n1*n2;
+    MurtyHyp innerSol(n3,n1);
+    size_t i,k;
+    int foundSol=0;
+    bool warmStart=false;
+    double minCost=numeric_limits<double>::infinity();
+    size_t *arrange;
+    ptrdiff_t *col4Row;
+
+    arrange=new size_t[n2];
+    col4Row=new ptrdiff_t[n1];
+    for(i=0;i<n2;i++) {
+        arrange[i]=i;
+    }
+
+    do {
+        double costVal;
+
+        for(k=0;k<n3;k++) {
+            for(i=0;i<n1;i++) {
+                workMem.C[subIdx(i,k,n1,n3)]=C[i+arrange[i]*n1+k*n1n2];
+            }
+        }
+
+        if(solveSub2D(col4Row,NULL,costVal,n1,n3,false,warmStart,workMem,&innerSol)==1) {
+            warmStart=true;
+            if(costVal<minCost) {
+                minCost=costVal;
+                for(i=0;i<n1;i++) {
+                    phi2[i]=(ptrdiff_t)arrange[i];
+                }
+                copy(col4Row,col4Row+n1,phi3);
+                foundSol=1;
+            }
+        } else {
+            warmStart=false;
+        }
+
+        /*Reversing the tail makes next_permutation skip all permutations
+         *that only differ after the first n1 elements.*/
+        reverse(arrange+n1,arrange+n2);
+    } while(next_permutation(arrange,arrange+n2));
+
+    delete[] col4Row;
+    delete[] arrange;
+
+    *minCostVal=minCost;
+    //The globally optimal solution has no cost gap.
+    *costGap=0;
+    return foundSol;
+}
+
+int assign3DCPP(ptrdiff_t *phi2,ptrdiff_t *phi3,double *minCostVal,double *costGap,const double *C,const size_t n1,const size_t n2,const size_t n3,const int algorithm,const size_t maxIter,const double epsVal) {
+    /*A single scratch space is used for all of the 2D assignment
+     *problems. No subproblem has more than n3 rows nor more than n1
+     *columns.*/
+    ScratchSpace workMem(n3,n1);
+
+    switch(algorithm) {
+        case 0:
+            return assign3DRelaxPattipati(phi2,phi3,minCostVal,costGap,C,n1,n2,n3,maxIter,epsVal,workMem);
+        case 1:
+            return assign3DRelaxFrieze(phi2,phi3,minCostVal,costGap,C,n1,n2,n3,maxIter,epsVal,workMem);
+        case 2:
+            return assign3DBruteForce(phi2,phi3,minCostVal,costGap,C,n1,n2,n3,workMem);
+        default:
+            return 0;
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,96 @@
+/*ASSIGN3DCPP A header file for functions implementing algorithms for the
+ *            axial 3D assignment problem. The algorithms repeatedly solve
+ *            2D assignment problems using the functions in
+ *            ShortestPathCPP.hpp.
+ *
+ *This file needs to be compiled with the files assign3DCPP.cpp and
+ *ShortestPathCPP.cpp
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef ASSIGN3DALGS
+#define ASSIGN3DALGS
+#include <stddef.h>
+
+int assign3DCPP(ptrdiff_t *phi2,
+                ptrdiff_t *phi3,
+                double *minCostVal,
+                double *costGap,
+                const double *C,
+                const size_t n1,
+                const size_t n2,
+                const size_t n3,
+                const int algorithm,
+                const size_t maxIter,
+                const double epsVal);
+/*ASSIGN3DCPP Solve the axial 3D assignment problem
+ *         minimize sum_{i} C(i,phi2(i),phi3(i))
+ *         where phi2 and phi3 are length n1 arrangements of n2 and n3
+ *         items, using either a Lagrangian relaxation approximation or
+ *         brute-force enumeration.
+ *
+ *INPUTS: phi2, phi3 Length n1 arrays in which the solution is placed.
+ *                   C(i,phi2[i],phi3[i]) is the cost for index i. The
+ *                   indices start from 0.
+ *        minCostVal A pointer to a double in which the cost of the
+ *                   assignment found is placed.
+ *           costGap A pointer to a double in which an upper bound on the
+ *                   difference between minCostVal and the true global
+ *                   minimum is placed (the duality gap). This is zero if
+ *                   algorithm=2.
+ *                 C An n1Xn2Xn3 cost hypermatrix, stored by column, where
+ *                   n1<=n2<=n3. Costs are real numbers > -Inf.
+ *        n1, n2, n3 The dimensions of C.
+ *         algorithm The algorithm to use. Possible values are
+ *                   0 Use the relaxation approximation of [1].
+ *                   1 Use the relaxation approximation of [2].
+ *                   2 Brute-force enumeration of all arrangements of the
+ *                     second dimension, solving a 2D assignment problem
+ *                     for the third.
+ *           maxIter The maximum number of subgradient iterations for
+ *                   algorithms 0 and 1.
+ *            epsVal The threshold on the relative duality gap for
+ *                   declaring convergence with algorithms 0 and 1.
+ *
+ *OUTPUTS: The return value is 1 if a solution with a finite cost was found
+ *         and 0 otherwise. If 0 is returned, phi2, phi3, minCostVal and
+ *         costGap are not valid.
+ *
+ *This is a C++ implementation of the algorithms in assign3D.m, which
+ *contains more documentation. A single ScratchSpace instance is used for
+ *all of the 2D assignment problems. The 2D assignment problems whose dual
+ *variables do not enter into the subgradient updates are warm-started from
+ *the solution of the previous iteration using assign2DWarmStart. If there
+ *are ties for the optimal solution of one of the 2D assignment problems,
+ *the tie might thus be broken differently than in assign3D.m.
+ *
+ *REFERENCES:
+ *[1] K. Pattipati, S. Deb, Y. Bar-Shalom, and R. B. Washburn Jr., "A
+ *    new relaxation algorithm and passive sensor data association," IEEE
+ *    Transactions on Automatic Control, vol. 37, no. 2, pp. 198-213, Feb.
+ *    1992.
+ *[2] A. M. Frieze and J. Yadegar, "An algorithm for solving 3-dimensional
+ *    assignment problems with application to scheduling a teaching
+ *    practice," The Journal of the Operational Research Society, vol. 32,
+ *    no. 11, pp. 989-995, Nov. 1981.
+ **/
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,534 @@
+/**ASSIGNSDCPP Functions in C++ implementing a generalized S-D assignment
+ *             algorithm for sparse lists of hypothesis tuples.
+ *
+ *  This file relies on the files assignSDCPP.hpp, ShortestPathCPP.hpp and
+ *  parallelForCPP.hpp. Much of the documentation for the functions is
+ *  found in assignSDCPP.hpp.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "assignSDCPP.hpp"
+#include "ShortestPathCPP.hpp"
+#include "parallelForCPP.hpp"
+#include <algorithm>
+#include <limits>
+#include <vector>
+//Needed for fabs and isfinite
+#include <math.h>
+
+using namespace std;
+
+/*The PairSortOrder class is used to sort the tuples by the indices of
+ *their first two dimensions so that all tuples sharing a pair of indices
+ *are contiguous.*/
+class PairSortOrder {
+public:
+    const size_t *tuples;
+    size_t S;
+
+    PairSortOrder(const size_t *tuplesIn, const size_t SIn) {
+        tuples=tuplesIn;
+        S=SIn;
+    }
+
+    inline bool operator()(const size_t a, const size_t b) const {
+        const size_t *tupA=tuples+a*S;
+        const size_t *tupB=tuples+b*S;
+
+        if(tupA[0]!=tupB[0]) {
+            return tupA[0]<tupB[0];
+        }
+        return tupA[1]<tupB[1];
+    }
+};
+
+/*The PairMinEvaluator class computes, for a range of pairs, the minimum
+ *reduced cost over all of the tuples sharing that pair of indices in the
+ *first two dimensions. For the dummy pair (0,0), which is not constrained
+ *in the relaxed problem, the sum of all negative reduced costs is
+ *computed instead. The reduced costs of all tuples are saved. It is used
+ *with parallelForCPP.*/
+class PairMinEvaluator {
+public:
+    const size_t *tuples;
+    const double *costs;
+    const double *u;
+    const size_t *uOffset;
+    const size_t *pairStart;
+    const size_t *pairI1;
+    const size_t *pairI2;
+    size_t S;
+    double *pairMin;
+    size_t *pairArg;
+    double *reducedCosts;
+
+    void operator()(const size_t threadIdx,const size_t startPair,const size_t endPair) {
+        size_t curPair,curTuple,s;
+        (void)threadIdx;
+
+        for(curPair=startPair;curPair<endPair;curPair++) {
+            const bool isDummyPair=(pairI1[curPair]==0&&pairI2[curPair]==0);
+            double minVal=numeric_limits<double>::infinity();
+            double negSum=0;
+            size_t minIdx=pairStart[curPair];
+
+            for(curTuple=pairStart[curPair];curTuple<pairStart[curPair+1];curTuple++) {
+                const size_t *curTup=tuples+curTuple*S;
+                double reducedCost=costs[curTuple];
+
+                for(s=2;s<S;s++) {
+                    reducedCost-=u[uOffset[s]+curTup[s]];
+                }
+                reducedCosts[curTuple]=reducedCost;
+
+                if(reducedCost<minVal) {
+                    minVal=reducedCost;
+                    minIdx=curTuple;
+                }
+                if(reducedCost<0) {
+                    negSum+=reducedCost;
+                }
+            }
+
+            pairMin[curPair]=isDummyPair?negSum:minVal;
+            pairArg[curPair]=minIdx;
+        }
+    }
+};
+
+//Prototypes for functions used in this file that are not present in
+//the header assignSDCPP.hpp.
+int solveDummy2D(vector<ptrdiff_t> &pairSel,const vector<double> &pairMin,const vector<size_t> &pairI1,const vector<size_t> &pairI2,const vector<ptrdiff_t> &pairLookup,const size_t n1,const size_t n2,const bool warmStart,ScratchSpace &workMem,MurtyHyp *problemSol,double *gain);
+
+int solveDummy2D(vector<ptrdiff_t> &pairSel,const vector<double> &pairMin,const vector<size_t> &pairI1,const vector<size_t> &pairI2,const vector<ptrdiff_t> &pairLookup,const size_t n1,const size_t n2,const bool warmStart,ScratchSpace &workMem,MurtyHyp *problemSol,double *gain) {
+/*SOLVEDUMMY2D Solve the 2D assignment problem over the first two
+ *             dimensions with dummy indices. The square cost matrix has
+ *             n1+n2 rows and columns. The first n2 rows are the non-dummy
+ *             indices of dimension 2 and the last n1 rows allow each index
+ *             of dimension 1 to be assigned to the dummy index of
+ *             dimension 2. Similarly, the first n1 columns are the
+ *             non-dummy indices of dimension 1 and the last n2 columns
+ *             allow the indices of dimension 2 to be assigned to the dummy
+ *             index of dimension 1. The dummy rows and columns can be
+ *             paired with each other at no cost. The indices of the pairs
+ *             chosen are placed in pairSel. The pair (0,0) is never
+ *             placed in pairSel. The return value is 0 if the problem is
+ *             infeasible and 1 otherwise.*/
+    const size_t N=n1+n2;
+    const double inf=numeric_limits<double>::infinity();
+    size_t curPair,curRow,curCol;
+    int found;
+
+    fill_n(workMem.C,N*N,inf);
+    for(curCol=n1;curCol<N;curCol++) {
+        fill_n(workMem.C+curCol*N+n2,n1,0.0);
+    }
+
+    for(curPair=0;curPair<pairMin.size();curPair++) {
+        const size_t i1=pairI1[curPair];
+        const size_t i2=pairI2[curPair];
+
+        if(i1!=0&&i2!=0) {
+            workMem.C[(i2-1)+(i1-1)*N]=pairMin[curPair];
+        } else if(i1!=0) {
+            workMem.C[(n2+i1-1)+(i1-1)*N]=pairMin[curPair];
+        } else if(i2!=0) {
+            workMem.C[(i2-1)+(n1+i2-1)*N]=pairMin[curPair];
+        }
+    }
+
+    //The cost matrix is adjusted in place.
+    if(warmStart) {
+        found=assign2DWarmStart(N,N,false,workMem.C,workMem,problemSol);
+    } else {
+        found=assign2D(N,N,false,workMem.C,workMem,problemSol);
+    }
+
+    if(found==0) {
+        return 0;
+    }
+    *gain=problemSol->gain;
+
+    pairSel.clear();
+    for(curCol=0;curCol<N;curCol++) {
+        size_t i1, i2;
+
+        curRow=(size_t)problemSol->row4col[curCol];
+        if(curCol<n1) {
+            i1=curCol+1;
+            i2=(curRow<n2)?curRow+1:0;
+        } else {
+            if(curRow>=n2) {
+                //A dummy row paired with a dummy column.
+                continue;
+            }
+            i1=0;
+            i2=curRow+1;
+        }
+
+        pairSel.push_back(pairLookup[i1+i2*(n1+1)]);
+    }
+
+    return 1;
+}
+
+int assignSDCPP(size_t *tupleSel,size_t *numSel,double *minCostVal,double *costGap,const size_t *tuples,const double *costs,const size_t numTuples,const size_t S,const size_t *dimSizes,const size_t maxIter,const double epsVal,const size_t numThreads) {
+    const size_t n1=dimSizes[0];
+    const size_t n2=dimSizes[1];
+    const size_t N=n1+n2;
+    const double inf=numeric_limits<double>::infinity();
+    size_t curTuple,curPair,numPairs,curIter,s,i;
+    size_t numUsedThreads;
+    vector<size_t> sortIdx(numTuples);
+    vector<size_t> sortedTuples(S*numTuples);
+    vector<double> sortedCosts(numTuples);
+    vector<size_t> pairStart, pairI1, pairI2, pairArg;
+    vector<double> pairMin, reducedCosts(numTuples);
+    vector<ptrdiff_t> pairLookup((n1+1)*(n2+1),-1);
+    vector<ptrdiff_t> pairSel;
+    vector<size_t> uOffset(S,0);
+    vector<double> u, g;
+    ptrdiff_t dummyPair=-1;
+    PairMinEvaluator evaluator;
+    double qStar=-inf;
+    double fStar=inf;
+    int foundSol=0;
+
+    if(S<2) {
+        return 0;
+    }
+
+    if(N==0) {
+        /*All of the tuples have dummy indices in the first two dimensions,
+         *so the first dimension can be dropped.*/
+        vector<size_t> subTuples;
+
+        if(S==2) {
+            return 0;
+        }
+
+        for(curTuple=0;curTuple<numTuples;curTuple++) {
+            subTuples.insert(subTuples.end(),tuples+curTuple*S+1,tuples+(curTuple+1)*S);
+        }
+        return assignSDCPP(tupleSel,numSel,minCostVal,costGap,subTuples.data(),costs,numTuples,S-1,dimSizes+1,maxIter,epsVal,numThreads);
+    }
+
+    /*Sort the tuples by their first two indices and store them contiguously
+     *so that the tuples of each pair are contiguous in memory.*/
+    for(curTuple=0;curTuple<numTuples;curTuple++) {
+        sortIdx[curTuple]=curTuple;
+    }
+    sort(sortIdx.begin(),sortIdx.end(),PairSortOrder(tuples,S));
+    for(curTuple=0;curTuple<numTuples;curTuple++) {
+        copy(tuples+sortIdx[curTuple]*S,tuples+(sortIdx[curTuple]+1)*S,sortedTuples.begin()+curTuple*S);
+        sortedCosts[curTuple]=costs[sortIdx[curTuple]];
+    }
+
+    //Find the start of each pair.
+    for(curTuple=0;curTuple<numTuples;curTuple++) {
+        const size_t *curTup=&sortedTuples[curTuple*S];
+
+        if(curTuple==0||curTup[0]!=pairI1.back()||curTup[1]!=pairI2.back()) {
+            pairLookup[curTup[0]+curTup[1]*(n1+1)]=(ptrdiff_t)pairI1.size();
+            if(curTup[0]==0&&curTup[1]==0) {
+                dummyPair=(ptrdiff_t)pairI1.size();
+            }
+            pairStart.push_back(curTuple);
+            pairI1.push_back(curTup[0]);
+            pairI2.push_back(curTup[1]);
+        }
+    }
+    numPairs=pairI1.size();
+    pairStart.push_back(numTuples);
+    pairMin.resize(numPairs);
+    pairArg.resize(numPairs);
+
+    //When S=2, a tuple with both indices zero has no meaning.
+    if(S==2&&dummyPair!=-1) {
+        pairMin[dummyPair]=0;
+    }
+
+    /*The Lagrange multipliers for dimensions 3 to S are stored
+     *contiguously. The multiplier for the dummy index of each dimension is
+     *always zero.*/
+    for(s=2;s<S;s++) {
+        uOffset[s]=u.size();
+        u.resize(u.size()+dimSizes[s]+1,0.0);
+    }
+    g.resize(u.size());
+
+    /*The overhead of starting the threads is only worth it if each thread
+     *gets a few hundred tuples.*/
+    numUsedThreads=numThreads2UseCPP(numThreads,min(numPairs,numTuples/256));
+    evaluator.tuples=sortedTuples.data();
+    evaluator.costs=sortedCosts.data();
+    evaluator.u=u.data();
+    evaluator.uOffset=uOffset.data();
+    evaluator.pairStart=pairStart.data();
+    evaluator.pairI1=pairI1.data();
+    evaluator.pairI2=pairI2.data();
+    evaluator.S=S;
+    evaluator.pairMin=pairMin.data();
+    evaluator.pairArg=pairArg.data();
+    evaluator.reducedCosts=reducedCosts.data();
+
+    {
+        ScratchSpace workMem(N,N);
+        MurtyHyp problemSol(N,N);
+        vector<size_t> relaxedSel;
+        vector<size_t> subTuples, subOrig, subSel;
+        vector<double> subCosts;
+        vector<size_t> subDimSizes(S>2?S-1:1);
+        vector<size_t> merged4Pair(numPairs);
+        vector<size_t> zeroTail4Pair(numPairs,numTuples);
+
+        /*For each pair, find a tuple (if any) whose indices in dimensions
+         *3 to S are all dummy indices. These are used to split merged
+         *pairs in the recursion.*/
+        for(curPair=0;curPair<numPairs;curPair++) {
+            for(curTuple=pairStart[curPair];curTuple<pairStart[curPair+1];curTuple++) {
+                const size_t *curTup=&sortedTuples[curTuple*S];
+
+                for(s=2;s<S;s++) {
+                    if(curTup[s]!=0) {
+                        break;
+                    }
+                }
+                if(s==S) {
+                    zeroTail4Pair[curPair]=curTuple;
+                    break;
+                }
+            }
+        }
+
+        for(curIter=0;curIter<maxIter||curIter==0;curIter++) {
+            double gain, q, normG2, target, stepSize;
+            bool improvedDual=false;
+
+            /*Evaluate the minimum reduced cost of each pair. This is the
+             *most expensive part when there are many tuples.*/
+            parallelForCPP(numPairs,numUsedThreads,evaluator);
+            if(S==2&&dummyPair!=-1) {
+                pairMin[dummyPair]=0;
+            }
+
+            //Solve the relaxed problem.
+            if(solveDummy2D(pairSel,pairMin,pairI1,pairI2,pairLookup,n1,n2,curIter>0,workMem,&problemSol,&gain)==0) {
+                break;
+            }
+
+            relaxedSel.clear();
+            for(i=0;i<pairSel.size();i++) {
+                relaxedSel.push_back(pairArg[pairSel[i]]);
+            }
+
+            if(S==2) {
+                //The relaxed problem is the full problem.
+                *numSel=relaxedSel.size();
+                for(i=0;i<relaxedSel.size();i++) {
+                    tupleSel[i]=sortIdx[relaxedSel[i]];
+                }
+                *minCostVal=gain;
+                *costGap=0;
+                return 1;
+            }
+
+            q=gain;
+            if(dummyPair!=-1) {
+                q+=pairMin[dummyPair];
+                for(curTuple=pairStart[dummyPair];curTuple<pairStart[dummyPair+1];curTuple++) {
+                    if(reducedCosts[curTuple]<0) {
+                        relaxedSel.push_back(curTuple);
+                    }
+                }
+            }
+            for(s=2;s<S;s++) {
+                for(i=1;i<=dimSizes[s];i++) {
+                    q+=u[uOffset[s]+i];
+                }
+            }
+
+            if(q>qStar) {
+                qStar=q;
+                improvedDual=true;
+            }
+
+            //The subgradient is the violation of the relaxed constraints.
+            fill(g.begin(),g.end(),1.0);
+            for(i=0;i<relaxedSel.size();i++) {
+                const size_t *curTup=&sortedTuples[relaxedSel[i]*S];
+
+                for(s=2;s<S;s++) {
+                    g[uOffset[s]+curTup[s]]-=1.0;
+                }
+            }
+            normG2=0;
+            for(s=2;s<S;s++) {
+                g[uOffset[s]]=0;
+                for(i=1;i<=dimSizes[s];i++) {
+                    normG2+=g[uOffset[s]+i]*g[uOffset[s]+i];
+                }
+            }
+
+            if(normG2==0) {
+                /*The relaxed solution satisfies all of the constraints, so
+                 *it is optimal.*/
+                double fVal=0;
+
+                for(i=0;i<relaxedSel.size();i++) {
+                    fVal+=sortedCosts[relaxedSel[i]];
+                }
+                if(fVal<fStar) {
+                    fStar=fVal;
+                    *numSel=relaxedSel.size();
+                    for(i=0;i<relaxedSel.size();i++) {
+                        tupleSel[i]=sortIdx[relaxedSel[i]];
+                    }
+                    foundSol=1;
+                }
+                if(fStar<qStar) {
+                    qStar=fStar;
+                }
+                break;
+            }
+
+            /*Get a feasible solution by fixing the chosen pairs of the
+             *first two dimensions as a merged dimension and solving the
+             *(S-1)-dimensional problem. Index 0 of the merged dimension
+             *holds the tuples whose first two indices are both zero. As
+             *the recursion is expensive for S>3, this is only done when
+             *the lower bound improves or no solution has been found.*/
+            if(improvedDual||foundSol==0) {
+                size_t numMerged=0;
+                size_t subNumSel=0;
+                double subCost, subGap;
+
+                fill(merged4Pair.begin(),merged4Pair.end(),numPairs+1);
+                for(i=0;i<pairSel.size();i++) {
+                    numMerged++;
+                    merged4Pair[pairSel[i]]=numMerged;
+                }
+                if(dummyPair!=-1) {
+                    merged4Pair[dummyPair]=0;
+                }
+
+                subTuples.clear();
+                subCosts.clear();
+                subOrig.clear();
+                for(curPair=0;curPair<numPairs;curPair++) {
+                    if(merged4Pair[curPair]>numPairs) {
+                        continue;
+                    }
+
+                    for(curTuple=pairStart[curPair];curTuple<pairStart[curPair+1];curTuple++) {
+                        const size_t *curTup=&sortedTuples[curTuple*S];
+
+                        //A merged dummy index with dummy indices elsewhere
+                        //is not a valid tuple.
+                        if(merged4Pair[curPair]==0) {
+                            for(s=2;s<S;s++) {
+                                if(curTup[s]!=0) {
+                                    break;
+                                }
+                            }
+                            if(s==S) {
+                                continue;
+                            }
+                        }
+
+                        subTuples.push_back(merged4Pair[curPair]);
+                        subTuples.insert(subTuples.end(),curTup+2,curTup+S);
+                        subCosts.push_back(sortedCosts[curTuple]);
+                        subOrig.push_back(curTuple);
+                        subOrig.push_back(numTuples);
+                    }
+
+                    /*If a merged pair (i1,i2) with i1,i2>0 has no tuple
+                     *with dummy indices in the other dimensions, then the
+                     *subproblem can be infeasible when the tuples of
+                     *different merged pairs conflict. Thus, the option of
+                     *splitting the pair into the tuples (i1,0,0,...) and
+                     *(0,i2,0,...) is added when they exist.*/
+                    if(merged4Pair[curPair]!=0&&pairI1[curPair]!=0&&pairI2[curPair]!=0&&zeroTail4Pair[curPair]==numTuples) {
+                        const ptrdiff_t pair1=pairLookup[pairI1[curPair]];
+                        const ptrdiff_t pair2=pairLookup[pairI2[curPair]*(n1+1)];
+
+                        if(pair1!=-1&&pair2!=-1&&zeroTail4Pair[pair1]!=numTuples&&zeroTail4Pair[pair2]!=numTuples) {
+                            subTuples.push_back(merged4Pair[curPair]);
+                            subTuples.insert(subTuples.end(),S-2,0);
+                            subCosts.push_back(sortedCosts[zeroTail4Pair[pair1]]+sortedCosts[zeroTail4Pair[pair2]]);
+                            subOrig.push_back(zeroTail4Pair[pair1]);
+                            subOrig.push_back(zeroTail4Pair[pair2]);
+                        }
+                    }
+                }
+
+                subDimSizes[0]=numMerged;
+                for(s=2;s<S;s++) {
+                    subDimSizes[s-1]=dimSizes[s];
+                }
+                subSel.resize(subCosts.size());
+
+                if(assignSDCPP(subSel.data(),&subNumSel,&subCost,&subGap,subTuples.data(),subCosts.data(),subCosts.size(),S-1,subDimSizes.data(),maxIter,epsVal,numThreads)&&subCost<fStar) {
+                    fStar=subCost;
+                    *numSel=0;
+                    for(i=0;i<subNumSel;i++) {
+                        const size_t *curOrig=&subOrig[2*subSel[i]];
+
+                        tupleSel[(*numSel)++]=sortIdx[curOrig[0]];
+                        if(curOrig[1]!=numTuples) {
+                            tupleSel[(*numSel)++]=sortIdx[curOrig[1]];
+                        }
+                    }
+                    foundSol=1;
+                }
+            }
+
+            //Check for convergence based on the relative duality gap.
+            if(foundSol) {
+                const double gapVal=fStar-qStar;
+
+                if(gapVal<=0||gapVal<=epsVal*fabs(qStar)) {
+                    break;
+                }
+            }
+
+            /*Take a subgradient step. If no feasible solution has been
+             *found yet, the step is based on the magnitude of the dual
+             *cost.*/
+            if(isfinite(fStar)) {
+                target=fStar;
+            } else {
+                target=q+max(fabs(q),1.0);
+            }
+            stepSize=(target-q)/normG2;
+            for(i=0;i<u.size();i++) {
+                u[i]+=stepSize*g[i];
+            }
+        }
+    }
+
+    if(foundSol) {
+        *minCostVal=fStar;
+        *costGap=max(fStar-qStar,0.0);
+    }
+    return foundSol;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
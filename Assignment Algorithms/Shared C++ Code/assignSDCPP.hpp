@@ -0,0 +1,108 @@
+/*ASSIGNSDCPP A header file for functions implementing a generalized S-D
+ *            assignment algorithm for sparse cost lists using successive
+ *            Lagrangian relaxation. The 2D assignment problems at the
+ *            bottom of the relaxation are solved using the functions in
+ *            ShortestPathCPP.hpp.
+ *
+ *This file needs to be compiled with the files assignSDCPP.cpp and
+ *ShortestPathCPP.cpp
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef ASSIGNSDALGS
+#define ASSIGNSDALGS
+#include <stddef.h>
+
+int assignSDCPP(size_t *tupleSel,
+                size_t *numSel,
+                double *minCostVal,
+                double *costGap,
+                const size_t *tuples,
+                const double *costs,
+                const size_t numTuples,
+                const size_t S,
+                const size_t *dimSizes,
+                const size_t maxIter,
+                const double epsVal,
+                const size_t numThreads);
+/*ASSIGNSDCPP Approximately solve the S-dimensional assignment problem
+ *         minimize sum_{z} c_z*rho_z
+ *         over binary rho_z, where each z is one of the hypothesis tuples
+ *         z=(i_1,...,i_S), subject to the constraint that for every
+ *         dimension s and every index i_s>=1 in that dimension, the sum
+ *         of rho_z over all tuples whose s-th index is i_s equals one.
+ *         Index 0 in each dimension is a dummy index (e.g. a missed
+ *         detection) that can be used by any number of tuples. Only the
+ *         tuples that are given are considered; all other tuples are
+ *         forbidden, so dense S-dimensional cost tensors are never
+ *         formed.
+ *
+ *INPUTS: tupleSel An array with space for numTuples elements in which the
+ *                 (0-based) indices of the tuples in the solution are
+ *                 placed.
+ *          numSel A pointer to a size_t in which the number of tuples
+ *                 placed in tupleSel is placed.
+ *      minCostVal A pointer to a double in which the cost of the solution
+ *                 is placed.
+ *         costGap A pointer to a double in which the duality gap, an
+ *                 upper bound on the difference between minCostVal and
+ *                 the true global minimum, is placed. This is zero when
+ *                 S=2, as the solution is then optimal.
+ *          tuples An S X numTuples array stored by column holding the
+ *                 indices of each tuple. The indices in dimension s range
+ *                 from 0 to dimSizes[s]. No tuple may have all indices
+ *                 equal to zero.
+ *           costs The length-numTuples array of the finite costs of the
+ *                 tuples.
+ *       numTuples The number of tuples.
+ *               S The number of dimensions, S>=2.
+ *        dimSizes A length-S array holding the number of non-dummy
+ *                 indices in each dimension.
+ *         maxIter The maximum number of subgradient iterations to perform
+ *                 at each level of the relaxation.
+ *          epsVal The relative duality gap below which the iterations are
+ *                 terminated.
+ *      numThreads The number of threads to use when evaluating the dual
+ *                 function. If this is zero, then the number of hardware
+ *                 threads is used.
+ *
+ *OUTPUTS: The return value is 1 if a feasible solution was found and 0
+ *         otherwise. If 0 is returned, the other outputs are not valid.
+ *
+ *The constraints of dimensions 3 to S are relaxed using Lagrange
+ *multipliers. The relaxed problem is a 2D assignment problem over the
+ *first two dimensions, where the cost of each pair (i_1,i_2) is the
+ *minimum reduced cost of all tuples starting with that pair. It is solved
+ *using the shortest augmenting path algorithm after adding dummy rows and
+ *columns for the dummy indices. The solution of the relaxed problem gives
+ *a lower bound on the optimal cost. A feasible solution is obtained by
+ *fixing the pairs of the first two dimensions chosen in the relaxed
+ *problem and recursively solving the resulting (S-1)-dimensional problem
+ *in the same manner. The multipliers are updated using a subgradient
+ *step. The evaluation of the minimum reduced cost of the pairs is split
+ *across threads. This is the general approach of
+ *S. Deb, M. Yeddanapudi, K. Pattipati, and Y. Bar-Shalom, "A generalized
+ *S-D assignment algorithm for multisensor-multitarget state estimation,"
+ *IEEE Transactions on Aerospace and Electronic Systems, vol. 33, no. 2,
+ *pp. 523-538, Apr. 1997.
+ **/
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -9,7 +9,13 @@
  *                   smallest finite element minus the largest element is
  *                   finite when performing maximization. Forbidden
  *                   assignments can be given costs of +Inf for
- *                   minimization and -Inf for maximization.
+ *                   minimization and -Inf for maximization. C can be
+ *                   of class double, single, int32 or int64. Single and
+ *                   int32 matrices are processed without being converted
+ *                   to doubles. Integer costs are solved exactly using
+ *                   64-bit integer arithmetic; an error is raised if the
+ *                   range of the costs is so large that this could
+ *                   overflow.
  *         k         The number >=1 of hypotheses to generate. If k is less
  *                   than the total number of unique hypotheses, then all
  *                   possible hypotheses will be returned.
@@ -25,7 +31,8 @@
  *                      row. 0 entries signify unassigned columns.
  *          gainBest    A kX1 vector containing the sum of the values of
  *                      the assigned elements in C for all of the
- *                      hypotheses.
+ *                      hypotheses. This is of class int64 if C is an
+ *                      integer matrix and double otherwise.
  * DEPENDENCIES: mex.h
  *               <algorithm>
  *               MexValidation.h
@@ -72,6 +79,7 @@
 
 #include "mex.h"
 #include <algorithm>
+#include <limits>
 /* This header validates inputs and includes a header needed to handle
  * Matlab matrices.*/
 #include "MexValidation.h"
@@ -79,58 +87,50 @@
 
 using namespace std;
 
-void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
-    size_t numRow,numCol,k,numFound;
-    mxArray *CMat, *col4rowMATLAB, *row4colMATLAB, *gainMATLAB;//These will hold the values to be returned.
+template<class CostType>
+void kBest2DForType(const int nlhs, mxArray *plhs[], const mxArray *CMATLAB, const size_t k, const bool maximize);
+
+template<class CostType>
+void kBest2DForType(const int nlhs, mxArray *plhs[], const mxArray *CMATLAB, const size_t k, const bool maximize) {
+/*KBEST2DFORTYPE Run the k-best assignment algorithm on the Matlab matrix
+ *               CMATLAB, whose elements are of type CostType, and set the
+ *               outputs.*/
+    typedef typename AssignCostTraits<CostType>::DualType DualType;
+    size_t numRow,numCol,numFound;
+    mxArray *col4rowMATLAB, *row4colMATLAB, *gainMATLAB;//These will hold the values to be returned.
     ptrdiff_t *col4rowBest, *row4colBest;
-    double *gainBest;
-    ScratchSpace workMem;//Scratch space needed for the assignment algorithm.
+    DualType *gainBest;
+    ScratchSpaceT<CostType> workMem;//Scratch space needed for the assignment algorithm.
+    const CostType *C;
+    CostType *CTrans=NULL;
     bool didFlip=false;
-    bool maximize=false;
-    
-    if(nrhs<2){
-        mexErrMsgTxt("Not enough inputs.");
-        return;
-    }
-    
-    k=getSizeTFromMatlab(prhs[1]);
-    if(k<=0){
-        mexErrMsgTxt("Invalid number of hypotheses requested.");
-        return;
-    }
-
-    if(nrhs==3) {
-        maximize=getBoolFromMatlab(prhs[2]);
-    }
-    
-    if(nrhs>3) {
-        mexErrMsgTxt("Too many inputs.");
-        return;
-    }
-    
-    if(nlhs>3) {
-        mexErrMsgTxt("Too many outputs.");
-        return;
-    }
+    const mxClassID dualClass=numeric_limits<CostType>::is_integer?mxINT64_CLASS:mxDOUBLE_CLASS;
     
-    /*Verify the validity of the assignment matrix.*/
-    checkRealDoubleArray(prhs[0]);
     /* Get the dimensions of the input data and the pointer to the matrix.
      * It is assumed that the matrix is not so large in M or N as to cause
      * an overflow when using a SIGNED integer data type.*/
-    numRow = mxGetM(prhs[0]);
-    numCol = mxGetN(prhs[0]);
+    numRow = mxGetM(CMATLAB);
+    numCol = mxGetN(CMATLAB);
+    C=(const CostType*)mxGetData(CMATLAB);
+    
+    if(costRangeIsSafe(C,numRow*numCol,max(numRow,numCol))==false) {
+        mexErrMsgTxt("The range of the integer costs is too large.");
+    }
 
     /* Transpose the matrix, if necessary, so that the number of rows is
-     * >= the number of columns.*/
-    if(numRow>=numCol) {
-        CMat=mxDuplicateArray(prhs[0]);
-    } else {        
-        swap(numRow,numCol);
+     * >= the number of columns. The input matrix is not modified, so no
+     * copy is made if it does not have to be transposed.*/
+    if(numRow<numCol) {
+        size_t curRow, curCol;
         
-        //This is freed using mxDestroyArray
-        CMat=mxCreateDoubleMatrix(numCol,numRow,mxREAL);
-        mexCallMATLAB(1, &CMat, 1,  (mxArray **)&prhs[0], "transpose");
+        CTrans=new CostType[numRow*numCol];
+        for(curCol=0;curCol<numCol;curCol++) {
+            for(curRow=0;curRow<numRow;curRow++) {
+                CTrans[curCol+curRow*numCol]=C[curRow+curCol*numRow];
+            }
+        }
+        C=CTrans;
+        swap(numRow,numCol);
         didFlip=true;
     }
     
@@ -141,15 +141,17 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     col4rowMATLAB =allocSignedSizeMatInMatlab(numRow,k);
     row4colMATLAB =allocSignedSizeMatInMatlab(numCol,k);
 
-    gainMATLAB = mxCreateNumericMatrix(k,1,mxDOUBLE_CLASS,mxREAL);
+    gainMATLAB = mxCreateNumericMatrix(k,1,dualClass,mxREAL);
     col4rowBest=(ptrdiff_t*)mxGetData(col4rowMATLAB);
     row4colBest=(ptrdiff_t*)mxGetData(row4colMATLAB);
-    gainBest=(double*)mxGetData(gainMATLAB);
+    gainBest=(DualType*)mxGetData(gainMATLAB);
 
     /*The assignment algorithm returns a nonzero value if no valid
      * solutions exist.*/
-    numFound=kBest2D(k,numRow,numCol,maximize, (double*)mxGetData(CMat), workMem, col4rowBest,row4colBest,gainBest);
-    mxDestroyArray(CMat);
+    numFound=kBest2D(k,numRow,numCol,maximize, C, workMem, col4rowBest,row4colBest,gainBest);
+    if(CTrans!=NULL) {
+        delete[] CTrans;
+    }
     
     if(numFound==0){
         mwSize dims[2] = {0,0};
@@ -157,11 +159,6 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
         mxSetDimensions(col4rowMATLAB, dims, numDims);
         mxSetDimensions(row4colMATLAB, dims, numDims);
         
-        dims[0]=1;
-        dims[1]=1;
-        mxSetDimensions(gainMATLAB, dims, numDims);
-        gainBest[0]=-1;
-        
         //Set the outputs
         mxDestroyArray(col4rowMATLAB);
         mxDestroyArray(row4colMATLAB);
@@ -189,9 +186,8 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
         case 3:
             dims[0]=numFound;
             dims[1]=1;
-        case 2:
             mxSetDimensions(gainMATLAB, dims, numDims); 
-            
+        case 2:
             dims[0]=numRow;
             dims[1]=numFound;
             /*Convert the indices to Matlab indices*/
@@ -228,6 +224,68 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
         default:
             plhs[0]=col4rowMATLAB;
     }
+}
+
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t k;
+    bool maximize=false;
+    
+    if(nrhs<2){
+        mexErrMsgTxt("Not enough inputs.");
+        return;
+    }
+    
+    k=getSizeTFromMatlab(prhs[1]);
+    if(k<=0){
+        mexErrMsgTxt("Invalid number of hypotheses requested.");
+        return;
+    }
+
+    if(nrhs==3) {
+        maximize=getBoolFromMatlab(prhs[2]);
+    }
+    
+    if(nrhs>3) {
+        mexErrMsgTxt("Too many inputs.");
+        return;
+    }
+    
+    if(nlhs>3) {
+        mexErrMsgTxt("Too many outputs.");
+        return;
+    }
+    
+    /*Verify the validity of the assignment matrix.*/
+    if(mxIsComplex(prhs[0])) {
+        mexErrMsgTxt("The cost matrix must be real.");
+        return;
+    }
+    if(mxIsEmpty(prhs[0])) {
+        mexErrMsgTxt("The cost matrix is empty.");
+        return;
+    }
+    if(mxGetNumberOfDimensions(prhs[0])>2) {
+        mexErrMsgTxt("The cost matrix has too many dimensions.");
+        return;
+    }
+    
+    switch(mxGetClassID(prhs[0])) {
+        case mxDOUBLE_CLASS:
+            kBest2DForType<double>(nlhs,plhs,prhs[0],k,maximize);
+            break;
+        case mxSINGLE_CLASS:
+            kBest2DForType<float>(nlhs,plhs,prhs[0],k,maximize);
+            break;
+        case mxINT32_CLASS:
+            kBest2DForType<int32_t>(nlhs,plhs,prhs[0],k,maximize);
+            break;
+        case mxINT64_CLASS:
+            kBest2DForType<int64_t>(nlhs,plhs,prhs[0],k,maximize);
+            break;
+        default:
+            mexErrMsgTxt("The cost matrix must be of class double, single, int32, or int64.");
+    }
     return;
 }
 
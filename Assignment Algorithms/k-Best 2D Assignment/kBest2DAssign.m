@@ -10,7 +10,10 @@ function [col4rowBest, row4colBest, gainBest]=kBest2DAssign(C,k,maximize)
 %                    smallest finite element minus the largest element is
 %                    finite when performing maximization. Forbidden
 %                    assignments can be given costs of +Inf for
-%                    minimization and -Inf for maximization.
+%                    minimization and -Inf for maximization. The compiled
+%                    version of this function also accepts single, int32
+%                    and int64 matrices without converting them to
+%                    doubles.
 %        k           The number >=1 of hypotheses to generate. If k is less
 %                    than the total number of unique hypotheses, then all
 %                    possible hypotheses will be returned.
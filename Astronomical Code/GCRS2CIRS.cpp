@@ -0,0 +1,142 @@
+/**GCRS2CIRS Convert vectors of position and possibly velocity from the
+ *           Geocentric Celestrial Reference System (GCRS), a type of
+ *           Earth-Centered Inertial (ECI) coordinate system, to the
+ *           Celestial Intermediate Reference System (CIRS), which is
+ *           offset by the rotation of the Celestial Intermediate Pole
+ *           (CIP). The velocity conversion omits the centrifugal effects
+ *           of the CIP motion, which have a period on the order of 14
+ *           months and are thus small.
+ *
+ *INPUTS:   x   The NXnumVec collection of vectors to convert. N can be 3,
+ *              or 6. If the vectors are 3D, then are position.
+ *              6D vectors are assumed to be position and velocity.
+ *Jul1, Jul2    Two parts of a Julian date given in terrestrial time (TT).
+ *              The units of the date are days. The full date is the sum of
+ *              both terms. The date is broken into two parts to provide
+ *              more bits of precision. It does not matter how the date is
+ *              split.
+ *dXdY          dXdY=[dX;dY] are the celestial pole offsets with respect to
+ *              the IAU 2006/2000A precession/nutation model in radians If
+ *              this parameter is omitted or an empty matrix is passed,
+ *              the value from the function getEOP will be used.
+ *numThreads    An optional parameter specifying the maximum number of
+ *              threads to use when there are multiple epochs. The default
+ *              if omitted or an empty matrix is passed is zero, which
+ *              means use the number of hardware threads.
+ *
+ *OUTPUTS: vec  A 3XN or 6XN matrix of vectors converted from GCRS
+ *              coordinates to CIRS coordinates.
+ *       rotMat The 3X3 rotation matrix used for the rotation of the
+ *              positions and velocities. If there are multiple epochs,
+ *              rotMat is 3X3XnumVec and rotMat(:,:,i) is the matrix for
+ *              the ith vector.
+ *
+ *The conversion functions from the International Astronomical Union's
+ *(IAU) Standard's of Fundamental Astronomy library are put together to get
+ *the necessary rotation matrix for the position.
+ *
+ *Each vector can be converted at its own epoch by passing Jul1 and Jul2
+ *as 1XnumVec vectors. The celestial pole offsets can likewise be given
+ *for each vector as a 2XnumVec matrix, or as a single pair that is used
+ *for all of the vectors. The rotations of the epochs are computed in
+ *parallel, so a time series should be converted in one call rather than
+ *one call per epoch.
+ *
+ *When there are many epochs, the X and Y coordinates of the Celestial
+ *Intermediate Pole and the CIO locator s are interpolated from Chebyshev
+ *polynomials that are fit over the span of the epochs the first time that
+ *they are needed and kept until the mex file is cleared, rather than
+ *being computed with the full IAU 2006/2000A series for each epoch. The
+ *polynomials agree with the series to within 1e-14 radians. See
+ *XYsChebCacheCPP.hpp.
+ *
+ *The algorithm can be compiled for use in Matlab  using the 
+ *CompileCLibraries function.
+ *
+ *The algorithm is run in Matlab using the command format
+ *[vec,rotMat]=GCRS2CIRS(x,Jul1,Jul2);
+ *or if more parameters are known,
+ *[vec,rotMat]=GCRS2CIRS(x,Jul1,Jul2,dXdY);
+ *or, to set the number of threads,
+ *[vec,rotMat]=GCRS2CIRS(x,Jul1,Jul2,dXdY,numThreads);
+ *
+ *April 2015 David F. Crouse, Naval Research Laboratory, Washington D.C.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+/*This header is required by Matlab.*/
+#include "mex.h"
+#include "MexValidation.h"
+/*This header is for the engine that computes the rotations at each
+ *epoch.*/
+#include "celestialRotationsCPP.hpp"
+/*This header is for reading the epochs and Earth orientation parameters.*/
+#include "EOPEpochsMexCPP.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t numRow,numVec;
+    size_t numThreads=0;
+    EarthOrientationEpochsCPP epochs;
+    mxArray *retMat;
+    double *rotMats=NULL;
+
+    if(nrhs<3||nrhs>5){
+        mexErrMsgTxt("Wrong number of inputs");
+    }
+
+    if(nlhs>2) {
+        mexErrMsgTxt("Wrong number of outputs.");
+    }
+
+    checkRealDoubleArray(prhs[0]);
+
+    numRow = mxGetM(prhs[0]);
+    numVec = mxGetN(prhs[0]);
+
+    if(!(numRow==3||numRow==6)) {
+        mexErrMsgTxt("The input vector has a bad dimensionality.");
+    }
+
+    //Get the epochs and the Earth orientation parameters. The values
+    //from the function getEOP are used for any that are omitted or empty.
+    getEOPEpochsMexCPP(epochs,numVec,prhs[1],prhs[2],NULL,NULL,nrhs>3?prhs[3]:NULL,NULL,EOP_EPOCHS_DXDY);
+
+    if(nrhs>4&&!mxIsEmpty(prhs[4])) {
+        numThreads=getSizeTFromMatlab(prhs[4]);
+    }
+
+    //Allocate space for the return vectors and the rotation matrices.
+    retMat=mxCreateDoubleMatrix(numRow,numVec,mxREAL);
+    if(nlhs>1) {
+        if(epochs.numEpochs==1) {
+            plhs[1]=mxCreateDoubleMatrix(3,3,mxREAL);
+        } else {
+            const mwSize dims[3]={3,3,numVec};
+
+            plhs[1]=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+        }
+        rotMats=(double*)mxGetData(plhs[1]);
+    }
+
+    celestialRotationsCPP((double*)mxGetData(retMat),rotMats,(double*)mxGetData(prhs[0]),numRow,numVec,epochs,CEL_ROT_GCRS2CIRS,0,getXYsCacheMexCPP(epochs,numThreads),numThreads);
+
+    plhs[0]=retMat;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
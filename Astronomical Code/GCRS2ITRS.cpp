@@ -0,0 +1,188 @@
+/**GCRS2ITRS  Convert vectors of position and possibly velocity from the
+ *            Geocentric Celestrial Reference System (GCRS), a type of
+ *            Earth-Centered Inertial (ECI) coordinate system, to the
+ *            International Terrestrial Reference System (ITRS), a type of
+ *            Earth-Centered Earth-Fixed (ECEF) coordinate system. Note
+ *            that the velocity correction includes the centrifugal effects
+ *            of the conversion from the terrestrial intermediate reference
+ *            system (TIRS) into the ITRS, but omits the effects of the
+ *            conversion from the GCRS into the celestial intermediate
+ *            reference system (CIRS). The period of the Celestial
+ *            Intermediate Pole (CIP) motion in the GCRS is on the order
+ *            of 14 months and thus is significantly smaller than the
+ *            rotation effects of the Earth in the TIRS. The velocity
+ *            conversion also does not include the (small) centrifugal
+ *            effect of polar motion.
+ *
+ *INPUTS:   x   The NXnumVec collection of vectors to convert. N can be 3,
+ *              or 6. If the vectors are 3D, then they are position.
+ *              6D vectors are assumed to be position
+ *              and velocity, whereby the angular velocity of the Earth's
+ *              rotation is taken into account using a non-relativistic
+ *              formula.
+ *Jul1, Jul2    Two parts of a Julian date given in terrestrial time (TT).
+ *              The units of the date are days. The full date is the sum of
+ *              both terms. The date is broken into two parts to provide
+ *              more bits of precision. It does not matter how the date is
+ *              split.
+ *deltaTTUT1    An optional parameter specifying the difference between TT
+ *              and UT1 in seconds. This information can be obtained from
+ *http://www.iers.org/nn_11474/IERS/EN/DataProducts/EarthOrientationData/eop.html?__nnn=true
+ *              or 
+ http://www.usno.navy.mil/USNO/earth-orientation/eo-products
+ *              If this parameter is omitted or if an empty matrix is
+ *              passed, then the value provided by the function getEOP
+ *              will be used instead.
+ *xpyp          xpyp=[xp;yp] are the polar motion coordinates in radians
+ *              including the effects of tides and librations. If this
+ *              parameter is omitted or if an empty matrix is passed, the
+ *              value from the function getEOP will be used.
+ *dXdY          dXdY=[dX;dY] are the celestial pole offsets with respect to
+ *              the IAU 2006/2000A precession/nutation model in radians If
+ *              this parameter is omitted, the value from the function
+ *              getEOP will be used.
+ *LOD           The difference between the length of the day using
+ *              terrestrial time, international atomic time, or UTC without
+ *              leap seconds and the length of the day in UT1. This is an
+ *              instantaneous parameter (in seconds) proportional to the
+ *              rotation rate of the Earth. This is only needed if more
+ *              than just position components are being converted.
+ *numThreads    An optional parameter specifying the maximum number of
+ *              threads to use when there are multiple epochs. The default
+ *              if omitted or an empty matrix is passed is zero, which
+ *              means use the number of hardware threads.
+ *
+ *OUTPUTS: vec  A 3XN or 6XN matrix of vectors converted from GCRS
+ *              coordinates to ITRS coordinates.
+ *       rotMat The 3X3 rotation matrix used for the conversion of the
+ *              positions. If there are multiple epochs, rotMat is
+ *              3X3XnumVec and rotMat(:,:,i) is the matrix for the ith
+ *              vector.
+ *
+ *The conversion functions from the International Astronomical Union's
+ *(IAU) Standard's of Fundamental Astronomy library are put together to get
+ *the necessary rotation matrix for the position.
+ *
+ *The velocity transformation deals with the instantaneous rotational
+ *velocity of the Earth using a simple Newtonian velocity addition.
+ *Basically, the axis of rotation in the Terrestrial Intermediate Reference
+ *System TIRS is the z-axis. The rotation rate in that system is
+ *Constants.IERSMeanEarthRotationRate adjusted using the Length-of-Day
+ *(LOD) Earth Orientation Parameter (EOP). Thus, in the TIRS, the angular
+ *velocity vector is [0;0;omega], where omega is the angular velocity
+ *accounting for the LOD EOP. Consequently, one accounts for rotation by
+ *transforming from the GCRS to the TIRS, subtracting the cross product of
+ *Omega with the position in the TIRS, and then converting to the ITRS.
+ *This is a simple Newtonian conversion.
+ *
+ *Each vector can be converted at its own epoch by passing Jul1 and Jul2
+ *as 1XnumVec vectors. The Earth orientation parameters can likewise be
+ *given for each vector, with deltaTTUT1 and LOD being 1XnumVec and xpyp
+ *and dXdY being 2XnumVec, or as single values that are used for all of
+ *the vectors. The rotations of the epochs are computed in parallel, so a
+ *time series should be converted in one call rather than one call per
+ *epoch.
+ *
+ *When there are many epochs, the X and Y coordinates of the Celestial
+ *Intermediate Pole and the CIO locator s are interpolated from Chebyshev
+ *polynomials that are fit over the span of the epochs the first time that
+ *they are needed and kept until the mex file is cleared, rather than
+ *being computed with the full IAU 2006/2000A series for each epoch. The
+ *polynomials agree with the series to within 1e-14 radians. See
+ *XYsChebCacheCPP.hpp.
+ *
+ *The algorithm can be compiled for use in Matlab  using the 
+ *CompileCLibraries function.
+ *
+ *The algorithm is run in Matlab using the command format
+ *[vec,rotMat]=GCRS2ITRS(x,Jul1,Jul2);
+ *or if more parameters are known,
+ *[vec,rotMat]=GCRS2ITRS(x,Jul1,Jul2,deltaTTUT1,xpyp,dXdY,LOD);
+ *or, to set the number of threads,
+ *[vec,rotMat]=GCRS2ITRS(x,Jul1,Jul2,deltaTTUT1,xpyp,dXdY,LOD,numThreads);
+ *
+ *December 2013 David F. Crouse, Naval Research Laboratory, Washington D.C.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+/*This header is required by Matlab.*/
+#include "mex.h"
+#include "MexValidation.h"
+/*This header is for the engine that computes the rotations at each
+ *epoch.*/
+#include "celestialRotationsCPP.hpp"
+/*This header is for reading the epochs and Earth orientation parameters.*/
+#include "EOPEpochsMexCPP.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t numRow,numVec;
+    size_t numThreads=0;
+    double meanRotRate;
+    EarthOrientationEpochsCPP epochs;
+    mxArray *retMat;
+    double *rotMats=NULL;
+
+    if(nrhs<3||nrhs>8){
+        mexErrMsgTxt("Wrong number of inputs");
+    }
+
+    if(nlhs>2) {
+        mexErrMsgTxt("Wrong number of outputs.");
+    }
+
+    checkRealDoubleArray(prhs[0]);
+
+    numRow = mxGetM(prhs[0]);
+    numVec = mxGetN(prhs[0]);
+
+    if(!(numRow==3||numRow==6)) {
+        mexErrMsgTxt("The input vector has a bad dimensionality.");
+    }
+
+    //Get the epochs and the Earth orientation parameters. The values
+    //from the function getEOP are used for any that are omitted or empty.
+    getEOPEpochsMexCPP(epochs,numVec,prhs[1],prhs[2],nrhs>3?prhs[3]:NULL,nrhs>4?prhs[4]:NULL,nrhs>5?prhs[5]:NULL,nrhs>6?prhs[6]:NULL,EOP_EPOCHS_DELTATTUT1|EOP_EPOCHS_XPYP|EOP_EPOCHS_DXDY|EOP_EPOCHS_LOD);
+
+    if(nrhs>7&&!mxIsEmpty(prhs[7])) {
+        numThreads=getSizeTFromMatlab(prhs[7]);
+    }
+
+    //The mean angular velocity of the Earth in radians per second. This
+    //is adjusted for the LOD in each epoch.
+    meanRotRate=getScalarMatlabClassConst("Constants","IERSMeanEarthRotationRate");
+
+    //Allocate space for the return vectors and the rotation matrices.
+    retMat=mxCreateDoubleMatrix(numRow,numVec,mxREAL);
+    if(nlhs>1) {
+        if(epochs.numEpochs==1) {
+            plhs[1]=mxCreateDoubleMatrix(3,3,mxREAL);
+        } else {
+            const mwSize dims[3]={3,3,numVec};
+
+            plhs[1]=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+        }
+        rotMats=(double*)mxGetData(plhs[1]);
+    }
+
+    celestialRotationsCPP((double*)mxGetData(retMat),rotMats,(double*)mxGetData(prhs[0]),numRow,numVec,epochs,CEL_ROT_GCRS2ITRS,meanRotRate,getXYsCacheMexCPP(epochs,numThreads),numThreads);
+
+    plhs[0]=retMat;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,143 @@
+/**GCRS2TOD Rotate a vector from the geocentric celestial reference system
+ *          (GCRS) to the true equator and equinox of date coordinate
+ *          system (TOD) using the IAU 2006/2000A model, where a location
+ *          is known as an "apparent place". The transformation is
+ *          performed by removing the precession, nutation, and frame bias.
+ *
+ *INPUTS:  xVec    The 3XN matrix of N 3X1 Cartesian vectors that are to
+ *                  be rotated from the GCRS into the TOD.
+ *         TT1, TT2 Jul1,Jul2 Two parts of a Julian date given in TT. The
+ *                  units of the date are days. The full date is the sum of
+ *                  both terms. The date is broken into two parts to
+ *                  provide more bits of precision. It does not matter how
+ *                  the date is split.
+ *         dXdY     dXdY=[dX;dY] are the celestial pole offsets with
+ *                  respect to the IAU 2006/2000A precession/nutation model
+ *                  in radians If this parameter is omitted or an empty
+ *                  matrix is passed, the value from the function getEOP
+ *                  will be used.
+ *numThreads        An optional parameter specifying the maximum number
+ *                  of threads to use when there are multiple epochs.
+ *                  The default if omitted or an empty matrix is passed
+ *                  is zero, which means use the number of hardware
+ *                  threads.
+ *
+ *OUTPUTS: xRot     The 3XN matrix of the N 3X1 input vector rotated into
+ *                  the TOD.
+ *         rotMat   The 3X3 rotation matrix such that
+ *                  xRot(:,i)=rotMat*xVec(:,i). If there are multiple
+ *                  epochs, rotMat is 3X3XnumVec and rotMat(:,:,i) is the
+ *                  matrix for the ith vector.
+ *
+ *This uses functions in the the International Astronomical Union's (IAU)
+ *Standard's of Fundamental Astronomy (SOFA) library to obtain the product
+ *of the nutation and precession rotation matrices  and the frame rotation
+ *bias matrix. One goes from GCRS to TOD by applying a frame bias and then
+ *precession and a nutation. The rotations are discussed in the
+ *documentation for the SOFA library as well as in
+ *G. Petit and B. Luzum, IERS Conventions (2010), International Earth
+ *Rotation and Reference Systems Service Std. 36, 2010.
+ *among other sources.
+ *
+ *The correction for using dXdY is the most accurate formula in
+ *G. H. Kaplan, "Celestial pole offsets: Conversion from (dx,dy) to
+ *(d?,d?)," U.S. Naval Observatory, Tech. Rep., May 2005. [Online].
+ *Available: http://aa.usno.navy.mil/publications/reports/dXdY to dpsideps.pdf
+ *
+ *Each vector can be converted at its own epoch by passing TT1 and TT2 as
+ *1XnumVec vectors. The celestial pole offsets can likewise be given for
+ *each vector as a 2XnumVec matrix, or as a single pair that is used for
+ *all of the vectors. The rotations of the epochs are computed in
+ *parallel, so a time series should be converted in one call rather than
+ *one call per epoch.
+ *
+ *The algorithm can be compiled for use in Matlab  using the 
+ *CompileCLibraries function.
+ *
+ *The algorithm is run in Matlab using the command format
+ *[xRot,rotMat]=GCRS2TOD(xVec,TT1,TT2);
+ *or
+ *[xRot,rotMat]=GCRS2TOD(xVec,TT1,TT2,dXdY);
+ *or, to set the number of threads,
+ *[xRot,rotMat]=GCRS2TOD(xVec,TT1,TT2,dXdY,numThreads);
+ *
+ *March 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+/*This header is required by Matlab.*/
+#include "mex.h"
+#include "MexValidation.h"
+/*This header is for the engine that computes the rotations at each
+ *epoch.*/
+#include "celestialRotationsCPP.hpp"
+/*This header is for reading the epochs and Earth orientation parameters.*/
+#include "EOPEpochsMexCPP.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t numRow,numVec;
+    size_t numThreads=0;
+    EarthOrientationEpochsCPP epochs;
+    mxArray *retMat;
+    double *rotMats=NULL;
+
+    if(nrhs<3||nrhs>5) {
+        mexErrMsgTxt("Incorrect number of inputs.");
+    }
+
+    if(nlhs>2) {
+        mexErrMsgTxt("Wrong number of outputs.");
+    }
+
+    checkRealDoubleArray(prhs[0]);
+
+    numRow = mxGetM(prhs[0]);
+    numVec = mxGetN(prhs[0]);
+
+    if(numRow!=3) {
+       mexErrMsgTxt("xVec has the wrong dimensionality. It must be an 3XN matrix.");
+    }
+
+    //Get the epochs and the Earth orientation parameters. The values
+    //from the function getEOP are used for any that are omitted or empty.
+    getEOPEpochsMexCPP(epochs,numVec,prhs[1],prhs[2],NULL,NULL,nrhs>3?prhs[3]:NULL,NULL,EOP_EPOCHS_DXDY);
+
+    if(nrhs>4&&!mxIsEmpty(prhs[4])) {
+        numThreads=getSizeTFromMatlab(prhs[4]);
+    }
+
+    //Allocate space for the return vectors and the rotation matrices.
+    retMat=mxCreateDoubleMatrix(numRow,numVec,mxREAL);
+    if(nlhs>1) {
+        if(epochs.numEpochs==1) {
+            plhs[1]=mxCreateDoubleMatrix(3,3,mxREAL);
+        } else {
+            const mwSize dims[3]={3,3,numVec};
+
+            plhs[1]=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+        }
+        rotMats=(double*)mxGetData(plhs[1]);
+    }
+
+    celestialRotationsCPP((double*)mxGetData(retMat),rotMats,(double*)mxGetData(prhs[0]),numRow,numVec,epochs,CEL_ROT_GCRS2TOD,0,NULL,numThreads);
+
+    plhs[0]=retMat;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,401 @@
+classdef SGP4Catalog < handle
+%%SGP4CATALOG A class that holds the SGP4 orbital elements of a catalog of
+%             satellites, such as a full set of published two-line element
+%             (TLE) sets, and propagates all of them in one call. If a C++
+%             class interface has been compiled, the SGP4/SDP4 ephemeris
+%             records of all of the satellites are initialized once when
+%             the catalog is made and each propagation runs over the
+%             satellites in parallel, which avoids a call to
+%             propagateOrbitSGP4 per satellite. Otherwise, the propagation
+%             just calls propagateOrbitSGP4 for each satellite.
+%
+%The elements, units, options and error codes are the same as in
+%propagateOrbitSGP4, but each satellite gets its own error codes, so a
+%decayed or invalid element set does not affect the rest of the catalog.
+%The states are in the obsolete True Equator Mean Equinox (TEME) of date
+%coordinate system.
+%
+%Note that if the C++ implementation is used, the mex file is locked when
+%an SGP4Catalog object is created and is not unlocked (and able to be
+%recompiled) until all of the SGP4Catalog objects have been freed.
+%
+%EXAMPLE:
+%Given a 7XnumSats matrix of SGP4 elements SGP4Elements and the two-part
+%epochs TTEpoch1 and TTEpoch2 in TT (for example from TLE2SGP4OrbEls or,
+%for a whole file of TLE sets, from TLEFile2SGP4OrbEls), the catalog is
+%propagated to a day of times every minute as
+% theCat=SGP4Catalog(SGP4Elements,TTEpoch1,TTEpoch2);
+% TT1=TTEpoch1(1)*ones(1441,1);
+% TT2=TTEpoch2(1)+(0:1440)'/1440;
+% [xState,errorState]=theCat.propagateTT(TT1,TT2);
+%where xState(:,k,i) is the state of satellite i at time k. The close
+%approaches within 1 km over that day are found using a grid of times 20
+%seconds apart as
+% [satPairs,TCA1,TCA2,missDist]=theCat.screenConjunctions(TTEpoch1(1),TTEpoch2(1),20,4321,1000);
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+properties(SetAccess=private)
+    numSats%The number of satellites in the catalog.
+    initErrors%The numSatsX1 error codes of the initialization.
+end
+
+properties(Access=private)
+    %These are only used if the C++ implementation does not exist.
+    SGP4Elements
+    TTEpoch1
+    TTEpoch2
+    opsMode
+    gravityModel
+    CPPData%Only used if an interface to a C++ implementation exists.
+end
+
+methods
+    function newCat=SGP4Catalog(SGP4Elements,TTEpoch1,TTEpoch2,opsMode,gravityModel,numThreads)
+    %%SGP4CATALOG Initialize a catalog of SGP4 element sets.
+    %
+    %INPUTS: SGP4Elements A 7XnumSats matrix of SGP4 orbital elements
+    %                  with one column per satellite in the format of
+    %                  propagateOrbitSGP4.
+    % TTEpoch1, TTEpoch2 The epochs of the elements in TT as two-part
+    %                  Julian dates. These are numSatsX1 or 1XnumSats
+    %                  vectors or scalars if all of the satellites share
+    %                  the same epoch. They can be omitted or empty
+    %                  matrices passed if no satellite uses the deep
+    %                  space propagator, but then propagateTT cannot be
+    %                  used.
+    % opsMode, gravityModel Optional parameters that are the same as in
+    %                  propagateOrbitSGP4. The defaults if omitted or
+    %                  empty matrices are passed are both 0.
+    %       numThreads An optional parameter specifying the maximum number
+    %                  of threads to use for the initialization. The
+    %                  default if omitted or an empty matrix is passed is
+    %                  zero, which means use the number of hardware
+    %                  threads. This is only used by the C++
+    %                  implementation.
+    %
+    %OUTPUTS: newCat A new SGP4Catalog instance.
+
+        if(nargin<2)
+            TTEpoch1=[];
+        end
+        if(nargin<3)
+            TTEpoch2=[];
+        end
+        if(nargin<4||isempty(opsMode))
+            opsMode=0;
+        end
+        if(nargin<5||isempty(gravityModel))
+            gravityModel=0;
+        end
+        if(nargin<6)
+            numThreads=[];
+        end
+
+        if(size(SGP4Elements,1)~=7)
+            error('The SGP4 elements must be a 7XnumSats matrix.');
+        end
+        newCat.numSats=size(SGP4Elements,2);
+
+        if(exist('SGP4CatalogCPPInt','file'))
+            [newCat.CPPData,newCat.initErrors]=SGP4CatalogCPPInt('SGP4CatalogCPP',SGP4Elements,TTEpoch1,TTEpoch2,opsMode,gravityModel,numThreads);
+            return;
+        end
+
+        newCat.SGP4Elements=SGP4Elements;
+        if(~isempty(TTEpoch1)&&~isempty(TTEpoch2))
+            newCat.TTEpoch1=TTEpoch1(:).*ones(newCat.numSats,1);
+            newCat.TTEpoch2=TTEpoch2(:).*ones(newCat.numSats,1);
+        end
+        newCat.opsMode=opsMode;
+        newCat.gravityModel=gravityModel;
+
+        %The initialization errors are those of propagating to the epoch.
+        newCat.initErrors=zeros(newCat.numSats,1);
+        for curSat=1:newCat.numSats
+            [~,newCat.initErrors(curSat)]=newCat.propagateSat(curSat,0);
+        end
+    end
+
+    function [xState,errorState]=propagate(theCat,deltaT,numThreads)
+    %%PROPAGATE Propagate all of the satellites to time offsets from
+    %           their epochs.
+    %
+    %INPUTS: theCat The SGP4Catalog instance.
+    %        deltaT The time offsets in seconds (TT) from the epoch of
+    %               each satellite. This is either a vector of numTimes
+    %               offsets that are used for all of the satellites or a
+    %               numTimesXnumSats matrix with one column per satellite.
+    %               A 1XnumSats vector is taken as one time per satellite.
+    %    numThreads An optional parameter specifying the maximum number of
+    %               threads to use. The default if omitted or an empty
+    %               matrix is passed is zero, which means use the number
+    %               of hardware threads. This is only used by the C++
+    %               implementation.
+    %
+    %OUTPUTS: xState The 6XnumTimesXnumSats states of the satellites in
+    %                TEME coordinates with position in meters and velocity
+    %                in meters per second.
+    %     errorState The numTimesXnumSats error codes, as described in
+    %                propagateOrbitSGP4.
+
+        if(nargin<3)
+            numThreads=[];
+        end
+
+        if(exist('SGP4CatalogCPPInt','file'))
+            [xState,errorState]=SGP4CatalogCPPInt('propagate',theCat.CPPData,deltaT,numThreads);
+            return;
+        end
+
+        numSats=theCat.numSats;
+        if(size(deltaT,2)==numSats&&numel(deltaT)>1)
+            numTimes=size(deltaT,1);
+        elseif(isvector(deltaT))
+            numTimes=numel(deltaT);
+            deltaT=repmat(deltaT(:),1,numSats);
+        else
+            error('The times must be a vector or have one column per satellite.');
+        end
+
+        xState=zeros(6,numTimes,numSats);
+        errorState=zeros(numTimes,numSats);
+        for curSat=1:numSats
+            [xState(:,:,curSat),errorState(:,curSat)]=theCat.propagateSat(curSat,deltaT(:,curSat));
+        end
+    end
+
+    function [xState,errorState]=propagateTT(theCat,TT1,TT2,numThreads)
+    %%PROPAGATETT Propagate all of the satellites to a common set of
+    %             times given as two-part Julian dates in TT. This
+    %             requires that the epochs were given when the catalog
+    %             was made.
+    %
+    %INPUTS: theCat The SGP4Catalog instance.
+    %      TT1, TT2 The two parts of the numTimes Julian dates in TT.
+    %    numThreads An optional parameter specifying the maximum number of
+    %               threads to use, as in the propagate method.
+    %
+    %OUTPUTS: xState, errorState The same as in the propagate method.
+
+        if(nargin<4)
+            numThreads=[];
+        end
+
+        if(numel(TT1)~=numel(TT2))
+            error('The two parts of the Julian dates must have the same number of elements.');
+        end
+
+        if(exist('SGP4CatalogCPPInt','file'))
+            [xState,errorState]=SGP4CatalogCPPInt('propagateTT',theCat.CPPData,TT1,TT2,numThreads);
+            return;
+        end
+
+        if(isempty(theCat.TTEpoch1))
+            error('The epochs of the elements must be given to propagate to Julian dates.');
+        end
+
+        numSats=theCat.numSats;
+        numTimes=numel(TT1);
+        xState=zeros(6,numTimes,numSats);
+        errorState=zeros(numTimes,numSats);
+        for curSat=1:numSats
+            deltaT=((TT1(:)-theCat.TTEpoch1(curSat))+(TT2(:)-theCat.TTEpoch2(curSat)))*86400;
+            [xState(:,:,curSat),errorState(:,curSat)]=theCat.propagateSat(curSat,deltaT);
+        end
+    end
+
+    function [satPairs,TCA1,TCA2,missDist,relSpeed]=screenConjunctions(theCat,TTStart1,TTStart2,deltaT,numSteps,threshold,numThreads)
+    %%SCREENCONJUNCTIONS Find all of the close approaches (conjunctions)
+    %           between pairs of satellites in the catalog with a miss
+    %           distance below a threshold over a span of time. The catalog
+    %           is propagated onto a grid of times and at each time, the
+    %           pairs that could come within the threshold in the interval
+    %           of deltaT around the time are found. The times of closest
+    %           approach of these candidates are then found by root
+    %           finding. The C++ implementation finds the candidates using
+    %           k-d trees and splits the times over multiple threads. The
+    %           Matlab implementation compares all pairs at each time and
+    %           is only practical for small catalogs. This requires that
+    %           the epochs were given when the catalog was made.
+    %
+    %INPUTS: theCat The SGP4Catalog instance.
+    % TTStart1, TTStart2 The start of the span as a two-part Julian date in
+    %               TT.
+    %        deltaT The spacing of the grid of times in seconds. Since the
+    %               number of candidate pairs at each time grows with
+    %               deltaT, a value of tens of seconds is typically best. It
+    %               should be small compared to the orbital periods, so that
+    %               a pair of satellites has at most one closest approach
+    %               in deltaT.
+    %      numSteps The number of times in the grid. The span ends
+    %               (numSteps-1)*deltaT seconds after the start.
+    %     threshold The maximum miss distance in meters.
+    %    numThreads An optional parameter specifying the maximum number of
+    %               threads to use, as in the propagate method.
+    %
+    %OUTPUTS: satPairs A 2XnumConj matrix of the indices of the satellites
+    %                of each close approach, with the smaller index first.
+    %     TCA1, TCA2 The numConjX1 times of closest approach as two-part
+    %                Julian dates in TT. The close approaches are sorted by
+    %                time.
+    %       missDist The numConjX1 distances between the satellites at the
+    %                times of closest approach in meters.
+    %       relSpeed The numConjX1 relative speeds of the satellites at the
+    %                times of closest approach in meters per second.
+    %
+    %Closest approaches at the start or the end of the span are not found.
+    %Satellites are left out at the times where the SGP4 error code is not
+    %zero.
+
+        if(nargin<7)
+            numThreads=[];
+        end
+
+        if(exist('SGP4CatalogCPPInt','file'))
+            [satPairs,TCA1,TCA2,missDist,relSpeed]=SGP4CatalogCPPInt('screenConjunctions',theCat.CPPData,TTStart1,TTStart2,deltaT,numSteps,threshold,numThreads);
+            return;
+        end
+
+        if(isempty(theCat.TTEpoch1))
+            error('The epochs of the elements must be given to screen for close approaches.');
+        end
+
+        GMEarth=3.986004418e14;
+        t=(0:(numSteps-1))'*deltaT;
+        tEnd=t(end);
+        [xState,errorState]=theCat.propagateTT(TTStart1*ones(numSteps,1),TTStart2+t/86400);
+        %The time from the epoch of each satellite to the start in seconds.
+        baseT=((TTStart1-theCat.TTEpoch1)+(TTStart2-theCat.TTEpoch2))*86400;
+
+        satPairs=zeros(2,0);
+        tCA=zeros(0,1);
+        missDist=zeros(0,1);
+        relSpeed=zeros(0,1);
+        for curStep=1:numSteps
+            valid=find(errorState(curStep,:)==0);
+            numValid=length(valid);
+            if(numValid<2)
+                continue;
+            end
+            r=reshape(xState(1:3,curStep,valid),3,numValid);
+            v=reshape(xState(4:6,curStep,valid),3,numValid);
+
+            %The same bounds as in the C++ implementation.
+            queryRadius=threshold+sqrt(max(sum(v.^2,1)))*deltaT;
+            accelMargin=(GMEarth/min(sum(r.^2,1)))*deltaT^2/4;
+            wa=max(t(curStep)-deltaT/2,0);
+            wb=min(t(curStep)+deltaT/2,tEnd);
+
+            for i1=1:(numValid-1)
+                i2=(i1+1):numValid;
+                dr=r(:,i2)-r(:,i1);
+                dv=v(:,i2)-v(:,i1);
+
+                %The closest approach with linear motion in the interval.
+                vv=sum(dv.^2,1);
+                tau=-sum(dr.*dv,1)./vv;
+                tau(vv==0)=0;
+                tau=min(max(tau,wa-t(curStep)),wb-t(curStep));
+                isCand=sum(dr.^2,1)<=queryRadius^2&sqrt(sum((dr+dv.*tau).^2,1))<=threshold+accelMargin;
+
+                for curCand=i2(isCand)
+                    sat1=valid(i1);
+                    sat2=valid(curCand);
+                    f=@(tt)theCat.rangeRate(sat1,sat2,baseT,tt);
+
+                    %The range rate goes from negative to nonnegative at a
+                    %closest approach.
+                    fa=f(wa);
+                    fb=f(wb);
+                    if(~(fa<0&&fb>=0))
+                        continue;
+                    end
+                    tRoot=fzero(f,[wa,wb]);
+
+                    [drCA,dvCA]=theCat.relState(sat1,sat2,baseT,tRoot);
+                    if(norm(drCA)<=threshold)
+                        satPairs(:,end+1)=[sat1;sat2];
+                        tCA(end+1,1)=tRoot;
+                        missDist(end+1,1)=norm(drCA);
+                        relSpeed(end+1,1)=norm(dvCA);
+                    end
+                end
+            end
+        end
+
+        [tCA,idx]=sort(tCA);
+        satPairs=satPairs(:,idx);
+        missDist=missDist(idx);
+        relSpeed=relSpeed(idx);
+        TCA1=TTStart1*ones(length(tCA),1);
+        TCA2=TTStart2+tCA/86400;
+    end
+
+    function delete(theCat)
+    %%DELETE The destructor method. This method is used when the catalog
+    %        is implemented as a C++ class. This method prevents a memory
+    %        leak.
+
+        if(exist('SGP4CatalogCPPInt','file')&&~isempty(theCat.CPPData))
+            SGP4CatalogCPPInt('~SGP4CatalogCPP',theCat.CPPData);
+        end
+    end
+end
+
+methods(Access=private)
+    function [xState,errorState]=propagateSat(theCat,curSat,deltaT)
+    %%PROPAGATESAT Propagate a single satellite with propagateOrbitSGP4.
+
+        if(isempty(theCat.TTEpoch1))
+            [xState,errorState]=propagateOrbitSGP4(theCat.SGP4Elements(:,curSat),deltaT,[],[],theCat.opsMode,theCat.gravityModel);
+        else
+            [xState,errorState]=propagateOrbitSGP4(theCat.SGP4Elements(:,curSat),deltaT,theCat.TTEpoch1(curSat),theCat.TTEpoch2(curSat),theCat.opsMode,theCat.gravityModel);
+        end
+    end
+
+    function [dr,dv]=relState(theCat,sat1,sat2,baseT,t)
+    %%RELSTATE The position and velocity of satellite sat2 relative to
+    %          satellite sat1 at a time t in seconds from the start of a
+    %          screening, where baseT holds the times from the epochs of
+    %          the satellites to the start. NaNs are returned if the
+    %          propagation of either satellite fails.
+
+        [x1,error1]=theCat.propagateSat(sat1,baseT(sat1)+t);
+        [x2,error2]=theCat.propagateSat(sat2,baseT(sat2)+t);
+        if(error1~=0||error2~=0)
+            dr=NaN(3,1);
+            dv=NaN(3,1);
+            return;
+        end
+        dr=x2(1:3)-x1(1:3);
+        dv=x2(4:6)-x1(4:6);
+    end
+
+    function f=rangeRate(theCat,sat1,sat2,baseT,t)
+    %%RANGERATE The derivative of half of the squared distance between two
+    %           satellites, which is zero at a closest approach.
+
+        [dr,dv]=theCat.relState(sat1,sat2,baseT,t);
+        f=dr'*dv;
+    end
+end
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
@@ -0,0 +1,319 @@
+/**SGP4CATALOGCPPINT An interface between the Matlab SGP4Catalog class and
+ *              the C++ SGP4CatalogCPP class, which holds the initialized
+ *              SGP4/SDP4 records of many satellites and propagates them in
+ *              parallel. This function is meant to be called by the
+ *              SGP4Catalog class in Matlab; not directly by the user.
+ *              Running the function with invalid inputs can crash Matlab.
+ *
+ *The function is called as
+ *[CPPData,initErrors]=SGP4CatalogCPPInt('SGP4CatalogCPP',SGP4Elements,TTEpoch1,TTEpoch2,opsMode,gravityModel,numThreads);
+ *where SGP4Elements is 7XnumSats, TTEpoch1 and TTEpoch2 are empty or have
+ *one element per satellite (or are scalars that are shared) and
+ *initErrors is the numSatsX1 vector of error codes from sgp4init,
+ *or
+ *[xState,errorState]=SGP4CatalogCPPInt('propagate',CPPData,deltaT,numThreads);
+ *where deltaT is a vector of offsets in seconds from the epochs that is
+ *shared by all of the satellites or is a numTimesXnumSats matrix with one
+ *column per satellite (a 1XnumSats vector is taken as one time per
+ *satellite), xState is 6XnumTimesXnumSats and errorState is
+ *numTimesXnumSats,
+ *or
+ *[xState,errorState]=SGP4CatalogCPPInt('propagateTT',CPPData,TT1,TT2,numThreads);
+ *where TT1 and TT2 are the two parts of a vector of shared Julian dates in
+ *TT, or
+ *[satPairs,TCA1,TCA2,missDist,relSpeed]=SGP4CatalogCPPInt('screenConjunctions',CPPData,TTStart1,TTStart2,deltaT,numSteps,threshold,numThreads);
+ *where the close approaches within threshold meters over numSteps times
+ *deltaT seconds apart starting at TTStart1+TTStart2 are found, satPairs
+ *is 2XnumConj with the one-based indices of the satellites of each close
+ *approach and the other outputs are numConjX1, or
+ *SGP4CatalogCPPInt('~SGP4CatalogCPP',CPPData);
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For strcmp
+#include <cstring>
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "SGP4CatalogCPP.hpp"
+#include "SGP4ConjunctionsCPP.hpp"
+
+static size_t getNumThreads(const int nrhs, const mxArray *prhs[], const int idx);
+static void allocStateOutputs(const int nlhs, mxArray *plhs[], const size_t numTimes, const size_t numSats, double **xState, double **errorState);
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    char cmd[64];
+    SGP4CatalogCPP *theCat;
+
+    if(nrhs<2) {
+        mexErrMsgTxt("Not enough inputs.");
+    }
+
+    if(nrhs>8) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+
+    //Get the command string that is passed.
+    mxGetString(prhs[0], cmd, sizeof(cmd));
+
+    if(!strcmp("SGP4CatalogCPP", cmd)) {
+        const double *SGP4Elements;
+        const double *TTEpoch1=NULL;
+        const double *TTEpoch2=NULL;
+        std::vector<double> epochBuffer;
+        bool opsMode=false;
+        bool gravityModel=false;
+        size_t numSats;
+
+        if(nrhs>7) {
+            mexErrMsgTxt("Too many inputs.");
+        }
+
+        if(nlhs>2) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        checkRealDoubleArray(prhs[1]);
+        if(mxGetM(prhs[1])!=7) {
+            mexErrMsgTxt("The SGP4 elements must be a 7XnumSats matrix.");
+        }
+        numSats=mxGetN(prhs[1]);
+        SGP4Elements=reinterpret_cast<const double*>(mxGetData(prhs[1]));
+
+        if(nrhs>3&&!mxIsEmpty(prhs[2])&&!mxIsEmpty(prhs[3])) {
+            const size_t numEl1=mxGetNumberOfElements(prhs[2]);
+            const size_t numEl2=mxGetNumberOfElements(prhs[3]);
+            size_t curSat;
+
+            checkRealDoubleArray(prhs[2]);
+            checkRealDoubleArray(prhs[3]);
+            if((numEl1!=1&&numEl1!=numSats)||(numEl2!=1&&numEl2!=numSats)) {
+                mexErrMsgTxt("The epochs must be scalars or have one element per satellite.");
+            }
+
+            //Scalar epochs are repeated for all of the satellites.
+            epochBuffer.resize(2*numSats);
+            for(curSat=0;curSat<numSats;curSat++) {
+                epochBuffer[curSat]=reinterpret_cast<const double*>(mxGetData(prhs[2]))[numEl1==1?0:curSat];
+                epochBuffer[numSats+curSat]=reinterpret_cast<const double*>(mxGetData(prhs[3]))[numEl2==1?0:curSat];
+            }
+            TTEpoch1=epochBuffer.data();
+            TTEpoch2=epochBuffer.data()+numSats;
+        }
+
+        if(nrhs>4&&!mxIsEmpty(prhs[4])) {
+            opsMode=getBoolFromMatlab(prhs[4]);
+        }
+
+        if(nrhs>5&&!mxIsEmpty(prhs[5])) {
+            gravityModel=getBoolFromMatlab(prhs[5]);
+        }
+
+        theCat=new SGP4CatalogCPP();
+        if(TTEpoch1==NULL&&theCat->needsEpochs(SGP4Elements,numSats)) {
+            delete theCat;
+            mexErrMsgTxt("The elements imply the use of the deep space propagator, but no time was given.");
+        }
+
+        theCat->init(SGP4Elements,numSats,TTEpoch1,TTEpoch2,opsMode,gravityModel,getNumThreads(nrhs,prhs,6));
+
+        //Lock this mex file so that it can not be cleared until the object
+        //has been deleted (This avoids a memory leak).
+        mexLock();
+        plhs[0]=ptr2Matlab<SGP4CatalogCPP*>(theCat);
+        if(nlhs>1) {
+            plhs[1]=intMat2MatlabDoubles(theCat->initErrors.data(),numSats,1);
+        }
+    } else if(!strcmp("propagate", cmd)) {
+        size_t M, N, numTimes;
+        bool timesPerSat;
+        double *xState, *errorState;
+
+        if(nrhs<3||nrhs>4) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>2) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theCat=Matlab2Ptr<SGP4CatalogCPP*>(prhs[1]);
+
+        checkRealDoubleArray(prhs[2]);
+        M=mxGetM(prhs[2]);
+        N=mxGetN(prhs[2]);
+        if(N==theCat->numSats&&(M>1||N>1)) {
+            //One column per satellite.
+            numTimes=M;
+            timesPerSat=true;
+        } else if(M==1||N==1) {
+            numTimes=M*N;
+            timesPerSat=false;
+        } else {
+            mexErrMsgTxt("The times must be a vector or have one column per satellite.");
+            return;
+        }
+
+        allocStateOutputs(nlhs,plhs,numTimes,theCat->numSats,&xState,&errorState);
+        theCat->propagate(xState,errorState,reinterpret_cast<const double*>(mxGetData(prhs[2])),numTimes,timesPerSat,getNumThreads(nrhs,prhs,3));
+        if(nlhs<2) {
+            mxFree(errorState);
+        }
+    } else if(!strcmp("propagateTT", cmd)) {
+        size_t numTimes;
+        double *xState, *errorState;
+
+        if(nrhs<4||nrhs>5) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>2) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theCat=Matlab2Ptr<SGP4CatalogCPP*>(prhs[1]);
+        if(!theCat->hasEpochs) {
+            mexErrMsgTxt("The epochs of the elements must be given to propagate to Julian dates.");
+        }
+
+        checkRealDoubleArray(prhs[2]);
+        checkRealDoubleArray(prhs[3]);
+        numTimes=mxGetNumberOfElements(prhs[2]);
+        if(mxGetNumberOfElements(prhs[3])!=numTimes) {
+            mexErrMsgTxt("The two parts of the Julian dates must have the same number of elements.");
+        }
+
+        allocStateOutputs(nlhs,plhs,numTimes,theCat->numSats,&xState,&errorState);
+        theCat->propagateTT(xState,errorState,reinterpret_cast<const double*>(mxGetData(prhs[2])),reinterpret_cast<const double*>(mxGetData(prhs[3])),numTimes,getNumThreads(nrhs,prhs,4));
+        if(nlhs<2) {
+            mxFree(errorState);
+        }
+    } else if(!strcmp("screenConjunctions", cmd)) {
+        std::vector<SGP4ConjunctionCPP> conjunctions;
+        double TTStart1, TTStart2, deltaT, threshold;
+        double *satPairs, *TCA1, *TCA2, *missDist, *relSpeed;
+        size_t numSteps, numConj, curConj;
+
+        if(nrhs<7) {
+            mexErrMsgTxt("Not enough inputs.");
+        }
+
+        if(nlhs>5) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theCat=Matlab2Ptr<SGP4CatalogCPP*>(prhs[1]);
+        if(!theCat->hasEpochs) {
+            mexErrMsgTxt("The epochs of the elements must be given to screen for close approaches.");
+        }
+
+        TTStart1=getDoubleFromMatlab(prhs[2]);
+        TTStart2=getDoubleFromMatlab(prhs[3]);
+        deltaT=getDoubleFromMatlab(prhs[4]);
+        numSteps=getSizeTFromMatlab(prhs[5]);
+        threshold=getDoubleFromMatlab(prhs[6]);
+        if(!(deltaT>0)||!(threshold>=0)) {
+            mexErrMsgTxt("The time step must be positive and the threshold nonnegative.");
+        }
+
+        screenSGP4ConjunctionsCPP(conjunctions,*theCat,TTStart1,TTStart2,deltaT,numSteps,threshold,getNumThreads(nrhs,prhs,7));
+
+        numConj=conjunctions.size();
+        plhs[0]=mxCreateDoubleMatrix(2,numConj,mxREAL);
+        satPairs=reinterpret_cast<double*>(mxGetData(plhs[0]));
+        TCA1=NULL;
+        TCA2=NULL;
+        missDist=NULL;
+        relSpeed=NULL;
+        if(nlhs>1) {
+            plhs[1]=mxCreateDoubleMatrix(numConj,1,mxREAL);
+            TCA1=reinterpret_cast<double*>(mxGetData(plhs[1]));
+        }
+        if(nlhs>2) {
+            plhs[2]=mxCreateDoubleMatrix(numConj,1,mxREAL);
+            TCA2=reinterpret_cast<double*>(mxGetData(plhs[2]));
+        }
+        if(nlhs>3) {
+            plhs[3]=mxCreateDoubleMatrix(numConj,1,mxREAL);
+            missDist=reinterpret_cast<double*>(mxGetData(plhs[3]));
+        }
+        if(nlhs>4) {
+            plhs[4]=mxCreateDoubleMatrix(numConj,1,mxREAL);
+            relSpeed=reinterpret_cast<double*>(mxGetData(plhs[4]));
+        }
+
+        for(curConj=0;curConj<numConj;curConj++) {
+            const SGP4ConjunctionCPP &theConj=conjunctions[curConj];
+
+            //Convert to Matlab's one-based indexation.
+            satPairs[2*curConj]=static_cast<double>(theConj.sat1+1);
+            satPairs[2*curConj+1]=static_cast<double>(theConj.sat2+1);
+            if(TCA1!=NULL) {
+                TCA1[curConj]=TTStart1;
+            }
+            if(TCA2!=NULL) {
+                TCA2[curConj]=TTStart2+theConj.tCA/86400.0;
+            }
+            if(missDist!=NULL) {
+                missDist[curConj]=theConj.missDist;
+            }
+            if(relSpeed!=NULL) {
+                relSpeed[curConj]=theConj.relSpeed;
+            }
+        }
+    } else if(!strcmp("~SGP4CatalogCPP", cmd)) {
+        theCat=Matlab2Ptr<SGP4CatalogCPP*>(prhs[1]);
+
+        delete theCat;
+        //Unlock the mex file allowing it to be cleared.
+        mexUnlock();
+    } else {
+        mexErrMsgTxt("Invalid string passed to SGP4CatalogCPPInt.");
+    }
+}
+
+static size_t getNumThreads(const int nrhs, const mxArray *prhs[], const int idx) {
+    //The default of zero means use the number of hardware threads.
+    if(nrhs>idx&&!mxIsEmpty(prhs[idx])) {
+        return getSizeTFromMatlab(prhs[idx]);
+    }
+    return 0;
+}
+
+static void allocStateOutputs(const int nlhs, mxArray *plhs[], const size_t numTimes, const size_t numSats, double **xState, double **errorState) {
+    //The states are returned as a 6XnumTimesXnumSats array. If the error
+    //codes are not requested, then they are put in a temporary buffer.
+    mwSize dims[3];
+
+    dims[0]=6;
+    dims[1]=numTimes;
+    dims[2]=numSats;
+    plhs[0]=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+    *xState=reinterpret_cast<double*>(mxGetData(plhs[0]));
+
+    if(nlhs>1) {
+        plhs[1]=mxCreateDoubleMatrix(numTimes,numSats,mxREAL);
+        *errorState=reinterpret_cast<double*>(mxGetData(plhs[1]));
+    } else {
+        *errorState=reinterpret_cast<double*>(mxMalloc(numTimes*numSats*sizeof(double)));
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
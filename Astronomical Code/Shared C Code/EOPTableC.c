@@ -0,0 +1,574 @@
+/*EOPTABLEC C functions for loading and interpolating a table of Earth
+ *          orientation parameters without calling back into Matlab. See
+ *          EOPTableC.h for details. The results match those of the Matlab
+ *          function getEOP.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "EOPTableC.h"
+#include "sofa.h"
+
+//The number of quantities in the table: xp, yp, UT1-UTC, LOD, dX, dY.
+#define EOP_NUM_QUANT 6
+#define EOP_XP 0
+#define EOP_YP 1
+#define EOP_UT1UTC 2
+#define EOP_LOD 3
+#define EOP_DX 4
+#define EOP_DY 5
+
+static const double pi=3.1415926535897932384626433832795;
+
+/*The oceanic tidal terms of the subroutine PMUT1_OCEANS in interp.f. Each
+ *row holds the multipliers of GMST+pi and the Delaunay arguments l, lp, F,
+ *D and Omega followed by the sine and cosine coefficients of x and y
+ *(microarcseconds) and of UT1 (microseconds).*/
+static const double oceanTerms[71][12]={
+    { 1,-1, 0,-2,-2,-2,   -0.05,   0.94,  -0.94,  -0.05,  0.396, -0.078},
+    { 1,-2, 0,-2, 0,-1,    0.06,   0.64,  -0.64,   0.06,  0.195, -0.059},
+    { 1,-2, 0,-2, 0,-2,    0.30,   3.42,  -3.42,   0.30,  1.034, -0.314},
+    { 1, 0, 0,-2,-2,-1,    0.08,   0.78,  -0.78,   0.08,  0.224, -0.073},
+    { 1, 0, 0,-2,-2,-2,    0.46,   4.15,  -4.15,   0.45,  1.187, -0.387},
+    { 1,-1, 0,-2, 0,-1,    1.19,   4.96,  -4.96,   1.19,  0.966, -0.474},
+    { 1,-1, 0,-2, 0,-2,    6.24,  26.31, -26.31,   6.23,  5.118, -2.499},
+    { 1, 1, 0,-2,-2,-1,    0.24,   0.94,  -0.94,   0.24,  0.172, -0.090},
+    { 1, 1, 0,-2,-2,-2,    1.28,   4.99,  -4.99,   1.28,  0.911, -0.475},
+    { 1, 0, 0,-2, 0, 0,   -0.28,  -0.77,   0.77,  -0.28, -0.093,  0.070},
+    { 1, 0, 0,-2, 0,-1,    9.22,  25.06, -25.06,   9.22,  3.025, -2.280},
+    { 1, 0, 0,-2, 0,-2,   48.82, 132.91,-132.90,  48.82, 16.020,-12.069},
+    { 1,-2, 0, 0, 0, 0,   -0.32,  -0.86,   0.86,  -0.32, -0.103,  0.078},
+    { 1, 0, 0, 0,-2, 0,   -0.66,  -1.72,   1.72,  -0.66, -0.194,  0.154},
+    { 1,-1, 0,-2, 2,-2,   -0.42,  -0.92,   0.92,  -0.42, -0.083,  0.074},
+    { 1, 1, 0,-2, 0,-1,   -0.30,  -0.64,   0.64,  -0.30, -0.057,  0.050},
+    { 1, 1, 0,-2, 0,-2,   -1.61,  -3.46,   3.46,  -1.61, -0.308,  0.271},
+    { 1,-1, 0, 0, 0, 0,   -4.48,  -9.61,   9.61,  -4.48, -0.856,  0.751},
+    { 1,-1, 0, 0, 0,-1,   -0.90,  -1.93,   1.93,  -0.90, -0.172,  0.151},
+    { 1, 1, 0, 0,-2, 0,   -0.86,  -1.81,   1.81,  -0.86, -0.161,  0.137},
+    { 1, 0,-1,-2, 2,-2,    1.54,   3.03,  -3.03,   1.54,  0.315, -0.189},
+    { 1, 0, 0,-2, 2,-1,   -0.29,  -0.58,   0.58,  -0.29, -0.062,  0.035},
+    { 1, 0, 0,-2, 2,-2,   26.13,  51.25, -51.25,  26.13,  5.512, -3.095},
+    { 1, 0, 1,-2, 2,-2,   -0.22,  -0.42,   0.42,  -0.22, -0.047,  0.025},
+    { 1, 0,-1, 0, 0, 0,   -0.61,  -1.20,   1.20,  -0.61, -0.134,  0.070},
+    { 1, 0, 0, 0, 0, 1,    1.54,   3.00,  -3.00,   1.54,  0.348, -0.171},
+    { 1, 0, 0, 0, 0, 0,  -77.48,-151.74, 151.74, -77.48,-17.620,  8.548},
+    { 1, 0, 0, 0, 0,-1,  -10.52, -20.56,  20.56, -10.52, -2.392,  1.159},
+    { 1, 0, 0, 0, 0,-2,    0.23,   0.44,  -0.44,   0.23,  0.052, -0.025},
+    { 1, 0, 1, 0, 0, 0,   -0.61,  -1.19,   1.19,  -0.61, -0.144,  0.065},
+    { 1, 0, 0, 2,-2, 2,   -1.09,  -2.11,   2.11,  -1.09, -0.267,  0.111},
+    { 1,-1, 0, 0, 2, 0,   -0.69,  -1.43,   1.43,  -0.69, -0.288,  0.043},
+    { 1, 1, 0, 0, 0, 0,   -3.46,  -7.28,   7.28,  -3.46, -1.610,  0.187},
+    { 1, 1, 0, 0, 0,-1,   -0.69,  -1.44,   1.44,  -0.69, -0.320,  0.037},
+    { 1, 0, 0, 0, 2, 0,   -0.37,  -1.06,   1.06,  -0.37, -0.407, -0.005},
+    { 1, 2, 0, 0, 0, 0,   -0.17,  -0.51,   0.51,  -0.17, -0.213, -0.005},
+    { 1, 0, 0, 2, 0, 2,   -1.10,  -3.42,   3.42,  -1.09, -1.436, -0.037},
+    { 1, 0, 0, 2, 0, 1,   -0.70,  -2.19,   2.19,  -0.70, -0.921, -0.023},
+    { 1, 0, 0, 2, 0, 0,   -0.15,  -0.46,   0.46,  -0.15, -0.193, -0.005},
+    { 1, 1, 0, 2, 0, 2,   -0.03,  -0.59,   0.59,  -0.03, -0.396, -0.024},
+    { 1, 1, 0, 2, 0, 1,   -0.02,  -0.38,   0.38,  -0.02, -0.253, -0.015},
+    { 2,-3, 0,-2, 0,-2,   -0.49,  -0.04,   0.63,   0.24, -0.089, -0.011},
+    { 2,-1, 0,-2,-2,-2,   -1.33,  -0.17,   1.53,   0.68, -0.224, -0.032},
+    { 2,-2, 0,-2, 0,-2,   -6.08,  -1.61,   3.13,   3.35, -0.637, -0.177},
+    { 2, 0, 0,-2,-2,-2,   -7.59,  -2.05,   3.44,   4.23, -0.745, -0.222},
+    { 2, 0, 1,-2,-2,-2,   -0.52,  -0.14,   0.22,   0.29, -0.049, -0.015},
+    { 2,-1,-1,-2, 0,-2,    0.47,   0.11,  -0.10,  -0.27,  0.033,  0.013},
+    { 2,-1, 0,-2, 0,-1,    2.12,   0.49,  -0.41,  -1.23,  0.141,  0.058},
+    { 2,-1, 0,-2, 0,-2,  -56.87, -12.93,  11.15,  32.88, -3.795, -1.556},
+    { 2,-1, 1,-2, 0,-2,   -0.54,  -0.12,   0.10,   0.31, -0.035, -0.015},
+    { 2, 1, 0,-2,-2,-2,  -11.01,  -2.40,   1.89,   6.41, -0.698, -0.298},
+    { 2, 1, 1,-2,-2,-2,   -0.51,  -0.11,   0.08,   0.30, -0.032, -0.014},
+    { 2,-2, 0,-2, 2,-2,    0.98,   0.11,  -0.11,  -0.58,  0.050,  0.022},
+    { 2, 0,-1,-2, 0,-2,    1.13,   0.11,  -0.13,  -0.67,  0.056,  0.025},
+    { 2, 0, 0,-2, 0,-1,   12.32,   1.00,  -1.41,  -7.31,  0.605,  0.266},
+    { 2, 0, 0,-2, 0,-2, -330.15, -26.96,  37.58, 195.92,-16.195, -7.140},
+    { 2, 0, 1,-2, 0,-2,   -1.01,  -0.07,   0.11,   0.60, -0.049, -0.021},
+    { 2,-1, 0,-2, 2,-2,    2.47,  -0.28,  -0.44,  -1.48,  0.111,  0.034},
+    { 2, 1, 0,-2, 0,-2,    9.40,  -1.44,  -1.88,  -5.65,  0.425,  0.117},
+    { 2,-1, 0, 0, 0, 0,   -2.35,   0.37,   0.47,   1.41, -0.106, -0.029},
+    { 2,-1, 0, 0, 0,-1,   -1.04,   0.17,   0.21,   0.62, -0.047, -0.013},
+    { 2, 0,-1,-2, 2,-2,   -8.51,   3.50,   3.29,   5.11, -0.437, -0.019},
+    { 2, 0, 0,-2, 2,-2, -144.13,  63.56,  59.23,  86.56, -7.547, -0.159},
+    { 2, 0, 1,-2, 2,-2,    1.19,  -0.56,  -0.52,  -0.72,  0.064,  0.000},
+    { 2, 0, 0, 0, 0, 1,    0.49,  -0.25,  -0.23,  -0.29,  0.027, -0.001},
+    { 2, 0, 0, 0, 0, 0,  -38.48,  19.14,  17.72,  23.11, -2.104,  0.041},
+    { 2, 0, 0, 0, 0,-1,  -11.44,   5.75,   5.32,   6.87, -0.627,  0.015},
+    { 2, 0, 0, 0, 0,-2,   -1.24,   0.63,   0.58,   0.75, -0.068,  0.002},
+    { 2, 1, 0, 0, 0, 0,   -1.77,   1.79,   1.71,   1.04, -0.146,  0.037},
+    { 2, 1, 0, 0, 0,-1,   -0.77,   0.78,   0.75,   0.45, -0.064,  0.017},
+    { 2, 0, 0, 2, 0, 2,   -0.33,   0.62,   0.65,   0.19, -0.049,  0.018}
+};
+
+/*The diurnal lunisolar terms of the subroutine PM_GRAVI in interp.f, with
+ *the multipliers followed by the sine and cosine coefficients of x and y
+ *(microarcseconds).*/
+static const double graviTerms[10][10]={
+    { 1,-1, 0,-2, 0,-1,   -0.44,   0.25,  -0.25,  -0.44},
+    { 1,-1, 0,-2, 0,-2,   -2.31,   1.32,  -1.32,  -2.31},
+    { 1, 1, 0,-2,-2,-2,   -0.44,   0.25,  -0.25,  -0.44},
+    { 1, 0, 0,-2, 0,-1,   -2.14,   1.23,  -1.23,  -2.14},
+    { 1, 0, 0,-2, 0,-2,  -11.36,   6.52,  -6.52, -11.36},
+    { 1,-1, 0, 0, 0, 0,    0.84,  -0.48,   0.48,   0.84},
+    { 1, 0, 0,-2, 2,-2,   -4.76,   2.73,  -2.73,  -4.76},
+    { 1, 0, 0, 0, 0, 0,   14.27,  -8.19,   8.19,  14.27},
+    { 1, 0, 0, 0, 0,-1,    1.93,  -1.11,   1.11,   1.93},
+    { 1, 1, 0, 0, 0, 0,    0.76,  -0.43,   0.43,   0.76}
+};
+
+static double modPos(const double x, const double y);
+static int readField(const char *line, const size_t lineLength, const size_t firstCol, const size_t lastCol, double *val);
+static void pchipSlopes(double *d, const double *x, const double *y, const size_t n);
+static double pchipEndSlope(const double h1, const double h2, const double del1, const double del2);
+static void tidalArguments(double *arg, double *dArg, const double MJD);
+static void tidalCorrections(const double MJD, double *corX, double *corY, double *corUT1, double *corLOD);
+
+int loadEOPTableC(EOPTableC *table, const char *fileName) {
+    FILE *fileID;
+    char *rawText;
+    long fileSize;
+    size_t numLines, numRead, curPos, curEntry, k;
+
+    table->numEntries=0;
+    table->MJD=NULL;
+    table->values=NULL;
+    table->slopes=NULL;
+
+    fileID=fopen(fileName,"rb");
+    if(fileID==NULL) {
+        return EOP_TABLE_OPEN_FAILED;
+    }
+
+    if(fseek(fileID,0,SEEK_END)!=0||(fileSize=ftell(fileID))<0||fseek(fileID,0,SEEK_SET)!=0) {
+        fclose(fileID);
+        return EOP_TABLE_OPEN_FAILED;
+    }
+
+    rawText=(char*)malloc((size_t)fileSize+1);
+    if(rawText==NULL) {
+        fclose(fileID);
+        return EOP_TABLE_ALLOC_FAILED;
+    }
+    numRead=fread(rawText,1,(size_t)fileSize,fileID);
+    fclose(fileID);
+    rawText[numRead]='\0';
+
+    //As in getEOP, every line that ends in a newline is an entry.
+    numLines=0;
+    for(curPos=0;curPos<numRead;curPos++) {
+        if(rawText[curPos]=='\n') {
+            numLines++;
+        }
+    }
+
+    table->MJD=(double*)malloc(sizeof(double)*(numLines+1));
+    table->values=(double*)calloc(EOP_NUM_QUANT*(numLines+1),sizeof(double));
+    table->slopes=(double*)malloc(sizeof(double)*EOP_NUM_QUANT*(numLines+1));
+    if(table->MJD==NULL||table->values==NULL||table->slopes==NULL) {
+        free(rawText);
+        freeEOPTableC(table);
+        return EOP_TABLE_ALLOC_FAILED;
+    }
+
+    //The values are first stored with the quantities of each entry
+    //together and are transposed once the number of entries is known.
+    curPos=0;
+    curEntry=0;
+    while(curEntry<numLines) {
+        const char *line=rawText+curPos;
+        double *curValues=table->slopes+EOP_NUM_QUANT*curEntry;
+        size_t lineLength=0;
+
+        while(line[lineLength]!='\n') {
+            lineLength++;
+        }
+        curPos+=lineLength+1;
+
+        for(k=0;k<EOP_NUM_QUANT;k++) {
+            curValues[k]=0;
+        }
+
+        //The columns are those used in getEOP.
+        if(!readField(line,lineLength,8,15,&table->MJD[curEntry])) {
+            free(rawText);
+            freeEOPTableC(table);
+            return EOP_TABLE_BAD_FORMAT;
+        }
+
+        //In finals.data, some of the final rows are just dates with no
+        //data. If x is not filled, then the end of the data has been
+        //reached.
+        if(!readField(line,lineLength,19,27,&curValues[EOP_XP])) {
+            break;
+        }
+
+        if(!readField(line,lineLength,38,46,&curValues[EOP_YP])||!readField(line,lineLength,59,68,&curValues[EOP_UT1UTC])) {
+            free(rawText);
+            freeEOPTableC(table);
+            return EOP_TABLE_BAD_FORMAT;
+        }
+
+        //LOD, dX and dY are not always filled.
+        if(lineLength>=80) {
+            readField(line,lineLength,80,86,&curValues[EOP_LOD]);
+
+            if(lineLength>=98&&readField(line,lineLength,98,106,&curValues[EOP_DX])) {
+                readField(line,lineLength,117,125,&curValues[EOP_DY]);
+            }
+        }
+
+        curEntry++;
+    }
+    free(rawText);
+
+    if(curEntry<2) {
+        freeEOPTableC(table);
+        return EOP_TABLE_BAD_FORMAT;
+    }
+    table->numEntries=curEntry;
+
+    for(curEntry=0;curEntry<table->numEntries;curEntry++) {
+        //The dates must be increasing for the interpolation.
+        if(curEntry>0&&!(table->MJD[curEntry]>table->MJD[curEntry-1])) {
+            freeEOPTableC(table);
+            return EOP_TABLE_BAD_FORMAT;
+        }
+
+        for(k=0;k<EOP_NUM_QUANT;k++) {
+            table->values[k*table->numEntries+curEntry]=table->slopes[EOP_NUM_QUANT*curEntry+k];
+        }
+    }
+
+    for(k=0;k<EOP_NUM_QUANT;k++) {
+        pchipSlopes(table->slopes+k*table->numEntries,table->MJD,table->values+k*table->numEntries,table->numEntries);
+    }
+
+    return EOP_TABLE_OK;
+}
+
+void freeEOPTableC(EOPTableC *table) {
+    free(table->MJD);
+    free(table->values);
+    free(table->slopes);
+    table->numEntries=0;
+    table->MJD=NULL;
+    table->values=NULL;
+    table->slopes=NULL;
+}
+
+void interpEOPTableC(const EOPTableC *table, const double JulUTC1, const double JulUTC2, double *xpyp, double *dXdY, double *deltaUTCUT1, double *deltaTTUT1, double *LOD) {
+    //The coefficient to convert arcseconds to radians.
+    const double as2Rad=(1.0/60.0)*(1.0/60.0)*pi/180.0;
+    const size_t n=table->numEntries;
+    const double *MJDTable=table->MJD;
+    //The date as a modified Julian date in one part.
+    const double MJD=(JulUTC1-2400000.5)+JulUTC2;
+    double vals[EOP_NUM_QUANT], corX, corY, corUT1, corLOD, s, h, del;
+    size_t k, idx;
+    int inTable;
+
+    //Find the interval holding the date with a binary search. Dates
+    //outside of the table use the first or last interval.
+    if(MJD<=MJDTable[0]) {
+        idx=0;
+    } else if(MJD>=MJDTable[n-2]) {
+        idx=n-2;
+    } else {
+        size_t lower=0;
+        size_t upper=n-2;
+
+        while(upper-lower>1) {
+            const size_t mid=lower+(upper-lower)/2;
+
+            if(MJDTable[mid]<=MJD) {
+                lower=mid;
+            } else {
+                upper=mid;
+            }
+        }
+        idx=lower;
+    }
+    inTable=(MJD>=MJDTable[0]&&MJD<=MJDTable[n-1]);
+
+    h=MJDTable[idx+1]-MJDTable[idx];
+    s=MJD-MJDTable[idx];
+    for(k=0;k<EOP_NUM_QUANT;k++) {
+        const double *y=table->values+k*n+idx;
+        const double *d=table->slopes+k*n+idx;
+        double c, b;
+
+        del=(y[1]-y[0])/h;
+        c=(3*del-2*d[0]-d[1])/h;
+        b=(d[0]-2*del+d[1])/(h*h);
+        vals[k]=y[0]+s*(d[0]+s*(c+s*b));
+    }
+
+    tidalCorrections(MJD,&corX,&corY,&corUT1,&corLOD);
+
+    if(inTable) {
+        vals[EOP_XP]+=corX;
+        vals[EOP_YP]+=corY;
+        vals[EOP_UT1UTC]+=corUT1;
+    } else {
+        //Outside of the table, the polar motion coordinates and the
+        //celestial pole offsets are set to zero and UT1-UTC is
+        //extrapolated linearly from the end entries.
+        const double *y=table->values+EOP_UT1UTC*n+idx;
+
+        vals[EOP_XP]=0;
+        vals[EOP_YP]=0;
+        vals[EOP_DX]=0;
+        vals[EOP_DY]=0;
+        vals[EOP_UT1UTC]=y[0]+s*(y[1]-y[0])/h;
+    }
+    //LOD is extrapolated with the end polynomials.
+    vals[EOP_LOD]+=corLOD;
+
+    if(xpyp!=NULL) {
+        xpyp[0]=vals[EOP_XP]*as2Rad;
+        xpyp[1]=vals[EOP_YP]*as2Rad;
+    }
+    if(dXdY!=NULL) {
+        dXdY[0]=vals[EOP_DX]*as2Rad;
+        dXdY[1]=vals[EOP_DY]*as2Rad;
+    }
+    if(deltaUTCUT1!=NULL) {
+        *deltaUTCUT1=-vals[EOP_UT1UTC];
+    }
+    if(deltaTTUT1!=NULL) {
+        double dayFrac, leapSeconds;
+        int year, month, day;
+
+        leapSeconds=0;
+        if(iauJd2cal(JulUTC1,JulUTC2,&year,&month,&day,&dayFrac)>=0) {
+            iauDat(year,month,day,dayFrac,&leapSeconds);
+        }
+        //The 32.184 is the offset of the zero mark of TT versus UTC and
+        //UT1.
+        *deltaTTUT1=-vals[EOP_UT1UTC]+32.184+leapSeconds;
+    }
+    if(LOD!=NULL) {
+        *LOD=vals[EOP_LOD];
+    }
+}
+
+double modPos(const double x, const double y) {
+/*MODPOS The modulo operation with the same sign convention as Matlab's mod
+ *       function for positive y.*/
+
+    return x-floor(x/y)*y;
+}
+
+int readField(const char *line, const size_t lineLength, const size_t firstCol, const size_t lastCol, double *val) {
+/*READFIELD Read a number from columns firstCol to lastCol (starting from 1)
+ *          of a line. The return value is zero and val is not changed if
+ *          the field is blank or is not a number.*/
+
+    char field[32];
+    char *endPtr;
+    size_t fieldLength;
+    double parsedVal;
+
+    if(firstCol>lineLength) {
+        return 0;
+    }
+    fieldLength=(lastCol<lineLength?lastCol:lineLength)-firstCol+1;
+    memcpy(field,line+firstCol-1,fieldLength);
+    field[fieldLength]='\0';
+
+    parsedVal=strtod(field,&endPtr);
+    if(endPtr==field) {
+        return 0;
+    }
+    *val=parsedVal;
+    return 1;
+}
+
+void pchipSlopes(double *d, const double *x, const double *y, const size_t n) {
+/*PCHIPSLOPES The derivatives at the n points of a shape-preserving
+ *            piecewise cubic Hermite interpolant, computed the same way as
+ *            in Matlab's pchip function.*/
+    size_t k;
+
+    if(n==2) {
+        d[0]=(y[1]-y[0])/(x[1]-x[0]);
+        d[1]=d[0];
+        return;
+    }
+
+    for(k=1;k<n-1;k++) {
+        const double h1=x[k]-x[k-1];
+        const double h2=x[k+1]-x[k];
+        const double del1=(y[k]-y[k-1])/h1;
+        const double del2=(y[k+1]-y[k])/h2;
+
+        if(del1*del2>0) {
+            const double hs=h1+h2;
+            const double w1=(h1+hs)/(3*hs);
+            const double w2=(hs+h2)/(3*hs);
+            const double dMax=fmax(fabs(del1),fabs(del2));
+            const double dMin=fmin(fabs(del1),fabs(del2));
+
+            d[k]=dMin/(w1*(del1/dMax)+w2*(del2/dMax));
+        } else {
+            d[k]=0;
+        }
+    }
+
+    d[0]=pchipEndSlope(x[1]-x[0],x[2]-x[1],(y[1]-y[0])/(x[1]-x[0]),(y[2]-y[1])/(x[2]-x[1]));
+    d[n-1]=pchipEndSlope(x[n-1]-x[n-2],x[n-2]-x[n-3],(y[n-1]-y[n-2])/(x[n-1]-x[n-2]),(y[n-2]-y[n-3])/(x[n-2]-x[n-3]));
+}
+
+double pchipEndSlope(const double h1, const double h2, const double del1, const double del2) {
+/*PCHIPENDSLOPE The noncentered, shape-preserving three-point formula for
+ *              the slope at an end point used by Matlab's pchip function.*/
+
+    double d=((2*h1+h2)*del1-h1*del2)/(h1+h2);
+
+    if((d>0)-(d<0)!=(del1>0)-(del1<0)) {
+        d=0;
+    } else if((del1>0)-(del1<0)!=(del2>0)-(del2<0)&&fabs(d)>fabs(3*del1)) {
+        d=3*del1;
+    }
+    return d;
+}
+
+void tidalArguments(double *arg, double *dArg, const double MJD) {
+/*TIDALARGUMENTS The arguments GMST+pi, l, lp, F, D and Omega in radians and
+ *               their derivatives in radians per day, as in the
+ *               subroutines PMUT1_OCEANS and PM_GRAVI of interp.f. The
+ *               expressions are those in getEOP.*/
+
+    const double secRad=pi/(180.0*3600.0);
+    //Julian centuries.
+    const double T=(MJD-51544.5)/36525.0;
+    const double T2=T*T;
+    const double T3=T2*T;
+    const double T4=T3*T;
+
+    arg[0]=(67310.54841+(876600.0*3600.0+8640184.812866)*T+0.093104*T2-6.2-6*T3)*15.0+648000.0;
+    arg[1]=-0.00024470*T4+0.051635*T3+31.8792*T2+1717915923.2178*T+485868.249036;
+    arg[2]=-0.00001149*T4-0.000136*T3-0.5532*T2+129596581.0481*T+1287104.79305;
+    arg[3]=0.00000417*T4-0.001037*T3-12.7512*T2+1739527262.8478*T+335779.526232;
+    arg[4]=-0.00003169*T4+0.006593*T3-6.3706*T2+1602961601.2090*T+1072260.70369;
+    arg[5]=-0.00005939*T4+0.007702*T3+7.4722*T2-6962890.2665*T+450160.398036;
+
+    dArg[0]=(876600.0*3600.0+8640184.812866+2*0.093104*T-3*6.2-6*T2)*15;
+    dArg[1]=-4*0.00024470*T3+3*0.051635*T2+2*31.8792*T+1717915923.2178;
+    dArg[2]=-4*0.00001149*T3-3*0.000136*T2-2*0.5532*T+129596581.0481;
+    dArg[3]=4*0.00000417*T3-3*0.001037*T2-2*12.7512*T+1739527262.8478;
+    dArg[4]=-4*0.00003169*T3+3*0.006593*T2-2*6.3706*T+1602961601.2090;
+    dArg[5]=-4*0.00005939*T3+3*0.007702*T2+2*7.4722*T-6962890.2665;
+
+    {
+        size_t i;
+        for(i=0;i<6;i++) {
+            arg[i]=modPos(arg[i],1296000.0)*secRad;
+            dArg[i]=dArg[i]*secRad/36525.0;
+        }
+    }
+}
+
+void tidalCorrections(const double MJD, double *corX, double *corY, double *corUT1, double *corLOD) {
+/*TIDALCORRECTIONS The sum of the oceanic tidal corrections of PMUT1_OCEANS
+ *                 and the lunisolar corrections of PM_GRAVI to x and y
+ *                 (arcseconds) and the oceanic corrections to UT1 and LOD
+ *                 (seconds) at the modified Julian date MJD.
+ *
+ *The multipliers of the arguments in the tables are all between -3 and 3,
+ *so rather than calling sin and cos for each of the 81 terms, the cosines
+ *and sines of the multiples of the six arguments are found once and the
+ *cosine and sine of the argument of each term are formed from them using
+ *the angle addition formulae.*/
+
+    double arg[6], dArg[6];
+    //The cosine and sine of m times argument i are at [i][m+3].
+    double cosMult[6][7], sinMult[6][7];
+    //The sums are kept in local variables, so that the terms do not have
+    //to wait on stores through the output pointers.
+    double sumX=0;
+    double sumY=0;
+    double sumUT1=0;
+    double sumLOD=0;
+    size_t j, i;
+    int m;
+
+    tidalArguments(arg,dArg,MJD);
+
+    for(i=0;i<6;i++) {
+        const double cosArg=cos(arg[i]);
+        const double sinArg=sin(arg[i]);
+
+        cosMult[i][3]=1;
+        sinMult[i][3]=0;
+        for(m=1;m<=3;m++) {
+            cosMult[i][3+m]=cosMult[i][2+m]*cosArg-sinMult[i][2+m]*sinArg;
+            sinMult[i][3+m]=sinMult[i][2+m]*cosArg+cosMult[i][2+m]*sinArg;
+            cosMult[i][3-m]=cosMult[i][3+m];
+            sinMult[i][3-m]=-sinMult[i][3+m];
+        }
+    }
+
+    for(j=0;j<71;j++) {
+        const double *term=oceanTerms[j];
+        double dag=0;
+        double sinAg=0;
+        double cosAg=1;
+
+        for(i=0;i<6;i++) {
+            const int mult=(int)term[i]+3;
+            const double cosPrev=cosAg;
+
+            cosAg=cosPrev*cosMult[i][mult]-sinAg*sinMult[i][mult];
+            sinAg=sinAg*cosMult[i][mult]+cosPrev*sinMult[i][mult];
+            dag+=term[i]*dArg[i];
+        }
+
+        sumX+=term[7]*cosAg+term[6]*sinAg;
+        sumY+=term[9]*cosAg+term[8]*sinAg;
+        sumUT1+=term[11]*cosAg+term[10]*sinAg;
+        sumLOD-=(-term[11]*sinAg+term[10]*cosAg)*dag;
+    }
+
+    for(j=0;j<10;j++) {
+        const double *term=graviTerms[j];
+        double sinAg=0;
+        double cosAg=1;
+
+        for(i=0;i<6;i++) {
+            const int mult=(int)term[i]+3;
+            const double cosPrev=cosAg;
+
+            cosAg=cosPrev*cosMult[i][mult]-sinAg*sinMult[i][mult];
+            sinAg=sinAg*cosMult[i][mult]+cosPrev*sinMult[i][mult];
+        }
+
+        sumX+=term[7]*cosAg+term[6]*sinAg;
+        sumY+=term[9]*cosAg+term[8]*sinAg;
+    }
+
+    //Convert from micro-units.
+    *corX=sumX*1e-6;
+    *corY=sumY*1e-6;
+    *corUT1=sumUT1*1e-6;
+    *corLOD=sumLOD*1e-6;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,109 @@
+/**EOPTABLEC A header file for C functions that load a table of Earth
+ *           orientation parameters (EOP) in the IERS finals format (the
+ *           format of ./data/EOP.txt that the Matlab function getEOP
+ *           reads) and interpolate it without calling back into Matlab.
+ *           The results are the same as those of getEOP: The tabulated
+ *           values are interpolated using piecewise cubic Hermite
+ *           interpolation with the same slopes as Matlab's pchip
+ *           function, the diurnal and subdiurnal tidal and libration
+ *           corrections from the subroutines PMUT1_OCEANS and PM_GRAVI in
+ *           the interp.f file of the IERS 2010 conventions are added and
+ *           the number of leap seconds comes from the iauDat function in
+ *           the SOFA library. As in getEOP, outside of the tabulated dates
+ *           the polar motion coordinates and celestial pole offsets are
+ *           zero, UT1-UTC is extrapolated linearly and LOD is extrapolated
+ *           using the end polynomials.
+ *
+ *The slopes of the interpolating polynomials are computed once when the
+ *table is loaded, so each interpolation is just a binary search, six cubic
+ *polynomials and the tidal series.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef EOPTABLEC
+#define EOPTABLEC
+
+#include <stddef.h>
+
+//The possible return values of loadEOPTableC.
+#define EOP_TABLE_OK 0
+#define EOP_TABLE_OPEN_FAILED 1
+#define EOP_TABLE_BAD_FORMAT 2
+#define EOP_TABLE_ALLOC_FAILED 3
+
+typedef struct {
+    size_t numEntries;
+    //The numEntries modified Julian dates in UTC of the entries.
+    double *MJD;
+    /*The tabulated values with the units in the file. Element
+     *k*numEntries+i is the ith entry of quantity k, where the quantities
+     *are xp (arcseconds), yp (arcseconds), UT1-UTC (seconds), LOD
+     *(milliseconds, as tabulated), dX and dY.*/
+    double *values;
+    //The Hermite slopes of the quantities, stored the same way.
+    double *slopes;
+} EOPTableC;
+
+int loadEOPTableC(EOPTableC *table, const char *fileName);
+/*Read an EOP file in the IERS finals format into table. Entries are read
+ *until the first line without polar motion coordinates. The return value
+ *is EOP_TABLE_OK on success or one of the other EOP_TABLE_ values on
+ *failure, in which case the table is left empty.*/
+
+void freeEOPTableC(EOPTableC *table);
+/*Free the memory of a table that was filled by loadEOPTableC. The table
+ *is left empty.*/
+
+void interpEOPTableC(const EOPTableC *table, const double JulUTC1, const double JulUTC2, double *xpyp, double *dXdY, double *deltaUTCUT1, double *deltaTTUT1, double *LOD);
+/*Interpolate the table at the two-part pseudo-Julian date JulUTC1+JulUTC2
+ *in UTC. The outputs are the same as those of the Matlab function getEOP:
+ *xpyp and dXdY are length-2 arrays in radians, deltaUTCUT1 is UTC-UT1 in
+ *seconds, deltaTTUT1 is TT-UT1 in seconds and LOD is the tabulated length
+ *of day offset with the tidal correction added. Any of the output pointers
+ *can be NULL if the value is not needed.*/
+
+void getEOPMexC(const double JulUTC1, const double JulUTC2, double *xpyp, double *dXdY, double *deltaUTCUT1, double *deltaTTUT1, double *LOD);
+/*This function is only for use in mex files. It is the same as
+ *interpEOPTableC, except the table is the file data/EOP.txt in the folder
+ *of getEOP.m, which is loaded the first time that the function is called
+ *and stays in memory until the mex file is cleared. The modification time
+ *and size of the file are checked at most once a second and the table is
+ *reloaded if either changed. An error is raised in Matlab if the file can
+ *not be loaded.*/
+
+const EOPTableC *getEOPTableMexC(void);
+/*This function is only for use in mex files. Get the table that
+ *getEOPMexC uses, loading it if necessary or reloading it if the file
+ *changed since it was loaded. Since interpEOPTableC does not change the
+ *table, the returned table can be interpolated from multiple threads at
+ *once, which getEOPMexC itself cannot do, because it might have to call
+ *back into Matlab. The table can be replaced by the next call to
+ *getEOPMexC or getEOPTableMexC, so it must not be used after that.*/
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
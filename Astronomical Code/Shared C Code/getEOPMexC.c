@@ -0,0 +1,174 @@
+/*GETEOPMEXC The function getEOPMexC for use in mex files. The table of
+ *           Earth orientation parameters in data/EOP.txt in the folder of
+ *           getEOP.m is loaded the first time that the function is called
+ *           and is kept until the mex file is cleared, so mex files do not
+ *           have to call back into Matlab to get the parameters. The
+ *           modification time and size of the file are recorded when it
+ *           is loaded and the table is reloaded if they change, such as
+ *           when getEOP replaces the file with data downloaded using
+ *           refreshFromSource. See EOPTableC.h for details.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "mex.h"
+#include "EOPTableC.h"
+
+static EOPTableC EOPTable={0,NULL,NULL,NULL};
+//The full path of the file, which is found the first time that the table
+//is loaded. This is persistent memory freed when the mex file is cleared.
+static char *EOPFileName=NULL;
+//The modification time and size of the file when the table was loaded.
+static time_t EOPFileModTime=0;
+static long long EOPFileSize=-1;
+//The time at which the file was last checked for changes.
+static time_t EOPLastCheckTime=0;
+
+static void findEOPFileMex(void);
+static int EOPFileChanged(void);
+static void freeEOPTableAtExit(void);
+
+void getEOPMexC(const double JulUTC1, const double JulUTC2, double *xpyp, double *dXdY, double *deltaUTCUT1, double *deltaTTUT1, double *LOD) {
+    const EOPTableC *table=&EOPTable;
+
+    //This is usually called once per date and checking the file takes
+    //about half as long as an interpolation, so the file is checked at
+    //most once a second here.
+    if(EOPTable.numEntries==0||time(NULL)!=EOPLastCheckTime) {
+        table=getEOPTableMexC();
+    }
+
+    interpEOPTableC(table,JulUTC1,JulUTC2,xpyp,dXdY,deltaUTCUT1,deltaTTUT1,LOD);
+}
+
+const EOPTableC *getEOPTableMexC(void) {
+    if(EOPFileName==NULL) {
+        findEOPFileMex();
+    }
+
+    if(EOPTable.numEntries==0||EOPFileChanged()) {
+        EOPTableC newTable={0,NULL,NULL,NULL};
+        struct stat fileStat;
+        int retVal;
+
+        //The file is checked before it is read, so that if it is changed
+        //while it is being read, it is read again on the next call.
+        if(stat(EOPFileName,&fileStat)!=0) {
+            mexErrMsgTxt("Could not open the EOP.txt file of getEOP.");
+        }
+
+        //The old table is kept if the new one can not be loaded.
+        retVal=loadEOPTableC(&newTable,EOPFileName);
+        switch(retVal) {
+            case EOP_TABLE_OK:
+                break;
+            case EOP_TABLE_OPEN_FAILED:
+                mexErrMsgTxt("Could not open the EOP.txt file of getEOP.");
+                break;
+            case EOP_TABLE_ALLOC_FAILED:
+                mexErrMsgTxt("Could not allocate memory for the Earth orientation parameters.");
+                break;
+            default:
+                mexErrMsgTxt("The EOP.txt file of getEOP is not in the expected format.");
+                break;
+        }
+
+        freeEOPTableC(&EOPTable);
+        EOPTable=newTable;
+        EOPFileModTime=fileStat.st_mtime;
+        EOPFileSize=(long long)fileStat.st_size;
+        EOPLastCheckTime=time(NULL);
+    }
+
+    return &EOPTable;
+}
+
+void findEOPFileMex(void) {
+/*FINDEOPFILEMEX Set EOPFileName to the full path of data/EOP.txt in the
+ *               folder of getEOP.m, finding the folder the same way that
+ *               Matlab would when calling the function.
+ */
+    static const char dataPath[]="data/EOP.txt";
+    mxArray *funcName, *pathMATLAB;
+    char *scriptPath, *fileName;
+    size_t pathLength;
+
+    funcName=mxCreateString("getEOP");
+    mexCallMATLAB(1,&pathMATLAB,1,&funcName,"which");
+    mxDestroyArray(funcName);
+    scriptPath=mxArrayToString(pathMATLAB);
+    mxDestroyArray(pathMATLAB);
+    if(scriptPath==NULL) {
+        mexErrMsgTxt("The function getEOP could not be found.");
+    }
+
+    //Remove the file name, leaving the path separator.
+    pathLength=strlen(scriptPath);
+    while(pathLength>0&&scriptPath[pathLength-1]!='/'&&scriptPath[pathLength-1]!='\\') {
+        pathLength--;
+    }
+    if(pathLength==0) {
+        mxFree(scriptPath);
+        mexErrMsgTxt("The function getEOP could not be found.");
+    }
+
+    fileName=(char*)mxMalloc(pathLength+sizeof(dataPath));
+    memcpy(fileName,scriptPath,pathLength);
+    memcpy(fileName+pathLength,dataPath,sizeof(dataPath));
+    mxFree(scriptPath);
+
+    mexMakeMemoryPersistent(fileName);
+    EOPFileName=fileName;
+    mexAtExit(freeEOPTableAtExit);
+}
+
+int EOPFileChanged(void) {
+/*EOPFILECHANGED Return nonzero if the modification time or the size of
+ *               the file differ from when the table was loaded. If the
+ *               file can not be checked, such as while it is being
+ *               replaced, the table that is loaded is kept. A file that is
+ *               replaced twice within a second with the same size is not
+ *               detected, since the modification time has a resolution of
+ *               a second on some systems.
+ */
+    struct stat fileStat;
+
+    EOPLastCheckTime=time(NULL);
+    if(stat(EOPFileName,&fileStat)!=0) {
+        return 0;
+    }
+
+    return fileStat.st_mtime!=EOPFileModTime||(long long)fileStat.st_size!=EOPFileSize;
+}
+
+void freeEOPTableAtExit(void) {
+/*FREEEOPTABLEATEXIT Free the table and the file name when the mex file is
+ *                   cleared.
+ */
+
+    freeEOPTableC(&EOPTable);
+    mxFree(EOPFileName);
+    EOPFileName=NULL;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
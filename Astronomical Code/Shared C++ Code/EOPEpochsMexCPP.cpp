@@ -0,0 +1,271 @@
+/**EOPEPOCHSMEXCPP Functions for mex files to read the epochs and Earth
+ *                orientation parameters that are passed to the
+ *                celestial/terrestrial coordinate conversion functions.
+ *                See EOPEpochsMexCPP.hpp for details.
+ *
+ *This file does not include MexValidation.h, because that header defines
+ *its functions and it is already included by the mex files.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <math.h>
+#include "EOPEpochsMexCPP.hpp"
+/*This header is for the SOFA library.*/
+#include "sofa.h"
+/*This header is for the native table of Earth orientation parameters.*/
+#include "EOPTableC.h"
+
+//The cache of the precession-nutation quantities of this mex file.
+static XYsChebCacheCPP XYsCacheMex;
+
+static size_t scalarParamCount(const mxArray *theMat, const size_t numVec, const char *errMsg);
+static size_t pairParamCount(const mxArray *theMat, const size_t numVec, const char *errMsg);
+static void copyParam(std::vector<double> &dest, const mxArray *theMat, const size_t count, const size_t offset, const size_t stride);
+
+void getEOPEpochsMexCPP(EarthOrientationEpochsCPP &epochs, const size_t numVec, const mxArray *TT1Mat, const mxArray *TT2Mat, const mxArray *deltaTTUT1Mat, const mxArray *xpypMat, const mxArray *dXdYMat, const mxArray *LODMat, const int neededParams) {
+    const size_t TT1Count=scalarParamCount(TT1Mat,numVec,"Jul1 must be a scalar or have one element per vector.");
+    const size_t TT2Count=scalarParamCount(TT2Mat,numVec,"Jul2 must be a scalar or have one element per vector.");
+    const size_t deltaTCount=scalarParamCount(deltaTTUT1Mat,numVec,"deltaTTUT1 must be a scalar or have one element per vector.");
+    const size_t xpypCount=pairParamCount(xpypMat,numVec,"The polar motion coordinates must be a 2X1 vector or a 2XN matrix with one column per vector.");
+    const size_t dXdYCount=pairParamCount(dXdYMat,numVec,"The celestial pole offsets must be a 2X1 vector or a 2XN matrix with one column per vector.");
+    const size_t LODCount=scalarParamCount(LODMat,numVec,"LOD must be a scalar or have one element per vector.");
+    const bool lookupDeltaT=(neededParams&EOP_EPOCHS_DELTATTUT1)&&deltaTCount==0;
+    const bool lookupXpyp=(neededParams&EOP_EPOCHS_XPYP)&&xpypCount==0;
+    const bool lookupDXdY=(neededParams&EOP_EPOCHS_DXDY)&&dXdYCount==0;
+    const bool lookupLOD=(neededParams&EOP_EPOCHS_LOD)&&LODCount==0;
+    size_t numEpochs;
+
+    if(TT1Count==0||TT2Count==0) {
+        mexErrMsgTxt("The dates cannot be empty.");
+    }
+
+    if(TT1Count>1||TT2Count>1||deltaTCount>1||xpypCount>1||dXdYCount>1||LODCount>1) {
+        numEpochs=numVec;
+    } else {
+        numEpochs=1;
+    }
+    epochs.resize(numEpochs);
+
+    copyParam(epochs.TT1,TT1Mat,TT1Count,0,1);
+    copyParam(epochs.TT2,TT2Mat,TT2Count,0,1);
+    copyParam(epochs.deltaTTUT1,deltaTTUT1Mat,deltaTCount,0,1);
+    copyParam(epochs.xp,xpypMat,xpypCount,0,2);
+    copyParam(epochs.yp,xpypMat,xpypCount,1,2);
+    copyParam(epochs.dX,dXdYMat,dXdYCount,0,2);
+    copyParam(epochs.dY,dXdYMat,dXdYCount,1,2);
+    copyParam(epochs.LOD,LODMat,LODCount,0,1);
+
+    if(lookupDeltaT||lookupXpyp||lookupDXdY||lookupLOD) {
+        //If the dates are the same for all of the epochs, the parameters
+        //only have to be looked up once.
+        const size_t numDates=(TT1Count>1||TT2Count>1)?numEpochs:1;
+        bool warned=false;
+        size_t curEpoch;
+
+        for(curEpoch=0;curEpoch<numDates;curEpoch++) {
+            double xpyp[2], dXdY[2], deltaT, LOD;
+            double JulUTC[2];
+            int retVal;
+
+            //Get the time in UTC to look up the parameters by going to
+            //TAI and then UTC.
+            retVal=iauTttai(epochs.TT1[curEpoch],epochs.TT2[curEpoch],&JulUTC[0],&JulUTC[1]);
+            if(retVal!=0) {
+                mexErrMsgTxt("An error occurred computing TAI.");
+            }
+            retVal=iauTaiutc(JulUTC[0],JulUTC[1],&JulUTC[0],&JulUTC[1]);
+            switch(retVal){
+                case 1:
+                    //Only warn once for a whole vector of dates.
+                    if(!warned) {
+                        mexWarnMsgTxt("Dubious Date entered.");
+                        warned=true;
+                    }
+                    break;
+                case -1:
+                    mexErrMsgTxt("Unacceptable date entered");
+                    break;
+                default:
+                    break;
+            }
+
+            getEOPMexC(JulUTC[0],JulUTC[1],xpyp,dXdY,NULL,&deltaT,&LOD);
+
+            if(lookupDeltaT) {
+                epochs.deltaTTUT1[curEpoch]=deltaT;
+            }
+            if(lookupXpyp) {
+                epochs.xp[curEpoch]=xpyp[0];
+                epochs.yp[curEpoch]=xpyp[1];
+            }
+            if(lookupDXdY) {
+                epochs.dX[curEpoch]=dXdY[0];
+                epochs.dY[curEpoch]=dXdY[1];
+            }
+            if(lookupLOD) {
+                epochs.LOD[curEpoch]=LOD;
+            }
+        }
+
+        //Repeat the looked-up values if the dates are the same.
+        for(curEpoch=numDates;curEpoch<numEpochs;curEpoch++) {
+            if(lookupDeltaT) {
+                epochs.deltaTTUT1[curEpoch]=epochs.deltaTTUT1[0];
+            }
+            if(lookupXpyp) {
+                epochs.xp[curEpoch]=epochs.xp[0];
+                epochs.yp[curEpoch]=epochs.yp[0];
+            }
+            if(lookupDXdY) {
+                epochs.dX[curEpoch]=epochs.dX[0];
+                epochs.dY[curEpoch]=epochs.dY[0];
+            }
+            if(lookupLOD) {
+                epochs.LOD[curEpoch]=epochs.LOD[0];
+            }
+        }
+    }
+}
+
+const XYsChebCacheCPP *getXYsCacheMexCPP(const EarthOrientationEpochsCPP &epochs, const size_t numThreads) {
+    const size_t numEpochs=epochs.numEpochs;
+    double JDRef, tMin, tMax;
+    size_t curEpoch;
+    bool allCovered=true;
+
+    if(numEpochs==0) {
+        return NULL;
+    }
+
+    //The dates relative to an integer plus one half.
+    JDRef=floor(epochs.TT1[0]+epochs.TT2[0])+0.5;
+    tMin=(epochs.TT1[0]-JDRef)+epochs.TT2[0];
+    tMax=tMin;
+    for(curEpoch=0;curEpoch<numEpochs;curEpoch++) {
+        const double t=(epochs.TT1[curEpoch]-JDRef)+epochs.TT2[curEpoch];
+
+        if(t<tMin) {
+            tMin=t;
+        }
+        if(t>tMax) {
+            tMax=t;
+        }
+        if(allCovered&&!XYsCacheMex.covers(epochs.TT1[curEpoch],epochs.TT2[curEpoch])) {
+            allCovered=false;
+        }
+    }
+
+    if(allCovered) {
+        return &XYsCacheMex;
+    }
+
+    //Round the span out to whole days, so that later calls with epochs
+    //in the same days can reuse the cache.
+    tMin=floor(tMin);
+    tMax=ceil(tMax);
+    if(tMax==tMin) {
+        tMax+=1.0;
+    }
+
+    if(ChebTimeCacheCPP::numFitEvals(JDRef,tMin,JDRef,tMax,XYS_CACHE_DEFAULT_DEGREE,XYS_CACHE_DEFAULT_SEG_LENGTH)>=numEpochs) {
+        return NULL;
+    }
+
+    if(!XYsCacheMex.fit(JDRef,tMin,JDRef,tMax,XYS_CACHE_DEFAULT_TOL,XYS_CACHE_DEFAULT_DEGREE,XYS_CACHE_DEFAULT_SEG_LENGTH,numThreads)) {
+        return NULL;
+    }
+    return &XYsCacheMex;
+}
+
+static size_t scalarParamCount(const mxArray *theMat, const size_t numVec, const char *errMsg) {
+    size_t numEl;
+
+    if(theMat==NULL) {
+        return 0;
+    }
+
+    numEl=mxGetNumberOfElements(theMat);
+    if(numEl>1) {
+        if(numEl!=numVec) {
+            mexErrMsgTxt(errMsg);
+        }
+        if(!mxIsDouble(theMat)||mxIsComplex(theMat)) {
+            mexErrMsgTxt("Vectors of epochs and Earth orientation parameters must be real doubles.");
+        }
+    }
+    return numEl;
+}
+
+static size_t pairParamCount(const mxArray *theMat, const size_t numVec, const char *errMsg) {
+    size_t numRow, numCol;
+
+    if(theMat==NULL||mxIsEmpty(theMat)) {
+        return 0;
+    }
+
+    if(!mxIsDouble(theMat)||mxIsComplex(theMat)) {
+        mexErrMsgTxt("Vectors of epochs and Earth orientation parameters must be real doubles.");
+    }
+
+    numRow=mxGetM(theMat);
+    numCol=mxGetN(theMat);
+    if((numRow==2&&numCol==1)||(numRow==1&&numCol==2)) {
+        return 1;
+    } else if(numRow==2&&numCol==numVec) {
+        return numCol;
+    }
+
+    mexErrMsgTxt(errMsg);
+    return 0;
+}
+
+static void copyParam(std::vector<double> &dest, const mxArray *theMat, const size_t count, const size_t offset, const size_t stride) {
+    //Copy element offset+stride*i of the matrix to epoch i, repeating the
+    //value if there is only one. If count=0, the parameter is zero.
+    const size_t numEpochs=dest.size();
+    size_t i;
+
+    if(count==0) {
+        for(i=0;i<numEpochs;i++) {
+            dest[i]=0;
+        }
+    } else if(count==1) {
+        double val;
+
+        if(stride==1) {
+            //Scalars can be of any numeric type, as with
+            //getDoubleFromMatlab.
+            val=mxGetScalar(theMat);
+        } else {
+            val=((const double*)mxGetData(theMat))[offset];
+        }
+
+        for(i=0;i<numEpochs;i++) {
+            dest[i]=val;
+        }
+    } else {
+        const double *data=(const double*)mxGetData(theMat);
+
+        for(i=0;i<numEpochs;i++) {
+            dest[i]=data[offset+stride*i];
+        }
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
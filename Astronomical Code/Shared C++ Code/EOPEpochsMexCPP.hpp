@@ -0,0 +1,69 @@
+/**EOPEPOCHSMEXCPP A header file for functions that are only for use in
+ *                mex files. They read the epochs and Earth orientation
+ *                parameters (EOP) passed to the celestial/terrestrial
+ *                coordinate conversion mex files into an
+ *                EarthOrientationEpochsCPP class for
+ *                celestialRotationsCPP and manage the cache of the
+ *                precession-nutation quantities of each mex file.
+ *                Parameters that are not given are interpolated from the
+ *                native EOP table using getEOPMexC.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef EOPEPOCHSMEXCPP
+#define EOPEPOCHSMEXCPP
+
+#include "mex.h"
+#include "celestialRotationsCPP.hpp"
+
+void getEOPEpochsMexCPP(EarthOrientationEpochsCPP &epochs, const size_t numVec, const mxArray *TT1Mat, const mxArray *TT2Mat, const mxArray *deltaTTUT1Mat, const mxArray *xpypMat, const mxArray *dXdYMat, const mxArray *LODMat, const int neededParams);
+/*Fill epochs for the conversion of numVec vectors. TT1Mat and TT2Mat are
+ *the two parts of the Julian dates in TT. Each can be a scalar or have
+ *numVec elements. deltaTTUT1Mat and LODMat can be scalars or have numVec
+ *elements and xpypMat and dXdYMat can have two elements or be 2XnumVec
+ *matrices. If any input has numVec elements (or columns), then
+ *epochs.numEpochs=numVec and the other inputs are repeated; otherwise,
+ *epochs.numEpochs=1. The EOP are looked up using getEOPMexC if the
+ *mxArray pointer is NULL or the matrix is empty, but only if the
+ *parameter is flagged in neededParams, which is a bitwise or of the
+ *EOP_EPOCHS_ values below. Parameters that are not needed are set to zero.
+ *Errors are raised in Matlab if the inputs are invalid.*/
+
+const XYsChebCacheCPP *getXYsCacheMexCPP(const EarthOrientationEpochsCPP &epochs, const size_t numThreads);
+/*Get the cache of the X, Y and s precession-nutation quantities to use for
+ *the epochs, or NULL if iauXys06a should be called directly. Each mex file
+ *keeps one cache, which stays in memory until the mex file is cleared. If
+ *the cache already covers all of the epochs, it is returned. Otherwise, a
+ *new cache is fit over the span of the epochs (rounded out to whole days)
+ *if that takes fewer evaluations of iauXys06a than the epochs themselves
+ *would, so converting a time series fits the cache on the first call and
+ *later calls within the same span just evaluate it. The fit uses the
+ *default parameters in XYsChebCacheCPP.hpp, which agree with iauXys06a to
+ *within XYS_CACHE_DEFAULT_TOL radians. numThreads is the maximum number of
+ *threads to use for the fit.*/
+
+//The flags for neededParams.
+#define EOP_EPOCHS_DELTATTUT1 1
+#define EOP_EPOCHS_XPYP 2
+#define EOP_EPOCHS_DXDY 4
+#define EOP_EPOCHS_LOD 8
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
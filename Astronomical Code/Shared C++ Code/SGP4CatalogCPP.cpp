@@ -0,0 +1,275 @@
+/**SGP4CATALOGCPP A class that holds the initialized SGP4/SDP4 ephemeris
+ *               records of a catalog of satellites. See SGP4CatalogCPP.hpp
+ *               for details.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "SGP4CatalogCPP.hpp"
+//For parallelForCPP
+#include "parallelForCPP.hpp"
+
+static const double pi=3.1415926535897932384626433832795;
+
+//The Julian date in TT at the epoch used in the orbital propagation
+//algorithm: 0:00 January 1 1950
+static const double SGP4EpochDate=2433281.5;
+
+/*The SGP4InitChunk class is used with parallelForCPP to initialize
+ *contiguous chunks of the records in separate threads.*/
+class SGP4InitChunk {
+public:
+    SGP4CatalogCPP *theCat;
+    const double *SGP4Elements;
+    char opsChar;
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        size_t curSat;
+
+        (void)threadIdx;
+        for(curSat=startItem;curSat<endItem;curSat++) {
+            const double *theEls=SGP4Elements+7*curSat;
+            double elementEpochTime=0;
+
+            if(theCat->hasEpochs) {
+                const double TT1=theCat->epochTT1[curSat];
+                const double TT2=theCat->epochTT2[curSat];
+
+                if(TT1>TT2) {
+                    elementEpochTime=(TT1-SGP4EpochDate)+TT2;
+                } else {
+                    elementEpochTime=(TT2-SGP4EpochDate)+TT1;
+                }
+            }
+
+            //The multiplication by 60 changes the mean motion from radians
+            //per second to radians per minute as desired by the SGP4 code.
+            sgp4init(theCat->gravConstType,
+                     opsChar,
+                     elementEpochTime,//Epoch time of the orbital elements.
+                     theEls[6],//BSTAR drag term.
+                     theEls[0],//Eccentricity
+                     theEls[2],//Argument of perigee
+                     theEls[1],//Inclination
+                     theEls[4],//Mean anomaly
+                     theEls[5]*60.0,//Mean motion
+                     theEls[3],//Right ascension of the ascending node.
+                     theCat->satRecs[curSat]);
+
+            theCat->initErrors[curSat]=theCat->satRecs[curSat].error;
+        }
+    }
+};
+
+/*The SGP4PropChunk class is used with parallelForCPP to propagate
+ *contiguous chunks of the satellites in separate threads. The items are
+ *the groups of near Earth satellites followed by the deep space
+ *satellites. If TT1 is not NULL, the times are Julian dates in TT;
+ *otherwise, they are offsets in seconds from the epochs of the satellites,
+ *which differ per satellite if timeStride is not zero.*/
+class SGP4PropChunk {
+public:
+    const SGP4CatalogCPP *theCat;
+    double *xState;
+    double *errorState;
+    const double *deltaT;
+    size_t timeStride;
+    const double *TT1;
+    const double *TT2;
+    size_t numTimes;
+
+    //The time since the epoch of a satellite in minutes, as the SGP4 code
+    //wants the times in minutes.
+    double tSince(const size_t curSat, const size_t curTime) const {
+        if(TT1!=NULL) {
+            return ((TT1[curTime]-theCat->epochTT1[curSat])+(TT2[curTime]-theCat->epochTT2[curSat]))*1440.0;
+        } else {
+            return deltaT[timeStride*curSat+curTime]/60.0;
+        }
+    }
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        const size_t numGroups=theCat->nearEarthLanes.numGroups;
+        size_t curItem;
+
+        (void)threadIdx;
+        for(curItem=startItem;curItem<endItem;curItem++) {
+            if(curItem<numGroups) {
+                propagateGroup(curItem);
+            } else {
+                propagateSat(theCat->deepSpaceSats[curItem-numGroups]);
+            }
+        }
+    }
+
+    void propagateGroup(const size_t curGroup) {
+        const size_t *laneSats=theCat->nearEarthLanes.laneSats.data()+curGroup*SGP4_NUM_LANES;
+        double t[SGP4_NUM_LANES], r[3*SGP4_NUM_LANES], v[3*SGP4_NUM_LANES];
+        int errors[SGP4_NUM_LANES];
+        size_t curTime, lane;
+
+        for(curTime=0;curTime<numTimes;curTime++) {
+            for(lane=0;lane<SGP4_NUM_LANES;lane++) {
+                //Unused lanes repeat the first satellite of the group.
+                const size_t curSat=(laneSats[lane]<theCat->numSats)?laneSats[lane]:laneSats[0];
+
+                t[lane]=tSince(curSat,curTime);
+            }
+
+            theCat->nearEarthLanes.propagateGroup(curGroup,t,r,v,errors);
+
+            for(lane=0;lane<SGP4_NUM_LANES;lane++) {
+                const size_t curSat=laneSats[lane];
+                double *curState;
+                int j;
+
+                if(curSat>=theCat->numSats) {
+                    continue;
+                }
+
+                //Convert the units from kilometers and kilometers per
+                //second to meters and meters per second. As with sgp4,
+                //the state is not set for some errors.
+                curState=xState+6*(numTimes*curSat+curTime);
+                if(errors[lane]==0||errors[lane]==6) {
+                    for(j=0;j<3;j++) {
+                        curState[j]=1000*r[j*SGP4_NUM_LANES+lane];
+                        curState[3+j]=1000*v[j*SGP4_NUM_LANES+lane];
+                    }
+                }
+
+                errorState[numTimes*curSat+curTime]=static_cast<double>(errors[lane]);
+            }
+        }
+    }
+
+    void propagateSat(const size_t curSat) {
+        //sgp4 changes the record, so a copy is used to leave the
+        //catalog unchanged and the results repeatable.
+        elsetrec satRec=theCat->satRecs[curSat];
+        double *curState=xState+6*numTimes*curSat;
+        double *curError=errorState+numTimes*curSat;
+        size_t curTime;
+
+        for(curTime=0;curTime<numTimes;curTime++) {
+            double *r=curState+6*curTime;
+            double *v=r+3;
+            int j;
+
+            sgp4(theCat->gravConstType,satRec,tSince(curSat,curTime),r,v);
+
+            //Convert the units from kilometers and kilometers per second
+            //to meters and meters per second.
+            for(j=0;j<3;j++) {
+                r[j]=1000*r[j];
+                v[j]=1000*v[j];
+            }
+
+            curError[curTime]=static_cast<double>(satRec.error);
+        }
+    }
+};
+
+SGP4CatalogCPP::SGP4CatalogCPP() {
+    numSats=0;
+    gravConstType=wgs72;
+    hasEpochs=false;
+}
+
+void SGP4CatalogCPP::init(const double *SGP4Elements, const size_t numSatsIn, const double *TTEpoch1, const double *TTEpoch2, const bool opsMode, const bool gravityModel, const size_t numThreads) {
+    SGP4InitChunk initializer;
+    size_t curSat;
+
+    numSats=numSatsIn;
+    if(gravityModel==0) {
+        gravConstType=wgs72;
+    } else {
+        gravConstType=wgs84;
+    }
+
+    satRecs.resize(numSats);
+    initErrors.resize(numSats);
+    epochTT1.assign(numSats,0.0);
+    epochTT2.assign(numSats,0.0);
+    hasEpochs=(TTEpoch1!=NULL&&TTEpoch2!=NULL);
+    if(hasEpochs) {
+        for(curSat=0;curSat<numSats;curSat++) {
+            epochTT1[curSat]=TTEpoch1[curSat];
+            epochTT2[curSat]=TTEpoch2[curSat];
+        }
+    }
+
+    initializer.theCat=this;
+    initializer.SGP4Elements=SGP4Elements;
+    if(opsMode==0) {
+        initializer.opsChar='a';
+    } else {
+        initializer.opsChar='i';
+    }
+
+    parallelForCPP(numSats,numThreads2UseCPP(numThreads,numSats),initializer);
+
+    nearEarthLanes.init(satRecs.data(),numSats,gravConstType,deepSpaceSats);
+}
+
+bool SGP4CatalogCPP::needsEpochs(const double *SGP4Elements, const size_t numSatsIn) const {
+    size_t curSat;
+
+    for(curSat=0;curSat<numSatsIn;curSat++) {
+        //The mean motion is in radians per second; the deep space
+        //propagator is used for periods of 225 minutes or more.
+        if(2*pi/(SGP4Elements[7*curSat+5]*60.0)>=225) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SGP4CatalogCPP::propagate(double *xState, double *errorState, const double *deltaT, const size_t numTimes, const bool timesPerSat, const size_t numThreads) const {
+    const size_t numItems=nearEarthLanes.numGroups+deepSpaceSats.size();
+    SGP4PropChunk propagator;
+
+    propagator.theCat=this;
+    propagator.xState=xState;
+    propagator.errorState=errorState;
+    propagator.deltaT=deltaT;
+    propagator.timeStride=timesPerSat?numTimes:0;
+    propagator.TT1=NULL;
+    propagator.TT2=NULL;
+    propagator.numTimes=numTimes;
+
+    parallelForCPP(numItems,numThreads2UseCPP(numThreads,numItems),propagator);
+}
+
+void SGP4CatalogCPP::propagateTT(double *xState, double *errorState, const double *TT1, const double *TT2, const size_t numTimes, const size_t numThreads) const {
+    const size_t numItems=nearEarthLanes.numGroups+deepSpaceSats.size();
+    SGP4PropChunk propagator;
+
+    propagator.theCat=this;
+    propagator.xState=xState;
+    propagator.errorState=errorState;
+    propagator.deltaT=NULL;
+    propagator.timeStride=0;
+    propagator.TT1=TT1;
+    propagator.TT2=TT2;
+    propagator.numTimes=numTimes;
+
+    parallelForCPP(numItems,numThreads2UseCPP(numThreads,numItems),propagator);
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
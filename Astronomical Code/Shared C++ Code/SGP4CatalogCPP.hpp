@@ -0,0 +1,100 @@
+/**SGP4CATALOGCPP A header file for a class that holds the initialized
+ *               SGP4/SDP4 ephemeris records of a catalog of satellites so
+ *               that the whole catalog can be propagated in one call. The
+ *               records are initialized once with sgp4init from Vallado's
+ *               SGP4 library when the catalog is made and the propagation
+ *               is split over the satellites in multiple threads. The
+ *               satellites that use the near Earth model are propagated
+ *               in groups using SGP4NearEarthLanesCPP. Each
+ *               satellite gets its own error codes, so a single decayed
+ *               or invalid element set does not stop the propagation of
+ *               the rest of the catalog.
+ *
+ *The elements, units and error codes are the same as in the
+ *propagateOrbitSGP4 function. The positions and velocities are in the TEME
+ *coordinate system in meters and meters per second.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef SGP4CATALOGCPP
+#define SGP4CATALOGCPP
+
+#include <stddef.h>
+#include <vector>
+/*This header is for the core SGP4 propagation routine.*/
+#include "sgp4unit.h"
+//For propagating the near Earth satellites in groups.
+#include "SGP4LanesCPP.hpp"
+
+class SGP4CatalogCPP {
+public:
+    size_t numSats;
+    gravconsttype gravConstType;
+    /*The initialized records, one per satellite. These are not changed by
+     *the propagation, which works on copies of them.*/
+    std::vector<elsetrec> satRecs;
+    /*The two-part epochs of the satellites in TT. These are zero if no
+     *epochs were given.*/
+    std::vector<double> epochTT1;
+    std::vector<double> epochTT2;
+    bool hasEpochs;
+    //The error code of sgp4init for each satellite.
+    std::vector<int> initErrors;
+    /*The satellites that use the near Earth model are propagated in
+     *groups using nearEarthLanes. The ones that use the deep space model,
+     *whose indices are in deepSpaceSats, are propagated one at a time
+     *with sgp4.*/
+    SGP4NearEarthLanesCPP nearEarthLanes;
+    std::vector<size_t> deepSpaceSats;
+
+    SGP4CatalogCPP();
+
+    void init(const double *SGP4Elements, const size_t numSatsIn, const double *TTEpoch1, const double *TTEpoch2, const bool opsMode, const bool gravityModel, const size_t numThreads);
+    /*Initialize the records of numSatsIn satellites. SGP4Elements is a
+     *7XnumSatsIn matrix stored by column with the elements of each
+     *satellite in the order and units of propagateOrbitSGP4 (the mean
+     *motion is in radians per second). TTEpoch1 and TTEpoch2 hold the
+     *numSatsIn two-part epochs in TT or are both NULL, in which case the
+     *deep space propagator cannot be used and propagateTT cannot be used.
+     *opsMode and gravityModel are as in propagateOrbitSGP4. The records
+     *are initialized in parallel using up to numThreads threads, with 0
+     *meaning the number of hardware threads.*/
+
+    bool needsEpochs(const double *SGP4Elements, const size_t numSatsIn) const;
+    /*Return true if any of the element sets would use the deep space
+     *propagator, which requires that the epochs be given.*/
+
+    void propagate(double *xState, double *errorState, const double *deltaT, const size_t numTimes, const bool timesPerSat, const size_t numThreads) const;
+    /*Propagate all of the satellites. deltaT holds the time offsets in
+     *seconds (TT) from the epoch of each satellite. If timesPerSat is
+     *false, the same numTimes offsets are used for every satellite;
+     *otherwise, deltaT is a numTimesXnumSats matrix stored by column with
+     *one column per satellite. xState is filled with the 6XnumTimesXnumSats
+     *states and errorState with the numTimesXnumSats error codes. Up to
+     *numThreads threads are used.*/
+
+    void propagateTT(double *xState, double *errorState, const double *TT1, const double *TT2, const size_t numTimes, const size_t numThreads) const;
+    /*This is the same as propagate, except the times are numTimes two-part
+     *Julian dates in TT that are shared by all of the satellites. This
+     *requires that the epochs were given to init.*/
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,383 @@
+/**SGP4CONJUNCTIONSCPP A function to screen a catalog of SGP4 satellites
+ *                    for close approaches using k-d trees. See
+ *                    SGP4ConjunctionsCPP.hpp for details.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For memcpy, which ClusterSetCPP.hpp uses.
+#include <string.h>
+#include <math.h>
+#include <limits>
+#include <algorithm>
+#include "SGP4ConjunctionsCPP.hpp"
+//For finding the candidate pairs at each time.
+#include "kdTreeCPP.hpp"
+//For parallelForCPP
+#include "parallelForCPP.hpp"
+
+//The gravitational parameter of the Earth in cubic meters per second
+//squared. This is only used to bound the accelerations.
+static const double GMEarth=3.986004418e14;
+//The tolerance in seconds on the times of closest approach.
+static const double TCATol=1e-4;
+
+static bool compareConjunctions(const SGP4ConjunctionCPP &a, const SGP4ConjunctionCPP &b);
+
+/*The SGP4PairCPP class holds copies of the records of two satellites and
+ *evaluates their relative state at times in seconds from the start of the
+ *screening.*/
+class SGP4PairCPP {
+public:
+    const SGP4CatalogCPP *theCat;
+    elsetrec rec1;
+    elsetrec rec2;
+    double baseMinutes1;
+    double baseMinutes2;
+
+    void init(const size_t sat1, const size_t sat2, const double *baseMinutes) {
+        //sgp4 changes the records, so copies are used.
+        rec1=theCat->satRecs[sat1];
+        rec2=theCat->satRecs[sat2];
+        baseMinutes1=baseMinutes[sat1];
+        baseMinutes2=baseMinutes[sat2];
+    }
+
+    bool relState(const double t, double *dr, double *dv) {
+    //Get the position and velocity of the second satellite relative to
+    //the first in meters and meters per second. The return value is false
+    //if sgp4 failed for either satellite.
+        double r1[3], v1[3], r2[3], v2[3];
+        int i;
+
+        sgp4(theCat->gravConstType,rec1,baseMinutes1+t/60.0,r1,v1);
+        sgp4(theCat->gravConstType,rec2,baseMinutes2+t/60.0,r2,v2);
+        if(rec1.error!=0||rec2.error!=0) {
+            return false;
+        }
+
+        for(i=0;i<3;i++) {
+            dr[i]=1000*(r2[i]-r1[i]);
+            dv[i]=1000*(v2[i]-v1[i]);
+        }
+        return true;
+    }
+
+    bool rangeRate(const double t, double &f) {
+    //The derivative of half of the squared distance, which is zero at a
+    //closest approach.
+        double dr[3], dv[3];
+
+        if(!relState(t,dr,dv)) {
+            return false;
+        }
+        f=dr[0]*dv[0]+dr[1]*dv[1]+dr[2]*dv[2];
+        return true;
+    }
+
+    bool findTCA(double a, double b, double fa, double fb, double &tCA) {
+    /*Find the root of rangeRate between a and b, where fa<0 and fb>=0
+     *using Brent's method, as described in Chapter 4 of
+     *R. P. Brent, Algorithms for Minimization Without Derivatives.
+     *Englewood Cliffs, NJ: Prentice-Hall, 1973.
+     *The return value is false if sgp4 failed.*/
+        const double epsVal=std::numeric_limits<double>::epsilon();
+        double c=b, fc=fb, d=b-a, e=d;
+        int curIter;
+
+        for(curIter=0;curIter<100;curIter++) {
+            double tol1, xm;
+
+            if((fb>0&&fc>0)||(fb<0&&fc<0)) {
+                c=a;
+                fc=fa;
+                d=b-a;
+                e=d;
+            }
+            //b is the best estimate so far.
+            if(fabs(fc)<fabs(fb)) {
+                a=b;
+                b=c;
+                c=a;
+                fa=fb;
+                fb=fc;
+                fc=fa;
+            }
+
+            tol1=2*epsVal*fabs(b)+0.5*TCATol;
+            xm=0.5*(c-b);
+            if(fabs(xm)<=tol1||fb==0) {
+                break;
+            }
+
+            if(fabs(e)>=tol1&&fabs(fa)>fabs(fb)) {
+                //Try inverse quadratic interpolation or the secant method.
+                const double s=fb/fa;
+                double p, q, min1, min2;
+
+                if(a==c) {
+                    p=2*xm*s;
+                    q=1-s;
+                } else {
+                    const double qa=fa/fc;
+                    const double r=fb/fc;
+
+                    p=s*(2*xm*qa*(qa-r)-(b-a)*(r-1));
+                    q=(qa-1)*(r-1)*(s-1);
+                }
+                if(p>0) {
+                    q=-q;
+                }
+                p=fabs(p);
+                min1=3*xm*q-fabs(tol1*q);
+                min2=fabs(e*q);
+                if(2*p<std::min(min1,min2)) {
+                    e=d;
+                    d=p/q;
+                } else {
+                    //Fall back to bisection.
+                    d=xm;
+                    e=d;
+                }
+            } else {
+                d=xm;
+                e=d;
+            }
+
+            a=b;
+            fa=fb;
+            if(fabs(d)>tol1) {
+                b+=d;
+            } else {
+                b+=(xm>=0)?tol1:-tol1;
+            }
+            if(!rangeRate(b,fb)) {
+                return false;
+            }
+        }
+
+        tCA=b;
+        return true;
+    }
+};
+
+/*The ScreenChunk class is used with parallelForCPP to screen contiguous
+ *chunks of the time steps in separate threads. The results of each thread
+ *are put in their own vector.*/
+class ScreenChunk {
+public:
+    const SGP4CatalogCPP *theCat;
+    //The time from the epoch of each satellite to the start in minutes.
+    const double *baseMinutes;
+    double deltaT;
+    size_t numSteps;
+    double threshold;
+    std::vector<std::vector<SGP4ConjunctionCPP> > threadResults;
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        const size_t numSats=theCat->numSats;
+        const double tEnd=deltaT*static_cast<double>(numSteps-1);
+        std::vector<SGP4ConjunctionCPP> &results=threadResults[threadIdx];
+        std::vector<double> satDeltaT(numSats), xState(6*numSats), errorState(numSats);
+        std::vector<double> pos(3*numSats), rectMin(3*numSats), rectMax(3*numSats);
+        std::vector<size_t> validSats(numSats);
+        SGP4PairCPP thePair;
+        size_t curStep;
+
+        thePair.theCat=theCat;
+
+        for(curStep=startItem;curStep<endItem;curStep++) {
+            const double t=deltaT*static_cast<double>(curStep);
+            //The interval around this time, clipped to the span.
+            const double wa=std::max(t-deltaT/2,0.0);
+            const double wb=std::min(t+deltaT/2,tEnd);
+            double maxSpeed2=0, minRadius2=std::numeric_limits<double>::infinity();
+            double queryRadius, accelMargin;
+            size_t numValid=0, curSat, curValid, i;
+
+            for(curSat=0;curSat<numSats;curSat++) {
+                satDeltaT[curSat]=60.0*baseMinutes[curSat]+t;
+            }
+            //This is already inside of a thread, so only one is used.
+            theCat->propagate(xState.data(),errorState.data(),satDeltaT.data(),1,true,1);
+
+            for(curSat=0;curSat<numSats;curSat++) {
+                const double *r=xState.data()+6*curSat;
+                const double *v=r+3;
+
+                if(errorState[curSat]!=0) {
+                    continue;
+                }
+
+                validSats[numValid]=curSat;
+                for(i=0;i<3;i++) {
+                    pos[3*numValid+i]=r[i];
+                }
+                maxSpeed2=std::max(maxSpeed2,v[0]*v[0]+v[1]*v[1]+v[2]*v[2]);
+                minRadius2=std::min(minRadius2,r[0]*r[0]+r[1]*r[1]+r[2]*r[2]);
+                numValid++;
+            }
+
+            if(numValid<2) {
+                continue;
+            }
+
+            //The error of linear motion over deltaT/2 with a relative
+            //acceleration of up to twice the largest gravitational
+            //acceleration.
+            accelMargin=(GMEarth/minRadius2)*deltaT*deltaT/4;
+            //Within deltaT/2 of t, the distance between two satellites can
+            //change by at most twice the maximum speed times deltaT/2. The
+            //same acceleration margin as in the linear-motion test is
+            //added, so that no pair that could pass that test is missed.
+            queryRadius=threshold+accelMargin+sqrt(maxSpeed2)*deltaT;
+
+            for(curValid=0;curValid<numValid;curValid++) {
+                for(i=0;i<3;i++) {
+                    rectMin[3*curValid+i]=pos[3*curValid+i]-queryRadius;
+                    rectMax[3*curValid+i]=pos[3*curValid+i]+queryRadius;
+                }
+            }
+
+            {
+                kdTreeCPP theTree(3,numValid);
+                ClusterSetCPP<size_t> candidates;
+
+                theTree.buildTreeFromBatch(pos.data());
+                theTree.rangeQuery(candidates,rectMin.data(),rectMax.data(),numValid);
+
+                for(curValid=0;curValid<numValid;curValid++) {
+                    const size_t *curCandidates=candidates[curValid];
+                    const size_t numCandidates=candidates.clusterSizes[curValid];
+                    size_t curCand;
+
+                    for(curCand=0;curCand<numCandidates;curCand++) {
+                        const size_t otherValid=curCandidates[curCand];
+                        const size_t sat1=validSats[curValid];
+                        const size_t sat2=validSats[otherValid];
+                        const double *v1=xState.data()+6*sat1+3;
+                        const double *v2=xState.data()+6*sat2+3;
+                        double dr[3], dv[3], dist2, vv, tau, fa, fb, tCA;
+
+                        //Each pair is found twice and only used once.
+                        if(otherValid<=curValid) {
+                            continue;
+                        }
+
+                        dist2=0;
+                        for(i=0;i<3;i++) {
+                            dr[i]=pos[3*otherValid+i]-pos[3*curValid+i];
+                            dv[i]=v2[i]-v1[i];
+                            dist2+=dr[i]*dr[i];
+                        }
+                        if(dist2>queryRadius*queryRadius) {
+                            continue;
+                        }
+
+                        //The closest approach with linear motion in the
+                        //interval.
+                        vv=dv[0]*dv[0]+dv[1]*dv[1]+dv[2]*dv[2];
+                        tau=0;
+                        if(vv>0) {
+                            tau=-(dr[0]*dv[0]+dr[1]*dv[1]+dr[2]*dv[2])/vv;
+                        }
+                        tau=std::min(std::max(tau,wa-t),wb-t);
+                        dist2=0;
+                        for(i=0;i<3;i++) {
+                            const double diff=dr[i]+dv[i]*tau;
+
+                            dist2+=diff*diff;
+                        }
+                        if(sqrt(dist2)>threshold+accelMargin) {
+                            continue;
+                        }
+
+                        //A closest approach is where the range rate goes
+                        //from negative to nonnegative. Requiring fa<0
+                        //makes an approach at the boundary between two
+                        //intervals only be found in one of them.
+                        thePair.init(sat1,sat2,baseMinutes);
+                        if(!thePair.rangeRate(wa,fa)||!thePair.rangeRate(wb,fb)||!(fa<0&&fb>=0)) {
+                            continue;
+                        }
+                        if(!thePair.findTCA(wa,wb,fa,fb,tCA)||!thePair.relState(tCA,dr,dv)) {
+                            continue;
+                        }
+
+                        dist2=dr[0]*dr[0]+dr[1]*dr[1]+dr[2]*dr[2];
+                        if(dist2<=threshold*threshold) {
+                            SGP4ConjunctionCPP theConj;
+
+                            theConj.sat1=sat1;
+                            theConj.sat2=sat2;
+                            theConj.tCA=tCA;
+                            theConj.missDist=sqrt(dist2);
+                            theConj.relSpeed=sqrt(dv[0]*dv[0]+dv[1]*dv[1]+dv[2]*dv[2]);
+                            results.push_back(theConj);
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+void screenSGP4ConjunctionsCPP(std::vector<SGP4ConjunctionCPP> &conjunctions, const SGP4CatalogCPP &theCat, const double TTStart1, const double TTStart2, const double deltaT, const size_t numSteps, const double threshold, const size_t numThreads) {
+    const size_t numSats=theCat.numSats;
+    const size_t numThreadsUsed=numThreads2UseCPP(numThreads,numSteps);
+    std::vector<double> baseMinutes(numSats);
+    ScreenChunk screener;
+    size_t curSat, curThread;
+
+    conjunctions.clear();
+    if(numSteps<2||numSats<2) {
+        return;
+    }
+
+    for(curSat=0;curSat<numSats;curSat++) {
+        baseMinutes[curSat]=((TTStart1-theCat.epochTT1[curSat])+(TTStart2-theCat.epochTT2[curSat]))*1440.0;
+    }
+
+    screener.theCat=&theCat;
+    screener.baseMinutes=baseMinutes.data();
+    screener.deltaT=deltaT;
+    screener.numSteps=numSteps;
+    screener.threshold=threshold;
+    screener.threadResults.resize(numThreadsUsed);
+
+    parallelForCPP(numSteps,numThreadsUsed,screener);
+
+    for(curThread=0;curThread<numThreadsUsed;curThread++) {
+        const std::vector<SGP4ConjunctionCPP> &curResults=screener.threadResults[curThread];
+
+        conjunctions.insert(conjunctions.end(),curResults.begin(),curResults.end());
+    }
+    std::sort(conjunctions.begin(),conjunctions.end(),compareConjunctions);
+}
+
+static bool compareConjunctions(const SGP4ConjunctionCPP &a, const SGP4ConjunctionCPP &b) {
+    if(a.tCA!=b.tCA) {
+        return a.tCA<b.tCA;
+    }
+    if(a.sat1!=b.sat1) {
+        return a.sat1<b.sat1;
+    }
+    return a.sat2<b.sat2;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
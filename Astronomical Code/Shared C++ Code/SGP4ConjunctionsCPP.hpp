@@ -0,0 +1,82 @@
+/**SGP4CONJUNCTIONSCPP A header file for a function that screens all of the
+ *                    satellites of an SGP4CatalogCPP against each other
+ *                    for close approaches (conjunctions) over a span of
+ *                    time. Comparing all pairs of satellites is O(N^2) per
+ *                    time, which is too slow for a full catalog. Here, the
+ *                    catalog is propagated onto a grid of times with a
+ *                    spacing of deltaT and at each time, a k-d tree
+ *                    (kdTreeCPP) of the positions is built and a range
+ *                    query around each satellite finds the pairs that are
+ *                    close enough that they could come within the
+ *                    threshold during the interval of deltaT around the
+ *                    time. Candidates that pass a test using linear motion
+ *                    are refined by finding the time of closest approach
+ *                    (TCA) as the root of the derivative of the squared
+ *                    distance between the satellites using Brent's method.
+ *                    The time steps are split over multiple threads.
+ *
+ *The query radius at a time is the threshold plus the maximum speed of the
+ *catalog at that time times deltaT, which bounds how much the distance
+ *between two satellites can change within deltaT/2 of the time. The
+ *linear-motion test allows for relative accelerations up to twice the
+ *largest gravitational acceleration of the catalog at that time and the
+ *same margin is added to the query radius. The interval around each time
+ *contains at most one closest approach for a pair if deltaT is small
+ *compared to the orbital periods, so deltaT should be no more than a few
+ *minutes. Smaller values of deltaT reduce the number of candidates, but
+ *require more time steps.
+ *
+ *Closest approaches are only found inside the span of the grid, so a
+ *minimum of the distance at the start or end of the span is not reported.
+ *Satellites with a nonzero SGP4 error code at a time are left out at that
+ *time. The refinement uses Vallado's sgp4 function for all satellites.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef SGP4CONJUNCTIONSCPP
+#define SGP4CONJUNCTIONSCPP
+
+#include <stddef.h>
+#include <vector>
+#include "SGP4CatalogCPP.hpp"
+
+typedef struct {
+    //The indices of the satellites in the catalog, with sat1<sat2.
+    size_t sat1;
+    size_t sat2;
+    //The time of closest approach in seconds (TT) from the start time.
+    double tCA;
+    //The distance in meters between the satellites at tCA.
+    double missDist;
+    //The relative speed in meters per second at tCA.
+    double relSpeed;
+} SGP4ConjunctionCPP;
+
+void screenSGP4ConjunctionsCPP(std::vector<SGP4ConjunctionCPP> &conjunctions, const SGP4CatalogCPP &theCat, const double TTStart1, const double TTStart2, const double deltaT, const size_t numSteps, const double threshold, const size_t numThreads);
+/*Find all of the close approaches between satellites of theCat with a
+ *miss distance of at most threshold meters in the span of numSteps times
+ *deltaT seconds apart (TT), starting at the two-part Julian date TTStart1,
+ *TTStart2 in TT. The catalog must have been given epochs. The results are
+ *put in conjunctions, sorted by the time of closest approach. Up to
+ *numThreads threads are used, with 0 meaning the number of hardware
+ *threads.*/
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
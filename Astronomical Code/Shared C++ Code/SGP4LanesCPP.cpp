@@ -0,0 +1,580 @@
+/**SGP4LANESCPP A class that propagates groups of satellites that use the
+ *             near Earth SGP4 model using a structure of arrays. See
+ *             SGP4LanesCPP.hpp for details.
+ *
+ *The steps of propagateLanesBody follow the near Earth path of sgp4 in
+ *sgp4unit.cpp, so that the two can be compared. The differences are that
+ *pow(xke/no,2/3), which only depends on the satellite, is precomputed,
+ *pow(am,1.5) is computed as am*sqrt(am) and the sines, cosines, inverse
+ *tangents and remainders are computed using the functions of the
+ *SGP4LaneMath classes.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <math.h>
+#include "SGP4LanesCPP.hpp"
+
+#if (defined(__GNUC__)||defined(__clang__))&&(defined(__x86_64__)||defined(__i386__))
+#define SGP4_LANES_X86_SIMD
+#include <immintrin.h>
+#endif
+
+//This is the value of pi used in sgp4unit.cpp.
+static const double pi=3.14159265358979323846;
+
+/*The constants for the sines and cosines. pi/2 is split into three parts
+ *for the reduction of the argument and the coefficients are those of the
+ *polynomials of the fdlibm library on [-pi/4,pi/4].*/
+static const double twoOverPi=6.36619772367581382433e-01;
+static const double pio2_1=1.57079632673412561417e+00;
+static const double pio2_2=6.07710050630396597660e-11;
+static const double pio2_3=2.02226624871116645580e-21;
+static const double S1=-1.66666666666666324348e-01;
+static const double S2=8.33333333332248946124e-03;
+static const double S3=-1.98412698298579493134e-04;
+static const double S4=2.75573137070700676789e-06;
+static const double S5=-2.50507602534068634195e-08;
+static const double S6=1.58969099521155010221e-10;
+static const double C1=4.16666666666666019037e-02;
+static const double C2=-1.38888888888741095749e-03;
+static const double C3=2.48015872894767294178e-05;
+static const double C4=-2.75573143513906633035e-07;
+static const double C5=2.08757232129817482790e-09;
+static const double C6=-1.13596475577881948265e-11;
+
+/*The constants for the inverse tangent. The coefficients are those of the
+ *polynomial of the fdlibm library, which is used on
+ *[-tan(pi/8),tan(pi/8)]. The multiples of pi are split into two parts.*/
+static const double tanPi8=0.41421356237309504880;
+static const double pio4Hi=7.85398163397448278999e-01;
+static const double pio4Lo=3.06161699786838301793e-17;
+static const double pio2Hi=1.57079632679489655800e+00;
+static const double pio2Lo=6.12323399573676603587e-17;
+static const double piHi=3.14159265358979311600e+00;
+static const double piLo=1.22464679914735317720e-16;
+static const double aT0=3.33333333333329318027e-01;
+static const double aT1=-1.99999999998764832476e-01;
+static const double aT2=1.42857142725034663711e-01;
+static const double aT3=-1.11111104054623557880e-01;
+static const double aT4=9.09088713343650656196e-02;
+static const double aT5=-7.69187620504482999495e-02;
+static const double aT6=6.66107313738753120669e-02;
+static const double aT7=-5.83357013379057348645e-02;
+static const double aT8=4.97687799461593236017e-02;
+static const double aT9=-3.65315727442169155270e-02;
+static const double aT10=1.62858201153657823623e-02;
+
+//The value of 2*pi used in sgp4unit.cpp, rounded to 24 bits after the
+//binary point, and the rest.
+static const double twopi=2.0*pi;
+static const double twopiHi=6.283185303211212;
+static const double twopiLo=3.968374073792802e-09;
+
+typedef void (*SGP4LanesFunc)(const double *p, const double xke, const double j2, const double radiusEarthKm, const double vKmPerSec, const double *tSince, double *r, double *v, int *errors);
+
+static SGP4LanesFunc getSGP4LanesFunc();
+static void propagateLanesDefault(const double *p, const double xke, const double j2, const double radiusEarthKm, const double vKmPerSec, const double *tSince, double *r, double *v, int *errors);
+#ifdef SGP4_LANES_X86_SIMD
+static void propagateLanesAVX2(const double *p, const double xke, const double j2, const double radiusEarthKm, const double vKmPerSec, const double *tSince, double *r, double *v, int *errors);
+#endif
+
+SGP4NearEarthLanesCPP::SGP4NearEarthLanesCPP() {
+    numGroups=0;
+    numSats=0;
+    xke=0;
+    j2=0;
+    radiusEarthKm=0;
+    vKmPerSec=0;
+}
+
+void SGP4NearEarthLanesCPP::init(const elsetrec *satRecs, const size_t numSatsIn, const gravconsttype gravConstType, std::vector<size_t> &deepSpaceSats) {
+    std::vector<size_t> nearSats;
+    double tumin, mu, j3, j4, j3oj2;
+    size_t curSat, curGroup, lane;
+
+    numSats=numSatsIn;
+    getgravconst(gravConstType,tumin,mu,radiusEarthKm,xke,j2,j3,j4,j3oj2);
+    vKmPerSec=radiusEarthKm*xke/60.0;
+
+    deepSpaceSats.clear();
+    for(curSat=0;curSat<numSats;curSat++) {
+        if(satRecs[curSat].method=='d') {
+            deepSpaceSats.push_back(curSat);
+        } else {
+            nearSats.push_back(curSat);
+        }
+    }
+
+    numGroups=(nearSats.size()+SGP4_NUM_LANES-1)/SGP4_NUM_LANES;
+    params.resize(numGroups*SGP4_LANE_NUM_PARAMS*SGP4_NUM_LANES);
+    laneSats.resize(numGroups*SGP4_NUM_LANES);
+
+    for(curGroup=0;curGroup<numGroups;curGroup++) {
+        double *p=params.data()+curGroup*SGP4_LANE_NUM_PARAMS*SGP4_NUM_LANES;
+
+        for(lane=0;lane<SGP4_NUM_LANES;lane++) {
+            const size_t nearIdx=curGroup*SGP4_NUM_LANES+lane;
+            const elsetrec *rec;
+
+            if(nearIdx<nearSats.size()) {
+                laneSats[nearIdx]=nearSats[nearIdx];
+                rec=satRecs+nearSats[nearIdx];
+            } else {
+                //An unused lane repeats the first satellite of the group.
+                laneSats[nearIdx]=numSats;
+                rec=satRecs+nearSats[curGroup*SGP4_NUM_LANES];
+            }
+
+            p[SGP4_LANE_MO*SGP4_NUM_LANES+lane]=rec->mo;
+            p[SGP4_LANE_MDOT*SGP4_NUM_LANES+lane]=rec->mdot;
+            p[SGP4_LANE_ARGPO*SGP4_NUM_LANES+lane]=rec->argpo;
+            p[SGP4_LANE_ARGPDOT*SGP4_NUM_LANES+lane]=rec->argpdot;
+            p[SGP4_LANE_NODEO*SGP4_NUM_LANES+lane]=rec->nodeo;
+            p[SGP4_LANE_NODEDOT*SGP4_NUM_LANES+lane]=rec->nodedot;
+            p[SGP4_LANE_NODECF*SGP4_NUM_LANES+lane]=rec->nodecf;
+            p[SGP4_LANE_CC1*SGP4_NUM_LANES+lane]=rec->cc1;
+            p[SGP4_LANE_BSTAR*SGP4_NUM_LANES+lane]=rec->bstar;
+            p[SGP4_LANE_CC4*SGP4_NUM_LANES+lane]=rec->cc4;
+            p[SGP4_LANE_CC5*SGP4_NUM_LANES+lane]=rec->cc5;
+            p[SGP4_LANE_T2COF*SGP4_NUM_LANES+lane]=rec->t2cof;
+            p[SGP4_LANE_T3COF*SGP4_NUM_LANES+lane]=rec->t3cof;
+            p[SGP4_LANE_T4COF*SGP4_NUM_LANES+lane]=rec->t4cof;
+            p[SGP4_LANE_T5COF*SGP4_NUM_LANES+lane]=rec->t5cof;
+            p[SGP4_LANE_OMGCOF*SGP4_NUM_LANES+lane]=rec->omgcof;
+            p[SGP4_LANE_ETA*SGP4_NUM_LANES+lane]=rec->eta;
+            p[SGP4_LANE_XMCOF*SGP4_NUM_LANES+lane]=rec->xmcof;
+            p[SGP4_LANE_DELMO*SGP4_NUM_LANES+lane]=rec->delmo;
+            p[SGP4_LANE_D2*SGP4_NUM_LANES+lane]=rec->d2;
+            p[SGP4_LANE_D3*SGP4_NUM_LANES+lane]=rec->d3;
+            p[SGP4_LANE_D4*SGP4_NUM_LANES+lane]=rec->d4;
+            p[SGP4_LANE_SINMAO*SGP4_NUM_LANES+lane]=rec->sinmao;
+            p[SGP4_LANE_NO*SGP4_NUM_LANES+lane]=rec->no;
+            //The mean motion does not change, so the power of it that
+            //sgp4 computes for every time is only computed once.
+            p[SGP4_LANE_AXNPOW*SGP4_NUM_LANES+lane]=pow(xke/rec->no,2.0/3.0);
+            p[SGP4_LANE_ECCO*SGP4_NUM_LANES+lane]=rec->ecco;
+            p[SGP4_LANE_INCLO*SGP4_NUM_LANES+lane]=rec->inclo;
+            //The inclination does not change in the near Earth model, so
+            //its sine and cosine are only computed once.
+            p[SGP4_LANE_SINIO*SGP4_NUM_LANES+lane]=sin(rec->inclo);
+            p[SGP4_LANE_COSIO*SGP4_NUM_LANES+lane]=cos(rec->inclo);
+            p[SGP4_LANE_AYCOF*SGP4_NUM_LANES+lane]=rec->aycof;
+            p[SGP4_LANE_XLCOF*SGP4_NUM_LANES+lane]=rec->xlcof;
+            p[SGP4_LANE_CON41*SGP4_NUM_LANES+lane]=rec->con41;
+            p[SGP4_LANE_X1MTH2*SGP4_NUM_LANES+lane]=rec->x1mth2;
+            p[SGP4_LANE_X7THM1*SGP4_NUM_LANES+lane]=rec->x7thm1;
+            p[SGP4_LANE_NOTSIMP*SGP4_NUM_LANES+lane]=(rec->isimp!=1)?1.0:0.0;
+        }
+    }
+}
+
+void SGP4NearEarthLanesCPP::propagateGroup(const size_t group, const double *tSince, double *r, double *v, int *errors) const {
+    static const SGP4LanesFunc lanesFunc=getSGP4LanesFunc();
+
+    lanesFunc(params.data()+group*SGP4_LANE_NUM_PARAMS*SGP4_NUM_LANES,xke,j2,radiusEarthKm,vKmPerSec,tSince,r,v,errors);
+}
+
+static SGP4LanesFunc getSGP4LanesFunc() {
+/*GETSGP4LANESFUNC Select the implementation of the loops over the lanes
+ *                 based on the instructions that the processor supports.
+ */
+#ifdef SGP4_LANES_X86_SIMD
+    __builtin_cpu_init();
+    if(__builtin_cpu_supports("avx2")&&__builtin_cpu_supports("fma")) {
+        return propagateLanesAVX2;
+    }
+#endif
+    return propagateLanesDefault;
+}
+
+#if defined(__GNUC__)||defined(__clang__)
+#define SGP4_LANES_INLINE inline __attribute__((always_inline))
+#else
+#define SGP4_LANES_INLINE inline
+#endif
+
+/*The SGP4LaneMathDefault class holds the sines, cosines, inverse tangents
+ *and remainders of all of the lanes of a group written as plain loops.
+ *Unlike sin, cos, atan2 and fmod in the standard library, these have no
+ *branches. The sine and cosine reduce the argument to [-pi/4,pi/4] and the
+ *inverse tangent reduces the ratio of the smaller to the larger magnitude
+ *to [-tan(pi/8),tan(pi/8)]. The polynomials are accurate to about one unit
+ *in the last place. The remainders are those after division by the value
+ *of 2*pi used in sgp4, as in fmod(x,twopi), and the product of the
+ *quotient and 2*pi is computed in two parts so that the result is
+ *accurate for quotients of up to 2^26.*/
+class SGP4LaneMathDefault {
+public:
+    static SGP4_LANES_INLINE void sinCos(const double *x, double *s, double *c) {
+        size_t l;
+
+        for(l=0;l<SGP4_NUM_LANES;l++) {
+            const double n=floor(x[l]*twoOverPi+0.5);
+            const double r=((x[l]-n*pio2_1)-n*pio2_2)-n*pio2_3;
+            const double z=r*r;
+            const double sr=r+r*z*(S1+z*(S2+z*(S3+z*(S4+z*(S5+z*S6)))));
+            const double cr=1.0-0.5*z+z*z*(C1+z*(C2+z*(C3+z*(C4+z*(C5+z*C6)))));
+            //The quadrant is n modulo 4.
+            const double q=n-4.0*floor(0.25*n);
+            const bool swapSC=(q==1.0||q==3.0);
+            const double sinVal=swapSC?cr:sr;
+            const double cosVal=swapSC?sr:cr;
+
+            s[l]=(q>=2.0)?-sinVal:sinVal;
+            c[l]=(q==1.0||q==2.0)?-cosVal:cosVal;
+        }
+    }
+
+    static SGP4_LANES_INLINE void atan2(const double *y, const double *x, double *theta) {
+        size_t l;
+
+        for(l=0;l<SGP4_NUM_LANES;l++) {
+            const double ax=fabs(x[l]);
+            const double ay=fabs(y[l]);
+            const bool swapXY=ay>ax;
+            const double num=swapXY?ax:ay;
+            const double den=swapXY?ay:ax;
+            const double t=(den>0.0)?num/den:0.0;
+            const bool shift=t>tanPi8;
+            const double tr=shift?(t-1.0)/(t+1.0):t;
+            const double z=tr*tr;
+            const double w=z*z;
+            const double s1=z*(aT0+w*(aT2+w*(aT4+w*(aT6+w*(aT8+w*aT10)))));
+            const double s2=w*(aT1+w*(aT3+w*(aT5+w*(aT7+w*aT9))));
+            double a;
+
+            a=shift?(pio4Hi-((tr*(s1+s2)-pio4Lo)-tr)):(tr-tr*(s1+s2));
+            a=swapXY?((pio2Hi-a)+pio2Lo):a;
+            a=(x[l]<0.0)?((piHi-a)+piLo):a;
+            theta[l]=(y[l]<0.0)?-a:a;
+        }
+    }
+
+    static SGP4_LANES_INLINE void fmodTwoPi(double *x) {
+        size_t l;
+
+        for(l=0;l<SGP4_NUM_LANES;l++) {
+            const double n=trunc(x[l]/twopi);
+
+            x[l]=(x[l]-n*twopiHi)-n*twopiLo;
+        }
+    }
+};
+
+#ifdef SGP4_LANES_X86_SIMD
+#if SGP4_NUM_LANES!=4
+#error "SGP4LaneMathAVX2 requires that SGP4_NUM_LANES be 4."
+#endif
+/*The SGP4LaneMathAVX2 class holds the same functions as
+ *SGP4LaneMathDefault written with AVX2 and FMA instructions, with one
+ *vector holding all four lanes. The fused multiply-adds make the results
+ *differ from those of SGP4LaneMathDefault in the last bits.*/
+class SGP4LaneMathAVX2 {
+public:
+    __attribute__((target("avx2,fma")))
+    static __m256d polyEval(const __m256d z, const double *c, const int numCoeffs) {
+        //Horner's method for c[0]+c[1]*z+...
+        __m256d sumVal=_mm256_set1_pd(c[numCoeffs-1]);
+        int i;
+
+        for(i=numCoeffs-2;i>=0;i--) {
+            sumVal=_mm256_fmadd_pd(sumVal,z,_mm256_set1_pd(c[i]));
+        }
+        return sumVal;
+    }
+
+    __attribute__((target("avx2,fma")))
+    static void sinCos(const double *x, double *s, double *c) {
+        const double SCoeffs[6]={S1,S2,S3,S4,S5,S6};
+        const double CCoeffs[6]={C1,C2,C3,C4,C5,C6};
+        const __m256d signBit=_mm256_set1_pd(-0.0);
+        const __m256d xVec=_mm256_loadu_pd(x);
+        const __m256d n=_mm256_floor_pd(_mm256_fmadd_pd(xVec,_mm256_set1_pd(twoOverPi),_mm256_set1_pd(0.5)));
+        __m256d r=_mm256_fnmadd_pd(n,_mm256_set1_pd(pio2_1),xVec);
+        r=_mm256_fnmadd_pd(n,_mm256_set1_pd(pio2_2),r);
+        r=_mm256_fnmadd_pd(n,_mm256_set1_pd(pio2_3),r);
+        const __m256d z=_mm256_mul_pd(r,r);
+        const __m256d sr=_mm256_fmadd_pd(_mm256_mul_pd(r,z),polyEval(z,SCoeffs,6),r);
+        const __m256d cr=_mm256_fmadd_pd(_mm256_mul_pd(z,z),polyEval(z,CCoeffs,6),_mm256_fnmadd_pd(_mm256_set1_pd(0.5),z,_mm256_set1_pd(1.0)));
+        //The quadrant is n modulo 4.
+        const __m256d q=_mm256_fnmadd_pd(_mm256_set1_pd(4.0),_mm256_floor_pd(_mm256_mul_pd(n,_mm256_set1_pd(0.25))),n);
+        const __m256d isQ1=_mm256_cmp_pd(q,_mm256_set1_pd(1.0),_CMP_EQ_OQ);
+        const __m256d isQ2=_mm256_cmp_pd(q,_mm256_set1_pd(2.0),_CMP_EQ_OQ);
+        const __m256d isQ3=_mm256_cmp_pd(q,_mm256_set1_pd(3.0),_CMP_EQ_OQ);
+        const __m256d swapSC=_mm256_or_pd(isQ1,isQ3);
+        const __m256d sinVal=_mm256_blendv_pd(sr,cr,swapSC);
+        const __m256d cosVal=_mm256_blendv_pd(cr,sr,swapSC);
+
+        _mm256_storeu_pd(s,_mm256_xor_pd(sinVal,_mm256_and_pd(_mm256_or_pd(isQ2,isQ3),signBit)));
+        _mm256_storeu_pd(c,_mm256_xor_pd(cosVal,_mm256_and_pd(_mm256_or_pd(isQ1,isQ2),signBit)));
+    }
+
+    __attribute__((target("avx2,fma")))
+    static void atan2(const double *y, const double *x, double *theta) {
+        const double evenCoeffs[6]={aT0,aT2,aT4,aT6,aT8,aT10};
+        const double oddCoeffs[5]={aT1,aT3,aT5,aT7,aT9};
+        const __m256d signBit=_mm256_set1_pd(-0.0);
+        const __m256d zero=_mm256_setzero_pd();
+        const __m256d one=_mm256_set1_pd(1.0);
+        const __m256d xVec=_mm256_loadu_pd(x);
+        const __m256d yVec=_mm256_loadu_pd(y);
+        const __m256d ax=_mm256_andnot_pd(signBit,xVec);
+        const __m256d ay=_mm256_andnot_pd(signBit,yVec);
+        const __m256d swapXY=_mm256_cmp_pd(ay,ax,_CMP_GT_OQ);
+        const __m256d num=_mm256_blendv_pd(ay,ax,swapXY);
+        const __m256d den=_mm256_blendv_pd(ax,ay,swapXY);
+        const __m256d t=_mm256_and_pd(_mm256_div_pd(num,den),_mm256_cmp_pd(den,zero,_CMP_GT_OQ));
+        const __m256d shift=_mm256_cmp_pd(t,_mm256_set1_pd(tanPi8),_CMP_GT_OQ);
+        const __m256d tr=_mm256_blendv_pd(t,_mm256_div_pd(_mm256_sub_pd(t,one),_mm256_add_pd(t,one)),shift);
+        const __m256d z=_mm256_mul_pd(tr,tr);
+        const __m256d w=_mm256_mul_pd(z,z);
+        const __m256d s1=_mm256_mul_pd(z,polyEval(w,evenCoeffs,6));
+        const __m256d s2=_mm256_mul_pd(w,polyEval(w,oddCoeffs,5));
+        const __m256d trs=_mm256_mul_pd(tr,_mm256_add_pd(s1,s2));
+        __m256d a;
+
+        a=_mm256_blendv_pd(_mm256_sub_pd(tr,trs),_mm256_sub_pd(_mm256_set1_pd(pio4Hi),_mm256_sub_pd(_mm256_sub_pd(trs,_mm256_set1_pd(pio4Lo)),tr)),shift);
+        a=_mm256_blendv_pd(a,_mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(pio2Hi),a),_mm256_set1_pd(pio2Lo)),swapXY);
+        a=_mm256_blendv_pd(a,_mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(piHi),a),_mm256_set1_pd(piLo)),_mm256_cmp_pd(xVec,zero,_CMP_LT_OQ));
+        _mm256_storeu_pd(theta,_mm256_xor_pd(a,_mm256_and_pd(_mm256_cmp_pd(yVec,zero,_CMP_LT_OQ),signBit)));
+    }
+
+    __attribute__((target("avx2,fma")))
+    static void fmodTwoPi(double *x) {
+        const __m256d xVec=_mm256_loadu_pd(x);
+        const __m256d n=_mm256_round_pd(_mm256_div_pd(xVec,_mm256_set1_pd(twopi)),_MM_FROUND_TO_ZERO|_MM_FROUND_NO_EXC);
+        const __m256d r=_mm256_fnmadd_pd(n,_mm256_set1_pd(twopiHi),xVec);
+
+        _mm256_storeu_pd(x,_mm256_fnmadd_pd(n,_mm256_set1_pd(twopiLo),r));
+    }
+};
+#endif
+
+template<class LaneMath>
+static SGP4_LANES_INLINE void propagateLanesBody(const double *p, const double xke, const double j2, const double radiusEarthKm, const double vKmPerSec, const double *tSince, double *r, double *v, int *errors) {
+/*PROPAGATELANESBODY The near Earth path of sgp4 run on all of the lanes of
+ *                   a group. This is inlined into the functions for each
+ *                   instruction set. p points to the parameters of the
+ *                   group.
+ */
+    const size_t L=SGP4_NUM_LANES;
+    double t[L], t2[L], xmdf[L], argpdf[L], nodem[L], tempa[L], tempe[L], templ[L];
+    double mm[L], argpm[L], sinxmdf[L], cosxmdf[L], sinmm[L], cosmm[L];
+    double nm[L], em[L], am[L], xlm[L], sinargp[L], cosargp[L];
+    double axnl[L], aynl[L], u[L], eo1[L], sineo1[L], coseo1[L], sinNew[L], cosNew[L];
+    double ecose[L], esine[L], el2[L], pl[L];
+    double rl[L], rdotl[L], rvdotl[L], betal[L], sinu[L], cosu[L], su[L], sin2u[L], cos2u[L];
+    double temp1[L], temp2[L], mrt[L], xnode[L], xinc[L], mvt[L], rvdot[L];
+    double sinsu[L], cossu[L], snod[L], cnod[L], sini[L], cosi[L];
+    bool active[L];
+    size_t l, ktr;
+
+    /* ------- update for secular gravity and atmospheric drag ----- */
+    for(l=0;l<L;l++) {
+        t[l]=tSince[l];
+        errors[l]=0;
+        xmdf[l]=p[SGP4_LANE_MO*L+l]+p[SGP4_LANE_MDOT*L+l]*t[l];
+        argpdf[l]=p[SGP4_LANE_ARGPO*L+l]+p[SGP4_LANE_ARGPDOT*L+l]*t[l];
+        const double nodedf=p[SGP4_LANE_NODEO*L+l]+p[SGP4_LANE_NODEDOT*L+l]*t[l];
+        t2[l]=t[l]*t[l];
+        nodem[l]=nodedf+p[SGP4_LANE_NODECF*L+l]*t2[l];
+        tempa[l]=1.0-p[SGP4_LANE_CC1*L+l]*t[l];
+        tempe[l]=p[SGP4_LANE_BSTAR*L+l]*p[SGP4_LANE_CC4*L+l]*t[l];
+        templ[l]=p[SGP4_LANE_T2COF*L+l]*t2[l];
+    }
+
+    LaneMath::sinCos(xmdf,sinxmdf,cosxmdf);
+
+    //The terms for isimp!=1 are computed for all lanes and selected.
+    for(l=0;l<L;l++) {
+        const bool notSimp=p[SGP4_LANE_NOTSIMP*L+l]!=0;
+        const double delomg=p[SGP4_LANE_OMGCOF*L+l]*t[l];
+        const double delmtemp=1.0+p[SGP4_LANE_ETA*L+l]*cosxmdf[l];
+        const double delm=p[SGP4_LANE_XMCOF*L+l]*(delmtemp*delmtemp*delmtemp-p[SGP4_LANE_DELMO*L+l]);
+        const double temp=delomg+delm;
+        const double t3=t2[l]*t[l];
+        const double t4=t3*t[l];
+        const double tempaFull=tempa[l]-p[SGP4_LANE_D2*L+l]*t2[l]-p[SGP4_LANE_D3*L+l]*t3-p[SGP4_LANE_D4*L+l]*t4;
+        const double templFull=templ[l]+p[SGP4_LANE_T3COF*L+l]*t3+t4*(p[SGP4_LANE_T4COF*L+l]+t[l]*p[SGP4_LANE_T5COF*L+l]);
+
+        mm[l]=notSimp?(xmdf[l]+temp):xmdf[l];
+        argpm[l]=notSimp?(argpdf[l]-temp):argpdf[l];
+        tempa[l]=notSimp?tempaFull:tempa[l];
+        templ[l]=notSimp?templFull:templ[l];
+    }
+
+    LaneMath::sinCos(mm,sinmm,cosmm);
+
+    for(l=0;l<L;l++) {
+        const bool notSimp=p[SGP4_LANE_NOTSIMP*L+l]!=0;
+        const double tempeFull=tempe[l]+p[SGP4_LANE_BSTAR*L+l]*p[SGP4_LANE_CC5*L+l]*(sinmm[l]-p[SGP4_LANE_SINMAO*L+l]);
+
+        tempe[l]=notSimp?tempeFull:tempe[l];
+        nm[l]=p[SGP4_LANE_NO*L+l];
+        errors[l]=(nm[l]<=0.0)?2:0;
+
+        //The power of the mean motion is precomputed.
+        am[l]=p[SGP4_LANE_AXNPOW*L+l]*tempa[l]*tempa[l];
+        nm[l]=xke/(am[l]*sqrt(am[l]));
+        em[l]=p[SGP4_LANE_ECCO*L+l]-tempe[l];
+        if(errors[l]==0&&((em[l]>=1.0)||(em[l]<-0.001))) {
+            errors[l]=1;
+        }
+        // sgp4fix fix tolerance to avoid a divide by zero
+        em[l]=(em[l]<1.0e-6)?1.0e-6:em[l];
+        mm[l]=mm[l]+p[SGP4_LANE_NO*L+l]*templ[l];
+        xlm[l]=mm[l]+argpm[l]+nodem[l];
+    }
+
+    LaneMath::fmodTwoPi(nodem);
+    LaneMath::fmodTwoPi(argpm);
+    LaneMath::fmodTwoPi(xlm);
+    for(l=0;l<L;l++) {
+        mm[l]=xlm[l]-argpm[l]-nodem[l];
+    }
+    LaneMath::fmodTwoPi(mm);
+
+    /* -------------------- long period periodics ------------------ */
+    LaneMath::sinCos(argpm,sinargp,cosargp);
+    for(l=0;l<L;l++) {
+        const double temp=1.0/(am[l]*(1.0-em[l]*em[l]));
+
+        axnl[l]=em[l]*cosargp[l];
+        aynl[l]=em[l]*sinargp[l]+temp*p[SGP4_LANE_AYCOF*L+l];
+        u[l]=mm[l]+argpm[l]+nodem[l]+temp*p[SGP4_LANE_XLCOF*L+l]*axnl[l]-nodem[l];
+    }
+
+    /* --------------------- solve kepler's equation --------------- */
+    LaneMath::fmodTwoPi(u);
+    for(l=0;l<L;l++) {
+        eo1[l]=u[l];
+        active[l]=true;
+        sineo1[l]=0;
+        coseo1[l]=0;
+    }
+
+    //Lanes that have converged are not changed, so each lane takes the
+    //same steps as in sgp4.
+    for(ktr=1;ktr<=10;ktr++) {
+        bool anyActive=false;
+
+        LaneMath::sinCos(eo1,sinNew,cosNew);
+        for(l=0;l<L;l++) {
+            double tem5;
+
+            sineo1[l]=active[l]?sinNew[l]:sineo1[l];
+            coseo1[l]=active[l]?cosNew[l]:coseo1[l];
+            tem5=1.0-coseo1[l]*axnl[l]-sineo1[l]*aynl[l];
+            tem5=(u[l]-aynl[l]*coseo1[l]+axnl[l]*sineo1[l]-eo1[l])/tem5;
+            tem5=(tem5>=0.95)?0.95:tem5;
+            tem5=(tem5<=-0.95)?-0.95:tem5;
+            eo1[l]=active[l]?(eo1[l]+tem5):eo1[l];
+            active[l]=active[l]&&(fabs(tem5)>=1.0e-12);
+            anyActive=anyActive||active[l];
+        }
+
+        if(!anyActive) {
+            break;
+        }
+    }
+
+    /* ------------- short period preliminary quantities ----------- */
+    for(l=0;l<L;l++) {
+        ecose[l]=axnl[l]*coseo1[l]+aynl[l]*sineo1[l];
+        esine[l]=axnl[l]*sineo1[l]-aynl[l]*coseo1[l];
+        el2[l]=axnl[l]*axnl[l]+aynl[l]*aynl[l];
+        pl[l]=am[l]*(1.0-el2[l]);
+        if(errors[l]==0&&pl[l]<0.0) {
+            errors[l]=4;
+        }
+
+        rl[l]=am[l]*(1.0-ecose[l]);
+        rdotl[l]=sqrt(am[l])*esine[l]/rl[l];
+        rvdotl[l]=sqrt(pl[l])/rl[l];
+        betal[l]=sqrt(1.0-el2[l]);
+
+        const double temp=esine[l]/(1.0+betal[l]);
+        sinu[l]=am[l]/rl[l]*(sineo1[l]-aynl[l]-axnl[l]*temp);
+        cosu[l]=am[l]/rl[l]*(coseo1[l]-axnl[l]+aynl[l]*temp);
+    }
+
+    LaneMath::atan2(sinu,cosu,su);
+
+    /* -------------- update for short period periodics ------------ */
+    for(l=0;l<L;l++) {
+        const double cosip=p[SGP4_LANE_COSIO*L+l];
+        const double sinip=p[SGP4_LANE_SINIO*L+l];
+        const double con41=p[SGP4_LANE_CON41*L+l];
+        const double x1mth2=p[SGP4_LANE_X1MTH2*L+l];
+        const double x7thm1=p[SGP4_LANE_X7THM1*L+l];
+        const double temp=1.0/pl[l];
+
+        sin2u[l]=(cosu[l]+cosu[l])*sinu[l];
+        cos2u[l]=1.0-2.0*sinu[l]*sinu[l];
+        temp1[l]=0.5*j2*temp;
+        temp2[l]=temp1[l]*temp;
+
+        mrt[l]=rl[l]*(1.0-1.5*temp2[l]*betal[l]*con41)+0.5*temp1[l]*x1mth2*cos2u[l];
+        su[l]=su[l]-0.25*temp2[l]*x7thm1*sin2u[l];
+        xnode[l]=nodem[l]+1.5*temp2[l]*cosip*sin2u[l];
+        xinc[l]=p[SGP4_LANE_INCLO*L+l]+1.5*temp2[l]*cosip*sinip*cos2u[l];
+        mvt[l]=rdotl[l]-nm[l]*temp1[l]*x1mth2*sin2u[l]/xke;
+        rvdot[l]=rvdotl[l]+nm[l]*temp1[l]*(x1mth2*cos2u[l]+1.5*con41)/xke;
+    }
+
+    /* --------------------- orientation vectors ------------------- */
+    LaneMath::sinCos(su,sinsu,cossu);
+    LaneMath::sinCos(xnode,snod,cnod);
+    LaneMath::sinCos(xinc,sini,cosi);
+
+    /* --------- position and velocity (in km and km/sec) ---------- */
+    for(l=0;l<L;l++) {
+        const double xmx=-snod[l]*cosi[l];
+        const double xmy=cnod[l]*cosi[l];
+        const double ux=xmx*sinsu[l]+cnod[l]*cossu[l];
+        const double uy=xmy*sinsu[l]+snod[l]*cossu[l];
+        const double uz=sini[l]*sinsu[l];
+        const double vx=xmx*cossu[l]-cnod[l]*sinsu[l];
+        const double vy=xmy*cossu[l]-snod[l]*sinsu[l];
+        const double vz=sini[l]*cossu[l];
+
+        r[l]=(mrt[l]*ux)*radiusEarthKm;
+        r[L+l]=(mrt[l]*uy)*radiusEarthKm;
+        r[2*L+l]=(mrt[l]*uz)*radiusEarthKm;
+        v[l]=(mvt[l]*ux+rvdot[l]*vx)*vKmPerSec;
+        v[L+l]=(mvt[l]*uy+rvdot[l]*vy)*vKmPerSec;
+        v[2*L+l]=(mvt[l]*uz+rvdot[l]*vz)*vKmPerSec;
+
+        // sgp4fix for decaying satellites
+        errors[l]=(errors[l]==0&&mrt[l]<1.0)?6:errors[l];
+    }
+}
+
+static void propagateLanesDefault(const double *p, const double xke, const double j2, const double radiusEarthKm, const double vKmPerSec, const double *tSince, double *r, double *v, int *errors) {
+    propagateLanesBody<SGP4LaneMathDefault>(p,xke,j2,radiusEarthKm,vKmPerSec,tSince,r,v,errors);
+}
+
+#ifdef SGP4_LANES_X86_SIMD
+__attribute__((target("avx2,fma")))
+static void propagateLanesAVX2(const double *p, const double xke, const double j2, const double radiusEarthKm, const double vKmPerSec, const double *tSince, double *r, double *v, int *errors) {
+    propagateLanesBody<SGP4LaneMathAVX2>(p,xke,j2,radiusEarthKm,vKmPerSec,tSince,r,v,errors);
+}
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
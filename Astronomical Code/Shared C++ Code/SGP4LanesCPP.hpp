@@ -0,0 +1,114 @@
+/**SGP4LANESCPP A header file for a class that propagates the satellites of
+ *             a catalog that use the near Earth SGP4 model in groups of
+ *             SGP4_NUM_LANES satellites. The sgp4 function of Vallado's
+ *             SGP4 library works on one elsetrec at a time and branches
+ *             on the model and the operation mode for every call. For the
+ *             near Earth model, the arithmetic is the same for all
+ *             satellites, so here the parameters of the records are
+ *             copied into a structure of arrays with one block of
+ *             SGP4_NUM_LANES values per parameter and group and every
+ *             step of the algorithm is run as a loop over the lanes of a
+ *             group. The branches become selections between values that
+ *             are computed for all lanes and the iteration of Kepler's
+ *             equation runs until all lanes have converged, with
+ *             converged lanes being left unchanged.
+ *
+ *The standard library functions sin, cos, atan2 and fmod have branches
+ *and can not be vectorized, so here they are replaced by polynomial
+ *approximations that are accurate to about one unit in the last place.
+ *When compiled using GCC or Clang for x86 processors and the processor
+ *supports AVX2 and FMA instructions, which is determined at runtime, these
+ *functions are evaluated for all four lanes of a group at once using
+ *vector instructions. Otherwise, they are evaluated in plain loops. The
+ *results of the different paths can differ in the last bits, but a given
+ *path always produces the same results. Compared to sgp4, the positions
+ *typically differ by less than a micrometer and the error codes are the
+ *same. On a processor with AVX2, propagating a catalog of near Earth
+ *satellites this way is about three times faster than calling sgp4 for
+ *each satellite. Satellites that use the deep space SDP4 model are not
+ *put in the groups and have to be propagated with sgp4.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef SGP4LANESCPP
+#define SGP4LANESCPP
+
+#include <stddef.h>
+#include <vector>
+/*This header is for the core SGP4 propagation routine.*/
+#include "sgp4unit.h"
+
+//The number of satellites that are propagated together.
+#define SGP4_NUM_LANES 4
+
+//The indices of the parameters of the records that are copied.
+enum SGP4LaneParams {
+    SGP4_LANE_MO, SGP4_LANE_MDOT, SGP4_LANE_ARGPO, SGP4_LANE_ARGPDOT,
+    SGP4_LANE_NODEO, SGP4_LANE_NODEDOT, SGP4_LANE_NODECF, SGP4_LANE_CC1,
+    SGP4_LANE_BSTAR, SGP4_LANE_CC4, SGP4_LANE_CC5, SGP4_LANE_T2COF,
+    SGP4_LANE_T3COF, SGP4_LANE_T4COF, SGP4_LANE_T5COF, SGP4_LANE_OMGCOF,
+    SGP4_LANE_ETA, SGP4_LANE_XMCOF, SGP4_LANE_DELMO, SGP4_LANE_D2,
+    SGP4_LANE_D3, SGP4_LANE_D4, SGP4_LANE_SINMAO, SGP4_LANE_NO, SGP4_LANE_AXNPOW,
+    SGP4_LANE_ECCO, SGP4_LANE_INCLO, SGP4_LANE_SINIO, SGP4_LANE_COSIO,
+    SGP4_LANE_AYCOF, SGP4_LANE_XLCOF, SGP4_LANE_CON41, SGP4_LANE_X1MTH2,
+    SGP4_LANE_X7THM1,
+    //This is 1 if isimp is not 1 and 0 otherwise.
+    SGP4_LANE_NOTSIMP,
+    SGP4_LANE_NUM_PARAMS
+};
+
+class SGP4NearEarthLanesCPP {
+public:
+    size_t numGroups;
+    /*The parameters of the records. The value of parameter k for lane l of
+     *group g is at ((g*SGP4_LANE_NUM_PARAMS)+k)*SGP4_NUM_LANES+l. The
+     *unused lanes of the last group repeat the first satellite of the
+     *group.*/
+    std::vector<double> params;
+    /*The index in the catalog of the satellite in each lane. Unused lanes
+     *hold numSats.*/
+    std::vector<size_t> laneSats;
+    size_t numSats;
+    //The constants of the gravitational model.
+    double xke;
+    double j2;
+    double radiusEarthKm;
+    double vKmPerSec;
+
+    SGP4NearEarthLanesCPP();
+
+    void init(const elsetrec *satRecs, const size_t numSatsIn, const gravconsttype gravConstType, std::vector<size_t> &deepSpaceSats);
+    /*Put the numSatsIn records initialized by sgp4init using the
+     *gravitational model gravConstType that use the near Earth model into
+     *groups. The indices of the satellites that use the deep space model
+     *are put in deepSpaceSats.*/
+
+    void propagateGroup(const size_t group, const double *tSince, double *r, double *v, int *errors) const;
+    /*Propagate the satellites of a group. tSince holds the SGP4_NUM_LANES
+     *times in minutes from the epochs of the satellites in the lanes. The
+     *positions in kilometers and the velocities in kilometers per second
+     *are put in r and v, which have 3*SGP4_NUM_LANES elements with
+     *component k of lane l at k*SGP4_NUM_LANES+l, and the error codes of
+     *sgp4 are put in errors. As with sgp4, the position and velocity of
+     *a lane are not valid for error codes 1, 2 and 4.*/
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
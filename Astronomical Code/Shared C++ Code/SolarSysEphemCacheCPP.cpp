@@ -0,0 +1,91 @@
+/**SOLARSYSEPHEMCACHECPP A class that holds piecewise Chebyshev fits of the
+ *             barycentric states of solar system bodies. See
+ *             SolarSysEphemCacheCPP.hpp for details.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "SolarSysEphemCacheCPP.hpp"
+/*This header is for the SOFA library.*/
+#include "sofa.h"
+
+void ApproxSolarSysFuncCPP::operator()(const double JD1, const double JD2, double *vals) const {
+    double pvh[2][3];
+    double pvb[2][3];
+    double pv[2][3];
+    size_t i;
+
+    //The status is not checked. As in approxSolarSysVec, dates outside of
+    //the valid range still give values, but they are less accurate.
+    iauEpv00(JD1,JD2,pvh,pvb);
+
+    if(solarBody==APPROX_SOLAR_SYS_EARTH) {
+        iauCpv(pvb,pv);
+    } else {
+        //The barycentric state of the Sun.
+        iauPvmpv(pvb,pvh,pv);
+
+        if(solarBody!=APPROX_SOLAR_SYS_SUN) {
+            double pvPlanet[2][3];
+
+            iauPlan94(JD1,JD2,solarBody,pvPlanet);
+            iauPvppv(pvPlanet,pv,pv);
+        }
+    }
+
+    //Convert from astronomical units and astronomical units per day TDB
+    //to meters and meters per second.
+    for(i=0;i<3;i++) {
+        vals[i]=pv[0][i]*AU2Meters;
+        vals[3+i]=pv[1][i]*AU2Meters*(1/86400.0);
+    }
+}
+
+bool SolarSysEphemCacheCPP::addApproxBody(const int solarBody, const double AU2Meters, const double TDBStart1, const double TDBStart2, const double TDBEnd1, const double TDBEnd2, const double tol, const size_t degree, const double initSegLength, const double minSegLength, const size_t numThreads) {
+    ApproxSolarSysFuncCPP bodyFunc;
+    ChebTimeCacheCPP newCache;
+
+    bodyFunc.solarBody=solarBody;
+    bodyFunc.AU2Meters=AU2Meters;
+
+    if(!newCache.fit(bodyFunc,6,TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,tol,degree,initSegLength,minSegLength,numThreads)) {
+        return false;
+    }
+
+    bodyCaches.push_back(newCache);
+    return true;
+}
+
+bool SolarSysEphemCacheCPP::addSampledBody(const double *samples, const double TDBStart1, const double TDBStart2, const double TDBEnd1, const double TDBEnd2, const double tol, const size_t degree, const double maxSegLength, const size_t numThreads, double &maxErr) {
+    ChebTimeCacheCPP newCache;
+    const bool fitOK=newCache.fitSamples(samples,6,TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,tol,degree,maxSegLength,numThreads);
+
+    maxErr=newCache.maxErr;
+    if(!fitOK) {
+        return false;
+    }
+
+    bodyCaches.push_back(newCache);
+    return true;
+}
+
+bool SolarSysEphemCacheCPP::evalState(const size_t bodyIdx, const double TDB1, const double TDB2, double *state) const {
+    return bodyCaches[bodyIdx].eval(TDB1,TDB2,state);
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,110 @@
+/**SOLARSYSEPHEMCACHECPP A header file for a class that holds piecewise
+ *             Chebyshev fits of the states of solar system bodies with
+ *             respect to the solar system barycenter over a span of dates
+ *             in barycentric dynamical time (TDB). Once the fits are
+ *             made, the state of a body at a date takes a few dozen
+ *             multiplications per component, which is much less than
+ *             evaluating the planetary theories, so the positions that
+ *             are needed for aberration, light deflection, tides and
+ *             third-body gravitation can be found cheaply at many dates.
+ *
+ *The fits are made with ChebTimeCacheCPP, one per body, so that quickly
+ *moving bodies such as Mercury can use shorter segments than the outer
+ *planets. Each body has six quantities: the position in meters and the
+ *velocity in meters per second in coordinates aligned with the
+ *International Celestial Reference System (ICRS) with the barycenter as
+ *the origin. That is essentially the Barycentric Celestial Reference System
+ *(BCRS), except that TDB is used instead of TCB.
+ *
+ *The states can come from the approximate series of iauEpv00 (Earth) and
+ *iauPlan94 (the planets) in the SOFA library, as in approxSolarSysVec, for
+ *which the ApproxSolarSysFuncCPP class is given. Since iauPlan94 gives
+ *heliocentric states, the barycentric state of the Sun from iauEpv00 is
+ *added to them. Alternatively, states computed elsewhere, such as from the
+ *JPL ephemerides using the SPICE toolkit, can be fit from samples at the
+ *dates given by ChebTimeCacheCPP::sampleDates.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef SOLARSYSEPHEMCACHECPP
+#define SOLARSYSEPHEMCACHECPP
+
+#include <stddef.h>
+#include <vector>
+#include "ChebTimeCacheCPP.hpp"
+
+/*The default fit parameters. The tolerance is in meters for the positions
+ *and meters per second for the velocities. The outer planets are
+ *trillions of meters from the barycenter, so the rounding errors of the
+ *series themselves are a few centimeters and the tolerance can not be
+ *much smaller than that.*/
+#define SOLAR_SYS_CACHE_DEFAULT_DEGREE 16
+#define SOLAR_SYS_CACHE_DEFAULT_SEG_LENGTH 8.0
+#define SOLAR_SYS_CACHE_MIN_SEG_LENGTH (1.0/64.0)
+#define SOLAR_SYS_CACHE_DEFAULT_TOL 0.1
+
+/*The bodies of the approximate series. The values 0 to 8 are the same as
+ *the solarBody input of approxSolarSysVec: 0 is the Earth, 3 the
+ *Earth-Moon barycenter and the others are the planets in order from the
+ *Sun, as in iauPlan94.*/
+#define APPROX_SOLAR_SYS_EARTH 0
+#define APPROX_SOLAR_SYS_NEPTUNE 8
+#define APPROX_SOLAR_SYS_SUN 9
+
+/*The ApproxSolarSysFuncCPP class evaluates the barycentric state of one of
+ *the bodies of the approximate series at a date in TDB for the
+ *ChebTimeCacheCPP class. AU2Meters is the length of the astronomical unit
+ *in meters. The valid range of dates is that of iauEpv00, 1900 to 2100
+ *AD.*/
+class ApproxSolarSysFuncCPP: public ChebTimeFuncCPP {
+public:
+    int solarBody;
+    double AU2Meters;
+
+    void operator()(const double JD1, const double JD2, double *vals) const;
+};
+
+class SolarSysEphemCacheCPP {
+public:
+    std::vector<ChebTimeCacheCPP> bodyCaches;
+
+    bool addApproxBody(const int solarBody, const double AU2Meters, const double TDBStart1, const double TDBStart2, const double TDBEnd1, const double TDBEnd2, const double tol, const size_t degree, const double initSegLength, const double minSegLength, const size_t numThreads);
+    /*Fit the state of one of the bodies of the approximate series over the
+     *span between two two-part Julian dates in TDB and append it to
+     *bodyCaches. The fit parameters are those of ChebTimeCacheCPP::fit.
+     *The return value is false and nothing is appended if the tolerance
+     *could not be met.*/
+
+    bool addSampledBody(const double *samples, const double TDBStart1, const double TDBStart2, const double TDBEnd1, const double TDBEnd2, const double tol, const size_t degree, const double maxSegLength, const size_t numThreads, double &maxErr);
+    /*Fit a body from the 6XnumDates states at the dates given by
+     *ChebTimeCacheCPP::sampleDates for the same span, degree and
+     *maxSegLength and append it to bodyCaches. The largest error at the
+     *check points is put in maxErr. The return value is false and nothing
+     *is appended if that is more than tol.*/
+
+    bool evalState(const size_t bodyIdx, const double TDB1, const double TDB2, double *state) const;
+    /*Put the 6X1 state of body bodyIdx (the order in which the bodies were
+     *added) at the two-part Julian date TDB1+TDB2 in state. The return
+     *value is false and state is not changed if the date is outside of
+     *the span of the fit.*/
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
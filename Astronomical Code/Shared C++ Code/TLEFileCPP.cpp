@@ -0,0 +1,402 @@
+/*TLEFILECPP C++ implementation of a class that memory maps and parses a
+ *           file of two-line element sets. See TLEFileCPP.hpp for the
+ *           format of the file.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For memcmp and memchr
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <limits>
+#include "TLEFileCPP.hpp"
+//For the time conversions.
+#include "sofa.h"
+
+static const double pi=3.1415926535897932384626433832795;
+//Multiplication coefficient to convert from degrees to radians.
+static const double deg2Rad=pi/180.0;
+
+//The powers of 10 that are exactly representable as doubles.
+static const double pow10Tab[23]={1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+
+static bool readDecimalParts(const char *field, const size_t len, double &intPart, double &fracPart);
+static double readDecimal(const char *field, const size_t len);
+static double readImpliedDecimal(const char *field, const size_t numDigits, const double expVal);
+static double readSatNum(const char *field);
+static bool checksumIsValid(const char *line, const size_t len);
+static bool isElementLine(const char *line, const size_t len, const char lineNum);
+static void parseTLESet(TLESetsCPP &sets, const char *line1, const char *line2);
+static const char *nextLine(const char *start, const char *end, size_t &len);
+
+int TLEFileCPP::open(const char *fileName) {
+    //The file is read once from start to end. An empty file just holds no
+    //sets.
+    switch(file.open(fileName,0,true)) {
+        case MAPPED_FILE_OK:
+            return TLE_FILE_OK;
+        case MAPPED_FILE_OPEN_FAILED:
+            return TLE_FILE_OPEN_FAILED;
+        default:
+            return TLE_FILE_MAP_FAILED;
+    }
+}
+
+void TLEFileCPP::parse(TLESetsCPP &sets, const bool skipBadChecksums) const {
+    parseText(sets,static_cast<const char*>(file.data()),file.size(),skipBadChecksums);
+}
+
+void TLEFileCPP::parseText(TLESetsCPP &sets, const char *text, const size_t textSize, const bool skipBadChecksums) {
+    const char *end=text+textSize;
+    const char *curLine, *prevLine=NULL;
+    size_t curLen, prevLen=0;
+    //Each set takes about 140 characters in a two-line file.
+    const size_t numSetsGuess=textSize/140+1;
+
+    sets.numSets=0;
+    sets.SGP4Elements.clear();
+    sets.TTEpoch1.clear();
+    sets.TTEpoch2.clear();
+    sets.satNums.clear();
+    sets.names.clear();
+    sets.checksumIsBad.clear();
+    sets.numSkippedLines=0;
+
+    sets.SGP4Elements.reserve(7*numSetsGuess);
+    sets.TTEpoch1.reserve(numSetsGuess);
+    sets.TTEpoch2.reserve(numSetsGuess);
+    sets.satNums.reserve(numSetsGuess);
+    sets.names.reserve(numSetsGuess);
+    sets.checksumIsBad.reserve(2*numSetsGuess);
+
+    if(textSize==0) {
+        return;
+    }
+
+    curLine=text;
+    while(curLine!=NULL) {
+        const char *line2=nextLine(curLine,end,curLen);
+        size_t len2=0;
+        const char *afterLine2=NULL;
+
+        if(line2!=NULL) {
+            afterLine2=nextLine(line2,end,len2);
+        }
+
+        //The satellite numbers of the two lines must match.
+        if(line2!=NULL&&isElementLine(curLine,curLen,'1')&&isElementLine(line2,len2,'2')&&memcmp(curLine+2,line2+2,5)==0) {
+            const bool line1Bad=!checksumIsValid(curLine,curLen);
+            const bool line2Bad=!checksumIsValid(line2,len2);
+            std::string name;
+
+            //A line right before the set that is not part of another set
+            //is the name of the satellite.
+            if(prevLine!=NULL) {
+                size_t nameStart=0;
+                size_t nameEnd=prevLen;
+
+                while(nameEnd>0&&(prevLine[nameEnd-1]==' '||prevLine[nameEnd-1]=='\t')) {
+                    nameEnd--;
+                }
+                if(nameEnd>=2&&prevLine[0]=='0'&&prevLine[1]==' ') {
+                    nameStart=2;
+                }
+                if(nameEnd>nameStart&&!isElementLine(prevLine,prevLen,'1')&&!isElementLine(prevLine,prevLen,'2')) {
+                    name.assign(prevLine+nameStart,nameEnd-nameStart);
+                } else {
+                    sets.numSkippedLines++;
+                }
+            }
+
+            if(skipBadChecksums&&(line1Bad||line2Bad)) {
+                sets.numSkippedLines+=2+(name.empty()?0:1);
+            } else {
+                parseTLESet(sets,curLine,line2);
+                sets.names.push_back(name);
+                sets.checksumIsBad.push_back(line1Bad);
+                sets.checksumIsBad.push_back(line2Bad);
+                sets.numSets++;
+            }
+
+            prevLine=NULL;
+            curLine=afterLine2;
+        } else {
+            if(prevLine!=NULL) {
+                sets.numSkippedLines++;
+            }
+            prevLine=curLine;
+            prevLen=curLen;
+            curLine=line2;
+        }
+    }
+
+    if(prevLine!=NULL) {
+        sets.numSkippedLines++;
+    }
+}
+
+const char *TLEFileCPP::errorString(const int errorCode) {
+    switch(errorCode) {
+        case TLE_FILE_OK:
+            return "No error.";
+        case TLE_FILE_OPEN_FAILED:
+            return "The TLE file could not be opened.";
+        case TLE_FILE_MAP_FAILED:
+            return "The TLE file could not be memory mapped.";
+        default:
+            return "Unknown error.";
+    }
+}
+
+static void parseTLESet(TLESetsCPP &sets, const char *line1, const char *line2) {
+/*PARSETLESET Read the elements, epoch and satellite number from the two
+ *            lines of a set and append them to sets. Both lines are at
+ *            least 68 characters long. The columns in the comments are
+ *            one-based, as in the description of the format.
+ */
+    const double NaN=std::numeric_limits<double>::quiet_NaN();
+    double epochYear, epochDay, dayFrac, meanMotion, TTEpoch1, TTEpoch2;
+
+    //Eccentricity, columns 27-33 of line 2 with an implied leading
+    //decimal point.
+    sets.SGP4Elements.push_back(readImpliedDecimal(line2+25,7,0));
+    //Inclination, columns 9-16 of line 2 in degrees.
+    sets.SGP4Elements.push_back(readDecimal(line2+8,8)*deg2Rad);
+    //Argument of perigee, columns 35-42 of line 2 in degrees.
+    sets.SGP4Elements.push_back(readDecimal(line2+34,8)*deg2Rad);
+    //Right ascension of the ascending node, columns 18-25 of line 2 in
+    //degrees.
+    sets.SGP4Elements.push_back(readDecimal(line2+17,8)*deg2Rad);
+    //Mean anomaly, columns 44-51 of line 2 in degrees.
+    sets.SGP4Elements.push_back(readDecimal(line2+43,8)*deg2Rad);
+    //Mean motion, columns 53-63 of line 2 in revolutions per day. Convert
+    //to radians per second, with 86400 seconds per TT Julian day.
+    meanMotion=readDecimal(line2+52,11);
+    sets.SGP4Elements.push_back(meanMotion*(2*pi/86400));
+    //BSTAR, columns 54-61 of line 1 as a sign, five digits with an implied
+    //leading decimal point and a signed power of 10 in columns 60-61.
+    sets.SGP4Elements.push_back(readImpliedDecimal(line1+53,5,readDecimal(line1+59,2)));
+
+    //The epoch year in columns 19-20 and day of the year in columns 21-32
+    //of line 1.
+    epochYear=readDecimal(line1+18,2);
+    TTEpoch1=NaN;
+    TTEpoch2=NaN;
+    if(epochYear==epochYear&&readDecimalParts(line1+20,12,epochDay,dayFrac)&&epochDay>=1) {
+        //The years only run from 1957 to 2056.
+        const int year=static_cast<int>(epochYear)+(epochYear<57?2000:1900);
+        double djm0, djm, TAI1, TAI2;
+
+        //The UTC date as a two-part quasi-Julian date, as iauDtf2d would
+        //give it.
+        if(iauCal2jd(year,1,1,&djm0,&djm)==0&&iauUtctai(djm0+djm+(epochDay-1),dayFrac,&TAI1,&TAI2)>=0) {
+            iauTaitt(TAI1,TAI2,&TTEpoch1,&TTEpoch2);
+        }
+    }
+    sets.TTEpoch1.push_back(TTEpoch1);
+    sets.TTEpoch2.push_back(TTEpoch2);
+
+    //The satellite number in columns 3-7 of line 1.
+    sets.satNums.push_back(readSatNum(line1+2));
+}
+
+static bool readDecimalParts(const char *field, const size_t len, double &intPart, double &fracPart) {
+/*READDECIMALPARTS Read a decimal number with optional leading and
+ *                 trailing spaces, an optional sign and an optional
+ *                 decimal point from a fixed-width field. The whole and
+ *                 fractional parts are returned separately, both with the
+ *                 sign of the number. Each part is rounded once, because
+ *                 the digits are accumulated in an integer and divided by
+ *                 an exact power of 10. The return value is false if the
+ *                 field is not a valid number.
+ */
+    uint64_t intDigits=0, fracDigits=0;
+    size_t numFracDigits=0, numDigits=0, i=0;
+    bool isNeg=false;
+
+    while(i<len&&field[i]==' ') {
+        i++;
+    }
+    if(i<len&&(field[i]=='-'||field[i]=='+')) {
+        isNeg=field[i]=='-';
+        i++;
+    }
+    while(i<len&&field[i]>='0'&&field[i]<='9') {
+        intDigits=intDigits*10+static_cast<uint64_t>(field[i]-'0');
+        numDigits++;
+        i++;
+    }
+    if(i<len&&field[i]=='.') {
+        i++;
+        while(i<len&&field[i]>='0'&&field[i]<='9') {
+            fracDigits=fracDigits*10+static_cast<uint64_t>(field[i]-'0');
+            numFracDigits++;
+            i++;
+        }
+    }
+    while(i<len&&field[i]==' ') {
+        i++;
+    }
+    //The fields are at most 12 characters wide, so the digits always fit.
+    if(i!=len||numDigits+numFracDigits==0||numFracDigits>22) {
+        return false;
+    }
+
+    intPart=static_cast<double>(intDigits);
+    fracPart=static_cast<double>(fracDigits)/pow10Tab[numFracDigits];
+    if(isNeg) {
+        intPart=-intPart;
+        fracPart=-fracPart;
+    }
+    return true;
+}
+
+static double readDecimal(const char *field, const size_t len) {
+/*READDECIMAL Read a decimal number from a fixed-width field. NaN is
+ *            returned if the field is not a valid number.
+ */
+    double intPart, fracPart;
+
+    if(!readDecimalParts(field,len,intPart,fracPart)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return intPart+fracPart;
+}
+
+static double readImpliedDecimal(const char *field, const size_t numDigits, const double expVal) {
+/*READIMPLIEDDECIMAL Read a field of numDigits digits with an implied
+ *                   leading decimal point that is preceded by a sign
+ *                   character, which can be a space, '+' or '-', and
+ *                   multiply it by 10^expVal. Spaces in the digits are
+ *                   taken as zeros, as in TLE2SGP4OrbEls. The scaling is
+ *                   done with a single division by an exact power of 10
+ *                   when possible, so the result is correctly rounded. NaN
+ *                   is returned if the field or the exponent is not valid.
+ */
+    uint64_t digits=0;
+    double val, scaleExp;
+    size_t i;
+
+    if((field[0]!=' '&&field[0]!='+'&&field[0]!='-')||expVal!=expVal) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    for(i=1;i<=numDigits;i++) {
+        const char c=field[i];
+
+        if(c>='0'&&c<='9') {
+            digits=digits*10+static_cast<uint64_t>(c-'0');
+        } else if(c==' ') {
+            digits*=10;
+        } else {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+
+    val=static_cast<double>(digits);
+    scaleExp=static_cast<double>(numDigits)-expVal;
+    if(scaleExp>=0&&scaleExp<=22) {
+        val/=pow10Tab[static_cast<size_t>(scaleExp)];
+    } else {
+        val*=pow(10.0,-scaleExp);
+    }
+    return field[0]=='-'?-val:val;
+}
+
+static double readSatNum(const char *field) {
+/*READSATNUM Read the five-character satellite number in columns 3-7 of a
+ *           line. In the Alpha-5 format, the first character is a letter
+ *           standing for 10 to 33, with I and O skipped.
+ */
+    const char c=field[0];
+
+    if(c>='A'&&c<='Z'&&c!='I'&&c!='O') {
+        int letterVal=c-'A';
+
+        if(c>'I') {
+            letterVal--;
+        }
+        if(c>'O') {
+            letterVal--;
+        }
+        return (letterVal+10)*10000.0+readDecimal(field+1,4);
+    }
+
+    return readDecimal(field,5);
+}
+
+static bool checksumIsValid(const char *line, const size_t len) {
+/*CHECKSUMISVALID The checksum in column 69 is the last digit of the sum of
+ *                the digits in columns 1-68, with each '-' counting as
+ *                1. A missing checksum is invalid.
+ */
+    unsigned int theSum=0;
+    size_t i;
+
+    if(len<69||line[68]<'0'||line[68]>'9') {
+        return false;
+    }
+
+    //This is written without branches so that it can be vectorized.
+    for(i=0;i<68;i++) {
+        const unsigned char digit=static_cast<unsigned char>(line[i]-'0');
+
+        theSum+=(digit<10)?digit:0;
+        theSum+=(line[i]=='-');
+    }
+
+    return theSum%10==static_cast<unsigned int>(line[68]-'0');
+}
+
+static bool isElementLine(const char *line, const size_t len, const char lineNum) {
+    return len>=68&&line[0]==lineNum&&line[1]==' ';
+}
+
+static const char *nextLine(const char *start, const char *end, size_t &len) {
+/*NEXTLINE Find the length of the line starting at start, without the line
+ *         ending, and return the start of the following line or NULL if
+ *         this is the last line. memchr is used, because it is typically
+ *         vectorized by the standard library.
+ */
+    const size_t maxLen=static_cast<size_t>(end-start);
+    const char *p=static_cast<const char*>(memchr(start,'\n',maxLen));
+    const char *CR;
+
+    if(p==NULL) {
+        p=end;
+    }
+    //A carriage return before the newline is part of the line ending. One
+    //before that means that the file uses carriage returns alone.
+    CR=static_cast<const char*>(memchr(start,'\r',static_cast<size_t>(p-start)));
+    if(CR!=NULL) {
+        p=CR;
+    }
+    len=static_cast<size_t>(p-start);
+
+    if(p<end&&*p=='\r') {
+        p++;
+    }
+    if(p<end&&*p=='\n') {
+        p++;
+    }
+
+    return p<end?p:NULL;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
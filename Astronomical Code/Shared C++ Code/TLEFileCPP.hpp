@@ -0,0 +1,105 @@
+/**TLEFILECPP A header file for a class that memory maps a text file of
+ *            two-line element (TLE) sets, such as a full catalog published
+ *            by Space-Track or CelesTrak, and parses all of the sets into
+ *            packed arrays of SGP4 orbital elements and epochs that can be
+ *            given directly to SGP4CatalogCPP. The file is read in one
+ *            pass straight from the mapped memory. The fields are read
+ *            from their fixed columns without making copies of the lines,
+ *            so a catalog of tens of thousands of satellites is parsed in
+ *            milliseconds.
+ *
+ *The file can hold two-line sets or three-line sets, where a line with the
+ *name of the satellite comes before the two lines of the elements, or a
+ *mix of the two. A leading "0 " on a name line, as is used in the
+ *three-line sets of Space-Track, is removed. Lines can end in "\n", "\r\n"
+ *or "\r". A line is taken as the first line of a set if it starts with
+ *"1 " and is at least 68 characters long and the next line starts with
+ *"2 ", is at least 68 characters long and has the same satellite number.
+ *Other lines that do not come right before the first line of a set, such
+ *as blank lines, are skipped and counted.
+ *
+ *The elements, units and epochs are the same as those of TLE2SGP4OrbEls,
+ *which parses a single set in Matlab, except that fields that cannot be
+ *read are NaN and the two-part epochs are split with the whole day in the
+ *first part. Satellite numbers in the Alpha-5 format, where the first
+ *digit is replaced by a letter (A=10, ..., Z=33, skipping I and O), are
+ *supported. The epochs in UTC are converted to TT using the leap seconds
+ *of the SOFA library. As in TLE2SGP4OrbEls, two-digit epoch years below
+ *57 are taken to be in the 2000s.
+ *
+ *The format of the TLE sets is described at
+ *http://www.celestrak.com/NORAD/elements/
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef TLEFILECPP
+#define TLEFILECPP
+
+#include <stddef.h>
+#include <vector>
+#include <string>
+#include "MappedFileCPP.hpp"
+
+//The possible return values of open.
+#define TLE_FILE_OK 0
+#define TLE_FILE_OPEN_FAILED 1
+#define TLE_FILE_MAP_FAILED 2
+
+/*The TLESetsCPP structure holds the results of parsing numSets TLE sets.
+ *The values of set i are at index i of each vector, with SGP4Elements
+ *holding the 7 elements of set i at 7*i, in the order used by
+ *propagateOrbitSGP4, and checksumIsBad holding the flags of the two lines
+ *of set i at 2*i.*/
+typedef struct {
+    size_t numSets;
+    std::vector<double> SGP4Elements;
+    std::vector<double> TTEpoch1;
+    std::vector<double> TTEpoch2;
+    std::vector<double> satNums;
+    //Empty for two-line sets.
+    std::vector<std::string> names;
+    std::vector<bool> checksumIsBad;
+    //The number of lines that were not part of a set.
+    size_t numSkippedLines;
+} TLESetsCPP;
+
+class TLEFileCPP {
+public:
+    int open(const char *fileName);
+    /*Map the given file. The return value is TLE_FILE_OK on success or one
+     *of the other TLE_FILE_ values on failure.*/
+
+    void parse(TLESetsCPP &sets, const bool skipBadChecksums) const;
+    /*Parse all of the TLE sets in the mapped file. If skipBadChecksums is
+     *true, sets where the checksum of either line is missing or wrong are
+     *left out and their lines are counted as skipped.*/
+
+    static void parseText(TLESetsCPP &sets, const char *text, const size_t textSize, const bool skipBadChecksums);
+    /*Parse the textSize characters of text, which need not be terminated
+     *by a null character, in the same manner as parse.*/
+
+    static const char *errorString(const int errorCode);
+    /*Get a description of a value returned by open.*/
+private:
+    MappedFileCPP file;
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
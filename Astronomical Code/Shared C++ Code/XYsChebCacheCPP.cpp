@@ -0,0 +1,50 @@
+/**XYSCHEBCACHECPP A class that caches the X, Y and s quantities of the IAU
+ *             2006/2000A precession-nutation model as piecewise Chebyshev
+ *             polynomials. See XYsChebCacheCPP.hpp for details.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "XYsChebCacheCPP.hpp"
+/*This header is for the SOFA library.*/
+#include "sofa.h"
+
+void XYsFuncCPP::operator()(const double JD1, const double JD2, double *vals) const {
+    iauXys06a(JD1,JD2,&vals[0],&vals[1],&vals[2]);
+}
+
+bool XYsChebCacheCPP::fit(const double TTStart1, const double TTStart2, const double TTEnd1, const double TTEnd2, const double tol, const size_t theDegree, const double initSegLength, const size_t numThreads) {
+    XYsFuncCPP XYsFunc;
+
+    return fit(XYsFunc,3,TTStart1,TTStart2,TTEnd1,TTEnd2,tol,theDegree,initSegLength,XYS_CACHE_MIN_SEG_LENGTH,numThreads);
+}
+
+void XYsChebCacheCPP::eval(const double TT1, const double TT2, double *X, double *Y, double *s) const {
+    double vals[3];
+
+    if(!eval(TT1,TT2,vals)) {
+        iauXys06a(TT1,TT2,X,Y,s);
+        return;
+    }
+
+    *X=vals[0];
+    *Y=vals[1];
+    *s=vals[2];
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,75 @@
+/**XYSCHEBCACHECPP A header file for a class that caches the X and Y
+ *             coordinates of the Celestial Intermediate Pole (CIP) and the
+ *             Celestial Intermediate Origin (CIO) locator s of the IAU
+ *             2006/2000A precession-nutation model as piecewise Chebyshev
+ *             polynomials over a span of time. The function iauXys06a in
+ *             the SOFA library sums thousands of terms of the nutation
+ *             series each time that it is called, whereas evaluating the
+ *             cache takes a few dozen multiplications, so the cache makes
+ *             the conversions between the GCRS and the CIRS, TIRS and ITRS
+ *             of long time series much faster.
+ *
+ *The cache is a ChebTimeCacheCPP of the three quantities of iauXys06a,
+ *which are given by the XYsFuncCPP class; see ChebTimeCacheCPP.hpp for how
+ *the fit is done. The quantities are very smooth; segments of 8 days with
+ *degree 16 polynomials match iauXys06a to within a few times 1e-16
+ *radians, which is at the level of the rounding errors of iauXys06a
+ *itself.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef XYSCHEBCACHECPP
+#define XYSCHEBCACHECPP
+
+#include <stddef.h>
+#include "ChebTimeCacheCPP.hpp"
+
+//The default fit parameters. The tolerance is in radians.
+#define XYS_CACHE_DEFAULT_DEGREE 16
+#define XYS_CACHE_DEFAULT_SEG_LENGTH 8.0
+#define XYS_CACHE_MIN_SEG_LENGTH (1.0/64.0)
+#define XYS_CACHE_DEFAULT_TOL 1e-14
+
+/*The XYsFuncCPP class puts X, Y and s from iauXys06a at a date in TT in
+ *vals for the ChebTimeCacheCPP class.*/
+class XYsFuncCPP: public ChebTimeFuncCPP {
+public:
+    void operator()(const double JD1, const double JD2, double *vals) const;
+};
+
+class XYsChebCacheCPP: public ChebTimeCacheCPP {
+public:
+    using ChebTimeCacheCPP::fit;
+    using ChebTimeCacheCPP::eval;
+
+    bool fit(const double TTStart1, const double TTStart2, const double TTEnd1, const double TTEnd2, const double tol, const size_t theDegree, const double initSegLength, const size_t numThreads);
+    /*Fit the cache over the span between two two-part Julian dates in TT
+     *using ChebTimeCacheCPP::fit with a tolerance of tol radians and a
+     *minimum segment length of XYS_CACHE_MIN_SEG_LENGTH days.*/
+
+    void eval(const double TT1, const double TT2, double *X, double *Y, double *s) const;
+    /*Get X, Y and s in radians at the two-part Julian date TT1+TT2 in TT.
+     *This is the same as iauXys06a(TT1,TT2,X,Y,s) to within the tolerance
+     *of the fit. If the date is outside of the span of the cache,
+     *iauXys06a is used.*/
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
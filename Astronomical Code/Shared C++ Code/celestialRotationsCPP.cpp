@@ -0,0 +1,356 @@
+/**CELESTIALROTATIONSCPP Functions that rotate position and velocity
+ *             vectors between the celestial and terrestrial coordinate
+ *             systems with per-vector epochs and Earth orientation
+ *             parameters. The algorithms are described in
+ *             celestialRotationsCPP.hpp and in the mex files that use
+ *             them.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <math.h>
+#include "celestialRotationsCPP.hpp"
+/*This header is for the SOFA library.*/
+#include "sofa.h"
+//For parallelForCPP
+#include "parallelForCPP.hpp"
+
+static void TEME2PEFRotMat(double TEME2PEF[3][3], const double UT11, const double UT12);
+static void polarMotion1980RotMat(double W[3][3], const double xp, const double yp);
+static void GCRS2TODRotMat(double rotMat[3][3], const double TT1, const double TT2, const double dX, const double dY);
+
+void EarthOrientationEpochsCPP::resize(const size_t newNumEpochs) {
+    numEpochs=newNumEpochs;
+    TT1.resize(newNumEpochs);
+    TT2.resize(newNumEpochs);
+    deltaTTUT1.resize(newNumEpochs);
+    xp.resize(newNumEpochs);
+    yp.resize(newNumEpochs);
+    dX.resize(newNumEpochs);
+    dY.resize(newNumEpochs);
+    LOD.resize(newNumEpochs);
+}
+
+/*The CelestialRotationChunk class is used with parallelForCPP to convert
+ *contiguous chunks of the vectors in separate threads. If there is only
+ *one epoch, the matrices are computed once before the loop and are just
+ *applied in the threads.*/
+class CelestialRotationChunk {
+public:
+    double *retData;
+    double *rotMats;
+    //This is not const, because the SOFA functions do not take const
+    //inputs. It is not modified.
+    double *xVec;
+    size_t numRow;
+    const EarthOrientationEpochsCPP *epochs;
+    int conversion;
+    double meanRotRate;
+    const XYsChebCacheCPP *XYsCache;
+    //The matrices when there is only one epoch.
+    double rotMat[3][3];
+    double toRotating[3][3];
+    double fromRotating[3][3];
+    double omega;
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        const bool isInverse=(conversion==CEL_ROT_ITRS2GCRS||conversion==CEL_ROT_TIRS2GCRS||conversion==CEL_ROT_CIRS2GCRS||conversion==CEL_ROT_ITRS2TEME);
+        double curRotMat[3][3];
+        double curToRotating[3][3];
+        double curFromRotating[3][3];
+        double curOmega;
+        size_t curVec;
+
+        (void)threadIdx;
+        if(epochs->numEpochs==1) {
+            iauCr(rotMat,curRotMat);
+            iauCr(toRotating,curToRotating);
+            iauCr(fromRotating,curFromRotating);
+            curOmega=omega;
+        }
+
+        for(curVec=startItem;curVec<endItem;curVec++) {
+            double *curX=xVec+numRow*curVec;
+            double *curRet=retData+numRow*curVec;
+
+            if(epochs->numEpochs>1) {
+                celestialRotMatsCPP(curRotMat,curToRotating,curFromRotating,&curOmega,*epochs,curVec,conversion,meanRotRate,XYsCache);
+
+                if(rotMats!=NULL) {
+                    size_t i,j;
+                    for(i=0;i<3;i++) {
+                        for(j=0;j<3;j++) {
+                            rotMats[9*curVec+i+3*j]=curRotMat[i][j];
+                        }
+                    }
+                }
+            }
+
+            //Rotate the position.
+            iauRxp(curRotMat,curX,curRet);
+
+            //If a velocity vector was given.
+            if(numRow>3) {
+                double Omega[3]={0,0,curOmega};
+                double posRot[3];
+                double velRot[3];
+                double rotVel[3];
+                double *retVel=curRet+3;
+
+                if(isInverse==false) {
+                    //Go into the rotating frame, subtract the
+                    //instantaneous velocity due to the rotation of the
+                    //Earth and go into the terrestrial frame.
+                    iauRxp(curToRotating,curX+3,velRot);
+                    iauRxp(curToRotating,curX,posRot);
+                    iauPxp(Omega,posRot,rotVel);
+                    iauPmp(velRot,rotVel,retVel);
+                    iauRxp(curFromRotating,retVel,retVel);
+                } else {
+                    //Go back into the rotating frame using the transpose
+                    //of the terrestrial rotation, add the instantaneous
+                    //velocity due to the rotation of the Earth and go into
+                    //the celestial frame.
+                    iauTrxp(curFromRotating,curX+3,velRot);
+                    iauTrxp(curFromRotating,curX,posRot);
+                    iauPxp(Omega,posRot,rotVel);
+                    iauPpp(velRot,rotVel,retVel);
+                    iauTrxp(curToRotating,retVel,retVel);
+                }
+            }
+        }
+    }
+};
+
+void celestialRotationsCPP(double *retData, double *rotMats, const double *xVec, const size_t numRow, const size_t numVec, const EarthOrientationEpochsCPP &epochs, const int conversion, const double meanRotRate, const XYsChebCacheCPP *XYsCache, const size_t numThreads) {
+    CelestialRotationChunk converter;
+    size_t numThreadsUsed;
+
+    converter.retData=retData;
+    converter.rotMats=rotMats;
+    converter.xVec=const_cast<double*>(xVec);
+    converter.numRow=numRow;
+    converter.epochs=&epochs;
+    converter.conversion=conversion;
+    converter.meanRotRate=meanRotRate;
+    converter.XYsCache=XYsCache;
+
+    if(epochs.numEpochs==1) {
+        celestialRotMatsCPP(converter.rotMat,converter.toRotating,converter.fromRotating,&converter.omega,epochs,0,conversion,meanRotRate,XYsCache);
+
+        if(rotMats!=NULL) {
+            size_t i,j;
+            for(i=0;i<3;i++) {
+                for(j=0;j<3;j++) {
+                    rotMats[i+3*j]=converter.rotMat[i][j];
+                }
+            }
+        }
+
+        //Just applying a matrix is too fast to be worth splitting unless
+        //there are a lot of vectors.
+        numThreadsUsed=numThreads2UseCPP(numThreads,numVec/4096);
+    } else {
+        numThreadsUsed=numThreads2UseCPP(numThreads,numVec);
+    }
+
+    parallelForCPP(numVec,numThreadsUsed,converter);
+}
+
+void celestialRotMatsCPP(double rotMat[3][3], double toRotating[3][3], double fromRotating[3][3], double *omega, const EarthOrientationEpochsCPP &epochs, const size_t epochIdx, const int conversion, const double meanRotRate, const XYsChebCacheCPP *XYsCache) {
+    const double TT1=epochs.TT1[epochIdx];
+    const double TT2=epochs.TT2[epochIdx];
+
+    switch(conversion) {
+        case CEL_ROT_GCRS2ITRS:
+        case CEL_ROT_ITRS2GCRS:
+        case CEL_ROT_GCRS2TIRS:
+        case CEL_ROT_TIRS2GCRS:
+        case CEL_ROT_GCRS2CIRS:
+        case CEL_ROT_CIRS2GCRS:
+        {
+            double x, y, s;
+            double rc2i[3][3];
+
+            //Get the X,Y coordinates of the Celestial Intermediate Pole
+            //(CIP) and the Celestial Intermediate Origin (CIO) locator s,
+            //using the IAU 2006 precession and IAU 2000A nutation models
+            //and add the CIP offsets.
+            if(XYsCache!=NULL) {
+                XYsCache->eval(TT1,TT2,&x,&y,&s);
+            } else {
+                iauXys06a(TT1,TT2,&x,&y,&s);
+            }
+            x+=epochs.dX[epochIdx];
+            y+=epochs.dY[epochIdx];
+
+            //Get the GCRS-to-CIRS matrix
+            iauC2ixys(x,y,s,rc2i);
+
+            if(conversion==CEL_ROT_GCRS2CIRS||conversion==CEL_ROT_CIRS2GCRS) {
+                iauCr(rc2i,rotMat);
+                iauCr(rc2i,toRotating);
+                iauIr(fromRotating);
+                *omega=0;
+            } else {
+                const bool hasPolarMotion=(conversion==CEL_ROT_GCRS2ITRS||conversion==CEL_ROT_ITRS2GCRS);
+                double era, UT11, UT12;
+
+                //Obtain UT1 from terestrial time and deltaT and find the
+                //Earth rotation angle.
+                iauTtut1(TT1,TT2,epochs.deltaTTUT1[epochIdx],&UT11,&UT12);
+                era=iauEra00(UT11,UT12);
+
+                //The GCRS-to-TIRS matrix is the same as the GCRS-to-ITRS
+                //matrix, but with the identity matrix in place of the
+                //polar motion matrix.
+                iauIr(fromRotating);
+                iauC2tcio(rc2i,era,fromRotating,toRotating);
+
+                if(hasPolarMotion) {
+                    //Get the Terrestrial Intermediate Origin (TIO) locator
+                    //s' in radians and the polar motion matrix.
+                    const double sp=iauSp00(TT1,TT2);
+                    iauPom00(epochs.xp[epochIdx],epochs.yp[epochIdx],sp,fromRotating);
+
+                    iauC2tcio(rc2i,era,fromRotating,rotMat);
+                } else {
+                    iauCr(toRotating,rotMat);
+                }
+
+                //86400.0 is the number of seconds in a TT day.
+                *omega=meanRotRate*(1-epochs.LOD[epochIdx]/86400.0);
+            }
+            break;
+        }
+        case CEL_ROT_TEME2ITRS:
+        case CEL_ROT_ITRS2TEME:
+        {
+            double UT11, UT12;
+
+            iauTtut1(TT1,TT2,epochs.deltaTTUT1[epochIdx],&UT11,&UT12);
+
+            TEME2PEFRotMat(toRotating,UT11,UT12);
+            polarMotion1980RotMat(fromRotating,epochs.xp[epochIdx],epochs.yp[epochIdx]);
+            iauRxr(fromRotating,toRotating,rotMat);
+
+            *omega=meanRotRate*(1-epochs.LOD[epochIdx]/86400.0);
+            break;
+        }
+        case CEL_ROT_GCRS2TOD:
+        case CEL_ROT_TOD2GCRS:
+        default:
+            GCRS2TODRotMat(rotMat,TT1,TT2,epochs.dX[epochIdx],epochs.dY[epochIdx]);
+            iauIr(toRotating);
+            iauIr(fromRotating);
+            *omega=0;
+            break;
+    }
+
+    if(conversion==CEL_ROT_ITRS2GCRS||conversion==CEL_ROT_TIRS2GCRS||conversion==CEL_ROT_CIRS2GCRS||conversion==CEL_ROT_ITRS2TEME||conversion==CEL_ROT_TOD2GCRS) {
+        iauTr(rotMat,rotMat);
+    }
+}
+
+static void TEME2PEFRotMat(double TEME2PEF[3][3], const double UT11, const double UT12) {
+    //Get Greenwhich mean sidereal time under the IAU's 1982 model. This is
+    //given in radians and is used to build a rotation matrix to rotate into
+    //the PEF system.
+    const double GMST1982=iauGmst82(UT11,UT12);
+    const double cosGMST=cos(GMST1982);
+    const double sinGMST=sin(GMST1982);
+
+    //Build the rotation matrix to rotate by GMST about the z-axis.
+    TEME2PEF[0][0]=cosGMST;
+    TEME2PEF[0][1]=sinGMST;
+    TEME2PEF[0][2]=0;
+    TEME2PEF[1][0]=-sinGMST;
+    TEME2PEF[1][1]=cosGMST;
+    TEME2PEF[1][2]=0;
+    TEME2PEF[2][0]=0;
+    TEME2PEF[2][1]=0;
+    TEME2PEF[2][2]=1.0;
+}
+
+static void polarMotion1980RotMat(double W[3][3], const double xp, const double yp) {
+    //The polar motion matrix to go from the PEF to the ITRS using the
+    //IAU's 1980 conventions, W=R1(-yp)*R2(-xp).
+    const double cosXp=cos(xp);
+    const double sinXp=sin(xp);
+    const double cosYp=cos(yp);
+    const double sinYp=sin(yp);
+
+    W[0][0]=cosXp;
+    W[0][1]=sinXp*sinYp;
+    W[0][2]=sinXp*cosYp;
+    W[1][0]=0;
+    W[1][1]=cosYp;
+    W[1][2]=-sinYp;
+    W[2][0]=-sinXp;
+    W[2][1]=cosXp*sinYp;
+    W[2][2]=cosXp*cosYp;
+}
+
+static void GCRS2TODRotMat(double rotMat[3][3], const double TT1, const double TT2, const double dX, const double dY) {
+    double dpsi,deps,epsa;
+    double rb[3][3];
+    double rp[3][3];
+    double rn[3][3];
+    double rbp[3][3];
+    double rbpn[3][3];
+    double XYZVec[3];
+    double dZ;
+
+    iauPn06a(TT1, TT2,
+              &dpsi, &deps, &epsa,
+              rb,//frame bias matrix
+              rp,//precession matrix
+              rbp,//bias-precession matrix
+              rn,//nutation matrix without dXdY correction.
+              rbpn);//GCRS-to-true matrix without dXdY correction
+
+    //Now, we have to put the corrections for dXdY into the nutation
+    //matrix. First, invert BPN by taking the Transpose. The result is
+    //B'P'N'. Next, get the pole coordinates by multiplying the inverted
+    //rbpn by [0;0;1].
+    iauTr(rbpn, rbpn);
+    XYZVec[0]=0;
+    XYZVec[1]=0;
+    XYZVec[2]=1;
+    iauRxp(rbpn, XYZVec, XYZVec);
+    //XYZVec now holds the pole coordinates X, Y, Z.
+    dZ=-(XYZVec[0]/XYZVec[2])*dX-(XYZVec[1]/XYZVec[2])*dY;
+    //Now multiply  P*B*[dX;dY;dZ] to get dX',dY'dZ'.
+    XYZVec[0]=dX;
+    XYZVec[1]=dY;
+    XYZVec[2]=dZ;
+    iauRxp(rbp, XYZVec, XYZVec);
+    //Add in the correction terms
+    dpsi+=XYZVec[0]/sin(epsa);
+    deps+=XYZVec[1];
+    //Use the corrected terms to get the full, corrected nutation matrix.
+    iauPn06(TT1, TT2,
+            dpsi, deps, &epsa,
+            rb,//frame bias matrix
+            rp,//precession matrix
+            rbp,//bias-precession matrix
+            rn,//nutation matrix with dXdY correction.
+            rotMat);//GCRS-to-true matrix with dXdY correction
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
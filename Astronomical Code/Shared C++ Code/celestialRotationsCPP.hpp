@@ -0,0 +1,114 @@
+/**CELESTIALROTATIONSCPP A header file for functions that rotate position
+ *             and velocity vectors between the celestial and terrestrial
+ *             coordinate systems (GCRS, TIRS, ITRS, TEME and TOD) using
+ *             the functions in the International Astronomical Union's
+ *             Standards of Fundamental Astronomy (SOFA) library. Each
+ *             vector can have its own epoch and Earth orientation
+ *             parameters (EOP), in which case the rotation matrices of the
+ *             epochs are computed in parallel. This is the engine that is
+ *             used by the mex files GCRS2ITRS, ITRS2GCRS, GCRS2TIRS,
+ *             TIRS2GCRS, GCRS2CIRS, CIRS2GCRS, TEME2ITRS, ITRS2TEME,
+ *             GCRS2TOD and TOD2GCRS, so that a time series can be
+ *             converted in one call.
+ *
+ *Velocities are converted by transforming into the rotating frame in which
+ *the axis of rotation of the Earth is the z-axis (the TIRS or the
+ *pseudo-Earth-fixed frame), subtracting the cross product of the angular
+ *velocity vector of the Earth with the position, and rotating into the
+ *final frame. The angular velocity is the mean rotation rate adjusted by
+ *the length of day (LOD) EOP. The documentation of the mex files describes
+ *the conversions in detail.
+ *
+ *The conversions that use the Celestial Intermediate Origin (those
+ *involving the GCRS other than the TOD conversions) can take the X, Y and
+ *s quantities of the precession-nutation model from an XYsChebCacheCPP
+ *instead of calling iauXys06a for each epoch, which is where nearly all of
+ *the time goes.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef CELESTIALROTATIONSCPP
+#define CELESTIALROTATIONSCPP
+
+#include <stddef.h>
+#include <vector>
+#include "XYsChebCacheCPP.hpp"
+
+//The possible conversions.
+#define CEL_ROT_GCRS2ITRS 0
+#define CEL_ROT_ITRS2GCRS 1
+#define CEL_ROT_GCRS2TIRS 2
+#define CEL_ROT_TIRS2GCRS 3
+#define CEL_ROT_TEME2ITRS 4
+#define CEL_ROT_ITRS2TEME 5
+#define CEL_ROT_GCRS2TOD 6
+#define CEL_ROT_TOD2GCRS 7
+#define CEL_ROT_GCRS2CIRS 8
+#define CEL_ROT_CIRS2GCRS 9
+
+class EarthOrientationEpochsCPP {
+public:
+    /*The number of epochs. This is 1 if all vectors are converted at the
+     *same epoch.*/
+    size_t numEpochs;
+    //The two-part Julian dates in terrestrial time (TT) of the epochs.
+    std::vector<double> TT1;
+    std::vector<double> TT2;
+    //The Earth orientation parameters of the epochs in the units used by
+    //getEOP. Those that are not used by a conversion can be left empty.
+    std::vector<double> deltaTTUT1;
+    std::vector<double> xp;
+    std::vector<double> yp;
+    std::vector<double> dX;
+    std::vector<double> dY;
+    std::vector<double> LOD;
+
+    void resize(const size_t newNumEpochs);
+};
+
+void celestialRotationsCPP(double *retData, double *rotMats, const double *xVec, const size_t numRow, const size_t numVec, const EarthOrientationEpochsCPP &epochs, const int conversion, const double meanRotRate, const XYsChebCacheCPP *XYsCache, const size_t numThreads);
+/*Convert the numRowXnumVec set of vectors in xVec (numRow=3 for position
+ *or 6 for position and velocity; only 3 for the TOD conversions) using
+ *the CEL_ROT_ conversion given by conversion, putting the results in
+ *retData. If epochs.numEpochs=1, all of the vectors are converted at the
+ *same epoch. Otherwise, epochs.numEpochs must equal numVec and vector i is
+ *converted at epoch i. If rotMats is not NULL, the 3X3 rotation matrices
+ *for the positions are placed in it, stored by column, one for each epoch.
+ *meanRotRate is the mean rotation rate of the Earth in radians per second
+ *(Constants.IERSMeanEarthRotationRate). XYsCache is the cache of the
+ *precession-nutation quantities to use, or NULL if iauXys06a should be
+ *called for each epoch. numThreads is the maximum number of threads to
+ *use, with 0 meaning the number of hardware threads.*/
+
+void celestialRotMatsCPP(double rotMat[3][3], double toRotating[3][3], double fromRotating[3][3], double *omega, const EarthOrientationEpochsCPP &epochs, const size_t epochIdx, const int conversion, const double meanRotRate, const XYsChebCacheCPP *XYsCache);
+/*Get the matrices for a single epoch of a conversion. For conversions
+ *from a celestial to a terrestrial system, rotMat=fromRotating*toRotating,
+ *where toRotating goes from the celestial system into the rotating frame
+ *and fromRotating goes from the rotating frame into the final terrestrial
+ *frame. For the inverse conversions, toRotating and fromRotating are the
+ *same as for the forward conversion and rotMat is the transpose of the
+ *forward rotation matrix. omega is the rotation rate of the Earth at the
+ *epoch. For the TOD conversions, only rotMat is set. For the CIRS
+ *conversions, toRotating is the GCRS-to-CIRS matrix, fromRotating is the
+ *identity matrix and omega is zero, because the CIRS does not rotate with
+ *the Earth.*/
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
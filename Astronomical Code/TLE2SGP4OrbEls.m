@@ -100,6 +100,10 @@ function [SGP4Elements,TTEpoch1,TTEpoch2,otherInfo,checksumIsBad]=TLE2SGP4OrbEls
 %Note that parts of the input strings that cannot be read will be filled
 %with NaN values.
 %
+%To read all of the TLE sets in a file, such as a full catalog, the
+%compiled function TLEFile2SGP4OrbEls is much faster than calling this
+%function on each set.
+%
 %Information of the format of the TLE sets can be found on
 %T. C. for Space Standards and Innovation. (2012, 27 Sep.) NORAD two-line
 %element sets. [Online].
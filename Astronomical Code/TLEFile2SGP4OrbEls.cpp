@@ -0,0 +1,146 @@
+/**TLEFILE2SGP4ORBELS Read all of the two-line element (TLE) sets in a text
+ *                    file, such as a full satellite catalog published by
+ *                    Space-Track or CelesTrak, and convert them into the
+ *                    SGP4 orbital elements and epochs used by
+ *                    propagateOrbitSGP4 and the SGP4Catalog class. This
+ *                    does the same thing as calling TLE2SGP4OrbEls on each
+ *                    set, but the file is memory mapped and parsed in one
+ *                    pass in C++, which is orders of magnitude faster
+ *                    than the string processing in Matlab. Files of
+ *                    three-line sets, where the name of the satellite is
+ *                    on the line before each set, can also be read.
+ *
+ *INPUTS: fileName A character string holding the name of the file.
+ * skipBadChecksums An optional boolean parameter. If true, sets where the
+ *                  checksum of either line is missing or wrong are left
+ *                  out of the outputs. The default if omitted or an empty
+ *                  matrix is passed is false.
+ *
+ *OUTPUTS: SGP4Elements A 7XnumSets matrix of the SGP4 orbital elements of
+ *                  the sets with one column per set. The elements are the
+ *                  same as the output of TLE2SGP4OrbEls and can be given
+ *                  directly to SGP4Catalog.
+ * TTEpoch1, TTEpoch2 The numSetsX1 epochs of the sets in terrestrial time
+ *                  (TT) as two-part Julian dates. The whole day is in
+ *                  TTEpoch1. As in TLE2SGP4OrbEls, epoch years from 57 to
+ *                  99 are taken to be in the 1900s and those below 57 in
+ *                  the 2000s.
+ *          satNums The numSetsX1 NORAD catalog numbers of the satellites.
+ *                  Numbers in the Alpha-5 format, where the first digit is
+ *                  replaced by a letter, are converted, so A0000=100000.
+ *            names A numSetsX1 cell array of the names of the satellites.
+ *                  These are empty for sets that do not have a name line.
+ *    checksumIsBad A 2XnumSets boolean matrix indicating whether the
+ *                  checksum of each line of each set is missing or bad, as
+ *                  in TLE2SGP4OrbEls.
+ *  numSkippedLines The number of lines in the file that were not part of
+ *                  a set or were skipped due to bad checksums.
+ *
+ *Fields that cannot be read are NaN. The format of the TLE sets is
+ *described in the comments to TLE2SGP4OrbEls.
+ *
+ *The algorithm can be compiled for use in Matlab  using the
+ *CompileCLibraries function.
+ *
+ *The algorithm is run in Matlab using the command format
+ *[SGP4Elements,TTEpoch1,TTEpoch2,satNums,names,checksumIsBad,numSkippedLines]=TLEFile2SGP4OrbEls(fileName,skipBadChecksums);
+ *
+ *EXAMPLE:
+ *A catalog of TLE sets downloaded as a file is read and propagated to one
+ *day after the epoch of the first set.
+ * [SGP4Elements,TTEpoch1,TTEpoch2]=TLEFile2SGP4OrbEls('catalog.txt',true);
+ * theCat=SGP4Catalog(SGP4Elements,TTEpoch1,TTEpoch2);
+ * [xState,errorState]=theCat.propagateTT(TTEpoch1(1),TTEpoch2(1)+1);
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "TLEFileCPP.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    bool skipBadChecksums=false;
+    char *fileName;
+    TLEFileCPP theFile;
+    TLESetsCPP sets;
+    size_t curSet;
+    int retVal;
+
+    if(nrhs<1||nrhs>2) {
+        mexErrMsgTxt("Wrong number of inputs.");
+        return;
+    }
+
+    if(nlhs>7) {
+        mexErrMsgTxt("Too many outputs.");
+        return;
+    }
+
+    if(!mxIsChar(prhs[0])) {
+        mexErrMsgTxt("The file name must be a character string.");
+        return;
+    }
+
+    if(nrhs>1&&!mxIsEmpty(prhs[1])) {
+        skipBadChecksums=getBoolFromMatlab(prhs[1]);
+    }
+
+    fileName=mxArrayToString(prhs[0]);
+    retVal=theFile.open(fileName);
+    mxFree(fileName);
+    if(retVal!=TLE_FILE_OK) {
+        mexErrMsgTxt(TLEFileCPP::errorString(retVal));
+        return;
+    }
+
+    theFile.parse(sets,skipBadChecksums);
+
+    plhs[0]=doubleMat2Matlab(sets.SGP4Elements.data(),7,sets.numSets);
+    if(nlhs>1) {
+        plhs[1]=doubleMat2Matlab(sets.TTEpoch1.data(),sets.numSets,1);
+    }
+    if(nlhs>2) {
+        plhs[2]=doubleMat2Matlab(sets.TTEpoch2.data(),sets.numSets,1);
+    }
+    if(nlhs>3) {
+        plhs[3]=doubleMat2Matlab(sets.satNums.data(),sets.numSets,1);
+    }
+    if(nlhs>4) {
+        plhs[4]=mxCreateCellMatrix(sets.numSets,1);
+        for(curSet=0;curSet<sets.numSets;curSet++) {
+            mxSetCell(plhs[4],curSet,mxCreateString(sets.names[curSet].c_str()));
+        }
+    }
+    if(nlhs>5) {
+        mxLogical *checksumIsBad;
+
+        plhs[5]=mxCreateLogicalMatrix(2,sets.numSets);
+        checksumIsBad=mxGetLogicals(plhs[5]);
+        for(curSet=0;curSet<2*sets.numSets;curSet++) {
+            checksumIsBad[curSet]=sets.checksumIsBad[curSet];
+        }
+    }
+    if(nlhs>6) {
+        plhs[6]=mxCreateDoubleScalar(static_cast<double>(sets.numSkippedLines));
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -40,6 +40,9 @@
  *respect to the origin. The magnitudes of the output vectors equal the
  *magnitudes of the input vectors.
  *
+ *The velocity of the Earth and its distance from the Sun at many times can
+ *be found cheaply for use here using the solarSysEphemCache class.
+ *
  *The algorithm can be compiled for use in Matlab  using the 
  *CompileCLibraries function.
  *
@@ -58,6 +58,11 @@
  *International Astronomical Union's (IAU) Standard's of Fundamental
  *Astronomy library.
  *
+ *If the states are needed at many dates within a span of time, such as at
+ *every step of a simulation, then a solarSysEphemCache made from the same
+ *series is much faster, since it evaluates piecewise Chebyshev fits
+ *instead of the series.
+ *
  *The algorithm can be compiled for use in Matlab  using the 
  *CompileCLibraries function.
  *
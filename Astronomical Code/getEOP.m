@@ -75,6 +75,18 @@ function [xpyp,dXdY,deltaUTCUT1,deltaTTUT1,LOD]=getEOP(JulUTC1,JulUTC2,refreshFr
 %
 %Once loaded, the data stays in memory until this function is cleared.
 %
+%The compiled (mex) coordinate and time conversion functions, such as
+%GCRS2ITRS and TT2UT1, do not call this function. Rather, they load
+%./data/EOP.txt themselves the first time that they need the parameters
+%and interpolate it in the same manner as this function (see
+%EOPTableC.h). Thus, data downloaded using refreshFromSource is only used
+%by the compiled functions if replaceEOPtxt is true. The compiled functions
+%record the modification time and size of ./data/EOP.txt when they load it
+%and reload it when they are next called if either changed, checking at
+%most once a second. A compiled function called within a second of its
+%previous call can thus still use the old file. To make all of the
+%compiled functions reload the file right away, use clear mex.
+%
 %x and y, sometimes called px, py or PMx, PMy are the polar motion
 %coordinates and do not include tidal or libration effects. dX and dY are
 %the celestial pole offsets with respect to the IAU 2006/2000A precession/
@@ -631,7 +643,7 @@ for curEntry=1:numEntry
     if(~isempty(val))
         dataRet(curEntry,5)=val;
     else
-        dataRet=dataRet(1:curEntry,:);
+        dataRet=dataRet(1:(curEntry-1),:);
         break;
     end
 
@@ -41,6 +41,10 @@
  *Jupiter    0.00095435     3e-9
  *Saturn     0.00028574     3e-10
  *
+ *When the states of the bodies are needed at many times, they can be
+ *taken from a solarSysEphemCache rather than being recomputed from the
+ *ephemerides for each time.
+ *
  *The algorithm can be compiled for use in Matlab  using the 
  *CompileCLibraries function.
  *
@@ -99,17 +103,19 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         mexErrMsgTxt("The input MSolar has the wrong dimensionality.");
     }
 
-    if(mxGetM(prhs[3])!=6||mxGetN(prhs[2])!=numBodies) {
+    checkRealDoubleArray(prhs[3]);
+    if(mxGetM(prhs[3])!=6||mxGetN(prhs[3])!=numBodies) {
         mexErrMsgTxt("The input xBody has the wrong dimensionality.");
     }
 
-    if(nrhs>3) {
+    if(nrhs>4) {
         checkRealDoubleArray(prhs[4]); 
 
         if(mxGetM(prhs[4])!=numBodies||mxGetN(prhs[4])!=1) {
            mexErrMsgTxt("The input deflecLimit has the wrong dimensionality."); 
         }
 
+        deflecLimit=(double*)mxGetData(prhs[4]);
     } else {
         deflecLimit=NULL;
     }
@@ -153,7 +159,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         //Velocity
         for(i=0;i<3;i++) {
             //Convert from meters per second BCRS to AU/ day.
-            bodyParam[curBody].pv[1][i]=xBody[3+baseIdx+i]*(1/DAU)*(1/DAYSEC);
+            bodyParam[curBody].pv[1][i]=xBody[3+baseIdx+i]*DAYSEC/DAU;
         }
         
         baseIdx+=6;
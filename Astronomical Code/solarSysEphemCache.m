@@ -0,0 +1,370 @@
+classdef solarSysEphemCache < handle
+%%SOLARSYSEPHEMCACHE A class holding piecewise Chebyshev polynomial fits of
+%                    the states of the Sun and planets (and the Moon if
+%                    the JPL ephemerides are used) with respect to the
+%                    solar system barycenter over a span of dates in
+%                    barycentric dynamical time (TDB). The fits are made
+%                    once when the cache is created, after which the
+%                    state of a body at any date in the span costs a few
+%                    dozen multiply-adds per component. This is meant for
+%                    simulations that need the positions of the bodies at
+%                    many times, for example for aberration (aberrCorr),
+%                    light deflection (lightDeflectCorr), solid Earth tides
+%                    or the gravitation of the Sun and the Moon.
+%
+%The states are 6X1 vectors [position;velocity] in meters and meters per
+%second in coordinates aligned with the International Celestial Reference
+%System (ICRS) with the solar system barycenter as the origin. That is
+%essentially the Barycentric Celestial Reference System (BCRS), except that
+%the time scale is TDB rather than TCB.
+%
+%The states can come from two sources:
+%'approx' The approximate series of iauEpv00 and iauPlan94 in the IAU's
+%         Standards of Fundamental Astronomy (SOFA) library, as used in
+%         approxSolarSysVec. The heliocentric states of the planets are
+%         moved to the barycenter using the barycentric state of the Sun
+%         from iauEpv00. The dates should be between 1900 and 2100 AD. The
+%         Moon and Pluto are not available.
+%'SPICE'  The DE430 ephemerides using the MICE interface to NASA's SPICE
+%         toolkit, as in solarBodyVec. The ephemeris file de430.bsp must
+%         be in the data folder next to this file. The ephemerides are
+%         only loaded while the cache is being fit.
+%The fits are checked against the source at points between the nodes of
+%the polynomials and the segments are shortened until the largest
+%difference of any component is within the tolerance. The series are
+%rounded to a few centimeters for the outer planets, so the tolerance
+%should not be much less than that.
+%
+%If the C++ implementation has not been compiled, then no fits are made
+%and the evaluate method just calls the source of the states. Also, if the
+%C++ implementation is used, the mex file is locked when a
+%solarSysEphemCache object is created and is not unlocked (and able to be
+%recompiled) until all of the solarSysEphemCache objects have been freed.
+%
+%EXAMPLE:
+%The states of the Earth, the Sun and Jupiter are fit over 30 days and are
+%then used to correct the direction to a star for light deflection and
+%aberration as seen from the center of the Earth once a minute.
+% [TDB1,TDB2]=Cal2TDB(2025,1,1,0,0,0);
+% theCache=solarSysEphemCache(TDB1,TDB2,TDB1,TDB2+30,{'EARTH','SUN','JUPITER BARYCENTER'},'approx');
+% TDBTimes2=TDB2+(0:(30*1440))/1440;
+% xEarth=theCache.evaluate(TDB1,TDBTimes2,'EARTH');
+% xSun=theCache.evaluate(TDB1,TDBTimes2,'SUN');
+% xJupiter=theCache.evaluate(TDB1,TDBTimes2,'JUPITER BARYCENTER');
+% uStar=[1;1;1]/sqrt(3);
+% numTimes=length(TDBTimes2);
+% uObs=zeros(3,numTimes);
+% for k=1:numTimes
+%     uDefl=lightDeflectCorr(uStar,xEarth(1:3,k),[1;0.00095435],[xSun(:,k),xJupiter(:,k)],[6e-6;3e-9]);
+%     uObs(:,k)=aberrCorr(uDefl,xEarth(4:6,k),norm(xEarth(1:3,k)-xSun(1:3,k)));
+% end
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+properties(SetAccess=private)
+    bodies%A cell array of the names of the bodies in the cache.
+    source%'approx' or 'SPICE'.
+    %The span of the fits as two-part Julian dates in TDB.
+    TDBStart1
+    TDBStart2
+    TDBEnd1
+    TDBEnd2
+    %The largest difference between the fit and the source found at the
+    %check points of each body. These are empty if the C++ implementation
+    %does not exist.
+    maxErr
+end
+
+properties(Access=private)
+    CPPData%Only used if an interface to a C++ implementation exists.
+end
+
+properties(Constant,Access=private)
+    %These match the defaults of SolarSysEphemCacheCPP.
+    degree=16;
+    initSegLength=8;
+    minSegLength=1/64;
+    %The names of the bodies of the approximate series in the order of
+    %the codes 0 to 9 of the C++ implementation, which are the same as
+    %the solarBody input of approxSolarSysVec with 9 being the Sun. The
+    %planets other than the Earth are given by iauPlan94 as barycenters of
+    %the planets and their moons.
+    approxBodyNames={{'EARTH'},{'MERCURY','MERCURY BARYCENTER'},{'VENUS','VENUS BARYCENTER'},{'EARTH-MOON BARYCENTER'},{'MARS BARYCENTER'},{'JUPITER BARYCENTER'},{'SATURN BARYCENTER'},{'URANUS BARYCENTER'},{'NEPTUNE BARYCENTER'},{'SUN'}};
+end
+
+methods
+    function newCache=solarSysEphemCache(TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,bodies,source,tol,numThreads)
+    %%SOLARSYSEPHEMCACHE Fit the states of a set of solar system bodies
+    %                    over a span of dates.
+    %
+    %INPUTS: TDBStart1, TDBStart2 The two parts of the Julian date in TDB
+    %                 at the start of the span. The dates of the
+    %                 functions for converting between time scales, such
+    %                 as Cal2TDB and TT2TDB, are split this way.
+    %      TDBEnd1, TDBEnd2 The two parts of the Julian date in TDB at the
+    %                 end of the span.
+    %           bodies A string or a cell array of strings of the names of
+    %                 the bodies, which are the same as the Object input
+    %                 of solarBodyVec: 'SUN', 'MOON', 'MERCURY', 'VENUS',
+    %                 'EARTH', 'EARTH-MOON BARYCENTER', 'MERCURY
+    %                 BARYCENTER', 'VENUS BARYCENTER', 'MARS BARYCENTER',
+    %                 'JUPITER BARYCENTER', 'SATURN BARYCENTER', 'URANUS
+    %                 BARYCENTER', 'NEPTUNE BARYCENTER' and 'PLUTO
+    %                 BARYCENTER'. 'MOON' and 'PLUTO BARYCENTER' can only
+    %                 be used with the 'SPICE' source. If omitted or an
+    %                 empty matrix is passed, all of the bodies of the
+    %                 source are used.
+    %           source The source of the states, 'approx' or 'SPICE', as
+    %                 described above. If omitted or an empty matrix is
+    %                 passed, 'SPICE' is used if the MICE library and the
+    %                 DE430 ephemeris file are available and 'approx'
+    %                 otherwise.
+    %              tol The tolerance of the fits in meters for the
+    %                 positions and meters per second for the velocities.
+    %                 If omitted or an empty matrix is passed, the default
+    %                 is 0.1.
+    %       numThreads The maximum number of threads to use when fitting.
+    %                 The default if omitted or an empty matrix is passed
+    %                 is zero, which means use the number of hardware
+    %                 threads. The SPICE toolkit is always called from one
+    %                 thread.
+    %
+    %OUTPUTS: newCache A new solarSysEphemCache instance.
+
+        ScriptPath=mfilename('fullpath');
+        ScriptFolder=fileparts(ScriptPath);
+        kernelFile=[ScriptFolder,'/data/de430.bsp'];
+
+        if(nargin<6||isempty(source))
+            if(exist('cspice_spkezr','file')&&exist(kernelFile,'file'))
+                source='SPICE';
+            else
+                source='approx';
+            end
+        end
+
+        if(nargin<5||isempty(bodies))
+            bodies={'SUN','MERCURY','VENUS','EARTH','EARTH-MOON BARYCENTER','MARS BARYCENTER','JUPITER BARYCENTER','SATURN BARYCENTER','URANUS BARYCENTER','NEPTUNE BARYCENTER'};
+            if(strcmp(source,'SPICE'))
+                bodies=[bodies,{'MOON','PLUTO BARYCENTER'}];
+            end
+        end
+
+        if(nargin<7||isempty(tol))
+            tol=0.1;
+        end
+
+        if(nargin<8||isempty(numThreads))
+            numThreads=0;
+        end
+
+        if(ischar(bodies))
+            bodies={bodies};
+        end
+
+        if(~strcmp(source,'approx')&&~strcmp(source,'SPICE'))
+            error('An unknown source of the states is given.')
+        end
+
+        if(~(tol>0))
+            error('The tolerance must be positive.')
+        end
+
+        newCache.bodies=bodies(:);
+        newCache.source=source;
+        newCache.TDBStart1=TDBStart1;
+        newCache.TDBStart2=TDBStart2;
+        newCache.TDBEnd1=TDBEnd1;
+        newCache.TDBEnd2=TDBEnd2;
+
+        numBodies=length(bodies);
+        if(strcmp(source,'approx'))
+            %Make sure that all of the bodies are in the series before
+            %fitting anything.
+            approxCodes=zeros(numBodies,1);
+            for curBody=1:numBodies
+                approxCodes(curBody)=solarSysEphemCache.approxBodyCode(bodies{curBody});
+            end
+        end
+
+        if(~exist('solarSysEphemCacheCPPInt','file'))
+            return;
+        end
+
+        newCache.CPPData=solarSysEphemCacheCPPInt('SolarSysEphemCacheCPP');
+        newCache.maxErr=zeros(numBodies,1);
+
+        if(strcmp(source,'approx'))
+            for curBody=1:numBodies
+                [fitOK,newCache.maxErr(curBody)]=solarSysEphemCacheCPPInt('addApproxBody',newCache.CPPData,approxCodes(curBody),TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,tol,solarSysEphemCache.degree,solarSysEphemCache.initSegLength,numThreads);
+                if(~fitOK)
+                    error(['The tolerance could not be met for ',bodies{curBody},'.'])
+                end
+            end
+            return;
+        end
+
+        cspice_furnsh(kernelFile)
+        for curBody=1:numBodies
+            segLength=solarSysEphemCache.initSegLength;
+            while(1)
+                [TDB1,TDB2]=solarSysEphemCacheCPPInt('sampleDates',TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,solarSysEphemCache.degree,segLength);
+                %Seconds past J2000.0 in TDB, as in solarBodyVec. The
+                %states are in kilometers and kilometers per second.
+                TDBSec=86400*((TDB1-2451545.0)+TDB2);
+                states=1e3*cspice_spkezr(bodies{curBody},TDBSec,'J2000','NONE','SOLAR SYSTEM BARYCENTER');
+
+                [fitOK,newCache.maxErr(curBody)]=solarSysEphemCacheCPPInt('addSampledBody',newCache.CPPData,states,TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,tol,solarSysEphemCache.degree,segLength,numThreads);
+                if(fitOK)
+                    break;
+                end
+
+                segLength=segLength/2;
+                if(segLength<solarSysEphemCache.minSegLength)
+                    cspice_unload(kernelFile)
+                    error(['The tolerance could not be met for ',bodies{curBody},'.'])
+                end
+            end
+        end
+        %Unload the ephemerides so that repeated calls do not exceed the
+        %limit on the number of loaded kernels.
+        cspice_unload(kernelFile)
+    end
+
+    function states=evaluate(theCache,TDB1,TDB2,body,numThreads)
+    %%EVALUATE Get the states of one or more of the bodies at a set of
+    %          dates within the span of the cache.
+    %
+    %INPUTS: theCache The solarSysEphemCache instance.
+    %       TDB1,TDB2 The two parts of the Julian dates in TDB. These have
+    %                 the same number of elements or one of them is a
+    %                 scalar.
+    %            body The name of a body, a cell array of names or a
+    %                 vector of the indices of the bodies in theCache.bodies.
+    %                 If omitted or an empty matrix is passed, all of the
+    %                 bodies are used.
+    %      numThreads The maximum number of threads to use. The default if
+    %                 omitted or an empty matrix is passed is 1, since
+    %                 evaluating the fits is cheap. This is only used by
+    %                 the C++ implementation.
+    %
+    %OUTPUTS: states The 6XnumDatesXnumBodies states of the bodies with
+    %                respect to the solar system barycenter in meters and
+    %                meters per second. The states at dates outside of the
+    %                span of the cache are NaN.
+
+        if(nargin<4||isempty(body))
+            body=1:length(theCache.bodies);
+        end
+
+        if(nargin<5)
+            numThreads=[];
+        end
+
+        if(ischar(body))
+            body={body};
+        end
+
+        if(iscell(body))
+            bodyIdx=zeros(length(body),1);
+            for curBody=1:length(body)
+                idx=find(strcmp(body{curBody},theCache.bodies),1);
+                if(isempty(idx))
+                    error(['The body ',body{curBody},' is not in the cache.'])
+                end
+                bodyIdx(curBody)=idx;
+            end
+        else
+            bodyIdx=body(:);
+        end
+
+        if(exist('solarSysEphemCacheCPPInt','file'))
+            states=solarSysEphemCacheCPPInt('evaluate',theCache.CPPData,bodyIdx,TDB1,TDB2,numThreads);
+            return;
+        end
+
+        %Without the C++ implementation, the source is called directly.
+        TDB1=TDB1(:)';
+        TDB2=TDB2(:)';
+        numDates=max(length(TDB1),length(TDB2));
+        TDB1=TDB1.*ones(1,numDates);
+        TDB2=TDB2.*ones(1,numDates);
+        numBodies=length(bodyIdx);
+        states=zeros(6,numDates,numBodies);
+
+        if(strcmp(theCache.source,'approx'))
+            [xHelio,xBary]=approxSolarSysVec(TDB1,TDB2,0);
+            sunBary=xBary-xHelio;
+            for curBody=1:numBodies
+                code=solarSysEphemCache.approxBodyCode(theCache.bodies{bodyIdx(curBody)});
+                switch(code)
+                    case 0
+                        states(:,:,curBody)=xBary;
+                    case 9
+                        states(:,:,curBody)=sunBary;
+                    otherwise
+                        states(:,:,curBody)=approxSolarSysVec(TDB1,TDB2,code)+sunBary;
+                end
+            end
+        else
+            ScriptPath=mfilename('fullpath');
+            ScriptFolder=fileparts(ScriptPath);
+            kernelFile=[ScriptFolder,'/data/de430.bsp'];
+
+            TDBSec=86400*((TDB1-2451545.0)+TDB2);
+            cspice_furnsh(kernelFile)
+            for curBody=1:numBodies
+                states(:,:,curBody)=1e3*cspice_spkezr(theCache.bodies{bodyIdx(curBody)},TDBSec,'J2000','NONE','SOLAR SYSTEM BARYCENTER');
+            end
+            cspice_unload(kernelFile)
+        end
+
+        %Dates outside of the span are NaN, as with the fits.
+        t=(TDB1-theCache.TDBStart1)+(TDB2-theCache.TDBStart2);
+        spanLength=(theCache.TDBEnd1-theCache.TDBStart1)+(theCache.TDBEnd2-theCache.TDBStart2);
+        states(:,t<0|t>spanLength,:)=NaN;
+    end
+
+    function delete(theCache)
+    %%DELETE The destructor method. This method is used when the cache is
+    %        implemented as a C++ class. This method prevents a memory
+    %        leak.
+
+        if(exist('solarSysEphemCacheCPPInt','file')&&~isempty(theCache.CPPData))
+            solarSysEphemCacheCPPInt('~SolarSysEphemCacheCPP',theCache.CPPData);
+        end
+    end
+end
+
+methods(Static,Access=private)
+    function code=approxBodyCode(bodyName)
+    %%APPROXBODYCODE Get the code 0 to 9 of a body of the approximate
+    %                series from its name.
+
+        for code=0:9
+            if(any(strcmp(bodyName,solarSysEphemCache.approxBodyNames{code+1})))
+                return;
+            end
+        end
+        error(['The body ',bodyName,' is not available in the approximate series.'])
+    end
+end
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
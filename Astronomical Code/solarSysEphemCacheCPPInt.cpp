@@ -0,0 +1,315 @@
+/**SOLARSYSEPHEMCACHECPPINT An interface between the Matlab
+ *              solarSysEphemCache class and the C++ SolarSysEphemCacheCPP
+ *              class, which holds Chebyshev fits of the barycentric states
+ *              of solar system bodies over a span of dates in TDB. This
+ *              function is meant to be called by the solarSysEphemCache
+ *              class in Matlab; not directly by the user. Running the
+ *              function with invalid inputs can crash Matlab.
+ *
+ *The function is called as
+ *CPPData=solarSysEphemCacheCPPInt('SolarSysEphemCacheCPP');
+ *to create an empty cache, or
+ *[fitOK,maxErr]=solarSysEphemCacheCPPInt('addApproxBody',CPPData,solarBody,TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,tol,degree,segLength,numThreads);
+ *where solarBody is 0 to 8 as in approxSolarSysVec or 9 for the Sun and
+ *the body is only added if fitOK is true, or
+ *[TDB1,TDB2]=solarSysEphemCacheCPPInt('sampleDates',TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,degree,segLength);
+ *to get the 1XnumDates dates at which the states of a body are needed
+ *to fit it with segments of at most segLength days, or
+ *[fitOK,maxErr]=solarSysEphemCacheCPPInt('addSampledBody',CPPData,states,TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,tol,degree,segLength,numThreads);
+ *where states is the 6XnumDates barycentric states at those dates in
+ *meters and meters per second, or
+ *states=solarSysEphemCacheCPPInt('evaluate',CPPData,bodyIdx,TDB1,TDB2,numThreads);
+ *where bodyIdx holds the one-based indices of the bodies in the order in
+ *which they were added, TDB1 and TDB2 have the same number of elements
+ *or one of them is a scalar and states is 6XnumDatesXnumBodies with NaNs
+ *for dates outside of the span of the fits, or
+ *solarSysEphemCacheCPPInt('~SolarSysEphemCacheCPP',CPPData);
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For strcmp
+#include <cstring>
+//For NaN
+#include <limits>
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "SolarSysEphemCacheCPP.hpp"
+//For parallelForCPP
+#include "parallelForCPP.hpp"
+
+/*The EvalChunk class is used with parallelForCPP to evaluate the states of
+ *contiguous chunks of the dates in separate threads.*/
+class EvalChunk {
+public:
+    const SolarSysEphemCacheCPP *theCache;
+    const size_t *bodyIdx;
+    size_t numBodies;
+    const double *TDB1;
+    const double *TDB2;
+    size_t TDB1Inc;
+    size_t TDB2Inc;
+    size_t numDates;
+    double *states;
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) const {
+        const double NaNVal=std::numeric_limits<double>::quiet_NaN();
+        size_t curDate, curBody, k;
+
+        (void)threadIdx;
+        for(curDate=startItem;curDate<endItem;curDate++) {
+            for(curBody=0;curBody<numBodies;curBody++) {
+                double *curState=states+6*(numDates*curBody+curDate);
+
+                if(!theCache->evalState(bodyIdx[curBody],TDB1[TDB1Inc*curDate],TDB2[TDB2Inc*curDate],curState)) {
+                    for(k=0;k<6;k++) {
+                        curState[k]=NaNVal;
+                    }
+                }
+            }
+        }
+    }
+};
+
+static size_t getNumThreads(const int nrhs, const mxArray *prhs[], const int idx);
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    char cmd[64];
+    SolarSysEphemCacheCPP *theCache;
+
+    if(nrhs<1) {
+        mexErrMsgTxt("Not enough inputs.");
+    }
+
+    if(nrhs>11) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+
+    //Get the command string that is passed.
+    mxGetString(prhs[0], cmd, sizeof(cmd));
+
+    if(!strcmp("SolarSysEphemCacheCPP", cmd)) {
+        if(nlhs>1) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theCache=new SolarSysEphemCacheCPP();
+
+        //Lock this mex file so that it can not be cleared until the object
+        //has been deleted (This avoids a memory leak).
+        mexLock();
+        plhs[0]=ptr2Matlab<SolarSysEphemCacheCPP*>(theCache);
+    } else if(!strcmp("addApproxBody", cmd)) {
+        int solarBody;
+        double AU2Meters, tol, segLength;
+        bool fitOK;
+        double maxErr;
+
+        if(nrhs<10) {
+            mexErrMsgTxt("Not enough inputs.");
+        }
+
+        if(nlhs>2) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theCache=Matlab2Ptr<SolarSysEphemCacheCPP*>(prhs[1]);
+        solarBody=getIntFromMatlab(prhs[2]);
+        if(solarBody<APPROX_SOLAR_SYS_EARTH||solarBody>APPROX_SOLAR_SYS_SUN) {
+            mexErrMsgTxt("Invalid solar body specified.");
+        }
+
+        tol=getDoubleFromMatlab(prhs[7]);
+        segLength=getDoubleFromMatlab(prhs[9]);
+        if(!(tol>0)||!(segLength>0)) {
+            mexErrMsgTxt("The tolerance and the segment length must be positive.");
+        }
+
+        //Get the astronomical unit constant.
+        AU2Meters=getScalarMatlabClassConst("Constants","AstronomialUnit");
+
+        fitOK=theCache->addApproxBody(solarBody,AU2Meters,getDoubleFromMatlab(prhs[3]),getDoubleFromMatlab(prhs[4]),getDoubleFromMatlab(prhs[5]),getDoubleFromMatlab(prhs[6]),tol,getSizeTFromMatlab(prhs[8]),segLength,SOLAR_SYS_CACHE_MIN_SEG_LENGTH,getNumThreads(nrhs,prhs,10));
+        //If the fit failed, then there is no fit from which to get the
+        //error.
+        maxErr=fitOK?theCache->bodyCaches.back().maxErr:std::numeric_limits<double>::infinity();
+
+        plhs[0]=boolMat2Matlab(&fitOK,1,1);
+        if(nlhs>1) {
+            plhs[1]=doubleMat2Matlab(&maxErr,1,1);
+        }
+    } else if(!strcmp("sampleDates", cmd)) {
+        double TDBStart1, TDBStart2, TDBEnd1, TDBEnd2, segLength;
+        size_t degree, numDates;
+        double *TDB1, *TDB2;
+
+        if(nrhs!=7) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>2) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        TDBStart1=getDoubleFromMatlab(prhs[1]);
+        TDBStart2=getDoubleFromMatlab(prhs[2]);
+        TDBEnd1=getDoubleFromMatlab(prhs[3]);
+        TDBEnd2=getDoubleFromMatlab(prhs[4]);
+        degree=getSizeTFromMatlab(prhs[5]);
+        segLength=getDoubleFromMatlab(prhs[6]);
+        if(!(segLength>0)) {
+            mexErrMsgTxt("The segment length must be positive.");
+        }
+
+        numDates=ChebTimeCacheCPP::sampleDates(TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,degree,segLength,NULL,NULL);
+        plhs[0]=mxCreateDoubleMatrix(1,numDates,mxREAL);
+        TDB1=reinterpret_cast<double*>(mxGetData(plhs[0]));
+        if(nlhs>1) {
+            plhs[1]=mxCreateDoubleMatrix(1,numDates,mxREAL);
+            TDB2=reinterpret_cast<double*>(mxGetData(plhs[1]));
+            ChebTimeCacheCPP::sampleDates(TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,degree,segLength,TDB1,TDB2);
+        } else {
+            std::vector<double> TDB2Buffer(numDates);
+
+            ChebTimeCacheCPP::sampleDates(TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,degree,segLength,TDB1,TDB2Buffer.data());
+        }
+    } else if(!strcmp("addSampledBody", cmd)) {
+        double TDBStart1, TDBStart2, TDBEnd1, TDBEnd2, tol, segLength;
+        size_t degree;
+        bool fitOK;
+        double maxErr;
+
+        if(nrhs<10) {
+            mexErrMsgTxt("Not enough inputs.");
+        }
+
+        if(nlhs>2) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theCache=Matlab2Ptr<SolarSysEphemCacheCPP*>(prhs[1]);
+
+        TDBStart1=getDoubleFromMatlab(prhs[3]);
+        TDBStart2=getDoubleFromMatlab(prhs[4]);
+        TDBEnd1=getDoubleFromMatlab(prhs[5]);
+        TDBEnd2=getDoubleFromMatlab(prhs[6]);
+        tol=getDoubleFromMatlab(prhs[7]);
+        degree=getSizeTFromMatlab(prhs[8]);
+        segLength=getDoubleFromMatlab(prhs[9]);
+        if(!(tol>0)||!(segLength>0)) {
+            mexErrMsgTxt("The tolerance and the segment length must be positive.");
+        }
+
+        checkRealDoubleArray(prhs[2]);
+        if(mxGetM(prhs[2])!=6||mxGetN(prhs[2])!=ChebTimeCacheCPP::sampleDates(TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,degree,segLength,NULL,NULL)) {
+            mexErrMsgTxt("The states must be 6XnumDates for the dates of sampleDates.");
+        }
+
+        fitOK=theCache->addSampledBody(reinterpret_cast<const double*>(mxGetData(prhs[2])),TDBStart1,TDBStart2,TDBEnd1,TDBEnd2,tol,degree,segLength,getNumThreads(nrhs,prhs,10),maxErr);
+
+        plhs[0]=boolMat2Matlab(&fitOK,1,1);
+        if(nlhs>1) {
+            plhs[1]=doubleMat2Matlab(&maxErr,1,1);
+        }
+    } else if(!strcmp("evaluate", cmd)) {
+        size_t numBodies, numEl1, numEl2, numDates, curBody;
+        std::vector<size_t> bodyIdx;
+        const double *bodyIdxMATLAB;
+        mwSize dims[3];
+        EvalChunk evaluator;
+        size_t numThreadsUsed;
+
+        if(nrhs<5||nrhs>6) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>1) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theCache=Matlab2Ptr<SolarSysEphemCacheCPP*>(prhs[1]);
+
+        checkRealDoubleArray(prhs[2]);
+        numBodies=mxGetNumberOfElements(prhs[2]);
+        bodyIdxMATLAB=reinterpret_cast<const double*>(mxGetData(prhs[2]));
+        bodyIdx.resize(numBodies);
+        for(curBody=0;curBody<numBodies;curBody++) {
+            const double curIdx=bodyIdxMATLAB[curBody];
+
+            if(!(curIdx>=1&&curIdx<=theCache->bodyCaches.size())||curIdx!=static_cast<double>(static_cast<size_t>(curIdx))) {
+                mexErrMsgTxt("Invalid body index specified.");
+            }
+            //Convert from Matlab's one-based indexation.
+            bodyIdx[curBody]=static_cast<size_t>(curIdx)-1;
+        }
+
+        checkRealDoubleArray(prhs[3]);
+        checkRealDoubleArray(prhs[4]);
+        numEl1=mxGetNumberOfElements(prhs[3]);
+        numEl2=mxGetNumberOfElements(prhs[4]);
+        if(numEl1==0||numEl2==0) {
+            mexErrMsgTxt("Empty matrices were passed instead of dates.");
+        }
+        if(numEl1!=numEl2&&numEl1!=1&&numEl2!=1) {
+            mexErrMsgTxt("The two parts of the Julian dates must have the same number of elements or one must be a scalar.");
+        }
+        numDates=numEl1>numEl2?numEl1:numEl2;
+
+        dims[0]=6;
+        dims[1]=numDates;
+        dims[2]=numBodies;
+        plhs[0]=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+
+        evaluator.theCache=theCache;
+        evaluator.bodyIdx=bodyIdx.data();
+        evaluator.numBodies=numBodies;
+        evaluator.TDB1=reinterpret_cast<const double*>(mxGetData(prhs[3]));
+        evaluator.TDB2=reinterpret_cast<const double*>(mxGetData(prhs[4]));
+        //Scalar dates are used for all of the dates.
+        evaluator.TDB1Inc=numEl1==1?0:1;
+        evaluator.TDB2Inc=numEl2==1?0:1;
+        evaluator.numDates=numDates;
+        evaluator.states=reinterpret_cast<double*>(mxGetData(plhs[0]));
+
+        numThreadsUsed=numThreads2UseCPP(getNumThreads(nrhs,prhs,5),numDates);
+        parallelForCPP(numDates,numThreadsUsed,evaluator);
+    } else if(!strcmp("~SolarSysEphemCacheCPP", cmd)) {
+        if(nrhs<2) {
+            mexErrMsgTxt("Not enough inputs.");
+        }
+
+        theCache=Matlab2Ptr<SolarSysEphemCacheCPP*>(prhs[1]);
+
+        delete theCache;
+        //Unlock the mex file allowing it to be cleared.
+        mexUnlock();
+    } else {
+        mexErrMsgTxt("Invalid string passed to solarSysEphemCacheCPPInt.");
+    }
+}
+
+static size_t getNumThreads(const int nrhs, const mxArray *prhs[], const int idx) {
+    //Evaluating the fits is cheap, so the default is one thread.
+    if(nrhs>idx&&!mxIsEmpty(prhs[idx])) {
+        return getSizeTFromMatlab(prhs[idx]);
+    }
+    return 1;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -55,6 +55,10 @@
  *          updated to account for the additional temporal effects of
  *          ocean tides and librations. If this parameter is omitted,
  *          the value provided by the function getEOP will be used instead.
+ *numThreads An optional parameter specifying the maximum number of
+ *          threads to use. The default if omitted or an empty matrix is
+ *          passed is zero, which means use the number of hardware
+ *          threads.
  *
  *OUTPUTS: zSpher For N stars, this is a 2XN matrix with each colum being
  *                the location of a star in [azimuth;elevation] in radians
@@ -66,6 +70,12 @@
  *
  *This is a mex wrapper for the function iauAtco13 in the International
  *Astronomical Union's (IAU) Standard's of Fundamental Astronomy library.
+ *Rather than calling iauAtco13 for each star, which would recompute the
+ *star-independent astrometry parameters (the time, Earth orientation,
+ *observer and refraction quantities) for every star, the parameters are
+ *computed once with iauApco13 and then iauAtciq and iauAtioq, which are
+ *the remaining steps of iauAtco13, are applied to each star. The stars are
+ *split between multiple threads, so converting a whole catalog is fast.
  *
  *The algorithm can be compiled for use in Matlab  using the 
  *CompileCLibraries function.
@@ -73,6 +83,8 @@
  *The algorithm is run in Matlab using the command format
  *[zObs,uObs]=starCat2Obs(catData,Jul1,Jul2,zObs,P,T,R,wl,dut1,xpyp);
  *or
+ *[zObs,uObs]=starCat2Obs(catData,Jul1,Jul2,zObs,P,T,R,wl,dut1,xpyp,numThreads);
+ *or
  *[zObs,uObs]=starCat2Obs(catData,Jul1,Jul2,zObs);
  *
  *March 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
@@ -84,7 +96,10 @@
 /*This header is for the SOFA library.*/
 #include "sofa.h"
 #include "MexValidation.h"
-#include "CoordFuncs.hpp"
+/*This header is for the native table of Earth orientation parameters.*/
+#include "EOPTableC.h"
+//For parallelForCPP
+#include "parallelForCPP.hpp"
 
 const double halfPi=1.5707963267948966192313216916398;
 const double pi=3.1415926535897932384626433832795;
@@ -93,15 +108,73 @@ const double pi=3.1415926535897932384626433832795;
 const double as2Rad=(1.0/60.0)*(1.0/60.0)*(pi/180.0);
 const double rad2as=1.0/as2Rad;
 
+/*The StarObsChunk class is used with parallelForCPP to convert contiguous
+ *chunks of the stars in separate threads. The star-independent astrometry
+ *parameters are only read, so they are shared by all of the threads.*/
+class StarObsChunk {
+public:
+    //Pointers to the rows of catData
+    const double *RArad;
+    const double *DErad;
+    const double *Plx;
+    const double *pmRA;
+    const double *pmDE;
+    const double *vRad;
+    iauASTROM *astrom;
+    double *zRet;
+    //This is NULL if the unit vectors are not desired.
+    double *uRet;
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        size_t i;
+
+        (void)threadIdx;
+        for(i=startItem;i<endItem;i++) {
+            //Variables to hold the results of the iauAtciq and iauAtioq
+            //functions.
+            double ri,di,aob,zob,hob,dob,rob;
+
+            //Transform from the ICRS to CIRS coordinates.
+            iauAtciq(RArad[i],//ICRS right ascension at J2000.0, radians.
+                     DErad[i],//ICRS declination at J2000.0, radians.
+                     pmRA[i],//RA proper motion, radians/year (in the form dRA/dt and not cos(Dec)*dRA/dt).
+                     pmDE[i],//Dec proper motion (radians/year).
+                     Plx[i]*rad2as,//parallax (arcseconds).
+                     vRad[i]/1000.0,//radial velocity (km/s, +ve if receding).
+                     astrom,
+                     &ri,&di);//CIRS right ascension and declination.
+
+            //Transform from CIRS to observed coordinates.
+            iauAtioq(ri,di,astrom,
+                     &aob,//Observed azimuth (radians East of North).
+                     &zob,//Observed zenith distance (radians).
+                     &hob,//Observed hour angle (radians).
+                     &dob,//Observed declination (radians North).
+                     &rob);//Observed CIO-based right ascension (radians).
+
+            zRet[2*i]=halfPi-aob;//Convert radians East of North to North of East
+            zRet[2*i+1]=halfPi-zob;
+
+            if(uRet!=NULL) {
+                //Convert the  azimith and zenith distance (zenith
+                //distance=pi/2-elevation) to a unit vector in the local
+                //ENU coordinate system of the observer.
+                uRet[3*i]=cos(aob)*sin(zob);
+                uRet[3*i+1]=sin(aob)*sin(zob);
+                uRet[3*i+2]=cos(zob);
+            }
+        }
+    }
+};
+
 void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     double *catData;
     mxArray *zSpherMATLAB;
     //This is only used if nlhs>1. It is initialized here to  avoid a
     //warning if compiled with -Wconditional-uninitialized
     mxArray *uObsMATLAB=NULL;
-    size_t numStars,i;
+    size_t numStars;
     double Jul1,Jul2;
-    double uENU[9];//To hold WGS-84 East-North-Up axes at the observer.
     //The if-statements below should properly initialize all of the EOP.
     //The following initializations to zero are to suppress warnings when
     //compiling with -Wconditional-uninitialized.
@@ -109,10 +182,11 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     double xp=0;
     double yp=0;
     double deltaT=0;
-    //Pointers to the rows of catData
-    double *RArad, *DErad, *Plx, *pmRA, *pmDE,*vRad;
+    size_t numThreads=0;
+    iauASTROM astrom;
+    StarObsChunk converter;
 
-    if(nrhs<4||nrhs>20) {
+    if(nrhs<4||nrhs>11) {
         mexErrMsgTxt("Wrong number of inputs.");
         return;
     }
@@ -180,57 +254,13 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     
     //If any default values will be needed, load them.
     if(nrhs<=9||mxGetM(prhs[8])==0||mxGetM(prhs[9])==0){
-        mxArray *retVals[3];
-        double *xpyp,*dXdY;
-        mxArray *JulUTCMATLAB[2];
-        double JulUTC[2];
-        int retVal;
-        
-        //Get the time in UTC to look up the parameters by going to TAI and
-        //then UTC.
-        retVal=iauTttai(Jul1, Jul2, &JulUTC[0], &JulUTC[1]);
-        if(retVal!=0) {
-            mexErrMsgTxt("An error occurred computing TAI.");
-        }
-        retVal=iauTaiutc(JulUTC[0], JulUTC[1], &JulUTC[0], &JulUTC[1]);
-        switch(retVal){
-            case 1:
-                mexWarnMsgTxt("Dubious Date entered.");
-                break;
-            case -1:
-                mexErrMsgTxt("Unacceptable date entered");
-                break;
-            default:
-                break;
-        }
-        
-        JulUTCMATLAB[0]=doubleMat2Matlab(&JulUTC[0],1,1);
-        JulUTCMATLAB[1]=doubleMat2Matlab(&JulUTC[1],1,1);
-        
-        //Get the Earth orientation parameters for the given date.
-        mexCallMATLAB(3,retVals,2,JulUTCMATLAB,"getEOP");
-        mxDestroyArray(JulUTCMATLAB[0]);
-        mxDestroyArray(JulUTCMATLAB[1]);
-        
-        checkRealDoubleArray(retVals[0]);
-        checkRealDoubleArray(retVals[1]);
-        if(mxGetM(retVals[0])!=2||mxGetN(retVals[0])!=1||mxGetM(retVals[1])!=2||mxGetN(retVals[1])!=1) {
-            mxDestroyArray(retVals[0]);
-            mxDestroyArray(retVals[1]);
-            mxDestroyArray(retVals[2]);
-            mexErrMsgTxt("Error using the getEOP function.");
-            return;
-        }
-        xpyp=(double*)mxGetData(retVals[0]);
-        dXdY=(double*)mxGetData(retVals[1]);//The celestial pole offsets are not used.
+        double xpyp[2];
+
+        //Get the Earth orientation parameters for the given date. The
+        //date is already in UTC.
+        getEOPMexC(Jul1,Jul2,xpyp,NULL,&deltaT,NULL,NULL);
         xp=xpyp[0];
         yp=xpyp[1];
-        deltaT=getDoubleFromMatlab(retVals[2]);
-        
-        //Free the returned arrays.
-        mxDestroyArray(retVals[0]);
-        mxDestroyArray(retVals[1]);
-        mxDestroyArray(retVals[2]);
     }
 
     //Get the UTC UT1 offset, if provided.
@@ -241,7 +271,7 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     //Get the components of the polar motion coordinates.
     if(nrhs>9&&mxGetM(prhs[9])!=0) {
         double *XpYp;
-        if(mxGetM(prhs[9])!=2&&mxGetN(prhs[9])!=1) {
+        if(mxGetM(prhs[9])*mxGetN(prhs[9])!=2) {
             mexErrMsgTxt("The polar motion coordinate vector has the wrong dimensionality.");
             return;
         }
@@ -252,101 +282,62 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
         yp=XpYp[1];
     }
     
-    //Get the axes at the local observer.
+    if(nrhs>10&&mxGetM(prhs[10])!=0) {
+        numThreads=getSizeTFromMatlab(prhs[10]);
+    }
+
+    //Compute the star-independent astrometry parameters once. This is
+    //the part of iauAtco13 that does not depend on the star.
     {
-        double c[3];
-        double a=getScalarMatlabClassConst("Constants","WGS84SemiMajorAxis");
-        double f=getScalarMatlabClassConst("Constants","WGS84Flattening");
+        double eo;//Equation of the Origins (ERA-GST).
+        int retVal;
 
-        getENUAxesCPP(uENU, c,zObs,false,a,f);
+        retVal=iauApco13(Jul1, Jul2,//Quasi-Julian UTC date.
+                         -deltaT,//UT1-UTC in seconds.
+                         zObs[1],//WGS-84Longitude, radians East.
+                         zObs[0],//WGS-84 geodetic latitude (radians North).
+                         zObs[2],//WGS-84 Ellipsoidal height in meters.
+                         xp,yp,//polar motion coordinates (radians)
+                         P,//Pressure at the observer in millibars (hectoPascals).
+                         T,//Temperature at the observer (deg C).
+                         R,//Relative humidity at the observer (0-1).
+                         wl,//Wavelength (micrometers).
+                         &astrom,
+                         &eo);
+        switch(retVal){
+            case 1:
+                mexWarnMsgTxt("Dubious Date entered.");
+                break;
+            case -1:
+                mexErrMsgTxt("An error occurred during the transformation to local coordinates.");
+                return;
+            default:
+                break;
+        }
     }
 
     //Set the pointers for each column of data in the catalog.
-    RArad=catData;
-    DErad=RArad+numStars;
-    Plx=DErad+numStars;
-    pmRA=Plx+numStars;
-    pmDE=pmRA+numStars;
-    vRad=pmDE+numStars;
-    
+    converter.RArad=catData;
+    converter.DErad=converter.RArad+numStars;
+    converter.Plx=converter.DErad+numStars;
+    converter.pmRA=converter.Plx+numStars;
+    converter.pmDE=converter.pmRA+numStars;
+    converter.vRad=converter.pmDE+numStars;
+    converter.astrom=&astrom;
+
     //Allocate space for the return values
     zSpherMATLAB=mxCreateDoubleMatrix(2,numStars,mxREAL);
     plhs[0]=zSpherMATLAB;
-    
+    converter.zRet=(double*)mxGetData(zSpherMATLAB);
+    converter.uRet=NULL;
+
     if(nlhs>1) {
         uObsMATLAB=mxCreateDoubleMatrix(3,numStars,mxREAL);
         plhs[1]=uObsMATLAB;
+        converter.uRet=(double*)mxGetData(uObsMATLAB);
     }
-    
-    {
-        double *uEast,*uNorth,*uUp;
-        double *zRet;
-        //This is only used if nlhs>1. It is initialized here to  avoid a
-        //warning if compiled with -Wconditional-uninitialized
-        double *uRet=NULL;
-        uEast=uENU;
-        uNorth=uENU+3;
-        uUp=uENU+6;
-        
-        zRet=(double*)mxGetData(zSpherMATLAB);
-        if(nlhs>1) {
-            uRet=(double*)mxGetData(uObsMATLAB);
-        }
-        
-        for(i=0;i<numStars;i++) {
-            //Variables to hold the result of the iauAtco13 function.
-            double aob,zob,hob,dob,rob,eo;
-            int retVal;
-            
-            retVal=iauAtco13(RArad[i],//ICRS right ascension at J2000.0, radians.
-                          DErad[i],//ICRS declination at J2000.0, radians.
-                          pmRA[i],//RA proper motion, radians/year (in the form dRA/dt and not cos(Dec)*dRA/dt).
-                          pmDE[i],//Dec proper motion (radians/year).
-                          Plx[i]*rad2as,//parallax (arcseconds).
-                          vRad[i]/1000.0,//radial velocity (km/s, +ve if receding).
-                          Jul1, Jul2,//Quasi-Julian UTC date.
-                          -deltaT,//UT1-UTC in seconds.
-                          zObs[1],//WGS-84Longitude, radians East.
-                          zObs[0],//WGS-84 geodetic latitude (radians North).
-                          zObs[2],//WGS-84 Ellipsoidal height in meters.
-                          xp,yp,//polar motion coordinates (radians)
-                          P,//Pressure at the observer in millibars (hectoPascals).
-                          T,//Temperature at the observer (deg C).
-                          R,//Relative humidity at the observer (0-1).
-                          wl,//Wavelength (micrometers).
-                          &aob,//Observed azimuth (radians East of North).
-                          &zob,//Observed zenith distance (radians).
-                          &hob,//Observed hour angle (radians).
-                          &dob,//Observed declination (radians North).
-                          &rob,//Observed CIO-based right ascension (radians).
-                          &eo);//Equation of the Origins (ERA-GST).
-
-            if(retVal<0) {
-                mxDestroyArray(zSpherMATLAB);
-                if(nlhs>1) {
-                    mxDestroyArray(uObsMATLAB);
-                }
-                
-                mexErrMsgTxt("An error occurred during the transformation to local coordinates.");
-                return;
-            }
 
-            zRet[0]=halfPi-aob;//Convert radians East of North to North of East
-            zRet[1]=halfPi-zob;
-            
-            if(nlhs>1) {
-                //Convert the  azimith and zenith distance (zenith
-                //distance=pi/2-elevation) to a unit vector in the local
-                //ENU coordinate system of the observer.
-                uRet[0]=cos(aob)*sin(zob);
-                uRet[1]=sin(aob)*sin(zob);
-                uRet[2]=cos(zob);
-                
-                uRet+=3;
-            }
-            zRet+=2;
-        }   
-    }
+    parallelForCPP(numStars,numThreads2UseCPP(numThreads,numStars),converter);
 }
 
 /*LICENSE:
@@ -61,8 +61,14 @@ mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-
 %Compile the magnetic and gravitational code.
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','./Mathematical Functions/polynomials/NALegendreCosRat.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp');
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','./Mathematical Functions/Polynomials/normHelmholtz.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp');
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','./Mathematical Functions/spherHarmonicEvalCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp','./Coordinate Systems/Shared C++ Code/calcSpherJacobCPP.cpp');
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','./Mathematical Functions/spherHarmonicCovCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/spherHarmonicEvalCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicKernelsCPP.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp','./Coordinate Systems/Shared C++ Code/calcSpherJacobCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/spherHarmonicGridEvalCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicGridEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicKernelsCPP.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp','./Coordinate Systems/Shared C++ Code/calcSpherJacobCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/spherHarmonicModelCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicModelCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCoeffFileCPP.cpp','./Misc/Shared C++ Code/MappedFileCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicKernelsCPP.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp','./Coordinate Systems/Shared C++ Code/calcSpherJacobCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/writeSpherHarmonicCoeffFileCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCoeffFileCPP.cpp','./Misc/Shared C++ Code/MappedFileCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicKernelsCPP.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp','./Coordinate Systems/Shared C++ Code/calcSpherJacobCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/spherHarmonicCovCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/spherHarmonicEvalCovCPPInt.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicKernelsCPP.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp','./Coordinate Systems/Shared C++ Code/calcSpherJacobCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Coordinate Systems/Shared C++ Code/','-I./Magnetism/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Magnetism/magneticFieldModelCPPInt.cpp','./Magnetism/Shared C++ Code/magneticFieldModelCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicModelCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCoeffFileCPP.cpp','./Misc/Shared C++ Code/MappedFileCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicEvalCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicCovCPP.cpp','./Mathematical Functions/Shared C++ Code/spherHarmonicKernelsCPP.cpp','./Mathematical Functions/Shared C++ Code/NALegendreCosRatCPP.cpp','./Mathematical Functions/Shared C++ Code/normHelmholtzCPP.cpp','./Coordinate Systems/Shared C++ Code/spher2CartCPP.cpp','./Coordinate Systems/Shared C++ Code/calcSpherJacobCPP.cpp','./Coordinate Systems/Shared C++ Code/getENUAxesCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Gravity/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Gravity/geoidGridCPPInt.cpp','./Gravity/Shared C++ Code/geoidGridCPP.cpp','./Misc/Shared C++ Code/MappedFileCPP.cpp');
 
 %Compile the 2D assignment algorithms
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','./Assignment Algorithms/2D Assignment/assign2DByCol.c');
@@ -73,6 +79,12 @@ mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-
 %Compile the k-best 2D assignment algorithm
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Assignment Algorithms/Shared C++ Code/','./Assignment Algorithms/k-Best 2D Assignment/kBest2DAssign.cpp','./Assignment Algorithms/Shared C++ Code/ShortestPathCPP.cpp');
 
+%Compile the 3D assignment algorithm
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Assignment Algorithms/Shared C++ Code/','./Assignment Algorithms/3D Assignment/assign3D.cpp','./Assignment Algorithms/Shared C++ Code/assign3DCPP.cpp','./Assignment Algorithms/Shared C++ Code/ShortestPathCPP.cpp');
+
+%Compile the S-D assignment algorithm
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Assignment Algorithms/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Assignment Algorithms/S-D Assignment/assignSD.cpp','./Assignment Algorithms/Shared C++ Code/assignSDCPP.cpp','./Assignment Algorithms/Shared C++ Code/ShortestPathCPP.cpp');
+
 %Compile the containers
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','./Container Classes/metricTreeCPPInt.cpp','./Container Classes/Shared C++ Code/metricTreeCPP.cpp','./Mathematical Functions/Shared C++ Code/findFirstMaxCPP.cpp');
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','./Container Classes/kdTreeCPPInt.cpp','./Container Classes/Shared C++ Code/kdTreeCPP.cpp','./Mathematical Functions/Shared C++ Code/findFirstMaxCPP.cpp');
@@ -90,7 +102,8 @@ mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Mathematical Functions/Combinatorics/Shared C++ Code/','./Mathematical Functions/Combinatorics/getNextGrayCode.cpp');
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Mathematical Functions/Shared C++ Code/','-I./Container Classes/Shared C++ Code/','./Mathematical Functions/findFirstMax.cpp','./Mathematical Functions/Shared C++ Code/findFirstMaxCPP.cpp')
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Mathematical Functions/Shared C Code/','./Mathematical Functions/binSearch.c','./Mathematical Functions/Shared C Code/binSearchC.c')
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Assignment Algorithms/Shared C++ Code/','-I./Mathematical Functions/MMOSPAApprox/Shared C++ Code/','./Mathematical Functions/MMOSPAApprox/MMOSPAApprox.cpp','./Mathematical Functions/MMOSPAApprox/Shared C++ Code/MMOSPAApproxCPP.cpp','./Assignment Algorithms/Shared C++ Code/ShortestPathCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Assignment Algorithms/Shared C++ Code/','-I./Mathematical Functions/MMOSPAApprox/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/MMOSPAApprox/MMOSPAApprox.cpp','./Mathematical Functions/MMOSPAApprox/Shared C++ Code/MMOSPAApproxCPP.cpp','./Assignment Algorithms/Shared C++ Code/ShortestPathCPP.cpp');
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Assignment Algorithms/Shared C++ Code/','-I./Mathematical Functions/MMOSPAApprox/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Mathematical Functions/MMOSPAApprox/MMOSPAExact.cpp','./Mathematical Functions/MMOSPAApprox/Shared C++ Code/MMOSPAApproxCPP.cpp','./Assignment Algorithms/Shared C++ Code/ShortestPathCPP.cpp');
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','./Mathematical Functions/wrapRange.cpp','./Mathematical Functions/Shared C++ Code/wrapRangeCPP.cpp')
 
 %If compiling under Windows, the compile environment must be set up so
@@ -196,7 +209,7 @@ cd(ScriptFolder)
 
 %Compile astronomical functions that use the SOFA code
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/changeEpoch.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./Coordinate Systems/Shared C++ Code/','-I./','./Astronomical Code/starCat2Obs.cpp','./Coordinate Systems/Shared C++ Code/getENUAxesCPP.cpp',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/starCat2Obs.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./Coordinate Systems/Relativity/Shared C Code/','-I./','./Astronomical Code/aberrCorr.c','./Coordinate Systems/Relativity/Shared C Code/relVecAddC.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/lightDeflectCorr.c',linkCommands{:})
 
@@ -205,24 +218,24 @@ mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Atmospheric Models/simpAstroRefParam.c',linkCommands{:})
 
 %%Compile the coordinate transforms that use the SOFA code.
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/GCRS2ITRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/ITRS2GCRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/GCRS2TIRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/TIRS2GCRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/TEME2ITRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/ITRS2TEME.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/TOD2GCRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/GCRS2TOD.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/GCRS2ITRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/ITRS2GCRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/GCRS2TIRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/TIRS2GCRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/TEME2ITRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/ITRS2TEME.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/TOD2GCRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/GCRS2TOD.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/MOD2GCRS.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/GCRS2MOD.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/J2000F2ICRS.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/ICRS2J2000F.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/TIRS2ITRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/ITRS2TIRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/GCRS2CIRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/CIRS2GCRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/CIRS2TIRS.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/TIRS2CIRS.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','./Astronomical Code/TIRS2ITRS.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','./Astronomical Code/ITRS2TIRS.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/GCRS2CIRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/CIRS2GCRS.cpp','./Astronomical Code/Shared C++ Code/celestialRotationsCPP.cpp','./Astronomical Code/Shared C++ Code/XYsChebCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C++ Code/EOPEpochsMexCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','./Astronomical Code/CIRS2TIRS.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','./Astronomical Code/TIRS2CIRS.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/G2ICRS.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Astronomical Code/ICRS2G.c',linkCommands{:})
 
@@ -237,8 +250,8 @@ mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/TCG2TT.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/TT2TAI.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/TT2TCG.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/TT2GMST.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/TT2GAST.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','./Coordinate Systems/Time/TT2GMST.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','./Coordinate Systems/Time/TT2GAST.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/TAI2UTC.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/BesselEpoch2TDB.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/TDB2BesselEpoch.c',linkCommands{:})
@@ -250,15 +263,19 @@ mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/JulDate2JulEpoch.c',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','./Coordinate Systems/Time/JulEpoch2JulDate.c',linkCommands{:})
 
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TT2UT1.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TAI2UT1.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TT2TCB.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TT2TDB.c',linkCommands{:})
-mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TDB2TT.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TT2UT1.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TAI2UT1.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TT2TCB.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TT2TDB.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Mathematical Functions/Shared C Code/','-I./Coordinate Systems/Time/Shared C Code/','./Coordinate Systems/Time/TDB2TT.c','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C Code/','-I./Coordinate Systems/Time/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Coordinate Systems/Time/convertTimeScale.cpp','./Coordinate Systems/Time/Shared C++ Code/TimeScalesCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp','./Astronomical Code/Shared C Code/EOPTableC.c','./Astronomical Code/Shared C Code/getEOPMexC.c',linkCommands{:})
 
 %%Compile other astronomical code
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./3rd_Party_Code/sofa/src/','./Astronomical Code/approxSolarSysVec.c',linkCommands{:})
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./','-I./3rd_Party_Code/sofa/src/','-I./Astronomical Code/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/solarSysEphemCacheCPPInt.cpp','./Astronomical Code/Shared C++ Code/SolarSysEphemCacheCPP.cpp','./Mathematical Functions/Shared C++ Code/ChebTimeCacheCPP.cpp',linkCommands{:})
 mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/SGP4/cpp/','-I./','./Astronomical Code/propagateOrbitSGP4.cpp','./3rd_Party_Code/SGP4/cpp/sgp4unit.cpp')
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/SGP4/cpp/','-I./','-I./Astronomical Code/Shared C++ Code/','-I./Misc/Shared C++ Code/','-I./Container Classes/Shared C++ Code/','-I./Mathematical Functions/Shared C++ Code/','./Astronomical Code/SGP4CatalogCPPInt.cpp','./Astronomical Code/Shared C++ Code/SGP4CatalogCPP.cpp','./Astronomical Code/Shared C++ Code/SGP4LanesCPP.cpp','./Astronomical Code/Shared C++ Code/SGP4ConjunctionsCPP.cpp','./Container Classes/Shared C++ Code/kdTreeCPP.cpp','./Mathematical Functions/Shared C++ Code/findFirstMaxCPP.cpp','./3rd_Party_Code/SGP4/cpp/sgp4unit.cpp')
+mex('-v','-largeArrayDims','-U__STDC_UTF_16__','-outdir','./0_Compiled_Code/','-I./3rd_Party_Code/sofa/src/','-I./','-I./Astronomical Code/Shared C++ Code/','-I./Misc/Shared C++ Code/','./Astronomical Code/TLEFile2SGP4OrbEls.cpp','./Astronomical Code/Shared C++ Code/TLEFileCPP.cpp','./Misc/Shared C++ Code/MappedFileCPP.cpp',linkCommands{:})
 
 %%Compile the MICE code for ephemerides.
 cd ./3rd_Party_Code/mice
@@ -322,7 +322,7 @@ void kdTreeCPP::rangeQuery(ClusterSetCPP<size_t> &rangeClust,const double *rectM
     for(i=0;i<numRanges;i++) {
         size_t numFound=0;
         
-        this->rangeQueryRecur(0,rectMin+i*k,rectMax+i*k,rangeClust[i],numFound,clusterSizes[i]);
+        this->rangeQueryRecur(0,rectMin+i*k,rectMax+i*k,rangeClust[i],numFound,rangeClust.clusterSizes[i]);
     }
 }
 
@@ -0,0 +1,443 @@
+/**TIMESCALESCPP Classes for converting two-part Julian dates between time
+ *              scales with cached leap seconds, natively interpolated
+ *              Earth orientation parameters and optional Chebyshev fits of
+ *              the costly series. See TimeScalesCPP.hpp for details.
+ *
+ *The conversions between UTC and TAI use the computations of the functions
+ *iauUtctai and iauTaiutc of the International Astronomical Union's
+ *Standards of Fundamental Astronomy (SOFA) library, except that TAI-UTC
+ *comes from a table filled from iauDat rather than from iauDat itself.
+ *They do not constitute software provided by or endorsed by SOFA.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <math.h>
+#include <ctype.h>
+#include <algorithm>
+#include "TimeScalesCPP.hpp"
+/*This header is for the SOFA library.*/
+#include "sofa.h"
+
+static void combineStatus(int &status, const int newStatus);
+
+int timeScaleFromString(const char *scaleName) {
+    static const char *names[]={"UTC","TAI","TT","TDB","TCB","TCG","UT1","GMST","GAST"};
+    static const int scales[]={TIME_SCALE_UTC,TIME_SCALE_TAI,TIME_SCALE_TT,TIME_SCALE_TDB,TIME_SCALE_TCB,TIME_SCALE_TCG,TIME_SCALE_UT1,TIME_SCALE_GMST,TIME_SCALE_GAST};
+    size_t curName;
+
+    for(curName=0;curName<sizeof(scales)/sizeof(scales[0]);curName++) {
+        const char *name=names[curName];
+        size_t i=0;
+
+        while(name[i]!='\0'&&toupper(static_cast<unsigned char>(scaleName[i]))==name[i]) {
+            i++;
+        }
+        if(name[i]=='\0'&&scaleName[i]=='\0') {
+            return scales[curName];
+        }
+    }
+    return -1;
+}
+
+LeapSecondTableCPP::LeapSecondTableCPP() {
+    double djm0;
+    int year, month;
+
+    iauCal2jd(1972,1,1,&djm0,&firstMJD);
+    dubiousMJD=HUGE_VAL;
+
+    //TAI-UTC only changes at the start of a month from 1972 on, so the
+    //months are scanned until iauDat flags the year as dubious.
+    for(year=1972;year<10000;year++) {
+        for(month=1;month<=12;month++) {
+            double MJD, dAT;
+            const int retVal=iauDat(year,month,1,0.0,&dAT);
+
+            iauCal2jd(year,month,1,&djm0,&MJD);
+            if(retVal!=0) {
+                dubiousMJD=MJD;
+                return;
+            }
+
+            if(TAIMinusUTC.empty()||dAT!=TAIMinusUTC.back()) {
+                changeMJD.push_back(MJD);
+                TAIMinusUTC.push_back(dAT);
+            }
+        }
+    }
+}
+
+int LeapSecondTableCPP::getTAIMinusUTC(const double MJD, double &dAT) const {
+    //The last change on or before the date.
+    const size_t idx=static_cast<size_t>(std::upper_bound(changeMJD.begin(),changeMJD.end(),MJD)-changeMJD.begin());
+
+    dAT=TAIMinusUTC[idx>0?idx-1:0];
+    return MJD>=dubiousMJD;
+}
+
+int LeapSecondTableCPP::getTAIMinusUTCAtDate(const double UTC1, const double UTC2, double &dAT) const {
+    double fd, djm0, MJD;
+    int iy, im, id;
+
+    if(iauJd2cal(UTC1,UTC2,&iy,&im,&id,&fd)) {
+        return -1;
+    }
+    iauCal2jd(iy,im,id,&djm0,&MJD);
+    if(MJD<firstMJD) {
+        return iauDat(iy,im,id,fd,&dAT);
+    }
+    return getTAIMinusUTC(MJD,dAT);
+}
+
+int LeapSecondTableCPP::UTC2TAI(const double UTC1, const double UTC2, double &TAI1, double &TAI2) const {
+    const double daySec=86400.0;
+    const bool big1=(UTC1>=UTC2);
+    const double u1=big1?UTC1:UTC2;
+    const double u2=big1?UTC2:UTC1;
+    double fd, z1, z2, dat0, dat24, a2;
+    int iy, im, id, retVal;
+
+    //The calendar day of the date.
+    retVal=iauJd2cal(u1,u2,&iy,&im,&id,&fd);
+    if(retVal) {
+        return retVal;
+    }
+    if(iauCal2jd(iy,im,id,&z1,&z2)) {
+        return -1;
+    }
+
+    //TAI-UTC drifted within each day before 1972.
+    if(z2<firstMJD) {
+        return iauUtctai(UTC1,UTC2,&TAI1,&TAI2);
+    }
+
+    //TAI-UTC at the start of today and of tomorrow. There is no drift, so
+    //any change is a leap second at the end of today.
+    getTAIMinusUTC(z2,dat0);
+    retVal=getTAIMinusUTC(z2+1.0,dat24);
+
+    //Spread the leap second over the day, as in iauUtctai.
+    fd*=(daySec+(dat24-dat0))/daySec;
+
+    //Assemble the TAI result, preserving the UTC split and order.
+    a2=z1-u1;
+    a2+=z2;
+    a2+=fd+dat0/daySec;
+    if(big1) {
+        TAI1=u1;
+        TAI2=a2;
+    } else {
+        TAI1=a2;
+        TAI2=u1;
+    }
+    return retVal;
+}
+
+int LeapSecondTableCPP::TAI2UTC(const double TAI1, const double TAI2, double &UTC1, double &UTC2) const {
+    const bool big1=(TAI1>=TAI2);
+    const double a1=big1?TAI1:TAI2;
+    const double a2=big1?TAI2:TAI1;
+    double u1=a1;
+    double u2=a2;
+    int curIter, retVal=0;
+
+    //Iterate on the inverse conversion, as in iauTaiutc.
+    for(curIter=0;curIter<3;curIter++) {
+        double g1, g2;
+
+        retVal=UTC2TAI(u1,u2,g1,g2);
+        if(retVal<0) {
+            return retVal;
+        }
+        u2+=a1-g1;
+        u2+=a2-g2;
+    }
+
+    if(big1) {
+        UTC1=u1;
+        UTC2=u2;
+    } else {
+        UTC1=u2;
+        UTC2=u1;
+    }
+    return retVal;
+}
+
+void TDBMinusTTFuncCPP::operator()(const double JD1, const double JD2, double *vals) const {
+    //With a clock at the geocenter, UT1 does not matter.
+    vals[0]=iauDtdb(JD1,JD2,0.0,0.0,0.0,0.0);
+}
+
+void EquationOfOriginsFuncCPP::operator()(const double JD1, const double JD2, double *vals) const {
+    double rnpb[3][3], x, y, s;
+
+    //The same steps as in iauGst06a and iauGst06.
+    iauPnm06a(JD1,JD2,rnpb);
+    iauBpn2xy(rnpb,&x,&y);
+    s=iauS06(JD1,JD2,x,y);
+    vals[0]=iauEors(rnpb,s);
+}
+
+TimeScaleConverterCPP::TimeScaleConverterCPP(const LeapSecondTableCPP *theLeapSecs, const EOPTableC *theEOPTable) {
+    leapSecs=theLeapSecs;
+    EOPTable=theEOPTable;
+    TDBCache=NULL;
+    EOCache=NULL;
+    useClockLoc=false;
+    elon=0;
+    u=0;
+    v=0;
+}
+
+int TimeScaleConverterCPP::convert(const int fromScale, const int toScale, const double Jul1, const double Jul2, const double *deltaTTUT1, double &out1, double &out2) const {
+    double TT1, TT2, temp1, temp2;
+    int status=0;
+
+    out1=NAN;
+    out2=NAN;
+
+    if(fromScale==toScale&&fromScale!=TIME_SCALE_GMST&&fromScale!=TIME_SCALE_GAST) {
+        out1=Jul1;
+        out2=Jul2;
+        return 0;
+    }
+
+    //Convert to TT.
+    switch(fromScale) {
+        case TIME_SCALE_UTC:
+            combineStatus(status,leapSecs->UTC2TAI(Jul1,Jul2,temp1,temp2));
+            if(status<0) {
+                return status;
+            }
+            iauTaitt(temp1,temp2,&TT1,&TT2);
+            break;
+        case TIME_SCALE_TAI:
+            iauTaitt(Jul1,Jul2,&TT1,&TT2);
+            break;
+        case TIME_SCALE_TT:
+            TT1=Jul1;
+            TT2=Jul2;
+            break;
+        case TIME_SCALE_TDB:
+            combineStatus(status,TDB2TT(Jul1,Jul2,deltaTTUT1,TT1,TT2));
+            break;
+        case TIME_SCALE_TCB:
+            iauTcbtdb(Jul1,Jul2,&temp1,&temp2);
+            combineStatus(status,TDB2TT(temp1,temp2,deltaTTUT1,TT1,TT2));
+            break;
+        case TIME_SCALE_TCG:
+            iauTcgtt(Jul1,Jul2,&TT1,&TT2);
+            break;
+        case TIME_SCALE_UT1:
+            combineStatus(status,UT12TT(Jul1,Jul2,deltaTTUT1,TT1,TT2));
+            break;
+        default:
+            return -1;
+    }
+    if(status<0) {
+        return status;
+    }
+
+    //Convert from TT.
+    switch(toScale) {
+        case TIME_SCALE_UTC:
+            iauTttai(TT1,TT2,&temp1,&temp2);
+            combineStatus(status,leapSecs->TAI2UTC(temp1,temp2,out1,out2));
+            break;
+        case TIME_SCALE_TAI:
+            iauTttai(TT1,TT2,&out1,&out2);
+            break;
+        case TIME_SCALE_TT:
+            out1=TT1;
+            out2=TT2;
+            break;
+        case TIME_SCALE_TDB:
+            combineStatus(status,TT2TDB(TT1,TT2,deltaTTUT1,out1,out2));
+            break;
+        case TIME_SCALE_TCB:
+            combineStatus(status,TT2TDB(TT1,TT2,deltaTTUT1,temp1,temp2));
+            iauTdbtcb(temp1,temp2,&out1,&out2);
+            break;
+        case TIME_SCALE_TCG:
+            iauTttcg(TT1,TT2,&out1,&out2);
+            break;
+        case TIME_SCALE_UT1:
+            combineStatus(status,TT2UT1(TT1,TT2,deltaTTUT1,out1,out2));
+            break;
+        case TIME_SCALE_GMST:
+            combineStatus(status,TT2UT1(TT1,TT2,deltaTTUT1,temp1,temp2));
+            out1=iauGmst06(temp1,temp2,TT1,TT2);
+            out2=0;
+            break;
+        case TIME_SCALE_GAST:
+        {
+            double EO;
+
+            combineStatus(status,TT2UT1(TT1,TT2,deltaTTUT1,temp1,temp2));
+            if(EOCache==NULL||!EOCache->eval(TT1,TT2,&EO)) {
+                EquationOfOriginsFuncCPP()(TT1,TT2,&EO);
+            }
+            out1=iauAnp(iauEra00(temp1,temp2)-EO);
+            out2=0;
+            break;
+        }
+        default:
+            return -1;
+    }
+
+    if(status<0) {
+        out1=NAN;
+        out2=NAN;
+    }
+    return status;
+}
+
+int TimeScaleConverterCPP::deltaTTUT1AtTT(const double TT1, const double TT2, double &deltaT) const {
+    double TAI1, TAI2, UTC1, UTC2, deltaUTCUT1, dAT;
+    int status=0;
+
+    //UT1-UTC is tabulated in UTC.
+    iauTttai(TT1,TT2,&TAI1,&TAI2);
+    combineStatus(status,leapSecs->TAI2UTC(TAI1,TAI2,UTC1,UTC2));
+    if(status<0) {
+        return status;
+    }
+    interpEOPTableC(EOPTable,UTC1,UTC2,NULL,NULL,&deltaUTCUT1,NULL,NULL);
+    combineStatus(status,leapSecs->getTAIMinusUTCAtDate(UTC1,UTC2,dAT));
+
+    //The 32.184 is the offset of TT from TAI.
+    deltaT=32.184+dAT+deltaUTCUT1;
+    return status;
+}
+
+int TimeScaleConverterCPP::TT2UT1(const double TT1, const double TT2, const double *deltaTTUT1, double &UT11, double &UT12) const {
+    double deltaT;
+    int status=0;
+
+    if(deltaTTUT1!=NULL) {
+        deltaT=*deltaTTUT1;
+    } else {
+        status=deltaTTUT1AtTT(TT1,TT2,deltaT);
+        if(status<0) {
+            return status;
+        }
+    }
+    combineStatus(status,iauTtut1(TT1,TT2,deltaT,&UT11,&UT12));
+    return status;
+}
+
+int TimeScaleConverterCPP::UT12TT(const double UT11, const double UT12, const double *deltaTTUT1, double &TT1, double &TT2) const {
+    int curIter, status=0;
+
+    if(deltaTTUT1!=NULL) {
+        iauUt1tt(UT11,UT12,*deltaTTUT1,&TT1,&TT2);
+        return 0;
+    }
+
+    //TT-UT1 is found at the current estimate of TT, starting from UT1.
+    TT1=UT11;
+    TT2=UT12;
+    for(curIter=0;curIter<2;curIter++) {
+        double deltaT;
+
+        status=deltaTTUT1AtTT(TT1,TT2,deltaT);
+        if(status<0) {
+            return status;
+        }
+        iauUt1tt(UT11,UT12,deltaT,&TT1,&TT2);
+    }
+    return status;
+}
+
+int TimeScaleConverterCPP::dtdb(const double TDB1, const double TDB2, const double TT1, const double TT2, const double *deltaTTUT1, double &deltaT) const {
+    double UT11, UT12, UT1Frac;
+    int status;
+
+    if(!useClockLoc) {
+        if(TDBCache==NULL||!TDBCache->eval(TDB1,TDB2,&deltaT)) {
+            TDBMinusTTFuncCPP()(TDB1,TDB2,&deltaT);
+        }
+        return 0;
+    }
+
+    //The topocentric terms depend on the fraction of the day in UT1.
+    status=TT2UT1(TT1,TT2,deltaTTUT1,UT11,UT12);
+    if(status<0) {
+        return status;
+    }
+    UT1Frac=(UT11-floor(UT11))+(UT12-floor(UT12));
+    UT1Frac=UT1Frac-floor(UT1Frac);
+
+    deltaT=iauDtdb(TDB1,TDB2,UT1Frac,elon,u,v);
+    return status;
+}
+
+int TimeScaleConverterCPP::TT2TDB(const double TT1, const double TT2, const double *deltaTTUT1, double &TDB1, double &TDB2) const {
+    int curIter, status=0;
+
+    /*iauDtdb takes TDB, but only TT is known. As in TT2TDB, TT is used
+     *first and then an extra iteration is done with the estimate of
+     *TDB.*/
+    TDB1=TT1;
+    TDB2=TT2;
+    for(curIter=0;curIter<2;curIter++) {
+        double deltaT;
+
+        status=dtdb(TDB1,TDB2,TT1,TT2,deltaTTUT1,deltaT);
+        if(status<0) {
+            return status;
+        }
+        iauTttdb(TT1,TT2,deltaT,&TDB1,&TDB2);
+    }
+    return status;
+}
+
+int TimeScaleConverterCPP::TDB2TT(const double TDB1, const double TDB2, const double *deltaTTUT1, double &TT1, double &TT2) const {
+    //At the geocenter, TDB-TT only depends on TDB, so one step is enough.
+    //Otherwise, UT1 comes from the estimate of TT, as in TDB2TT.
+    const int numIter=useClockLoc?2:1;
+    int curIter, status=0;
+
+    TT1=TDB1;
+    TT2=TDB2;
+    for(curIter=0;curIter<numIter;curIter++) {
+        double deltaT;
+
+        status=dtdb(TDB1,TDB2,TT1,TT2,deltaTTUT1,deltaT);
+        if(status<0) {
+            return status;
+        }
+        iauTdbtt(TDB1,TDB2,deltaT,&TT1,&TT2);
+    }
+    return status;
+}
+
+void combineStatus(int &status, const int newStatus) {
+/*COMBINESTATUS Combine the SOFA-style return values of the steps of a
+ *              conversion: An unacceptable date (-1) takes precedence over
+ *              a dubious year (1), which takes precedence over OK (0).*/
+
+    if(newStatus<0) {
+        status=-1;
+    } else if(newStatus>0&&status==0) {
+        status=1;
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,173 @@
+/**TIMESCALESCPP A header file for classes that convert arrays of two-part
+ *              Julian dates between the time scales UTC, TAI, TT, TDB,
+ *              TCB, TCG and UT1 and from them to Greenwich mean and
+ *              apparent sidereal time (GMST and GAST). The conversions are
+ *              the same as those of the SOFA-based functions UTC2TAI,
+ *              TT2TDB, TT2UT1, TT2GAST and the like, but all of the costly
+ *              parts are done once rather than for each date:
+ *              - The leap seconds (TAI-UTC) of the iauDat function in the
+ *                SOFA library are put in a table of the dates on which
+ *                they change when a LeapSecondTableCPP is made and are
+ *                then found with a binary search.
+ *              - UT1-UTC is interpolated from a native table of Earth
+ *                orientation parameters (EOPTableC) without calling back
+ *                into Matlab.
+ *              - TDB-TT at the geocenter and the equation of the origins
+ *                used for GAST, which sum hundreds and thousands of terms
+ *                of periodic series, can be taken from piecewise
+ *                Chebyshev fits (ChebTimeCacheCPP) over the span of the
+ *                dates.
+ *
+ *All conversions go through TT. The conversions between UTC and TAI are
+ *the same as those of iauUtctai and iauTaiutc, so a UTC day with a leap
+ *second is 86401 SI seconds long. Before 1972, iauUtctai is called, since
+ *TAI-UTC drifted within each day then. As in TT2UT1, TT-UT1 is found from
+ *UT1-UTC at the date in UTC and the leap seconds. As in TT2TDB and TDB2TT,
+ *TDB-TT is from iauDtdb with a clock at the center of the Earth unless a
+ *clock location is given, in which case the Chebyshev fits are not used,
+ *because iauDtdb then also depends on UT1. GMST and GAST are those of the
+ *IAU 2006 models (iauGmst06 and iauGst06a).
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef TIMESCALESCPP
+#define TIMESCALESCPP
+
+#include <stddef.h>
+#include <vector>
+#include "ChebTimeCacheCPP.hpp"
+/*This header is for the native table of Earth orientation parameters.*/
+#include "EOPTableC.h"
+
+//The time scales. GMST and GAST can only be converted to.
+#define TIME_SCALE_UTC 0
+#define TIME_SCALE_TAI 1
+#define TIME_SCALE_TT 2
+#define TIME_SCALE_TDB 3
+#define TIME_SCALE_TCB 4
+#define TIME_SCALE_TCG 5
+#define TIME_SCALE_UT1 6
+#define TIME_SCALE_GMST 7
+#define TIME_SCALE_GAST 8
+
+/*The default parameters of the Chebyshev fits of TDB-TT (seconds) and of
+ *the equation of the origins (radians).*/
+#define TIME_CACHE_DEFAULT_DEGREE 16
+#define TIME_CACHE_DEFAULT_SEG_LENGTH 8.0
+#define TIME_CACHE_MIN_SEG_LENGTH (1.0/64.0)
+#define TDB_CACHE_DEFAULT_TOL 1e-14
+#define EO_CACHE_DEFAULT_TOL 1e-14
+
+int timeScaleFromString(const char *scaleName);
+/*Get the TIME_SCALE_ value of a name such as "UTC" or "TDB". The case of
+ *the name does not matter. The return value is -1 if the name is not
+ *recognized.*/
+
+class LeapSecondTableCPP {
+public:
+    //The modified Julian dates in UTC of 1972 January 1, before which
+    //iauDat is used, and of January 1 of the first year that iauDat
+    //considers too far in the future to be trusted.
+    double firstMJD;
+    double dubiousMJD;
+    //The modified Julian dates in UTC on which TAI-UTC changes and the
+    //values of TAI-UTC in seconds from those dates on.
+    std::vector<double> changeMJD;
+    std::vector<double> TAIMinusUTC;
+
+    LeapSecondTableCPP();
+    /*Fill the table from the iauDat function of the SOFA library.*/
+
+    int getTAIMinusUTC(const double MJD, double &dAT) const;
+    /*Get TAI-UTC in seconds at the start of the day with the modified
+     *Julian date MJD in UTC, which must be an integer and must be at least
+     *firstMJD. The return value is 1 if the date is too far in the future
+     *to be trusted and 0 otherwise.*/
+
+    int UTC2TAI(const double UTC1, const double UTC2, double &TAI1, double &TAI2) const;
+    int TAI2UTC(const double TAI1, const double TAI2, double &UTC1, double &UTC2) const;
+    /*Convert two-part (quasi-)Julian dates between UTC and TAI with the
+     *same results and return values as iauUtctai and iauTaiutc: 0 is OK,
+     *1 means a dubious year and -1 an unacceptable date.*/
+
+    int getTAIMinusUTCAtDate(const double UTC1, const double UTC2, double &dAT) const;
+    /*Get TAI-UTC in seconds at the two-part quasi-Julian date UTC1+UTC2
+     *in UTC. The return value is the same as that of iauDat.*/
+};
+
+/*The TDBMinusTTFuncCPP class evaluates TDB-TT in seconds at the center of
+ *the Earth using iauDtdb for the ChebTimeCacheCPP class. The date is in
+ *TDB, but TT can be used, as in iauDtdb.*/
+class TDBMinusTTFuncCPP: public ChebTimeFuncCPP {
+public:
+    void operator()(const double JD1, const double JD2, double *vals) const;
+};
+
+/*The EquationOfOriginsFuncCPP class evaluates the equation of the origins
+ *in radians of the IAU 2006/2000A precession-nutation model at a date in
+ *TT the same way that iauGst06a does for the ChebTimeCacheCPP class.*/
+class EquationOfOriginsFuncCPP: public ChebTimeFuncCPP {
+public:
+    void operator()(const double JD1, const double JD2, double *vals) const;
+};
+
+class TimeScaleConverterCPP {
+public:
+    const LeapSecondTableCPP *leapSecs;
+    /*The table of Earth orientation parameters from which UT1-UTC is
+     *interpolated. This is only used if a value of TT-UT1 is not given to
+     *convert.*/
+    const EOPTableC *EOPTable;
+    /*Chebyshev fits of TDBMinusTTFuncCPP and EquationOfOriginsFuncCPP.
+     *Either can be NULL, in which case the SOFA functions are called for
+     *each date. Dates outside of the span of a fit also call the SOFA
+     *functions.*/
+    const ChebTimeCacheCPP *TDBCache;
+    const ChebTimeCacheCPP *EOCache;
+    /*If useClockLoc is true, TDB is for a clock at the east longitude elon
+     *(radians), distance from the Earth's spin axis u (km) and distance
+     *north of the equatorial plane v (km), as in iauDtdb.*/
+    bool useClockLoc;
+    double elon;
+    double u;
+    double v;
+
+    TimeScaleConverterCPP(const LeapSecondTableCPP *theLeapSecs, const EOPTableC *theEOPTable);
+
+    int convert(const int fromScale, const int toScale, const double Jul1, const double Jul2, const double *deltaTTUT1, double &out1, double &out2) const;
+    /*Convert the two-part Julian date Jul1+Jul2 from fromScale to toScale,
+     *which are TIME_SCALE_ values. deltaTTUT1 points to TT-UT1 in seconds
+     *or is NULL if it should be found from the EOP table. For the time
+     *scales, the result is put in out1 and out2 keeping the split of the
+     *input as SOFA does. For GMST and GAST, the angle in radians is put in
+     *out1 and out2 is zero. The return value is 0 if the conversion is OK,
+     *1 if a dubious year was involved and -1 if the date is unacceptable
+     *or the scales are invalid, in which case the outputs are NaN.*/
+private:
+    int TT2UT1(const double TT1, const double TT2, const double *deltaTTUT1, double &UT11, double &UT12) const;
+    int UT12TT(const double UT11, const double UT12, const double *deltaTTUT1, double &TT1, double &TT2) const;
+    int TT2TDB(const double TT1, const double TT2, const double *deltaTTUT1, double &TDB1, double &TDB2) const;
+    int TDB2TT(const double TDB1, const double TDB2, const double *deltaTTUT1, double &TT1, double &TT2) const;
+    int deltaTTUT1AtTT(const double TT1, const double TT2, double &deltaT) const;
+    int dtdb(const double TDB1, const double TDB2, const double TT1, const double TT2, const double *deltaTTUT1, double &deltaT) const;
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -30,6 +30,8 @@
 /*This header is for the SOFA library.*/
 #include "sofa.h"
 #include "MexValidation.h"
+/*This header is for the native table of Earth orientation parameters.*/
+#include "EOPTableC.h"
 //Needed for isnan
 #include <math.h>
 
@@ -54,8 +56,6 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
     if(nrhs>2) {
         deltaT=getDoubleFromMatlab(prhs[2]);
     } else {
-        mxArray *retVals[4];
-        mxArray *JulUTCMATLAB[2];
         double JulUTC[2];
         
         //Get the time in UTC to look up the parameters.
@@ -71,20 +71,10 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
                 break;
         }
         
-        JulUTCMATLAB[0]=doubleMat2Matlab(&JulUTC[0],1,1);
-        JulUTCMATLAB[1]=doubleMat2Matlab(&JulUTC[1],1,1);
-        
         //Get the Earth orientation parameters for the given date.
-        mexCallMATLAB(4,retVals,2,JulUTCMATLAB,"getEOP");
+        getEOPMexC(JulUTC[0],JulUTC[1],NULL,NULL,NULL,&deltaT,NULL);
         //The 32.184 is the offset between TT and TAI.
-        deltaT=getDoubleFromMatlab(retVals[3])-32.184;
-        //Free the returned arrays.
-        mxDestroyArray(retVals[0]);
-        mxDestroyArray(retVals[1]);
-        mxDestroyArray(retVals[2]);
-        mxDestroyArray(retVals[3]);
-        mxDestroyArray(JulUTCMATLAB[0]);
-        mxDestroyArray(JulUTCMATLAB[1]);
+        deltaT-=32.184;
     }
  
     //Perform the conversion.
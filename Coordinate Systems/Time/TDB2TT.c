@@ -52,6 +52,8 @@
 /*This header is for the SOFA library.*/
 #include "sofa.h"
 #include "MexValidation.h"
+/*This header is for the native table of Earth orientation parameters.*/
+#include "EOPTableC.h"
 
 //Function prototype
 double getDeltaTFromEOP(double TT1,double TT2);
@@ -153,12 +155,11 @@ void mexFunction(int nlhs, mxArray *plhs[], int nrhs, const mxArray *prhs[]) {
 
 double getDeltaTFromEOP(double TT1,double TT2) {
 /**GETDELTATFROMEOP Get the deltaTTUT1 parameter given a time in
- *                  terrestrial time using the function getEOP. This will
- *                  call Matlab errors if parameter problems arise.
+ *                  terrestrial time using the same Earth orientation
+ *                  parameters as the function getEOP. This will call
+ *                  Matlab errors if parameter problems arise.
  */
     
-    mxArray *retVals[4];
-    mxArray *JulUTCMATLAB[2];
     double deltaT, JulUTC[2];
     int retVal;
 
@@ -180,20 +181,8 @@ double getDeltaTFromEOP(double TT1,double TT2) {
         break;
     }
 
-    JulUTCMATLAB[0]=doubleMat2Matlab(&JulUTC[0],1,1);
-    JulUTCMATLAB[1]=doubleMat2Matlab(&JulUTC[1],1,1);
-
     //Get the Earth orientation parameters for the given date.
-    mexCallMATLAB(4,retVals,2,JulUTCMATLAB,"getEOP");
-    //This is TT-UT1
-    deltaT=getDoubleFromMatlab(retVals[3]);
-    //Free the returned arrays.
-    mxDestroyArray(retVals[0]);
-    mxDestroyArray(retVals[1]);
-    mxDestroyArray(retVals[2]);
-    mxDestroyArray(retVals[3]);
-    mxDestroyArray(JulUTCMATLAB[0]);
-    mxDestroyArray(JulUTCMATLAB[1]);
+    getEOPMexC(JulUTC[0],JulUTC[1],NULL,NULL,NULL,&deltaT,NULL);
     
     return deltaT;
 }
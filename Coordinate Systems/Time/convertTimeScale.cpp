@@ -0,0 +1,378 @@
+/**CONVERTTIMESCALE Convert an array of two-part Julian dates from one time
+ *                scale to another or to Greenwich mean or apparent
+ *                sidereal time in a single call. The supported scales are
+ *                universal coordinated time (UTC), international atomic
+ *                time (TAI), terrestrial time (TT), barycentric dynamical
+ *                time (TDB), barycentric coordinate time (TCB),
+ *                geocentric coordinate time (TCG) and UT1. The results
+ *                are the same as those of chaining the functions such as
+ *                UTC2TAI, TAI2TT, TT2TDB, TT2UT1 and TT2GAST, but those
+ *                take one date at a time (or call the SOFA library with
+ *                per-date lookups), whereas here the leap seconds are
+ *                kept in a table, the Earth orientation parameters are
+ *                interpolated natively, the costly series are fit once
+ *                over the span of the dates and the dates are split over
+ *                multiple threads, so millions of dates are converted in
+ *                a fraction of a second.
+ *
+ *INPUTS: Jul1, Jul2 Matrices of the two parts of the Julian dates in the
+ *                  scale fromScale. The units of the dates are days. The
+ *                  full dates are the sums of the terms. If fromScale is
+ *                  UTC, the dates are pseudo-Julian as in UTC2TAI. The
+ *                  matrices must have the same number of elements or one
+ *                  of them can be a scalar, which is used with all of the
+ *                  elements of the other.
+ *        fromScale A character string giving the time scale of the input
+ *                  dates. Possible values are 'UTC', 'TAI', 'TT', 'TDB',
+ *                  'TCB', 'TCG' and 'UT1'. Case does not matter.
+ *          toScale A character string giving the time scale of the output
+ *                  dates. This can be any of the values of fromScale or
+ *                  'GMST' or 'GAST' to get the Greenwich mean or apparent
+ *                  sidereal time in radians according to the IAU 2006
+ *                  models, as with the default version of TT2GMST and
+ *                  TT2GAST.
+ *       deltaTTUT1 An optional parameter specifying the offset between TT
+ *                  and UT1 in seconds. This is only used for conversions
+ *                  involving UT1, GMST or GAST or involving TDB or TCB
+ *                  when clockLoc is given. It can be a scalar or have one
+ *                  element per date. If this parameter is omitted or an
+ *                  empty matrix is passed, then the values that the
+ *                  function getEOP would give are used.
+ *         clockLoc An optional 3X1 vector specifying the location of the
+ *                  clock in the Terrestrial Intermediate Reference System
+ *                  (TIRS) in meters, as in TT2TDB, for conversions
+ *                  involving TDB and TCB. If this parameter is omitted or
+ *                  an empty matrix is passed, a clock at the center of
+ *                  the Earth is used.
+ *       numThreads An optional parameter specifying the maximum number of
+ *                  threads to use. If omitted or an empty matrix is
+ *                  passed, the number of hardware threads is used.
+ *
+ *OUTPUTS: Jul1, Jul2 The dates in the scale toScale with the same
+ *                  dimensions as the inputs. If toScale is 'GMST' or
+ *                  'GAST', Jul1 holds the angles in radians and Jul2 is
+ *                  all zeros. Dates for which the conversion is not
+ *                  possible, such as UTC dates before 1960, are NaN and a
+ *                  warning is issued.
+ *
+ *All conversions go through TT. As in TT2UT1, TT-UT1 comes from UT1-UTC
+ *interpolated from the same table as getEOP at the date in UTC and the
+ *leap seconds of the SOFA library. A warning is issued if any of the
+ *dates is too far in the future for the leap seconds to be trusted.
+ *
+ *With a clock at the center of the Earth, TDB-TT from iauDtdb and the
+ *equation of the origins used for GAST are fit by piecewise Chebyshev
+ *polynomials over the span of the dates if that takes fewer evaluations
+ *than the dates themselves would. The fits agree with the SOFA functions
+ *to about 1e-14 seconds and radians. Each fit stays in memory until the
+ *mex file is cleared, so later calls with dates in the same days reuse
+ *it.
+ *
+ *The algorithm can be compiled for use in Matlab  using the
+ *CompileCLibraries function.
+ *
+ *The algorithm is run in Matlab using the command format
+ *[Jul1,Jul2]=convertTimeScale(Jul1,Jul2,fromScale,toScale);
+ *or
+ *[Jul1,Jul2]=convertTimeScale(Jul1,Jul2,fromScale,toScale,deltaTTUT1,clockLoc,numThreads);
+ *
+ *EXAMPLE:
+ *A day of UTC times one second apart is converted to TDB and the Greenwich
+ *apparent sidereal time is found for each.
+ * [UTC1,UTC2]=Cal2UTC(2015,7,1,0,0,0);
+ * UTC2=UTC2+(0:86399)'/86400;
+ * [TDB1,TDB2]=convertTimeScale(UTC1,UTC2,'UTC','TDB');
+ * GAST=convertTimeScale(UTC1,UTC2,'UTC','GAST');
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <math.h>
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "TimeScalesCPP.hpp"
+//For parallelForCPP
+#include "parallelForCPP.hpp"
+
+//The leap seconds and the fits of this mex file, which stay in memory
+//until the mex file is cleared.
+static LeapSecondTableCPP leapSecTableMex;
+static ChebTimeCacheCPP TDBCacheMex;
+static ChebTimeCacheCPP EOCacheMex;
+
+static const ChebTimeCacheCPP *getCacheMex(ChebTimeCacheCPP &cache, const ChebTimeFuncCPP &func, const double tol, const double *Jul1, const size_t Jul1Stride, const double *Jul2, const size_t Jul2Stride, const size_t numDates, const size_t numThreads);
+
+/*The ConvertChunk class is used with parallelForCPP to convert contiguous
+ *chunks of the dates in separate threads. Each thread records whether it
+ *saw any dubious or unacceptable dates.*/
+class ConvertChunk {
+public:
+    const TimeScaleConverterCPP *converter;
+    int fromScale;
+    int toScale;
+    const double *Jul1;
+    size_t Jul1Stride;
+    const double *Jul2;
+    size_t Jul2Stride;
+    //NULL if the values are to be looked up.
+    const double *deltaTTUT1;
+    size_t deltaTStride;
+    double *out1;
+    double *out2;
+    int *threadHadDubious;
+    int *threadHadBad;
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        int hadDubious=0;
+        int hadBad=0;
+        size_t curDate;
+
+        for(curDate=startItem;curDate<endItem;curDate++) {
+            const double *curDeltaT=(deltaTTUT1==NULL)?NULL:deltaTTUT1+deltaTStride*curDate;
+            const int retVal=converter->convert(fromScale,toScale,Jul1[Jul1Stride*curDate],Jul2[Jul2Stride*curDate],curDeltaT,out1[curDate],out2[curDate]);
+
+            if(retVal<0) {
+                hadBad=1;
+            } else if(retVal>0) {
+                hadDubious=1;
+            }
+        }
+
+        threadHadDubious[threadIdx]=hadDubious;
+        threadHadBad[threadIdx]=hadBad;
+    }
+};
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t numDates, numRow, numCol, numThreads=0, numThreadsUsed, i;
+    size_t Jul1Stride, Jul2Stride, deltaTStride=0;
+    const double *deltaTTUT1=NULL;
+    int fromScale, toScale;
+    bool needUT1, needTDB;
+    char *scaleName;
+    mxArray *out1MATLAB, *out2MATLAB;
+    TimeScaleConverterCPP converter(&leapSecTableMex,NULL);
+    ConvertChunk converterChunk;
+
+    if(nrhs<4||nrhs>7) {
+        mexErrMsgTxt("Wrong number of inputs.");
+        return;
+    }
+
+    if(nlhs>2) {
+        mexErrMsgTxt("Wrong number of outputs.");
+        return;
+    }
+
+    checkRealDoubleArray(prhs[0]);
+    checkRealDoubleArray(prhs[1]);
+    {
+        const size_t numEls1=mxGetNumberOfElements(prhs[0]);
+        const size_t numEls2=mxGetNumberOfElements(prhs[1]);
+
+        if(numEls1==0||numEls2==0||(numEls1!=numEls2&&numEls1!=1&&numEls2!=1)) {
+            mexErrMsgTxt("The dimensionalities of the inputs are incorrect.");
+            return;
+        }
+
+        //The output has the dimensions of the input that is not a scalar.
+        if(numEls1>=numEls2) {
+            numRow=mxGetM(prhs[0]);
+            numCol=mxGetN(prhs[0]);
+        } else {
+            numRow=mxGetM(prhs[1]);
+            numCol=mxGetN(prhs[1]);
+        }
+        numDates=numRow*numCol;
+        Jul1Stride=(numEls1==1)?0:1;
+        Jul2Stride=(numEls2==1)?0:1;
+    }
+
+    if(!mxIsChar(prhs[2])||!mxIsChar(prhs[3])) {
+        mexErrMsgTxt("The time scales must be given as character strings.");
+        return;
+    }
+    scaleName=mxArrayToString(prhs[2]);
+    fromScale=timeScaleFromString(scaleName);
+    mxFree(scaleName);
+    scaleName=mxArrayToString(prhs[3]);
+    toScale=timeScaleFromString(scaleName);
+    mxFree(scaleName);
+    if(fromScale<0||toScale<0) {
+        mexErrMsgTxt("Unknown time scale given.");
+        return;
+    }
+    if(fromScale==TIME_SCALE_GMST||fromScale==TIME_SCALE_GAST) {
+        mexErrMsgTxt("Sidereal times can not be converted to other time scales.");
+        return;
+    }
+
+    if(nrhs>4&&!mxIsEmpty(prhs[4])) {
+        const size_t numDeltaT=mxGetNumberOfElements(prhs[4]);
+
+        checkRealDoubleArray(prhs[4]);
+        if(numDeltaT!=1&&numDeltaT!=numDates) {
+            mexErrMsgTxt("deltaTTUT1 must be a scalar or have one element per date.");
+            return;
+        }
+        deltaTTUT1=reinterpret_cast<const double*>(mxGetData(prhs[4]));
+        deltaTStride=(numDeltaT==1)?0:1;
+    }
+
+    if(nrhs>5&&!mxIsEmpty(prhs[5])) {
+        const double *xyzClock;
+
+        if(mxGetM(prhs[5])!=3||mxGetN(prhs[5])!=1) {
+            mexErrMsgTxt("The dimensionality of the clock location is incorrect.");
+            return;
+        }
+        checkRealDoubleArray(prhs[5]);
+        xyzClock=reinterpret_cast<const double*>(mxGetData(prhs[5]));
+
+        //Convert from meters to kilometers.
+        converter.useClockLoc=true;
+        converter.u=sqrt(xyzClock[0]*xyzClock[0]+xyzClock[1]*xyzClock[1])/1000.0;
+        converter.v=xyzClock[2]/1000.0;
+        converter.elon=atan2(xyzClock[1],xyzClock[0]);
+    }
+
+    if(nrhs>6&&!mxIsEmpty(prhs[6])) {
+        numThreads=getSizeTFromMatlab(prhs[6]);
+    }
+
+    needTDB=(fromScale==TIME_SCALE_TDB||fromScale==TIME_SCALE_TCB||toScale==TIME_SCALE_TDB||toScale==TIME_SCALE_TCB)&&fromScale!=toScale;
+    needUT1=fromScale==TIME_SCALE_UT1||toScale==TIME_SCALE_UT1||toScale==TIME_SCALE_GMST||toScale==TIME_SCALE_GAST||(needTDB&&converter.useClockLoc);
+    //The table is loaded here, because the threads cannot call Matlab.
+    if(needUT1&&deltaTTUT1==NULL) {
+        converter.EOPTable=getEOPTableMexC();
+    }
+
+    if(needTDB&&!converter.useClockLoc) {
+        converter.TDBCache=getCacheMex(TDBCacheMex,TDBMinusTTFuncCPP(),TDB_CACHE_DEFAULT_TOL,mxGetPr(prhs[0]),Jul1Stride,mxGetPr(prhs[1]),Jul2Stride,numDates,numThreads);
+    }
+    if(toScale==TIME_SCALE_GAST) {
+        converter.EOCache=getCacheMex(EOCacheMex,EquationOfOriginsFuncCPP(),EO_CACHE_DEFAULT_TOL,mxGetPr(prhs[0]),Jul1Stride,mxGetPr(prhs[1]),Jul2Stride,numDates,numThreads);
+    }
+
+    out1MATLAB=mxCreateDoubleMatrix(numRow,numCol,mxREAL);
+    out2MATLAB=mxCreateDoubleMatrix(numRow,numCol,mxREAL);
+
+    numThreadsUsed=numThreads2UseCPP(numThreads,numDates);
+    {
+        std::vector<int> threadHadDubious(numThreadsUsed,0);
+        std::vector<int> threadHadBad(numThreadsUsed,0);
+        bool hadDubious=false;
+        bool hadBad=false;
+
+        converterChunk.converter=&converter;
+        converterChunk.fromScale=fromScale;
+        converterChunk.toScale=toScale;
+        converterChunk.Jul1=mxGetPr(prhs[0]);
+        converterChunk.Jul1Stride=Jul1Stride;
+        converterChunk.Jul2=mxGetPr(prhs[1]);
+        converterChunk.Jul2Stride=Jul2Stride;
+        converterChunk.deltaTTUT1=deltaTTUT1;
+        converterChunk.deltaTStride=deltaTStride;
+        converterChunk.out1=mxGetPr(out1MATLAB);
+        converterChunk.out2=mxGetPr(out2MATLAB);
+        converterChunk.threadHadDubious=threadHadDubious.data();
+        converterChunk.threadHadBad=threadHadBad.data();
+        parallelForCPP(numDates,numThreadsUsed,converterChunk);
+
+        for(i=0;i<numThreadsUsed;i++) {
+            hadDubious=hadDubious||threadHadDubious[i];
+            hadBad=hadBad||threadHadBad[i];
+        }
+
+        //Only warn once for the whole array of dates.
+        if(hadDubious) {
+            mexWarnMsgTxt("Dubious dates entered.");
+        }
+        if(hadBad) {
+            mexWarnMsgTxt("Unacceptable dates entered. NaNs are returned for them.");
+        }
+    }
+
+    plhs[0]=out1MATLAB;
+    if(nlhs>1) {
+        plhs[1]=out2MATLAB;
+    } else {
+        mxDestroyArray(out2MATLAB);
+    }
+}
+
+const ChebTimeCacheCPP *getCacheMex(ChebTimeCacheCPP &cache, const ChebTimeFuncCPP &func, const double tol, const double *Jul1, const size_t Jul1Stride, const double *Jul2, const size_t Jul2Stride, const size_t numDates, const size_t numThreads) {
+/*GETCACHEMEX Get the fit of func to use for the dates or NULL if func
+ *            should be called directly. If cache already covers all of
+ *            the dates, it is returned. Otherwise, it is refit over the
+ *            span of the dates, rounded out to whole days plus one day on
+ *            each side to allow for the differences between the time
+ *            scales, if that takes fewer evaluations of func than the
+ *            dates themselves would.*/
+
+    double JDRef, tMin, tMax;
+    size_t curDate;
+    bool allCovered=true;
+
+    //The dates relative to an integer plus one half.
+    JDRef=floor(Jul1[0]+Jul2[0])+0.5;
+    tMin=(Jul1[0]-JDRef)+Jul2[0];
+    tMax=tMin;
+    for(curDate=0;curDate<numDates;curDate++) {
+        const double J1=Jul1[Jul1Stride*curDate];
+        const double J2=Jul2[Jul2Stride*curDate];
+        const double t=(J1-JDRef)+J2;
+
+        if(t<tMin) {
+            tMin=t;
+        }
+        if(t>tMax) {
+            tMax=t;
+        }
+        if(allCovered&&!cache.covers(J1-1.0,J2)) {
+            allCovered=false;
+        }
+        if(allCovered&&!cache.covers(J1+1.0,J2)) {
+            allCovered=false;
+        }
+    }
+
+    if(allCovered) {
+        return &cache;
+    }
+
+    //Non-finite dates are left to the SOFA functions.
+    if(!(tMax-tMin<HUGE_VAL)) {
+        return NULL;
+    }
+
+    tMin=floor(tMin)-1.0;
+    tMax=ceil(tMax)+1.0;
+    if(ChebTimeCacheCPP::numFitEvals(JDRef,tMin,JDRef,tMax,TIME_CACHE_DEFAULT_DEGREE,TIME_CACHE_DEFAULT_SEG_LENGTH)>=numDates) {
+        return NULL;
+    }
+
+    if(!cache.fit(func,1,JDRef,tMin,JDRef,tMax,tol,TIME_CACHE_DEFAULT_DEGREE,TIME_CACHE_DEFAULT_SEG_LENGTH,TIME_CACHE_MIN_SEG_LENGTH,numThreads)) {
+        return NULL;
+    }
+    return &cache;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,259 @@
+/*GEOIDGRIDCPP C++ implementation of a class that memory maps and
+ *             interpolates a tiled grid of geoid heights and related
+ *             quantities. See geoidGridCPP.hpp for the format of the file.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For memcpy, memcmp and memset
+#include <string.h>
+#include <math.h>
+//For NaN
+#include <limits>
+#include "geoidGridCPP.hpp"
+
+static const char geoidGridMagic[8]={'G','E','O','I','D','G','R','D'};
+static const double pi=3.1415926535897932384626433832795;
+
+static void cubicConvWeights(double *w, const double t);
+
+GeoidGridCPP::GeoidGridCPP() {
+    memset(&header,0,sizeof(header));
+    nodes=NULL;
+    numLat=0;
+    numLon=0;
+    numLayers=0;
+    numLonTiles=0;
+    tileShift=0;
+    invDeltaLat=0;
+    invDeltaLon=0;
+}
+
+GeoidGridCPP::~GeoidGridCPP() {
+    close();
+}
+
+int GeoidGridCPP::open(const char *fileName) {
+    uint64_t fileSize, expectedSize, numLatTiles, numLonTilesFile;
+
+    close();
+
+    switch(file.open(fileName,sizeof(GeoidGridHeaderCPP))) {
+        case MAPPED_FILE_OK:
+            break;
+        case MAPPED_FILE_OPEN_FAILED:
+            return GEOID_GRID_OPEN_FAILED;
+        case MAPPED_FILE_TOO_SMALL:
+            return GEOID_GRID_BAD_HEADER;
+        default:
+            return GEOID_GRID_MAP_FAILED;
+    }
+    fileSize=file.size();
+
+    memcpy(&header,file.data(),sizeof(header));
+    if(memcmp(header.magic,geoidGridMagic,sizeof(geoidGridMagic))!=0||header.version!=GEOID_GRID_VERSION) {
+        close();
+        return GEOID_GRID_BAD_HEADER;
+    }
+    if(header.byteOrder!=GEOID_GRID_BYTE_ORDER) {
+        close();
+        return GEOID_GRID_BAD_BYTE_ORDER;
+    }
+    //The tile size must be a power of 2.
+    if(header.numLat<2||header.numLon<4||header.numLayers<1||header.numLayers>GEOID_GRID_MAX_LAYERS||header.tileSize==0||(header.tileSize&(header.tileSize-1))!=0) {
+        close();
+        return GEOID_GRID_BAD_HEADER;
+    }
+
+    numLatTiles=(header.numLat+header.tileSize-1)/header.tileSize;
+    numLonTilesFile=(header.numLon+header.tileSize-1)/header.tileSize;
+    expectedSize=sizeof(GeoidGridHeaderCPP)+sizeof(float)*numLatTiles*numLonTilesFile*header.tileSize*header.tileSize*header.numLayers;
+    if(fileSize!=expectedSize) {
+        close();
+        return GEOID_GRID_BAD_SIZE;
+    }
+
+    nodes=reinterpret_cast<const float*>(static_cast<const unsigned char*>(file.data())+sizeof(GeoidGridHeaderCPP));
+    numLat=static_cast<size_t>(header.numLat);
+    numLon=static_cast<size_t>(header.numLon);
+    numLayers=header.numLayers;
+    numLonTiles=static_cast<size_t>(numLonTilesFile);
+    tileShift=0;
+    while((static_cast<uint32_t>(1)<<tileShift)<header.tileSize) {
+        tileShift++;
+    }
+    invDeltaLat=static_cast<double>(numLat-1)/pi;
+    invDeltaLon=static_cast<double>(numLon)/(2*pi);
+
+    return GEOID_GRID_OK;
+}
+
+void GeoidGridCPP::interp(double *values, const double *latLon, const size_t numPoints) const {
+    const double maxLatIdx=static_cast<double>(numLat-1);
+    const double NaNVal=std::numeric_limits<double>::quiet_NaN();
+    size_t curPoint;
+
+    for(curPoint=0;curPoint<numPoints;curPoint++) {
+        const double lat=latLon[2*curPoint];
+        const double lon=latLon[2*curPoint+1];
+        double *curValues=values+numLayers*curPoint;
+        double wLat[4], wLon[4], wLonRefl[4], x;
+        size_t cols[4], colsRefl[4], i0, a, b, k;
+
+        //The clipping and the conversions to indices below do not work
+        //with NaNs or infinite values.
+        if(!isfinite(lat)||!isfinite(lon)) {
+            for(k=0;k<numLayers;k++) {
+                curValues[k]=NaNVal;
+            }
+            continue;
+        }
+
+        //The position in units of the grid spacing. Latitudes outside of
+        //+/-pi/2 are clipped.
+        x=(lat+pi/2)*invDeltaLat;
+        if(x<0) {
+            x=0;
+        } else if(x>maxLatIdx) {
+            x=maxLatIdx;
+        }
+        i0=static_cast<size_t>(x);
+        if(i0>numLat-2) {
+            i0=numLat-2;
+        }
+        cubicConvWeights(wLat,x-static_cast<double>(i0));
+
+        //The columns wrap around. The rows beyond the poles are the rows
+        //on the other side of the pole, half way around in longitude.
+        lonNodes(cols,wLon,lon*invDeltaLon);
+        if(i0==0||i0+2>=numLat) {
+            lonNodes(colsRefl,wLonRefl,lon*invDeltaLon+0.5*static_cast<double>(numLon));
+        }
+
+        for(k=0;k<numLayers;k++) {
+            curValues[k]=0;
+        }
+
+        for(a=0;a<4;a++) {
+            double rowSum[GEOID_GRID_MAX_LAYERS]={0,0,0,0};
+            const size_t *rowCols=cols;
+            const double *rowWLon=wLon;
+            bool reflected=false;
+            size_t row=i0+a-1;
+
+            if(a==0&&i0==0) {
+                row=1;
+                reflected=true;
+            } else if(a==3&&i0+2>=numLat) {
+                row=numLat-2;
+                reflected=true;
+            }
+            if(reflected) {
+                rowCols=colsRefl;
+                rowWLon=wLonRefl;
+            }
+
+            for(b=0;b<4;b++) {
+                const float *node=getNode(row,rowCols[b]);
+
+                for(k=0;k<numLayers;k++) {
+                    rowSum[k]+=rowWLon[b]*static_cast<double>(node[k]);
+                }
+            }
+
+            //The North-South and East-West components of the deflection
+            //of the vertical change sign across the pole.
+            if(reflected&&numLayers>2) {
+                rowSum[1]=-rowSum[1];
+                rowSum[2]=-rowSum[2];
+            }
+
+            for(k=0;k<numLayers;k++) {
+                curValues[k]+=wLat[a]*rowSum[k];
+            }
+        }
+    }
+}
+
+void GeoidGridCPP::lonNodes(size_t *cols, double *wLon, double y) const {
+    const double numLonDouble=static_cast<double>(numLon);
+    size_t j0;
+
+    y-=numLonDouble*floor(y/numLonDouble);
+    j0=static_cast<size_t>(y);
+    //Rounding can put y at numLon.
+    if(j0>=numLon) {
+        j0=0;
+        y=0;
+    }
+
+    cubicConvWeights(wLon,y-static_cast<double>(j0));
+    cols[0]=(j0==0)?numLon-1:j0-1;
+    cols[1]=j0;
+    cols[2]=(j0+1<numLon)?j0+1:j0+1-numLon;
+    cols[3]=(j0+2<numLon)?j0+2:j0+2-numLon;
+}
+
+const char *GeoidGridCPP::errorString(const int errorCode) {
+    switch(errorCode) {
+        case GEOID_GRID_OK:
+            return "No error.";
+        case GEOID_GRID_OPEN_FAILED:
+            return "The grid file could not be opened.";
+        case GEOID_GRID_BAD_HEADER:
+            return "The file is not a valid geoid grid file.";
+        case GEOID_GRID_BAD_BYTE_ORDER:
+            return "The grid file was written on a machine with a different byte order.";
+        case GEOID_GRID_BAD_SIZE:
+            return "The size of the grid file does not match its header.";
+        case GEOID_GRID_MAP_FAILED:
+            return "The grid file could not be memory mapped.";
+        default:
+            return "Unknown error.";
+    }
+}
+
+const float *GeoidGridCPP::getNode(const size_t i, const size_t j) const {
+    const size_t tileMask=(static_cast<size_t>(1)<<tileShift)-1;
+    const size_t tileIdx=(i>>tileShift)*numLonTiles+(j>>tileShift);
+    const size_t nodeIdx=(tileIdx<<(2*tileShift))+((i&tileMask)<<tileShift)+(j&tileMask);
+
+    return nodes+nodeIdx*numLayers;
+}
+
+void GeoidGridCPP::close() {
+    file.close();
+    nodes=NULL;
+}
+
+void cubicConvWeights(double *w, const double t) {
+/*CUBICCONVWEIGHTS The weights of the 4 nodes at offsets -1, 0, 1 and 2
+ *                 from the node before a point that is a fraction t of
+ *                 the way to the next node using the cubic convolution
+ *                 kernel with a=-1/2.
+ */
+    const double t2=t*t;
+    const double t3=t2*t;
+
+    w[0]=0.5*(-t3+2*t2-t);
+    w[1]=0.5*(3*t3-5*t2+2);
+    w[2]=0.5*(-3*t3+4*t2+t);
+    w[3]=0.5*(t3-t2);
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
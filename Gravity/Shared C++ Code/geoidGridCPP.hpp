@@ -0,0 +1,151 @@
+/**GEOIDGRIDCPP A header file for a class that memory maps a binary file
+ *              holding a global latitude-longitude grid of geoid heights
+ *              and related quantities (deflections of the vertical and
+ *              gravity anomalies) and interpolates the grid bicubically.
+ *              Evaluating the spherical harmonic series of a high-degree
+ *              model such as EGM2008 at a single point takes milliseconds,
+ *              whereas interpolating a grid synthesized once from the
+ *              series takes on the order of 100 nanoseconds, which is what
+ *              is needed when geoid heights are required at high rates in
+ *              a navigation filter. Grid files are made by
+ *              makeGeoidGridFile.
+ *
+ *The grid has numLat latitudes -pi/2+i*deltaLat for i=0 to numLat-1 with
+ *deltaLat=pi/(numLat-1), so the poles are grid lines, and numLon
+ *longitudes j*deltaLon for j=0 to numLon-1 with deltaLon=2*pi/numLon,
+ *which wrap around. Each node holds numLayers single-precision values.
+ *All values in the file are stored in the native byte order of the machine
+ *that wrote it. The file consists of
+ *1) A 72-byte header with the fields of the GeoidGridHeaderCPP structure
+ *   below.
+ *2) The nodes, stored in square tiles of tileSize by tileSize nodes. The
+ *   tiles are stored in order of increasing longitude and then increasing
+ *   latitude. Within a tile, the nodes are also stored in order of
+ *   increasing longitude and then increasing latitude and the numLayers
+ *   values of each node are stored together. The tiles on the last rows
+ *   and columns are padded to the full tile size. Thus, node (i,j) starts
+ *   at element
+ *   (((i/tileSize)*numLonTiles+j/tileSize)*tileSize*tileSize+(i%tileSize)*tileSize+j%tileSize)*numLayers
+ *   where numLonTiles=ceil(numLon/tileSize). Tiling keeps the 4X4 nodes
+ *   used in an interpolation in a few adjacent cache lines and pages, so
+ *   only the parts of the file that are used have to be read from disk.
+ *
+ *The interpolation uses the cubic convolution kernel of
+ *R. G. Keys, "Cubic convolution interpolation for digital image
+ *processing," IEEE Transactions on Acoustics, Speech, and Signal
+ *Processing, vol. 29, no. 6, pp. 1153-1160, Dec. 1981.
+ *(with a=-1/2), which uses the 4X4 nodes around a point, reproduces
+ *quadratic functions exactly and has an error that is O(h^3) in the grid
+ *spacing h for smooth functions. The error of a grid with respect to the
+ *series that it was synthesized from depends on how much of the signal
+ *the grid resolves. makeGeoidGridFile estimates the maximum error of each
+ *layer at random points and stores it in the header. Near the poles, the
+ *rows beyond the pole are taken from the other side of the pole, half way
+ *around in longitude. If there are more than two layers, the second and
+ *third are taken to be the North-South and East-West components of a
+ *horizontal vector, as are the deflections of the vertical of
+ *makeGeoidGridFile, and their signs are changed in those rows.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef GEOIDGRIDCPP
+#define GEOIDGRIDCPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include "MappedFileCPP.hpp"
+
+//The value of the byteOrder field of the header.
+#define GEOID_GRID_BYTE_ORDER 0x01020304u
+#define GEOID_GRID_VERSION 1u
+//The maximum number of values at each node.
+#define GEOID_GRID_MAX_LAYERS 4
+
+//The possible return values of open.
+#define GEOID_GRID_OK 0
+#define GEOID_GRID_OPEN_FAILED 1
+#define GEOID_GRID_BAD_HEADER 2
+#define GEOID_GRID_BAD_BYTE_ORDER 3
+#define GEOID_GRID_BAD_SIZE 4
+#define GEOID_GRID_MAP_FAILED 5
+
+typedef struct {
+    //The characters GEOIDGRD.
+    char magic[8];
+    uint32_t version;
+    //GEOID_GRID_BYTE_ORDER as written by the machine that made the file.
+    uint32_t byteOrder;
+    //The number of latitudes (at least 2) and longitudes (at least 4).
+    uint64_t numLat;
+    uint64_t numLon;
+    //The number of nodes on each side of a tile. This is a power of 2.
+    uint32_t tileSize;
+    //The number of values at each node, 1 to GEOID_GRID_MAX_LAYERS.
+    uint32_t numLayers;
+    //The estimated maximum interpolation error of each layer. This is not
+    //used by the interpolation.
+    double maxErr[GEOID_GRID_MAX_LAYERS];
+} GeoidGridHeaderCPP;
+
+class GeoidGridCPP {
+public:
+    GeoidGridHeaderCPP header;
+
+    GeoidGridCPP();
+    ~GeoidGridCPP();
+
+    int open(const char *fileName);
+    /*Map the given file and check its header and size. The return value is
+     *GEOID_GRID_OK on success or one of the other GEOID_GRID_ values on
+     *failure.*/
+
+    void interp(double *values, const double *latLon, const size_t numPoints) const;
+    /*Interpolate all of the layers of the grid at numPoints points given
+     *as [latitude;longitude] pairs in radians, with respect to the same
+     *reference ellipsoid as the grid. The longitudes can be given in any
+     *range. values is numLayers*numPoints, holding the layers of each
+     *point together. The values of points with a NaN or infinite latitude
+     *or longitude are NaN.*/
+
+    static const char *errorString(const int errorCode);
+    /*Get a description of a value returned by open.*/
+private:
+    void lonNodes(size_t *cols, double *wLon, double y) const;
+    /*Get the four columns and the interpolation weights in longitude of
+     *the position y in units of the grid spacing, which can be in any
+     *range.*/
+    //A pointer to the first node in the mapped file.
+    const float *nodes;
+    size_t numLat;
+    size_t numLon;
+    size_t numLayers;
+    size_t numLonTiles;
+    //tileSize=2^tileShift.
+    size_t tileShift;
+    double invDeltaLat;
+    double invDeltaLon;
+    MappedFileCPP file;
+    void close();
+
+    const float *getNode(const size_t i, const size_t j) const;
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,235 @@
+classdef geoidGrid < handle
+%%GEOIDGRID A class that interpolates a global grid of geoid heights and
+%           related quantities that was made by makeGeoidGridFile. If a
+%           C++ class interface has been compiled, the grid file is memory
+%           mapped, so opening even a very large grid takes almost no time
+%           and each interpolation takes a fraction of a microsecond.
+%           Otherwise, the whole file is read into memory and the
+%           interpolation is performed in Matlab.
+%
+%The interpolation uses the cubic convolution kernel over the 4X4 nodes
+%around each point. The format of the file and the interpolation are
+%described in geoidGridCPP.hpp.
+%
+%Note that if the C++ implementation is used, the mex file is locked when a
+%geoidGrid object is created and is not unlocked (and able to be
+%recompiled) until all of the geoidGrid objects have been freed.
+%
+%EXAMPLE:
+%Here, a 1 degree grid of EGM2008 to degree 180 is made and geoid heights
+%at many points are interpolated and compared to getEGMGeoidHeight.
+% maxErr=makeGeoidGridFile('EGM2008_180.grd',pi/180,180);
+% theGrid=geoidGrid('EGM2008_180.grd');
+% numPoints=1e5;
+% latLon=[asin(2*rand(1,numPoints)-1);2*pi*rand(1,numPoints)];
+% vals=theGrid.interp(latLon);
+% geoidHeightGrid=vals(1,:);
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+properties(SetAccess=private)
+    numLat%The number of latitudes in the grid, including the poles.
+    numLon%The number of longitudes in the grid.
+    numLayers%The number of values at each node.
+    maxErr%The estimated maximum interpolation error of each layer.
+end
+
+properties(Access=private)
+    %These are only used if the C++ implementation does not exist.
+    nodes
+    tileSize
+    CPPData%Only used if an interface to a C++ implementation exists.
+end
+
+methods
+    function newGrid=geoidGrid(fileName)
+    %%GEOIDGRID Open a grid file.
+    %
+    %INPUTS: fileName The name of a grid file made by makeGeoidGridFile.
+    %
+    %OUTPUTS: newGrid A new geoidGrid instance.
+
+        if(exist('geoidGridCPPInt','file'))
+            [newGrid.CPPData,numLat,numLon,numLayers,newGrid.maxErr]=geoidGridCPPInt('geoidGridCPP',fileName);
+            newGrid.numLat=double(numLat);
+            newGrid.numLon=double(numLon);
+            newGrid.numLayers=double(numLayers);
+            return;
+        end
+
+        fileID=fopen(fileName,'r');
+        if(fileID==-1)
+            error('The grid file could not be opened.');
+        end
+
+        %Read the 72-byte header.
+        magic=fread(fileID,8,'*char')';
+        version=fread(fileID,1,'uint32');
+        byteOrder=fread(fileID,1,'uint32');
+        if(~strcmp(magic,'GEOIDGRD')||version~=1)
+            fclose(fileID);
+            error('The file is not a valid geoid grid file.');
+        end
+        if(byteOrder~=hex2dec('01020304'))
+            fclose(fileID);
+            error('The grid file was written on a machine with a different byte order.');
+        end
+        newGrid.numLat=fread(fileID,1,'uint64');
+        newGrid.numLon=fread(fileID,1,'uint64');
+        newGrid.tileSize=fread(fileID,1,'uint32');
+        newGrid.numLayers=fread(fileID,1,'uint32');
+        maxErr=fread(fileID,4,'double');
+        newGrid.maxErr=maxErr(1:newGrid.numLayers);
+
+        newGrid.nodes=fread(fileID,[newGrid.numLayers,Inf],'single=>single');
+        fclose(fileID);
+
+        numTiles=ceil(newGrid.numLat/newGrid.tileSize)*ceil(newGrid.numLon/newGrid.tileSize);
+        if(size(newGrid.nodes,2)~=numTiles*newGrid.tileSize^2)
+            error('The size of the grid file does not match its header.');
+        end
+    end
+
+    function values=interp(theGrid,latLon)
+    %%INTERP Interpolate all of the layers of the grid at a set of points.
+    %
+    %INPUTS: theGrid The geoidGrid instance.
+    %         latLon A 2XN set of [latitude;longitude] points in radians
+    %                with respect to the WGS-84 reference ellipsoid. The
+    %                longitudes can be given in any range.
+    %
+    %OUTPUTS: values The numLayersXN interpolated values. For grids made
+    %                by makeGeoidGridFile, the rows are the geoid height,
+    %                the two deflections of the vertical and the gravity
+    %                anomaly, as in getEGMGeoidHeight. The values of
+    %                points with a NaN or infinite coordinate are NaN.
+
+        if(size(latLon,1)~=2)
+            error('The points must be given as [latitude;longitude].');
+        end
+
+        if(exist('geoidGridCPPInt','file'))
+            values=geoidGridCPPInt('interp',theGrid.CPPData,latLon);
+            return;
+        end
+
+        numLat=theGrid.numLat;
+        numLon=theGrid.numLon;
+        T=theGrid.tileSize;
+        numLonTiles=ceil(numLon/T);
+        numPoints=size(latLon,2);
+
+        %Points with NaN or infinite coordinates are interpolated at zero
+        %and then set to NaN, so that they can not be used as indices.
+        valid=isfinite(latLon(1,:))&isfinite(latLon(2,:));
+        latLon(:,~valid)=0;
+
+        %The position in units of the grid spacing.
+        x=(latLon(1,:)+pi/2)*((numLat-1)/pi);
+        x=min(max(x,0),numLat-1);
+        i0=min(floor(x),numLat-2);
+        wLat=cubicConvWeights(x-i0);
+
+        %The columns wrap around. The rows beyond the poles are the rows
+        %on the other side of the pole, half way around in longitude.
+        y=latLon(2,:)*(numLon/(2*pi));
+        [cols,wLon]=lonNodes(y,numLon);
+        [colsRefl,wLonRefl]=lonNodes(y+numLon/2,numLon);
+        rows=[i0-1;i0;i0+1;i0+2];
+        reflSouth=(rows(1,:)<0);
+        rows(1,reflSouth)=1;
+        reflNorth=(rows(4,:)>numLat-1);
+        rows(4,reflNorth)=numLat-2;
+
+        values=zeros(theGrid.numLayers,numPoints);
+        for a=1:4
+            switch(a)
+                case 1
+                    refl=reflSouth;
+                case 4
+                    refl=reflNorth;
+                otherwise
+                    refl=false(1,numPoints);
+            end
+            rowCols=cols;
+            rowCols(:,refl)=colsRefl(:,refl);
+            rowWLon=wLon;
+            rowWLon(:,refl)=wLonRefl(:,refl);
+
+            rowSum=zeros(theGrid.numLayers,numPoints);
+            for b=1:4
+                i=rows(a,:);
+                j=rowCols(b,:);
+                nodeIdx=(floor(i/T)*numLonTiles+floor(j/T))*T^2+mod(i,T)*T+mod(j,T);
+                rowSum=rowSum+bsxfun(@times,double(theGrid.nodes(:,nodeIdx+1)),rowWLon(b,:));
+            end
+
+            %The North-South and East-West components of the deflection of
+            %the vertical change sign across the pole.
+            if(theGrid.numLayers>2)
+                rowSum(2:3,refl)=-rowSum(2:3,refl);
+            end
+            values=values+bsxfun(@times,rowSum,wLat(a,:));
+        end
+        values(:,~valid)=NaN;
+    end
+
+    function delete(theGrid)
+    %%DELETE The destructor method. This method is used when the grid is
+    %        implemented as a C++ class. This method prevents a memory
+    %        leak.
+
+        if(exist('geoidGridCPPInt','file')&&~isempty(theGrid.CPPData))
+            geoidGridCPPInt('~geoidGridCPP',theGrid.CPPData);
+        end
+    end
+end
+end
+
+function [cols,w]=lonNodes(y,numLon)
+%%LONNODES The 4XN columns and interpolation weights in longitude of the
+%          positions y in units of the grid spacing, which can be in any
+%          range.
+
+    y=mod(y,numLon);
+    j0=floor(y);
+    %Rounding can put y at numLon.
+    sel=(j0>=numLon);
+    j0(sel)=0;
+    y(sel)=0;
+
+    w=cubicConvWeights(y-j0);
+    cols=mod(bsxfun(@plus,j0,(-1:2)'),numLon);
+end
+
+function w=cubicConvWeights(t)
+%%CUBICCONVWEIGHTS The 4XN weights of the nodes at offsets -1, 0, 1 and 2
+%                  from the node before each point using the cubic
+%                  convolution kernel with a=-1/2. t holds the fractional
+%                  positions of the points between the nodes.
+
+    t2=t.^2;
+    t3=t2.*t;
+    w=0.5*[-t3+2*t2-t;
+           3*t3-5*t2+2;
+           -3*t3+4*t2+t;
+           t3-t2];
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
@@ -0,0 +1,137 @@
+/**GEOIDGRIDCPPINT An interface between the Matlab geoidGrid class and the
+ *              C++ GeoidGridCPP class, which memory maps a grid file made
+ *              by makeGeoidGridFile and interpolates it. This function is
+ *              meant to be called by the geoidGrid class in Matlab; not
+ *              directly by the user. Running the function with invalid
+ *              inputs can crash Matlab.
+ *
+ *The function is called as
+ *[CPPData,numLat,numLon,numLayers,maxErr]=geoidGridCPPInt('geoidGridCPP',fileName);
+ *where maxErr is the numLayersX1 vector of the estimated maximum
+ *interpolation errors stored in the file,
+ *or
+ *values=geoidGridCPPInt('interp',CPPData,latLon);
+ *where latLon is 2XnumPoints and values is numLayersXnumPoints,
+ *or
+ *geoidGridCPPInt('~geoidGridCPP',CPPData);
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For strcmp
+#include <cstring>
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "geoidGridCPP.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    char cmd[64];
+    GeoidGridCPP *theGrid;
+
+    if(nrhs<2) {
+        mexErrMsgTxt("Not enough inputs.");
+    }
+
+    if(nrhs>3) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+
+    //Get the command string that is passed.
+    mxGetString(prhs[0], cmd, sizeof(cmd));
+
+    if(!strcmp("geoidGridCPP", cmd)) {
+        char *fileName;
+        int retVal;
+
+        if(nrhs!=2) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>5) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        if(!mxIsChar(prhs[1])) {
+            mexErrMsgTxt("The file name must be a string.");
+        }
+
+        theGrid=new GeoidGridCPP();
+        fileName=mxArrayToString(prhs[1]);
+        retVal=theGrid->open(fileName);
+        mxFree(fileName);
+        if(retVal!=GEOID_GRID_OK) {
+            delete theGrid;
+            mexErrMsgTxt(GeoidGridCPP::errorString(retVal));
+        }
+
+        //Lock this mex file so that it can not be cleared until the object
+        //has been deleted (This avoids a memory leak).
+        mexLock();
+        plhs[0]=ptr2Matlab<GeoidGridCPP*>(theGrid);
+        if(nlhs>1) {
+            const size_t numLat=static_cast<size_t>(theGrid->header.numLat);
+            plhs[1]=unsignedSizeMat2Matlab(&numLat,1,1);
+        }
+        if(nlhs>2) {
+            const size_t numLon=static_cast<size_t>(theGrid->header.numLon);
+            plhs[2]=unsignedSizeMat2Matlab(&numLon,1,1);
+        }
+        if(nlhs>3) {
+            const size_t numLayers=theGrid->header.numLayers;
+            plhs[3]=unsignedSizeMat2Matlab(&numLayers,1,1);
+        }
+        if(nlhs>4) {
+            plhs[4]=doubleMat2Matlab(theGrid->header.maxErr,theGrid->header.numLayers,1);
+        }
+    } else if(!strcmp("interp", cmd)) {
+        size_t numPoints;
+        mxArray *valuesMATLAB;
+
+        if(nrhs!=3) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>1) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theGrid=Matlab2Ptr<GeoidGridCPP*>(prhs[1]);
+
+        checkRealDoubleArray(prhs[2]);
+        if(mxGetM(prhs[2])!=2) {
+            mexErrMsgTxt("The points must be given as [latitude;longitude].");
+        }
+        numPoints=mxGetN(prhs[2]);
+
+        valuesMATLAB=mxCreateDoubleMatrix(theGrid->header.numLayers,numPoints,mxREAL);
+        theGrid->interp((double*)mxGetData(valuesMATLAB),(double*)mxGetData(prhs[2]),numPoints);
+        plhs[0]=valuesMATLAB;
+    } else if(!strcmp("~geoidGridCPP", cmd)) {
+        theGrid=Matlab2Ptr<GeoidGridCPP*>(prhs[1]);
+
+        delete theGrid;
+        //Unlock the mex file allowing it to be cleared.
+        mexUnlock();
+    } else {
+        mexErrMsgTxt("Invalid string passed to geoidGridCPPInt.");
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
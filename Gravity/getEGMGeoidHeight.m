@@ -1,4 +1,4 @@
-function [geoidHeight,coeffData]=getEGMGeoidHeight(latLon,tideSys,useNGAApprox,modelType,coeffData)
+function [geoidHeight,coeffData,deflection,gravAnomaly]=getEGMGeoidHeight(latLon,tideSys,useNGAApprox,modelType,coeffData)
 %%GETEGMGEOIDHEIGHT  Given a point as latitude and longitude in WGS-84
 %                  ellipsoidal coordinates, obtain the geoid height (geoid
 %                  undulation) using the National Geospatial Intelligence
@@ -54,6 +54,22 @@ function [geoidHeight,coeffData]=getEGMGeoidHeight(latLon,tideSys,useNGAApprox,m
 %         coeffData   The coeffData coefficients that can be passed to
 %                     another call of getEGMGeoidHeight to make it
 %                     faster.
+%         deflection  If requested, the 2XN set of deflections of the
+%                     vertical [xi;eta] in radians on the reference
+%                     ellipsoid, where xi is the North-South component and
+%                     eta the East-West component. These are
+%                     xi=-gradT_N/gamma and eta=-gradT_E/gamma, where
+%                     gradT_N and gradT_E are the components of the
+%                     gradient of the disturbing potential along the local
+%                     North and East axes and gamma is the magnitude of the
+%                     normal gravity. They are not affected by tideSys.
+%         gravAnomaly If requested, the NX1 set of gravity anomalies in
+%                     m/s^2 on the reference ellipsoid, computed in the
+%                     spherical approximation as -dT/dr-2*T/r with the
+%                     derivative taken along the ellipsoidal normal.
+%
+%The deflections and gravity anomalies only use the disturbing potential,
+%not the height anomaly to geoid undulation correction.
 %
 %The geoid is a theoretical surface of constant gravitational potential.
 %The potential used for the geoid is that implied on 
@@ -230,7 +246,11 @@ for curPoint=2:numPoints
 end
 
 %Compute the disturbing potential at the lat-lon-point.
-T=spherHarmonicEval(coeffData.C,coeffData.S,spherPoint,aPotential,GMPotential);
+if(nargout>2)
+    [T,gradT]=spherHarmonicEval(coeffData.C,coeffData.S,spherPoint,aPotential,GMPotential);
+else
+    T=spherHarmonicEval(coeffData.C,coeffData.S,spherPoint,aPotential,GMPotential);
+end
 [U0,g]=ellipsParam2Grav(cartPoint,omegaEllipse,aEllipse,fEllipse,GMEllipse);
 
 %Acceleration due to gravity on the reference ellipsoid under an
@@ -270,6 +290,20 @@ else
     geoidHeight=zeta+zeta2N/100;
 end
 
+if(nargout>2)
+    %The local East, North and Up unit vectors on the reference ellipsoid.
+    sinLat=sin(latLon(1,:));
+    cosLat=cos(latLon(1,:));
+    sinLon=sin(latLon(2,:));
+    cosLon=cos(latLon(2,:));
+    uEast=[-sinLon;cosLon;zeros(1,numPoints)];
+    uNorth=[-sinLat.*cosLon;-sinLat.*sinLon;cosLat];
+    uUp=[cosLat.*cosLon;cosLat.*sinLon;sinLat];
+
+    deflection=-[sum(gradT.*uNorth,1);sum(gradT.*uEast,1)]./[gamma';gamma'];
+    gravAnomaly=-sum(gradT.*uUp,1)'-2*T./r';
+end
+
 %Now, convert the the appropriate tide system
 switch(tideSys)
     case 1%mean tide
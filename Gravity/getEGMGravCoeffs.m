@@ -100,14 +100,18 @@ function [C,S,a,c,CStdDev,SStdDev]=getEGMGravCoeffs(M,isTideFree,modelType,TT1,T
 %egm96 without a file extension). The decompressed file should be placed in
 %the data folder that is in the same folder as this script.
 %
-%This function first checks for a .mat file with the coefficients in it.
-%The .mat file is small and can be read quite quickly. However, if one does
-%not exist, then it tries to read the EGM2008_to2190_TideFree text file (or
-%the egm96 text file) that one can obtain directly from the NGA. If
-%M is the maximum number of coefficients or is empty and the text file is
-%read directly, then the .mat file is created so that subsequent reads are
-%faster. Note that after the .mat file has ben created, the text file can
-%be deleted.
+%This function first checks for a binary coefficient file with the
+%extension .shc, as written by writeSpherHarmonicCoeffFile, from which only
+%the degrees up to M are read. Next, it checks for a .mat file with the
+%coefficients in it. The .mat file is small and can be read quite quickly.
+%However, if neither exists, then it tries to read the
+%EGM2008_to2190_TideFree text file (or the egm96 text file) that one can
+%obtain directly from the NGA. If M is the maximum number of coefficients
+%or is empty and the text file is read directly, then the .mat file (and
+%the .shc file, if the C++ code has been compiled) is created so that
+%subsequent reads are faster. Note that after the .mat file has ben
+%created, the text file can be deleted. The .shc file can also be memory
+%mapped by spherHarmonicModel.
 %
 %More on using the spherical harmonic coefficients is given in
 %the comments for the function spherHarmonicEval and the format and use of
@@ -195,9 +199,12 @@ totalNumCoeffs=(M+1)*(M+2)/2;
 ScriptPath=mfilename('fullpath');
 ScriptFolder = fileparts(ScriptPath);
 
-%First, see if a .mat file with all of the data exists. If so, then use
-%that and ignore everything else.
-if(exist([ScriptFolder,fileName,'.mat'],'file'))
+%First, see if a binary coefficient file exists. If so, only the degrees
+%that are needed are read from it. Otherwise, see if a .mat file with all
+%of the data exists. If so, then use that and ignore everything else.
+if(exist([ScriptFolder,fileName,'.shc'],'file'))
+    [C,S,~,~,CStdDev,SStdDev]=readSpherHarmonicCoeffFile([ScriptFolder,fileName,'.shc'],M);
+elseif(exist([ScriptFolder,fileName,'.mat'],'file'))
     load([ScriptFolder,fileName,'.mat'],'CCoeffs','SCoeffs','CCoeffsStdDev','SCoeffsStdDev','clustSizes','offsets');
     %Create the ClusterSet classes to hold the data.
     C=ClusterSet();
@@ -263,6 +270,10 @@ else
         offsets=C.offsetArray;
 
         save([ScriptFolder,fileName,'.mat'],'CCoeffs','SCoeffs','CCoeffsStdDev','SCoeffsStdDev','clustSizes','offsets');
+
+        if(exist('writeSpherHarmonicCoeffFileCPPInt','file'))
+            writeSpherHarmonicCoeffFile([ScriptFolder,fileName,'.shc'],C,S,a,c,CStdDev,SStdDev,1);
+        end
     end
 end
 
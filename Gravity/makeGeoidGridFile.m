@@ -0,0 +1,280 @@
+function maxErr=makeGeoidGridFile(fileName,gridSpacing,M,tideSys,useNGAApprox,modelType,numCheck,tileSize,numThreads)
+%%MAKEGEOIDGRIDFILE Synthesize a global grid of geoid heights, deflections
+%                   of the vertical and gravity anomalies from the Earth
+%                   Gravitational Model 2008 (EGM2008) or 1996 (EGM96) and
+%                   save it in a tiled binary file that the geoidGrid class
+%                   can interpolate in a fraction of a microsecond per
+%                   point. getEGMGeoidHeight evaluates the full spherical
+%                   harmonic series at every point, which takes on the
+%                   order of milliseconds per point with EGM2008. That is
+%                   far too slow when geoid heights are needed at high
+%                   rates for many platforms in a navigation filter.
+%
+%INPUTS: fileName The name of the grid file to write.
+%     gridSpacing The spacing of the grid in latitude and longitude in
+%                 radians. The grid has round(pi/gridSpacing)+1
+%                 latitudes, including the poles, and
+%                 round(2*pi/gridSpacing) longitudes. The default if
+%                 omitted or an empty matrix is passed is 5 arcminutes,
+%                 which resolves EGM2008 to degree 2160. The file holds 16
+%                 bytes per node, so a 5 arcminute grid is about 150MB and
+%                 a 1 arcminute grid is about 3.7GB.
+%               M The maximum degree of the model to use. If omitted or an
+%                 empty matrix is passed, all of the coefficients of the
+%                 model are used. Using a lower degree with a coarser grid
+%                 gives a smaller file with a lower interpolation error
+%                 with respect to the truncated model.
+% tideSys, useNGAApprox, modelType These are the same as in
+%                 getEGMGeoidHeight and have the same defaults. The tide
+%                 system only affects the geoid heights.
+%        numCheck The number of random points, uniformly distributed on
+%                 the sphere, at which the grid is compared to
+%                 getEGMGeoidHeight to estimate the maximum interpolation
+%                 error of each layer. The estimates are stored in the
+%                 file. The default if omitted or an empty matrix is passed
+%                 is 1000. If 0, no check is performed and zeros are
+%                 stored.
+%        tileSize The number of nodes on each side of the square tiles in
+%                 which the grid is stored. This must be a power of 2. The
+%                 default if omitted or an empty matrix is passed is 16,
+%                 so that a tile of 4-layer nodes fills a 4kB page.
+%      numThreads The number of threads used in the spherical harmonic
+%                 synthesis, as in spherHarmonicGridEval. The default if
+%                 omitted or an empty matrix is passed is 1.
+%
+%OUTPUTS: maxErr The 4X1 vector of the estimated maximum absolute
+%                interpolation errors of the geoid height (meters), the
+%                two deflections of the vertical (radians) and the gravity
+%                anomaly (m/s^2), as stored in the file.
+%
+%The file holds 4 layers at each node, in the order of the outputs of
+%getEGMGeoidHeight: the geoid height, the North-South and East-West
+%deflections of the vertical and the gravity anomaly, all with respect to
+%the WGS-84 reference ellipsoid. The format of the file is described in
+%geoidGridCPP.hpp. The values are stored in single precision, which is
+%much finer than the accuracy of the models.
+%
+%The grid is synthesized one latitude row at a time with
+%spherHarmonicGridEval, which uses a fast Fourier transform for the sum
+%over the orders, using the same expressions as getEGMGeoidHeight. The
+%interpolation error depends on how much of the model the grid resolves:
+%Signals with wavelengths close to twice the grid spacing are not
+%interpolated accurately. Reducing M or the grid spacing reduces the
+%error.
+%
+%EXAMPLE:
+%A 15 arcminute grid of EGM2008 to degree 720 is made and then used to get
+%geoid heights.
+% gridSpacing=(15/60)*(pi/180);
+% maxErr=makeGeoidGridFile('EGM2008_720.grd',gridSpacing,720);
+% theGrid=geoidGrid('EGM2008_720.grd');
+% latLon=[38.628155;269.779155]*(pi/180);
+% vals=theGrid.interp(latLon);
+% geoidHeight=vals(1)
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+if(nargin<9||isempty(numThreads))
+    numThreads=1;
+end
+
+if(nargin<8||isempty(tileSize))
+    tileSize=16;
+end
+
+if(nargin<7||isempty(numCheck))
+    numCheck=1000;
+end
+
+if(nargin<6||isempty(modelType))
+    modelType=0;%EGM2008 Model
+end
+
+if(nargin<5||isempty(useNGAApprox))
+    useNGAApprox=false;
+end
+
+if(nargin<4||isempty(tideSys))
+    tideSys=0;
+end
+
+if(nargin<3)
+    M=[];
+end
+
+if(nargin<2||isempty(gridSpacing))
+    gridSpacing=(5/60)*(pi/180);
+end
+
+if(tileSize<1||bitand(tileSize,tileSize-1)~=0)
+    error('The tile size must be a power of 2.');
+end
+
+numLat=round(pi/gridSpacing)+1;
+numLon=round(2*pi/gridSpacing);
+numLayers=4;
+
+%The constants for the reference ellipsoid, as in getEGMGeoidHeight.
+GMEllipse=Constants.WGS84GMWithAtmosphere;
+aEllipse=Constants.WGS84SemiMajorAxis;
+omegaEllipse=Constants.WGS84EarthRotationRate;
+fEllipse=Constants.WGS84Flattening;
+GMPotential=Constants.EGM2008GM;
+aPotential=Constants.EGM2008SemiMajorAxis;
+
+[C,S]=getEGMWGS84TCoeffs(M,useNGAApprox,modelType);
+coeffData.C=C;
+coeffData.S=S;
+if(isempty(M))
+    MZeta=[];
+elseif(modelType==0)
+    MZeta=min(M,2160);
+else
+    MZeta=min(M,360);
+end
+[C,S]=getEGMZeta2NCoeffs(MZeta,modelType);
+coeffData.CZeta=C;
+coeffData.SZeta=S;
+
+if(useNGAApprox==false)
+    W0=ellipsParam2Grav([],omegaEllipse,Constants.EGM2008GeoidSemiMajorAxis,Constants.EGM2008GeoidFlattening,GMEllipse);
+end
+
+%The grid is padded to a whole number of tiles.
+numLatTiles=ceil(numLat/tileSize);
+numLonTiles=ceil(numLon/tileSize);
+gridVals=zeros(numLayers,numLonTiles*tileSize,numLatTiles*tileSize,'single');
+
+lat=-pi/2+pi*(0:(numLat-1))/(numLat-1);
+lon=2*pi*(0:(numLon-1))/numLon;
+sinLon=sin(lon);
+cosLon=cos(lon);
+
+%The rows are synthesized in batches to limit the memory used.
+numRowsPerBatch=max(1,floor(2^20/numLon));
+for startRow=1:numRowsPerBatch:numLat
+    rowIdx=startRow:min(startRow+numRowsPerBatch-1,numLat);
+    numRows=length(rowIdx);
+    latBatch=lat(rowIdx);
+
+    %The range and spherical latitude of each row on the ellipsoid.
+    cartRows=ellips2Cart([latBatch;zeros(2,numRows)],aEllipse,fEllipse);
+    rRows=sqrt(sum(cartRows.*cartRows,1));
+    elRows=atan2(cartRows(3,:),cartRows(1,:));
+
+    %The normal potential and gravity only depend on the latitude.
+    [U0,g]=ellipsParam2Grav(cartRows,omegaEllipse,aEllipse,fEllipse,GMEllipse);
+    gamma=sqrt(sum(g.*g,1));
+
+    [T,gradT]=spherHarmonicGridEval(coeffData.C,coeffData.S,[rRows;elRows],0,numLon,aPotential,GMPotential,true,[],numThreads);
+    zeta2N=spherHarmonicGridEval(coeffData.CZeta,coeffData.SZeta,elRows,0,numLon,[],[],true,[],numThreads);
+
+    %The height anomaly, as in getEGMGeoidHeight.
+    if(useNGAApprox~=false)
+        if(modelType==0)
+            correctionTerm=-0.41;
+        else
+            correctionTerm=-0.53;
+        end
+        zeta=bsxfun(@rdivide,T,gamma)-repmat(coeffData.C(0+1,0+1)*GMPotential./(gamma.*rRows),numLon,1)+correctionTerm;
+    else
+        zeta=bsxfun(@rdivide,bsxfun(@minus,T,W0-U0(:).'),gamma);
+    end
+
+    if(modelType==0)
+        geoidHeight=zeta+zeta2N;
+    else
+        geoidHeight=zeta+zeta2N/100;
+    end
+
+    switch(tideSys)
+        case 1%mean tide
+            k=0.3;
+            geoidHeight=bsxfun(@plus,geoidHeight,(1+k)*(9.9-26.9*sin(latBatch).^2)*10^(-2));
+        case 2%zero tide
+            k=0.3;
+            geoidHeight=bsxfun(@plus,geoidHeight,k*(9.9-29.6*sin(latBatch).^2)*10^(-2));
+        otherwise
+    end
+
+    %The components of the gradient of T along the local East, North and
+    %Up axes, which are numLonXnumRows.
+    sinLat=sin(latBatch);
+    cosLat=cos(latBatch);
+    gx=reshape(gradT(1,:,:),numLon,numRows);
+    gy=reshape(gradT(2,:,:),numLon,numRows);
+    gz=reshape(gradT(3,:,:),numLon,numRows);
+    gEast=-bsxfun(@times,gx,sinLon(:))+bsxfun(@times,gy,cosLon(:));
+    gHoriz=bsxfun(@times,gx,cosLon(:))+bsxfun(@times,gy,sinLon(:));
+    gNorth=-bsxfun(@times,gHoriz,sinLat)+bsxfun(@times,gz,cosLat);
+    gUp=bsxfun(@times,gHoriz,cosLat)+bsxfun(@times,gz,sinLat);
+
+    xi=-bsxfun(@rdivide,gNorth,gamma);
+    eta=-bsxfun(@rdivide,gEast,gamma);
+    gravAnomaly=-gUp-2*bsxfun(@rdivide,T,rRows);
+
+    gridVals(1,1:numLon,rowIdx)=reshape(single(geoidHeight),[1,numLon,numRows]);
+    gridVals(2,1:numLon,rowIdx)=reshape(single(xi),[1,numLon,numRows]);
+    gridVals(3,1:numLon,rowIdx)=reshape(single(eta),[1,numLon,numRows]);
+    gridVals(4,1:numLon,rowIdx)=reshape(single(gravAnomaly),[1,numLon,numRows]);
+end
+
+%Put the nodes into tiles. The dimensions become the layer, the longitude
+%and latitude within a tile and then the longitude and latitude of the
+%tile.
+gridVals=reshape(gridVals,[numLayers,tileSize,numLonTiles,tileSize,numLatTiles]);
+gridVals=permute(gridVals,[1,2,4,3,5]);
+
+fileID=fopen(fileName,'w');
+if(fileID==-1)
+    error('The grid file could not be opened for writing.');
+end
+%The 72-byte header.
+fwrite(fileID,uint8('GEOIDGRD'),'uint8');
+fwrite(fileID,1,'uint32');
+fwrite(fileID,hex2dec('01020304'),'uint32');
+fwrite(fileID,numLat,'uint64');
+fwrite(fileID,numLon,'uint64');
+fwrite(fileID,tileSize,'uint32');
+fwrite(fileID,numLayers,'uint32');
+fwrite(fileID,zeros(4,1),'double');
+fwrite(fileID,gridVals(:),'single');
+fclose(fileID);
+clear gridVals
+
+maxErr=zeros(4,1);
+if(numCheck>0)
+    latLon=[asin(2*rand(1,numCheck)-1);2*pi*rand(1,numCheck)];
+    [geoidHeight,~,deflection,gravAnomaly]=getEGMGeoidHeight(latLon,tideSys,useNGAApprox,modelType,coeffData);
+
+    theGrid=geoidGrid(fileName);
+    vals=theGrid.interp(latLon);
+    delete(theGrid);
+
+    maxErr=max(abs(vals-[geoidHeight.';deflection;gravAnomaly.']),[],2);
+
+    %Store the errors in the header.
+    fileID=fopen(fileName,'r+');
+    fseek(fileID,40,'bof');
+    fwrite(fileID,maxErr,'double');
+    fclose(fileID);
+end
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
@@ -0,0 +1,125 @@
+/*MAGNETICFIELDMODELCPP C++ implementation of a class that evaluates a
+ *                    time-varying geomagnetic field model. See
+ *                    magneticFieldModelCPP.hpp for more information.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <math.h>
+#include "magneticFieldModelCPP.hpp"
+//For getENUAxesCPP
+#include "CoordFuncs.hpp"
+
+using namespace std;
+
+MagneticFieldModelCPP::MagneticFieldModelCPP(const double *CCoeffs, const double *SCoeffs, const size_t M, const double *CDotCoeffs, const double *SDotCoeffs, const size_t MDot, const double refEpochVal, const double a, const double c, const double scalFactor) {
+    mainField.reset(new SpherHarmonicModelCPP(CCoeffs,SCoeffs,M,a,c,scalFactor));
+    if(CDotCoeffs!=NULL&&SDotCoeffs!=NULL) {
+        secVar.reset(new SpherHarmonicModelCPP(CDotCoeffs,SDotCoeffs,MDot,a,c,scalFactor));
+    }
+    refEpoch=refEpochVal;
+}
+
+MagneticFieldModelCPP::MagneticFieldModelCPP(const shared_ptr<const SpherHarmonicCoeffFileCPP> &coeffFile, const double scalFactor) {
+    const SpherHarmonicCoeffHeaderCPP &header=coeffFile->header;
+
+    mainField.reset(new SpherHarmonicModelCPP(coeffFile,scalFactor));
+    if(header.numSets==4&&header.auxType==SPHER_HARMONIC_COEFF_AUX_RATE) {
+        //The secular variation is small, so it is copied.
+        secVar.reset(new SpherHarmonicModelCPP(coeffFile->CAux,coeffFile->SAux,static_cast<size_t>(header.MAux),header.a,header.c,scalFactor));
+        refEpoch=header.refEpoch;
+    } else {
+        refEpoch=0;
+    }
+}
+
+void MagneticFieldModelCPP::evaluate(double *B, const double *plhPoints, const double *times, const size_t numPoints, const bool oneTime, const int frame, const double aEllips, const double fEllips, const size_t numThreads) {
+    const double e2=fEllips*(2-fEllips);
+    size_t curPoint;
+
+    spherPoints.resize(3*numPoints);
+    potential.resize(numPoints);
+    gradMain.resize(3*numPoints);
+
+    //Convert the geodetic points to spherical coordinates.
+    for(curPoint=0;curPoint<numPoints;curPoint++) {
+        const double *plh=plhPoints+3*curPoint;
+        const double sinLat=sin(plh[0]);
+        const double cosLat=cos(plh[0]);
+        //The radius of curvature in the prime vertical.
+        const double Ne=aEllips/sqrt(1-e2*sinLat*sinLat);
+        const double rho=(Ne+plh[2])*cosLat;
+        const double z=(Ne*(1-e2)+plh[2])*sinLat;
+        double *spherPoint=spherPoints.data()+3*curPoint;
+
+        spherPoint[0]=sqrt(rho*rho+z*z);
+        spherPoint[1]=plh[1];
+        spherPoint[2]=atan2(z,rho);
+    }
+
+    mainField->evaluate(potential.data(),gradMain.data(),NULL,spherPoints.data(),numPoints,numThreads);
+    if(secVar) {
+        gradSecVar.resize(3*numPoints);
+        secVar->evaluate(potential.data(),gradSecVar.data(),NULL,spherPoints.data(),numPoints,numThreads);
+    }
+
+    for(curPoint=0;curPoint<numPoints;curPoint++) {
+        const double *g=gradMain.data()+3*curPoint;
+        double BECEF[3];
+        double *BCur=B+3*curPoint;
+
+        if(secVar) {
+            const double deltaT=(oneTime?times[0]:times[curPoint])-refEpoch;
+            const double *gDot=gradSecVar.data()+3*curPoint;
+
+            BECEF[0]=-(g[0]+deltaT*gDot[0]);
+            BECEF[1]=-(g[1]+deltaT*gDot[1]);
+            BECEF[2]=-(g[2]+deltaT*gDot[2]);
+        } else {
+            BECEF[0]=-g[0];
+            BECEF[1]=-g[1];
+            BECEF[2]=-g[2];
+        }
+
+        if(frame==MAGNETIC_FIELD_FRAME_ECEF) {
+            BCur[0]=BECEF[0];
+            BCur[1]=BECEF[1];
+            BCur[2]=BECEF[2];
+        } else {
+            //The unit vectors of the East, North and Up axes.
+            double u[9], cMag[3], BE, BN, BU;
+
+            getENUAxesCPP(u,cMag,plhPoints+3*curPoint,false,aEllips,fEllips);
+            BE=u[0]*BECEF[0]+u[1]*BECEF[1]+u[2]*BECEF[2];
+            BN=u[3]*BECEF[0]+u[4]*BECEF[1]+u[5]*BECEF[2];
+            BU=u[6]*BECEF[0]+u[7]*BECEF[1]+u[8]*BECEF[2];
+
+            if(frame==MAGNETIC_FIELD_FRAME_ENU) {
+                BCur[0]=BE;
+                BCur[1]=BN;
+                BCur[2]=BU;
+            } else {
+                BCur[0]=BN;
+                BCur[1]=BE;
+                BCur[2]=-BU;
+            }
+        }
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,104 @@
+/**MAGNETICFIELDMODELCPP A header file for a class that evaluates a
+ *                    time-varying geomagnetic field model, such as the
+ *                    World Magnetic Model (WMM) or the Enhanced Magnetic
+ *                    Model (EMM), given its main-field coefficients and
+ *                    the linear secular-variation coefficients. The
+ *                    coefficients are loaded once and the field can then
+ *                    be evaluated at any number of (point, time) pairs
+ *                    without ever forming the coefficients for a
+ *                    particular epoch.
+ *
+ *The potential of such a model at time t is the spherical harmonic series
+ *with the coefficients C+(t-t0)*CDot and S+(t-t0)*SDot, where t0 is the
+ *reference epoch. Since the series is linear in the coefficients, the
+ *gradient at time t is the gradient of the main-field series plus (t-t0)
+ *times the gradient of the secular-variation series. The secular
+ *variation is generally only given to a low degree (e.g. 15 for the EMM,
+ *whose main field goes to degree 720), so summing it separately costs
+ *little and the main field, which dominates the cost, can reuse the
+ *Legendre functions between points in the same manner as
+ *spherHarmonicEvalCPP regardless of the times.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef MAGNETICFIELDMODELCPP
+#define MAGNETICFIELDMODELCPP
+
+#include <stddef.h>
+#include <vector>
+#include <memory>
+#include "spherHarmonicModelCPP.hpp"
+
+//The coordinate systems in which the field can be expressed.
+#define MAGNETIC_FIELD_FRAME_ECEF 0
+#define MAGNETIC_FIELD_FRAME_ENU 1
+#define MAGNETIC_FIELD_FRAME_NED 2
+
+class MagneticFieldModelCPP {
+public:
+    //The main field and the secular variation, which is NULL if the model
+    //does not vary with time. Both have the same a and c.
+    std::unique_ptr<SpherHarmonicModelCPP> mainField;
+    std::unique_ptr<SpherHarmonicModelCPP> secVar;
+    //The epoch at which the main-field coefficients apply, in the same
+    //units as the times passed to evaluate (normally decimal years).
+    double refEpoch;
+
+    MagneticFieldModelCPP(const double *CCoeffs, const double *SCoeffs, const size_t M, const double *CDotCoeffs, const double *SDotCoeffs, const size_t MDot, const double refEpochVal, const double a, const double c, const double scalFactor);
+    /*The coefficient arrays are stored by degree in the same manner as the
+     *clusterEls member of a ClusterSet, holding fully normalized
+     *coefficients up to degree M for the main field and MDot for the
+     *secular variation. The secular-variation coefficients are the rates
+     *of change per unit of time. If CDotCoeffs is NULL, the field does not
+     *vary with time. The coefficients are copied.*/
+
+    MagneticFieldModelCPP(const std::shared_ptr<const SpherHarmonicCoeffFileCPP> &coeffFile, const double scalFactor);
+    /*Create a model from an opened coefficient file. The main field is
+     *evaluated directly from the mapped file. If the file holds rates of
+     *change (auxType=SPHER_HARMONIC_COEFF_AUX_RATE), they are the secular
+     *variation and refEpoch is taken from the file. Otherwise, the field
+     *does not vary with time.*/
+
+    void evaluate(double *B, const double *plhPoints, const double *times, const size_t numPoints, const bool oneTime, const int frame, const double aEllips, const double fEllips, const size_t numThreads);
+    /*Evaluate the magnetic flux density B=-gradV at numPoints points given
+     *as geodetic [latitude;longitude;height] with respect to a reference
+     *ellipsoid with semi-major axis aEllips and flattening fEllips. If
+     *oneTime is true, all of the points are evaluated at times[0].
+     *Otherwise, point i is evaluated at times[i]. frame is one of the
+     *MAGNETIC_FIELD_FRAME_ values and selects whether the 3 components of
+     *each B are in ECEF Cartesian coordinates or in the local
+     *East-North-Up or North-East-Down coordinate system at the point. The
+     *points are split across numThreads threads.*/
+private:
+    //The points in spherical coordinates, the potentials and the gradients
+    //of the main-field and secular-variation series, which are kept
+    //between calls.
+    std::vector<double> spherPoints;
+    std::vector<double> potential;
+    std::vector<double> gradMain;
+    std::vector<double> gradSecVar;
+
+    //The class holds models that can not be copied.
+    MagneticFieldModelCPP(const MagneticFieldModelCPP &);
+    MagneticFieldModelCPP &operator=(const MagneticFieldModelCPP &);
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -1,4 +1,4 @@
-function [C,S,a,c]=getEMMCoeffs(M,year,fullyNormalize)
+function [C,S,a,c,CDot,SDot,yearRef]=getEMMCoeffs(M,year,fullyNormalize)
 %%GETEMMCOEFFS Obtain spherical harmonic coefficients for the 2010 
 %                 version of the National Oceanic and Atmospheric
 %                 Administration's (NOAA's) Enchaned Magnetic Model (EMM)
@@ -40,13 +40,25 @@ function [C,S,a,c]=getEMMCoeffs(M,year,fullyNormalize)
 %               sum having units of meters.
 %         c     The constant value by which the spherical harmonic series
 %               is multiplied, having units of squared meters.
+%    CDot, SDot ClusterSet classes holding the rates of change of the
+%               coefficients in Tesla per year, normalized in the same
+%               manner as C and S. The secular variation is only given to
+%               a low degree, so these generally have fewer degrees than C
+%               and S.
+%       yearRef The reference epoch of the coefficient set that was used
+%               as a decimal year. C and S at yearRef with CDot, SDot and
+%               yearRef can be passed to magneticFieldModel to evaluate
+%               the field at many points and times without calling this
+%               function for each time.
 %
 %Details on the normalization of the coefficients is given in the comments
 %to the function spherHarmonicEval.
 %
-%This function first checks for a .mat file with the coefficients in it.
-%The .mat file is small and can be read quite quickly. However, if one does
-%not exist, then it tries to read the EMM2015.COF and EMM2015SV.COF text
+%This function first checks for a binary coefficient file, as written by
+%writeSpherHarmonicCoeffFile, from which only the degrees up to M are read.
+%Next, it checks for a .mat file with the coefficients in it. The .mat file
+%is small and can be read quite quickly. However, if neither exists, then
+%it tries to read the EMM2015.COF and EMM2015SV.COF text
 %files that one can obtain directly from the NOAA. Reading from the text
 %files is very slow.
 %
@@ -65,7 +77,8 @@ function [C,S,a,c]=getEMMCoeffs(M,year,fullyNormalize)
 %The data is kept in zipped files in the ./data folder. If all of the data
 %is being loaded for a particular year (M=Inf), then a .mat file will be
 %created in the ./data folder with the data for that year so that it can be
-%loaded more quickly in the future.
+%loaded more quickly in the future. If the C++ code has been compiled, an
+%EMM<year>.shc binary coefficient file is also created.
 %
 %June 2015 David F. Crouse, Naval Research Laboratory, Washington D.C.
 %(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
@@ -118,8 +131,17 @@ yearRef=EMMYears(yearIdx2Load);
 %exists. If so, then use that to load the coefficients from which
 %interpolation must be performed.
 matFile=[ScriptFolder,'/data/EMM',int2str(yearRef),'.mat'];
+shcFile=[ScriptFolder,'/data/EMM',int2str(yearRef),'.shc'];
 
-if(exist(matFile,'file'))
+if(exist(shcFile,'file'))
+    %A binary coefficient file holds the fully normalized coefficients in
+    %Tesla and their rates of change per year. Only the degrees that are
+    %needed are read.
+    [C,S,~,~,C1,S1]=readSpherHarmonicCoeffFile(shcFile,M);
+    M=C.numClusters()-1;
+    totalNumDriftCoeffs=length(C1.clusterEls);
+    isNormalized=true;
+elseif(exist(matFile,'file'))
     load(matFile,'CCoeffs','SCoeffs','C1Coeffs','S1Coeffs','clustSizesCS','clustSizesC1S1','offsetsCS','offsetsC1S1');
     %Create the ClusterSet classes to hold the data.
     C=ClusterSet();
@@ -160,6 +182,7 @@ if(exist(matFile,'file'))
 
     C1.offsetArray=offsetsC1S1(1:(MDrift+1));
     S1.offsetArray=C1.offsetArray;
+    isNormalized=false;
 else
     %Otherwise, just read the data from the text files.
     
@@ -240,7 +263,28 @@ else
         offsetsC1S1=C1.offsetArray;
 
         save(matFile,'CCoeffs','SCoeffs','C1Coeffs','S1Coeffs','clustSizesCS','clustSizesC1S1','offsetsCS','offsetsC1S1');
+
+        %If the C++ code has been compiled, also save a binary coefficient
+        %file, which holds fully normalized coefficients.
+        if(exist('writeSpherHarmonicCoeffFileCPPInt','file'))
+            CN=C.duplicate();
+            SN=S.duplicate();
+            C1N=C1.duplicate();
+            S1N=S1.duplicate();
+            for n=0:M
+                k=1/sqrt(1+2*n);
+                CN(n+1,:)=k*CN(n+1,:);
+                SN(n+1,:)=k*SN(n+1,:);
+                if(n<=MDrift)
+                    C1N(n+1,:)=k*C1N(n+1,:);
+                    S1N(n+1,:)=k*S1N(n+1,:);
+                end
+            end
+            a=Constants.WMM2010SphereRad;
+            writeSpherHarmonicCoeffFile(shcFile,CN,SN,a,a^2,C1N,S1N,2,yearRef);
+        end
     end
+    isNormalized=false;
 end
 
 %If interpolation to other dates must be performed.
@@ -254,13 +298,36 @@ if(year~=yearRef)
 end
 
 %If the coefficients should be fully normalized.
-if(fullyNormalize~=false)
+%Convert the coefficients to the desired normalization.
+if(fullyNormalize~=false&&~isNormalized)
      for n=0:M
         k=1/sqrt(1+2*n);
         C(n+1,:)=k*C(n+1,:);
         S(n+1,:)=k*S(n+1,:);
      end
+     if(nargout>4)
+        for n=0:(C1.numClusters()-1)
+            k=1/sqrt(1+2*n);
+            C1(n+1,:)=k*C1(n+1,:);
+            S1(n+1,:)=k*S1(n+1,:);
+        end
+     end
+elseif(fullyNormalize==false&&isNormalized)
+     for n=0:M
+        k=sqrt(1+2*n);
+        C(n+1,:)=k*C(n+1,:);
+        S(n+1,:)=k*S(n+1,:);
+     end
+     if(nargout>4)
+        for n=0:(C1.numClusters()-1)
+            k=sqrt(1+2*n);
+            C1(n+1,:)=k*C1(n+1,:);
+            S1(n+1,:)=k*S1(n+1,:);
+        end
+     end
 end
+CDot=C1;
+SDot=S1;
 
 %The EMM2015 model uses the same reference ellipse as the WMM2010.
 a=Constants.WMM2010SphereRad;%meters
@@ -1,4 +1,4 @@
-function [C,S,a,c]=getWMMCoeffs(year,fullyNormalize)
+function [C,S,a,c,CDot,SDot,yearRef]=getWMMCoeffs(year,fullyNormalize)
 %%GETWMMCOEFFS Obtain spherical harmonic coefficients for the 2015 
 %              version of the DoD's World Magnetic Model (WMM) at a
 %              particular time or at the reference epoch (2015). The WMM
@@ -43,10 +43,26 @@ function [C,S,a,c]=getWMMCoeffs(year,fullyNormalize)
 %               sum having units of meters.
 %         c     The constant value by which the spherical harmonic series
 %               is multiplied, having units of squared meters.
+%    CDot, SDot ClusterSet classes holding the rates of change of the
+%               coefficients in Tesla per year, normalized in the same
+%               manner as C and S. These are the secular variation terms
+%               used to go from the reference epoch to the given year.
+%       yearRef The reference epoch of the model as a decimal year. C and
+%               S are CDot and SDot times (year-yearRef) plus the
+%               coefficients at yearRef. Passing C and S at yearRef with
+%               CDot, SDot and yearRef to magneticFieldModel lets the field
+%               be evaluated at many points and times without calling this
+%               function for each time.
 %
 %Details on the normalization of the coefficients is given in the comments
 %to the function spherHarmonicEval.
 %
+%The first time that the coefficients are read from the WMM.COF text file,
+%if the C++ code has been compiled, they are also saved in the binary
+%coefficient file WMM.shc in the data folder, along with their rates of
+%change (see writeSpherHarmonicCoeffFile). Subsequent calls read that file
+%instead.
+%
 %Documentation for the WMM is given in
 %S. Maus, S. McLean, M. Nair, and C. Rollins, "The US/UK
 %world magnetic model for 2010-2015," National Oceanographic and
@@ -60,92 +76,125 @@ function [C,S,a,c]=getWMMCoeffs(year,fullyNormalize)
 %January 2015 David F. Crouse, Naval Research Laboratory, Washington D.C.
 %(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
 
-%Read the WMM data file, which should be located in a data folder that is
-%in the same folder as this file.
+if(nargin<2)
+   fullyNormalize=true; 
+end
+
+%The WMM data files should be located in a data folder that is in the same
+%folder as this file.
 ScriptPath=mfilename('fullpath');
 ScriptFolder = fileparts(ScriptPath);
+shcFile=[ScriptFolder,'/data/WMM.shc'];
+
+if(exist(shcFile,'file'))
+    %A binary coefficient file holds the fully normalized coefficients in
+    %Tesla and their rates of change per year.
+    [C,S,~,~,C1,S1,~,yearRef]=readSpherHarmonicCoeffFile(shcFile);
+    M=C.numClusters()-1;
+    isNormalized=true;
+else
+    %Read the WMM data file.
+    fileID=fopen([ScriptFolder,'/data/WMM.COF']);
+    data=textscan(fileID,'%s','CommentStyle','#','whitespace',' ','delimiter','\n');
+    fclose(fileID);
+    data=data{1};
+    %data{1} is just a bunch of labels that can be ignored. The last two
+    %rows in data are just a bunch of 9's and can also be ignored.
+
+    %Put all of the elements for each row into a cell array.
+    numRows=length(data)-3;
+    rowData=cell(numRows,1);
+    for curRow=1:numRows
+        V=textscan(data{curRow+1},'%f %f %f %f %f %f','whitespace',' ');
+        rowData{curRow}=V;
+    end
+
+    %The reference year
+    yearRef=2015.0;
+    M=12;%The maximum degree and order of the model.
+
+    %Allocate space for the coefficients and their rates of change, which
+    %are needed so that interpolation between the years can be performed,
+    %if necessary.
+    totalNumCoeffs=(M+1)*(M+2)/2;
+    emptyData=zeros(totalNumCoeffs,1);
+    clustSizes=1:(M+1);
+    C=ClusterSet(emptyData,clustSizes);
+    S=ClusterSet(emptyData,clustSizes);
+    C1=ClusterSet(emptyData,clustSizes);
+    S1=ClusterSet(emptyData,clustSizes);
 
-fileID=fopen([ScriptFolder,'/data/WMM.COF']);
-data=textscan(fileID,'%s','CommentStyle','#','whitespace',' ','delimiter','\n');
-fclose(fileID);
-data=data{1};
-%data{1} is just a bunch of labels that can be ignored. The last two rows
-%in data are just a bunch of 9's and can also be ignored.
-
-%Put all of the elements for each row into a cell array.
-numRows=length(data)-3;
-rowData=cell(numRows,1);
-for curRow=1:numRows
-    V=textscan(data{curRow+1},'%f %f %f %f %f %f','whitespace',' ');
-    rowData{curRow}=V;
+    putCoeffsIntoC(rowData,C,3);
+    putCoeffsIntoC(rowData,S,4);
+    %The slopes for interpolation.
+    putCoeffsIntoC(rowData,C1,5);
+    putCoeffsIntoC(rowData,S1,6);
+
+    %Change the units from Nanotesla to Tesla.
+    C(:)=10^(-9)*C(:);
+    S(:)=10^(-9)*S(:);
+    C1(:)=10^(-9)*C1(:);
+    S1(:)=10^(-9)*S1(:);
+    isNormalized=false;
+
+    %If the C++ code has been compiled, save a binary coefficient file so
+    %that future reads are faster. The file holds fully normalized
+    %coefficients.
+    if(exist('writeSpherHarmonicCoeffFileCPPInt','file'))
+        CN=C.duplicate();
+        SN=S.duplicate();
+        C1N=C1.duplicate();
+        S1N=S1.duplicate();
+        for n=0:M
+            k=1/sqrt(1+2*n);
+            CN(n+1,:)=k*CN(n+1,:);
+            SN(n+1,:)=k*SN(n+1,:);
+            C1N(n+1,:)=k*C1N(n+1,:);
+            S1N(n+1,:)=k*S1N(n+1,:);
+        end
+        a=Constants.WMM2010SphereRad;
+        writeSpherHarmonicCoeffFile(shcFile,CN,SN,a,a^2,C1N,S1N,2,yearRef);
+    end
 end
 
-%The reference year
-yearRef=2015.0;
-M=12;%The maximum degree and order of the model.
-
-%Allocate space for two sets of coefficients. these are needed so that
-%interpolation between the years can be performed, if necessary.
-totalNumCoeffs=(M+1)*(M+2)/2;
-emptyData=zeros(totalNumCoeffs,1);
-clustSizes=1:(M+1);
-C=ClusterSet(emptyData,clustSizes);
-S=ClusterSet(emptyData,clustSizes);
-C1=ClusterSet(emptyData,clustSizes);
-S1=ClusterSet(emptyData,clustSizes);
-
-%The closest two years of coefficients for the data must be extracted from
-%rowData in so that one can linearly interpolate the coefficients to the
-%proper time. If the time requested falls after the final year, then the SV
-%values must be taken from rowData for future interpolation. If no date is
-%given, then the final reference date in the model is used and no
+%If no date is given, then the reference date in the model is used and no
 %interpolation is performed.
-
 if(nargin==0)
     year=yearRef;
 end
 
-if(nargin<2)
-   fullyNormalize=true; 
-end
-
 if(year~=yearRef)
     if(year<yearRef)
         warning('Interpolation to past years might not be accurate');
     end
-    
-    putCoeffsIntoC(rowData,C,3);
-    putCoeffsIntoC(rowData,S,4);
-    %The slopes for interpolation.
-    putCoeffsIntoC(rowData,C1,5);
-    putCoeffsIntoC(rowData,S1,6);
-    
+
     yearDiff=year-yearRef;
-    
+
     %Perform linear interpolation.
-    for n=0:M
-        for m=0:n
-            C(n+1,m+1)=C(n+1,m+1)+yearDiff*C1(n+1,m+1);
-            S(n+1,m+1)=S(n+1,m+1)+yearDiff*S1(n+1,m+1);
-        end
-    end
-else
-    putCoeffsIntoC(rowData,C,3);
-    putCoeffsIntoC(rowData,S,4);
+    C.clusterEls=C.clusterEls+yearDiff*C1.clusterEls;
+    S.clusterEls=S.clusterEls+yearDiff*S1.clusterEls;
 end
 
-%Change the units from Nanotesla to Tesla.
-C(:)=10^(-9)*C(:);
-S(:)=10^(-9)*S(:);
-
-%If the coefficients should be fully normalized.
-if(fullyNormalize~=false)
+%Convert the coefficients to the desired normalization.
+if(fullyNormalize~=false&&~isNormalized)
      for n=0:M
         k=1/sqrt(1+2*n);
         C(n+1,:)=k*C(n+1,:);
         S(n+1,:)=k*S(n+1,:);
+        C1(n+1,:)=k*C1(n+1,:);
+        S1(n+1,:)=k*S1(n+1,:);
+     end
+elseif(fullyNormalize==false&&isNormalized)
+     for n=0:M
+        k=sqrt(1+2*n);
+        C(n+1,:)=k*C(n+1,:);
+        S(n+1,:)=k*S(n+1,:);
+        C1(n+1,:)=k*C1(n+1,:);
+        S1(n+1,:)=k*S1(n+1,:);
      end
 end
+CDot=C1;
+SDot=S1;
 
 a=Constants.WMM2010SphereRad;%meters
 c=a^2;
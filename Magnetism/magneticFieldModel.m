@@ -0,0 +1,348 @@
+classdef magneticFieldModel < handle
+%%MAGNETICFIELDMODEL A class holding a time-varying geomagnetic field
+%                    model, such as the World Magnetic Model (WMM) or the
+%                    Enhanced Magnetic Model (EMM), so that the magnetic
+%                    flux density can be evaluated at many points, each at
+%                    its own time, without forming the coefficients for
+%                    each time. If a C++ class interface has been
+%                    compiled, then the coefficients are copied to C++
+%                    once when the model is created. Otherwise, the
+%                    evaluate method calls spherHarmonicEval once per
+%                    distinct time.
+%
+%Functions such as getWMMCoeffs and getEMMCoeffs return the coefficients at
+%a single time, so evaluating the field along a trajectory means
+%reloading and renormalizing all of the coefficients at every time step.
+%However, the models are linear in time: the coefficients at time t are
+%C+(t-t0)*CDot and S+(t-t0)*SDot, where t0 is the reference epoch. Since
+%the potential is linear in the coefficients, the field at time t is the
+%field of the main-field coefficients plus (t-t0) times the field of the
+%secular-variation coefficients. The C++ implementation evaluates the two
+%series separately at all of the points at once, so the costly
+%high-degree main field is summed once per point regardless of the times
+%and the secular variation, which is only given to a low degree, adds
+%little. Models that are only piecewise linear in time, such as the IGRF,
+%can be handled by creating one model per interval.
+%
+%Note that if the C++ implementation is used, the mex file is locked when a
+%magneticFieldModel object is created and is not unlocked (and able to be
+%recompiled) until all of the magneticFieldModel objects have been freed.
+%
+%EXAMPLE:
+%Here, the field of the WMM is evaluated in North-East-Down coordinates
+%along a trajectory, with each point at a different time.
+% [C,S,a,c,CDot,SDot,yearRef]=getWMMCoeffs();
+% model=magneticFieldModel(C,S,CDot,SDot,yearRef,a,c);
+% numPoints=100;
+% plhPoints=[linspace(0,deg2rad(40),numPoints);
+%            linspace(0,deg2rad(-70),numPoints);
+%            linspace(0,10e3,numPoints)];
+% years=linspace(2016,2017,numPoints);
+% BNED=model.evaluate(plhPoints,years,'NED');
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+properties(SetAccess=private)
+    M%The maximum degree of the main field.
+    MDot%The maximum degree of the secular variation.
+    refEpoch%The epoch at which the main-field coefficients apply.
+    a%The numerator in the (a/r)^n term.
+    c%The constant by which the series is multiplied.
+    scalFactor%The scale factor used in the Legendre recursion.
+end
+
+properties(Access=private)
+    %These are only used if the C++ implementation does not exist.
+    C
+    S
+    CDot
+    SDot
+    CPPData%Only used if an interface to a C++ implementation exists.
+end
+
+methods
+    function newModel=magneticFieldModel(C,S,CDot,SDot,refEpoch,a,c,fullyNormalized,scalFactor)
+    %%MAGNETICFIELDMODEL Create a new time-varying geomagnetic field model.
+    %
+    %INPUTS: C, S ClusterSet classes holding the main-field coefficients at
+    %             the reference epoch in Tesla, as returned by getWMMCoeffs
+    %             or getEMMCoeffs when evaluated at their reference epochs.
+    %             Alternatively, C can be the name of a coefficient file
+    %             written by writeSpherHarmonicCoeffFile, in which case all
+    %             of the other inputs except scalFactor are ignored and
+    %             empty matrices can be passed for them. The secular
+    %             variation and reference epoch are then taken from the
+    %             file if it holds rates of change (auxType=2), as the
+    %             WMM.shc and EMM<year>.shc files written by getWMMCoeffs
+    %             and getEMMCoeffs do.
+    %  CDot, SDot ClusterSet classes holding the rates of change of C and S
+    %             per unit time (normally per year). These can have a lower
+    %             maximum degree than C and S. If empty matrices are
+    %             passed, the field does not vary with time.
+    %    refEpoch The time at which C and S apply, in the same units as the
+    %             times passed to evaluate (normally decimal years). The
+    %             default if omitted or an empty matrix is passed is 0.
+    % a, c, fullyNormalized, scalFactor These are the same as in
+    %             spherHarmonicEval. The defaults of a and c if omitted or
+    %             empty matrices are passed are Constants.WMM2010SphereRad
+    %             and its square. fullyNormalized applies to both C, S and
+    %             CDot, SDot.
+    %
+    %OUTPUTS: newModel A new magneticFieldModel instance. The coefficients
+    %                  are copied.
+
+        if(nargin<9||isempty(scalFactor))
+            scalFactor=10^(-280);
+        end
+
+        if(nargin<8||isempty(fullyNormalized))
+            fullyNormalized=true;
+        end
+
+        if(nargin<6||isempty(a))
+            a=Constants.WMM2010SphereRad;
+        end
+
+        if(nargin<7||isempty(c))
+            c=a^2;
+        end
+
+        if(nargin<5||isempty(refEpoch))
+            refEpoch=0;
+        end
+
+        if(nargin<4)
+            CDot=[];
+            SDot=[];
+        end
+
+        newModel.scalFactor=scalFactor;
+
+        %If the coefficients are in a file.
+        if(ischar(C))
+            fileName=C;
+            if(exist('magneticFieldModelCPPInt','file'))
+                [newModel.CPPData,M,MDot,refEpoch,a,c]=magneticFieldModelCPPInt('magneticFieldModelFromFileCPP',fileName,scalFactor);
+                newModel.M=double(M);
+                newModel.MDot=double(MDot);
+                newModel.refEpoch=refEpoch;
+                newModel.a=a;
+                newModel.c=c;
+                return;
+            end
+
+            %Coefficient files always hold fully normalized coefficients.
+            [C,S,a,c,CDot,SDot,auxType,refEpoch]=readSpherHarmonicCoeffFile(fileName);
+            if(auxType~=2)
+                CDot=[];
+                SDot=[];
+                refEpoch=0;
+            end
+            fullyNormalized=true;
+        end
+
+        M=C.numClusters()-1;
+        if(M<3)
+            error('The coefficients must be provided to at least degree 3. To use a lower degree, one can insert zero coefficients.');
+        end
+
+        if(isempty(CDot))
+            MDot=0;
+        else
+            MDot=CDot.numClusters()-1;
+            if(MDot<3)
+                error('The secular variation coefficients must be provided to at least degree 3. To use a lower degree, one can insert zero coefficients.');
+            end
+        end
+
+        newModel.M=M;
+        newModel.MDot=MDot;
+        newModel.refEpoch=refEpoch;
+        newModel.a=a;
+        newModel.c=c;
+
+        %The coefficients are normalized in the same manner as in
+        %spherHarmonicEval.
+        if(fullyNormalized==false)
+            C=normalizeCoeffs(C);
+            S=normalizeCoeffs(S);
+            if(~isempty(CDot))
+                CDot=normalizeCoeffs(CDot);
+                SDot=normalizeCoeffs(SDot);
+            end
+        end
+
+        if(exist('magneticFieldModelCPPInt','file'))
+            if(isempty(CDot))
+                newModel.CPPData=magneticFieldModelCPPInt('magneticFieldModelCPP',C.clusterEls,S.clusterEls,M,[],[],0,refEpoch,a,c,scalFactor);
+            else
+                newModel.CPPData=magneticFieldModelCPPInt('magneticFieldModelCPP',C.clusterEls,S.clusterEls,M,CDot.clusterEls,SDot.clusterEls,MDot,refEpoch,a,c,scalFactor);
+            end
+        else
+            newModel.C=C.duplicate();
+            newModel.S=S.duplicate();
+            if(~isempty(CDot))
+                newModel.CDot=CDot.duplicate();
+                newModel.SDot=SDot.duplicate();
+            end
+        end
+    end
+
+    function B=evaluate(theModel,plhPoints,times,frame,aEllips,fEllips,numThreads)
+    %%EVALUATE Evaluate the magnetic flux density at a set of points, each
+    %          at a given time.
+    %
+    %INPUTS: theModel The magneticFieldModel instance.
+    %       plhPoints The 3XN set of points given in geodetic
+    %                 [latitude;longitude;height] coordinates with respect
+    %                 to the reference ellipsoid, with the latitude and
+    %                 longitude in radians and the height in meters.
+    %           times Either a scalar time at which all of the points are
+    %                 evaluated or a 1XN vector of times, one per point, in
+    %                 the same units as the reference epoch (normally
+    %                 decimal years). The default if omitted or an empty
+    %                 matrix is passed is the reference epoch.
+    %           frame A string specifying the coordinate system of the
+    %                 output. Possible values are
+    %                 'ECEF' (The default if omitted or an empty matrix is
+    %                        passed) Cartesian ECEF coordinates.
+    %                 'ENU'  Local East-North-Up coordinates at each point.
+    %                 'NED'  Local North-East-Down coordinates at each
+    %                        point.
+    % aEllips, fEllips The semi-major axis and the flattening factor of the
+    %                 reference ellipsoid. If omitted or empty matrices are
+    %                 passed, Constants.WGS84SemiMajorAxis and
+    %                 Constants.WGS84Flattening are used.
+    %      numThreads The optional number of threads across which the
+    %                 points are split, as in spherHarmonicEval. The
+    %                 default if omitted or an empty matrix is passed is 1.
+    %
+    %OUTPUTS: B The 3XN magnetic flux density in Tesla at each point in the
+    %           selected coordinate system.
+
+        if(nargin<7||isempty(numThreads))
+            numThreads=1;
+        end
+
+        if(nargin<6||isempty(fEllips))
+            fEllips=Constants.WGS84Flattening;
+        end
+
+        if(nargin<5||isempty(aEllips))
+            aEllips=Constants.WGS84SemiMajorAxis;
+        end
+
+        if(nargin<4||isempty(frame))
+            frame='ECEF';
+        end
+
+        if(nargin<3||isempty(times))
+            times=theModel.refEpoch;
+        end
+
+        switch(frame)
+            case 'ECEF'
+                frameIdx=0;
+            case 'ENU'
+                frameIdx=1;
+            case 'NED'
+                frameIdx=2;
+            otherwise
+                error('Invalid frame specified.');
+        end
+
+        if(size(plhPoints,1)~=3)
+            error('The points must be 3-dimensional.');
+        end
+        numPoints=size(plhPoints,2);
+
+        if(~isscalar(times)&&length(times)~=numPoints)
+            error('There must be one time or one time per point.');
+        end
+
+        if(exist('magneticFieldModelCPPInt','file'))
+            B=magneticFieldModelCPPInt('evaluate',theModel.CPPData,plhPoints,times(:).',frameIdx,aEllips,fEllips,numThreads);
+            return;
+        end
+
+        pointsSpher=ellips2Sphere(plhPoints,aEllips,fEllips);
+        B=zeros(3,numPoints);
+
+        if(isempty(theModel.CDot))
+            [~,gradV]=spherHarmonicEval(theModel.C,theModel.S,pointsSpher,theModel.a,theModel.c,true,theModel.scalFactor,numThreads);
+            B=-gradV;
+        else
+            %Form the coefficients once per distinct time.
+            if(isscalar(times))
+                times=repmat(times,1,numPoints);
+            end
+            [uniqueTimes,~,timeIdx]=unique(times(:));
+            numDriftCoeffs=length(theModel.CDot.clusterEls);
+            CCur=theModel.C.duplicate();
+            SCur=theModel.S.duplicate();
+            for curTime=1:length(uniqueTimes)
+                sel=(timeIdx==curTime);
+                deltaT=uniqueTimes(curTime)-theModel.refEpoch;
+
+                CCur.clusterEls(1:numDriftCoeffs)=theModel.C.clusterEls(1:numDriftCoeffs)+deltaT*theModel.CDot.clusterEls;
+                SCur.clusterEls(1:numDriftCoeffs)=theModel.S.clusterEls(1:numDriftCoeffs)+deltaT*theModel.SDot.clusterEls;
+
+                [~,gradV]=spherHarmonicEval(CCur,SCur,pointsSpher(:,sel),theModel.a,theModel.c,true,theModel.scalFactor,numThreads);
+                B(:,sel)=-gradV;
+            end
+        end
+
+        if(frameIdx~=0)
+            for curPoint=1:numPoints
+                u=getENUAxes(plhPoints(:,curPoint),false,aEllips,fEllips);
+                BENU=u'*B(:,curPoint);
+                if(frameIdx==1)
+                    B(:,curPoint)=BENU;
+                else
+                    B(:,curPoint)=[BENU(2);BENU(1);-BENU(3)];
+                end
+            end
+        end
+    end
+
+    function delete(theModel)
+    %%DELETE The destructor method. This method is used when the model is
+    %        implemented as a C++ class. This method prevents a memory
+    %        leak.
+
+        if(exist('magneticFieldModelCPPInt','file')&&~isempty(theModel.CPPData))
+            magneticFieldModelCPPInt('~magneticFieldModelCPP',theModel.CPPData);
+        end
+    end
+end
+end
+
+function C=normalizeCoeffs(C)
+%%NORMALIZECOEFFS Convert Schmidt semi-normalized coefficients into fully
+%                 normalized coefficients, as in spherHarmonicEval. A copy
+%                 is returned.
+
+    C=C.duplicate();
+    for n=0:(C.numClusters()-1)
+        k=1/sqrt(1+2*n);
+        C(n+1,:)=k*C(n+1,:);
+    end
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
@@ -0,0 +1,223 @@
+/**MAGNETICFIELDMODELCPPINT An interface between the Matlab
+ *              magneticFieldModel class and the C++ MagneticFieldModelCPP
+ *              class, which holds a time-varying geomagnetic field model
+ *              that has been loaded once so that it can be evaluated
+ *              repeatedly at arbitrary points and times. This function is
+ *              meant to be called by the magneticFieldModel class in
+ *              Matlab; not directly by the user. Running the function
+ *              with invalid inputs can crash Matlab.
+ *
+ *The function is called as
+ *CPPData=magneticFieldModelCPPInt('magneticFieldModelCPP',CCoeffs,SCoeffs,M,CDotCoeffs,SDotCoeffs,MDot,refEpoch,a,c,scalFactor);
+ *where CCoeffs and SCoeffs are the clusterEls members of the ClusterSet
+ *classes holding fully normalized main-field coefficients up to degree M
+ *and CDotCoeffs and SDotCoeffs are those of the secular-variation
+ *coefficients up to degree MDot (empty matrices if the field does not vary
+ *with time),
+ *or
+ *[CPPData,M,MDot,refEpoch,a,c]=magneticFieldModelCPPInt('magneticFieldModelFromFileCPP',fileName,scalFactor);
+ *where fileName is a coefficient file written by
+ *writeSpherHarmonicCoeffFile, whose auxiliary coefficients, if they are
+ *rates of change, are the secular variation. MDot is 0 if the file holds
+ *no rates of change,
+ *or
+ *B=magneticFieldModelCPPInt('evaluate',CPPData,plhPoints,times,frame,aEllips,fEllips,numThreads);
+ *where plhPoints is 3XnumPoints, times is a scalar or a 1XnumPoints
+ *vector, frame is 0 for ECEF, 1 for ENU and 2 for NED and B is
+ *3XnumPoints,
+ *or
+ *magneticFieldModelCPPInt('~magneticFieldModelCPP',CPPData);
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For strcmp
+#include <cstring>
+//For make_shared
+#include <memory>
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "magneticFieldModelCPP.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    char cmd[64];
+    MagneticFieldModelCPP *theModel;
+
+    if(nrhs<2) {
+        mexErrMsgTxt("Not enough inputs.");
+    }
+
+    if(nrhs>11) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+
+    //Get the command string that is passed.
+    mxGetString(prhs[0], cmd, sizeof(cmd));
+
+    if(!strcmp("magneticFieldModelCPP", cmd)) {
+        size_t M, MDot, numCoeffs;
+        double refEpoch, a, c, scalFactor;
+        double *CDotCoeffs, *SDotCoeffs;
+
+        if(nrhs!=11) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        checkRealDoubleArray(prhs[1]);
+        checkRealDoubleArray(prhs[2]);
+        M=getSizeTFromMatlab(prhs[3]);
+        refEpoch=getDoubleFromMatlab(prhs[7]);
+        a=getDoubleFromMatlab(prhs[8]);
+        c=getDoubleFromMatlab(prhs[9]);
+        scalFactor=getDoubleFromMatlab(prhs[10]);
+
+        numCoeffs=(M+1)*(M+2)/2;
+        if(mxGetNumberOfElements(prhs[1])!=numCoeffs||mxGetNumberOfElements(prhs[2])!=numCoeffs) {
+            mexErrMsgTxt("The number of coefficients does not match the maximum degree.");
+        }
+
+        if(mxIsEmpty(prhs[4])||mxIsEmpty(prhs[5])) {
+            CDotCoeffs=NULL;
+            SDotCoeffs=NULL;
+            MDot=0;
+        } else {
+            checkRealDoubleArray(prhs[4]);
+            checkRealDoubleArray(prhs[5]);
+            MDot=getSizeTFromMatlab(prhs[6]);
+
+            numCoeffs=(MDot+1)*(MDot+2)/2;
+            if(mxGetNumberOfElements(prhs[4])!=numCoeffs||mxGetNumberOfElements(prhs[5])!=numCoeffs) {
+                mexErrMsgTxt("The number of secular variation coefficients does not match the maximum degree.");
+            }
+
+            CDotCoeffs=(double*)mxGetData(prhs[4]);
+            SDotCoeffs=(double*)mxGetData(prhs[5]);
+        }
+
+        theModel=new MagneticFieldModelCPP((double*)mxGetData(prhs[1]),(double*)mxGetData(prhs[2]),M,CDotCoeffs,SDotCoeffs,MDot,refEpoch,a,c,scalFactor);
+
+        //Lock this mex file so that it can not be cleared until the object
+        //has been deleted (This avoids a memory leak).
+        mexLock();
+        //Return the pointer to the model.
+        plhs[0]=ptr2Matlab<MagneticFieldModelCPP*>(theModel);
+    } else if(!strcmp("magneticFieldModelFromFileCPP", cmd)) {
+        std::shared_ptr<SpherHarmonicCoeffFileCPP> coeffFile;
+        char *fileName;
+        double scalFactor;
+        size_t MDot;
+        int retVal;
+
+        if(nrhs!=3) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>6) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        if(!mxIsChar(prhs[1])) {
+            mexErrMsgTxt("The file name must be a string.");
+        }
+        scalFactor=getDoubleFromMatlab(prhs[2]);
+
+        fileName=mxArrayToString(prhs[1]);
+        coeffFile=std::make_shared<SpherHarmonicCoeffFileCPP>();
+        retVal=coeffFile->open(fileName);
+        mxFree(fileName);
+        if(retVal!=SPHER_HARMONIC_COEFF_OK) {
+            mexErrMsgTxt(SpherHarmonicCoeffFileCPP::errorString(retVal));
+        }
+
+        theModel=new MagneticFieldModelCPP(coeffFile,scalFactor);
+
+        //Lock this mex file so that it can not be cleared until the object
+        //has been deleted (This avoids a memory leak).
+        mexLock();
+        plhs[0]=ptr2Matlab<MagneticFieldModelCPP*>(theModel);
+        if(nlhs>1) {
+            plhs[1]=unsignedSizeMat2Matlab(&(theModel->mainField->M),1,1);
+        }
+        if(nlhs>2) {
+            MDot=theModel->secVar?theModel->secVar->M:0;
+            plhs[2]=unsignedSizeMat2Matlab(&MDot,1,1);
+        }
+        if(nlhs>3) {
+            plhs[3]=doubleMat2Matlab(&(theModel->refEpoch),1,1);
+        }
+        if(nlhs>4) {
+            plhs[4]=doubleMat2Matlab(&(theModel->mainField->a),1,1);
+        }
+        if(nlhs>5) {
+            plhs[5]=doubleMat2Matlab(&(theModel->mainField->c),1,1);
+        }
+    } else if(!strcmp("evaluate", cmd)) {
+        size_t numPoints, numTimes, numThreads;
+        double aEllips, fEllips;
+        int frame;
+        mxArray *BMATLAB;
+
+        if(nrhs!=8) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>1) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theModel=Matlab2Ptr<MagneticFieldModelCPP*>(prhs[1]);
+
+        checkRealDoubleArray(prhs[2]);
+        if(mxGetM(prhs[2])!=3) {
+            mexErrMsgTxt("The points must be 3-dimensional.");
+        }
+        numPoints=mxGetN(prhs[2]);
+
+        checkRealDoubleArray(prhs[3]);
+        numTimes=mxGetNumberOfElements(prhs[3]);
+        if(numTimes!=1&&numTimes!=numPoints) {
+            mexErrMsgTxt("There must be one time or one time per point.");
+        }
+
+        frame=static_cast<int>(getSizeTFromMatlab(prhs[4]));
+        if(frame!=MAGNETIC_FIELD_FRAME_ECEF&&frame!=MAGNETIC_FIELD_FRAME_ENU&&frame!=MAGNETIC_FIELD_FRAME_NED) {
+            mexErrMsgTxt("Invalid frame specified.");
+        }
+        aEllips=getDoubleFromMatlab(prhs[5]);
+        fEllips=getDoubleFromMatlab(prhs[6]);
+        numThreads=getSizeTFromMatlab(prhs[7]);
+
+        BMATLAB=mxCreateDoubleMatrix(3,numPoints,mxREAL);
+        if(numPoints>0) {
+            theModel->evaluate((double*)mxGetData(BMATLAB),(double*)mxGetData(prhs[2]),(double*)mxGetData(prhs[3]),numPoints,numTimes==1,frame,aEllips,fEllips,numThreads);
+        }
+        plhs[0]=BMATLAB;
+    } else if(!strcmp("~magneticFieldModelCPP", cmd)) {
+        theModel=Matlab2Ptr<MagneticFieldModelCPP*>(prhs[1]);
+
+        delete theModel;
+        //Unlock the mex file allowing it to be cleared.
+        mexUnlock();
+    } else {
+        mexErrMsgTxt("Invalid string passed to magneticFieldModelCPPInt.");
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
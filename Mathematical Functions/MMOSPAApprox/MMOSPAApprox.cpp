@@ -20,6 +20,18 @@
 *                    though more scans can improve the estimate, global
 *                    convergence is not guaranteed. The default is 1 if
 *                    this parameter is not provided.
+*           numStarts An optional parameter >=1 specifying how many times
+*                    to run the algorithm using different hypotheses as the
+*                    reference that fixes the target ordering. The first
+*                    run uses the first hypothesis and the others use the
+*                    remaining hypotheses in order of decreasing weight.
+*                    The result with the lowest MOSPA cost is kept. The
+*                    default if omitted or an empty matrix is passed is 1.
+*           numThreads An optional parameter specifying the number of
+*                    threads to use to perform the runs in parallel when
+*                    numStarts>1. The default if omitted or an empty matrix
+*                    is passed is 0, which means use the number of hardware
+*                    threads.
 * 
 * OUTPUTS:  MMOSPAEst The approximate xDim X numTar MMOSPA estimate.
 *           orderList A numTarXnumHyp matrix specifying the ordering of the
@@ -41,7 +53,11 @@
 * The basic algorithm uses sequential 2D assignment going forward to
 * approximate the MMOSPA estimate. If desired, assignments can be
 * reevaluated in additional backward-forward passes to try to obtain an
-* approximation close to the true MMOSPA estimate.
+* approximation close to the true MMOSPA estimate. The cost matrices of the
+* assignment problems are filled as small matrix products.
+*
+* For a small number of targets and hypotheses, the exact MMOSPA estimate
+* can be found using the function MMOSPAExact.
 *
 * The algorithm as well as the concept of MOSPA error are described in
 * detail in 
@@ -53,7 +69,7 @@
 * CompileCLibraries function.
 *
 * The algorithm is run in Matlab using the command format
-* [MMOSPAEst,orderList]=MMOSPAApprox(x,w,numScans);
+* [MMOSPAEst,orderList]=MMOSPAApprox(x,w,numScans,numStarts,numThreads);
 *
 * November 2013 David F. Crouse, Naval Research Laboratory, Washington D.C.*/
 /*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
@@ -68,6 +84,8 @@ using namespace std;
 
 void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
     size_t xDim,numTar,numHyp,numScans;
+    size_t numStarts=1;
+    size_t numThreads=0;
     mxArray *MMOSPAEstMATLAB,*orderListMATLAB;//These will hold the values to be returned.
     const mwSize *xDims;
     double *MMOSPAEst,*x,*w;
@@ -78,7 +96,7 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
         return;
     }
     
-    if(nrhs<3){
+    if(nrhs<3||mxIsEmpty(prhs[2])){
         numScans=1;
     }else {
         numScans=getSizeTFromMatlab(prhs[2]);
@@ -89,7 +107,20 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
         }
     }
     
-    if(nrhs>3) {
+    if(nrhs>3&&!mxIsEmpty(prhs[3])) {
+        numStarts=getSizeTFromMatlab(prhs[3]);
+        
+        if(numStarts<1) {
+            mexErrMsgTxt("Invalid number of starts specified.");
+            return;
+        }
+    }
+    
+    if(nrhs>4&&!mxIsEmpty(prhs[4])) {
+        numThreads=getSizeTFromMatlab(prhs[4]);
+    }
+    
+    if(nrhs>5) {
         mexErrMsgTxt("Too many inputs.");
         return;
     }
@@ -142,7 +173,9 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
                     xDim,
                     numTar,
                     numHyp,
-                    numScans);
+                    numScans,
+                    numStarts,
+                    numThreads);
     
 /*Set the outputs*/
      switch(nlhs) {
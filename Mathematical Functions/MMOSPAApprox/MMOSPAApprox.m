@@ -1,4 +1,4 @@
-function [MMOSPAEst,orderList]=MMOSPAApprox(x,w,numScans)
+function [MMOSPAEst,orderList]=MMOSPAApprox(x,w,numScans,numStarts,numThreads)
 %%MMOSPAAPPROX  Find the approximate minimum mean optimal sub-pattern
 %               assignment (MMOSPA) estimate from a set of weighted 
 %               discrete sets of target estiamtes using 2D assignment in a
@@ -21,6 +21,18 @@ function [MMOSPAEst,orderList]=MMOSPAApprox(x,w,numScans)
 %                    though more scans can improve the estimate, global
 %                    convergence is not guaranteed. The default is 1 if
 %                    this parameter is not provided.
+%           numStarts An optional parameter >=1 specifying how many times
+%                    to run the algorithm using different hypotheses as the
+%                    reference that fixes the target ordering. The first
+%                    run uses the first hypothesis and the others use the
+%                    remaining hypotheses in order of decreasing weight.
+%                    The result with the lowest MOSPA cost is kept. The
+%                    default if omitted or an empty matrix is passed is 1.
+%           numThreads The number of threads to use for the runs when
+%                    numStarts>1. This is only used by the compiled version
+%                    of this function. The default if omitted or an empty
+%                    matrix is passed is 0, which means use the number of
+%                    hardware threads.
 %
 %OUTPUTS:   MMOSPAEst The approximate xDim X numTar MMOSPA estimate.
 %           orderList A numTarXnumHyp matrix specifying the ordering of the
@@ -44,6 +56,9 @@ function [MMOSPAEst,orderList]=MMOSPAApprox(x,w,numScans)
 %reevaluated in additional backward-forward passes to try to obtain an
 %approximation close to the true MMOSPA estimate.
 %
+%For a small number of targets and hypotheses, the exact MMOSPA estimate
+%can be found using the compiled function MMOSPAExact.
+%
 %The algorithm as well as the concept of MOSPA error are described in
 %detail in 
 %D. F. Crouse, "Advances in displaying uncertain estimates of multiple
@@ -53,9 +68,43 @@ function [MMOSPAEst,orderList]=MMOSPAApprox(x,w,numScans)
 %October 2013 David F. Crouse, Naval Research Laboratory, Washington D.C.
 %(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
 
-    if(nargin<3)
+    if(nargin<3||isempty(numScans))
         numScans=1;
     end
+    
+    if(nargin<4||isempty(numStarts))
+        numStarts=1;
+    end
+    
+    numHyp=size(x,3);
+    numStarts=min(numStarts,numHyp);
+
+    %The first run uses the first hypothesis as the reference. The others
+    %use the remaining hypotheses in order of decreasing weight.
+    [~,sortIdx]=sort(w(2:end),'descend');
+    refHyps=[1;sortIdx(:)+1];
+
+    bestVal=-Inf;
+    for curStart=1:numStarts
+        refHyp=refHyps(curStart);
+        hypOrder=[refHyp,1:(refHyp-1),(refHyp+1):numHyp];
+        
+        [curEst,curOrderList]=MMOSPAApproxScans(x(:,:,hypOrder),w(hypOrder),numScans);
+        
+        %The MOSPA cost is lowest when the norm of the estimate is largest.
+        curVal=sum(curEst(:).^2);
+        if(curVal>bestVal)
+            bestVal=curVal;
+            MMOSPAEst=curEst;
+            orderList(:,hypOrder)=curOrderList;
+        end
+    end
+end
+
+function [MMOSPAEst,orderList]=MMOSPAApproxScans(x,w,numScans)
+%%MMOSPAAPPROXSCANS Run the forward algorithm followed by numScans-1
+%                   backward-forward scans using the first hypothesis as
+%                   the reference.
 
     %First, get the forward solution, which might be bad.
     [MMOSPAEst,orderList]=MMOSPAApproxForward(x,w);
@@ -0,0 +1,149 @@
+/**MMOSPAEXACT  Find the exact minimum mean optimal sub-pattern assignment
+*               (MMOSPA) estimate from a set of weighted discrete sets of
+*               target estimates using branch-and-bound. This is only
+*               practical for a small number of targets and hypotheses.
+*
+* INPUTS:   x        An xDim X numTar X numHyp hypermatrix that holds
+*                    numHyp hypotheses each consisting or numTar targets
+*                    (or generic vectors) with xDim dimensions per target
+*                    (per generic vector). As in MMOSPAApprox, the
+*                    components of each target vector will generally be
+*                    position only.
+*           w        A numHyp X 1 vector of the probabilities of each of
+*                    the numHyp hypotheses in x. The elements must all be
+*                    positive and sum to one.
+* 
+* OUTPUTS:  MMOSPAEst The xDim X numTar MMOSPA estimate.
+*           orderList A numTarXnumHyp matrix specifying the ordering of the
+*                     targets in each hypothesis that went into the
+*                     MMOSPA estimate. The first column is always 1:numTar.
+* 
+* The MOSPA cost of an estimate is minimized when the squared Frobenius
+* norm of the weighted sum of the reordered hypotheses is maximized. The
+* search is initialized with the output of MMOSPAApprox using two scans
+* and numHyp starts. The orderings of the hypotheses are then chosen one
+* hypothesis at a time, pruning any branch where the norm of the partial
+* sum plus the sum of the weighted norms of the remaining hypotheses cannot
+* exceed the best norm found so far. The worst-case complexity is
+* O((numTar!)^(numHyp-1)).
+*
+* The MMOSPA estimate is described in
+* D. F. Crouse, "Advances in displaying uncertain estimates of multiple
+* targets," in Proceedings of SPIE: Signal Processing, Sensor Fusion, and
+* Target Recognition XXII, vol. 8745, Baltimore, MD, Apr. 2013.
+*
+* The algorithm can be compiled for use in Matlab  using the 
+* CompileCLibraries function.
+*
+* The algorithm is run in Matlab using the command format
+* [MMOSPAEst,orderList]=MMOSPAExact(x,w);
+*/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+/*This header is required by Matlab*/
+#include "mex.h"
+#include "MexValidation.h"
+#include "MMOSPAApproxCPP.hpp"
+#include <algorithm>
+
+using namespace std;
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    size_t xDim,numTar,numHyp;
+    mxArray *MMOSPAEstMATLAB,*orderListMATLAB;//These will hold the values to be returned.
+    const mwSize *xDims;
+    double *MMOSPAEst,*x,*w;
+    size_t *orderList;
+    
+    if(nrhs<2){
+        mexErrMsgTxt("Not enough inputs.");
+        return;
+    }
+    
+    if(nrhs>2) {
+        mexErrMsgTxt("Too many inputs.");
+        return;
+    }
+    
+    if(nlhs>2) {
+        mexErrMsgTxt("Too many outputs.");
+        return;
+    }
+    
+    /*Verify the validity of the x and w parameters.*/
+    checkRealDoubleArray(prhs[0]);
+    checkRealDoubleArray(prhs[1]);
+    
+    xDims=mxGetDimensions(prhs[0]);
+    xDim=xDims[0];
+    numTar=xDims[1];//Matlab should always provide at least a 2D dimension vector.
+    
+    if(mxGetNumberOfDimensions(prhs[0])<3){
+        numHyp=1;
+    } else if(mxGetNumberOfDimensions(prhs[0])>3) {
+        mexErrMsgTxt("The first parameter has too many dimensions.");
+        return;
+    } else {
+        numHyp=xDims[2];
+    }
+    
+    //Check the dimensionality of the second input
+    if(mxGetNumberOfDimensions(prhs[1])>2){
+        mexErrMsgTxt("The second parameter has too may dimensions.");
+        return;
+    }
+    
+    xDims = mxGetDimensions(prhs[1]);
+    if(xDims[0]!=numHyp||xDims[1]!=1) {
+        mexErrMsgTxt("The dimensionality of the second parameter is inconsistent.");
+        return;
+    }
+    
+    //Allocate space for the return variables.
+    MMOSPAEstMATLAB = mxCreateNumericMatrix(xDim,numTar,mxDOUBLE_CLASS,mxREAL);
+    orderListMATLAB=allocUnsignedSizeMatInMatlab(numTar,numHyp);
+
+    MMOSPAEst=(double*)mxGetData(MMOSPAEstMATLAB);
+    orderList=(size_t*)mxGetData(orderListMATLAB);
+
+/*Get the matrices*/
+    x = (double*)mxGetData(prhs[0]); 
+    w = (double*)mxGetData(prhs[1]);
+    
+    //Run the algorithm
+    MMOSPAExactCPP(MMOSPAEst,
+                   orderList,
+                   x,
+                   w,
+                   xDim,
+                   numTar,
+                   numHyp);
+    
+/*Set the outputs*/
+     switch(nlhs) {
+        case 2:
+            /*Convert C++ indices to Matlab indices*/
+            for_each(orderList, orderList+numTar*numHyp, increment<size_t>);
+            plhs[1]=orderListMATLAB;
+        default:
+            plhs[0]=MMOSPAEstMATLAB;
+    }   
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -5,10 +5,16 @@
 
 #include <limits>
 #include <algorithm>
+#include <vector>
+//Needed for sqrt
+#include <math.h>
 #include "MMOSPAApproxCPP.hpp"
+#include "parallelForCPP.hpp"
 
 using namespace std;
 
+class MMOSPAExactState;
+
 //Prototypes for functions not prototyped in the headers.
 void MMOSPAApproxForward(double *MMOSPAEst,
                          size_t *orderList,
@@ -18,7 +24,25 @@ void MMOSPAApproxForward(double *MMOSPAEst,
                          const double *w,
                          const size_t xDim,
                          const size_t numTar,
-                         const size_t numHyp);
+                         const size_t numHyp,
+                         const size_t *hypOrder);
+
+void MMOSPAApproxScans(double *MMOSPAEst,
+                       size_t *orderList,
+                       MurtyHyp *problemSol,
+                       ScratchSpace &workMem,
+                       double *xOptCur,
+                       const double *x,
+                       const double *w,
+                       const size_t xDim,
+                       const size_t numTar,
+                       const size_t numHyp,
+                       const size_t *hypOrder,
+                       size_t numScan);
+
+double fillGainMatrix(double *C, const double *xRow, const double *xCol, const size_t xDim, const size_t numTar);
+
+void MMOSPAExactSearch(MMOSPAExactState &state, const size_t curLevel);
 
 void doUpdate4Col(double *MMOSPAEst,
                   size_t *orderList,
@@ -70,6 +94,140 @@ inline void vecScalMadd(double *vec1, const double scalarVal, const double *vec2
     }
 }
 
+double fillGainMatrix(double *C, const double *xRow, const double *xCol, const size_t xDim, const size_t numTar) {
+/**FILLGAINMATRIX Fill the numTarXnumTar matrix C (stored by column) with
+ *         C(curRow,curCol)=sum(xRow(:,curRow).*xCol(:,curCol)), where
+ *         xRow and xCol are xDimXnumTar matrices. That is, C=xRow'*xCol.
+ *         The maximum element of C is returned. The product is computed
+ *         in 2X2 blocks so that each element loaded from xRow and xCol is
+ *         used twice. Each element is still accumulated in the same order
+ *         as in dotProduct, so the results are identical to filling C
+ *         one dotProduct at a time.
+ */
+    const size_t numTarEven=numTar-numTar%2;
+    double cMax=-numeric_limits<double>::infinity();
+    size_t curRow, curCol, k;
+
+    for(curCol=0;curCol<numTarEven;curCol+=2) {
+        const double *col0=xCol+xDim*curCol;
+        const double *col1=col0+xDim;
+
+        for(curRow=0;curRow<numTarEven;curRow+=2) {
+            const double *row0=xRow+xDim*curRow;
+            const double *row1=row0+xDim;
+            double c00=0, c10=0, c01=0, c11=0;
+
+            for(k=0;k<xDim;k++) {
+                c00=c00+row0[k]*col0[k];
+                c10=c10+row1[k]*col0[k];
+                c01=c01+row0[k]*col1[k];
+                c11=c11+row1[k]*col1[k];
+            }
+
+            C[curRow+curCol*numTar]=c00;
+            C[curRow+1+curCol*numTar]=c10;
+            C[curRow+(curCol+1)*numTar]=c01;
+            C[curRow+1+(curCol+1)*numTar]=c11;
+        }
+
+        //The last row if numTar is odd.
+        if(curRow<numTar) {
+            const double *row0=xRow+xDim*curRow;
+
+            C[curRow+curCol*numTar]=dotProduct(row0,col0,xDim);
+            C[curRow+(curCol+1)*numTar]=dotProduct(row0,col1,xDim);
+        }
+    }
+
+    //The last column if numTar is odd.
+    if(curCol<numTar) {
+        for(curRow=0;curRow<numTar;curRow++) {
+            C[curRow+curCol*numTar]=dotProduct(xRow+xDim*curRow,xCol+xDim*curCol,xDim);
+        }
+    }
+
+    for(k=0;k<numTar*numTar;k++) {
+        if(C[k]>cMax) {
+            cMax=C[k];
+        }
+    }
+
+    return cMax;
+}
+
+/*The MMOSPAStartRunner class runs the forward-backward algorithm for a
+ *range of starting hypotheses. It is used with parallelForCPP, so each
+ *call allocates its own scratch space and writes only to the outputs of
+ *its own starts.*/
+class MMOSPAStartRunner {
+public:
+    double *MMOSPAEsts;
+    size_t *orderLists;
+    double *estNorms;
+    const size_t *refHyps;
+    const double *x;
+    const double *w;
+    size_t xDim;
+    size_t numTar;
+    size_t numHyp;
+    size_t numScan;
+
+    void operator()(const size_t threadIdx, const size_t startIdx, const size_t endIdx) {
+        const size_t stackedTarDim=xDim*numTar;
+        MurtyHyp problemSol(numTar,numTar);
+        ScratchSpace workMem(numTar,numTar);
+        vector<double> xOptCur(stackedTarDim);
+        vector<size_t> hypOrder(numHyp);
+        size_t curStart, curHyp, i;
+        (void)threadIdx;
+
+        for(curStart=startIdx;curStart<endIdx;curStart++) {
+            double *MMOSPAEst=MMOSPAEsts+curStart*stackedTarDim;
+
+            /*The reference hypothesis goes first and the others follow in
+             *their original order.*/
+            hypOrder[0]=refHyps[curStart];
+            i=1;
+            for(curHyp=0;curHyp<numHyp;curHyp++) {
+                if(curHyp!=refHyps[curStart]) {
+                    hypOrder[i]=curHyp;
+                    i++;
+                }
+            }
+
+            MMOSPAApproxScans(MMOSPAEst,orderLists+curStart*numTar*numHyp,&problemSol,workMem,xOptCur.data(),x,w,xDim,numTar,numHyp,hypOrder.data(),numScan);
+
+            /*The MOSPA cost is sum_h w(h)*norm(x(:,:,h),'fro')^2 minus
+             *norm(MMOSPAEst,'fro')^2, so larger norms are better.*/
+            estNorms[curStart]=dotProduct(MMOSPAEst,MMOSPAEst,stackedTarDim);
+        }
+    }
+};
+
+/*The MMOSPAExactState class holds the variables shared by all levels of
+ *the branch-and-bound search in MMOSPAExactCPP.*/
+class MMOSPAExactState {
+public:
+    const double *x;
+    const double *w;
+    size_t xDim;
+    size_t numTar;
+    size_t numHyp;
+    //The partial weighted sums of the hypotheses at each level.
+    vector<double> partialSums;
+    //remNorm[h]=sum_{j>=h} w[j]*norm(x(:,:,j),'fro')
+    vector<double> remNorm;
+    //The squared Frobenius norms of the hypotheses.
+    vector<double> hypNorm2;
+    //The orderings at each level of the current branch.
+    vector<size_t> curOrder;
+    //Scratch space for the inner products at each level.
+    vector<double> gainMats;
+    double bestVal;
+    size_t *bestOrder;
+    double *bestEst;
+};
+
 void MMOSPAApproxForward(double *MMOSPAEst,
                          size_t *orderList,
                          MurtyHyp *problemSol,
@@ -78,10 +236,14 @@ void MMOSPAApproxForward(double *MMOSPAEst,
                          const double *w,
                          const size_t xDim,
                          const size_t numTar,
-                         const size_t numHyp) {
+                         const size_t numHyp,
+                         const size_t *hypOrder) {
 /**MMOSPAAPPROXFORWARD  Perform a single forward step of the approximate
 *                      MMOSPA algorithm without having any previous
-*                      estimate.
+*                      estimate. The hypotheses are visited in the order
+*                      given by the length-numHyp array hypOrder, so
+*                      hypothesis hypOrder[0] determines the target
+*                      ordering.
 *
 *INPUTS:    x        An xDim X numTar X numHyp hypermatrix that holds
 *                    numHyp hypotheses each consisting or numTar targets
@@ -97,35 +259,28 @@ void MMOSPAApproxForward(double *MMOSPAEst,
 *                   approximate MMOSPA estimate. 
 *
 *October 2013 David F. Crouse, Naval Research Laboratory, Washington D.C.*/
-    size_t curTar1,curTar2, curHyp;
+    size_t curTar1, curIdx, curHyp;
     const size_t stackedTarDim=xDim*numTar;
     const size_t CSize=numTar*numTar;
     
    /* The initial hypothesis has a fixed ordering that determines the 
     * ultimate target ordering.*/
-    multScalVec(MMOSPAEst,w[0],x,stackedTarDim);
+    multScalVec(MMOSPAEst,w[hypOrder[0]],x+hypOrder[0]*stackedTarDim,stackedTarDim);
     for(curTar1=0;curTar1<numTar;curTar1++){
-        orderList[curTar1]=curTar1;
+        orderList[curTar1+numTar*hypOrder[0]]=curTar1;
     }
     
     /*Enter a loop for all of the other hypotheses*/
-    for(curHyp=1;curHyp<numHyp;curHyp++){
-        size_t curHypOffset=curHyp*stackedTarDim;
-        double cMax=-numeric_limits<double>::infinity();
+    for(curIdx=1;curIdx<numHyp;curIdx++){
+        size_t curHypOffset;
+        double cMax;
 
+        curHyp=hypOrder[curIdx];
+        curHypOffset=curHyp*stackedTarDim;
         /* Fill the cost matrix using the partial MMOSPA estimate up to
-         * this point. Rows are from xM (curTar1).
-         * Columns are from x.*/
-        for(curTar2=0;curTar2<numTar;curTar2++){
-            size_t curOffset=curTar2*numTar;
-            for(curTar1=0;curTar1<numTar;curTar1++){
-                workMem.C[curTar1+curOffset]=dotProduct(MMOSPAEst+xDim*curTar1,x+xDim*curTar2+curHypOffset,xDim);//c(curRow,curCol)=sum(xM(:,curRow).*x(:,curCol,curHyp));
-
-                if(workMem.C[curTar1+curOffset]>cMax){
-                    cMax=workMem.C[curTar1+curOffset];
-                }
-            }
-        }
+         * this point. Rows are from xM. Columns are from x.
+         * c(curRow,curCol)=sum(xM(:,curRow).*x(:,curCol,curHyp));*/
+        cMax=fillGainMatrix(workMem.C,MMOSPAEst,x+curHypOffset,xDim,numTar);
         /* Now, evaluate c=cMax-c; so that we can use a 2D assignment
          * algorithm that performs minimization rather than one that
          * performs maximization.*/
@@ -166,7 +321,7 @@ void doUpdate4Col(double *MMOSPAEst,
     size_t cur1,cur2;
     size_t curHypOffset=varHyp*stackedTarDim;
     size_t curOrderOffset=numTar*varHyp;
-    double cMax=-numeric_limits<double>::infinity();
+    double cMax;
     
     //xOptCur=(xMMOSPAEst-x(:,orderList(:,varHyp),varHyp)*w(varHyp))/denom;
     for(cur1=0;cur1<numTar;cur1++){
@@ -179,17 +334,9 @@ void doUpdate4Col(double *MMOSPAEst,
         }
     }
     
-    //Now, we must fill the cost matrix.
-    for(cur2=0;cur2<numTar;cur2++){
-        size_t curOffset=cur2*numTar;
-        for(cur1=0;cur1<numTar;cur1++){
-            workMem.C[cur1+curOffset]=dotProduct(xOptCur+xDim*cur1,x+xDim*cur2+curHypOffset,xDim);//c(curRow,curCol)=sum(xM(:,curRow).*x(:,curCol,curHyp));
-
-            if(workMem.C[cur1+curOffset]>cMax){
-                cMax=workMem.C[cur1+curOffset];
-            }
-        }
-    }
+    /*Now, we must fill the cost matrix.
+     *c(curRow,curCol)=sum(xOptCur(:,curRow).*x(:,curCol,varHyp));*/
+    cMax=fillGainMatrix(workMem.C,xOptCur,x+curHypOffset,xDim,numTar);
         
     /* Now, evaluate c=cMax-c; so that we can use a 2D assignment
      * algorithm that performs minimization rather than one that
@@ -217,6 +364,67 @@ void doUpdate4Col(double *MMOSPAEst,
 }
 
 
+void MMOSPAApproxScans(double *MMOSPAEst,
+                       size_t *orderList,
+                       MurtyHyp *problemSol,
+                       ScratchSpace &workMem,
+                       double *xOptCur,
+                       const double *x,
+                       const double *w,
+                       const size_t xDim,
+                       const size_t numTar,
+                       const size_t numHyp,
+                       const size_t *hypOrder,
+                       size_t numScan) {
+/**MMOSPAAPPROXSCANS Run the forward algorithm followed by numScan-1
+ *              backward-forward scans with the hypotheses visited in the
+ *              order given by hypOrder. xOptCur is scratch space for
+ *              xDim*numTar doubles.
+ */
+    size_t curIdx;
+
+    /*Run the forward algorithm*/
+    MMOSPAApproxForward(MMOSPAEst,orderList,problemSol,workMem,x,w,xDim,numTar,numHyp,hypOrder);
+
+    //With fewer than three hypotheses, the scans cannot change anything.
+    if(numHyp<3) {
+        return;
+    }
+
+    //Do a reverse and then a forward scan numScans times.
+    while(numScan>1) {
+        //Re-evaluate the hypotheses going backwards.
+        for(curIdx=numHyp-2;curIdx>0;curIdx--) {
+            doUpdate4Col(MMOSPAEst,
+                         orderList,
+                         problemSol,
+                         workMem,
+                         xOptCur,
+                         x,
+                         w,
+                         xDim,
+                         numTar,
+                         hypOrder[curIdx]);
+        }
+
+        //Re-evaluate the hypotheses going forwards.
+        for(curIdx=2;curIdx<numHyp;curIdx++){
+            doUpdate4Col(MMOSPAEst,
+                         orderList,
+                         problemSol,
+                         workMem,
+                         xOptCur,
+                         x,
+                         w,
+                         xDim,
+                         numTar,
+                         hypOrder[curIdx]);
+        }
+
+        numScan--;
+    }
+}
+
 void MMOSPAApproxCPP(double *MMOSPAEst,
                      size_t *orderList,
                      const double *x,
@@ -224,52 +432,234 @@ void MMOSPAApproxCPP(double *MMOSPAEst,
                      const size_t xDim,
                      const size_t numTar,
                      const size_t numHyp,
-                     size_t numScan) {
-    MurtyHyp problemSol(numTar,numTar);
-    ScratchSpace workMem(numTar,numTar);
-    size_t curHyp;
-    
-    /*Run the forward algorithm*/
-    MMOSPAApproxForward(MMOSPAEst,orderList,&problemSol,workMem,x,w,xDim,numTar,numHyp);
-    
-    if(numScan>1) {
-        double *xOptCur = new double[xDim*numTar];//Scratch space for the update steps.
-        
-        //Do a reverse and then a forward scan numScans times.
-        while(numScan>1) {
-            //Re-evaluate the hypotheses going backwards.
-            for(curHyp=numHyp-2;curHyp>0;curHyp--) {
-                doUpdate4Col(MMOSPAEst,
-                             orderList,
-                             &problemSol,
-                             workMem,
-                             xOptCur,
-                             x,
-                             w,
-                             xDim,
-                             numTar,
-                             curHyp);
-            }
+                     const size_t numScan,
+                     size_t numStarts,
+                     const size_t numThreads) {
+    const size_t stackedTarDim=xDim*numTar;
+    MMOSPAStartRunner runner;
+    size_t curHyp, curStart, bestStart, i;
+    size_t *refHyps;
+    double *estNorms;
+
+    if(numStarts<1) {
+        numStarts=1;
+    } else if(numStarts>numHyp) {
+        numStarts=numHyp;
+    }
+
+    /*The first start uses the first hypothesis as the reference. The others
+     *use the remaining hypotheses in order of decreasing weight. A stable
+     *sort is used so that ties are broken the same way as in Matlab.*/
+    refHyps=new size_t[numHyp];
+    estNorms=new double[numStarts];
+    for(curHyp=0;curHyp<numHyp;curHyp++) {
+        refHyps[curHyp]=curHyp;
+    }
+    if(numStarts>1) {
+        vector<pair<double,size_t> > sortedW;
 
-            //Re-evaluate the hypotheses going forwards.
-            for(curHyp=2;curHyp<numHyp;curHyp++){
-                doUpdate4Col(MMOSPAEst,
-                             orderList,
-                             &problemSol,
-                             workMem,
-                             xOptCur,
-                             x,
-                             w,
-                             xDim,
-                             numTar,
-                             curHyp);
+        for(curHyp=1;curHyp<numHyp;curHyp++) {
+            sortedW.push_back(pair<double,size_t>(-w[curHyp],curHyp));
+        }
+        //The pairs are unique, so sort is as good as a stable sort.
+        sort(sortedW.begin(),sortedW.end());
+        for(i=0;i<sortedW.size();i++) {
+            refHyps[i+1]=sortedW[i].second;
+        }
+    }
+
+    runner.refHyps=refHyps;
+    runner.estNorms=estNorms;
+    runner.x=x;
+    runner.w=w;
+    runner.xDim=xDim;
+    runner.numTar=numTar;
+    runner.numHyp=numHyp;
+    runner.numScan=numScan;
+
+    if(numStarts==1) {
+        //Write directly into the outputs.
+        runner.MMOSPAEsts=MMOSPAEst;
+        runner.orderLists=orderList;
+        runner(0,0,1);
+    } else {
+        double *allEsts=new double[numStarts*stackedTarDim];
+        size_t *allOrders=new size_t[numStarts*numTar*numHyp];
+
+        runner.MMOSPAEsts=allEsts;
+        runner.orderLists=allOrders;
+        parallelForCPP(numStarts,numThreads2UseCPP(numThreads,numStarts),runner);
+
+        //Keep the best result, with ties going to the earliest start.
+        bestStart=0;
+        for(curStart=1;curStart<numStarts;curStart++) {
+            if(estNorms[curStart]>estNorms[bestStart]) {
+                bestStart=curStart;
             }
+        }
 
-            numScan--;
+        copy(allEsts+bestStart*stackedTarDim,allEsts+(bestStart+1)*stackedTarDim,MMOSPAEst);
+        copy(allOrders+bestStart*numTar*numHyp,allOrders+(bestStart+1)*numTar*numHyp,orderList);
+
+        delete[] allOrders;
+        delete[] allEsts;
+    }
+
+    delete[] estNorms;
+    delete[] refHyps;
+}
+
+void MMOSPAExactSearch(MMOSPAExactState &state, const size_t curLevel) {
+/**MMOSPAEXACTSEARCH Recursively search over the target orderings of the
+ *            hypotheses curLevel to numHyp-1 given the orderings of the
+ *            earlier hypotheses, whose weighted sum is in
+ *            state.partialSums at offset curLevel*xDim*numTar. Branches
+ *            that cannot beat state.bestVal are pruned using the triangle
+ *            inequality.
+ */
+    const size_t xDim=state.xDim;
+    const size_t numTar=state.numTar;
+    const size_t stackedTarDim=xDim*numTar;
+    const double *partialSum=state.partialSums.data()+curLevel*stackedTarDim;
+    const double partialNorm2=dotProduct(partialSum,partialSum,stackedTarDim);
+    vector<pair<double,size_t> > children;
+    vector<size_t> perms;
+    vector<size_t> perm(numTar);
+    const double *xCur;
+    double *G;
+    double wCur;
+    size_t i, curChild;
+
+    if(curLevel==state.numHyp) {
+        if(partialNorm2>state.bestVal) {
+            state.bestVal=partialNorm2;
+            copy(state.curOrder.begin(),state.curOrder.end(),state.bestOrder);
+            copy(partialSum,partialSum+stackedTarDim,state.bestEst);
         }
+        return;
+    }
+
+    xCur=state.x+curLevel*stackedTarDim;
+    wCur=state.w[curLevel];
+    G=state.gainMats.data()+curLevel*numTar*numTar;
 
-        delete[] xOptCur;
+    //G(curRow,curCol)=sum(partialSum(:,curRow).*x(:,curCol,curLevel))
+    fillGainMatrix(G,partialSum,xCur,xDim,numTar);
+
+    /*Evaluate an upper bound on the value of the best leaf under each
+     *ordering of the current hypothesis. The squared norm of the child's
+     *partial sum is partialNorm2+2*wCur*gain+wCur^2*hypNorm2.*/
+    for(i=0;i<numTar;i++) {
+        perm[i]=i;
     }
+    do {
+        double gain=0, childNorm2, bound;
+
+        for(i=0;i<numTar;i++) {
+            gain+=G[i+perm[i]*numTar];
+        }
+        childNorm2=partialNorm2+2*wCur*gain+wCur*wCur*state.hypNorm2[curLevel];
+        if(childNorm2<0) {
+            childNorm2=0;
+        }
+        bound=sqrt(childNorm2)+state.remNorm[curLevel+1];
+        bound*=bound;
+
+        if(bound>state.bestVal) {
+            children.push_back(pair<double,size_t>(-bound,perms.size()/numTar));
+            perms.insert(perms.end(),perm.begin(),perm.end());
+        }
+    } while(next_permutation(perm.begin(),perm.end()));
+
+    //Visit the most promising children first.
+    sort(children.begin(),children.end());
+
+    for(curChild=0;curChild<children.size();curChild++) {
+        const size_t *childPerm=perms.data()+children[curChild].second*numTar;
+        double *childSum=state.partialSums.data()+(curLevel+1)*stackedTarDim;
+
+        //The bound might have been invalidated by a better solution.
+        if(-children[curChild].first<=state.bestVal) {
+            break;
+        }
+
+        copy(partialSum,partialSum+stackedTarDim,childSum);
+        for(i=0;i<numTar;i++) {
+            vecScalMadd(childSum+i*xDim,wCur,xCur+childPerm[i]*xDim,xDim);
+        }
+        copy(childPerm,childPerm+numTar,state.curOrder.begin()+curLevel*numTar);
+
+        MMOSPAExactSearch(state,curLevel+1);
+    }
+}
+
+void MMOSPAExactCPP(double *MMOSPAEst,
+                    size_t *orderList,
+                    const double *x,
+                    const double *w,
+                    const size_t xDim,
+                    const size_t numTar,
+                    const size_t numHyp) {
+    const size_t stackedTarDim=xDim*numTar;
+    MMOSPAExactState state;
+    size_t curHyp, i;
+
+    /*Get a good initial solution with the approximate algorithm so that
+     *more branches can be pruned.*/
+    MMOSPAApproxCPP(MMOSPAEst,orderList,x,w,xDim,numTar,numHyp,2,numHyp,1);
+
+    if(numHyp<2) {
+        return;
+    }
+
+    state.x=x;
+    state.w=w;
+    state.xDim=xDim;
+    state.numTar=numTar;
+    state.numHyp=numHyp;
+    state.partialSums.resize((numHyp+1)*stackedTarDim);
+    state.remNorm.resize(numHyp+1);
+    state.hypNorm2.resize(numHyp);
+    state.curOrder.resize(numTar*numHyp);
+    state.gainMats.resize(numHyp*numTar*numTar);
+    state.bestVal=dotProduct(MMOSPAEst,MMOSPAEst,stackedTarDim);
+    state.bestOrder=orderList;
+    state.bestEst=MMOSPAEst;
+
+    for(curHyp=0;curHyp<numHyp;curHyp++) {
+        state.hypNorm2[curHyp]=dotProduct(x+curHyp*stackedTarDim,x+curHyp*stackedTarDim,stackedTarDim);
+    }
+    state.remNorm[numHyp]=0;
+    for(curHyp=numHyp;curHyp>0;curHyp--) {
+        state.remNorm[curHyp-1]=state.remNorm[curHyp]+w[curHyp-1]*sqrt(state.hypNorm2[curHyp-1]);
+    }
+
+    /*The approximate solution might use a different hypothesis as the
+     *reference, so its target ordering is changed so that the first
+     *hypothesis is in its original order, as in the search.*/
+    {
+        vector<size_t> inv(numTar);
+        vector<double> estCopy(MMOSPAEst,MMOSPAEst+stackedTarDim);
+        vector<size_t> orderCopy(orderList,orderList+numTar*numHyp);
+
+        for(i=0;i<numTar;i++) {
+            inv[orderCopy[i]]=i;
+        }
+        for(i=0;i<numTar;i++) {
+            copy(estCopy.begin()+inv[i]*xDim,estCopy.begin()+(inv[i]+1)*xDim,MMOSPAEst+i*xDim);
+            for(curHyp=0;curHyp<numHyp;curHyp++) {
+                orderList[i+curHyp*numTar]=orderCopy[inv[i]+curHyp*numTar];
+            }
+        }
+    }
+
+    //The first hypothesis has a fixed ordering.
+    multScalVec(state.partialSums.data()+stackedTarDim,w[0],x,stackedTarDim);
+    for(i=0;i<numTar;i++) {
+        state.curOrder[i]=i;
+    }
+
+    MMOSPAExactSearch(state,1);
 }
 
 /*LICENSE:
@@ -11,7 +11,9 @@ void MMOSPAApproxCPP(double *MMOSPAEst,
                      const size_t xDim,
                      const size_t numTar,
                      const size_t numHyp,
-                     size_t numScan);
+                     const size_t numScan,
+                     size_t numStarts,
+                     const size_t numThreads);
 /*MMOSPAAPPROXCPP A C++ implementation of aan approximate minimum MOSPA
  *                optimization algorithm.
  *
@@ -32,6 +34,16 @@ void MMOSPAApproxCPP(double *MMOSPAEst,
  *        numHyp    The size of the third dimensions that x splits into.
  *        numScan   The number of forward scans of the approximation
  *                  algoirthm to perform.
+ *        numStarts The number of times that the algorithm is run with
+ *                  different reference hypotheses, keeping the best
+ *                  result. The first run uses the first hypothesis as the
+ *                  reference and the others use the remaining hypotheses
+ *                  in order of decreasing weight. Values above numHyp are
+ *                  clipped to numHyp. If numStarts=1, the result is the
+ *                  same as the original single-start algorithm.
+ *        numThreads The number of threads to use to run the starts in
+ *                  parallel. If this is zero, then the number of hardware
+ *                  threads is used.
  *
  *OUTPUT: The output is placed in MMOSPAEst and orderList and is
  *        The MMOSPA estimate and the ordering idices of the hypotheses.
@@ -45,6 +57,28 @@ void MMOSPAApproxCPP(double *MMOSPAEst,
  * November 2013 David F. Crouse, Naval Research Laboratory, Washington D.C.
  */ 
 
+void MMOSPAExactCPP(double *MMOSPAEst,
+                    size_t *orderList,
+                    const double *x,
+                    const double *w,
+                    const size_t xDim,
+                    const size_t numTar,
+                    const size_t numHyp);
+/*MMOSPAEXACTCPP Find the exact MMOSPA estimate using branch-and-bound. The
+ *               inputs and outputs are the same as in MMOSPAApproxCPP,
+ *               except the first hypothesis always has its original
+ *               target ordering in orderList. The MOSPA cost is minimized
+ *               when the squared Frobenius norm of the estimate is
+ *               maximized. The search goes through the hypotheses in order
+ *               and a branch is pruned when the norm of its partial
+ *               weighted sum plus the sum of the weighted norms of the
+ *               remaining hypotheses cannot exceed the norm of the best
+ *               estimate found. The search is initialized with the result
+ *               of MMOSPAApproxCPP. The worst-case complexity is
+ *               O((numTar!)^(numHyp-1)), so this is only practical when
+ *               the number of targets and hypotheses is small.
+ */
+
 #endif
 
 /*LICENSE:
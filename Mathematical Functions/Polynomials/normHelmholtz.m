@@ -116,7 +116,9 @@ function [HBar,dHBardu,d2HBardu2]=normHelmholtz(u,M,scalFactor)
         %For n=2, m=0.
         m=0;
         n=2;
-        k=sqrt((n-m)*(n+m+1));
+        %As in the first derivative, the m=0 term has a different
+        %normalization factor than the other orders.
+        k=sqrt(n*(n+1)/2);
         kp=sqrt((n-(m+1))*(n+(m+1)+1));
         d2HBardu2(n+1,m+1)=k*kp*HBar(n+1,m+2+1);
         
@@ -0,0 +1,310 @@
+/**CHEBTIMECACHECPP A class that caches smooth functions of time as
+ *            piecewise Chebyshev polynomials. See ChebTimeCacheCPP.hpp for
+ *            details.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include <math.h>
+#include "ChebTimeCacheCPP.hpp"
+//For parallelForCPP
+#include "parallelForCPP.hpp"
+
+static const double pi=3.1415926535897932384626433832795;
+
+static double chebEval(const double *c, const size_t degree, const double u);
+static double getSpan(double &JDRef, double &spanStart, const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2);
+static size_t getNumSegments(const double spanLength, const double maxSegLength);
+
+/*The ChebFitChunk class is used with parallelForCPP to fit contiguous
+ *chunks of the segments in separate threads. The values are either from
+ *func or, if samples is not NULL, from the values at the dates of
+ *sampleDates. The largest error of each thread is saved in
+ *threadMaxErr.*/
+class ChebFitChunk {
+public:
+    const ChebTimeFuncCPP *func;
+    const double *samples;
+    double *coeffs;
+    double *threadMaxErr;
+    double JDRef;
+    double spanStart;
+    double segLength;
+    size_t numQuant;
+    size_t degree;
+
+    void getVals(const size_t curSeg, const size_t curPoint, const double u, double *vals) const {
+        if(samples!=NULL) {
+            const double *curSample=samples+numQuant*((2*degree+3)*curSeg+curPoint);
+            size_t k;
+
+            for(k=0;k<numQuant;k++) {
+                vals[k]=curSample[k];
+            }
+        } else {
+            const double segMid=spanStart+(curSeg+0.5)*segLength;
+
+            (*func)(JDRef,segMid+0.5*segLength*u,vals);
+        }
+    }
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        const size_t numNodes=degree+1;
+        std::vector<double> vals(numQuant*numNodes);
+        std::vector<double> trueVals(numQuant);
+        std::vector<double> nodeVals(numQuant);
+        double maxErr=0;
+        size_t curSeg, j, n, k;
+
+        for(curSeg=startItem;curSeg<endItem;curSeg++) {
+            double *c=coeffs+numQuant*numNodes*curSeg;
+
+            //Evaluate the quantities at the Chebyshev nodes.
+            for(j=0;j<numNodes;j++) {
+                getVals(curSeg,j,cos(pi*(j+0.5)/numNodes),nodeVals.data());
+                for(k=0;k<numQuant;k++) {
+                    vals[k*numNodes+j]=nodeVals[k];
+                }
+            }
+
+            //The interpolating coefficients are given by the discrete
+            //cosine transform of the values at the nodes.
+            for(k=0;k<numQuant;k++) {
+                for(n=0;n<numNodes;n++) {
+                    double sumVal=0;
+                    for(j=0;j<numNodes;j++) {
+                        sumVal+=vals[k*numNodes+j]*cos(pi*n*(j+0.5)/numNodes);
+                    }
+                    c[k*numNodes+n]=(2.0/numNodes)*sumVal;
+                }
+                c[k*numNodes]*=0.5;
+            }
+
+            //Check the fit at the ends of the segment and halfway between
+            //the nodes, where the interpolation error is largest.
+            for(j=0;j<=numNodes;j++) {
+                const double u=cos(pi*j/numNodes);
+
+                getVals(curSeg,numNodes+j,u,trueVals.data());
+                for(k=0;k<numQuant;k++) {
+                    const double err=fabs(chebEval(c+k*numNodes,degree,u)-trueVals[k]);
+                    //The negated comparison also catches NaNs.
+                    if(!(err<=maxErr)) {
+                        maxErr=err;
+                    }
+                }
+            }
+        }
+
+        threadMaxErr[threadIdx]=maxErr;
+    }
+};
+
+ChebTimeCacheCPP::ChebTimeCacheCPP() {
+    clear();
+}
+
+void ChebTimeCacheCPP::clear() {
+    JDRef=0;
+    spanStart=0;
+    segLength=0;
+    numSegments=0;
+    numQuant=0;
+    degree=0;
+    maxErr=0;
+    coeffs.clear();
+}
+
+bool ChebTimeCacheCPP::fit(const ChebTimeFuncCPP &func, const size_t theNumQuant, const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const double tol, const size_t theDegree, const double initSegLength, const double minSegLength, const size_t numThreads) {
+    double spanLength;
+
+    clear();
+
+    spanLength=getSpan(JDRef,spanStart,JDStart1,JDStart2,JDEnd1,JDEnd2);
+
+    numQuant=theNumQuant;
+    degree=theDegree;
+    numSegments=getNumSegments(spanLength,initSegLength);
+
+    while(true) {
+        segLength=spanLength/numSegments;
+        fitSegments(&func,NULL,numThreads);
+
+        if(maxErr<=tol) {
+            return true;
+        }
+
+        if(segLength/2<minSegLength) {
+            clear();
+            return false;
+        }
+        numSegments*=2;
+    }
+}
+
+bool ChebTimeCacheCPP::fitSamples(const double *samples, const size_t theNumQuant, const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const double tol, const size_t theDegree, const double maxSegLength, const size_t numThreads) {
+    double spanLength;
+
+    clear();
+
+    spanLength=getSpan(JDRef,spanStart,JDStart1,JDStart2,JDEnd1,JDEnd2);
+
+    numQuant=theNumQuant;
+    degree=theDegree;
+    numSegments=getNumSegments(spanLength,maxSegLength);
+    segLength=spanLength/numSegments;
+    fitSegments(NULL,samples,numThreads);
+
+    return maxErr<=tol;
+}
+
+size_t ChebTimeCacheCPP::numFitEvals(const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const size_t theDegree, const double initSegLength) {
+    double JDRefSpan, spanStartSpan;
+    const double spanLength=getSpan(JDRefSpan,spanStartSpan,JDStart1,JDStart2,JDEnd1,JDEnd2);
+
+    //The nodes and the check points of each segment.
+    return getNumSegments(spanLength,initSegLength)*(2*theDegree+3);
+}
+
+size_t ChebTimeCacheCPP::sampleDates(const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const size_t theDegree, const double maxSegLength, double *JD1, double *JD2) {
+    const size_t numNodes=theDegree+1;
+    double JDRefSpan, spanStartSpan, segLengthSpan;
+    const double spanLength=getSpan(JDRefSpan,spanStartSpan,JDStart1,JDStart2,JDEnd1,JDEnd2);
+    const size_t numSegs=getNumSegments(spanLength,maxSegLength);
+    size_t curSeg, j, curDate;
+
+    if(JD1==NULL||JD2==NULL) {
+        return numSegs*(2*theDegree+3);
+    }
+
+    segLengthSpan=spanLength/numSegs;
+    curDate=0;
+    for(curSeg=0;curSeg<numSegs;curSeg++) {
+        const double segMid=spanStartSpan+(curSeg+0.5)*segLengthSpan;
+
+        //The Chebyshev nodes and then the check points, in the order
+        //that fitSegments uses them.
+        for(j=0;j<numNodes;j++) {
+            JD1[curDate]=JDRefSpan;
+            JD2[curDate]=segMid+0.5*segLengthSpan*cos(pi*(j+0.5)/numNodes);
+            curDate++;
+        }
+        for(j=0;j<=numNodes;j++) {
+            JD1[curDate]=JDRefSpan;
+            JD2[curDate]=segMid+0.5*segLengthSpan*cos(pi*j/numNodes);
+            curDate++;
+        }
+    }
+
+    return curDate;
+}
+
+void ChebTimeCacheCPP::fitSegments(const ChebTimeFuncCPP *func, const double *samples, const size_t numThreads) {
+    const size_t numThreadsUsed=numThreads2UseCPP(numThreads,numSegments);
+    std::vector<double> threadMaxErr(numThreadsUsed,0.0);
+    ChebFitChunk fitter;
+    size_t i;
+
+    coeffs.resize(numQuant*(degree+1)*numSegments);
+
+    fitter.func=func;
+    fitter.samples=samples;
+    fitter.coeffs=coeffs.data();
+    fitter.threadMaxErr=threadMaxErr.data();
+    fitter.JDRef=JDRef;
+    fitter.spanStart=spanStart;
+    fitter.segLength=segLength;
+    fitter.numQuant=numQuant;
+    fitter.degree=degree;
+    parallelForCPP(numSegments,numThreadsUsed,fitter);
+
+    maxErr=0;
+    for(i=0;i<numThreadsUsed;i++) {
+        if(!(threadMaxErr[i]<=maxErr)) {
+            maxErr=threadMaxErr[i];
+        }
+    }
+}
+
+bool ChebTimeCacheCPP::covers(const double JD1, const double JD2) const {
+    const double t=((JD1-JDRef)+JD2)-spanStart;
+
+    return numSegments>0&&t>=0&&t<=segLength*numSegments;
+}
+
+bool ChebTimeCacheCPP::eval(const double JD1, const double JD2, double *vals) const {
+    const size_t numNodes=degree+1;
+    const double t=((JD1-JDRef)+JD2)-spanStart;
+    const double *c;
+    size_t curSeg, k;
+    double u;
+
+    if(!covers(JD1,JD2)) {
+        return false;
+    }
+
+    curSeg=static_cast<size_t>(t/segLength);
+    //The end of the span is in the last segment.
+    if(curSeg>=numSegments) {
+        curSeg=numSegments-1;
+    }
+    u=2.0*(t-curSeg*segLength)/segLength-1.0;
+
+    c=coeffs.data()+numQuant*numNodes*curSeg;
+    for(k=0;k<numQuant;k++) {
+        vals[k]=chebEval(c+k*numNodes,degree,u);
+    }
+    return true;
+}
+
+static double getSpan(double &JDRef, double &spanStart, const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2) {
+    double spanLength;
+
+    //An integer plus one half near the start of the span.
+    JDRef=floor(JDStart1+JDStart2)+0.5;
+    spanStart=(JDStart1-JDRef)+JDStart2;
+    spanLength=((JDEnd1-JDRef)+JDEnd2)-spanStart;
+    //A span of a single instant is given a length of one day.
+    if(!(spanLength>0)) {
+        spanLength=1.0;
+    }
+    return spanLength;
+}
+
+static size_t getNumSegments(const double spanLength, const double maxSegLength) {
+    //The fewest segments of at most maxSegLength days that cover the span.
+    const size_t numSegs=static_cast<size_t>(ceil(spanLength/maxSegLength));
+
+    return numSegs>0?numSegs:1;
+}
+
+static double chebEval(const double *c, const size_t degree, const double u) {
+    //Evaluate the Chebyshev series using Clenshaw's recurrence.
+    double b1=0;
+    double b2=0;
+    size_t n;
+
+    for(n=degree;n>=1;n--) {
+        const double b=2.0*u*b1-b2+c[n];
+        b2=b1;
+        b1=b;
+    }
+    return u*b1-b2+c[0];
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
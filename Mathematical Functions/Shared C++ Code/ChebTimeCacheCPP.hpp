@@ -0,0 +1,124 @@
+/**CHEBTIMECACHECPP A header file for a class that caches one or more smooth
+ *            functions of time as piecewise Chebyshev polynomials over a
+ *            span of dates. It is meant for quantities such as the
+ *            periodic series of the IAU models in the SOFA library, which
+ *            sum hundreds or thousands of terms each time that they are
+ *            evaluated, whereas evaluating the cache takes a few dozen
+ *            multiplications per quantity.
+ *
+ *As with the JPL ephemerides, the span is split into segments of equal
+ *length and the quantities are fit in each segment by the Chebyshev
+ *polynomials that interpolate the function at the Chebyshev nodes of the
+ *segment. The fit is checked at the ends of the segments and halfway
+ *between the nodes. If the largest difference from the function is more
+ *than the requested tolerance, the segment length is halved and the fit
+ *is repeated. The segments are fit in parallel. Values sampled elsewhere
+ *can also be fit, in which case the caller shortens the segments.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef CHEBTIMECACHECPP
+#define CHEBTIMECACHECPP
+
+#include <stddef.h>
+#include <vector>
+
+/*The functions that are cached are given as classes that inherit from
+ *ChebTimeFuncCPP. The operator() puts the values of the numQuant
+ *quantities at the two-part Julian date JD1+JD2 in vals. It is called
+ *from multiple threads at once and must not call the Matlab API.*/
+class ChebTimeFuncCPP {
+public:
+    virtual ~ChebTimeFuncCPP() {}
+    virtual void operator()(const double JD1, const double JD2, double *vals) const=0;
+};
+
+class ChebTimeCacheCPP {
+public:
+    /*The start of the span is JDRef+spanStart in days and JDRef is an
+     *integer plus one half, so that the offsets are small and exact.*/
+    double JDRef;
+    double spanStart;
+    double segLength;
+    size_t numSegments;
+    size_t numQuant;
+    size_t degree;
+    //The largest difference from the function found when checking the
+    //fit.
+    double maxErr;
+    /*The Chebyshev coefficients. The coefficients of quantity k in segment
+     *i start at element (numQuant*i+k)*(degree+1).*/
+    std::vector<double> coeffs;
+
+    ChebTimeCacheCPP();
+
+    bool fit(const ChebTimeFuncCPP &func, const size_t theNumQuant, const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const double tol, const size_t theDegree, const double initSegLength, const double minSegLength, const size_t numThreads);
+    /*Fit the cache to the theNumQuant quantities of func over the span
+     *between two two-part Julian dates. The fit starts with segments of
+     *length initSegLength days (shortened so that a whole number fit in
+     *the span) and halves the length until the maximum error at the check
+     *points is at most tol for all of the quantities. The segments are fit
+     *in parallel using up to numThreads threads, with 0 meaning the number
+     *of hardware threads. The return value is false if the tolerance could
+     *not be met with segments of at least minSegLength days, in which case
+     *the cache is left empty.*/
+
+    static size_t numFitEvals(const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const size_t theDegree, const double initSegLength);
+    /*The number of times that the function is evaluated by fit over the
+     *given span if the tolerance is met with the initial segment length.
+     *This can be compared to the number of dates to be evaluated to decide
+     *whether fitting the cache is worthwhile.*/
+
+    static size_t sampleDates(const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const size_t theDegree, const double maxSegLength, double *JD1, double *JD2);
+    bool fitSamples(const double *samples, const size_t theNumQuant, const double JDStart1, const double JDStart2, const double JDEnd1, const double JDEnd2, const double tol, const size_t theDegree, const double maxSegLength, const size_t numThreads);
+    /*These fit the cache to values that were computed elsewhere, such as
+     *from a library that cannot be called from multiple threads.
+     *sampleDates puts the two-part Julian dates at which the quantities
+     *are needed for a fit over the given span with the fewest segments of
+     *at most maxSegLength days in JD1 and JD2 and returns the number of
+     *dates, which is the number of segments times 2*theDegree+3. If JD1 or
+     *JD2 is NULL, only the number of dates is returned. fitSamples takes
+     *the theNumQuantXnumDates values at those dates (all of the quantities
+     *of a date are consecutive) and fits the cache. The fit is kept and
+     *maxErr set even if it does not meet the tolerance, in which case the
+     *return value is false and the caller can try again with shorter
+     *segments.*/
+
+    bool isEmpty() const {
+        return numSegments==0;
+    }
+
+    bool covers(const double JD1, const double JD2) const;
+    /*Return true if the two-part Julian date JD1+JD2 is within the span of
+     *the cache.*/
+
+    bool eval(const double JD1, const double JD2, double *vals) const;
+    /*Put the numQuant quantities at the two-part Julian date JD1+JD2 in
+     *vals. The return value is false and vals is not changed if the date
+     *is outside of the span of the cache, in which case the function
+     *should be called directly.*/
+
+    void clear();
+private:
+    void fitSegments(const ChebTimeFuncCPP *func, const double *samples, const size_t numThreads);
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
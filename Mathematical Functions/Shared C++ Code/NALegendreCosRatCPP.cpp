@@ -13,6 +13,15 @@
  *Matlab implementation of the function NALegendreCosRat for more
  *information on the algorithm used.
  *
+ *The spherical harmonic synthesis functions do not use these functions,
+ *but rather NALegendreCosRatOrderMajorCPP and
+ *NALegendreCosRatDerivOrderMajorCPP in spherHarmonicKernelsCPP.cpp, which
+ *run the same recursions over the degree for each order with precomputed
+ *coefficients and vectorized inner loops. The functions here fill
+ *ClusterSets stored by degree for NALegendreCosRat, and copying the
+ *order-major results into that layout is a transposition of the whole
+ *array, which costs more than the vectorized recursions save.
+ *
  *January 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
  **/
 /*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
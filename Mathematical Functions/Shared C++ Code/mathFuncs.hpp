@@ -14,8 +14,11 @@
 
 size_t findFirstMaxCPP(const double *arr, const size_t arrayLen);
 
-void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const double *point, const size_t numPoints,const double a, const double c, const double scalFactor);
-void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t numPoints,const double a, const double c, const double scalFactor);
+void spherHarmonicEvalCPP(double *V, double *gradV, double *HessV, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const double *point, const size_t numPoints,const double a, const double c, const double scalFactor, const size_t numThreads);
+void spherHarmonicGridEvalCPP(double *V, double *gradV, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const double *rLat, const size_t numRows, const double lambda0, const size_t numLon, const double a, const double c, const double scalFactor, const size_t numThreads);
+void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t numPoints,const double a, const double c, const double scalFactor, const size_t numThreads);
+void spherHarmonicCovPointCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const ClusterSetCPP<double> &FuncVals, const ClusterSetCPP<double> &FuncDerivs, const double *nCoeff, const double *rm, const double *im, const size_t N, const double r, const double s, const double t, const double u, const double c, const double scalFactor);
+void spherHarmonicEvalCovCPP(double *V, double *gradV, double *sigma2, double *Sigma, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t numPoints,const double a, const double c, const double scalFactor, const size_t numThreads);
 
 void NALegendreCosRatCPP(ClusterSetCPP<double> &PBarUVals, const double theta, const double scalFactor);
 void NALegendreCosRatDerivCPP(ClusterSetCPP<double> &dPBarUValsdTheta, const ClusterSetCPP<double> &PBarUVals, const double theta);
@@ -114,7 +114,9 @@ void normHelmHoltzDeriv2CPP(ClusterSetCPP<double> &d2HBardu2,const ClusterSetCPP
     n=2;
     mf=0.0;
     nf=2.0;
-    k=sqrt((nf-mf)*(nf+mf+1));
+    //As in the first derivative, the m=0 term has a different
+    //normalization factor than the other orders.
+    k=sqrt(nf*(nf+1)/2);
     kp=sqrt((nf-(mf+1))*(nf+(mf+1)+1));
     d2HBardu2[n][m]=k*kp*HBar[n][m+2];
 
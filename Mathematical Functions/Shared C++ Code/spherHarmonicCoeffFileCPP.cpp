@@ -0,0 +1,254 @@
+/*SPHERHARMONICCOEFFFILECPP C++ functions for reading and writing a binary
+ *                    file of spherical harmonic coefficients that is
+ *                    memory mapped when it is read. See
+ *                    spherHarmonicCoeffFileCPP.hpp for the format of the
+ *                    file.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For memcpy and memcmp
+#include <string.h>
+//For fopen and fwrite
+#include <stdio.h>
+#include "spherHarmonicCoeffFileCPP.hpp"
+//For the order-major layout and spherHarmonicDegAmpCPP
+#include "spherHarmonicModelCPP.hpp"
+
+using namespace std;
+
+static const char coeffFileMagic[8]={'S','P','H','H','A','R','M','C'};
+
+int writeSpherHarmonicCoeffFileCPP(const char *fileName, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S, const ClusterSetCPP<double> *CAux, const ClusterSetCPP<double> *SAux, const uint32_t auxType, const double refEpoch, const double a, const double c) {
+    const size_t M=C.numClust-1;
+    const size_t numCoeffs=(M+1)*(M+2)/2;
+    const std::shared_ptr<const SpherHarmonicLayoutCPP> layout=getSpherHarmonicLayoutCPP(M);
+    SpherHarmonicCoeffHeaderCPP header;
+    vector<uint64_t> offsets(M+1);
+    vector<double> orderMajor(layout->totalSize);
+    vector<double> degAmp(M+1);
+    size_t n, MAux, numAuxCoeffs;
+    bool writeOK;
+    FILE *fp;
+
+    if(CAux!=NULL&&SAux!=NULL) {
+        MAux=CAux->numClust-1;
+        numAuxCoeffs=(MAux+1)*(MAux+2)/2;
+    } else {
+        MAux=0;
+        numAuxCoeffs=0;
+    }
+
+    memset(&header,0,sizeof(header));
+    memcpy(header.magic,coeffFileMagic,sizeof(coeffFileMagic));
+    header.version=SPHER_HARMONIC_COEFF_VERSION;
+    header.byteOrder=SPHER_HARMONIC_COEFF_BYTE_ORDER;
+    header.M=M;
+    header.MAux=MAux;
+    header.numSets=(numAuxCoeffs>0)?4:2;
+    header.auxType=(numAuxCoeffs>0)?auxType:SPHER_HARMONIC_COEFF_AUX_NONE;
+    header.orderMajorSize=layout->totalSize;
+    header.a=a;
+    header.c=c;
+    header.refEpoch=refEpoch;
+
+    for(n=0;n<=M;n++) {
+        offsets[n]=n*(n+1)/2;
+    }
+
+    fp=fopen(fileName,"wb");
+    if(fp==NULL) {
+        return SPHER_HARMONIC_COEFF_OPEN_FAILED;
+    }
+
+    writeOK=fwrite(&header,sizeof(header),1,fp)==1;
+    writeOK=writeOK&&fwrite(offsets.data(),sizeof(uint64_t),M+1,fp)==M+1;
+    writeOK=writeOK&&fwrite(C.clusterEls,sizeof(double),numCoeffs,fp)==numCoeffs;
+    writeOK=writeOK&&fwrite(S.clusterEls,sizeof(double),numCoeffs,fp)==numCoeffs;
+    if(numAuxCoeffs>0) {
+        writeOK=writeOK&&fwrite(CAux->clusterEls,sizeof(double),numAuxCoeffs,fp)==numAuxCoeffs;
+        writeOK=writeOK&&fwrite(SAux->clusterEls,sizeof(double),numAuxCoeffs,fp)==numAuxCoeffs;
+    }
+
+    orderMajorFromClusterSetCPP(orderMajor.data(),C,*layout);
+    writeOK=writeOK&&fwrite(orderMajor.data(),sizeof(double),layout->totalSize,fp)==layout->totalSize;
+    orderMajorFromClusterSetCPP(orderMajor.data(),S,*layout);
+    writeOK=writeOK&&fwrite(orderMajor.data(),sizeof(double),layout->totalSize,fp)==layout->totalSize;
+
+    spherHarmonicDegAmpCPP(degAmp.data(),C,S);
+    writeOK=writeOK&&fwrite(degAmp.data(),sizeof(double),M+1,fp)==M+1;
+
+    writeOK=(fclose(fp)==0)&&writeOK;
+    if(!writeOK) {
+        return SPHER_HARMONIC_COEFF_OPEN_FAILED;
+    }
+    return SPHER_HARMONIC_COEFF_OK;
+}
+
+SpherHarmonicCoeffFileCPP::SpherHarmonicCoeffFileCPP() {
+    memset(&header,0,sizeof(header));
+    C=NULL;
+    S=NULL;
+    CAux=NULL;
+    SAux=NULL;
+    CO=NULL;
+    SO=NULL;
+    degAmp=NULL;
+}
+
+SpherHarmonicCoeffFileCPP::~SpherHarmonicCoeffFileCPP() {
+    close();
+}
+
+int SpherHarmonicCoeffFileCPP::open(const char *fileName) {
+    const unsigned char *curPtr;
+    uint64_t fileSize, expectedSize, numCoeffs, numAuxCoeffs;
+    const uint64_t *offsets;
+    size_t n;
+
+    close();
+
+    switch(file.open(fileName,sizeof(SpherHarmonicCoeffHeaderCPP))) {
+        case MAPPED_FILE_OK:
+            break;
+        case MAPPED_FILE_OPEN_FAILED:
+            return SPHER_HARMONIC_COEFF_OPEN_FAILED;
+        case MAPPED_FILE_TOO_SMALL:
+            return SPHER_HARMONIC_COEFF_BAD_HEADER;
+        default:
+            return SPHER_HARMONIC_COEFF_MAP_FAILED;
+    }
+    fileSize=file.size();
+
+    curPtr=static_cast<const unsigned char*>(file.data());
+    memcpy(&header,curPtr,sizeof(header));
+    if(memcmp(header.magic,coeffFileMagic,sizeof(coeffFileMagic))!=0||header.version!=SPHER_HARMONIC_COEFF_VERSION) {
+        close();
+        return SPHER_HARMONIC_COEFF_BAD_HEADER;
+    }
+    if(header.byteOrder!=SPHER_HARMONIC_COEFF_BYTE_ORDER) {
+        close();
+        return SPHER_HARMONIC_COEFF_BAD_BYTE_ORDER;
+    }
+    if((header.numSets!=2&&header.numSets!=4)||header.MAux>header.M) {
+        close();
+        return SPHER_HARMONIC_COEFF_BAD_HEADER;
+    }
+
+    //A corrupt header can give a degree so large that the sizes below
+    //overflow or that building the layout runs out of memory, so the
+    //degree and the order-major size are first bounded by the number of
+    //doubles in the file. The C and S coefficients alone take
+    //(M+1)*(M+2)/2 doubles each. The second comparison is that test
+    //rearranged so that it can not overflow.
+    {
+        const uint64_t maxEls=fileSize/sizeof(double);
+
+        if(header.M>=maxEls||header.M+2>2*maxEls/(header.M+1)||header.orderMajorSize>maxEls) {
+            close();
+            return SPHER_HARMONIC_COEFF_BAD_SIZE;
+        }
+    }
+
+    numCoeffs=(header.M+1)*(header.M+2)/2;
+    numAuxCoeffs=(header.numSets==4)?(header.MAux+1)*(header.MAux+2)/2:0;
+    expectedSize=sizeof(SpherHarmonicCoeffHeaderCPP)+sizeof(uint64_t)*(header.M+1)+sizeof(double)*(2*numCoeffs+2*numAuxCoeffs+2*header.orderMajorSize+header.M+1);
+    if(fileSize!=expectedSize) {
+        close();
+        return SPHER_HARMONIC_COEFF_BAD_SIZE;
+    }
+
+    //The order-major arrays must match the layout that the kernels use.
+    if(header.orderMajorSize!=getSpherHarmonicLayoutCPP(static_cast<size_t>(header.M))->totalSize) {
+        close();
+        return SPHER_HARMONIC_COEFF_BAD_SIZE;
+    }
+
+    curPtr+=sizeof(SpherHarmonicCoeffHeaderCPP);
+    offsets=reinterpret_cast<const uint64_t*>(curPtr);
+    curPtr+=sizeof(uint64_t)*(header.M+1);
+    C=reinterpret_cast<const double*>(curPtr);
+    curPtr+=sizeof(double)*numCoeffs;
+    S=reinterpret_cast<const double*>(curPtr);
+    curPtr+=sizeof(double)*numCoeffs;
+    if(numAuxCoeffs>0) {
+        CAux=reinterpret_cast<const double*>(curPtr);
+        curPtr+=sizeof(double)*numAuxCoeffs;
+        SAux=reinterpret_cast<const double*>(curPtr);
+        curPtr+=sizeof(double)*numAuxCoeffs;
+    }
+    CO=reinterpret_cast<const double*>(curPtr);
+    curPtr+=sizeof(double)*header.orderMajorSize;
+    SO=reinterpret_cast<const double*>(curPtr);
+    curPtr+=sizeof(double)*header.orderMajorSize;
+    degAmp=reinterpret_cast<const double*>(curPtr);
+
+    offsetArray.resize(static_cast<size_t>(header.M)+1);
+    clusterSizes.resize(static_cast<size_t>(header.M)+1);
+    for(n=0;n<=header.M;n++) {
+        if(offsets[n]!=n*(n+1)/2) {
+            close();
+            return SPHER_HARMONIC_COEFF_BAD_HEADER;
+        }
+        offsetArray[n]=static_cast<size_t>(offsets[n]);
+        clusterSizes[n]=n+1;
+    }
+
+    return SPHER_HARMONIC_COEFF_OK;
+}
+
+void SpherHarmonicCoeffFileCPP::getClusterSet(ClusterSetCPP<double> &dest, const double *els, const size_t maxDeg) const {
+    dest.numClust=maxDeg+1;
+    dest.totalNumEl=(maxDeg+1)*(maxDeg+2)/2;
+    //The ClusterSet is only read.
+    dest.clusterEls=const_cast<double*>(els);
+    dest.offsetArray=const_cast<size_t*>(offsetArray.data());
+    dest.clusterSizes=const_cast<size_t*>(clusterSizes.data());
+}
+
+const char *SpherHarmonicCoeffFileCPP::errorString(const int errorCode) {
+    switch(errorCode) {
+        case SPHER_HARMONIC_COEFF_OK:
+            return "No error.";
+        case SPHER_HARMONIC_COEFF_OPEN_FAILED:
+            return "The coefficient file could not be opened.";
+        case SPHER_HARMONIC_COEFF_BAD_HEADER:
+            return "The file is not a valid spherical harmonic coefficient file.";
+        case SPHER_HARMONIC_COEFF_BAD_BYTE_ORDER:
+            return "The coefficient file was written on a machine with a different byte order.";
+        case SPHER_HARMONIC_COEFF_BAD_SIZE:
+            return "The size of the coefficient file does not match its header.";
+        case SPHER_HARMONIC_COEFF_MAP_FAILED:
+            return "The coefficient file could not be memory mapped.";
+        default:
+            return "Unknown error.";
+    }
+}
+
+void SpherHarmonicCoeffFileCPP::close() {
+    file.close();
+    C=NULL;
+    S=NULL;
+    CAux=NULL;
+    SAux=NULL;
+    CO=NULL;
+    SO=NULL;
+    degAmp=NULL;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
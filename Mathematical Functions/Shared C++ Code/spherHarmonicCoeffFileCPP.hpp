@@ -0,0 +1,150 @@
+/**SPHERHARMONICCOEFFFILECPP A header file for reading and writing a binary
+ *                    file of spherical harmonic coefficients that is
+ *                    memory mapped when it is read. Loading a large model
+ *                    such as EGM2008 from text or from a .mat file takes a
+ *                    long time and the coefficients then have to be held in
+ *                    memory. When a coefficient file is memory mapped,
+ *                    opening it takes almost no time, only the parts of the
+ *                    file that are used are read from disk and the
+ *                    operating system can share the pages between
+ *                    processes.
+ *
+ *All values in the file are stored in the native byte order of the machine
+ *that wrote it. The file consists of
+ *1) A 72-byte header with the fields of the SpherHarmonicCoeffHeaderCPP
+ *   structure below.
+ *2) The M+1 offsets of the degrees, as 64-bit unsigned integers. Degree n
+ *   has the n+1 orders m=0 to n and offset n*(n+1)/2, as in the
+ *   offsetArray member of a ClusterSet.
+ *3) The (M+1)*(M+2)/2 fully normalized C coefficients stored by degree in
+ *   the same manner as the clusterEls member of a ClusterSet, followed by
+ *   the S coefficients.
+ *4) If numSets=4, two more sets of (MAux+1)*(MAux+2)/2 values stored by
+ *   degree for C and S. These are the standard deviations of the
+ *   coefficients if auxType=1, or their rates of change per year if
+ *   auxType=2.
+ *5) The C and S coefficients in the order-major layout of
+ *   spherHarmonicKernelsCPP.hpp for maximum degree M, each having
+ *   orderMajorSize elements. These are what the algorithm of Holmes and
+ *   Featherstone uses, so a model can be evaluated directly from the
+ *   mapped file without copying anything.
+ *6) The M+1 degree amplitudes of C and S, as in spherHarmonicDegAmpCPP.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef SPHERHARMONICCOEFFFILECPP
+#define SPHERHARMONICCOEFFFILECPP
+
+#include <stddef.h>
+#include <stdint.h>
+#include "MappedFileCPP.hpp"
+#include <vector>
+#include "ClusterSetCPP.hpp"
+
+//The value of the byteOrder field of the header.
+#define SPHER_HARMONIC_COEFF_BYTE_ORDER 0x01020304u
+#define SPHER_HARMONIC_COEFF_VERSION 1u
+
+//The possible values of auxType.
+#define SPHER_HARMONIC_COEFF_AUX_NONE 0u
+#define SPHER_HARMONIC_COEFF_AUX_STD_DEV 1u
+#define SPHER_HARMONIC_COEFF_AUX_RATE 2u
+
+//The possible return values of open.
+#define SPHER_HARMONIC_COEFF_OK 0
+#define SPHER_HARMONIC_COEFF_OPEN_FAILED 1
+#define SPHER_HARMONIC_COEFF_BAD_HEADER 2
+#define SPHER_HARMONIC_COEFF_BAD_BYTE_ORDER 3
+#define SPHER_HARMONIC_COEFF_BAD_SIZE 4
+#define SPHER_HARMONIC_COEFF_MAP_FAILED 5
+
+typedef struct {
+    //The characters SPHHARMC.
+    char magic[8];
+    uint32_t version;
+    //SPHER_HARMONIC_COEFF_BYTE_ORDER as written by the machine that made
+    //the file.
+    uint32_t byteOrder;
+    //The maximum degree of C and S.
+    uint64_t M;
+    //The maximum degree of the auxiliary sets, MAux<=M.
+    uint64_t MAux;
+    //2 if only C and S are present, 4 if the auxiliary sets are present.
+    uint32_t numSets;
+    uint32_t auxType;
+    //The number of elements in each of the order-major arrays.
+    uint64_t orderMajorSize;
+    double a;
+    double c;
+    //The reference epoch of the coefficients, such as a decimal year, if
+    //the auxiliary sets are rates. This is not otherwise used.
+    double refEpoch;
+} SpherHarmonicCoeffHeaderCPP;
+
+int writeSpherHarmonicCoeffFileCPP(const char *fileName, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S, const ClusterSetCPP<double> *CAux, const ClusterSetCPP<double> *SAux, const uint32_t auxType, const double refEpoch, const double a, const double c);
+/*WRITESPHERHARMONICCOEFFFILECPP Write a coefficient file. C and S hold
+ *                  fully normalized coefficients up to degree
+ *                  M=C.numClust-1. If CAux and SAux are not NULL, they are
+ *                  written as the auxiliary sets and must not have a
+ *                  higher degree than C. The return value is
+ *                  SPHER_HARMONIC_COEFF_OK on success and
+ *                  SPHER_HARMONIC_COEFF_OPEN_FAILED if the file could not
+ *                  be written.
+ */
+
+class SpherHarmonicCoeffFileCPP {
+public:
+    SpherHarmonicCoeffHeaderCPP header;
+    //Pointers into the mapped file. CAux and SAux are NULL if numSets=2.
+    const double *C;
+    const double *S;
+    const double *CAux;
+    const double *SAux;
+    const double *CO;
+    const double *SO;
+    const double *degAmp;
+
+    SpherHarmonicCoeffFileCPP();
+    ~SpherHarmonicCoeffFileCPP();
+
+    int open(const char *fileName);
+    /*Map the given file and check its header and size. The return value is
+     *SPHER_HARMONIC_COEFF_OK on success or one of the other
+     *SPHER_HARMONIC_COEFF_ values on failure.*/
+
+    void getClusterSet(ClusterSetCPP<double> &dest, const double *els, const size_t maxDeg) const;
+    /*Make dest a view of the values in els, which must be one of C, S,
+     *CAux or SAux, truncated to degree maxDeg. The maximum degree must not
+     *be more than M (or MAux for the auxiliary sets). dest does not own
+     *the memory and must not be modified.*/
+
+    static const char *errorString(const int errorCode);
+    /*Get a description of a value returned by open.*/
+private:
+    //The offsets and cluster sizes are copied into native size_t values,
+    //since size_t is not 64 bits on all systems.
+    std::vector<size_t> offsetArray;
+    std::vector<size_t> clusterSizes;
+    MappedFileCPP file;
+    void close();
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
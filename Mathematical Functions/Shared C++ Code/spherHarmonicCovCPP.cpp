@@ -12,6 +12,13 @@
  *can be consulted for more information regarding the implementation and
  *the meaning of the results. 
  *
+ *The points can be split between multiple threads by setting numThreads
+ *to a value other than 1 (zero means use the number of hardware
+ *threads). The results do not depend on the number of threads. The sums
+ *for a single point are in spherHarmonicCovPointCPP so that they can also
+ *be used by spherHarmonicEvalCovCPP, which shares the Legendre function
+ *values between the potential and its covariance.
+ *
  *April 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
  **/
 /*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
@@ -24,6 +31,8 @@
 #include <limits>
 //for memset
 #include <string.h>
+//For splitting the points between threads.
+#include "parallelForCPP.hpp"
 
 //Windows does not support the isfinite function in C++, so we have to
 //define it if this is compiled under Windows. The _WIN32 macro is defined
@@ -37,14 +46,57 @@ template<typename T> bool isfinite(T arg)
 }
 #endif
 
-void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t numPoints, const double a, const double c, const double scalFactor) {
-    //If a NULL pointer is passed for gradV, then it is assumed that the
-    //gradient is not desired. Otherwise, a pointer to a buffer for 3
-    //doubles should be passed.
+//Prototypes for functions used in this file that are not present in
+//the header mathFuncs.hpp.
+void spherHarmonicCovChunkCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t startPoint, const size_t endPoint, const double a, const double c, const double scalFactor);
+
+/*The SpherHarmonicCovChunk class is used with parallelForCPP to compute
+ *the covariances for contiguous chunks of the points in separate
+ *threads.*/
+class SpherHarmonicCovChunk {
+public:
+    double *sigma2;
+    double *Sigma;
+    const ClusterSetCPP<double> *CStdDev;
+    const ClusterSetCPP<double> *SStdDev;
+    const double *point;
+    double a;
+    double c;
+    double scalFactor;
+
+    void operator()(const size_t threadIdx,const size_t startPoint,const size_t endPoint) {
+        (void)threadIdx;
+        spherHarmonicCovChunkCPP(sigma2,Sigma,*CStdDev,*SStdDev,point,startPoint,endPoint,a,c,scalFactor);
+    }
+};
+
+void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t numPoints, const double a, const double c, const double scalFactor, const size_t numThreads) {
+    //If a NULL pointer is passed for Sigma, then it is assumed that the
+    //covariance matrix of the gradient is not desired. Otherwise, a
+    //pointer to a buffer for 9 doubles per point should be passed.
+    SpherHarmonicCovChunk evaluator;
+
+    evaluator.sigma2=sigma2;
+    evaluator.Sigma=Sigma;
+    evaluator.CStdDev=&CStdDev;
+    evaluator.SStdDev=&SStdDev;
+    evaluator.point=point;
+    evaluator.a=a;
+    evaluator.c=c;
+    evaluator.scalFactor=scalFactor;
+
+    parallelForCPP(numPoints,numThreads2UseCPP(numThreads,numPoints),evaluator);
+}
+
+void spherHarmonicCovChunkCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t startPoint, const size_t endPoint, const double a, const double c, const double scalFactor) {
+/*SPHERHARMONICCOVCHUNKCPP Compute the covariances for the points from
+ *                    startPoint to endPoint-1 serially. This can be called
+ *                    from multiple threads at once on disjoint ranges of
+ *                    points.
+ */
     double r, *nCoeff;
     const size_t M=CStdDev.numClust-1;
     size_t n,m,curPoint;
-    double nf,mf;
     double rPrevVal,thetaPrev;
     ClusterSetCPP<double> FuncVals;
     ClusterSetCPP<double> FuncDerivs;
@@ -94,7 +146,7 @@ void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<doub
     
     rPrevVal=std::numeric_limits<double>::infinity();
     thetaPrev=std::numeric_limits<double>::infinity();
-    for(curPoint=0;curPoint<numPoints;curPoint++) {
+    for(curPoint=startPoint;curPoint<endPoint;curPoint++) {
         double thetaCur;
         bool rChanged;
         bool thetaChanged;
@@ -129,10 +181,14 @@ void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<doub
         t=CartPoint[1]/r;
         u=CartPoint[2]/r;
 
-        //Compute the fully normalized Helmholtz polynomials.
+        //Compute the fully normalized Helmholtz polynomials and, if the
+        //covariance matrix of the gradient is desired, their derivatives.
         if(thetaChanged) {
             normHelmHoltzCPP(FuncVals,u, scalFactor);
-            thetaPrev=thetaCur;
+
+            if(Sigma!=NULL) {
+                normHelmHoltzDerivCPP(FuncDerivs,FuncVals);
+            }
         }
 
         //Recursively compute the rm and im terms for the sums.
@@ -144,70 +200,108 @@ void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<doub
             im[m]=s*im[m-1]+t*rm[m-1];
         }
 
-        //Perform the sum for the potential from Equation 44 in the
-        //Fantino and Casotto paper.
-        sigma2[curPoint]=0;
-        for(n=0;n<=M;n++) {
-            double innerTerm=0;
-            for(m=0;m<=n;m++) {
-                double CVal, SVal, rVal, iVal, FVal;
-                double temp1, temp2;
-                CVal=CStdDev[n][m];
-                SVal=SStdDev[n][m];
-                rVal=rm[m];
-                iVal=im[m];
-                FVal=FuncVals[n][m];
-                
-                temp1=CVal*rVal*FVal;
-                temp2=SVal*iVal*FVal;
-                
-                innerTerm+=temp1*temp1+temp2*temp2;
-            }
-            sigma2[curPoint]+=nCoeff[n]*nCoeff[n]*innerTerm;
+        spherHarmonicCovPointCPP(sigma2+curPoint,(Sigma==NULL)?NULL:Sigma+9*curPoint,CStdDev,SStdDev,FuncVals,FuncDerivs,nCoeff,rm,im,M,r,s,t,u,c,scalFactor);
+    }
+    
+    delete[] buffer;
+}
+
+void spherHarmonicCovPointCPP(double *sigma2, double *Sigma, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const ClusterSetCPP<double> &FuncVals, const ClusterSetCPP<double> &FuncDerivs, const double *nCoeff, const double *rm, const double *im, const size_t N, const double r, const double s, const double t, const double u, const double c, const double scalFactor) {
+/*SPHERHARMONICCOVPOINTCPP Compute the variance of the potential and, if
+ *                    Sigma is not NULL, the covariance matrix of the
+ *                    gradient at a single point using the degrees from 0
+ *                    to N. FuncVals holds the fully normalized Helmholtz
+ *                    polynomials of u scaled by scalFactor and FuncDerivs
+ *                    holds their derivatives, which are only used if
+ *                    Sigma is not NULL. nCoeff holds (a/r)^n and rm and im
+ *                    are the terms of Equation 49 of the Fantino and
+ *                    Casotto paper. s, t and u are the direction cosines
+ *                    of the point.
+ */
+    size_t n,m;
+    double nf,mf;
+
+    //Perform the sum for the potential from Equation 44 in the
+    //Fantino and Casotto paper.
+    (*sigma2)=0;
+    for(n=0;n<=N;n++) {
+        double innerTerm=0;
+        for(m=0;m<=n;m++) {
+            double CVal, SVal, rVal, iVal, FVal;
+            double temp1, temp2;
+            CVal=CStdDev[n][m];
+            SVal=SStdDev[n][m];
+            rVal=rm[m];
+            iVal=im[m];
+            FVal=FuncVals[n][m];
+            
+            temp1=CVal*rVal*FVal;
+            temp2=SVal*iVal*FVal;
+            
+            innerTerm+=temp1*temp1+temp2*temp2;
         }
-        
-        //The variance of the potential.
-        sigma2[curPoint]=(c/r)*(c/r)*sigma2[curPoint]/(scalFactor*scalFactor);
+        (*sigma2)+=nCoeff[n]*nCoeff[n]*innerTerm;
+    }
+    
+    //The variance of the potential.
+    (*sigma2)=(c/r)*(c/r)*(*sigma2)/(scalFactor*scalFactor);
 
-        //Compute the covariance matrix of the gradient, if needed.
-        if(Sigma!=NULL) {
-            double a11=0;
-            double a22=0;
-            double a33=0;
-            double a44=0;
-            double a12=0;
-            double a13=0;
-            double a14=0;
-            double a23=0;
-            double a24=0;
-            double a34=0;
+    //Compute the covariance matrix of the gradient, if needed.
+    if(Sigma!=NULL) {
+        double a11=0;
+        double a22=0;
+        double a33=0;
+        double a44=0;
+        double a12=0;
+        double a13=0;
+        double a14=0;
+        double a23=0;
+        double a24=0;
+        double a34=0;
 
-            normHelmHoltzDerivCPP(FuncDerivs,FuncVals);
+        //The equations in these loops are from Table 10.
+        nf=0.0;
+        for(n=0;n<=N;n++) {
+            double CProdMN;
+            double HVal;
+            double dHVal;
+            double Lmn;
+            double CCur2,SCur2,rCur,iCur;
+            
+            double a11Loop=0;
+            double a22Loop=0;
+            double a33Loop;
+            double a12Loop=0;
+            double a13Loop=0;
+            double a14Loop=0;
+            double a23Loop=0;
+            double a24Loop=0;
+            double a34Loop;
+            double a44Loop;
 
-            //The equations in these loops are from Table 10.
-            nf=0.0;
-            for(n=0;n<=M;n++) {
-                double CProdMN;
-                double HVal;
-                double dHVal;
-                double Lmn;
-                double CCur2,SCur2,rCur,iCur;
+            //The m=0 case only applies to a3 and a4, so that means only to
+            //a33, a34, and a44.
+            m=0;
+            mf=0.0;
+            HVal=FuncVals[n][m];
+            dHVal=FuncDerivs[n][m];
+            CCur2=CStdDev[n][m]*CStdDev[n][m];
+            SCur2=SStdDev[n][m]*SStdDev[n][m];
+            rCur=rm[m];
+            iCur=im[m];
+            
+            CProdMN=CCur2*rCur*rCur+SCur2*iCur*iCur;
+            Lmn=(nf+mf+1)*HVal+u*dHVal;//Defined in Table 14.
+            
+            a33Loop=CProdMN*dHVal*dHVal;
+            a44Loop=CProdMN*Lmn*Lmn;
+            a34Loop=-CProdMN*Lmn*dHVal;
+            
+            mf=1.0;
+            for(m=1;m<=n;m++) {
+                const double rPrev=rm[m-1];
+                const double iPrev=im[m-1];
                 
-                double a11Loop=0;
-                double a22Loop=0;
-                double a33Loop;
-                double a12Loop=0;
-                double a13Loop=0;
-                double a14Loop=0;
-                double a23Loop=0;
-                double a24Loop=0;
-                double a34Loop;
-                double a44Loop;
-
-                //The m=0 case only applies to a3 and a4, so that means only to
-                //a33, a34, and a44.
-                m=0;
-                mf=0.0;
                 HVal=FuncVals[n][m];
                 dHVal=FuncDerivs[n][m];
                 CCur2=CStdDev[n][m]*CStdDev[n][m];
@@ -216,101 +310,76 @@ void spherHarmonicCovCPP(double *sigma2, double *Sigma, const ClusterSetCPP<doub
                 iCur=im[m];
                 
                 CProdMN=CCur2*rCur*rCur+SCur2*iCur*iCur;
-                Lmn=(nf+mf+1)*HVal+u*dHVal;//Defined in Table 14.
+                Lmn=(nf+mf+1)*HVal+u*dHVal;
                 
-                a33Loop=CProdMN*dHVal*dHVal;
-                a44Loop=CProdMN*Lmn*Lmn;
-                a34Loop=-CProdMN*Lmn*dHVal;
+                a11Loop+=mf*mf*(CCur2*rPrev*rPrev+SCur2*iPrev*iPrev)*HVal*HVal;
+                a22Loop+=mf*mf*(SCur2*rPrev*rPrev+CCur2*iPrev*iPrev)*HVal*HVal;
+                //This is to deal with numerical precision problems near the
+                //poles. We want to avoid 0*Inf terms due to limitations in
+                //the valid range of double precision numbers. Of course,
+                //the loss of the terms where overflow occurs means that the
+                //covariance matrix will be underestimated.
+                if(isfinite(Lmn)) {
+                    a44Loop+=CProdMN*Lmn*Lmn;
+                    a14Loop-=mf*(CCur2*rPrev*rCur+SCur2*iPrev*iCur)*HVal*Lmn;
+                    a24Loop-=mf*(-CCur2*iPrev*rCur+SCur2*rPrev*iCur)*HVal*Lmn;
+                    a34Loop-=CProdMN*Lmn*dHVal;
+                }
                 
-                mf=1.0;
-                for(m=1;m<=n;m++) {
-                    const double rPrev=rm[m-1];
-                    const double iPrev=im[m-1];
-                    
-                    HVal=FuncVals[n][m];
-                    dHVal=FuncDerivs[n][m];
-                    CCur2=CStdDev[n][m]*CStdDev[n][m];
-                    SCur2=SStdDev[n][m]*SStdDev[n][m];
-                    rCur=rm[m];
-                    iCur=im[m];
-                    
-                    CProdMN=CCur2*rCur*rCur+SCur2*iCur*iCur;
-                    Lmn=(nf+mf+1)*HVal+u*dHVal;
-                    
-                    a11Loop+=mf*mf*(CCur2*rPrev*rPrev+SCur2*iPrev*iPrev)*HVal*HVal;
-                    a22Loop+=mf*mf*(SCur2*rPrev*rPrev+CCur2*iPrev*iPrev)*HVal*HVal;
-                    //This is to deal with numerical precision problems near the
-                    //poles. We want to avoid 0*Inf terms due to limitations in
-                    //the valid range of double precision numbers. Of course,
-                    //the loss of the terms where overflow occurs means that the
-                    //covariance matrix will be underestimated.
-                    if(isfinite(Lmn)) {
-                        a44Loop+=CProdMN*Lmn*Lmn;
-                        a14Loop-=mf*(CCur2*rPrev*rCur+SCur2*iPrev*iCur)*HVal*Lmn;
-                        a24Loop-=mf*(-CCur2*iPrev*rCur+SCur2*rPrev*iCur)*HVal*Lmn;
-                        a34Loop-=CProdMN*Lmn*dHVal;
-                    }
-                    
-                    if(isfinite(dHVal)) {
-                        a33Loop+=CProdMN*dHVal*dHVal;
-                        a13Loop+=mf*(CCur2*rPrev*rCur+SCur2*iPrev*iCur)*HVal*dHVal;
-                        a23Loop+=mf*(-CCur2*iPrev*rCur+SCur2*rPrev*iCur)*HVal*dHVal;
-                    }
-                    
-                    a12Loop+=mf*mf*rPrev*iPrev*(SCur2-CCur2)*HVal*HVal;
-
-                    mf++;
+                if(isfinite(dHVal)) {
+                    a33Loop+=CProdMN*dHVal*dHVal;
+                    a13Loop+=mf*(CCur2*rPrev*rCur+SCur2*iPrev*iCur)*HVal*dHVal;
+                    a23Loop+=mf*(-CCur2*iPrev*rCur+SCur2*rPrev*iCur)*HVal*dHVal;
                 }
+                
+                a12Loop+=mf*mf*rPrev*iPrev*(SCur2-CCur2)*HVal*HVal;
 
-                {
-                    const double nCoeff2=nCoeff[n]*nCoeff[n];
-                    
-                    a11+=nCoeff2*a11Loop;
-                    a22+=nCoeff2*a22Loop;
-                    a33+=nCoeff2*a33Loop;
-                    a44+=nCoeff2*a44Loop;
-                    a12+=nCoeff2*a12Loop;
-                    a13+=nCoeff2*a13Loop;
-                    a14+=nCoeff2*a14Loop;
-                    a23+=nCoeff2*a23Loop;
-                    a24+=nCoeff2*a24Loop;
-                    a34+=nCoeff2*a34Loop;
-                }
+                mf++;
+            }
 
-                nf++;
+            {
+                const double nCoeff2=nCoeff[n]*nCoeff[n];
+                
+                a11+=nCoeff2*a11Loop;
+                a22+=nCoeff2*a22Loop;
+                a33+=nCoeff2*a33Loop;
+                a44+=nCoeff2*a44Loop;
+                a12+=nCoeff2*a12Loop;
+                a13+=nCoeff2*a13Loop;
+                a14+=nCoeff2*a14Loop;
+                a23+=nCoeff2*a23Loop;
+                a24+=nCoeff2*a24Loop;
+                a34+=nCoeff2*a34Loop;
             }
 
+            nf++;
+        }
+
 //These are based on squaring the terms in equation 70, removing cross
 //terms. However, an additional 1/r (squared) term has been added,
 //which the original paper omitted when going from Equation 68 to 70.
-            {
-                double temp=c/(r*r*scalFactor);
-                double s11=a11+2*s*a14+s*s*a44;
-                double s12=a12+s*a24+t*a14+s*t*a44;
-                double s13=a13+s*a34+u*a14+s*u*a44;
-                double s22=a22+2*t*a24+t*t*a44;
-                double s23=a23+t*a34+u*a24+t*u*a44;
-                double s33=a33+2*u*a34+u*u*a44;
-                
-                temp*=temp;
+        {
+            double temp=c/(r*r*scalFactor);
+            double s11=a11+2*s*a14+s*s*a44;
+            double s12=a12+s*a24+t*a14+s*t*a44;
+            double s13=a13+s*a34+u*a14+s*u*a44;
+            double s22=a22+2*t*a24+t*t*a44;
+            double s23=a23+t*a34+u*a24+t*u*a44;
+            double s33=a33+2*u*a34+u*u*a44;
+            
+            temp*=temp;
 
-                *Sigma=temp*s11;
-                *(Sigma+1)=temp*s12;
-                *(Sigma+2)=temp*s13;
-                *(Sigma+3)=temp*s12;
-                *(Sigma+4)=temp*s22;
-                *(Sigma+5)=temp*s23;
-                *(Sigma+6)=temp*s13;
-                *(Sigma+7)=temp*s23;
-                *(Sigma+8)=temp*s33;
-                
-                //Go to the next point.
-                Sigma+=9;
-            }
+            *Sigma=temp*s11;
+            *(Sigma+1)=temp*s12;
+            *(Sigma+2)=temp*s13;
+            *(Sigma+3)=temp*s12;
+            *(Sigma+4)=temp*s22;
+            *(Sigma+5)=temp*s23;
+            *(Sigma+6)=temp*s13;
+            *(Sigma+7)=temp*s23;
+            *(Sigma+8)=temp*s33;
         }
     }
-    
-    delete[] buffer;
 }
 
 /*LICENSE:
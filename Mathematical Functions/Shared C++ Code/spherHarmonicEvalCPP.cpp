@@ -10,6 +10,27 @@
  *can be consulted for more information regarding the implementation and
  *the meaning of the results. 
  *
+ *The points can be split between multiple threads by setting numThreads
+ *to a value other than 1 (zero means use the number of hardware
+ *threads). The results are identical regardless of the number of
+ *threads.
+ *
+ *Away from the poles, the Legendre function ratios and the lumped
+ *coefficients are computed using the vectorized, order-major functions in
+ *spherHarmonicKernelsCPP.hpp.
+ *
+ *When spherHarmonicEvalPreparedCPP is given a relative tolerance, the
+ *series at each point is truncated at the lowest degree for which the
+ *neglected terms, scaled by (a/r)^n, are within the tolerance. Far from
+ *the reference sphere, such as at orbital altitudes, this uses far fewer
+ *degrees than are in the model.
+ *
+ *spherHarmonicEvalCovCPP computes the potential together with the results
+ *of spherHarmonicCovCPP. The Legendre function ratios of Holmes and
+ *Featherstone, P[n][m]/u^m, are the fully normalized Helmholtz
+ *polynomials used for the covariance, so they are only computed once for
+ *both.
+ *
  *January 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
  **/
 /*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
@@ -22,19 +43,374 @@
 #include <limits>
 //for memset
 #include <string.h>
+//For stable_sort
+#include <algorithm>
+//For splitting the points between threads.
+#include "parallelForCPP.hpp"
+//For the vectorized Legendre recursion and sums.
+#include "spherHarmonicKernelsCPP.hpp"
+//For the work buffers and spherHarmonicEvalPreparedCPP.
+#include "spherHarmonicModelCPP.hpp"
+#include <vector>
+
+//Prototypes for functions used in this file that are not present in
+//the header mathFuncs.hpp.
+void spherHarmonicEvalChunkCPP(double *V, double *gradV, double *HessV, double *sigma2, double *Sigma, const ClusterSetCPP<double> *CStdDev, const ClusterSetCPP<double> *SStdDev, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const SpherHarmonicLayoutCPP &layout, const double *CO, const double *SO, const double *point, const size_t *maxDegs, const size_t startPoint, const size_t endPoint, const double a, const double c, const double scalFactor, SpherHarmonicScratchCPP &scratch);
+void spherHessian2CartCPP(double *HessCart, const double *pointSpher, const double *dVSpher, const double *d2VSpher);
+
+/*The DecreasingDegCompare class is used with stable_sort to order the
+ *indices of points by decreasing maximum degree.*/
+class DecreasingDegCompare {
+public:
+    const size_t *maxDegs;
 
-void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const double *point, const size_t numPoints, const double a, const double c, const double scalFactor) {
+    bool operator()(const size_t idx1, const size_t idx2) const {
+        return maxDegs[idx1]>maxDegs[idx2];
+    }
+};
+
+/*The SpherHarmonicEvalChunk class is used with parallelForCPP to evaluate
+ *contiguous chunks of the points in separate threads. Each thread has its
+ *own work buffers, so the reuse of values between consecutive points
+ *having the same range and/or latitude is preserved within each chunk.*/
+class SpherHarmonicEvalChunk {
+public:
+    double *V;
+    double *gradV;
+    double *HessV;
+    //The covariance outputs and the standard deviations of the
+    //coefficients. These are NULL if the covariance is not desired.
+    double *sigma2;
+    double *Sigma;
+    const ClusterSetCPP<double> *CStdDev;
+    const ClusterSetCPP<double> *SStdDev;
+    const ClusterSetCPP<double> *C;
+    const ClusterSetCPP<double> *S;
+    const SpherHarmonicLayoutCPP *layout;
+    //The coefficients in the order-major layout.
+    const double *CO;
+    const double *SO;
+    const double *point;
+    //The maximum degree for each point, or NULL if all degrees are used.
+    const size_t *maxDegs;
+    /*If segStart is not NULL, then the items passed by parallelForCPP are
+     *segments of points rather than points, with segment i holding the
+     *points segStart[i] to segStart[i+1]-1. This is used to balance the
+     *work when the points have different maximum degrees.*/
+    const size_t *segStart;
+    double a;
+    double c;
+    double scalFactor;
+    SpherHarmonicScratchCPP *scratch;
+
+    void operator()(const size_t threadIdx,const size_t startItem,const size_t endItem) {
+        if(segStart==NULL) {
+            spherHarmonicEvalChunkCPP(V,gradV,HessV,sigma2,Sigma,CStdDev,SStdDev,*C,*S,*layout,CO,SO,point,maxDegs,startItem,endItem,a,c,scalFactor,scratch[threadIdx]);
+        } else {
+            spherHarmonicEvalChunkCPP(V,gradV,HessV,sigma2,Sigma,CStdDev,SStdDev,*C,*S,*layout,CO,SO,point,maxDegs,segStart[startItem],segStart[endItem],a,c,scalFactor,scratch[threadIdx]);
+        }
+    }
+};
+
+void spherHarmonicEvalCPP(double *V, double *gradV, double *HessV, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const double *point, const size_t numPoints, const double a, const double c, const double scalFactor, const size_t numThreads) {
     //If a NULL pointer is passed for gradV, then it is assumed that the
     //gradient is not desired. Otherwise, a pointer to a buffer for 3
-    //doubles should be passed.
-    double temp, r, lambda, *nCoeff;
+    //doubles per point should be passed. Similarly, if HessV is not NULL,
+    //then it should point to a buffer for 9 doubles per point and gradV
+    //must also not be NULL.
+    const std::shared_ptr<const SpherHarmonicLayoutCPP> layout=getSpherHarmonicLayoutCPP(C.numClust-1);
+    //The coefficients are copied into the order-major layout once and
+    //shared by all of the threads.
+    std::vector<double> CO(layout->totalSize);
+    std::vector<double> SO(layout->totalSize);
+    std::vector<SpherHarmonicScratchCPP> scratch;
+
+    orderMajorFromClusterSetCPP(CO.data(),C,*layout);
+    orderMajorFromClusterSetCPP(SO.data(),S,*layout);
+
+    spherHarmonicEvalPreparedCPP(V,gradV,HessV,C,S,*layout,CO.data(),SO.data(),point,numPoints,a,c,scalFactor,NULL,0,numThreads,scratch);
+}
+
+void spherHarmonicEvalPreparedCPP(double *V, double *gradV, double *HessV, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S, const SpherHarmonicLayoutCPP &layout, const double *CO, const double *SO, const double *point, const size_t numPoints, const double a, const double c, const double scalFactor, const double *degAmp, const double relTol, const size_t numThreads, std::vector<SpherHarmonicScratchCPP> &scratch) {
+    const size_t M=C.numClust-1;
+    const size_t numThreadsUsed=numThreads2UseCPP(numThreads,numPoints);
+    SpherHarmonicEvalChunk evaluator;
+
+    if(scratch.size()<numThreadsUsed) {
+        scratch.resize(numThreadsUsed);
+    }
+
+    evaluator.V=V;
+    evaluator.gradV=gradV;
+    evaluator.HessV=HessV;
+    evaluator.sigma2=NULL;
+    evaluator.Sigma=NULL;
+    evaluator.CStdDev=NULL;
+    evaluator.SStdDev=NULL;
+    evaluator.C=&C;
+    evaluator.S=&S;
+    evaluator.layout=&layout;
+    evaluator.CO=CO;
+    evaluator.SO=SO;
+    evaluator.point=point;
+    evaluator.maxDegs=NULL;
+    evaluator.segStart=NULL;
+    evaluator.a=a;
+    evaluator.c=c;
+    evaluator.scalFactor=scalFactor;
+    evaluator.scratch=scratch.data();
+
+    if(relTol>0&&degAmp!=NULL&&numPoints>0) {
+        const size_t derivOrder=(HessV!=NULL)?2:((gradV!=NULL)?1:0);
+        std::vector<size_t> maxDegs(numPoints);
+        double rPrev=std::numeric_limits<double>::infinity();
+        size_t NPrev=M;
+        bool isTruncated=false;
+        size_t curPoint;
+
+        //The degree only depends on the range, so it is only recomputed
+        //when the range changes.
+        for(curPoint=0;curPoint<numPoints;curPoint++) {
+            const double r=point[3*curPoint];
+
+            if(r!=rPrev) {
+                NPrev=spherHarmonicTruncDegCPP(degAmp,M,a/r,relTol,derivOrder);
+                rPrev=r;
+            }
+            maxDegs[curPoint]=NPrev;
+            isTruncated=isTruncated||NPrev<M;
+        }
+
+        if(isTruncated) {
+            std::vector<size_t> order(numPoints);
+            std::vector<size_t> sortedDegs(numPoints);
+            std::vector<double> sortedPoints(3*numPoints);
+            std::vector<double> sortedV(numPoints);
+            std::vector<double> sortedGradV((gradV==NULL)?0:3*numPoints);
+            std::vector<double> sortedHessV((HessV==NULL)?0:9*numPoints);
+            std::vector<double> pointCost(numPoints);
+            std::vector<size_t> segStart(numThreadsUsed+1);
+            DecreasingDegCompare degCompare;
+            double totalCost=0;
+            double curCost;
+            size_t curSeg;
+
+            /*The points are evaluated in order of decreasing degree. The
+             *stable sort keeps points with the same range and latitude
+             *together, so values are still reused between them, and the
+             *Legendre function ratios for a latitude can be reused for
+             *any lower degree.*/
+            for(curPoint=0;curPoint<numPoints;curPoint++) {
+                order[curPoint]=curPoint;
+            }
+            degCompare.maxDegs=maxDegs.data();
+            std::stable_sort(order.begin(),order.end(),degCompare);
+
+            for(curPoint=0;curPoint<numPoints;curPoint++) {
+                const size_t idx=order[curPoint];
+
+                sortedDegs[curPoint]=maxDegs[idx];
+                sortedPoints[3*curPoint]=point[3*idx];
+                sortedPoints[3*curPoint+1]=point[3*idx+1];
+                sortedPoints[3*curPoint+2]=point[3*idx+2];
+            }
+
+            /*The cost of a point is taken as O(N^2) if the range or
+             *latitude differs from the previous point, so the lumped
+             *coefficients must be recomputed, and as O(N) otherwise. Each
+             *thread gets a contiguous segment of points with about the
+             *same total cost.*/
+            for(curPoint=0;curPoint<numPoints;curPoint++) {
+                const double Nf=static_cast<double>(sortedDegs[curPoint]+1);
+                const bool isReused=curPoint>0&&sortedPoints[3*curPoint]==sortedPoints[3*(curPoint-1)]&&sortedPoints[3*curPoint+2]==sortedPoints[3*(curPoint-1)+2];
+
+                pointCost[curPoint]=isReused?Nf:Nf*Nf;
+                totalCost+=pointCost[curPoint];
+            }
+            segStart[0]=0;
+            curSeg=1;
+            curCost=0;
+            for(curPoint=0;curPoint<numPoints&&curSeg<numThreadsUsed;curPoint++) {
+                curCost+=pointCost[curPoint];
+                while(curSeg<numThreadsUsed&&curCost>=totalCost*static_cast<double>(curSeg)/static_cast<double>(numThreadsUsed)) {
+                    segStart[curSeg]=curPoint+1;
+                    curSeg++;
+                }
+            }
+            while(curSeg<=numThreadsUsed) {
+                segStart[curSeg]=numPoints;
+                curSeg++;
+            }
+
+            evaluator.V=sortedV.data();
+            evaluator.gradV=(gradV==NULL)?NULL:sortedGradV.data();
+            evaluator.HessV=(HessV==NULL)?NULL:sortedHessV.data();
+            evaluator.point=sortedPoints.data();
+            evaluator.maxDegs=sortedDegs.data();
+            evaluator.segStart=segStart.data();
+            parallelForCPP(numThreadsUsed,numThreadsUsed,evaluator);
+
+            //Put the results back in the original order of the points.
+            for(curPoint=0;curPoint<numPoints;curPoint++) {
+                const size_t idx=order[curPoint];
+                size_t k;
+
+                V[idx]=sortedV[curPoint];
+                if(gradV!=NULL) {
+                    for(k=0;k<3;k++) {
+                        gradV[3*idx+k]=sortedGradV[3*curPoint+k];
+                    }
+                }
+                if(HessV!=NULL) {
+                    for(k=0;k<9;k++) {
+                        HessV[9*idx+k]=sortedHessV[9*curPoint+k];
+                    }
+                }
+            }
+            return;
+        }
+    }
+
+    /*Every point is computed from scratch or from cached values that are
+     *identical to what would be computed from scratch, so the results do
+     *not depend on the number of threads.*/
+    parallelForCPP(numPoints,numThreadsUsed,evaluator);
+}
+
+void spherHarmonicEvalCovCPP(double *V, double *gradV, double *sigma2, double *Sigma, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const ClusterSetCPP<double> &CStdDev,const ClusterSetCPP<double> &SStdDev, const double *point, const size_t numPoints, const double a, const double c, const double scalFactor, const size_t numThreads) {
+    //gradV and Sigma are NULL if the gradient and the covariance matrix of
+    //the gradient are not desired. Sigma can only be used if gradV is not
+    //NULL. CStdDev and SStdDev must have the same maximum degree as C and
+    //S.
+    const std::shared_ptr<const SpherHarmonicLayoutCPP> layout=getSpherHarmonicLayoutCPP(C.numClust-1);
+    const size_t numThreadsUsed=numThreads2UseCPP(numThreads,numPoints);
+    std::vector<double> CO(layout->totalSize);
+    std::vector<double> SO(layout->totalSize);
+    std::vector<SpherHarmonicScratchCPP> scratch(numThreadsUsed);
+    SpherHarmonicEvalChunk evaluator;
+
+    orderMajorFromClusterSetCPP(CO.data(),C,*layout);
+    orderMajorFromClusterSetCPP(SO.data(),S,*layout);
+
+    evaluator.V=V;
+    evaluator.gradV=gradV;
+    evaluator.HessV=NULL;
+    evaluator.sigma2=sigma2;
+    evaluator.Sigma=Sigma;
+    evaluator.CStdDev=&CStdDev;
+    evaluator.SStdDev=&SStdDev;
+    evaluator.C=&C;
+    evaluator.S=&S;
+    evaluator.layout=layout.get();
+    evaluator.CO=CO.data();
+    evaluator.SO=SO.data();
+    evaluator.point=point;
+    evaluator.maxDegs=NULL;
+    evaluator.segStart=NULL;
+    evaluator.a=a;
+    evaluator.c=c;
+    evaluator.scalFactor=scalFactor;
+    evaluator.scratch=scratch.data();
+
+    parallelForCPP(numPoints,numThreadsUsed,evaluator);
+}
+
+void spherHarmonicDegAmpCPP(double *degAmp, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S) {
+    const size_t M=C.numClust-1;
+    size_t n, m;
+
+    for(n=0;n<=M;n++) {
+        double sumVal=0;
+
+        for(m=0;m<=n;m++) {
+            sumVal+=C[n][m]*C[n][m]+S[n][m]*S[n][m];
+        }
+        degAmp[n]=sqrt(sumVal);
+    }
+}
+
+size_t spherHarmonicTruncDegCPP(const double *degAmp, const size_t M, const double aOverR, const double relTol, const size_t derivOrder) {
+    double qn, nf, term, totalVal, maxTerm, partialSum;
+    size_t n;
+
+    //The first pass finds the sum of all of the terms and the largest
+    //term.
+    qn=1;
+    nf=0;
+    totalVal=0;
+    maxTerm=0;
+    for(n=0;n<=M;n++) {
+        term=qn*degAmp[n];
+        if(derivOrder>0) {
+            term*=nf+1;
+        }
+        if(derivOrder>1) {
+            term*=nf+2;
+        }
+        totalVal+=term;
+        if(term>maxTerm) {
+            maxTerm=term;
+        }
+        qn*=aOverR;
+        nf++;
+    }
+
+    //The second pass finds the lowest degree for which the sum of the
+    //remaining terms is within the tolerance. The terms are all positive,
+    //so the remaining sum is the total minus the partial sum.
+    qn=1;
+    nf=0;
+    partialSum=0;
+    for(n=0;n<M;n++) {
+        term=qn*degAmp[n];
+        if(derivOrder>0) {
+            term*=nf+1;
+        }
+        if(derivOrder>1) {
+            term*=nf+2;
+        }
+        partialSum+=term;
+        if(totalVal-partialSum<=relTol*maxTerm) {
+            return n;
+        }
+        qn*=aOverR;
+        nf++;
+    }
+    return M;
+}
+
+void spherHarmonicEvalChunkCPP(double *V, double *gradV, double *HessV, double *sigma2, double *Sigma, const ClusterSetCPP<double> *CStdDev, const ClusterSetCPP<double> *SStdDev, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const SpherHarmonicLayoutCPP &layout, const double *CO, const double *SO, const double *point, const size_t *maxDegs, const size_t startPoint, const size_t endPoint, const double a, const double c, const double scalFactor, SpherHarmonicScratchCPP &scratch) {
+/*SPHERHARMONICEVALCHUNKCPP Evaluate the points from startPoint to
+ *                    endPoint-1 serially using the work buffers in
+ *                    scratch. This can be called from multiple threads at
+ *                    once on disjoint ranges of points with different
+ *                    scratch. If maxDegs is not NULL, then the series for
+ *                    point i is only summed up to degree maxDegs[i]<=M.
+ *                    If sigma2 is not NULL, then the results of
+ *                    spherHarmonicCovCPP for the standard deviations in
+ *                    CStdDev and SStdDev are also computed. Sigma can
+ *                    only be used if gradV is not NULL.
+ */
+    double temp, r, lambda, *nCoeff, *nCoeffDr, *nCoeffDrr;
     const size_t M=C.numClust-1;
     const double pi = 2*acos(0.0);
     size_t n,m,curPoint;
     double nf,mf;
     double rPrev,thetaPrev;
+    //N is the maximum degree used for the current point. funcDeg is the
+    //maximum degree for which the Legendre function ratios or Helmholtz
+    //polynomials for the current latitude have been computed. helmDeg is
+    //the maximum degree of the Helmholtz polynomials copied from the
+    //Legendre function ratios for the covariance.
+    size_t N,NPrev,funcDeg,helmDeg;
+    //The rm and im terms for the covariance when the algorithm of Holmes
+    //and Featherstone is used, since rm and im then share memory with
+    //SinVec and CosVec.
+    double *covRm=NULL;
+    double *covIm=NULL;
     ClusterSetCPP<double> FuncVals;
     ClusterSetCPP<double> FuncDerivs;
+    ClusterSetCPP<double> FuncDerivs2;
     //These are to store sin(m*lambda) and cos(m*lambda) for m=0->M.
     double *SinVec,*CosVec;//This are each length C.numClust.
     //These are never used at the same time as SinVec andCosVec and are the
@@ -51,11 +427,19 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
     double *XSdr=NULL;
     double *XCdTheta=NULL;
     double *XSdTheta=NULL;
-    //A big chunk of memory will be allocated into a single buffer and
-    //split between the variables that need it. That is faster than
-    //allocating a bunch of small buffers, and all of the variables are of
-    //the same type.
+    //These values are only used if HessV!=NULL.
+    double *XCdrr=NULL;
+    double *XSdrr=NULL;
+    double *XCdrTheta=NULL;
+    double *XSdrTheta=NULL;
+    //A big chunk of memory is held in a single buffer and split between
+    //the variables that need it. That is faster than allocating a bunch of
+    //small buffers, and all of the variables are of the same type.
     double *buffer;
+    //The Legendre function ratios and their derivatives in the
+    //order-major layout for the algorithm of Holmes and Featherstone. The
+    //pad elements must be zero.
+    double *PO, *dPO;
         
     //Initialize the ClusterSet classes for the coefficients. The space
     //for the elements will be allocated shortly.
@@ -67,13 +451,46 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
     FuncDerivs.totalNumEl=C.totalNumEl;
     FuncDerivs.offsetArray=C.offsetArray;
     FuncDerivs.clusterSizes=C.clusterSizes;
+    FuncDerivs2.numClust=C.numClust;
+    FuncDerivs2.totalNumEl=C.totalNumEl;
+    FuncDerivs2.offsetArray=C.offsetArray;
+    FuncDerivs2.clusterSizes=C.clusterSizes;
 
-    //Allocate the buffer and partition it between variables.
+    //Size the buffers and partition them between variables. The pad
+    //elements of the order-major arrays are never written, so they stay
+    //zero when the buffers are reused.
     if(gradV==NULL){
-        buffer = new double[C.totalNumEl+5*C.numClust];
+        if(scratch.buffer.size()<C.totalNumEl+5*C.numClust) {
+            scratch.buffer.resize(C.totalNumEl+5*C.numClust);
+        }
+    }else if(HessV==NULL){
+        if(scratch.buffer.size()<2*C.totalNumEl+10*C.numClust) {
+            scratch.buffer.resize(2*C.totalNumEl+10*C.numClust);
+        }
+        if(scratch.dPO.size()!=layout.totalSize) {
+            scratch.dPO.assign(layout.totalSize,0.0);
+        }
     }else{
-        buffer = new double[2*C.totalNumEl+9*C.numClust];
+        if(scratch.buffer.size()<3*C.totalNumEl+15*C.numClust) {
+            scratch.buffer.resize(3*C.totalNumEl+15*C.numClust);
+        }
+        if(scratch.dPO.size()!=layout.totalSize) {
+            scratch.dPO.assign(layout.totalSize,0.0);
+        }
+    }
+    if(scratch.PO.size()!=layout.totalSize) {
+        scratch.PO.assign(layout.totalSize,0.0);
+    }
+    if(sigma2!=NULL) {
+        if(scratch.covBuffer.size()<2*C.numClust) {
+            scratch.covBuffer.resize(2*C.numClust);
+        }
+        covRm=scratch.covBuffer.data();
+        covIm=covRm+C.numClust;
     }
+    buffer=scratch.buffer.data();
+    PO=scratch.PO.data();
+    dPO=(gradV==NULL)?NULL:scratch.dPO.data();
     {
         double *tempPtr=buffer;
         //This stores all of the powers of a/r needed for the sum, regardless
@@ -98,7 +515,7 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
         if(gradV!=NULL) {
             tempPtr+=C.numClust;
             FuncDerivs.clusterEls=tempPtr;
-            tempPtr+=C.numClust;
+            tempPtr+=C.totalNumEl;
             XCdr=tempPtr;
             tempPtr+=C.numClust;
             XSdr=tempPtr;
@@ -106,6 +523,27 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
             XCdTheta=tempPtr;
             tempPtr+=C.numClust;
             XSdTheta=tempPtr;
+            tempPtr+=C.numClust;
+            nCoeffDr=tempPtr;
+        } else {
+            nCoeffDr=NULL;
+        }
+
+        if(HessV!=NULL) {
+            tempPtr+=C.numClust;
+            FuncDerivs2.clusterEls=tempPtr;
+            tempPtr+=C.totalNumEl;
+            XCdrr=tempPtr;
+            tempPtr+=C.numClust;
+            XSdrr=tempPtr;
+            tempPtr+=C.numClust;
+            XCdrTheta=tempPtr;
+            tempPtr+=C.numClust;
+            XSdrTheta=tempPtr;
+            tempPtr+=C.numClust;
+            nCoeffDrr=tempPtr;
+        } else {
+            nCoeffDrr=NULL;
         }
     }
         
@@ -113,25 +551,48 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
     
     rPrev=std::numeric_limits<double>::infinity();
     thetaPrev=std::numeric_limits<double>::infinity();
-    for(curPoint=0;curPoint<numPoints;curPoint++) {
+    NPrev=M;
+    funcDeg=M;
+    helmDeg=M;
+    for(curPoint=startPoint;curPoint<endPoint;curPoint++) {
         double thetaCur;
         bool rChanged;
         bool thetaChanged;
+        bool degChanged;
         
         r=point[0+3*curPoint];
         lambda=point[1+3*curPoint];
         thetaCur=point[2+3*curPoint];
+        N=(maxDegs==NULL)?M:maxDegs[curPoint];
         
         rChanged=rPrev!=r;
         thetaChanged=thetaCur!=thetaPrev;
+        degChanged=N!=NPrev;
         rPrev=r;
         thetaPrev=thetaCur;
+        NPrev=N;
         
         if(rChanged) {
             temp=a/r;
             for(n=1;n<=M;n++) {
                 nCoeff[n]=nCoeff[n-1]*temp;
             }
+
+            if(gradV!=NULL) {
+                nf=1.0;
+                for(n=0;n<=M;n++) {
+                    nCoeffDr[n]=nf*nCoeff[n];
+                    nf++;
+                }
+            }
+
+            if(HessV!=NULL) {
+                nf=1.0;
+                for(n=0;n<=M;n++) {
+                    nCoeffDrr[n]=nf*(nf+1)*nCoeff[n];
+                    nf++;
+                }
+            }
         }
 
         if(fabs(thetaCur)<88*pi/180||gradV==NULL) {
@@ -150,7 +611,7 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
             SinVec[2]=2*SinVec[1]*CosVec[1];
             CosVec[2]=1-2*SinVec[1]*SinVec[1];
             //Use a two-part recursion for the rest of the terms.
-            for(m=3;m<=M;m++){
+            for(m=3;m<=N;m++){
                 SinVec[m]=2*CosVec[1]*SinVec[m-1]-SinVec[m-2];
                 CosVec[m]=2*CosVec[1]*CosVec[m-1]-CosVec[m-2];
             }
@@ -161,34 +622,34 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
         //(colatitude). Thus, the point must be transformed.
             theta=pi/2-thetaCur;
             u=sin(theta);
-            if(thetaChanged) {
+            //The ratios up to a given degree do not depend on the maximum
+            //degree, so they only have to be recomputed if the latitude
+            //changes or a higher degree is needed.
+            if(thetaChanged||N>funcDeg) {
                 //Get the associated Legendre function ratios.
-                NALegendreCosRatCPP(FuncVals,  theta, scalFactor);
+                NALegendreCosRatOrderMajorCPP(PO,layout,N,theta,scalFactor);
 
                 //Get the derivatives of the ratios if the gradient is desired.
                 if(gradV!=NULL) {
-                    NALegendreCosRatDerivCPP(FuncDerivs,FuncVals,theta);
+                    NALegendreCosRatDerivOrderMajorCPP(dPO,PO,layout,N,theta);
                 }
+                funcDeg=N;
             }
             
-            //Evaluate Equation 7 from the Holmes and Featherstone paper.
-            if(rChanged||thetaChanged) {
-                //Zero the arrays.
-                memset(XC,0,sizeof(double)*C.numClust);
-                memset(XS,0,sizeof(double)*C.numClust);
-
-                //Compute the X coefficients for the sum
-                for(m=0;m<=M;m++) {
-                    for(n=m;n<=M;n++) {
-                        XC[m]+=nCoeff[n]*C[n][m]*FuncVals[n][m];
-                        XS[m]+=nCoeff[n]*S[n][m]*FuncVals[n][m];
-                    }
+            //Evaluate Equation 7 from the Holmes and Featherstone paper
+            //for the potential and, if desired, for the partial
+            //derivatives.
+            if(rChanged||thetaChanged||degChanged) {
+                spherHarmonicLumpedCoeffsCPP(XC,XS,XCdr,XSdr,XCdTheta,XSdTheta,layout,N,CO,SO,nCoeff,nCoeffDr,PO,dPO);
+
+                if(HessV!=NULL) {
+                    spherHarmonicLumpedCoeffs2CPP(XCdrr,XSdrr,XCdrTheta,XSdrTheta,layout,N,CO,SO,nCoeffDrr,nCoeffDr,PO,dPO);
                 }
             }
             
             //Use Horner's method to compute V.
             V[curPoint]=0;
-            m=M+1;
+            m=N+1;
             do {
                 m--;
                 
@@ -206,35 +667,8 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
                 double dVdLambda=0;
                 double dVdTheta=0;
                 
-                if(rChanged||thetaChanged) {
-                    memset(XCdr,0,sizeof(double)*C.numClust);
-                    memset(XSdr,0,sizeof(double)*C.numClust);
-                    memset(XCdTheta,0,sizeof(double)*C.numClust);
-                    memset(XSdTheta,0,sizeof(double)*C.numClust);
-
-                    //Evaluate Equation 7 from the Holmes and Featherstone paper.
-                    mf=0;
-                    for(m=0;m<=M;m++) {
-                        nf=mf;
-                        for(n=m;n<=M;n++) {
-                            double CScal=nCoeff[n]*C[n][m];
-                            double SScal=nCoeff[n]*S[n][m];
-
-                            XCdr[m]+=(nf+1)*CScal*FuncVals[n][m];
-                            XSdr[m]+=(nf+1)*SScal*FuncVals[n][m];
-
-                            XCdTheta[m]+=CScal*FuncDerivs[n][m];
-                            XSdTheta[m]+=SScal*FuncDerivs[n][m];
-                            
-                            nf++;
-                        }
-                                    
-                        mf++;
-                    }
-                 }
-                
                 //Use Horner's method to compute the partials.
-                m=M+1;
+                m=N+1;
                 mf=(double)m;
                 do {
                     m--;
@@ -259,6 +693,98 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
                 gradV[0+3*curPoint]=dVdr*J[0]+dVdLambda*J[1]+dVdTheta*J[2];
                 gradV[1+3*curPoint]=dVdr*J[3]+dVdLambda*J[4]+dVdTheta*J[5];
                 gradV[2+3*curPoint]=dVdr*J[6]+dVdLambda*J[7]+dVdTheta*J[8];
+
+                //Compute the Hessian, if it is desired.
+                if(HessV!=NULL) {
+                    const double tCur=cos(theta);
+                    const double cScal=c/(r*scalFactor);
+                    double sumR=0;
+                    double sumTheta=0;
+                    double sumRR=0;
+                    double sumRLambda=0;
+                    double sumRTheta=0;
+                    double sumLambdaLambda=0;
+                    double sumLambdaTheta=0;
+                    double dVSpher[3], d2VSpher[6];
+
+                    //Use Horner's method to compute the second partials.
+                    m=N+1;
+                    mf=(double)m;
+                    do {
+                        m--;
+                        mf--;
+
+                        sumR=sumR*u+XCdr[m]*CosVec[m]+XSdr[m]*SinVec[m];
+                        sumTheta=sumTheta*u+XCdTheta[m]*CosVec[m]+XSdTheta[m]*SinVec[m];
+                        sumRR=sumRR*u+XCdrr[m]*CosVec[m]+XSdrr[m]*SinVec[m];
+                        sumRLambda=sumRLambda*u+mf*(-XCdr[m]*SinVec[m]+XSdr[m]*CosVec[m]);
+                        sumRTheta=sumRTheta*u+XCdrTheta[m]*CosVec[m]+XSdrTheta[m]*SinVec[m];
+                        sumLambdaLambda=sumLambdaLambda*u-mf*mf*(XC[m]*CosVec[m]+XS[m]*SinVec[m]);
+                        sumLambdaTheta=sumLambdaTheta*u+mf*(-XCdTheta[m]*SinVec[m]+XSdTheta[m]*CosVec[m]);
+                    } while(m>0);
+
+                    dVSpher[0]=dVdr;
+                    dVSpher[1]=dVdLambda;
+                    dVSpher[2]=dVdTheta;
+                    //The second derivatives are with respect to
+                    //[r,lambda,latitude]. Derivatives with respect to
+                    //colatitude change sign once for each derivative with
+                    //respect to the latitude.
+                    d2VSpher[0]=(cScal/(r*r))*sumRR;
+                    d2VSpher[1]=-(cScal/r)*sumRLambda;
+                    d2VSpher[2]=(cScal/r)*sumRTheta;
+                    d2VSpher[3]=cScal*sumLambdaLambda;
+                    d2VSpher[4]=-cScal*sumLambdaTheta;
+                    /*The second derivative of the Legendre function ratios
+                     *with respect to the colatitude is
+                     *(m^2/u^2-n*(n+1))*P-(t/u)*dP, from the differential
+                     *equation of the associated Legendre functions (the
+                     *first equation in the second Holmes and Featherstone
+                     *paper). Since n*(n+1)=(n+1)*(n+2)-2*(n+1), the sum is
+                     *formed from the other lumped coefficients.*/
+                    d2VSpher[5]=cScal*(-sumLambdaLambda/(u*u)-(tCur/u)*sumTheta-sumRR+2*sumR);
+
+                    spherHessian2CartCPP(HessV+9*curPoint,point+3*curPoint,dVSpher,d2VSpher);
+                }
+            }
+
+            //Compute the covariance, if it is desired.
+            if(sigma2!=NULL) {
+                double CartPoint[3], sCov, tCov, uCov;
+
+                //The Helmholtz polynomials are the Legendre function
+                //ratios, which are only stored in a different order.
+                if(thetaChanged||N!=helmDeg) {
+                    FuncVals.numClust=N+1;
+                    FuncVals.totalNumEl=(N+1)*(N+2)/2;
+                    for(n=0;n<=N;n++) {
+                        for(m=0;m<=n;m++) {
+                            FuncVals[n][m]=PO[layout.idx(n,m)];
+                        }
+                    }
+
+                    if(Sigma!=NULL) {
+                        FuncDerivs.numClust=FuncVals.numClust;
+                        FuncDerivs.totalNumEl=FuncVals.totalNumEl;
+                        normHelmHoltzDerivCPP(FuncDerivs,FuncVals);
+                    }
+                    helmDeg=N;
+                }
+
+                //The direction cosines and the rm and im terms, as in
+                //spherHarmonicCovCPP.
+                spher2CartCPP(CartPoint,point+3*curPoint,0);
+                sCov=CartPoint[0]/r;
+                tCov=CartPoint[1]/r;
+                uCov=CartPoint[2]/r;
+                covRm[0]=1;
+                covIm[0]=0;
+                for(m=1;m<=N;m++) {
+                    covRm[m]=sCov*covRm[m-1]-tCov*covIm[m-1];
+                    covIm[m]=sCov*covIm[m-1]+tCov*covRm[m-1];
+                }
+
+                spherHarmonicCovPointCPP(sigma2+curPoint,(Sigma==NULL)?NULL:Sigma+9*curPoint,*CStdDev,*SStdDev,FuncVals,FuncDerivs,nCoeff,covRm,covIm,N,r,sCov,tCov,uCov,c,scalFactor);
             }
         } else {  
         //At latitudes that are near the poles, the non-singular algorithm of
@@ -279,16 +805,24 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
             t=CartPoint[1]/r;
             u=CartPoint[2]/r;
 
-            //Compute the fully normalized Helmholtz polynomials.
-            if(thetaChanged) {
+            //Compute the fully normalized Helmholtz polynomials. The
+            //ClusterSets only hold the degrees up to N, because the
+            //derivatives are computed for all of the degrees present.
+            if(thetaChanged||N!=funcDeg) {
+                FuncVals.numClust=N+1;
+                FuncVals.totalNumEl=(N+1)*(N+2)/2;
+                FuncDerivs.numClust=FuncVals.numClust;
+                FuncDerivs.totalNumEl=FuncVals.totalNumEl;
+                FuncDerivs2.numClust=FuncVals.numClust;
+                FuncDerivs2.totalNumEl=FuncVals.totalNumEl;
                 normHelmHoltzCPP(FuncVals,u, scalFactor);
-                thetaPrev=thetaCur;
+                funcDeg=N;
             }
             
             //Recursively compute the rm and im terms for the sums.
             rm[0]=1;
             im[0]=0;
-            for(m=1;m<=M;m++) {
+            for(m=1;m<=N;m++) {
                 //These are equation 49 in the Fantino and Casotto paper.
                 rm[m]=s*rm[m-1]-t*im[m-1];
                 im[m]=s*im[m-1]+t*rm[m-1];
@@ -297,7 +831,7 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
             //Perform the sum for the potential from Equation 44 in the
             //Fantino and Casotto paper.
             V[curPoint]=0;
-            for(n=0;n<=M;n++) {
+            for(n=0;n<=N;n++) {
                 double innerTerm=0;
                 for(m=0;m<=n;m++) {
                     innerTerm+=(C[n][m]*rm[m]+S[n][m]*im[m])*FuncVals[n][m];
@@ -318,7 +852,7 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
 
                 //The equations in these loops are from Table 10.
                 nf=0.0;
-                for(n=0;n<=M;n++) {
+                for(n=0;n<=N;n++) {
                     double a1Loop=0;
                     double a2Loop=0;
                     double a3Loop;
@@ -372,11 +906,205 @@ void spherHarmonicEvalCPP(double *V, double *gradV, const ClusterSetCPP<double>
                     gradV[1+3*curPoint]=temp*(a2+t*a4)/scalFactor;
                     gradV[2+3*curPoint]=temp*(a3+u*a4)/scalFactor;
                 }
+
+                /*Compute the Hessian, if it is desired. Pines' algorithm
+                 *expresses the potential as a sum over n of
+                 *(c/r)*(a/r)^n*G_n(s,t,u), where G_n is a function of the
+                 *direction cosines. Applying the chain rule twice with
+                 *ds_i/dx_j=(delta_ij-s_i*s_j)/r and dr/dx_i=s_i gives the
+                 *Hessian as (c/r^3) times the sum over n of (a/r)^n times
+                 *Hm-I*L-(n+2)*(e*g'+g*e')-(e*(Hm*e)'+(Hm*e)*e')+e*e'*Q
+                 *where e=[s;t;u], g and Hm are the gradient and Hessian
+                 *of G_n with respect to e, L=(n+1)*G_n+e'*g (as in Table
+                 *14 of the Fantino and Casotto paper) and
+                 *Q=(n+3)*L+(n+2)*e'*g+e'*Hm*e.*/
+                if(HessV!=NULL) {
+                    const double e[3]={s,t,u};
+                    double sumHm[3][3]={{0,0,0},{0,0,0},{0,0,0}};
+                    double sumG2[3]={0,0,0};
+                    double sumL=0;
+                    double sumQ=0;
+                    double He[3];
+                    double *HessCur=HessV+9*curPoint;
+                    size_t i,j;
+
+                    normHelmHoltzDeriv2CPP(FuncDerivs2,FuncVals);
+
+                    nf=0.0;
+                    for(n=0;n<=N;n++) {
+                        double G=0;
+                        double g[3]={0,0,0};
+                        double Hm[3][3];
+                        double Gss=0;
+                        double Gst=0;
+                        double Gsu=0;
+                        double Gtu=0;
+                        double Guu=0;
+                        double eg, eHme, L;
+
+                        mf=0.0;
+                        for(m=0;m<=n;m++) {
+                            const double HVal=FuncVals[n][m];
+                            const double dHVal=FuncDerivs[n][m];
+                            const double CProdMN=C[n][m]*rm[m]+S[n][m]*im[m];
+
+                            G+=CProdMN*HVal;
+                            g[2]+=CProdMN*dHVal;
+                            Guu+=CProdMN*FuncDerivs2[n][m];
+                            if(m>=1) {
+                                const double CProdS=mf*(C[n][m]*rm[m-1]+S[n][m]*im[m-1]);
+                                const double CProdT=mf*(S[n][m]*rm[m-1]-C[n][m]*im[m-1]);
+
+                                g[0]+=CProdS*HVal;
+                                g[1]+=CProdT*HVal;
+                                Gsu+=CProdS*dHVal;
+                                Gtu+=CProdT*dHVal;
+                            }
+                            if(m>=2) {
+                                const double mm1=mf*(mf-1);
+
+                                Gss+=mm1*(C[n][m]*rm[m-2]+S[n][m]*im[m-2])*HVal;
+                                Gst+=mm1*(S[n][m]*rm[m-2]-C[n][m]*im[m-2])*HVal;
+                            }
+                            mf++;
+                        }
+
+                        //(s+1i*t)^m is harmonic in s and t, so G_tt=-G_ss.
+                        Hm[0][0]=Gss;
+                        Hm[0][1]=Gst;
+                        Hm[0][2]=Gsu;
+                        Hm[1][0]=Gst;
+                        Hm[1][1]=-Gss;
+                        Hm[1][2]=Gtu;
+                        Hm[2][0]=Gsu;
+                        Hm[2][1]=Gtu;
+                        Hm[2][2]=Guu;
+
+                        eg=e[0]*g[0]+e[1]*g[1]+e[2]*g[2];
+                        eHme=0;
+                        for(i=0;i<3;i++) {
+                            for(j=0;j<3;j++) {
+                                eHme+=e[i]*Hm[i][j]*e[j];
+                                sumHm[i][j]+=nCoeff[n]*Hm[i][j];
+                            }
+                            sumG2[i]+=nCoeff[n]*(nf+2)*g[i];
+                        }
+                        L=(nf+1)*G+eg;
+                        sumL+=nCoeff[n]*L;
+                        sumQ+=nCoeff[n]*((nf+3)*L+(nf+2)*eg+eHme);
+
+                        nf++;
+                    }
+
+                    for(i=0;i<3;i++) {
+                        He[i]=sumHm[i][0]*e[0]+sumHm[i][1]*e[1]+sumHm[i][2]*e[2];
+                    }
+
+                    temp=c/(r*r*r*scalFactor);
+                    for(j=0;j<3;j++) {
+                        for(i=0;i<3;i++) {
+                            double val=sumHm[i][j]-e[i]*sumG2[j]-e[j]*sumG2[i]-e[i]*He[j]-e[j]*He[i]+e[i]*e[j]*sumQ;
+
+                            if(i==j) {
+                                val-=sumL;
+                            }
+                            HessCur[i+3*j]=temp*val;
+                        }
+                    }
+                }
+            }
+
+            //Compute the covariance, if it is desired. The Helmholtz
+            //polynomials and their derivatives were computed above.
+            if(sigma2!=NULL) {
+                spherHarmonicCovPointCPP(sigma2+curPoint,(Sigma==NULL)?NULL:Sigma+9*curPoint,*CStdDev,*SStdDev,FuncVals,FuncDerivs,nCoeff,rm,im,N,r,s,t,u,c,scalFactor);
             }
         }
     }
-    
-    delete[] buffer;
+}
+
+void spherHessian2CartCPP(double *HessCart, const double *pointSpher, const double *dVSpher, const double *d2VSpher) {
+/*SPHERHESSIAN2CARTCPP Convert the first and second partial derivatives of
+ *                  a function with respect to the spherical coordinates
+ *                  [r;azimuth;elevation] at pointSpher into the 3X3
+ *                  Hessian matrix with respect to Cartesian coordinates,
+ *                  stored by column. d2VSpher holds the second
+ *                  derivatives in the order rr, r azimuth, r elevation,
+ *                  azimuth azimuth, azimuth elevation, elevation
+ *                  elevation.
+ */
+    double J[9], HSpher[9], CartPoint[3], d2r[9], d2Lambda[9], d2Phi[9];
+    double x, y, z, r, r2, r4, rho2, rho, rho4;
+    size_t i, j, k, l;
+
+    spher2CartCPP(CartPoint,pointSpher,0);
+    calcSpherJacobCPP(J,pointSpher,0);
+    x=CartPoint[0];
+    y=CartPoint[1];
+    z=CartPoint[2];
+    r=pointSpher[0];
+    r2=r*r;
+    r4=r2*r2;
+    rho2=x*x+y*y;
+    rho=sqrt(rho2);
+    rho4=rho2*rho2;
+
+    //The symmetric matrix of second partials in spherical coordinates.
+    HSpher[0]=d2VSpher[0];
+    HSpher[1]=d2VSpher[1];
+    HSpher[2]=d2VSpher[2];
+    HSpher[3]=d2VSpher[1];
+    HSpher[4]=d2VSpher[3];
+    HSpher[5]=d2VSpher[4];
+    HSpher[6]=d2VSpher[2];
+    HSpher[7]=d2VSpher[4];
+    HSpher[8]=d2VSpher[5];
+
+    //The Hessian of r.
+    for(i=0;i<3;i++) {
+        for(j=0;j<3;j++) {
+            d2r[i+3*j]=-CartPoint[i]*CartPoint[j]/(r2*r);
+        }
+        d2r[i+3*i]+=1/r;
+    }
+
+    //The Hessian of the azimuth, atan2(y,x).
+    d2Lambda[0]=2*x*y/rho4;
+    d2Lambda[1]=(y*y-x*x)/rho4;
+    d2Lambda[2]=0;
+    d2Lambda[3]=d2Lambda[1];
+    d2Lambda[4]=-d2Lambda[0];
+    d2Lambda[5]=0;
+    d2Lambda[6]=0;
+    d2Lambda[7]=0;
+    d2Lambda[8]=0;
+
+    //The Hessian of the elevation, atan2(z,rho).
+    d2Phi[0]=-z*(r2*rho2-2*x*x*rho2-r2*x*x)/(r4*rho2*rho);
+    d2Phi[1]=x*y*z*(2*rho2+r2)/(r4*rho2*rho);
+    d2Phi[2]=-x*(r2-2*z*z)/(r4*rho);
+    d2Phi[3]=d2Phi[1];
+    d2Phi[4]=-z*(r2*rho2-2*y*y*rho2-r2*y*y)/(r4*rho2*rho);
+    d2Phi[5]=-y*(r2-2*z*z)/(r4*rho);
+    d2Phi[6]=d2Phi[2];
+    d2Phi[7]=d2Phi[5];
+    d2Phi[8]=-2*z*rho/r4;
+
+    //HessCart=J'*HSpher*J+sum_k dVSpher[k]*(Hessian of coordinate k),
+    //where J[k+3*i] is the derivative of spherical coordinate k with
+    //respect to Cartesian coordinate i.
+    for(j=0;j<3;j++) {
+        for(i=0;i<3;i++) {
+            double val=dVSpher[0]*d2r[i+3*j]+dVSpher[1]*d2Lambda[i+3*j]+dVSpher[2]*d2Phi[i+3*j];
+
+            for(k=0;k<3;k++) {
+                for(l=0;l<3;l++) {
+                    val+=J[k+3*i]*HSpher[k+3*l]*J[l+3*j];
+                }
+            }
+            HessCart[i+3*j]=val;
+        }
+    }
 }
 
 /*LICENSE:
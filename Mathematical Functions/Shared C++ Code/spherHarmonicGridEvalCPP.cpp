@@ -0,0 +1,464 @@
+/*SPHERHARMONICGRIDEVALCPP A C++ implementation of a function to determine
+ *                     a potential and/ or the gradient of the potential
+ *                     from spherical harmonic coefficients on a grid of
+ *                     points that is regularly spaced in longitude.
+ *
+ *This function is a C++ implementation of the main routine of the function
+ *spherHarmonicGridEval in Matlab, which is called through the mex function
+ *spherHarmonicGridEvalCPPInt. The grid consists of rows, each with a given
+ *range and latitude, and numLon longitudes per row, lambda0+2*pi*k/numLon
+ *for k=0 to numLon-1. In the algorithm of Holmes and Featherstone used in
+ *spherHarmonicEvalCPP, the lumped coefficients XC and XS only depend on the
+ *range and the latitude, and the remaining sum over the order m for each
+ *longitude is a Fourier series. Thus, after computing XC and XS once per
+ *row, all of the longitudes in the row are obtained using a single fast
+ *Fourier transform (FFT) of length numLon, rather than a length-M sum per
+ *longitude. Orders m>=numLon are aliased onto m mod numLon, which is
+ *exact, since the longitudes are evenly spaced around the full circle.
+ *
+ *The FFT is a radix-2 FFT when numLon is a power of two and uses
+ *Bluestein's algorithm with a radix-2 FFT for other lengths.
+ *
+ *When the gradient is requested, rows within 2 degrees of the poles are
+ *evaluated using spherHarmonicEvalCPP, which switches to the algorithm of
+ *Pines there, because of the singularity of the spherical coordinate
+ *system.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "mathFuncs.hpp"
+#include "CoordFuncs.hpp"
+
+//For the sin, cos, frexp and ldexp.
+#include <math.h>
+#include <complex>
+#include <vector>
+//For splitting the rows between threads.
+#include "parallelForCPP.hpp"
+//For the vectorized Legendre recursion and sums.
+#include "spherHarmonicKernelsCPP.hpp"
+
+using namespace std;
+
+/*The FFTPlanCPP class holds the precomputed values for computing
+ *y[j]=sum_{k=0}^{N-1} x[k]*exp(2*pi*1i*j*k/N)
+ *for j=0 to N-1 for a fixed length N. When N is not a power of two,
+ *Bluestein's algorithm is used to express the transform as a cyclic
+ *convolution of power-of-two length L>=2*N-1. The plan is read-only after
+ *construction, so it can be shared between threads.*/
+class FFTPlanCPP {
+public:
+    size_t N;
+    //The power-of-two length used for the radix-2 transforms.
+    size_t L;
+    bool useBluestein;
+    //twiddle[k]=exp(2*pi*1i*k/L) for k=0 to L/2-1.
+    vector<complex<double> > twiddle;
+    //chirp[k]=exp(pi*1i*k^2/N) for k=0 to N-1. Only used with Bluestein.
+    vector<complex<double> > chirp;
+    //The transform of the conjugate chirp filter divided by L.
+    vector<complex<double> > filterFFT;
+
+    FFTPlanCPP(const size_t numPoints);
+    void transform(complex<double> *x, complex<double> *work) const;
+};
+
+/*The SpherGridWorkspace class holds the scratch space for evaluating one
+ *row of the grid. Each thread has its own.*/
+class SpherGridWorkspace {
+public:
+    //The Legendre function ratios and their derivatives in the
+    //order-major layout.
+    vector<double> PO;
+    vector<double> dPO;
+    vector<double> nCoeff;
+    vector<double> nCoeffDr;
+    vector<double> XC, XS, XCdr, XSdr, XCdTheta, XSdTheta;
+    //The Fourier coefficients of V, dVdr, dVdLambda and dVdTheta.
+    vector<complex<double> > coeffs;
+    vector<complex<double> > work;
+    //For the rows near the poles when the gradient is desired.
+    vector<double> rowPoints;
+};
+
+//Prototypes for functions used in this file that are not present in
+//the header mathFuncs.hpp.
+void fftRadix2CPP(complex<double> *x, const size_t L, const complex<double> *twiddle, const bool conjTwiddle);
+void initSpherGridWorkspace(SpherGridWorkspace &ws, const SpherHarmonicLayoutCPP &layout, const size_t numLon, const size_t L, const bool wantGrad);
+void spherHarmonicGridRowCPP(double *VRow, double *gradVRow, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S, const SpherHarmonicLayoutCPP &layout, const double *CO, const double *SO, const double r, const double lat, const double lambda0, const double a, const double c, const double scalFactor, const FFTPlanCPP &plan, SpherGridWorkspace &ws);
+
+/*The SpherHarmonicGridChunk class is used with parallelForCPP to evaluate
+ *contiguous chunks of rows of the grid in separate threads.*/
+class SpherHarmonicGridChunk {
+public:
+    double *V;
+    double *gradV;
+    const ClusterSetCPP<double> *C;
+    const ClusterSetCPP<double> *S;
+    const SpherHarmonicLayoutCPP *layout;
+    //The coefficients in the order-major layout.
+    const double *CO;
+    const double *SO;
+    const double *rLat;
+    double lambda0;
+    size_t numLon;
+    double a;
+    double c;
+    double scalFactor;
+    const FFTPlanCPP *plan;
+
+    void operator()(const size_t threadIdx,const size_t startRow,const size_t endRow) {
+        SpherGridWorkspace ws;
+        size_t curRow;
+        (void)threadIdx;
+
+        initSpherGridWorkspace(ws,*layout,numLon,plan->L,gradV!=NULL);
+        for(curRow=startRow;curRow<endRow;curRow++) {
+            double *gradVRow=(gradV==NULL)?NULL:gradV+3*numLon*curRow;
+
+            spherHarmonicGridRowCPP(V+numLon*curRow,gradVRow,*C,*S,*layout,CO,SO,rLat[2*curRow],rLat[2*curRow+1],lambda0,a,c,scalFactor,*plan,ws);
+        }
+    }
+};
+
+void spherHarmonicGridEvalCPP(double *V, double *gradV, const ClusterSetCPP<double> &C,const ClusterSetCPP<double> &S, const double *rLat, const size_t numRows, const double lambda0, const size_t numLon, const double a, const double c, const double scalFactor, const size_t numThreads) {
+    //If a NULL pointer is passed for gradV, then it is assumed that the
+    //gradient is not desired. Otherwise, a pointer to a buffer for
+    //3*numLon*numRows doubles should be passed.
+    const FFTPlanCPP plan(numLon);
+    const shared_ptr<const SpherHarmonicLayoutCPP> layout=getSpherHarmonicLayoutCPP(C.numClust-1);
+    vector<double> CO(layout->totalSize);
+    vector<double> SO(layout->totalSize);
+    SpherHarmonicGridChunk evaluator;
+
+    orderMajorFromClusterSetCPP(CO.data(),C,*layout);
+    orderMajorFromClusterSetCPP(SO.data(),S,*layout);
+
+    evaluator.V=V;
+    evaluator.gradV=gradV;
+    evaluator.C=&C;
+    evaluator.S=&S;
+    evaluator.layout=layout.get();
+    evaluator.CO=CO.data();
+    evaluator.SO=SO.data();
+    evaluator.rLat=rLat;
+    evaluator.lambda0=lambda0;
+    evaluator.numLon=numLon;
+    evaluator.a=a;
+    evaluator.c=c;
+    evaluator.scalFactor=scalFactor;
+    evaluator.plan=&plan;
+
+    parallelForCPP(numRows,numThreads2UseCPP(numThreads,numRows),evaluator);
+}
+
+FFTPlanCPP::FFTPlanCPP(const size_t numPoints) {
+    const double pi=2*acos(0.0);
+    size_t k;
+
+    N=numPoints;
+    useBluestein=(N&(N-1))!=0;
+
+    L=1;
+    if(useBluestein) {
+        while(L<2*N-1) {
+            L*=2;
+        }
+    } else {
+        L=N;
+    }
+
+    twiddle.resize(L/2+1);
+    for(k=0;k<L/2;k++) {
+        const double theta=2*pi*static_cast<double>(k)/static_cast<double>(L);
+        twiddle[k]=complex<double>(cos(theta),sin(theta));
+    }
+
+    if(useBluestein) {
+        chirp.resize(N);
+        for(k=0;k<N;k++) {
+            //Reducing k^2 modulo 2N keeps the argument small for accuracy.
+            const double theta=pi*static_cast<double>((k*k)%(2*N))/static_cast<double>(N);
+            chirp[k]=complex<double>(cos(theta),sin(theta));
+        }
+
+        filterFFT.assign(L,complex<double>(0,0));
+        filterFFT[0]=conj(chirp[0]);
+        for(k=1;k<N;k++) {
+            filterFFT[k]=conj(chirp[k]);
+            filterFFT[L-k]=conj(chirp[k]);
+        }
+        fftRadix2CPP(&filterFFT[0],L,&twiddle[0],false);
+        for(k=0;k<L;k++) {
+            filterFFT[k]/=static_cast<double>(L);
+        }
+    }
+}
+
+void FFTPlanCPP::transform(complex<double> *x, complex<double> *work) const {
+/*TRANSFORM Compute the transform of the N values in x in place. If
+ *          useBluestein is true, then work must have space for L
+ *          elements.
+ */
+    size_t k;
+
+    if(!useBluestein) {
+        fftRadix2CPP(x,L,&twiddle[0],false);
+        return;
+    }
+
+    //y[j]=chirp[j]*sum_k (x[k]*chirp[k])*conj(chirp[j-k])
+    for(k=0;k<N;k++) {
+        work[k]=x[k]*chirp[k];
+    }
+    for(k=N;k<L;k++) {
+        work[k]=0;
+    }
+
+    //The cyclic convolution.
+    fftRadix2CPP(work,L,&twiddle[0],false);
+    for(k=0;k<L;k++) {
+        work[k]*=filterFFT[k];
+    }
+    fftRadix2CPP(work,L,&twiddle[0],true);
+
+    for(k=0;k<N;k++) {
+        x[k]=work[k]*chirp[k];
+    }
+}
+
+void fftRadix2CPP(complex<double> *x, const size_t L, const complex<double> *twiddle, const bool conjTwiddle) {
+/*FFTRADIX2CPP An in-place iterative decimation-in-time radix-2 FFT of
+ *             length L, which must be a power of two. If conjTwiddle is
+ *             false, the exponent of the transform is positive. Otherwise
+ *             it is negative. No scaling is performed.
+ */
+    size_t i, j, bit, len, k;
+
+    //Sort the elements in bit-reversed order.
+    j=0;
+    for(i=1;i<L;i++) {
+        bit=L>>1;
+        while(j&bit) {
+            j^=bit;
+            bit>>=1;
+        }
+        j^=bit;
+        if(i<j) {
+            swap(x[i],x[j]);
+        }
+    }
+
+    for(len=2;len<=L;len*=2) {
+        const size_t halfLen=len/2;
+        const size_t step=L/len;
+
+        for(i=0;i<L;i+=len) {
+            for(k=0;k<halfLen;k++) {
+                const complex<double> w=conjTwiddle?conj(twiddle[k*step]):twiddle[k*step];
+                const complex<double> t=x[i+k+halfLen]*w;
+
+                x[i+k+halfLen]=x[i+k]-t;
+                x[i+k]+=t;
+            }
+        }
+    }
+}
+
+void initSpherGridWorkspace(SpherGridWorkspace &ws, const SpherHarmonicLayoutCPP &layout, const size_t numLon, const size_t L, const bool wantGrad) {
+    const size_t numClust=layout.M+1;
+
+    //The pad elements must be zero.
+    ws.PO.assign(layout.totalSize,0.0);
+    ws.nCoeff.resize(numClust);
+    ws.XC.resize(numClust);
+    ws.XS.resize(numClust);
+    if(wantGrad) {
+        ws.dPO.assign(layout.totalSize,0.0);
+        ws.nCoeffDr.resize(numClust);
+        ws.XCdr.resize(numClust);
+        ws.XSdr.resize(numClust);
+        ws.XCdTheta.resize(numClust);
+        ws.XSdTheta.resize(numClust);
+        ws.coeffs.resize(4*numLon);
+        ws.rowPoints.resize(3*numLon);
+    } else {
+        ws.coeffs.resize(numLon);
+    }
+    ws.work.resize(L);
+}
+
+void spherHarmonicGridRowCPP(double *VRow, double *gradVRow, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S, const SpherHarmonicLayoutCPP &layout, const double *CO, const double *SO, const double r, const double lat, const double lambda0, const double a, const double c, const double scalFactor, const FFTPlanCPP &plan, SpherGridWorkspace &ws) {
+/*SPHERHARMONICGRIDROWCPP Evaluate the potential and possibly the gradient
+ *                  at all of the longitudes of a single row of the grid.
+ */
+    const double pi=2*acos(0.0);
+    const size_t M=C.numClust-1;
+    const size_t numLon=plan.N;
+    const size_t numSeries=(gradVRow==NULL)?1:4;
+    complex<double> *coeffs=&ws.coeffs[0];
+    double theta, u, temp, nf, mf, uPowMant, CosLambda0, SinLambda0;
+    double CosPrev, SinPrev, CosCur, SinCur;
+    int uPowExp;
+    size_t n, m, k, curSeries;
+
+    if(gradVRow!=NULL&&fabs(lat)>=88*pi/180) {
+    //Near the poles, the gradient must be computed with the algorithm of
+    //Pines, which does not separate in longitude.
+        double *point=&ws.rowPoints[0];
+
+        for(k=0;k<numLon;k++) {
+            point[3*k]=r;
+            point[3*k+1]=lambda0+2*pi*static_cast<double>(k)/static_cast<double>(numLon);
+            point[3*k+2]=lat;
+        }
+        spherHarmonicEvalCPP(VRow,gradVRow,NULL,C,S,point,numLon,a,c,scalFactor,1);
+        return;
+    }
+
+    ws.nCoeff[0]=1;
+    temp=a/r;
+    for(n=1;n<=M;n++) {
+        ws.nCoeff[n]=ws.nCoeff[n-1]*temp;
+    }
+
+    //The colatitude is used in the Holmes and Featherstone algorithm.
+    theta=pi/2-lat;
+    u=sin(theta);
+    NALegendreCosRatOrderMajorCPP(&ws.PO[0],layout,layout.M,theta,scalFactor);
+
+    //Evaluate Equation 7 from the Holmes and Featherstone paper.
+    if(gradVRow==NULL) {
+        spherHarmonicLumpedCoeffsCPP(&ws.XC[0],&ws.XS[0],NULL,NULL,NULL,NULL,layout,layout.M,CO,SO,&ws.nCoeff[0],NULL,&ws.PO[0],NULL);
+    } else {
+        NALegendreCosRatDerivOrderMajorCPP(&ws.dPO[0],&ws.PO[0],layout,layout.M,theta);
+
+        nf=1.0;
+        for(n=0;n<=M;n++) {
+            ws.nCoeffDr[n]=nf*ws.nCoeff[n];
+            nf++;
+        }
+        spherHarmonicLumpedCoeffsCPP(&ws.XC[0],&ws.XS[0],&ws.XCdr[0],&ws.XSdr[0],&ws.XCdTheta[0],&ws.XSdTheta[0],layout,layout.M,CO,SO,&ws.nCoeff[0],&ws.nCoeffDr[0],&ws.PO[0],&ws.dPO[0]);
+    }
+
+    /*Form the Fourier coefficients. A term a*cos(m*lambda)+b*sin(m*lambda)
+     *with lambda=lambda0+2*pi*k/numLon is the real part of
+     *(a-1i*b)*exp(1i*m*lambda0)*exp(2*pi*1i*m*k/numLon), and the
+     *coefficient is added to bin m mod numLon. The factor u^m, which is
+     *applied using Horner's method in spherHarmonicEvalCPP, is kept as a
+     *separate mantissa and exponent, because u^m can underflow for high
+     *orders even though u^m*XC[m] does not.*/
+    for(k=0;k<numSeries*numLon;k++) {
+        coeffs[k]=0;
+    }
+
+    CosLambda0=cos(lambda0);
+    SinLambda0=sin(lambda0);
+    CosPrev=1;
+    SinPrev=0;
+    uPowMant=1;
+    uPowExp=0;
+    k=0;
+    for(m=0;m<=M;m++) {
+        double aVals[4], bVals[4];
+        complex<double> phaseFactor;
+
+        if(m==0) {
+            CosCur=1;
+            SinCur=0;
+        } else {
+            //The angle addition formula gives cos(m*lambda0) and
+            //sin(m*lambda0).
+            CosCur=CosPrev*CosLambda0-SinPrev*SinLambda0;
+            SinCur=SinPrev*CosLambda0+CosPrev*SinLambda0;
+            CosPrev=CosCur;
+            SinPrev=SinCur;
+
+            {
+                int uExp;
+                uPowMant*=u;
+                uPowMant=frexp(uPowMant,&uExp);
+                uPowExp+=uExp;
+            }
+        }
+        phaseFactor=complex<double>(CosCur,SinCur);
+
+        mf=static_cast<double>(m);
+        aVals[0]=ws.XC[m];
+        bVals[0]=ws.XS[m];
+        if(gradVRow!=NULL) {
+            aVals[1]=ws.XCdr[m];
+            bVals[1]=ws.XSdr[m];
+            aVals[2]=mf*ws.XS[m];
+            bVals[2]=-mf*ws.XC[m];
+            aVals[3]=ws.XCdTheta[m];
+            bVals[3]=ws.XSdTheta[m];
+        }
+
+        for(curSeries=0;curSeries<numSeries;curSeries++) {
+            double aScal, bScal;
+            int aExp, bExp;
+
+            aScal=frexp(aVals[curSeries],&aExp);
+            bScal=frexp(bVals[curSeries],&bExp);
+            aScal=ldexp(aScal*uPowMant,aExp+uPowExp);
+            bScal=ldexp(bScal*uPowMant,bExp+uPowExp);
+
+            coeffs[curSeries*numLon+k]+=complex<double>(aScal,-bScal)*phaseFactor;
+        }
+
+        k++;
+        if(k==numLon) {
+            k=0;
+        }
+    }
+
+    for(curSeries=0;curSeries<numSeries;curSeries++) {
+        plan.transform(coeffs+curSeries*numLon,&ws.work[0]);
+    }
+
+    temp=(c/r)/scalFactor;
+    for(k=0;k<numLon;k++) {
+        VRow[k]=temp*coeffs[k].real();
+    }
+
+    if(gradVRow!=NULL) {
+        double point[3];
+
+        point[0]=r;
+        point[2]=lat;
+        for(k=0;k<numLon;k++) {
+            double J[9];
+            //The minus sign on dVdTheta is because the input coordinate
+            //is latitude, not colatitude.
+            const double dVdr=-(temp/r)*coeffs[numLon+k].real();
+            const double dVdLambda=temp*coeffs[2*numLon+k].real();
+            const double dVdTheta=-temp*coeffs[3*numLon+k].real();
+
+            point[1]=lambda0+2*pi*static_cast<double>(k)/static_cast<double>(numLon);
+            calcSpherJacobCPP(J,point,0);
+
+            gradVRow[3*k]=dVdr*J[0]+dVdLambda*J[1]+dVdTheta*J[2];
+            gradVRow[3*k+1]=dVdr*J[3]+dVdLambda*J[4]+dVdTheta*J[5];
+            gradVRow[3*k+2]=dVdr*J[6]+dVdLambda*J[7]+dVdTheta*J[8];
+        }
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,521 @@
+/*SPHERHARMONICKERNELSCPP C++ implementations of the order-major Legendre
+ *                    function recursions and lumped coefficient sums used
+ *                    for spherical harmonic synthesis. See
+ *                    spherHarmonicKernelsCPP.hpp for more information.
+ *
+ *The recursions are those of NALegendreCosRatCPP and
+ *NALegendreCosRatDerivCPP (Equations 27, 28 and 30 of the first Holmes
+ *and Featherstone paper), reordered so that the inner loop runs over the
+ *degree for a fixed order. Each value of order m depends only on values
+ *of orders m+1 and m+2 of the same degree, so the inner loops have no
+ *dependencies between iterations and can be vectorized.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For memcpy in ClusterSetCPP.hpp.
+#include <string.h>
+#include "spherHarmonicKernelsCPP.hpp"
+//For sin, cos and sqrt.
+#include <math.h>
+#include <mutex>
+#include <algorithm>
+
+#if (defined(__GNUC__)||defined(__clang__))&&(defined(__x86_64__)||defined(__i386__))
+#define SPHER_HARMONIC_X86_SIMD
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+/*The SpherKernelsCPP structure holds the implementations of the inner
+ *loops that are selected at runtime.*/
+struct SpherKernelsCPP {
+    //out[i]=G[i]*t*p1[i]+H[i]*u2*p2[i]
+    void (*legendreCol)(double *out, const double *G, const double *H, const double *p1, const double *p2, const double t, const double u2, const size_t len);
+    //out[i]=c1*p[i]+E[i]*u*p1[i]
+    void (*legendreDerivCol)(double *out, const double *E, const double *p, const double *p1, const double c1, const double u, const size_t len);
+    //sums[0]=sum w[i]*C[i]*P[i], sums[1]=sum w[i]*S[i]*P[i]
+    void (*dots2)(double *sums, const double *w, const double *C, const double *S, const double *P, const size_t len);
+    /*The same as dots2 for sums[0] and sums[1] plus
+     *sums[2]=sum wDr[i]*C[i]*P[i], sums[3]=sum wDr[i]*S[i]*P[i],
+     *sums[4]=sum w[i]*C[i]*dP[i], sums[5]=sum w[i]*S[i]*dP[i]*/
+    void (*dots6)(double *sums, const double *w, const double *wDr, const double *C, const double *S, const double *P, const double *dP, const size_t len);
+};
+
+//Prototypes for functions used in this file that are not present in
+//the header spherHarmonicKernelsCPP.hpp.
+const SpherKernelsCPP &getSpherKernelsCPP();
+void legendreColScalar(double *out, const double *G, const double *H, const double *p1, const double *p2, const double t, const double u2, const size_t len);
+void legendreDerivColScalar(double *out, const double *E, const double *p, const double *p1, const double c1, const double u, const size_t len);
+void dots2Scalar(double *sums, const double *w, const double *C, const double *S, const double *P, const size_t len);
+void dots6Scalar(double *sums, const double *w, const double *wDr, const double *C, const double *S, const double *P, const double *dP, const size_t len);
+#ifdef SPHER_HARMONIC_X86_SIMD
+void legendreColAVX2(double *out, const double *G, const double *H, const double *p1, const double *p2, const double t, const double u2, const size_t len);
+void legendreDerivColAVX2(double *out, const double *E, const double *p, const double *p1, const double c1, const double u, const size_t len);
+void dots2AVX2(double *sums, const double *w, const double *C, const double *S, const double *P, const size_t len);
+void dots6AVX2(double *sums, const double *w, const double *wDr, const double *C, const double *S, const double *P, const double *dP, const size_t len);
+void legendreColAVX512(double *out, const double *G, const double *H, const double *p1, const double *p2, const double t, const double u2, const size_t len);
+void legendreDerivColAVX512(double *out, const double *E, const double *p, const double *p1, const double c1, const double u, const size_t len);
+void dots2AVX512(double *sums, const double *w, const double *C, const double *S, const double *P, const size_t len);
+void dots6AVX512(double *sums, const double *w, const double *wDr, const double *C, const double *S, const double *P, const double *dP, const size_t len);
+#endif
+
+SpherHarmonicLayoutCPP::SpherHarmonicLayoutCPP(const size_t maxDeg) {
+    const double jTerm=1/sqrt(2.0);
+    size_t n, m, curStart;
+    double nf, mf;
+
+    M=maxDeg;
+    colStart.resize(M+2);
+    curStart=0;
+    for(m=0;m<=M+1;m++) {
+        //The pad element plus the M-m+1 values, rounded up to a multiple
+        //of 4.
+        const size_t colLen=(m<=M)?(M-m+2):1;
+
+        colStart[m]=curStart;
+        curStart+=(colLen+3)&~static_cast<size_t>(3);
+    }
+    totalSize=curStart;
+
+    G.assign(totalSize,0.0);
+    H.assign(totalSize,0.0);
+    E.assign(totalSize,0.0);
+    diagRatio.assign(M+1,0.0);
+
+    //Equation 28 in the first Holmes and Featherstone paper.
+    mf=2.0;
+    for(m=2;m<=M;m++) {
+        diagRatio[m]=sqrt((2*mf+1)/(2*mf));
+        mf++;
+    }
+
+    mf=0.0;
+    for(m=0;m<=M;m++) {
+        nf=mf+1;
+        for(n=m+1;n<=M;n++) {
+            //g and h are given in Equations 18 and 19 of the first Holmes
+            //and Featherstone paper. h is zero for n=m+1.
+            double g=2*(mf+1)/sqrt((nf-mf)*(nf+mf+1));
+            double h=sqrt((nf+mf+2)*(nf-mf-1)/((nf-mf)*(nf+mf+1)));
+
+            if(m==0) {
+                g*=jTerm;
+                h*=jTerm;
+            }
+            G[idx(n,m)]=g;
+            H[idx(n,m)]=-h;
+            nf++;
+        }
+
+        //e is given in Equation 22 of the first Holmes and Featherstone
+        //paper.
+        nf=mf;
+        for(n=m;n<=M;n++) {
+            if(m==0) {
+                E[idx(n,m)]=-sqrt((nf+mf+1)*(nf-mf)/2);
+            } else {
+                E[idx(n,m)]=-sqrt((nf+mf+1)*(nf-mf));
+            }
+            nf++;
+        }
+        mf++;
+    }
+}
+
+shared_ptr<const SpherHarmonicLayoutCPP> getSpherHarmonicLayoutCPP(const size_t M) {
+    static mutex cacheMutex;
+    static shared_ptr<const SpherHarmonicLayoutCPP> cachedLayout;
+    lock_guard<mutex> lock(cacheMutex);
+
+    if(!cachedLayout||cachedLayout->M!=M) {
+        cachedLayout=shared_ptr<const SpherHarmonicLayoutCPP>(new SpherHarmonicLayoutCPP(M));
+    }
+    return cachedLayout;
+}
+
+void orderMajorFromClusterSetCPP(double *dest, const ClusterSetCPP<double> &src, const SpherHarmonicLayoutCPP &layout) {
+    const size_t M=layout.M;
+    size_t n, m;
+
+    fill(dest,dest+layout.totalSize,0.0);
+    for(n=0;n<=M;n++) {
+        const double *srcRow=src[n];
+
+        for(m=0;m<=n;m++) {
+            dest[layout.idx(n,m)]=srcRow[m];
+        }
+    }
+}
+
+void NALegendreCosRatOrderMajorCPP(double *P, const SpherHarmonicLayoutCPP &layout, const size_t N, const double theta, const double scalFactor) {
+    const SpherKernelsCPP &kernels=getSpherKernelsCPP();
+    const double u=sin(theta);
+    const double t=cos(theta);
+    size_t m;
+
+    //The diagonal, as in NALegendreCosRatCPP.
+    P[layout.idx(0,0)]=1.0*scalFactor;
+    if(N>=1) {
+        P[layout.idx(1,1)]=sqrt(3.0)*scalFactor;
+    }
+    for(m=2;m<=N;m++) {
+        P[layout.idx(m,m)]=layout.diagRatio[m]*P[layout.idx(m-1,m-1)];
+    }
+
+    //Equation 27, going down in order. The values of order m and degrees
+    //n=m+1 to N depend on orders m+1 and m+2 of the same degrees. The
+    //value of order m+2 for degree m+1 is the zero pad.
+    m=N;
+    while(m>0) {
+        m--;
+        const size_t outIdx=layout.idx(m+1,m);
+
+        kernels.legendreCol(P+outIdx,&layout.G[outIdx],&layout.H[outIdx],P+layout.idx(m+1,m+1),P+layout.colStart[m+2],t,u*u,N-m);
+    }
+}
+
+void NALegendreCosRatDerivOrderMajorCPP(double *dP, const double *P, const SpherHarmonicLayoutCPP &layout, const size_t N, const double theta) {
+    const SpherKernelsCPP &kernels=getSpherKernelsCPP();
+    const double u=sin(theta);
+    const double t=cos(theta);
+    size_t m;
+    double mf;
+
+    //Equation 30. The value of order m+1 for degree m is the zero pad.
+    mf=0.0;
+    for(m=0;m<=N;m++) {
+        const size_t outIdx=layout.idx(m,m);
+        const double c1=(m==0)?0.0:mf*(t/u);
+
+        kernels.legendreDerivCol(dP+outIdx,&layout.E[outIdx],P+outIdx,P+layout.colStart[m+1],c1,u,N-m+1);
+        mf++;
+    }
+}
+
+void spherHarmonicLumpedCoeffsCPP(double *XC, double *XS, double *XCdr, double *XSdr, double *XCdTheta, double *XSdTheta, const SpherHarmonicLayoutCPP &layout, const size_t N, const double *CO, const double *SO, const double *nCoeff, const double *nCoeffDr, const double *P, const double *dP) {
+    const SpherKernelsCPP &kernels=getSpherKernelsCPP();
+    size_t m;
+
+    for(m=0;m<=N;m++) {
+        const size_t startIdx=layout.idx(m,m);
+        const size_t len=N-m+1;
+
+        if(XCdr==NULL) {
+            double sums[2];
+
+            kernels.dots2(sums,nCoeff+m,CO+startIdx,SO+startIdx,P+startIdx,len);
+            XC[m]=sums[0];
+            XS[m]=sums[1];
+        } else {
+            double sums[6];
+
+            kernels.dots6(sums,nCoeff+m,nCoeffDr+m,CO+startIdx,SO+startIdx,P+startIdx,dP+startIdx,len);
+            XC[m]=sums[0];
+            XS[m]=sums[1];
+            XCdr[m]=sums[2];
+            XSdr[m]=sums[3];
+            XCdTheta[m]=sums[4];
+            XSdTheta[m]=sums[5];
+        }
+    }
+}
+
+void spherHarmonicLumpedCoeffs2CPP(double *XCdrr, double *XSdrr, double *XCdrTheta, double *XSdrTheta, const SpherHarmonicLayoutCPP &layout, const size_t N, const double *CO, const double *SO, const double *nCoeffDrr, const double *nCoeffDr, const double *P, const double *dP) {
+    const SpherKernelsCPP &kernels=getSpherKernelsCPP();
+    size_t m;
+
+    for(m=0;m<=N;m++) {
+        const size_t startIdx=layout.idx(m,m);
+        const size_t len=N-m+1;
+        double sums[2];
+
+        kernels.dots2(sums,nCoeffDrr+m,CO+startIdx,SO+startIdx,P+startIdx,len);
+        XCdrr[m]=sums[0];
+        XSdrr[m]=sums[1];
+        kernels.dots2(sums,nCoeffDr+m,CO+startIdx,SO+startIdx,dP+startIdx,len);
+        XCdrTheta[m]=sums[0];
+        XSdrTheta[m]=sums[1];
+    }
+}
+
+const SpherKernelsCPP &getSpherKernelsCPP() {
+/*GETSPHERKERNELSCPP Select the implementations of the inner loops the
+ *                   first time that this is called based on the
+ *                   instructions that the processor supports.
+ */
+    static const SpherKernelsCPP kernels=[]() {
+        SpherKernelsCPP k;
+
+        k.legendreCol=legendreColScalar;
+        k.legendreDerivCol=legendreDerivColScalar;
+        k.dots2=dots2Scalar;
+        k.dots6=dots6Scalar;
+    #ifdef SPHER_HARMONIC_X86_SIMD
+        __builtin_cpu_init();
+        if(__builtin_cpu_supports("avx512f")) {
+            k.legendreCol=legendreColAVX512;
+            k.legendreDerivCol=legendreDerivColAVX512;
+            k.dots2=dots2AVX512;
+            k.dots6=dots6AVX512;
+        } else if(__builtin_cpu_supports("avx2")&&__builtin_cpu_supports("fma")) {
+            k.legendreCol=legendreColAVX2;
+            k.legendreDerivCol=legendreDerivColAVX2;
+            k.dots2=dots2AVX2;
+            k.dots6=dots6AVX2;
+        }
+    #endif
+        return k;
+    }();
+
+    return kernels;
+}
+
+void legendreColScalar(double *out, const double *G, const double *H, const double *p1, const double *p2, const double t, const double u2, const size_t len) {
+    size_t i;
+
+    for(i=0;i<len;i++) {
+        out[i]=G[i]*t*p1[i]+H[i]*u2*p2[i];
+    }
+}
+
+void legendreDerivColScalar(double *out, const double *E, const double *p, const double *p1, const double c1, const double u, const size_t len) {
+    size_t i;
+
+    for(i=0;i<len;i++) {
+        out[i]=c1*p[i]+E[i]*u*p1[i];
+    }
+}
+
+void dots2Scalar(double *sums, const double *w, const double *C, const double *S, const double *P, const size_t len) {
+    double sumC=0;
+    double sumS=0;
+    size_t i;
+
+    for(i=0;i<len;i++) {
+        sumC+=w[i]*C[i]*P[i];
+        sumS+=w[i]*S[i]*P[i];
+    }
+    sums[0]=sumC;
+    sums[1]=sumS;
+}
+
+void dots6Scalar(double *sums, const double *w, const double *wDr, const double *C, const double *S, const double *P, const double *dP, const size_t len) {
+    double sumVals[6]={0,0,0,0,0,0};
+    size_t i;
+
+    for(i=0;i<len;i++) {
+        const double CScal=w[i]*C[i];
+        const double SScal=w[i]*S[i];
+        const double CScalDr=wDr[i]*C[i];
+        const double SScalDr=wDr[i]*S[i];
+
+        sumVals[0]+=CScal*P[i];
+        sumVals[1]+=SScal*P[i];
+        sumVals[2]+=CScalDr*P[i];
+        sumVals[3]+=SScalDr*P[i];
+        sumVals[4]+=CScal*dP[i];
+        sumVals[5]+=SScal*dP[i];
+    }
+    copy(sumVals,sumVals+6,sums);
+}
+
+#ifdef SPHER_HARMONIC_X86_SIMD
+
+__attribute__((target("avx2,fma")))
+inline double hSumAVX2(const __m256d x) {
+    const __m128d low=_mm256_castpd256_pd128(x);
+    const __m128d high=_mm256_extractf128_pd(x,1);
+    const __m128d sum2=_mm_add_pd(low,high);
+
+    return _mm_cvtsd_f64(_mm_add_sd(sum2,_mm_unpackhi_pd(sum2,sum2)));
+}
+
+__attribute__((target("avx2,fma")))
+void legendreColAVX2(double *out, const double *G, const double *H, const double *p1, const double *p2, const double t, const double u2, const size_t len) {
+    const __m256d tVec=_mm256_set1_pd(t);
+    const __m256d u2Vec=_mm256_set1_pd(u2);
+    size_t i;
+
+    for(i=0;i+4<=len;i+=4) {
+        const __m256d term1=_mm256_mul_pd(_mm256_mul_pd(_mm256_loadu_pd(G+i),tVec),_mm256_loadu_pd(p1+i));
+        const __m256d hu2=_mm256_mul_pd(_mm256_loadu_pd(H+i),u2Vec);
+
+        _mm256_storeu_pd(out+i,_mm256_fmadd_pd(hu2,_mm256_loadu_pd(p2+i),term1));
+    }
+    legendreColScalar(out+i,G+i,H+i,p1+i,p2+i,t,u2,len-i);
+}
+
+__attribute__((target("avx2,fma")))
+void legendreDerivColAVX2(double *out, const double *E, const double *p, const double *p1, const double c1, const double u, const size_t len) {
+    const __m256d c1Vec=_mm256_set1_pd(c1);
+    const __m256d uVec=_mm256_set1_pd(u);
+    size_t i;
+
+    for(i=0;i+4<=len;i+=4) {
+        const __m256d Eu=_mm256_mul_pd(_mm256_loadu_pd(E+i),uVec);
+
+        _mm256_storeu_pd(out+i,_mm256_fmadd_pd(Eu,_mm256_loadu_pd(p1+i),_mm256_mul_pd(c1Vec,_mm256_loadu_pd(p+i))));
+    }
+    legendreDerivColScalar(out+i,E+i,p+i,p1+i,c1,u,len-i);
+}
+
+__attribute__((target("avx2,fma")))
+void dots2AVX2(double *sums, const double *w, const double *C, const double *S, const double *P, const size_t len) {
+    __m256d accC=_mm256_setzero_pd();
+    __m256d accS=_mm256_setzero_pd();
+    double tailSums[2];
+    size_t i;
+
+    for(i=0;i+4<=len;i+=4) {
+        const __m256d wP=_mm256_mul_pd(_mm256_loadu_pd(w+i),_mm256_loadu_pd(P+i));
+
+        accC=_mm256_fmadd_pd(wP,_mm256_loadu_pd(C+i),accC);
+        accS=_mm256_fmadd_pd(wP,_mm256_loadu_pd(S+i),accS);
+    }
+    dots2Scalar(tailSums,w+i,C+i,S+i,P+i,len-i);
+    sums[0]=hSumAVX2(accC)+tailSums[0];
+    sums[1]=hSumAVX2(accS)+tailSums[1];
+}
+
+__attribute__((target("avx2,fma")))
+void dots6AVX2(double *sums, const double *w, const double *wDr, const double *C, const double *S, const double *P, const double *dP, const size_t len) {
+    __m256d acc[6];
+    double tailSums[6];
+    size_t i, k;
+
+    for(k=0;k<6;k++) {
+        acc[k]=_mm256_setzero_pd();
+    }
+    for(i=0;i+4<=len;i+=4) {
+        const __m256d CVec=_mm256_loadu_pd(C+i);
+        const __m256d SVec=_mm256_loadu_pd(S+i);
+        const __m256d PVec=_mm256_loadu_pd(P+i);
+        const __m256d dPVec=_mm256_loadu_pd(dP+i);
+        const __m256d wVec=_mm256_loadu_pd(w+i);
+        const __m256d wP=_mm256_mul_pd(wVec,PVec);
+        const __m256d wDrP=_mm256_mul_pd(_mm256_loadu_pd(wDr+i),PVec);
+        const __m256d wdP=_mm256_mul_pd(wVec,dPVec);
+
+        acc[0]=_mm256_fmadd_pd(wP,CVec,acc[0]);
+        acc[1]=_mm256_fmadd_pd(wP,SVec,acc[1]);
+        acc[2]=_mm256_fmadd_pd(wDrP,CVec,acc[2]);
+        acc[3]=_mm256_fmadd_pd(wDrP,SVec,acc[3]);
+        acc[4]=_mm256_fmadd_pd(wdP,CVec,acc[4]);
+        acc[5]=_mm256_fmadd_pd(wdP,SVec,acc[5]);
+    }
+    dots6Scalar(tailSums,w+i,wDr+i,C+i,S+i,P+i,dP+i,len-i);
+    for(k=0;k<6;k++) {
+        sums[k]=hSumAVX2(acc[k])+tailSums[k];
+    }
+}
+
+__attribute__((target("avx512f")))
+inline double hSumAVX512(const __m512d x) {
+/*_mm512_reduce_add_pd is not used, because GCC implements it by
+ *extracting halves into undefined vectors, which gives -Wuninitialized
+ *warnings. The sums are done in the same order.*/
+    double vals[8];
+
+    _mm512_storeu_pd(vals,x);
+    return ((vals[0]+vals[4])+(vals[2]+vals[6]))+((vals[1]+vals[5])+(vals[3]+vals[7]));
+}
+
+__attribute__((target("avx512f")))
+void legendreColAVX512(double *out, const double *G, const double *H, const double *p1, const double *p2, const double t, const double u2, const size_t len) {
+    const __m512d tVec=_mm512_set1_pd(t);
+    const __m512d u2Vec=_mm512_set1_pd(u2);
+    size_t i;
+
+    for(i=0;i+8<=len;i+=8) {
+        const __m512d term1=_mm512_mul_pd(_mm512_mul_pd(_mm512_loadu_pd(G+i),tVec),_mm512_loadu_pd(p1+i));
+        const __m512d hu2=_mm512_mul_pd(_mm512_loadu_pd(H+i),u2Vec);
+
+        _mm512_storeu_pd(out+i,_mm512_fmadd_pd(hu2,_mm512_loadu_pd(p2+i),term1));
+    }
+    legendreColScalar(out+i,G+i,H+i,p1+i,p2+i,t,u2,len-i);
+}
+
+__attribute__((target("avx512f")))
+void legendreDerivColAVX512(double *out, const double *E, const double *p, const double *p1, const double c1, const double u, const size_t len) {
+    const __m512d c1Vec=_mm512_set1_pd(c1);
+    const __m512d uVec=_mm512_set1_pd(u);
+    size_t i;
+
+    for(i=0;i+8<=len;i+=8) {
+        const __m512d Eu=_mm512_mul_pd(_mm512_loadu_pd(E+i),uVec);
+
+        _mm512_storeu_pd(out+i,_mm512_fmadd_pd(Eu,_mm512_loadu_pd(p1+i),_mm512_mul_pd(c1Vec,_mm512_loadu_pd(p+i))));
+    }
+    legendreDerivColScalar(out+i,E+i,p+i,p1+i,c1,u,len-i);
+}
+
+__attribute__((target("avx512f")))
+void dots2AVX512(double *sums, const double *w, const double *C, const double *S, const double *P, const size_t len) {
+    __m512d accC=_mm512_setzero_pd();
+    __m512d accS=_mm512_setzero_pd();
+    double tailSums[2];
+    size_t i;
+
+    for(i=0;i+8<=len;i+=8) {
+        const __m512d wP=_mm512_mul_pd(_mm512_loadu_pd(w+i),_mm512_loadu_pd(P+i));
+
+        accC=_mm512_fmadd_pd(wP,_mm512_loadu_pd(C+i),accC);
+        accS=_mm512_fmadd_pd(wP,_mm512_loadu_pd(S+i),accS);
+    }
+    dots2Scalar(tailSums,w+i,C+i,S+i,P+i,len-i);
+    sums[0]=hSumAVX512(accC)+tailSums[0];
+    sums[1]=hSumAVX512(accS)+tailSums[1];
+}
+
+__attribute__((target("avx512f")))
+void dots6AVX512(double *sums, const double *w, const double *wDr, const double *C, const double *S, const double *P, const double *dP, const size_t len) {
+    __m512d acc[6];
+    double tailSums[6];
+    size_t i, k;
+
+    for(k=0;k<6;k++) {
+        acc[k]=_mm512_setzero_pd();
+    }
+    for(i=0;i+8<=len;i+=8) {
+        const __m512d CVec=_mm512_loadu_pd(C+i);
+        const __m512d SVec=_mm512_loadu_pd(S+i);
+        const __m512d PVec=_mm512_loadu_pd(P+i);
+        const __m512d dPVec=_mm512_loadu_pd(dP+i);
+        const __m512d wVec=_mm512_loadu_pd(w+i);
+        const __m512d wP=_mm512_mul_pd(wVec,PVec);
+        const __m512d wDrP=_mm512_mul_pd(_mm512_loadu_pd(wDr+i),PVec);
+        const __m512d wdP=_mm512_mul_pd(wVec,dPVec);
+
+        acc[0]=_mm512_fmadd_pd(wP,CVec,acc[0]);
+        acc[1]=_mm512_fmadd_pd(wP,SVec,acc[1]);
+        acc[2]=_mm512_fmadd_pd(wDrP,CVec,acc[2]);
+        acc[3]=_mm512_fmadd_pd(wDrP,SVec,acc[3]);
+        acc[4]=_mm512_fmadd_pd(wdP,CVec,acc[4]);
+        acc[5]=_mm512_fmadd_pd(wdP,SVec,acc[5]);
+    }
+    dots6Scalar(tailSums,w+i,wDr+i,C+i,S+i,P+i,dP+i,len-i);
+    for(k=0;k<6;k++) {
+        sums[k]=hSumAVX512(acc[k])+tailSums[k];
+    }
+}
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,141 @@
+/**SPHERHARMONICKERNELSCPP A header file for functions that evaluate the
+ *                    most expensive parts of spherical harmonic synthesis
+ *                    using the algorithm of Holmes and Featherstone: the
+ *                    recursion for the ratios of the fully normalized
+ *                    associated Legendre functions to u^m and the sums
+ *                    over the degree giving the lumped coefficients for
+ *                    each order.
+ *
+ *In the ClusterSetCPP classes used elsewhere, the values are stored by
+ *degree, so the elements of a given order are not contiguous and the sums
+ *over the degree can not be vectorized. The functions here use an
+ *order-major layout, where column m holds the values for degrees n=m to
+ *M contiguously, preceded by a single zero pad element. The pad makes the
+ *recursions uniform, since the values for degree n<m of column m are
+ *zero. Columns are padded to multiples of 4 elements. The recursion
+ *coefficients, which involve square roots, only depend on the maximum
+ *degree and are precomputed.
+ *
+ *The inner loops are run using AVX-512 or AVX2 with FMA instructions when
+ *compiled with GCC or Clang for x86 processors and the processor supports
+ *them, which is determined at runtime. Otherwise, scalar loops are used.
+ *The results of the different paths can differ in the last bits, but a
+ *given path always produces the same results.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef SPHERHARMONICKERNELSCPP
+#define SPHERHARMONICKERNELSCPP
+
+#include <stddef.h>
+#include <vector>
+#include <memory>
+#include "ClusterSetCPP.hpp"
+
+/*The SpherHarmonicLayoutCPP class holds the order-major layout and the
+ *precomputed recursion coefficients for a maximum degree M. It does not
+ *depend on the coefficients of the model or on the point.*/
+class SpherHarmonicLayoutCPP {
+public:
+    size_t M;
+    //The total number of elements in an order-major array.
+    size_t totalSize;
+    /*colStart[m] is the index of the zero pad element of column m; the
+     *value for degree n is at colStart[m]+1+(n-m). There are M+2
+     *columns, the last holding only the pad.*/
+    std::vector<size_t> colStart;
+    //The coefficients of the recursion in the degree for each column.
+    std::vector<double> G;
+    std::vector<double> H;
+    //The coefficients of the recursion for the derivatives.
+    std::vector<double> E;
+    //The ratios of consecutive values along the diagonal n=m.
+    std::vector<double> diagRatio;
+
+    explicit SpherHarmonicLayoutCPP(const size_t maxDeg);
+
+    inline size_t idx(const size_t n, const size_t m) const {
+        return colStart[m]+1+(n-m);
+    }
+};
+
+std::shared_ptr<const SpherHarmonicLayoutCPP> getSpherHarmonicLayoutCPP(const size_t M);
+/*GETSPHERHARMONICLAYOUTCPP Get the layout for maximum degree M. The most
+ *                  recently used layout is cached, so repeated calls
+ *                  with the same M do not recompute the coefficients. This
+ *                  function is thread safe.
+ */
+
+void orderMajorFromClusterSetCPP(double *dest, const ClusterSetCPP<double> &src, const SpherHarmonicLayoutCPP &layout);
+/*ORDERMAJORFROMCLUSTERSETCPP Copy coefficients stored by degree in a
+ *                  ClusterSet into an order-major array of
+ *                  layout.totalSize elements, setting the pad elements to
+ *                  zero.
+ */
+
+void NALegendreCosRatOrderMajorCPP(double *P, const SpherHarmonicLayoutCPP &layout, const size_t N, const double theta, const double scalFactor);
+/*NALEGENDRECOSRATORDERMAJORCPP The same as NALegendreCosRatCPP, except the
+ *                  results are placed in the order-major array P, whose
+ *                  pad elements must be zero. Only the values for degrees
+ *                  up to N<=layout.M are computed. The values for higher
+ *                  degrees in P are not changed.
+ */
+
+void NALegendreCosRatDerivOrderMajorCPP(double *dP, const double *P, const SpherHarmonicLayoutCPP &layout, const size_t N, const double theta);
+/*NALEGENDRECOSRATDERIVORDERMAJORCPP The same as NALegendreCosRatDerivCPP,
+ *                  except the values are in order-major arrays. The pad
+ *                  elements of dP and P must be zero. As with
+ *                  NALegendreCosRatOrderMajorCPP, only degrees up to N
+ *                  are computed. This must not be called at the poles,
+ *                  where u=0.
+ */
+
+void spherHarmonicLumpedCoeffsCPP(double *XC, double *XS, double *XCdr, double *XSdr, double *XCdTheta, double *XSdTheta, const SpherHarmonicLayoutCPP &layout, const size_t N, const double *CO, const double *SO, const double *nCoeff, const double *nCoeffDr, const double *P, const double *dP);
+/*SPHERHARMONICLUMPEDCOEFFSCPP Compute the lumped coefficients of Equation
+ *                  7 of the Holmes and Featherstone paper for each order
+ *                  m=0 to N, where N<=layout.M is the maximum degree
+ *                  used:
+ *                  XC[m]=sum_{n=m}^N nCoeff[n]*C[n][m]*P[n][m]
+ *                  and XS[m] likewise with S. If XCdr is not NULL, then
+ *                  the coefficients for the partial derivatives are also
+ *                  computed:
+ *                  XCdr[m]=sum_{n=m}^N nCoeffDr[n]*C[n][m]*P[n][m]
+ *                  XCdTheta[m]=sum_{n=m}^N nCoeff[n]*C[n][m]*dP[n][m]
+ *                  and the same for XSdr and XSdTheta with S. CO and SO
+ *                  are the order-major coefficients, nCoeff holds
+ *                  (a/r)^n and nCoeffDr holds (n+1)*(a/r)^n for n=0 to N.
+ */
+
+void spherHarmonicLumpedCoeffs2CPP(double *XCdrr, double *XSdrr, double *XCdrTheta, double *XSdrTheta, const SpherHarmonicLayoutCPP &layout, const size_t N, const double *CO, const double *SO, const double *nCoeffDrr, const double *nCoeffDr, const double *P, const double *dP);
+/*SPHERHARMONICLUMPEDCOEFFS2CPP Compute the lumped coefficients needed for
+ *                  the second partial derivatives in addition to those of
+ *                  spherHarmonicLumpedCoeffsCPP:
+ *                  XCdrr[m]=sum_{n=m}^N nCoeffDrr[n]*C[n][m]*P[n][m]
+ *                  XCdrTheta[m]=sum_{n=m}^N nCoeffDr[n]*C[n][m]*dP[n][m]
+ *                  and the same for XSdrr and XSdrTheta with S, where
+ *                  nCoeffDrr holds (n+1)*(n+2)*(a/r)^n. The second
+ *                  derivatives of the Legendre function ratios with
+ *                  respect to theta are not needed, because they follow
+ *                  from P and dP through the differential equation of the
+ *                  Legendre functions.
+ */
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
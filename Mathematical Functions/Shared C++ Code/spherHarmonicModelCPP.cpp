@@ -0,0 +1,90 @@
+/*SPHERHARMONICMODELCPP C++ implementation of a class holding a spherical
+ *                    harmonic model that is evaluated repeatedly. See
+ *                    spherHarmonicModelCPP.hpp for more information.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For memcpy
+#include <string.h>
+#include "spherHarmonicModelCPP.hpp"
+
+using namespace std;
+
+SpherHarmonicModelCPP::SpherHarmonicModelCPP(const double *CCoeffs, const double *SCoeffs, const size_t maxDeg, const double aVal, const double cVal, const double scalFactorVal) {
+    vector<size_t> clusterSizes(maxDeg+1);
+    size_t n;
+
+    M=maxDeg;
+    a=aVal;
+    c=cVal;
+    scalFactor=scalFactorVal;
+
+    //Degree n has the n+1 orders m=0 to n.
+    for(n=0;n<=M;n++) {
+        clusterSizes[n]=n+1;
+    }
+    C.initWithClusterSizes(clusterSizes.data(),M+1);
+    S.initWithClusterSizes(clusterSizes.data(),M+1);
+    memcpy(C.clusterEls,CCoeffs,sizeof(double)*C.totalNumEl);
+    memcpy(S.clusterEls,SCoeffs,sizeof(double)*S.totalNumEl);
+
+    //The layout is held here, so it remains valid even if the cached
+    //layout is replaced by one for a different degree.
+    layout=getSpherHarmonicLayoutCPP(M);
+    CO.resize(layout->totalSize);
+    SO.resize(layout->totalSize);
+    orderMajorFromClusterSetCPP(CO.data(),C,*layout);
+    orderMajorFromClusterSetCPP(SO.data(),S,*layout);
+    COData=CO.data();
+    SOData=SO.data();
+
+    degAmp.resize(M+1);
+    spherHarmonicDegAmpCPP(degAmp.data(),C,S);
+    degAmpData=degAmp.data();
+    relTol=0;
+}
+
+SpherHarmonicModelCPP::SpherHarmonicModelCPP(const shared_ptr<const SpherHarmonicCoeffFileCPP> &coeffFileVal, const double scalFactorVal) {
+    coeffFile=coeffFileVal;
+
+    M=static_cast<size_t>(coeffFile->header.M);
+    a=coeffFile->header.a;
+    c=coeffFile->header.c;
+    scalFactor=scalFactorVal;
+
+    //Everything is read from the mapped file. The size of the order-major
+    //arrays was checked against the layout when the file was opened.
+    coeffFile->getClusterSet(C,coeffFile->C,M);
+    coeffFile->getClusterSet(S,coeffFile->S,M);
+    layout=getSpherHarmonicLayoutCPP(M);
+    COData=coeffFile->CO;
+    SOData=coeffFile->SO;
+    degAmpData=coeffFile->degAmp;
+    relTol=0;
+}
+
+void SpherHarmonicModelCPP::evaluate(double *V, double *gradV, double *HessV, const double *point, const size_t numPoints, const size_t numThreads) {
+    spherHarmonicEvalPreparedCPP(V,gradV,HessV,C,S,*layout,COData,SOData,point,numPoints,a,c,scalFactor,degAmpData,relTol,numThreads,scratch);
+}
+
+void SpherHarmonicModelCPP::setRelTol(const double newRelTol) {
+    relTol=newRelTol;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,162 @@
+/**SPHERHARMONICMODELCPP A header file for a class holding a spherical
+ *                    harmonic model (such as a gravitational or magnetic
+ *                    model) that is loaded once and then evaluated
+ *                    repeatedly. spherHarmonicEvalCPP copies the
+ *                    coefficients into the order-major layout of
+ *                    spherHarmonicKernelsCPP.hpp and allocates its work
+ *                    buffers on every call. When the same model is
+ *                    evaluated many times, such as when computing the
+ *                    acceleration due to gravity at every step of an
+ *                    orbit propagation, the SpherHarmonicModelCPP class
+ *                    does that once and keeps the work buffers between
+ *                    calls. A model can also be created from a memory
+ *                    mapped coefficient file (see
+ *                    spherHarmonicCoeffFileCPP.hpp), in which case nothing
+ *                    is copied and the coefficients are read directly from
+ *                    the mapping.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef SPHERHARMONICMODELCPP
+#define SPHERHARMONICMODELCPP
+
+#include <stddef.h>
+#include <vector>
+#include <memory>
+#include "ClusterSetCPP.hpp"
+#include "spherHarmonicKernelsCPP.hpp"
+#include "spherHarmonicCoeffFileCPP.hpp"
+
+/*The SpherHarmonicScratchCPP class holds the work buffers used by one
+ *thread when evaluating a spherical harmonic series. The buffers are
+ *resized as needed, so an instance can be reused for any number of
+ *points.*/
+class SpherHarmonicScratchCPP {
+public:
+    //The values that are stored by degree and by order.
+    std::vector<double> buffer;
+    //The order-major Legendre function ratios and their derivatives. The
+    //pad elements are always zero.
+    std::vector<double> PO;
+    std::vector<double> dPO;
+    //The rm and im terms of Pines' algorithm used for the covariance in
+    //spherHarmonicEvalCovCPP.
+    std::vector<double> covBuffer;
+};
+
+void spherHarmonicEvalPreparedCPP(double *V, double *gradV, double *HessV, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S, const SpherHarmonicLayoutCPP &layout, const double *CO, const double *SO, const double *point, const size_t numPoints, const double a, const double c, const double scalFactor, const double *degAmp, const double relTol, const size_t numThreads, std::vector<SpherHarmonicScratchCPP> &scratch);
+/*SPHERHARMONICEVALPREPAREDCPP The same as spherHarmonicEvalCPP, except
+ *                  the order-major coefficients CO and SO for the given
+ *                  layout and the work buffers are provided. scratch is
+ *                  resized to hold one element per thread used. If relTol
+ *                  is positive, then degAmp must be the degree amplitudes
+ *                  from spherHarmonicDegAmpCPP and the series at each
+ *                  point is truncated at the degree given by
+ *                  spherHarmonicTruncDegCPP, where derivOrder is 2 if
+ *                  HessV is not NULL, 1 if gradV is not NULL and 0
+ *                  otherwise. The points are then evaluated in order of
+ *                  decreasing degree. If relTol=0 or degAmp is NULL, all
+ *                  degrees are used.
+ */
+
+void spherHarmonicDegAmpCPP(double *degAmp, const ClusterSetCPP<double> &C, const ClusterSetCPP<double> &S);
+/*SPHERHARMONICDEGAMPCPP Compute the amplitude of each degree n=0 to M of
+ *                  fully normalized coefficients,
+ *                  degAmp[n]=sqrt(sum_{m=0}^n C[n][m]^2+S[n][m]^2).
+ *                  This is the root mean square value over the sphere of
+ *                  the degree n terms of the series (without the (a/r)^n
+ *                  factor).
+ */
+
+size_t spherHarmonicTruncDegCPP(const double *degAmp, const size_t M, const double aOverR, const double relTol, const size_t derivOrder);
+/*SPHERHARMONICTRUNCDEGCPP Get the lowest degree N<=M for which the sum
+ *                  of the terms w(n)*(a/r)^n*degAmp[n] for n=N+1 to M is
+ *                  at most relTol times the largest of the terms. w(n) is
+ *                  1 for the potential (derivOrder=0), (n+1) for the
+ *                  gradient (derivOrder=1) and (n+1)*(n+2) for the Hessian
+ *                  (derivOrder=2), which are the factors by which the
+ *                  radial derivatives scale the terms. The result bounds
+ *                  the root mean square, over all points at range r, of
+ *                  the error due to truncation relative to the largest
+ *                  degree term. It is not a strict bound on the error at
+ *                  each point.
+ */
+
+class SpherHarmonicModelCPP {
+public:
+    //The maximum degree of the model.
+    size_t M;
+    double a;
+    double c;
+    double scalFactor;
+    //The fully normalized coefficients stored by degree. These are used by
+    //the algorithm of Pines near the poles. They are copies, or views of
+    //the mapped file if the model was created from a file.
+    ClusterSetCPP<double> C;
+    ClusterSetCPP<double> S;
+    //The recursion coefficients and the order-major C and S. COData and
+    //SOData point to CO and SO, or into the mapped file.
+    std::shared_ptr<const SpherHarmonicLayoutCPP> layout;
+    std::vector<double> CO;
+    std::vector<double> SO;
+    const double *COData;
+    const double *SOData;
+    //The mapped file, if the model was created from one. It is NULL
+    //otherwise.
+    std::shared_ptr<const SpherHarmonicCoeffFileCPP> coeffFile;
+    //The work buffers for each thread, which are kept between calls.
+    std::vector<SpherHarmonicScratchCPP> scratch;
+    //The amplitudes of the degrees from spherHarmonicDegAmpCPP and the
+    //relative tolerance used to choose the degree at each point. relTol=0
+    //means that all degrees are used. degAmpData points to degAmp or into
+    //the mapped file.
+    std::vector<double> degAmp;
+    const double *degAmpData;
+    double relTol;
+
+    SpherHarmonicModelCPP(const double *CCoeffs, const double *SCoeffs, const size_t maxDeg, const double aVal, const double cVal, const double scalFactorVal);
+    /*The constructor copies the coefficients. CCoeffs and SCoeffs hold
+     *(maxDeg+1)*(maxDeg+2)/2 elements each, stored by degree in the same
+     *manner as in the clusterEls member of a ClusterSet, with fully
+     *normalized coefficients.*/
+
+    SpherHarmonicModelCPP(const std::shared_ptr<const SpherHarmonicCoeffFileCPP> &coeffFileVal, const double scalFactorVal);
+    /*Create a model using all of the degrees of C and S in a coefficient
+     *file that has been opened. The values of a and c are taken from the
+     *file. The file remains mapped as long as the model exists.*/
+
+    void evaluate(double *V, double *gradV, double *HessV, const double *point, const size_t numPoints, const size_t numThreads);
+    /*Evaluate the potential and, if gradV is not NULL, its gradient and, if
+     *HessV is also not NULL, its Hessian at the numPoints points given in
+     *spherical coordinates [r;azimuth;elevation]. If relTol=0, the results
+     *are the same as those of spherHarmonicEvalCPP. Otherwise, the series
+     *is truncated at each point as in spherHarmonicEvalPreparedCPP.*/
+
+    void setRelTol(const double newRelTol);
+    /*Set the relative tolerance used to choose the maximum degree at each
+     *point. A value of zero means that all of the degrees are used.*/
+private:
+    //ClusterSetCPP does not support copying, so neither does this class.
+    SpherHarmonicModelCPP(const SpherHarmonicModelCPP &);
+    SpherHarmonicModelCPP &operator=(const SpherHarmonicModelCPP &);
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
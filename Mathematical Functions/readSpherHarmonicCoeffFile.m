@@ -0,0 +1,108 @@
+function [C,S,a,c,CAux,SAux,auxType,refEpoch]=readSpherHarmonicCoeffFile(fileName,M)
+%%READSPHERHARMONICCOEFFFILE Read spherical harmonic coefficients up to a
+%                   given degree from a binary file written by
+%                   writeSpherHarmonicCoeffFile. Since the coefficients are
+%                   stored by degree, only the part of the file holding
+%                   degrees up to M is read.
+%
+%INPUTS: fileName The name of the coefficient file.
+%               M The maximum degree of the coefficients to read. If this
+%                 is omitted, an empty matrix is passed or M is larger
+%                 than the maximum degree in the file, all of the
+%                 coefficients are read.
+%
+%OUTPUTS: C, S  ClusterSet classes holding the fully normalized
+%               coefficients up to degree M.
+%         a, c  The numerator in the (a/r)^n term and the constant by which
+%               the series is multiplied, as stored in the file.
+%   CAux, SAux  ClusterSet classes holding the auxiliary coefficients up to
+%               the lesser of M and their maximum degree in the file. These
+%               are empty matrices if the file has no auxiliary
+%               coefficients.
+%      auxType  0 if there are no auxiliary coefficients, 1 if they are
+%               standard deviations and 2 if they are rates of change per
+%               year.
+%     refEpoch  The reference epoch stored in the file.
+%
+%The format of the file is described in spherHarmonicCoeffFileCPP.hpp.
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+fileID=fopen(fileName,'r');
+if(fileID==-1)
+    error('The coefficient file could not be opened.');
+end
+
+%Read the 72-byte header.
+magic=fread(fileID,8,'*char')';
+version=fread(fileID,1,'uint32');
+byteOrder=fread(fileID,1,'uint32');
+if(~strcmp(magic,'SPHHARMC')||version~=1)
+    fclose(fileID);
+    error('The file is not a valid spherical harmonic coefficient file.');
+end
+if(byteOrder~=hex2dec('01020304'))
+    fclose(fileID);
+    error('The coefficient file was written on a machine with a different byte order.');
+end
+MFile=fread(fileID,1,'uint64');
+MAuxFile=fread(fileID,1,'uint64');
+numSets=fread(fileID,1,'uint32');
+auxType=fread(fileID,1,'uint32');
+%The size of the order-major arrays, which are not read here.
+fread(fileID,1,'uint64');
+a=fread(fileID,1,'double');
+c=fread(fileID,1,'double');
+refEpoch=fread(fileID,1,'double');
+
+if(nargin<2||isempty(M)||M>MFile)
+    M=MFile;
+end
+
+%Skip the offsets of the degrees.
+fseek(fileID,8*(MFile+1),'cof');
+
+C=readDegrees(fileID,M,MFile);
+S=readDegrees(fileID,M,MFile);
+
+if(numSets==4)
+    MAux=min(M,MAuxFile);
+    CAux=readDegrees(fileID,MAux,MAuxFile);
+    SAux=readDegrees(fileID,MAux,MAuxFile);
+else
+    CAux=[];
+    SAux=[];
+end
+fclose(fileID);
+end
+
+function C=readDegrees(fileID,M,MFile)
+%%READDEGREES Read the coefficients up to degree M from a set of
+%             coefficients up to degree MFile and put them into a
+%             ClusterSet. The file is left positioned after the set.
+
+    numCoeffs=(M+1)*(M+2)/2;
+    numFileCoeffs=(MFile+1)*(MFile+2)/2;
+
+    coeffs=fread(fileID,numCoeffs,'double');
+    fseek(fileID,8*(numFileCoeffs-numCoeffs),'cof');
+    C=ClusterSet(coeffs,1:(M+1));
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
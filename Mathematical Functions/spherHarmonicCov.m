@@ -1,4 +1,4 @@
-function [sigma2,Sigma]=spherHarmonicCov(CStdDev,SStdDev,point,a,c,fullyNormalized,scalFactor)
+function [sigma2,Sigma]=spherHarmonicCov(CStdDev,SStdDev,point,a,c,fullyNormalized,scalFactor,numThreads)
 %%SPHERHARMONICCOV  Evaluate the variance of a potential or the covariance
 %                   matrix of a gradient that one might compute using a
 %                   spherical harmonic coefficient model with
@@ -70,6 +70,11 @@ function [sigma2,Sigma]=spherHarmonicCov(CStdDev,SStdDev,point,a,c,fullyNormaliz
 %               high-order models are used, this scale factor prevents
 %               overflows. However overflows (and a loss of precision) are
 %               unavoidable when using the full EGM2008 model.
+%    numThreads An optional parameter specifying how many threads the
+%               points are split across when the compiled C++
+%               implementation is used. The default if omitted or an empty
+%               matrix is passed is 1. This parameter is ignored by the
+%               Matlab implementation.
 %
 %OUTPUTS: sigma2 The NX1 vector of variances (squared standard deviations)
 %                of the potential estimate at the given points.
@@ -85,6 +90,10 @@ function [sigma2,Sigma]=spherHarmonicCov(CStdDev,SStdDev,point,a,c,fullyNormaliz
 %April 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
 %(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
 
+if(nargin<8||isempty(numThreads))
+    numThreads=1;
+end
+
 if(nargin<7)
     scalFactor=2^(-500);
 end
@@ -152,9 +161,9 @@ if(exist('spherHarmonicCovCPPInt','file'))
     end
     
     if(nargout==2)
-        [sigma2,Sigma]=spherHarmonicCovCPPInt(CStdDev.clusterEls,SStdDev.clusterEls,CStdDev.offsetArray,CStdDev.clusterSizes,point,a,c,scalFactor);
+        [sigma2,Sigma]=spherHarmonicCovCPPInt(CStdDev.clusterEls,SStdDev.clusterEls,CStdDev.offsetArray,CStdDev.clusterSizes,point,a,c,scalFactor,numThreads);
     else
-        sigma2=spherHarmonicCovCPPInt(CStdDev.clusterEls,SStdDev.clusterEls,CStdDev.offsetArray,CStdDev.clusterSizes,point,a,c,scalFactor);
+        sigma2=spherHarmonicCovCPPInt(CStdDev.clusterEls,SStdDev.clusterEls,CStdDev.offsetArray,CStdDev.clusterSizes,point,a,c,scalFactor,numThreads);
     end
     return
 end
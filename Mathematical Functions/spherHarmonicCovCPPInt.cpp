@@ -20,12 +20,14 @@
  *CompileCLibraries function.
  *
  *The function is called in Matlab using the format:
- *[sigma2,Sigma]=spherHarmonicCovCPPInt(CStdDev,SStdDev,offsetArray,clusterSizes,point,a,c,scalFactor);
+ *[sigma2,Sigma]=spherHarmonicCovCPPInt(CStdDev,SStdDev,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
  *or using 
- *[sigma2]=spherHarmonicCovCPPInt(CStdDev,SStdDev,offsetArray,clusterSizes,point,a,c,scalFactor);
+ *[sigma2]=spherHarmonicCovCPPInt(CStdDev,SStdDev,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
  *if one only the variance of the potential is desired. The function
  *executes faster if only the variance of the potential and not the
- *covariance matrix of the gradient need be computed.
+ *covariance matrix of the gradient need be computed. The numThreads input
+ *is optional and defaults to 1. The points are split across that many
+ *threads.
  *
  *April 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
  */
@@ -43,14 +45,14 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     double *point;
     ClusterSetCPP<double> CStdDev;
     ClusterSetCPP<double> SStdDev;
-    size_t numPoints;
+    size_t numPoints, numThreads;
     mxArray *sigma2MATLAB;
     //This variable is only used if nlhs>1. It is set to zero here to
     //suppress a warning if compiled using -Wconditional-uninitialized.
     mxArray *SigmaMATLAB=NULL;
     double *sigma2,*Sigma;
     
-    if(nrhs!=8) {
+    if(nrhs!=8&&nrhs!=9) {
         mexErrMsgTxt("Wrong number of inputs.");
     }
     
@@ -78,6 +80,11 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     a=getDoubleFromMatlab(prhs[5]);
     c=getDoubleFromMatlab(prhs[6]);
     scalFactor=getDoubleFromMatlab(prhs[7]);
+    if(nrhs>8) {
+        numThreads=getSizeTFromMatlab(prhs[8]);
+    } else {
+        numThreads=1;
+    }
     
     //Allocate space for the return values
     sigma2MATLAB=mxCreateDoubleMatrix(numPoints, 1,mxREAL);
@@ -95,7 +102,7 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     } else {
         Sigma=NULL;
     }
-    spherHarmonicCovCPP(sigma2,Sigma,CStdDev,SStdDev,point,numPoints,a,c,scalFactor);
+    spherHarmonicCovCPP(sigma2,Sigma,CStdDev,SStdDev,point,numPoints,a,c,scalFactor,numThreads);
 
     plhs[0]=sigma2MATLAB;
     
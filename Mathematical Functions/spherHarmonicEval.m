@@ -1,4 +1,4 @@
-function [V,gradV]=spherHarmonicEval(C,S,point,a,c,fullyNormalized,scalFactor)
+function [V,gradV,HessV]=spherHarmonicEval(C,S,point,a,c,fullyNormalized,scalFactor,numThreads)
 %%SPHERHARMONICEVAL  Evaluate a potential (e.g. gravitational or magnetic)
 %                    and/ or the gradient of a  potential when the
 %                    potential is expressed in terms of spherical harmonic
@@ -70,6 +70,14 @@ function [V,gradV]=spherHarmonicEval(C,S,point,a,c,fullyNormalized,scalFactor)
 %               in the Holmes and Featherstone paper (cited below) is
 %               sufficient. When very high-order models are used, this
 %               scale factor prevents overflows.
+%    numThreads An optional parameter specifying the number of threads
+%               across which the points are split when the compiled C++
+%               implementation is used. If omitted or an empty matrix is
+%               passed, one thread is used. If zero, the number of hardware
+%               threads is used. The results are the same regardless of
+%               the number of threads. Since consecutive points with the
+%               same range and elevation share computations within each
+%               thread, presorting the points remains beneficial.
 %
 %OUTPUTS:  V    The potential as obtained from the spherical harmonic
 %               series. When dealing with gravitational models, the SI
@@ -87,6 +95,14 @@ function [V,gradV]=spherHarmonicEval(C,S,point,a,c,fullyNormalized,scalFactor)
 %               (The rotation is assumed to be about the z-axis). If V is a
 %               magnetic potential, then gradV is the negative of the
 %               magnetic flux density vector B.
+%      HessV    The 3X3XnumPoints Hessian matrices of the potential in
+%               Cartesian coordinates (the gravity gradient tensor, when V
+%               is a gravitational potential). HessV(:,:,i) is the matrix
+%               of second partial derivatives of V with respect to
+%               [x;y;z] at the ith point. It is symmetric and, outside of
+%               the attracting body, has a zero trace. This output is
+%               only available if the compiled C++ implementation
+%               spherHarmonicEvalCPPInt exists.
 %
 %When non-normalized coefficients are used, the spherical harmonic series
 %for the potential is assumed to be of the form
@@ -230,6 +246,10 @@ function [V,gradV]=spherHarmonicEval(C,S,point,a,c,fullyNormalized,scalFactor)
 %December 2013 David F. Crouse, Naval Research Laboratory, Washington D.C.
 %(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
 
+if(nargin<8||isempty(numThreads))
+    numThreads=1;
+end
+
 if(nargin<7)
     scalFactor=10^(-280);
 end
@@ -296,14 +316,20 @@ if(exist('spherHarmonicEvalCPPInt','file'))
             C.clusterSizes=reshape(uint64(C.clusterSizes),C.numClusters(),1);
     end
     
-    if(nargout==2)
-        [V,gradV]=spherHarmonicEvalCPPInt(C.clusterEls,S.clusterEls,C.offsetArray,C.clusterSizes,point,a,c,scalFactor);
+    if(nargout==3)
+        [V,gradV,HessV]=spherHarmonicEvalCPPInt(C.clusterEls,S.clusterEls,C.offsetArray,C.clusterSizes,point,a,c,scalFactor,numThreads);
+    elseif(nargout==2)
+        [V,gradV]=spherHarmonicEvalCPPInt(C.clusterEls,S.clusterEls,C.offsetArray,C.clusterSizes,point,a,c,scalFactor,numThreads);
     else
-        V=spherHarmonicEvalCPPInt(C.clusterEls,S.clusterEls,C.offsetArray,C.clusterSizes,point,a,c,scalFactor);
+        V=spherHarmonicEvalCPPInt(C.clusterEls,S.clusterEls,C.offsetArray,C.clusterSizes,point,a,c,scalFactor,numThreads);
     end
     return
 end
 
+if(nargout>2)
+    error('The Hessian is only available from the compiled C++ implementation. Run CompileCLibraries.')
+end
+
 %Preallocate space used by the modified forward row algorithm when
 %evaluating over multiple values with the same range and latitude but
 %different longitudes.
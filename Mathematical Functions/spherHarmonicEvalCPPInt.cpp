@@ -18,11 +18,16 @@
  *CompileCLibraries function.
  *
  *The function is called in Matlab using the format:
- *[V,gradV]=spherHarmonicEvalCPPInt(CCoeffs,SCoeffs,offsetArray,clusterSizes,point,a,c,scalFactor);
- *or using 
- *[V]=spherHarmonicEvalCPPInt(CCoeffs,SCoeffs,offsetArray,clusterSizes,point,a,c,scalFactor);
+ *[V,gradV]=spherHarmonicEvalCPPInt(CCoeffs,SCoeffs,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
+ *or using
+ *[V,gradV,HessV]=spherHarmonicEvalCPPInt(CCoeffs,SCoeffs,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
+ *if the 3X3XnumPoints Hessian of the potential is also desired, or using 
+ *[V]=spherHarmonicEvalCPPInt(CCoeffs,SCoeffs,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
  *if one only wants the potential. The function executes faster if only the
- *potential and not the gradient need be computed.
+ *potential and not the gradient need be computed. The numThreads input is
+ *optional. It is the number of threads across which the points are split.
+ *If omitted, one thread is used. If zero, the number of hardware threads
+ *is used. The results do not depend on the number of threads.
  *
  *January 2014 David F. Crouse, Naval Research Laboratory, Washington D.C.
  */
@@ -41,16 +46,22 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     ClusterSetCPP<double> C;
     ClusterSetCPP<double> S;
     size_t numPoints;
+    size_t numThreads=1;
     mxArray *VMATLAB;
     //This variable is only used if nlhs>1. It is set to zero here to
     //suppress a warning if compiled using -Wconditional-uninitialized.
     mxArray *gradVMATLAB=NULL;
-    double *V,*gradV;
+    mxArray *HessVMATLAB=NULL;
+    double *V,*gradV,*HessV;
     
-    if(nrhs!=8) {
+    if(nrhs!=8&&nrhs!=9) {
         mexErrMsgTxt("Wrong number of inputs.");
     }
     
+    if(nlhs>3) {
+        mexErrMsgTxt("Wrong number of outputs.");
+    }
+    
     C.clusterEls=(double*)mxGetData(prhs[0]);
     S.clusterEls=(double*)mxGetData(prhs[1]);
     
@@ -75,6 +86,9 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     a=getDoubleFromMatlab(prhs[5]);
     c=getDoubleFromMatlab(prhs[6]);
     scalFactor=getDoubleFromMatlab(prhs[7]);
+    if(nrhs>8) {
+        numThreads=getSizeTFromMatlab(prhs[8]);
+    }
     
     //Allocate space for the return values
     VMATLAB=mxCreateDoubleMatrix(numPoints, 1,mxREAL);
@@ -86,13 +100,24 @@ void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray
     } else {
         gradV=NULL;
     }
-    spherHarmonicEvalCPP(V, gradV,C,S,point,numPoints,a,c,scalFactor);
+    
+    if(nlhs>2) {
+        const mwSize dims[3]={3,3,numPoints};
+        HessVMATLAB=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+        HessV=(double*)mxGetData(HessVMATLAB);
+    } else {
+        HessV=NULL;
+    }
+    spherHarmonicEvalCPP(V,gradV,HessV,C,S,point,numPoints,a,c,scalFactor,numThreads);
 
     plhs[0]=VMATLAB;
     
     if(nlhs>1) {
         plhs[1]=gradVMATLAB;
     }
+    if(nlhs>2) {
+        plhs[2]=HessVMATLAB;
+    }
 }
 
 /*LICENSE:
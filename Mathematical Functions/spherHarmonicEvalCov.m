@@ -0,0 +1,170 @@
+function [V,gradV,sigma2,Sigma]=spherHarmonicEvalCov(C,S,CStdDev,SStdDev,point,a,c,fullyNormalized,scalFactor,numThreads)
+%%SPHERHARMONICEVALCOV Evaluate a potential (e.g. gravitational or
+%                   magnetic) and its gradient using a spherical harmonic
+%                   coefficient model as well as the variance of the
+%                   potential and the covariance matrix of the gradient
+%                   given the standard deviations of the coefficients.
+%                   This gives the same results as calling
+%                   spherHarmonicEval and spherHarmonicCov, but if the
+%                   compiled C++ implementation exists, the associated
+%                   Legendre functions and trigonometric terms at each
+%                   point are only computed once and used for both.
+%
+%INPUTS: C, S   ClusterSet classes holding the coefficients of the model,
+%               as in spherHarmonicEval.
+%  CStdDev, SStdDev ClusterSet classes holding the standard deviations of
+%               the coefficients in C and S, as in spherHarmonicCov. These
+%               must have the same number of clusters as C and S.
+%       point   The 3XN set of N points at which the potential and
+%               gradient should be evaluated given in SPHERICAL, ECEF
+%               coordinates consisting of [r;azimuth;elevation], or the
+%               2XN set of [azimuth;elevation] for terrain heights, as in
+%               spherHarmonicEval.
+% a, c, fullyNormalized These are the same as in spherHarmonicEval and
+%               have the same defaults. The normalization given by
+%               fullyNormalized applies to the coefficients and to their
+%               standard deviations.
+%    scalFactor An optional scale factor used in computing the normalized
+%               associated Legendre polynomials. The variances are computed
+%               from squares of scaled terms, so scalFactor^2 must not
+%               underflow. The default if omitted is 2^(-500), as in
+%               spherHarmonicCov.
+%    numThreads An optional parameter specifying how many threads the
+%               points are split across when the compiled C++
+%               implementation is used. The default if omitted or an empty
+%               matrix is passed is 1.
+%
+%OUTPUTS: V     The NX1 vector of potentials at the given points.
+%        gradV  The 3XN gradients of the potential at the given points in
+%               Cartesian coordinates.
+%       sigma2  The NX1 vector of variances of the potential at the given
+%               points.
+%        Sigma  The 3X3XN covariance matrices of the gradient of the
+%               potential at the given points.
+%
+%See the comments to spherHarmonicEval and spherHarmonicCov for more
+%information on the series and on the normalization of the coefficients.
+%
+%EXAMPLE:
+%The acceleration due to gravity of EGM2008 to degree 360 and its
+%covariance matrix are found at a point on the surface of the reference
+%ellipsoid.
+% [C,S,a,c,CStdDev,SStdDev]=getEGMGravCoeffs(360,true);
+% pointSpher=ellips2Sphere([0.1;0.2;0]);
+% [~,accel,~,accelCov]=spherHarmonicEvalCov(C,S,CStdDev,SStdDev,pointSpher,a,c);
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+if(nargin<10||isempty(numThreads))
+    numThreads=1;
+end
+
+if(nargin<9)
+    scalFactor=2^(-500);
+end
+
+if(nargin<8)
+    fullyNormalized=true;
+end
+
+if(nargin<7)
+    c=Constants.EGM2008GM;
+end
+
+if(nargin<6)
+    a=Constants.EGM2008SemiMajorAxis;
+end
+
+M=C.numClusters()-1;
+
+if(M<3)
+    error('The coefficients must be provided to at least degree 3. To use a lower degree, one can insert zero coefficients.');
+end
+
+if(CStdDev.numClusters()~=M+1||SStdDev.numClusters()~=M+1||S.numClusters()~=M+1)
+    error('The coefficients and their standard deviations must all have the same maximum degree.');
+end
+
+%%If a compiled C++ implementation does not exist, then just call the
+%%two functions separately.
+if(~exist('spherHarmonicEvalCovCPPInt','file'))
+    [V,gradV]=spherHarmonicEval(C,S,point,a,c,fullyNormalized,scalFactor,numThreads);
+    if(nargout>3)
+        [sigma2,Sigma]=spherHarmonicCov(CStdDev,SStdDev,point,a,c,fullyNormalized,scalFactor,numThreads);
+    else
+        sigma2=spherHarmonicCov(CStdDev,SStdDev,point,a,c,fullyNormalized,scalFactor,numThreads);
+    end
+    return;
+end
+
+numPoints=size(point,2);
+%If we are evaluating terrain heights.
+switch(size(point,1))
+    case 2
+        a=1;
+        c=1;
+        point=[ones(1,numPoints);point(1,:);point(2,:)];
+    case 3
+    otherwise
+        error('Invalid point length');
+end
+
+%If the coefficients are Schmidt semi-normalized, then convert them and
+%their standard deviations to fully normalized ones.
+if(fullyNormalized==false)
+    %Duplicate the input coefficients so that when they are modified, the
+    %orignal values are not changed.
+    C=C.duplicate();
+    S=S.duplicate();
+    CStdDev=CStdDev.duplicate();
+    SStdDev=SStdDev.duplicate();
+
+    for n=0:M
+        k=1/sqrt(1+2*n);
+        for m=0:n
+            C(n+1,m+1)=k*C(n+1,m+1);
+            S(n+1,m+1)=k*S(n+1,m+1);
+            CStdDev(n+1,m+1)=k*CStdDev(n+1,m+1);
+            SStdDev(n+1,m+1)=k*SStdDev(n+1,m+1);
+        end
+    end
+end
+
+%The function expects the format of offsetArray and clusterSizes to be in
+%the native unsigned format of the architecture, not as doubles (the
+%default of Matlab), so convert the types. All of the coefficient sets
+%share the same offsets and sizes.
+switch(systemNumberOfBits())
+    case 32
+        offsetArray=reshape(uint32(C.offsetArray),C.numClusters(),1);
+        clusterSizes=reshape(uint32(C.clusterSizes),C.numClusters(),1);
+    otherwise%Otherwise, assume it is a 64 bit system
+        offsetArray=reshape(uint64(C.offsetArray),C.numClusters(),1);
+        clusterSizes=reshape(uint64(C.clusterSizes),C.numClusters(),1);
+end
+
+if(nargout>3)
+    [V,gradV,sigma2,Sigma]=spherHarmonicEvalCovCPPInt(C.clusterEls,S.clusterEls,CStdDev.clusterEls,SStdDev.clusterEls,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
+else
+    [V,gradV,sigma2]=spherHarmonicEvalCovCPPInt(C.clusterEls,S.clusterEls,CStdDev.clusterEls,SStdDev.clusterEls,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
+end
+
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
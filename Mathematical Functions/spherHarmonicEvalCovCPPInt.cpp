@@ -0,0 +1,152 @@
+/**SPHERHARMONICEVALCOVCPPINT A mex file interface to the C++
+ *                     implementation of the spherical harmonic synthesis
+ *                     algorithm that also computes the variances and
+ *                     covariances associated with the estimates given the
+ *                     standard deviations of the coefficients. Generally,
+ *                     the Matlab function spherHarmonicEvalCov should be
+ *                     called instead of this one, as this function does no
+ *                     input checking and running the function with
+ *                     invalid inputs will crash Matlab.
+ *
+ *Computing the potential with spherHarmonicEvalCPPInt and the variance
+ *with spherHarmonicCovCPPInt recomputes the Legendre functions and the
+ *trigonometric terms at every point twice. This function computes them
+ *once per point and uses them for both.
+ *
+ *The algorithm can be compiled for use in Matlab using the
+ *CompileCLibraries function.
+ *
+ *The function is called in Matlab using the format:
+ *[V,gradV,sigma2,Sigma]=spherHarmonicEvalCovCPPInt(CCoeffs,SCoeffs,CStdDev,SStdDev,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
+ *or using
+ *[V,gradV,sigma2]=spherHarmonicEvalCovCPPInt(CCoeffs,SCoeffs,CStdDev,SStdDev,offsetArray,clusterSizes,point,a,c,scalFactor,numThreads);
+ *if the covariance matrix of the gradient is not desired. All of the
+ *coefficient arrays share the same offsetArray and clusterSizes. The
+ *numThreads input is optional. It is the number of threads across which
+ *the points are split. If omitted, one thread is used.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include"matrix.h"
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "mathFuncs.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    double a,c,scalFactor;
+    double *point;
+    ClusterSetCPP<double> C;
+    ClusterSetCPP<double> S;
+    ClusterSetCPP<double> CStdDev;
+    ClusterSetCPP<double> SStdDev;
+    size_t numPoints, numClust, totalNumEl;
+    size_t numThreads=1;
+    mxArray *VMATLAB, *gradVMATLAB, *sigma2MATLAB;
+    //This variable is only used if nlhs>3. It is set to zero here to
+    //suppress a warning if compiled using -Wconditional-uninitialized.
+    mxArray *SigmaMATLAB=NULL;
+    double *V,*gradV,*sigma2,*Sigma;
+
+    if(nrhs!=10&&nrhs!=11) {
+        mexErrMsgTxt("Wrong number of inputs.");
+    }
+
+    if(nlhs>4) {
+        mexErrMsgTxt("Wrong number of outputs.");
+    }
+
+    numClust=mxGetM(prhs[4]);
+    {
+        size_t M;
+        M=numClust-1;
+        totalNumEl=(M+1)*(M+2)/2;
+    }
+
+    C.clusterEls=(double*)mxGetData(prhs[0]);
+    S.clusterEls=(double*)mxGetData(prhs[1]);
+    CStdDev.clusterEls=(double*)mxGetData(prhs[2]);
+    SStdDev.clusterEls=(double*)mxGetData(prhs[3]);
+
+    C.offsetArray=(size_t*)mxGetData(prhs[4]);
+    C.clusterSizes=(size_t*)mxGetData(prhs[5]);
+    C.numClust=numClust;
+    C.totalNumEl=totalNumEl;
+
+    S.offsetArray=C.offsetArray;
+    S.clusterSizes=C.clusterSizes;
+    S.numClust=numClust;
+    S.totalNumEl=totalNumEl;
+    CStdDev.offsetArray=C.offsetArray;
+    CStdDev.clusterSizes=C.clusterSizes;
+    CStdDev.numClust=numClust;
+    CStdDev.totalNumEl=totalNumEl;
+    SStdDev.offsetArray=C.offsetArray;
+    SStdDev.clusterSizes=C.clusterSizes;
+    SStdDev.numClust=numClust;
+    SStdDev.totalNumEl=totalNumEl;
+
+    //Get the other parameters.
+    checkRealDoubleArray(prhs[6]);
+    point=(double*)mxGetData(prhs[6]);
+    numPoints=mxGetN(prhs[6]);
+    a=getDoubleFromMatlab(prhs[7]);
+    c=getDoubleFromMatlab(prhs[8]);
+    scalFactor=getDoubleFromMatlab(prhs[9]);
+    if(nrhs>10) {
+        numThreads=getSizeTFromMatlab(prhs[10]);
+    }
+
+    //Allocate space for the return values. The gradient is always
+    //computed, because the covariance matrix of the gradient uses it.
+    VMATLAB=mxCreateDoubleMatrix(numPoints, 1,mxREAL);
+    V=(double*)mxGetData(VMATLAB);
+    gradVMATLAB=mxCreateDoubleMatrix(3, numPoints,mxREAL);
+    gradV=(double*)mxGetData(gradVMATLAB);
+    sigma2MATLAB=mxCreateDoubleMatrix(numPoints, 1,mxREAL);
+    sigma2=(double*)mxGetData(sigma2MATLAB);
+
+    if(nlhs>3) {
+        const mwSize dims[3]={3,3,numPoints};
+        SigmaMATLAB=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+        Sigma=(double*)mxGetData(SigmaMATLAB);
+    } else {
+        Sigma=NULL;
+    }
+    spherHarmonicEvalCovCPP(V,gradV,sigma2,Sigma,C,S,CStdDev,SStdDev,point,numPoints,a,c,scalFactor,numThreads);
+
+    plhs[0]=VMATLAB;
+
+    if(nlhs>1) {
+        plhs[1]=gradVMATLAB;
+    } else {
+        mxDestroyArray(gradVMATLAB);
+    }
+    if(nlhs>2) {
+        plhs[2]=sigma2MATLAB;
+    } else {
+        mxDestroyArray(sigma2MATLAB);
+    }
+    if(nlhs>3) {
+        plhs[3]=SigmaMATLAB;
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
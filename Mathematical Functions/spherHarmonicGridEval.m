@@ -0,0 +1,199 @@
+function [V,gradV]=spherHarmonicGridEval(C,S,latRows,lambda0,numLon,a,c,fullyNormalized,scalFactor,numThreads)
+%%SPHERHARMONICGRIDEVAL Evaluate a potential (e.g. gravitational or
+%                    magnetic) and/ or the gradient of a potential
+%                    expressed in terms of spherical harmonic coefficients
+%                    on a grid of points that is regularly spaced in
+%                    longitude. This is much faster than spherHarmonicEval
+%                    when making maps, because the sum over the orders of
+%                    the spherical harmonics for all of the longitudes in a
+%                    row is performed at once using a fast Fourier
+%                    transform. Alternatively, this function can be used to
+%                    evaluate the type of spherical harmonic series used to
+%                    express terrain heights on a grid.
+%
+%INPUTS:    C   A ClusterSet class holding the coefficient terms that are
+%               multiplied by cosines in the harmonic expansion. The format
+%               is the same as in spherHarmonicEval.
+%           S   A ClusterSet class holding the coefficient terms that are
+%               multiplied by sines in the harmonic expansion. The format
+%               is the same as in spherHarmonicEval.
+%     latRows A 2XnumRows matrix where each column is the [r;elevation]
+%               (range and latitude in spherical coordinates) of a row of
+%               the grid. The range can vary from row to row, for example
+%               to follow the surface of a reference ellipsoid.
+%               Alternatively, if C and S are for evaluating terrain
+%               heights, then latRows is 1XnumRows and just holds the
+%               elevations.
+%     lambda0 The azimuth (longitude) in radians of the first point of
+%               each row. If omitted or an empty matrix is passed, zero is
+%               used.
+%      numLon The number of points in each row. The azimuths of the
+%               points are lambda0+2*pi*(0:(numLon-1))/numLon; the grid
+%               must cover the full circle. Any positive integer can be
+%               used, though powers of two are fastest.
+%   a, c, fullyNormalized, scalFactor These optional parameters are the
+%               same as in spherHarmonicEval and have the same defaults.
+%  numThreads The number of threads across which the rows are split. If
+%               omitted or an empty matrix is passed, one thread is used.
+%               If zero, the number of hardware threads is used.
+%
+%OUTPUTS: V     A numLonXnumRows matrix of the potential at the points
+%               of the grid. V(k,i) corresponds to azimuth
+%               lambda0+2*pi*(k-1)/numLon in row i.
+%      gradV    A 3XnumLonXnumRows matrix of the gradient of the potential
+%               in Cartesian coordinates at the points of the grid.
+%
+%In the algorithm of Holmes and Featherstone used by spherHarmonicEval,
+%the lumped coefficients for each order only depend on the range and the
+%latitude, and the potential at a given longitude is a Fourier series in
+%the longitude with those coefficients. Thus, for each row, the lumped
+%coefficients are computed once and the Fourier series is evaluated at
+%all numLon longitudes using a fast Fourier transform. Orders above numLon
+%are aliased, which is exact as the grid covers the full circle. This
+%reduces the cost of each row from O(M*numLon) to O(numLon*log(numLon))
+%beyond the O(M^2) needed to get the lumped coefficients, where M is the
+%maximum degree. When the gradient is desired, rows within 2 degrees of
+%the poles are evaluated as in spherHarmonicEval.
+%
+%EXAMPLE:
+%Here, the geoid undulation due to the EGM2008 disturbing potential is
+%mapped to degree 360 on a 1 degree grid using the spherical
+%approximation N=T/gamma with gamma=GM/r^2. The result is the same as
+%evaluating the points individually with spherHarmonicEval.
+% M=360;
+% [C,S]=getEGMGravCoeffs(M,true);
+% C(0+1,0+1)=0;
+% C(2+1,0+1)=0;
+% lat=(-89:89)*(pi/180);
+% r=Constants.EGM2008SemiMajorAxis*ones(size(lat));
+% numLon=360;
+% V=spherHarmonicGridEval(C,S,[r;lat],0,numLon);
+% N=V.*(r.^2/Constants.EGM2008GM);
+% lon=(0:(numLon-1))*(360/numLon);
+% figure(1)
+% clf
+% imagesc(lon,lat*(180/pi),N.')
+% set(gca,'YDir','normal')
+% colorbar()
+%
+%If the helper function spherHarmonicGridEvalCPPInt has not been compiled,
+%then the points of the grid are evaluated using spherHarmonicEval.
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+if(nargin<10||isempty(numThreads))
+    numThreads=1;
+end
+
+if(nargin<9||isempty(scalFactor))
+    scalFactor=10^(-280);
+end
+
+if(nargin<8||isempty(fullyNormalized))
+    fullyNormalized=true;
+end
+
+if(nargin<7||isempty(c))
+    c=Constants.EGM2008GM;
+end
+
+if(nargin<6||isempty(a))
+    a=Constants.EGM2008SemiMajorAxis;
+end
+
+if(nargin<4||isempty(lambda0))
+    lambda0=0;
+end
+
+M=C.numClusters()-1;
+
+if(M<3)
+    error('The coefficients must be provided to at least degree 3. To use a lower degree, one can insert zero coefficients.');
+end
+
+if(numLon<1||numLon~=fix(numLon))
+    error('numLon must be a positive integer.');
+end
+
+numRows=size(latRows,2);
+%If we are evaluating terrain heights.
+switch(size(latRows,1))
+    case 1
+        a=1;
+        c=1;
+        latRows=[ones(1,numRows);latRows];
+    case 2
+    otherwise
+        error('Invalid latRows size');
+end
+
+if(exist('spherHarmonicGridEvalCPPInt','file'))
+    %The coefficients are normalized in the same manner as in
+    %spherHarmonicEval.
+    if(fullyNormalized==false)
+        C=C.duplicate();
+        S=S.duplicate();
+
+        for n=0:M
+            k=1/sqrt(1+2*n);
+            for m=0:n
+                C(n+1,m+1)=k*C(n+1,m+1);
+                S(n+1,m+1)=k*S(n+1,m+1);
+            end
+        end
+    end
+
+    switch(systemNumberOfBits())
+        case 32
+            C.offsetArray=reshape(uint32(C.offsetArray),C.numClusters(),1);
+            C.clusterSizes=reshape(uint32(C.clusterSizes),C.numClusters(),1);
+        otherwise%Otherwise, assume it is a 64 bit system
+            C.offsetArray=reshape(uint64(C.offsetArray),C.numClusters(),1);
+            C.clusterSizes=reshape(uint64(C.clusterSizes),C.numClusters(),1);
+    end
+
+    if(nargout==2)
+        [V,gradV]=spherHarmonicGridEvalCPPInt(C.clusterEls,S.clusterEls,C.offsetArray,C.clusterSizes,latRows,lambda0,numLon,a,c,scalFactor,numThreads);
+    else
+        V=spherHarmonicGridEvalCPPInt(C.clusterEls,S.clusterEls,C.offsetArray,C.clusterSizes,latRows,lambda0,numLon,a,c,scalFactor,numThreads);
+    end
+    return
+end
+
+%Without the compiled code, the points of the grid are evaluated
+%individually. Each row has a constant range and latitude, so the lumped
+%coefficients are still only computed once per row.
+lambda=lambda0+2*pi*(0:(numLon-1))/numLon;
+points=zeros(3,numLon,numRows);
+points(1,:,:)=repmat(reshape(latRows(1,:),[1,1,numRows]),[1,numLon,1]);
+points(2,:,:)=repmat(lambda,[1,1,numRows]);
+points(3,:,:)=repmat(reshape(latRows(2,:),[1,1,numRows]),[1,numLon,1]);
+points=reshape(points,3,numLon*numRows);
+
+if(nargout==2)
+    [V,gradV]=spherHarmonicEval(C,S,points,a,c,fullyNormalized,scalFactor,numThreads);
+    gradV=reshape(gradV,3,numLon,numRows);
+else
+    V=spherHarmonicEval(C,S,points,a,c,fullyNormalized,scalFactor,numThreads);
+end
+V=reshape(V,numLon,numRows);
+
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
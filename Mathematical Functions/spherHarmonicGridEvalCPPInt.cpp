@@ -0,0 +1,128 @@
+/**SPHERHARMONICGRIDEVALCPPINT A mex file interface to the C++
+ *                     implementation of spherical harmonic synthesis on a
+ *                     grid that is regularly spaced in longitude.
+ *                     Generally, the Matlab function spherHarmonicGridEval
+ *                     should be called instead of this one, as this
+ *                     function does little input checking and running the
+ *                     function with invalid inputs will crash Matlab.
+ *
+ *As with spherHarmonicEvalCPPInt, the individual elements of the
+ *ClusterSet classes for the coefficients are passed so that Matlab does
+ *not make copies of the coefficients.
+ *
+ *The algorithm can be compiled for use in Matlab using the
+ *CompileCLibraries function.
+ *
+ *The function is called in Matlab using the format:
+ *[V,gradV]=spherHarmonicGridEvalCPPInt(CCoeffs,SCoeffs,offsetArray,clusterSizes,rLat,lambda0,numLon,a,c,scalFactor,numThreads);
+ *or using
+ *[V]=spherHarmonicGridEvalCPPInt(CCoeffs,SCoeffs,offsetArray,clusterSizes,rLat,lambda0,numLon,a,c,scalFactor,numThreads);
+ *if one only wants the potential. rLat is a 2XnumRows matrix of the
+ *ranges and latitudes of the rows of the grid. The longitudes in each row
+ *are lambda0+2*pi*(0:(numLon-1))/numLon. V is returned as a numLonXnumRows
+ *matrix and gradV as a 3XnumLonXnumRows matrix.
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include"matrix.h"
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "mathFuncs.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    double a,c,scalFactor,lambda0;
+    double *rLat;
+    ClusterSetCPP<double> C;
+    ClusterSetCPP<double> S;
+    size_t numRows,numLon,numThreads;
+    mxArray *VMATLAB;
+    //This variable is only used if nlhs>1. It is set to zero here to
+    //suppress a warning if compiled using -Wconditional-uninitialized.
+    mxArray *gradVMATLAB=NULL;
+    double *V,*gradV;
+
+    if(nrhs!=11) {
+        mexErrMsgTxt("Wrong number of inputs.");
+    }
+
+    if(nlhs>2) {
+        mexErrMsgTxt("Too many outputs.");
+    }
+
+    C.clusterEls=(double*)mxGetData(prhs[0]);
+    S.clusterEls=(double*)mxGetData(prhs[1]);
+
+    C.offsetArray=(size_t*)mxGetData(prhs[2]);
+    C.clusterSizes=(size_t*)mxGetData(prhs[3]);
+    S.offsetArray=C.offsetArray;
+    S.clusterSizes=C.clusterSizes;
+
+    C.numClust=mxGetM(prhs[2]);
+    S.numClust=C.numClust;
+    {
+        size_t M;
+        M=C.numClust-1;
+        C.totalNumEl=(M+1)*(M+2)/2;
+    }
+    S.totalNumEl=C.totalNumEl;
+
+    //Get the other parameters.
+    checkRealDoubleArray(prhs[4]);
+    if(mxGetM(prhs[4])!=2) {
+        mexErrMsgTxt("rLat must have two rows.");
+    }
+    rLat=(double*)mxGetData(prhs[4]);
+    numRows=mxGetN(prhs[4]);
+    lambda0=getDoubleFromMatlab(prhs[5]);
+    numLon=getSizeTFromMatlab(prhs[6]);
+    if(numLon==0) {
+        mexErrMsgTxt("numLon must be positive.");
+    }
+    a=getDoubleFromMatlab(prhs[7]);
+    c=getDoubleFromMatlab(prhs[8]);
+    scalFactor=getDoubleFromMatlab(prhs[9]);
+    numThreads=getSizeTFromMatlab(prhs[10]);
+
+    //Allocate space for the return values
+    VMATLAB=mxCreateDoubleMatrix(numLon,numRows,mxREAL);
+    V=(double*)mxGetData(VMATLAB);
+
+    if(nlhs>1) {
+        mwSize dims[3];
+
+        dims[0]=3;
+        dims[1]=numLon;
+        dims[2]=numRows;
+        gradVMATLAB=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+        gradV=(double*)mxGetData(gradVMATLAB);
+    } else {
+        gradV=NULL;
+    }
+    spherHarmonicGridEvalCPP(V,gradV,C,S,rLat,numRows,lambda0,numLon,a,c,scalFactor,numThreads);
+
+    plhs[0]=VMATLAB;
+
+    if(nlhs>1) {
+        plhs[1]=gradVMATLAB;
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,273 @@
+classdef spherHarmonicModel < handle
+%%SPHERHARMONICMODEL A class holding a set of spherical harmonic
+%                    coefficients (e.g. for a gravitational or magnetic
+%                    model) so that the potential and its derivatives can be
+%                    evaluated many times without the overhead of
+%                    preparing the coefficients on every call. If a C++
+%                    class interface has been compiled, then the
+%                    coefficients are copied to C++ once when the model is
+%                    created. Otherwise, the evaluate method calls
+%                    spherHarmonicEval.
+%
+%Every call to spherHarmonicEval passes all of the coefficients to the
+%compiled code, possibly renormalizes them, and allocates and initializes
+%work buffers. For high-degree models such as EGM2008, that is a lot of
+%memory per call and can dominate the cost when only a few points are
+%evaluated at a time, such as when computing the acceleration due to
+%gravity at every step of an orbit propagation in a tracking filter. This
+%class does that work once.
+%
+%Far from the reference sphere, such as at orbital altitudes, the (a/r)^n
+%factors make the high-degree terms negligible. If a relative tolerance
+%relTol>0 is given, then the C++ implementation truncates the series at
+%each point at the lowest degree for which the neglected terms are within
+%relTol of the largest term. Terms of degree n are weighted by (n+1) when
+%the gradient is requested and by (n+1)*(n+2) when the Hessian is
+%requested. The error bound is on the root mean square error over the
+%sphere at the given range, not on the error at each point. This can
+%make propagating orbits with high-degree models much faster. If the C++
+%implementation does not exist, all degrees are always used.
+%
+%A model can also be created from a binary coefficient file written by
+%writeSpherHarmonicCoeffFile. With the C++ implementation, the file is
+%memory mapped, so creating a model of the full EGM2008 takes almost no
+%time and the coefficients are never copied into memory.
+%
+%Note that if the C++ implementation is used, the mex file is locked when a
+%spherHarmonicModel object is created and is not unlocked (and able to be
+%recompiled) until all of the spherHarmonicModel objects have been freed.
+%
+%EXAMPLE:
+%Here, the acceleration due to gravity of EGM2008 to degree 360 is
+%evaluated at a number of points, one at a time, as would be done in a
+%propagation.
+% [C,S]=getEGMGravCoeffs(360,true);
+% %Truncate the series where the neglected terms are below 1e-12 of the
+% %largest.
+% model=spherHarmonicModel(C,S,[],[],[],[],1e-12);
+% numPoints=100;
+% accel=zeros(3,numPoints);
+% for curPoint=1:numPoints
+%     pointSpher=[Constants.EGM2008SemiMajorAxis+1e5*curPoint;0.01*curPoint;0.005*curPoint];
+%     [~,accel(:,curPoint)]=model.evaluate(pointSpher);
+% end
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+properties(SetAccess=private)
+    M%The maximum degree of the model.
+    a%The numerator in the (a/r)^n term.
+    c%The constant by which the series is multiplied.
+    scalFactor%The scale factor used in the Legendre recursion.
+    relTol%The relative tolerance used to truncate the series.
+end
+
+properties(Access=private)
+    %These are only used if the C++ implementation does not exist.
+    C
+    S
+    CPPData%Only used if an interface to a C++ implementation exists.
+end
+
+methods
+    function newModel=spherHarmonicModel(C,S,a,c,fullyNormalized,scalFactor,relTol)
+    %%SPHERHARMONICMODEL Create a new spherical harmonic model from a set
+    %                    of coefficients.
+    %
+    %INPUTS: C, S, a, c, fullyNormalized, scalFactor These are the same as
+    %           in spherHarmonicEval and have the same defaults. To
+    %           evaluate terrain heights, use a=1 and c=1. Alternatively,
+    %           C can be the name of a coefficient file written by
+    %           writeSpherHarmonicCoeffFile, in which case S, a, c and
+    %           fullyNormalized are ignored and empty matrices can be
+    %           passed for them. The values of a and c are taken from the
+    %           file. If the C++ implementation exists, the file is memory
+    %           mapped and the coefficients are not copied. Otherwise, the
+    %           file is read with readSpherHarmonicCoeffFile.
+    %    relTol The optional nonnegative relative tolerance used to
+    %           choose the maximum degree of the series at each point.
+    %           The default if omitted or an empty matrix is passed is 0,
+    %           meaning that all degrees are used.
+    %
+    %OUTPUTS: newModel A new spherHarmonicModel instance. The coefficients
+    %                  are copied, so C and S can be changed afterward
+    %                  without affecting the model.
+
+        if(nargin<7||isempty(relTol))
+            relTol=0;
+        end
+
+        if(nargin<6||isempty(scalFactor))
+            scalFactor=10^(-280);
+        end
+
+        if(nargin<5||isempty(fullyNormalized))
+            fullyNormalized=true;
+        end
+
+        if(nargin<4||isempty(c))
+            c=Constants.EGM2008GM;
+        end
+
+        if(nargin<3||isempty(a))
+            a=Constants.EGM2008SemiMajorAxis;
+        end
+
+        %If the coefficients are in a file.
+        if(ischar(C))
+            fileName=C;
+            newModel.scalFactor=scalFactor;
+            newModel.relTol=relTol;
+            if(exist('spherHarmonicModelCPPInt','file'))
+                [newModel.CPPData,M,a,c]=spherHarmonicModelCPPInt('spherHarmonicModelFromFileCPP',fileName,scalFactor);
+                newModel.M=double(M);
+                newModel.a=a;
+                newModel.c=c;
+                if(relTol~=0)
+                    spherHarmonicModelCPPInt('setRelTol',newModel.CPPData,relTol);
+                end
+                return;
+            end
+
+            %Coefficient files always hold fully normalized coefficients.
+            [C,S,a,c]=readSpherHarmonicCoeffFile(fileName);
+            fullyNormalized=true;
+        end
+
+        M=C.numClusters()-1;
+
+        if(M<3)
+            error('The coefficients must be provided to at least degree 3. To use a lower degree, one can insert zero coefficients.');
+        end
+
+        newModel.M=M;
+        newModel.a=a;
+        newModel.c=c;
+        newModel.scalFactor=scalFactor;
+        newModel.relTol=relTol;
+
+        %The coefficients are normalized in the same manner as in
+        %spherHarmonicEval.
+        if(fullyNormalized==false)
+            C=C.duplicate();
+            S=S.duplicate();
+
+            for n=0:M
+                k=1/sqrt(1+2*n);
+                for m=0:n
+                    C(n+1,m+1)=k*C(n+1,m+1);
+                    S(n+1,m+1)=k*S(n+1,m+1);
+                end
+            end
+        end
+
+        if(exist('spherHarmonicModelCPPInt','file'))
+            newModel.CPPData=spherHarmonicModelCPPInt('spherHarmonicModelCPP',C.clusterEls,S.clusterEls,M,a,c,scalFactor);
+            if(relTol~=0)
+                spherHarmonicModelCPPInt('setRelTol',newModel.CPPData,relTol);
+            end
+        else
+            %The coefficients are already normalized.
+            newModel.C=C.duplicate();
+            newModel.S=S.duplicate();
+        end
+    end
+
+    function [V,gradV,HessV]=evaluate(theModel,point,numThreads)
+    %%EVALUATE Evaluate the potential and, if requested, its gradient and
+    %          Hessian at a set of points.
+    %
+    %INPUTS: theModel The spherHarmonicModel instance.
+    %           point The 3XN set of points in spherical ECEF coordinates
+    %                 [r;azimuth;elevation] or, for terrain heights, the
+    %                 2XN set of [azimuth;elevation], in which case the
+    %                 model should have been created with a=1 and c=1.
+    %      numThreads The optional number of threads across which the
+    %                 points are split, as in spherHarmonicEval. The
+    %                 default if omitted or an empty matrix is passed is 1.
+    %
+    %OUTPUTS: V, gradV, HessV The potential and the gradient and Hessian of
+    %                  the potential in Cartesian coordinates, as in
+    %                  spherHarmonicEval.
+
+        if(nargin<3||isempty(numThreads))
+            numThreads=1;
+        end
+
+        numPoints=size(point,2);
+        switch(size(point,1))
+            case 2
+                point=[ones(1,numPoints);point(1,:);point(2,:)];
+            case 3
+            otherwise
+                error('Invalid point length');
+        end
+
+        if(exist('spherHarmonicModelCPPInt','file'))
+            if(nargout==3)
+                [V,gradV,HessV]=spherHarmonicModelCPPInt('evaluate',theModel.CPPData,point,numThreads);
+            elseif(nargout==2)
+                [V,gradV]=spherHarmonicModelCPPInt('evaluate',theModel.CPPData,point,numThreads);
+            else
+                V=spherHarmonicModelCPPInt('evaluate',theModel.CPPData,point,numThreads);
+            end
+        else
+            if(nargout==3)
+                [V,gradV,HessV]=spherHarmonicEval(theModel.C,theModel.S,point,theModel.a,theModel.c,true,theModel.scalFactor,numThreads);
+            elseif(nargout==2)
+                [V,gradV]=spherHarmonicEval(theModel.C,theModel.S,point,theModel.a,theModel.c,true,theModel.scalFactor,numThreads);
+            else
+                V=spherHarmonicEval(theModel.C,theModel.S,point,theModel.a,theModel.c,true,theModel.scalFactor,numThreads);
+            end
+        end
+    end
+
+    function setRelTol(theModel,relTol)
+    %%SETRELTOL Set the relative tolerance used to choose the maximum
+    %           degree of the series at each point.
+    %
+    %INPUTS: theModel The spherHarmonicModel instance.
+    %          relTol The nonnegative relative tolerance. A value of 0
+    %                 means that all degrees are used.
+    %
+    %OUTPUTS: None. The model is modified.
+
+        if(~(relTol>=0))
+            error('The relative tolerance must be nonnegative.');
+        end
+
+        theModel.relTol=relTol;
+        if(exist('spherHarmonicModelCPPInt','file'))
+            spherHarmonicModelCPPInt('setRelTol',theModel.CPPData,relTol);
+        end
+    end
+
+    function delete(theModel)
+    %%DELETE The destructor method. This method is used when the model is
+    %        implemented as a C++ class. This method prevents a memory
+    %        leak.
+
+        if(exist('spherHarmonicModelCPPInt','file')&&~isempty(theModel.CPPData))
+            spherHarmonicModelCPPInt('~spherHarmonicModelCPP',theModel.CPPData);
+        end
+    end
+end
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
@@ -0,0 +1,224 @@
+/**SPHERHARMONICMODELCPPINT An interface between the Matlab
+ *              spherHarmonicModel class and the C++
+ *              SpherHarmonicModelCPP class, which holds a spherical
+ *              harmonic model that has been loaded once so that it can be
+ *              evaluated repeatedly without passing the coefficients to
+ *              C++ on every call. This function is meant to be called by
+ *              the spherHarmonicModel class in Matlab; not directly by
+ *              the user. Running the function with invalid inputs can
+ *              crash Matlab.
+ *
+ *The function is called as
+ *CPPData=spherHarmonicModelCPPInt('spherHarmonicModelCPP',CCoeffs,SCoeffs,M,a,c,scalFactor);
+ *where CCoeffs and SCoeffs are the clusterEls members of the ClusterSet
+ *classes holding fully normalized coefficients up to degree M,
+ *or
+ *[CPPData,M,a,c]=spherHarmonicModelCPPInt('spherHarmonicModelFromFileCPP',fileName,scalFactor);
+ *where fileName is a coefficient file written by
+ *writeSpherHarmonicCoeffFile, which is memory mapped rather than copied,
+ *or
+ *[V,gradV,HessV]=spherHarmonicModelCPPInt('evaluate',CPPData,point,numThreads);
+ *where point is 3XnumPoints and gradV and HessV are optional. HessV is
+ *3X3XnumPoints,
+ *or
+ *spherHarmonicModelCPPInt('setRelTol',CPPData,relTol);
+ *where relTol is the relative tolerance used to choose the maximum degree
+ *at each point (zero means use all degrees),
+ *or
+ *M=spherHarmonicModelCPPInt('getM',CPPData);
+ *or
+ *spherHarmonicModelCPPInt('~spherHarmonicModelCPP',CPPData);
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+//For strcmp
+#include <cstring>
+//For make_shared
+#include <memory>
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "spherHarmonicModelCPP.hpp"
+
+void mexFunction(const int nlhs, mxArray *plhs[], const int nrhs, const mxArray *prhs[]) {
+    char cmd[64];
+    SpherHarmonicModelCPP *theModel;
+
+    if(nrhs<2) {
+        mexErrMsgTxt("Not enough inputs.");
+    }
+
+    if(nrhs>7) {
+        mexErrMsgTxt("Too many inputs.");
+    }
+
+    //Get the command string that is passed.
+    mxGetString(prhs[0], cmd, sizeof(cmd));
+
+    if(!strcmp("spherHarmonicModelCPP", cmd)) {
+        size_t M, numCoeffs;
+        double a, c, scalFactor;
+
+        if(nrhs!=7) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        checkRealDoubleArray(prhs[1]);
+        checkRealDoubleArray(prhs[2]);
+        M=getSizeTFromMatlab(prhs[3]);
+        a=getDoubleFromMatlab(prhs[4]);
+        c=getDoubleFromMatlab(prhs[5]);
+        scalFactor=getDoubleFromMatlab(prhs[6]);
+
+        numCoeffs=(M+1)*(M+2)/2;
+        if(mxGetNumberOfElements(prhs[1])!=numCoeffs||mxGetNumberOfElements(prhs[2])!=numCoeffs) {
+            mexErrMsgTxt("The number of coefficients does not match the maximum degree.");
+        }
+
+        theModel=new SpherHarmonicModelCPP((double*)mxGetData(prhs[1]),(double*)mxGetData(prhs[2]),M,a,c,scalFactor);
+
+        //Lock this mex file so that it can not be cleared until the object
+        //has been deleted (This avoids a memory leak).
+        mexLock();
+        //Return the pointer to the model.
+        plhs[0]=ptr2Matlab<SpherHarmonicModelCPP*>(theModel);
+    } else if(!strcmp("spherHarmonicModelFromFileCPP", cmd)) {
+        std::shared_ptr<SpherHarmonicCoeffFileCPP> coeffFile;
+        char *fileName;
+        double scalFactor;
+        int retVal;
+
+        if(nrhs!=3) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>4) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        if(!mxIsChar(prhs[1])) {
+            mexErrMsgTxt("The file name must be a string.");
+        }
+        scalFactor=getDoubleFromMatlab(prhs[2]);
+
+        fileName=mxArrayToString(prhs[1]);
+        coeffFile=std::make_shared<SpherHarmonicCoeffFileCPP>();
+        retVal=coeffFile->open(fileName);
+        mxFree(fileName);
+        if(retVal!=SPHER_HARMONIC_COEFF_OK) {
+            mexErrMsgTxt(SpherHarmonicCoeffFileCPP::errorString(retVal));
+        }
+
+        theModel=new SpherHarmonicModelCPP(coeffFile,scalFactor);
+
+        //Lock this mex file so that it can not be cleared until the object
+        //has been deleted (This avoids a memory leak).
+        mexLock();
+        plhs[0]=ptr2Matlab<SpherHarmonicModelCPP*>(theModel);
+        if(nlhs>1) {
+            plhs[1]=unsignedSizeMat2Matlab(&(theModel->M),1,1);
+        }
+        if(nlhs>2) {
+            plhs[2]=doubleMat2Matlab(&(theModel->a),1,1);
+        }
+        if(nlhs>3) {
+            plhs[3]=doubleMat2Matlab(&(theModel->c),1,1);
+        }
+    } else if(!strcmp("evaluate", cmd)) {
+        size_t numPoints, numThreads;
+        double *point, *V, *gradV, *HessV;
+        mxArray *VMATLAB;
+        //This variable is only used if nlhs>1. It is set to zero here to
+        //suppress a warning if compiled using -Wconditional-uninitialized.
+        mxArray *gradVMATLAB=NULL;
+        mxArray *HessVMATLAB=NULL;
+
+        if(nrhs!=4) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        if(nlhs>3) {
+            mexErrMsgTxt("Too many outputs.");
+        }
+
+        theModel=Matlab2Ptr<SpherHarmonicModelCPP*>(prhs[1]);
+
+        checkRealDoubleArray(prhs[2]);
+        if(mxGetM(prhs[2])!=3) {
+            mexErrMsgTxt("The points must be 3-dimensional.");
+        }
+        point=(double*)mxGetData(prhs[2]);
+        numPoints=mxGetN(prhs[2]);
+        numThreads=getSizeTFromMatlab(prhs[3]);
+
+        //Allocate space for the return values
+        VMATLAB=mxCreateDoubleMatrix(numPoints,1,mxREAL);
+        V=(double*)mxGetData(VMATLAB);
+        if(nlhs>1) {
+            gradVMATLAB=mxCreateDoubleMatrix(3,numPoints,mxREAL);
+            gradV=(double*)mxGetData(gradVMATLAB);
+        } else {
+            gradV=NULL;
+        }
+        if(nlhs>2) {
+            const mwSize dims[3]={3,3,numPoints};
+            HessVMATLAB=mxCreateNumericArray(3,dims,mxDOUBLE_CLASS,mxREAL);
+            HessV=(double*)mxGetData(HessVMATLAB);
+        } else {
+            HessV=NULL;
+        }
+
+        theModel->evaluate(V,gradV,HessV,point,numPoints,numThreads);
+
+        plhs[0]=VMATLAB;
+        if(nlhs>1) {
+            plhs[1]=gradVMATLAB;
+        }
+        if(nlhs>2) {
+            plhs[2]=HessVMATLAB;
+        }
+    } else if(!strcmp("setRelTol", cmd)) {
+        double relTol;
+
+        if(nrhs!=3) {
+            mexErrMsgTxt("Wrong number of inputs.");
+        }
+
+        theModel=Matlab2Ptr<SpherHarmonicModelCPP*>(prhs[1]);
+        relTol=getDoubleFromMatlab(prhs[2]);
+        if(!(relTol>=0)) {
+            mexErrMsgTxt("The relative tolerance must be nonnegative.");
+        }
+        theModel->setRelTol(relTol);
+    } else if(!strcmp("getM", cmd)) {
+        theModel=Matlab2Ptr<SpherHarmonicModelCPP*>(prhs[1]);
+        plhs[0]=unsignedSizeMat2Matlab(&(theModel->M),1,1);
+    } else if(!strcmp("~spherHarmonicModelCPP", cmd)) {
+        theModel=Matlab2Ptr<SpherHarmonicModelCPP*>(prhs[1]);
+
+        delete theModel;
+        //Unlock the mex file allowing it to be cleared.
+        mexUnlock();
+    } else {
+        mexErrMsgTxt("Invalid string passed to spherHarmonicModelCPPInt.");
+    }
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,100 @@
+function writeSpherHarmonicCoeffFile(fileName,C,S,a,c,CAux,SAux,auxType,refEpoch)
+%%WRITESPHERHARMONICCOEFFFILE Write a set of fully normalized spherical
+%                   harmonic coefficients to a binary file that can be
+%                   read quickly with readSpherHarmonicCoeffFile or memory
+%                   mapped by spherHarmonicModel. Loading large models,
+%                   such as EGM2008, from text or .mat files is slow and
+%                   requires that all of the coefficients be held in
+%                   memory. A memory-mapped coefficient file is opened
+%                   almost instantly and only the parts that are used are
+%                   read from disk.
+%
+%INPUTS: fileName The name of the file to write.
+%           C, S  ClusterSet classes holding the fully normalized
+%                 coefficients, as in spherHarmonicEval. C and S must have
+%                 the same maximum degree.
+%           a, c  The numerator in the (a/r)^n term and the constant by
+%                 which the series is multiplied, as in spherHarmonicEval.
+%      CAux, SAux An optional pair of ClusterSet classes holding the
+%                 standard deviations or the rates of change of C and S.
+%                 These can have a lower maximum degree than C and S.
+%                 These can be omitted or empty matrices passed if there
+%                 are no auxiliary coefficients.
+%         auxType If CAux and SAux are given, this indicates what they
+%                 are. Possible values are
+%                 1 (The default if omitted or an empty matrix is passed)
+%                   The standard deviations of the coefficients.
+%                 2 The rates of change of the coefficients per year.
+%        refEpoch The reference epoch of the coefficients, such as a
+%                 decimal year for which the rates in CAux and SAux are
+%                 defined. The default if omitted or an empty matrix is
+%                 passed is 0.
+%
+%OUTPUTS: None. The file is written.
+%
+%The file is written in the native byte order of the machine and holds
+%the coefficients stored by degree (as in ClusterSet classes) followed by
+%order-major copies of C and S that the compiled spherical harmonic code
+%uses directly. The format is described in spherHarmonicCoeffFileCPP.hpp.
+%This function requires that the C++ code has been compiled with
+%CompileCLibraries.
+%
+%EXAMPLE:
+%The full EGM2008 model with its standard deviations is written to a file
+%and a model is then created from the file.
+% [C,S,a,c,CStdDev,SStdDev]=getEGMGravCoeffs();
+% writeSpherHarmonicCoeffFile('EGM2008.shc',C,S,a,c,CStdDev,SStdDev);
+% model=spherHarmonicModel('EGM2008.shc');
+%
+%(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.
+
+if(nargin<9||isempty(refEpoch))
+    refEpoch=0;
+end
+
+if(nargin<8||isempty(auxType))
+    auxType=1;
+end
+
+if(nargin<6)
+    CAux=[];
+    SAux=[];
+end
+
+if(~exist('writeSpherHarmonicCoeffFileCPPInt','file'))
+    error('Writing coefficient files requires the compiled C++ code. Run CompileCLibraries.');
+end
+
+M=C.numClusters()-1;
+if(S.numClusters()~=M+1)
+    error('C and S must have the same maximum degree.');
+end
+
+if(isempty(CAux))
+    writeSpherHarmonicCoeffFileCPPInt(fileName,C.clusterEls(:),S.clusterEls(:),M,a,c);
+else
+    MAux=CAux.numClusters()-1;
+    if(SAux.numClusters()~=MAux+1)
+        error('CAux and SAux must have the same maximum degree.');
+    end
+    writeSpherHarmonicCoeffFileCPPInt(fileName,C.clusterEls(:),S.clusterEls(:),M,a,c,CAux.clusterEls(:),SAux.clusterEls(:),MAux,auxType,refEpoch);
+end
+end
+
+%LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.
@@ -0,0 +1,127 @@
+/**WRITESPHERHARMONICCOEFFFILECPPINT A mex file interface to the C++
+ *                     function that writes a binary file of spherical
+ *                     harmonic coefficients that can be memory mapped.
+ *                     Generally, the Matlab function
+ *                     writeSpherHarmonicCoeffFile should be called instead
+ *                     of this one, as this function does little input
+ *                     checking and running the function with invalid
+ *                     inputs can crash Matlab.
+ *
+ *The function is called in Matlab using the format:
+ *writeSpherHarmonicCoeffFileCPPInt(fileName,CCoeffs,SCoeffs,M,a,c);
+ *or using
+ *writeSpherHarmonicCoeffFileCPPInt(fileName,CCoeffs,SCoeffs,M,a,c,CAuxCoeffs,SAuxCoeffs,MAux,auxType,refEpoch);
+ *where CCoeffs and SCoeffs are the clusterEls members of ClusterSet
+ *classes holding fully normalized coefficients up to degree M and
+ *CAuxCoeffs and SAuxCoeffs are the clusterEls members of ClusterSet
+ *classes up to degree MAux<=M holding standard deviations (auxType=1) or
+ *rates of change (auxType=2).
+ */
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "mex.h"
+/* This header validates inputs and includes a header needed to handle
+ * Matlab matrices.*/
+#include "MexValidation.h"
+#include "spherHarmonicCoeffFileCPP.hpp"
+#include <vector>
+
+static void makeDegreeClusterSet(ClusterSetCPP<double> &dest, std::vector<size_t> &offsetArray, std::vector<size_t> &clusterSizes, const mxArray *coeffs, const size_t M);
+
+void mexFunction(const int nlhs, mxArray *[], const int nrhs, const mxArray *prhs[]) {
+    std::vector<size_t> offsetArray, clusterSizes;
+    ClusterSetCPP<double> C, S, CAux, SAux;
+    size_t M, MAux;
+    uint32_t auxType=SPHER_HARMONIC_COEFF_AUX_NONE;
+    double a, c, refEpoch=0;
+    char *fileName;
+    int retVal;
+
+    if(nrhs!=6&&nrhs!=11) {
+        mexErrMsgTxt("Wrong number of inputs.");
+    }
+
+    if(nlhs>0) {
+        mexErrMsgTxt("Wrong number of outputs.");
+    }
+
+    if(!mxIsChar(prhs[0])) {
+        mexErrMsgTxt("The file name must be a string.");
+    }
+
+    M=getSizeTFromMatlab(prhs[3]);
+    a=getDoubleFromMatlab(prhs[4]);
+    c=getDoubleFromMatlab(prhs[5]);
+    makeDegreeClusterSet(C,offsetArray,clusterSizes,prhs[1],M);
+    makeDegreeClusterSet(S,offsetArray,clusterSizes,prhs[2],M);
+
+    if(nrhs>6) {
+        MAux=getSizeTFromMatlab(prhs[8]);
+        if(MAux>M) {
+            mexErrMsgTxt("The auxiliary coefficients can not have a higher degree than C and S.");
+        }
+        makeDegreeClusterSet(CAux,offsetArray,clusterSizes,prhs[6],MAux);
+        makeDegreeClusterSet(SAux,offsetArray,clusterSizes,prhs[7],MAux);
+        auxType=static_cast<uint32_t>(getSizeTFromMatlab(prhs[9]));
+        refEpoch=getDoubleFromMatlab(prhs[10]);
+    }
+
+    fileName=mxArrayToString(prhs[0]);
+    if(nrhs>6) {
+        retVal=writeSpherHarmonicCoeffFileCPP(fileName,C,S,&CAux,&SAux,auxType,refEpoch,a,c);
+    } else {
+        retVal=writeSpherHarmonicCoeffFileCPP(fileName,C,S,NULL,NULL,auxType,refEpoch,a,c);
+    }
+    mxFree(fileName);
+
+    if(retVal!=SPHER_HARMONIC_COEFF_OK) {
+        mexErrMsgTxt("The coefficient file could not be written.");
+    }
+}
+
+void makeDegreeClusterSet(ClusterSetCPP<double> &dest, std::vector<size_t> &offsetArray, std::vector<size_t> &clusterSizes, const mxArray *coeffs, const size_t M) {
+/*MAKEDEGREECLUSTERSET Make dest a view of the coefficients in coeffs
+ *                     stored by degree up to degree M. offsetArray and
+ *                     clusterSizes are grown as needed and are shared
+ *                     between all of the views.
+ */
+    size_t n;
+
+    checkRealDoubleArray(coeffs);
+    if(mxGetNumberOfElements(coeffs)!=(M+1)*(M+2)/2) {
+        mexErrMsgTxt("The number of coefficients does not match the maximum degree.");
+    }
+
+    if(offsetArray.size()<M+1) {
+        offsetArray.resize(M+1);
+        clusterSizes.resize(M+1);
+        for(n=0;n<=M;n++) {
+            offsetArray[n]=n*(n+1)/2;
+            clusterSizes[n]=n+1;
+        }
+    }
+
+    dest.numClust=M+1;
+    dest.totalNumEl=(M+1)*(M+2)/2;
+    dest.clusterEls=(double*)mxGetData(coeffs);
+    dest.offsetArray=offsetArray.data();
+    dest.clusterSizes=clusterSizes.data();
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
@@ -0,0 +1,166 @@
+/*MAPPEDFILECPP C++ implementation of a class that memory maps a whole file
+ *              read-only. See MappedFileCPP.hpp for details.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#include "MappedFileCPP.hpp"
+
+#if defined _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFileCPP::MappedFileCPP() {
+    mapAddress=NULL;
+    mapSize=0;
+#if defined _WIN32
+    fileHandle=INVALID_HANDLE_VALUE;
+    mappingHandle=NULL;
+#endif
+}
+
+MappedFileCPP::~MappedFileCPP() {
+    close();
+}
+
+int MappedFileCPP::open(const char *fileName, const uint64_t minSize, const bool sequentialAccess) {
+    uint64_t fileSize;
+
+    close();
+
+#if defined _WIN32
+    {
+        LARGE_INTEGER sizeVal;
+
+        //There is no equivalent of MADV_SEQUENTIAL for a mapped view.
+        (void)sequentialAccess;
+
+        fileHandle=CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+        if(fileHandle==INVALID_HANDLE_VALUE) {
+            return MAPPED_FILE_OPEN_FAILED;
+        }
+        if(!GetFileSizeEx(fileHandle,&sizeVal)) {
+            close();
+            return MAPPED_FILE_OPEN_FAILED;
+        }
+        fileSize=static_cast<uint64_t>(sizeVal.QuadPart);
+        if(fileSize<minSize) {
+            close();
+            return MAPPED_FILE_TOO_SMALL;
+        }
+        //An empty file can not be mapped.
+        if(fileSize==0) {
+            close();
+            return MAPPED_FILE_OK;
+        }
+        //The file would not fit in the address space.
+        if(fileSize>static_cast<uint64_t>(static_cast<size_t>(-1))) {
+            close();
+            return MAPPED_FILE_MAP_FAILED;
+        }
+
+        mappingHandle=CreateFileMappingA(fileHandle,NULL,PAGE_READONLY,0,0,NULL);
+        if(mappingHandle==NULL) {
+            close();
+            return MAPPED_FILE_MAP_FAILED;
+        }
+        mapAddress=MapViewOfFile(mappingHandle,FILE_MAP_READ,0,0,0);
+        if(mapAddress==NULL) {
+            close();
+            return MAPPED_FILE_MAP_FAILED;
+        }
+        mapSize=static_cast<size_t>(fileSize);
+    }
+#else
+    {
+        struct stat fileStat;
+        void *address;
+        int fd;
+
+        fd=::open(fileName,O_RDONLY);
+        if(fd<0) {
+            return MAPPED_FILE_OPEN_FAILED;
+        }
+        if(fstat(fd,&fileStat)!=0) {
+            ::close(fd);
+            return MAPPED_FILE_OPEN_FAILED;
+        }
+        fileSize=static_cast<uint64_t>(fileStat.st_size);
+        if(fileSize<minSize) {
+            ::close(fd);
+            return MAPPED_FILE_TOO_SMALL;
+        }
+        //An empty file can not be mapped.
+        if(fileSize==0) {
+            ::close(fd);
+            return MAPPED_FILE_OK;
+        }
+        //The file would not fit in the address space.
+        if(fileSize>static_cast<uint64_t>(static_cast<size_t>(-1))) {
+            ::close(fd);
+            return MAPPED_FILE_MAP_FAILED;
+        }
+
+        address=mmap(NULL,static_cast<size_t>(fileSize),PROT_READ,MAP_SHARED,fd,0);
+        //The mapping remains valid after the file is closed.
+        ::close(fd);
+        if(address==MAP_FAILED) {
+            return MAPPED_FILE_MAP_FAILED;
+        }
+        if(sequentialAccess) {
+            madvise(address,static_cast<size_t>(fileSize),MADV_SEQUENTIAL);
+        }
+        mapAddress=address;
+        mapSize=static_cast<size_t>(fileSize);
+    }
+#endif
+
+    return MAPPED_FILE_OK;
+}
+
+void MappedFileCPP::close() {
+#if defined _WIN32
+    if(mapAddress!=NULL) {
+        UnmapViewOfFile(mapAddress);
+    }
+    if(mappingHandle!=NULL) {
+        CloseHandle(mappingHandle);
+    }
+    if(fileHandle!=INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+    }
+    fileHandle=INVALID_HANDLE_VALUE;
+    mappingHandle=NULL;
+#else
+    if(mapAddress!=NULL) {
+        munmap(mapAddress,mapSize);
+    }
+#endif
+    mapAddress=NULL;
+    mapSize=0;
+}
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
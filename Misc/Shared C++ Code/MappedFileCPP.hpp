@@ -0,0 +1,83 @@
+/**MAPPEDFILECPP A header file for a class that memory maps a whole file
+ *              read-only, using mmap under *NIX systems and
+ *              CreateFileMapping under Windows. This is what the classes
+ *              that read large binary or text files in place, such as
+ *              TLEFileCPP, GeoidGridCPP and SpherHarmonicCoeffFileCPP,
+ *              use to get at the contents of their files, so that they
+ *              only have to check and interpret the mapped bytes.
+ *
+ *The mapped memory is only valid until the file is closed or another file
+ *is opened. A file of zero bytes can not be mapped, so if it is allowed by
+ *the minimum size, opening it succeeds with data() being NULL and size()
+ *being 0.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef MAPPEDFILECPP
+#define MAPPEDFILECPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+//The possible return values of open.
+#define MAPPED_FILE_OK 0
+#define MAPPED_FILE_OPEN_FAILED 1
+#define MAPPED_FILE_TOO_SMALL 2
+#define MAPPED_FILE_MAP_FAILED 3
+
+class MappedFileCPP {
+public:
+    MappedFileCPP();
+    ~MappedFileCPP();
+
+    int open(const char *fileName, const uint64_t minSize, const bool sequentialAccess=false);
+    /*Map the given file, closing any file that is already mapped. Files
+     *with fewer than minSize bytes are not mapped. If sequentialAccess is
+     *true, the operating system is told that the file will be read once
+     *from start to end, so that it can read ahead more aggressively
+     *(madvise with MADV_SEQUENTIAL; this has no effect under Windows). The
+     *return value is MAPPED_FILE_OK on success or one of the other
+     *MAPPED_FILE_ values on failure.*/
+
+    void close();
+    /*Unmap the file, if one is mapped.*/
+
+    const void *data() const {
+        return mapAddress;
+    }
+
+    size_t size() const {
+        return mapSize;
+    }
+private:
+    void *mapAddress;
+    size_t mapSize;
+#if defined _WIN32
+    void *fileHandle;
+    void *mappingHandle;
+#endif
+
+    //Mapped files can not be copied.
+    MappedFileCPP(const MappedFileCPP &);
+    MappedFileCPP &operator=(const MappedFileCPP &);
+};
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/
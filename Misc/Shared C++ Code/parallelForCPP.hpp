@@ -0,0 +1,143 @@
+/**PARALLELFORCPP A header file with functions for splitting a loop over
+ *               independent items across multiple threads using the C++11
+ *               thread library. This is header-only, so nothing else has
+ *               to be compiled with it, though under *NIX systems the
+ *               -pthread option might have to be passed to the compiler.
+ *
+ *The work done in the threads must not call any Matlab API functions (such
+ *as mexErrMsgTxt or mxMalloc), as those functions are not thread safe.
+ *Errors should be recorded in a per-item or per-thread variable and
+ *handled after parallelForCPP returns. If an exception is thrown in any of
+ *the threads, all of the threads are still joined and then the exception
+ *is rethrown in the calling thread.
+ **/
+/*(UNCLASSIFIED) DISTRIBUTION STATEMENT A. Approved for public release.*/
+
+#ifndef PARALLELFORCPP
+#define PARALLELFORCPP
+#include <stddef.h>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <exception>
+
+inline size_t numThreads2UseCPP(const size_t numThreadsRequested, const size_t numItems) {
+/**NUMTHREADS2USECPP Get the number of threads to use for a loop over
+ *                  numItems items. If numThreadsRequested is zero, then
+ *                  the number of hardware threads is used. The result is
+ *                  always between 1 and numItems (or 1 if numItems=0).
+ */
+    size_t numThreads=numThreadsRequested;
+
+    if(numThreads==0) {
+        numThreads=static_cast<size_t>(std::thread::hardware_concurrency());
+    }
+
+    if(numThreads>numItems) {
+        numThreads=numItems;
+    }
+
+    if(numThreads==0) {
+        numThreads=1;
+    }
+
+    return numThreads;
+}
+
+/*The ParallelForJoinerCPP class joins the threads that have been started
+ *when it goes out of scope, so that they are joined even if starting a
+ *thread or processing the chunk in the calling thread throws.*/
+class ParallelForJoinerCPP {
+public:
+    std::vector<std::thread> threads;
+
+    ~ParallelForJoinerCPP() {
+        size_t curThread;
+
+        for(curThread=0;curThread<threads.size();curThread++) {
+            if(threads[curThread].joinable()) {
+                threads[curThread].join();
+            }
+        }
+    }
+};
+
+template<class ChunkFunc>
+void parallelForChunkCPP(ChunkFunc &func, const size_t threadIdx, const size_t startIdx, const size_t endIdx, std::exception_ptr &error) {
+/**PARALLELFORCHUNKCPP Call func for one chunk, saving any exception in
+ *               error rather than letting it escape the thread, which
+ *               would terminate the program.
+ */
+    try {
+        func(threadIdx,startIdx,endIdx);
+    } catch(...) {
+        error=std::current_exception();
+    }
+}
+
+template<class ChunkFunc>
+void parallelForCPP(const size_t numItems, const size_t numThreads, ChunkFunc &func) {
+/**PARALLELFORCPP Call func(threadIdx,startIdx,endIdx) once for each of
+ *               numThreads contiguous chunks of the items 0 to numItems-1,
+ *               with each chunk being processed in a separate thread. The
+ *               items in a chunk are startIdx to endIdx-1 and threadIdx
+ *               goes from 0 to numThreads-1, so it can be used to select
+ *               per-thread scratch space. The chunks differ in size by at
+ *               most one item. The first chunk is processed in the calling
+ *               thread. If numThreads<=1, func is just called once with
+ *               all of the items. numThreads should be obtained from
+ *               numThreads2UseCPP. If func throws, the exception of the
+ *               lowest threadIdx is rethrown after all of the threads are
+ *               joined.
+ */
+    if(numThreads<=1||numItems<=1) {
+        func(0,0,numItems);
+        return;
+    } else {
+        std::vector<std::exception_ptr> errors(numThreads);
+        const size_t baseSize=numItems/numThreads;
+        const size_t numLarger=numItems%numThreads;
+        size_t curThread, startIdx, chunkSize;
+
+        {
+            ParallelForJoinerCPP joiner;
+
+            joiner.threads.reserve(numThreads-1);
+            //The first chunk is done in this thread after the others start.
+            startIdx=baseSize+(numLarger>0);
+            for(curThread=1;curThread<numThreads;curThread++) {
+                chunkSize=baseSize+(curThread<numLarger);
+                joiner.threads.push_back(std::thread(parallelForChunkCPP<ChunkFunc>,std::ref(func),curThread,startIdx,startIdx+chunkSize,std::ref(errors[curThread])));
+                startIdx+=chunkSize;
+            }
+
+            parallelForChunkCPP(func,0,0,baseSize+(numLarger>0),errors[0]);
+        }
+
+        for(curThread=0;curThread<numThreads;curThread++) {
+            if(errors[curThread]) {
+                std::rethrow_exception(errors[curThread]);
+            }
+        }
+    }
+}
+
+#endif
+
+/*LICENSE:
+%
+%The source code is in the public domain and not licensed or under
+%copyright. The information and software may be used freely by the public.
+%As required by 17 U.S.C. 403, third parties producing copyrighted works
+%consisting predominantly of the material produced by U.S. government
+%agencies must provide notice with such work(s) identifying the U.S.
+%Government material incorporated and stating that such material is not
+%subject to copyright protection.
+%
+%Derived works shall not identify themselves in a manner that implies an
+%endorsement by or an affiliation with the Naval Research Laboratory.
+%
+%RECIPIENT BEARS ALL RISK RELATING TO QUALITY AND PERFORMANCE OF THE
+%SOFTWARE AND ANY RELATED MATERIALS, AND AGREES TO INDEMNIFY THE NAVAL
+%RESEARCH LABORATORY FOR ALL THIRD-PARTY CLAIMS RESULTING FROM THE ACTIONS
+%OF RECIPIENT IN THE USE OF THE SOFTWARE.*/